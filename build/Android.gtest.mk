@@ -132,6 +132,7 @@ ART_TEST_MODULES := \
     art_dexlayout_tests \
     art_dexlist_tests \
     art_dexoptanalyzer_tests \
+    art_disassembler_tests \
     art_hiddenapi_tests \
     art_imgdiag_tests \
     art_libartbase_tests \
@@ -147,6 +148,7 @@ ART_TEST_MODULES := \
     art_runtime_compiler_tests \
     art_runtime_tests \
     art_sigchain_tests \
+    art_simulator_tests \
 
 ART_TARGET_GTEST_NAMES := $(foreach tm,$(ART_TEST_MODULES),\
   $(foreach path,$(ART_TEST_LIST_device_$(TARGET_ARCH)_$(tm)),\
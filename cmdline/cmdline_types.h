@@ -485,8 +485,12 @@ static gc::CollectorType ParseCollectorType(const std::string& option) {
     return gc::kCollectorTypeCMS;
   } else if (option == "SS") {
     return gc::kCollectorTypeSS;
+  } else if (option == "GSS") {
+    return gc::kCollectorTypeGSS;
   } else if (option == "CC") {
     return gc::kCollectorTypeCC;
+  } else if (option == "CMC") {
+    return gc::kCollectorTypeCMC;
   } else {
     return gc::kCollectorTypeNone;
   }
@@ -578,7 +582,7 @@ struct CmdlineType<XGcOption> : CmdlineTypeParser<XGcOption> {
 
   static const char* Name() { return "XgcOption"; }
   static const char* DescribeType() {
-    return "MS|nonconccurent|concurrent|CMS|SS|CC|[no]preverify[_rosalloc]|"
+    return "MS|nonconccurent|concurrent|CMS|SS|GSS|CC|CMC|[no]preverify[_rosalloc]|"
            "[no]presweepingverify[_rosalloc]|[no]generation_cc|[no]postverify[_rosalloc]|"
            "[no]gcstress|measure|[no]precisce|[no]verifycardtable";
   }
@@ -622,7 +626,7 @@ struct CmdlineType<BackgroundGcOption>
 
   static const char* Name() { return "BackgroundGcOption"; }
   static const char* DescribeType() {
-    return "HSpaceCompact|MS|nonconccurent|CMS|concurrent|SS|CC";
+    return "HSpaceCompact|MS|nonconccurent|CMS|concurrent|SS|GSS|CC|CMC";
   }
 };
 
@@ -37,7 +37,7 @@
 #include "jni/quick/x86_64/calling_convention_x86_64.h"
 #endif
 
-#ifdef ART_ENABLE_CODEGEN_loongarch64_unimp  // XC-TODO unimplmented 
+#ifdef ART_ENABLE_CODEGEN_loongarch64
 #include "jni/quick/loongarch64/calling_convention_loongarch64.h"
 #endif
 
@@ -77,7 +77,7 @@ std::unique_ptr<ManagedRuntimeCallingConvention> ManagedRuntimeCallingConvention
           new (allocator) x86_64::X86_64ManagedRuntimeCallingConvention(
               is_static, is_synchronized, shorty));
 #endif
-#ifdef ART_ENABLE_CODEGEN_loongarch64_unimp   // XC-TODO unimplmented 
+#ifdef ART_ENABLE_CODEGEN_loongarch64
     case InstructionSet::kLoongarch64:
       return std::unique_ptr<ManagedRuntimeCallingConvention>(
           new (allocator) loongarch64::Loongarch64ManagedRuntimeCallingConvention(
@@ -177,7 +177,7 @@ std::unique_ptr<JniCallingConvention> JniCallingConvention::Create(ArenaAllocato
           new (allocator) x86_64::X86_64JniCallingConvention(
               is_static, is_synchronized, is_critical_native, shorty));
 #endif
-#ifdef ART_ENABLE_CODEGEN_loongarch64_unimp   // XC-TODO unimplmented
+#ifdef ART_ENABLE_CODEGEN_loongarch64
     case InstructionSet::kLoongarch64:
       return std::unique_ptr<JniCallingConvention>(
           new (allocator) loongarch64::Loongarch64JniCallingConvention(
@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "calling_convention_loongarch64.h"
+
+#include <android-base/logging.h>
+
+#include "arch/instruction_set.h"
+#include "arch/loongarch64/jni_frame_loongarch64.h"
+#include "utils/loongarch64/managed_register_loongarch64.h"
+
+namespace art {
+namespace loongarch64 {
+
+static const XRegister kXArgumentRegisters[] = {
+  A0, A1, A2, A3, A4, A5, A6, A7
+};
+static_assert(kMaxIntLikeRegisterArguments == arraysize(kXArgumentRegisters));
+
+static const FRegister kFArgumentRegisters[] = {
+  FA0, FA1, FA2, FA3, FA4, FA5, FA6, FA7
+};
+static_assert(kMaxFloatOrDoubleRegisterArguments == arraysize(kFArgumentRegisters));
+
+static constexpr ManagedRegister kCalleeSaveRegisters[] = {
+    // Core registers.
+    // Note: The native jni function may call to some VM runtime functions which may suspend
+    // or trigger GC. And the jni method frame will become top quick frame in those cases.
+    // So we need to satisfy GC to save RA and callee-save registers which is similar to
+    // CalleeSaveMethod(RefOnly) frame.
+    // Jni function is the native function which the java code wants to call.
+    // Jni method is the method that is compiled by jni compiler.
+    // Call chain: managed code(java) --> jni method --> jni function.
+    // This does not apply to the @CriticalNative.
+
+    // S1(TR) is the thread register and it is preserved by the native code.
+    Loongarch64ManagedRegister::FromXRegister(FP),
+    Loongarch64ManagedRegister::FromXRegister(S0),
+    Loongarch64ManagedRegister::FromXRegister(S2),
+    Loongarch64ManagedRegister::FromXRegister(S3),
+    Loongarch64ManagedRegister::FromXRegister(S4),
+    Loongarch64ManagedRegister::FromXRegister(S5),
+    Loongarch64ManagedRegister::FromXRegister(S6),
+    Loongarch64ManagedRegister::FromXRegister(S7),
+    Loongarch64ManagedRegister::FromXRegister(S8),
+    Loongarch64ManagedRegister::FromXRegister(RA),  // Must be the last core register, see below.
+    // Hard float registers.
+    // Considering the case, java_method_1 --> jni method --> jni function --> java_method_2,
+    // we may break on java_method_2 and we still need to find out the values of DEX registers
+    // in java_method_1. So all callee-saves(in managed code) need to be saved.
+    Loongarch64ManagedRegister::FromFRegister(FS0),
+    Loongarch64ManagedRegister::FromFRegister(FS1),
+    Loongarch64ManagedRegister::FromFRegister(FS2),
+    Loongarch64ManagedRegister::FromFRegister(FS3),
+    Loongarch64ManagedRegister::FromFRegister(FS4),
+    Loongarch64ManagedRegister::FromFRegister(FS5),
+    Loongarch64ManagedRegister::FromFRegister(FS6),
+    Loongarch64ManagedRegister::FromFRegister(FS7),
+};
+
+template <size_t size>
+static constexpr uint32_t CalculateCoreCalleeSpillMask(
+    const ManagedRegister (&callee_saves)[size]) {
+  uint32_t result = 0u;
+  for (auto&& r : callee_saves) {
+    if (r.AsLoongarch64().IsXRegister()) {
+      result |= (1u << r.AsLoongarch64().AsXRegister());
+    }
+  }
+  return result;
+}
+
+template <size_t size>
+static constexpr uint32_t CalculateFpCalleeSpillMask(const ManagedRegister (&callee_saves)[size]) {
+  uint32_t result = 0u;
+  for (auto&& r : callee_saves) {
+    if (r.AsLoongarch64().IsFRegister()) {
+      result |= (1u << r.AsLoongarch64().AsFRegister());
+    }
+  }
+  return result;
+}
+
+static constexpr uint32_t kCoreCalleeSpillMask = CalculateCoreCalleeSpillMask(kCalleeSaveRegisters);
+static constexpr uint32_t kFpCalleeSpillMask = CalculateFpCalleeSpillMask(kCalleeSaveRegisters);
+
+static constexpr ManagedRegister kNativeCalleeSaveRegisters[] = {
+    // Core registers.
+    Loongarch64ManagedRegister::FromXRegister(FP),
+    Loongarch64ManagedRegister::FromXRegister(S0),
+    Loongarch64ManagedRegister::FromXRegister(S1),
+    Loongarch64ManagedRegister::FromXRegister(S2),
+    Loongarch64ManagedRegister::FromXRegister(S3),
+    Loongarch64ManagedRegister::FromXRegister(S4),
+    Loongarch64ManagedRegister::FromXRegister(S5),
+    Loongarch64ManagedRegister::FromXRegister(S6),
+    Loongarch64ManagedRegister::FromXRegister(S7),
+    Loongarch64ManagedRegister::FromXRegister(S8),
+    // Hard float registers.
+    Loongarch64ManagedRegister::FromFRegister(FS0),
+    Loongarch64ManagedRegister::FromFRegister(FS1),
+    Loongarch64ManagedRegister::FromFRegister(FS2),
+    Loongarch64ManagedRegister::FromFRegister(FS3),
+    Loongarch64ManagedRegister::FromFRegister(FS4),
+    Loongarch64ManagedRegister::FromFRegister(FS5),
+    Loongarch64ManagedRegister::FromFRegister(FS6),
+    Loongarch64ManagedRegister::FromFRegister(FS7),
+};
+
+static constexpr uint32_t kNativeCoreCalleeSpillMask =
+    CalculateCoreCalleeSpillMask(kNativeCalleeSaveRegisters);
+static constexpr uint32_t kNativeFpCalleeSpillMask =
+    CalculateFpCalleeSpillMask(kNativeCalleeSaveRegisters);
+
+// Calling convention
+static ManagedRegister ReturnRegisterForShorty(const char* shorty) {
+  if (shorty[0] == 'F' || shorty[0] == 'D') {
+    return Loongarch64ManagedRegister::FromFRegister(FA0);
+  } else if (shorty[0] == 'V') {
+    return Loongarch64ManagedRegister::NoRegister();
+  } else {
+    // All other return types use A0. Note that there is no managed return register
+    // of a smaller width on LoongArch64, 32-bit values are kept sign-extended.
+    return Loongarch64ManagedRegister::FromXRegister(A0);
+  }
+}
+
+ManagedRegister Loongarch64ManagedRuntimeCallingConvention::ReturnRegister() {
+  return ReturnRegisterForShorty(GetShorty());
+}
+
+ManagedRegister Loongarch64JniCallingConvention::ReturnRegister() {
+  return ReturnRegisterForShorty(GetShorty());
+}
+
+ManagedRegister Loongarch64JniCallingConvention::IntReturnRegister() {
+  return Loongarch64ManagedRegister::FromXRegister(A0);
+}
+
+// Managed runtime calling convention
+
+ManagedRegister Loongarch64ManagedRuntimeCallingConvention::MethodRegister() {
+  return Loongarch64ManagedRegister::FromXRegister(A0);
+}
+
+bool Loongarch64ManagedRuntimeCallingConvention::IsCurrentParamInRegister() {
+  if (IsCurrentParamAFloatOrDouble()) {
+    return itr_float_and_doubles_ < kMaxFloatOrDoubleRegisterArguments;
+  } else {
+    size_t non_fp_arg_number = itr_args_ - itr_float_and_doubles_;
+    return /* method */ 1u + non_fp_arg_number < kMaxIntLikeRegisterArguments;
+  }
+}
+
+bool Loongarch64ManagedRuntimeCallingConvention::IsCurrentParamOnStack() {
+  return !IsCurrentParamInRegister();
+}
+
+ManagedRegister Loongarch64ManagedRuntimeCallingConvention::CurrentParamRegister() {
+  DCHECK(IsCurrentParamInRegister());
+  if (IsCurrentParamAFloatOrDouble()) {
+    return Loongarch64ManagedRegister::FromFRegister(kFArgumentRegisters[itr_float_and_doubles_]);
+  } else {
+    size_t non_fp_arg_number = itr_args_ - itr_float_and_doubles_;
+    return Loongarch64ManagedRegister::FromXRegister(
+        kXArgumentRegisters[/* method */ 1u + non_fp_arg_number]);
+  }
+}
+
+FrameOffset Loongarch64ManagedRuntimeCallingConvention::CurrentParamStackOffset() {
+  return FrameOffset(displacement_.Int32Value() +  // displacement
+                     kFramePointerSize +  // Method ref
+                     (itr_slots_ * sizeof(uint32_t)));  // offset into in args
+}
+
+// JNI calling convention
+
+Loongarch64JniCallingConvention::Loongarch64JniCallingConvention(bool is_static,
+                                                                 bool is_synchronized,
+                                                                 bool is_critical_native,
+                                                                 const char* shorty)
+    : JniCallingConvention(is_static,
+                           is_synchronized,
+                           is_critical_native,
+                           shorty,
+                           kLoongarch64PointerSize) {
+}
+
+uint32_t Loongarch64JniCallingConvention::CoreSpillMask() const {
+  return is_critical_native_ ? 0u : kCoreCalleeSpillMask;
+}
+
+uint32_t Loongarch64JniCallingConvention::FpSpillMask() const {
+  return is_critical_native_ ? 0u : kFpCalleeSpillMask;
+}
+
+ManagedRegister Loongarch64JniCallingConvention::SavedLocalReferenceCookieRegister() const {
+  // The S2 is callee-save register in both managed and native ABIs.
+  // It is saved in the stack frame and it has no special purpose like `tr`.
+  static_assert((kCoreCalleeSpillMask & (1u << S2)) != 0u);  // Managed callee save register.
+  static_assert((kNativeCoreCalleeSpillMask & (1u << S2)) != 0u);  // Native callee save register.
+  return Loongarch64ManagedRegister::FromXRegister(S2);
+}
+
+ManagedRegister Loongarch64JniCallingConvention::ReturnScratchRegister() const {
+  return ManagedRegister::NoRegister();
+}
+
+size_t Loongarch64JniCallingConvention::FrameSize() const {
+  if (is_critical_native_) {
+    CHECK(!SpillsMethod());
+    CHECK(!HasLocalReferenceSegmentState());
+    CHECK(!SpillsReturnValue());
+    return 0u;  // There is no managed frame for @CriticalNative.
+  }
+
+  // Method*, callee save area size, local reference segment state
+  DCHECK(SpillsMethod());
+  size_t method_ptr_size = static_cast<size_t>(kFramePointerSize);
+  size_t callee_save_area_size = CalleeSaveRegisters().size() * kFramePointerSize;
+  size_t total_size = method_ptr_size + callee_save_area_size;
+
+  DCHECK(HasLocalReferenceSegmentState());
+  // Cookie is saved in one of the spilled registers.
+
+  // Plus return value spill area size
+  if (SpillsReturnValue()) {
+    // No padding between the method pointer and the return value on loongarch64.
+    DCHECK_EQ(ReturnValueSaveLocation().SizeValue(), method_ptr_size);
+    total_size += SizeOfReturnValue();
+  }
+
+  return RoundUp(total_size, kStackAlignment);
+}
+
+size_t Loongarch64JniCallingConvention::OutFrameSize() const {
+  // Count param args, including JNIEnv* and jclass*.
+  size_t all_args = NumberOfExtraArgumentsForJni() + NumArgs();
+  size_t num_fp_args = NumFloatOrDoubleArgs();
+  DCHECK_GE(all_args, num_fp_args);
+  size_t num_non_fp_args = all_args - num_fp_args;
+  // The size of outgoing arguments.
+  size_t size = GetNativeOutArgsSize(num_fp_args, num_non_fp_args);
+
+  // @CriticalNative can use tail call as all managed callee saves are preserved by the
+  // native ABI. RA is not, but a tail call returns directly to the managed caller.
+  static_assert((kCoreCalleeSpillMask & ~(kNativeCoreCalleeSpillMask | (1u << RA))) == 0u);
+  static_assert((kFpCalleeSpillMask & ~kNativeFpCalleeSpillMask) == 0u);
+
+  // For @CriticalNative, we can make a tail call if there are no stack args and
+  // we do not need to extend the result. Otherwise, add space for return PC.
+  if (is_critical_native_ && (size != 0u || RequiresSmallResultTypeExtension())) {
+    size += kFramePointerSize;  // We need to spill RA with the args.
+  }
+  size_t out_args_size = RoundUp(size, kLoongarch64StackAlignment);
+  if (UNLIKELY(IsCriticalNative())) {
+    DCHECK_EQ(out_args_size, GetCriticalNativeStubFrameSize(GetShorty(), NumArgs() + 1u));
+  }
+  return out_args_size;
+}
+
+ArrayRef<const ManagedRegister> Loongarch64JniCallingConvention::CalleeSaveRegisters() const {
+  if (UNLIKELY(IsCriticalNative())) {
+    if (UseTailCall()) {
+      return ArrayRef<const ManagedRegister>();  // Do not spill anything.
+    } else {
+      // Spill RA with out args.
+      static_assert((kCoreCalleeSpillMask & (1u << RA)) != 0u);  // Contains RA.
+      constexpr size_t ra_index = POPCOUNT(kCoreCalleeSpillMask) - 1u;
+      static_assert(kCalleeSaveRegisters[ra_index].Equals(
+                        Loongarch64ManagedRegister::FromXRegister(RA)));
+      return ArrayRef<const ManagedRegister>(kCalleeSaveRegisters).SubArray(
+          /*pos*/ ra_index, /*length=*/ 1u);
+    }
+  } else {
+    return ArrayRef<const ManagedRegister>(kCalleeSaveRegisters);
+  }
+}
+
+// The native ABI passes FP args in FPRs, then in GPRs once the FPRs are used up,
+// and only then on the stack. Non-FP args use GPRs and then the stack.
+
+bool Loongarch64JniCallingConvention::IsCurrentParamInRegister() {
+  if (itr_float_and_doubles_ < kMaxFloatOrDoubleRegisterArguments) {
+    if (IsCurrentParamAFloatOrDouble()) {
+      return true;
+    } else {
+      size_t num_non_fp_args = itr_args_ - itr_float_and_doubles_;
+      return num_non_fp_args < kMaxIntLikeRegisterArguments;
+    }
+  } else {
+    // All previous FP args used FPRs, all other args (FP or not) use GPRs.
+    return itr_args_ < kMaxFloatOrDoubleRegisterArguments + kMaxIntLikeRegisterArguments;
+  }
+}
+
+bool Loongarch64JniCallingConvention::IsCurrentParamOnStack() {
+  return !IsCurrentParamInRegister();
+}
+
+ManagedRegister Loongarch64JniCallingConvention::CurrentParamRegister() {
+  CHECK(IsCurrentParamInRegister());
+  if (itr_float_and_doubles_ < kMaxFloatOrDoubleRegisterArguments) {
+    if (IsCurrentParamAFloatOrDouble()) {
+      return Loongarch64ManagedRegister::FromFRegister(kFArgumentRegisters[itr_float_and_doubles_]);
+    } else {
+      size_t num_non_fp_args = itr_args_ - itr_float_and_doubles_;
+      DCHECK_LT(num_non_fp_args, kMaxIntLikeRegisterArguments);
+      return Loongarch64ManagedRegister::FromXRegister(kXArgumentRegisters[num_non_fp_args]);
+    }
+  } else {
+    // This argument is in a GPR, whether it's a FP arg or a non-FP arg.
+    DCHECK_LT(itr_args_, kMaxFloatOrDoubleRegisterArguments + kMaxIntLikeRegisterArguments);
+    return Loongarch64ManagedRegister::FromXRegister(
+        kXArgumentRegisters[itr_args_ - kMaxFloatOrDoubleRegisterArguments]);
+  }
+}
+
+FrameOffset Loongarch64JniCallingConvention::CurrentParamStackOffset() {
+  CHECK(IsCurrentParamOnStack());
+  // Account for FP arguments passed through FA0-FA7.
+  // All other args are passed through A0-A7 (even FP args) and the stack.
+  size_t num_gpr_and_stack_args =
+      itr_args_ - std::min(kMaxFloatOrDoubleRegisterArguments,
+                           static_cast<size_t>(itr_float_and_doubles_));
+  size_t args_on_stack =
+      num_gpr_and_stack_args - std::min(kMaxIntLikeRegisterArguments, num_gpr_and_stack_args);
+  size_t offset = displacement_.Int32Value() - OutFrameSize() + (args_on_stack * kFramePointerSize);
+  CHECK_LT(offset, OutFrameSize());
+  return FrameOffset(offset);
+}
+
+ManagedRegister Loongarch64JniCallingConvention::HiddenArgumentRegister() const {
+  CHECK(IsCriticalNative());
+  // T0 is neither managed callee-save, nor argument register, nor scratch register.
+  // It is also the register expected by `art_jni_dlsym_lookup_critical_stub`.
+  // TODO: Change to static_assert; std::none_of should be constexpr since C++20.
+  DCHECK(std::none_of(kCalleeSaveRegisters,
+                      kCalleeSaveRegisters + std::size(kCalleeSaveRegisters),
+                      [](ManagedRegister callee_save) constexpr {
+                        return callee_save.Equals(Loongarch64ManagedRegister::FromXRegister(T0));
+                      }));
+  DCHECK(std::none_of(kXArgumentRegisters,
+                      kXArgumentRegisters + std::size(kXArgumentRegisters),
+                      [](XRegister reg) { return reg == T0; }));
+  return Loongarch64ManagedRegister::FromXRegister(T0);
+}
+
+// Whether to use tail call (used only for @CriticalNative).
+bool Loongarch64JniCallingConvention::UseTailCall() const {
+  CHECK(IsCriticalNative());
+  return OutFrameSize() == 0u;
+}
+
+}  // namespace loongarch64
+}  // namespace art
@@ -52,6 +52,7 @@
 #include "gc/space/image_space.h"
 #include "intern_table.h"
 #include "intrinsics.h"
+#include "jit/profiling_info.h"
 #include "mirror/array-inl.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/object_reference.h"
@@ -309,6 +310,14 @@ uint32_t CodeGenerator::GetArrayDataOffset(HArrayGet* array_get) {
       : mirror::Array::DataOffset(DataType::Size(array_get->GetType())).Uint32Value();
 }
 
+BranchCache* CodeGenerator::GetBranchCacheForProfiling(HIf* if_instr) const {
+  ProfilingInfo* info = GetGraph()->GetProfilingInfo();
+  if (info == nullptr || !GetGraph()->IsCompilingBaseline() || if_instr->GetDexPc() == kNoDexPc) {
+    return nullptr;
+  }
+  return info->GetBranchCache(if_instr->GetDexPc());
+}
+
 bool CodeGenerator::GoesToNextBlock(HBasicBlock* current, HBasicBlock* next) const {
   DCHECK_EQ((*block_order_)[current_block_index_], current);
   return GetNextBlockToEmit() == FirstNonEmptyBlock(next);
@@ -1019,6 +1028,12 @@ std::unique_ptr<CodeGenerator> CodeGenerator::Create(HGraph* graph,
           new (allocator) arm64::CodeGeneratorARM64(graph, compiler_options, stats));
     }
 #endif
+#ifdef ART_ENABLE_CODEGEN_loongarch64
+    case InstructionSet::kLoongarch64: {
+      return std::unique_ptr<CodeGenerator>(
+          new (allocator) loongarch64::CodeGeneratorLoongarch64(graph, compiler_options, stats));
+    }
+#endif
 #ifdef ART_ENABLE_CODEGEN_x86
     case InstructionSet::kX86: {
       return std::unique_ptr<CodeGenerator>(
@@ -59,6 +59,7 @@ static constexpr ReadBarrierOption kCompilerReadBarrierOption =
     kEmitCompilerReadBarrier ? kWithReadBarrier : kWithoutReadBarrier;
 
 class Assembler;
+class BranchCache;
 class CodeGenerator;
 class CompilerOptions;
 class StackMapStream;
@@ -397,6 +398,10 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
     return is_leaf_;
   }
 
+  // Returns the branch cache that baseline code updates when executing `if_instr`, or null if
+  // the branch is not profiled.
+  BranchCache* GetBranchCacheForProfiling(HIf* if_instr) const;
+
   void MarkNotLeaf() {
     is_leaf_ = false;
     requires_current_method_ = true;
@@ -493,6 +498,26 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
     return type == DataType::Type::kReference && !value->IsNullConstant();
   }
 
+  // Like above, but also honors a card mark that WriteBarrierElimination folded into an
+  // earlier store to the same holder.
+  static bool StoreNeedsWriteBarrier(DataType::Type type,
+                                     HInstruction* value,
+                                     WriteBarrierKind write_barrier_kind) {
+    return write_barrier_kind != WriteBarrierKind::kDontEmit &&
+           StoreNeedsWriteBarrier(type, value);
+  }
+
+  // Returns how `instruction` marks the card of its holder. Stores other than field sets, such as
+  // intrinsics, always use the default.
+  static WriteBarrierKind GetWriteBarrierKind(HInstruction* instruction) {
+    if (instruction->IsInstanceFieldSet()) {
+      return instruction->AsInstanceFieldSet()->GetWriteBarrierKind();
+    } else if (instruction->IsStaticFieldSet()) {
+      return instruction->AsStaticFieldSet()->GetWriteBarrierKind();
+    }
+    return WriteBarrierKind::kEmitWithNullCheck;
+  }
+
 
   // Performs checks pertaining to an InvokeRuntime call.
   void ValidateInvokeRuntime(QuickEntrypointEnum entrypoint,
@@ -2125,8 +2125,13 @@ void InstructionCodeGeneratorARM64::HandleFieldSet(HInstruction* instruction,
     }
   }
 
-  if (CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(1))) {
-    codegen_->MarkGCCard(obj, Register(value), value_can_be_null);
+  WriteBarrierKind write_barrier_kind = CodeGenerator::GetWriteBarrierKind(instruction);
+  if (CodeGenerator::StoreNeedsWriteBarrier(
+          field_type, instruction->InputAt(1), write_barrier_kind)) {
+    codegen_->MarkGCCard(
+        obj,
+        Register(value),
+        value_can_be_null && write_barrier_kind == WriteBarrierKind::kEmitWithNullCheck);
   }
 
   if (is_predicated) {
@@ -3650,9 +3655,38 @@ void InstructionCodeGeneratorARM64::VisitIf(HIf* if_instr) {
   if (codegen_->GoesToNextBlock(if_instr->GetBlock(), false_successor)) {
     false_target = nullptr;
   }
+  BranchCache* cache = codegen_->GetBranchCacheForProfiling(if_instr);
+  if (cache != nullptr) {
+    // Record which side of the branch is taken before jumping to it.
+    vixl::aarch64::Label true_taken;
+    GenerateTestAndBranch(if_instr, /* condition_input_index= */ 0, &true_taken, nullptr);
+    GenerateBranchProfileUpdate(cache, /* taken= */ false);
+    if (false_target != nullptr) {
+      __ B(false_target);
+    }
+    __ Bind(&true_taken);
+    GenerateBranchProfileUpdate(cache, /* taken= */ true);
+    if (true_target != nullptr) {
+      __ B(true_target);
+    }
+    return;
+  }
   GenerateTestAndBranch(if_instr, /* condition_input_index= */ 0, true_target, false_target);
 }
 
+void InstructionCodeGeneratorARM64::GenerateBranchProfileUpdate(BranchCache* cache, bool taken) {
+  MemberOffset offset = taken ? BranchCache::TrueOffset() : BranchCache::FalseOffset();
+  UseScratchRegisterScope temps(GetVIXLAssembler());
+  Register temp = temps.AcquireX();
+  Register counter = temps.AcquireW();
+  __ Mov(temp, reinterpret_cast64<uint64_t>(cache));
+  __ Ldrh(counter, MemOperand(temp, offset.Int32Value()));
+  __ Add(counter, counter, 1);
+  // Subtract one if the counter would overflow.
+  __ Sub(counter, counter, Operand(counter, LSR, 16));
+  __ Strh(counter, MemOperand(temp, offset.Int32Value()));
+}
+
 void LocationsBuilderARM64::VisitDeoptimize(HDeoptimize* deoptimize) {
   LocationSummary* locations = new (GetGraph()->GetAllocator())
       LocationSummary(deoptimize, LocationSummary::kCallOnSlowPath);
@@ -367,6 +367,8 @@ class InstructionCodeGeneratorARM64 : public InstructionCodeGenerator {
                              size_t condition_input_index,
                              vixl::aarch64::Label* true_target,
                              vixl::aarch64::Label* false_target);
+  // Increment the (saturating) counter of `cache` for the `taken` side of a branch.
+  void GenerateBranchProfileUpdate(BranchCache* cache, bool taken);
   void DivRemOneOrMinusOne(HBinaryOperation* instruction);
   void DivRemByPowerOfTwo(HBinaryOperation* instruction);
   void GenerateIncrementNegativeByOne(vixl::aarch64::Register out,
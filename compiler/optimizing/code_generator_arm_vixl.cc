@@ -2812,6 +2812,10 @@ void LocationsBuilderARMVIXL::VisitIf(HIf* if_instr) {
   if (IsBooleanValueOrMaterializedCondition(if_instr->InputAt(0))) {
     locations->SetInAt(0, Location::RequiresRegister());
   }
+  if (codegen_->GetBranchCacheForProfiling(if_instr) != nullptr) {
+    // Holds the address of the branch cache, `ip` holds the counter.
+    locations->AddTemp(Location::RequiresRegister());
+  }
 }
 
 void InstructionCodeGeneratorARMVIXL::VisitIf(HIf* if_instr) {
@@ -2821,9 +2825,44 @@ void InstructionCodeGeneratorARMVIXL::VisitIf(HIf* if_instr) {
       nullptr : codegen_->GetLabelOf(true_successor);
   vixl32::Label* false_target = codegen_->GoesToNextBlock(if_instr->GetBlock(), false_successor) ?
       nullptr : codegen_->GetLabelOf(false_successor);
+  BranchCache* cache = codegen_->GetBranchCacheForProfiling(if_instr);
+  if (cache != nullptr) {
+    // Record which side of the branch is taken before jumping to it.
+    vixl32::Register temp = RegisterFrom(if_instr->GetLocations()->GetTemp(0));
+    vixl32::Label true_taken;
+    GenerateTestAndBranch(if_instr,
+                          /* condition_input_index= */ 0,
+                          &true_taken,
+                          /* false_target= */ nullptr,
+                          /* far_target= */ false);
+    GenerateBranchProfileUpdate(cache, /* taken= */ false, temp);
+    if (false_target != nullptr) {
+      __ B(false_target);
+    }
+    __ Bind(&true_taken);
+    GenerateBranchProfileUpdate(cache, /* taken= */ true, temp);
+    if (true_target != nullptr) {
+      __ B(true_target);
+    }
+    return;
+  }
   GenerateTestAndBranch(if_instr, /* condition_input_index= */ 0, true_target, false_target);
 }
 
+void InstructionCodeGeneratorARMVIXL::GenerateBranchProfileUpdate(BranchCache* cache,
+                                                                  bool taken,
+                                                                  vixl32::Register temp) {
+  MemberOffset offset = taken ? BranchCache::TrueOffset() : BranchCache::FalseOffset();
+  UseScratchRegisterScope temps(GetVIXLAssembler());
+  vixl32::Register counter = temps.Acquire();
+  __ Mov(temp, reinterpret_cast32<uint32_t>(cache));
+  __ Ldrh(counter, MemOperand(temp, offset.Int32Value()));
+  __ Add(counter, counter, 1);
+  // Subtract one if the counter would overflow.
+  __ Sub(counter, counter, Operand(counter, LSR, 16));
+  __ Strh(counter, MemOperand(temp, offset.Int32Value()));
+}
+
 void LocationsBuilderARMVIXL::VisitDeoptimize(HDeoptimize* deoptimize) {
   LocationSummary* locations = new (GetGraph()->GetAllocator())
       LocationSummary(deoptimize, LocationSummary::kCallOnSlowPath);
@@ -5844,10 +5883,18 @@ void InstructionCodeGeneratorARMVIXL::HandleFieldSet(HInstruction* instruction,
       UNREACHABLE();
   }
 
-  if (CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(1))) {
+  // The temps stay allocated for `kDontEmit`, they are also used for reference poisoning.
+  WriteBarrierKind write_barrier_kind = CodeGenerator::GetWriteBarrierKind(instruction);
+  if (CodeGenerator::StoreNeedsWriteBarrier(
+          field_type, instruction->InputAt(1), write_barrier_kind)) {
     vixl32::Register temp = RegisterFrom(locations->GetTemp(0));
     vixl32::Register card = RegisterFrom(locations->GetTemp(1));
-    codegen_->MarkGCCard(temp, card, base, RegisterFrom(value), value_can_be_null);
+    codegen_->MarkGCCard(
+        temp,
+        card,
+        base,
+        RegisterFrom(value),
+        value_can_be_null && write_barrier_kind == WriteBarrierKind::kEmitWithNullCheck);
   }
 
   if (is_volatile) {
@@ -422,6 +422,8 @@ class InstructionCodeGeneratorARMVIXL : public InstructionCodeGenerator {
                              vixl::aarch32::Label* true_target,
                              vixl::aarch32::Label* false_target,
                              bool far_target = true);
+  // Increment the (saturating) counter of `cache` for the `taken` side of a branch.
+  void GenerateBranchProfileUpdate(BranchCache* cache, bool taken, vixl::aarch32::Register temp);
   void GenerateCompareTestAndBranch(HCondition* condition,
                                     vixl::aarch32::Label* true_target,
                                     vixl::aarch32::Label* false_target,
@@ -0,0 +1,6377 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_generator_loongarch64.h"
+
+#include "arch/loongarch64/asm_support_loongarch64.h"
+#include "arch/loongarch64/instruction_set_features_loongarch64.h"
+#include "arch/loongarch64/jni_frame_loongarch64.h"
+#include "art_method-inl.h"
+#include "base/bit_utils.h"
+#include "base/bit_utils_iterator.h"
+#include "class_table.h"
+#include "code_generator_utils.h"
+#include "compiled_method.h"
+#include "entrypoints/quick/quick_entrypoints.h"
+#include "entrypoints/quick/quick_entrypoints_enum.h"
+#include "gc/accounting/card_table.h"
+#include "gc/space/image_space.h"
+#include "heap_poisoning.h"
+#include "interpreter/mterp/nterp.h"
+#include "intrinsics.h"
+#include "jit/profiling_info.h"
+#include "linker/linker_patch.h"
+#include "lock_word.h"
+#include "mirror/array-inl.h"
+#include "mirror/class-inl.h"
+#include "offsets.h"
+#include "scoped_thread_state_change-inl.h"
+#include "stack_map_stream.h"
+#include "thread.h"
+#include "utils/assembler.h"
+#include "utils/loongarch64/assembler_loongarch64.h"
+#include "utils/stack_checks.h"
+
+namespace art {
+namespace loongarch64 {
+
+static constexpr int kCurrentMethodStackOffset = 0;
+static constexpr XRegister kMethodRegisterArgument = A0;
+
+// Placeholders for the PC-relative `pcaddu12i` + `addi.d`/`ld.*` pairs
+// that are filled in by the linker, see Loongarch64RelativePatcher.
+static constexpr int32_t kPcRelativePlaceholderHigh = 0x12345;
+static constexpr int32_t kPcRelativePlaceholderLow = 0x678;
+
+Location Loongarch64ReturnLocation(DataType::Type return_type) {
+  switch (return_type) {
+    case DataType::Type::kBool:
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kUint32:
+    case DataType::Type::kInt32:
+    case DataType::Type::kReference:
+    case DataType::Type::kUint64:
+    case DataType::Type::kInt64:
+      return Location::RegisterLocation(A0);
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      return Location::FpuRegisterLocation(FA0);
+
+    case DataType::Type::kVoid:
+      return Location();
+  }
+  UNREACHABLE();
+}
+
+Location InvokeDexCallingConventionVisitorLoongarch64::GetReturnLocation(DataType::Type type) const {
+  return Loongarch64ReturnLocation(type);
+}
+
+Location InvokeDexCallingConventionVisitorLoongarch64::GetMethodLocation() const {
+  return Location::RegisterLocation(kMethodRegisterArgument);
+}
+
+Location InvokeDexCallingConventionVisitorLoongarch64::GetNextLocation(DataType::Type type) {
+  Location next_location;
+  if (type == DataType::Type::kVoid) {
+    LOG(FATAL) << "Unexpected parameter type " << type;
+  }
+
+  if (DataType::IsFloatingPointType(type) &&
+      (float_index_ < calling_convention.GetNumberOfFpuRegisters())) {
+    next_location = Location::FpuRegisterLocation(
+        calling_convention.GetFpuRegisterAt(float_index_++));
+  } else if (!DataType::IsFloatingPointType(type) &&
+             (gp_index_ < calling_convention.GetNumberOfRegisters())) {
+    next_location = Location::RegisterLocation(calling_convention.GetRegisterAt(gp_index_++));
+  } else {
+    size_t stack_offset = calling_convention.GetStackOffsetOf(stack_index_);
+    next_location = DataType::Is64BitType(type) ? Location::DoubleStackSlot(stack_offset)
+                                                : Location::StackSlot(stack_offset);
+  }
+
+  // Space on the stack is reserved for all arguments.
+  stack_index_ += DataType::Is64BitType(type) ? 2 : 1;
+
+  return next_location;
+}
+
+Location CriticalNativeCallingConventionVisitorLoongarch64::GetNextLocation(DataType::Type type) {
+  DCHECK_NE(type, DataType::Type::kReference);
+
+  Location location = Location::NoLocation();
+  if (DataType::IsFloatingPointType(type)) {
+    if (fpr_index_ < kParameterFpuRegistersLength) {
+      location = Location::FpuRegisterLocation(kParameterFpuRegisters[fpr_index_]);
+      ++fpr_index_;
+    } else if (gpr_index_ < 1u + kParameterCoreRegistersLength) {
+      // The native ABI passes FP arguments in GPRs once the FP argument registers are used up.
+      location = Location::RegisterLocation(
+          gpr_index_ == 0u ? kMethodRegisterArgument : kParameterCoreRegisters[gpr_index_ - 1u]);
+      ++gpr_index_;
+    }
+  } else {
+    // Native ABI uses the same registers as managed, except that the method register A0
+    // is a normal argument.
+    if (gpr_index_ < 1u + kParameterCoreRegistersLength) {
+      location = Location::RegisterLocation(
+          gpr_index_ == 0u ? kMethodRegisterArgument : kParameterCoreRegisters[gpr_index_ - 1u]);
+      ++gpr_index_;
+    }
+  }
+  if (location.IsInvalid()) {
+    if (DataType::Is64BitType(type)) {
+      location = Location::DoubleStackSlot(stack_offset_);
+    } else {
+      location = Location::StackSlot(stack_offset_);
+    }
+    stack_offset_ += kFramePointerSize;
+
+    if (for_register_allocation_) {
+      location = Location::Any();
+    }
+  }
+  return location;
+}
+
+Location CriticalNativeCallingConventionVisitorLoongarch64::GetReturnLocation(
+    DataType::Type type) const {
+  // We perform conversion to the managed ABI return register after the call if needed.
+  InvokeDexCallingConventionVisitorLoongarch64 dex_calling_convention;
+  return dex_calling_convention.GetReturnLocation(type);
+}
+
+Location CriticalNativeCallingConventionVisitorLoongarch64::GetMethodLocation() const {
+  // Pass the method in the hidden argument T0.
+  return Location::RegisterLocation(T0);
+}
+
+Location InvokeRuntimeCallingConvention::GetReturnLocation(DataType::Type type) {
+  return Loongarch64ReturnLocation(type);
+}
+
+static RegisterSet OneRegInReferenceOutSaveEverythingCallerSaves() {
+  InvokeRuntimeCallingConvention calling_convention;
+  RegisterSet caller_saves = RegisterSet::Empty();
+  caller_saves.Add(Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+  DCHECK_EQ(calling_convention.GetRegisterAt(0),
+            calling_convention.GetReturnLocation(DataType::Type::kReference).AsRegister<XRegister>());
+  return caller_saves;
+}
+
+// The mark entrypoints are indexed by register number, but the Thread object only
+// holds 30 of them. Registers 2 and 3 (TP and SP) can never hold a reference, so the
+// entrypoints for S7 and S8 are installed in their slots instead.
+static int32_t ReadBarrierMarkEntrypointOffset(XRegister reg) {
+  DCHECK_NE(reg, TP);
+  DCHECK_NE(reg, SP);
+  size_t slot = static_cast<size_t>(reg);
+  if (reg == S7) {
+    slot = 2u;
+  } else if (reg == S8) {
+    slot = 3u;
+  }
+  return Thread::ReadBarrierMarkEntryPointsOffset<kLoongarch64PointerSize>(slot);
+}
+
+// NOLINT on __ macro to suppress wrong warning/fix (misc-macro-parentheses) from clang-tidy.
+#define __ down_cast<CodeGeneratorLoongarch64*>(codegen)->GetAssembler()->  // NOLINT
+#define QUICK_ENTRY_POINT(x) QUICK_ENTRYPOINT_OFFSET(kLoongarch64PointerSize, x).Int32Value()
+
+class BoundsCheckSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  explicit BoundsCheckSlowPathLoongarch64(HBoundsCheck* instruction)
+      : SlowPathCodeLoongarch64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    __ Bind(GetEntryLabel());
+    if (instruction_->CanThrowIntoCatchBlock()) {
+      // Live registers will be restored in the catch block if caught.
+      SaveLiveRegisters(codegen, instruction_->GetLocations());
+    }
+    // We're moving two locations to locations that could overlap, so we need a parallel
+    // move resolver.
+    InvokeRuntimeCallingConvention calling_convention;
+    codegen->EmitParallelMoves(locations->InAt(0),
+                               Location::RegisterLocation(calling_convention.GetRegisterAt(0)),
+                               DataType::Type::kInt32,
+                               locations->InAt(1),
+                               Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+                               DataType::Type::kInt32);
+    QuickEntrypointEnum entrypoint = instruction_->AsBoundsCheck()->IsStringCharAt()
+        ? kQuickThrowStringBounds
+        : kQuickThrowArrayBounds;
+    loongarch64_codegen->InvokeRuntime(entrypoint, instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickThrowStringBounds, void, int32_t, int32_t>();
+    CheckEntrypointTypes<kQuickThrowArrayBounds, void, int32_t, int32_t>();
+  }
+
+  bool IsFatal() const override { return true; }
+
+  const char* GetDescription() const override { return "BoundsCheckSlowPathLoongarch64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BoundsCheckSlowPathLoongarch64);
+};
+
+class DivZeroCheckSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  explicit DivZeroCheckSlowPathLoongarch64(HDivZeroCheck* instruction)
+      : SlowPathCodeLoongarch64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    __ Bind(GetEntryLabel());
+    loongarch64_codegen->InvokeRuntime(
+        kQuickThrowDivZero, instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickThrowDivZero, void, void>();
+  }
+
+  bool IsFatal() const override { return true; }
+
+  const char* GetDescription() const override { return "DivZeroCheckSlowPathLoongarch64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(DivZeroCheckSlowPathLoongarch64);
+};
+
+class LoadClassSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  LoadClassSlowPathLoongarch64(HLoadClass* cls, HInstruction* at)
+      : SlowPathCodeLoongarch64(at), cls_(cls) {
+    DCHECK(at->IsLoadClass() || at->IsClinitCheck());
+    DCHECK_EQ(instruction_->IsLoadClass(), cls_ == instruction_);
+  }
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    Location out = locations->Out();
+    const uint32_t dex_pc = instruction_->GetDexPc();
+    bool must_resolve_type = instruction_->IsLoadClass() && cls_->MustResolveTypeOnSlowPath();
+    bool must_do_clinit = instruction_->IsClinitCheck() || cls_->MustGenerateClinitCheck();
+
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    if (must_resolve_type) {
+      DCHECK(IsSameDexFile(cls_->GetDexFile(), loongarch64_codegen->GetGraph()->GetDexFile()));
+      dex::TypeIndex type_index = cls_->GetTypeIndex();
+      __ LoadConst32(calling_convention.GetRegisterAt(0), type_index.index_);
+      if (cls_->NeedsAccessCheck()) {
+        CheckEntrypointTypes<kQuickResolveTypeAndVerifyAccess, void*, uint32_t>();
+        loongarch64_codegen->InvokeRuntime(
+            kQuickResolveTypeAndVerifyAccess, instruction_, dex_pc, this);
+      } else {
+        CheckEntrypointTypes<kQuickResolveType, void*, uint32_t>();
+        loongarch64_codegen->InvokeRuntime(kQuickResolveType, instruction_, dex_pc, this);
+      }
+      // If we also must_do_clinit, the resolved type is now in the correct register.
+    } else {
+      DCHECK(must_do_clinit);
+      Location source = instruction_->IsLoadClass() ? out : locations->InAt(0);
+      loongarch64_codegen->MoveLocation(
+          Location::RegisterLocation(calling_convention.GetRegisterAt(0)),
+          source,
+          cls_->GetType());
+    }
+    if (must_do_clinit) {
+      loongarch64_codegen->InvokeRuntime(kQuickInitializeStaticStorage, instruction_, dex_pc, this);
+      CheckEntrypointTypes<kQuickInitializeStaticStorage, void*, mirror::Class*>();
+    }
+
+    // Move the class to the desired location.
+    if (out.IsValid()) {
+      DCHECK(out.IsRegister() && !locations->GetLiveRegisters()->ContainsCoreRegister(out.reg()));
+      DataType::Type type = instruction_->GetType();
+      loongarch64_codegen->MoveLocation(out, calling_convention.GetReturnLocation(type), type);
+    }
+    RestoreLiveRegisters(codegen, locations);
+
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "LoadClassSlowPathLoongarch64"; }
+
+ private:
+  // The class this slow path will load.
+  HLoadClass* const cls_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadClassSlowPathLoongarch64);
+};
+
+class LoadStringSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  explicit LoadStringSlowPathLoongarch64(HLoadString* instruction)
+      : SlowPathCodeLoongarch64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    DCHECK(instruction_->IsLoadString());
+    DCHECK_EQ(instruction_->AsLoadString()->GetLoadKind(), HLoadString::LoadKind::kBssEntry);
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+    const dex::StringIndex string_index = instruction_->AsLoadString()->GetStringIndex();
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    InvokeRuntimeCallingConvention calling_convention;
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    __ LoadConst32(calling_convention.GetRegisterAt(0), string_index.index_);
+    loongarch64_codegen->InvokeRuntime(kQuickResolveString,
+                                       instruction_,
+                                       instruction_->GetDexPc(),
+                                       this);
+    CheckEntrypointTypes<kQuickResolveString, void*, uint32_t>();
+
+    DataType::Type type = instruction_->GetType();
+    loongarch64_codegen->MoveLocation(locations->Out(),
+                                      calling_convention.GetReturnLocation(type),
+                                      type);
+    RestoreLiveRegisters(codegen, locations);
+
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "LoadStringSlowPathLoongarch64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathLoongarch64);
+};
+
+class NullCheckSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  explicit NullCheckSlowPathLoongarch64(HNullCheck* instr) : SlowPathCodeLoongarch64(instr) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    __ Bind(GetEntryLabel());
+    if (instruction_->CanThrowIntoCatchBlock()) {
+      // Live registers will be restored in the catch block if caught.
+      SaveLiveRegisters(codegen, instruction_->GetLocations());
+    }
+    loongarch64_codegen->InvokeRuntime(kQuickThrowNullPointer,
+                                       instruction_,
+                                       instruction_->GetDexPc(),
+                                       this);
+    CheckEntrypointTypes<kQuickThrowNullPointer, void, void>();
+  }
+
+  bool IsFatal() const override { return true; }
+
+  const char* GetDescription() const override { return "NullCheckSlowPathLoongarch64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NullCheckSlowPathLoongarch64);
+};
+
+class SuspendCheckSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  SuspendCheckSlowPathLoongarch64(HSuspendCheck* instruction, HBasicBlock* successor)
+      : SlowPathCodeLoongarch64(instruction), successor_(successor) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);  // Only saves live vector registers for SIMD.
+    loongarch64_codegen->InvokeRuntime(
+        kQuickTestSuspend, instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickTestSuspend, void, void>();
+    RestoreLiveRegisters(codegen, locations);  // Only restores live vector registers for SIMD.
+    if (successor_ == nullptr) {
+      __ B(GetReturnLabel());
+    } else {
+      __ B(loongarch64_codegen->GetLabelOf(successor_));
+    }
+  }
+
+  Loongarch64Label* GetReturnLabel() {
+    DCHECK(successor_ == nullptr);
+    return &return_label_;
+  }
+
+  const char* GetDescription() const override { return "SuspendCheckSlowPathLoongarch64"; }
+
+  HBasicBlock* GetSuccessor() const {
+    return successor_;
+  }
+
+ private:
+  // If not null, the block to branch to after the suspend check.
+  HBasicBlock* const successor_;
+
+  // If `successor_` is null, the label to branch to after the suspend check.
+  Loongarch64Label return_label_;
+
+  DISALLOW_COPY_AND_ASSIGN(SuspendCheckSlowPathLoongarch64);
+};
+
+class TypeCheckSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  explicit TypeCheckSlowPathLoongarch64(HInstruction* instruction, bool is_fatal)
+      : SlowPathCodeLoongarch64(instruction), is_fatal_(is_fatal) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+
+    uint32_t dex_pc = instruction_->GetDexPc();
+    DCHECK(instruction_->IsCheckCast()
+           || !locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+
+    __ Bind(GetEntryLabel());
+    if (!is_fatal_ || instruction_->CanThrowIntoCatchBlock()) {
+      SaveLiveRegisters(codegen, locations);
+    }
+
+    // We're moving two locations to locations that could overlap, so we need a parallel
+    // move resolver.
+    InvokeRuntimeCallingConvention calling_convention;
+    codegen->EmitParallelMoves(locations->InAt(0),
+                               Location::RegisterLocation(calling_convention.GetRegisterAt(0)),
+                               DataType::Type::kReference,
+                               locations->InAt(1),
+                               Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+                               DataType::Type::kReference);
+    if (instruction_->IsInstanceOf()) {
+      loongarch64_codegen->InvokeRuntime(kQuickInstanceofNonTrivial, instruction_, dex_pc, this);
+      CheckEntrypointTypes<kQuickInstanceofNonTrivial, size_t, mirror::Object*, mirror::Class*>();
+      DataType::Type ret_type = instruction_->GetType();
+      Location ret_loc = calling_convention.GetReturnLocation(ret_type);
+      loongarch64_codegen->MoveLocation(locations->Out(), ret_loc, ret_type);
+    } else {
+      DCHECK(instruction_->IsCheckCast());
+      loongarch64_codegen->InvokeRuntime(kQuickCheckInstanceOf, instruction_, dex_pc, this);
+      CheckEntrypointTypes<kQuickCheckInstanceOf, void, mirror::Object*, mirror::Class*>();
+    }
+
+    if (!is_fatal_) {
+      RestoreLiveRegisters(codegen, locations);
+      __ B(GetExitLabel());
+    }
+  }
+
+  const char* GetDescription() const override { return "TypeCheckSlowPathLoongarch64"; }
+
+  bool IsFatal() const override { return is_fatal_; }
+
+ private:
+  const bool is_fatal_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeCheckSlowPathLoongarch64);
+};
+
+class DeoptimizationSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  explicit DeoptimizationSlowPathLoongarch64(HDeoptimize* instruction)
+    : SlowPathCodeLoongarch64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    __ Bind(GetEntryLabel());
+    LocationSummary* locations = instruction_->GetLocations();
+    SaveLiveRegisters(codegen, locations);
+    InvokeRuntimeCallingConvention calling_convention;
+    __ LoadConst32(calling_convention.GetRegisterAt(0),
+                   static_cast<uint32_t>(instruction_->AsDeoptimize()->GetDeoptimizationKind()));
+    loongarch64_codegen->InvokeRuntime(kQuickDeoptimize, instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickDeoptimize, void, DeoptimizationKind>();
+  }
+
+  const char* GetDescription() const override { return "DeoptimizationSlowPathLoongarch64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(DeoptimizationSlowPathLoongarch64);
+};
+
+class ArraySetSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  explicit ArraySetSlowPathLoongarch64(HInstruction* instruction)
+      : SlowPathCodeLoongarch64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    HParallelMove parallel_move(codegen->GetGraph()->GetAllocator());
+    parallel_move.AddMove(
+        locations->InAt(0),
+        Location::RegisterLocation(calling_convention.GetRegisterAt(0)),
+        DataType::Type::kReference,
+        nullptr);
+    parallel_move.AddMove(
+        locations->InAt(1),
+        Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+        DataType::Type::kInt32,
+        nullptr);
+    parallel_move.AddMove(
+        locations->InAt(2),
+        Location::RegisterLocation(calling_convention.GetRegisterAt(2)),
+        DataType::Type::kReference,
+        nullptr);
+    codegen->GetMoveResolver()->EmitNativeCode(&parallel_move);
+
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    loongarch64_codegen->InvokeRuntime(kQuickAputObject, instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickAputObject, void, mirror::Array*, int32_t, mirror::Object*>();
+    RestoreLiveRegisters(codegen, locations);
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "ArraySetSlowPathLoongarch64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ArraySetSlowPathLoongarch64);
+};
+
+// Slow path marking an object reference `ref` during a read barrier.
+//
+// The mark entrypoint for the register holding `ref` is loaded into `entrypoint`
+// by the fast path; it is null when the GC is not marking. The entrypoint takes
+// and returns the reference in the same register and preserves all other
+// registers, so there is no need to save live registers here.
+class ReadBarrierMarkSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  ReadBarrierMarkSlowPathLoongarch64(HInstruction* instruction, Location ref, Location entrypoint)
+      : SlowPathCodeLoongarch64(instruction), ref_(ref), entrypoint_(entrypoint) {
+    DCHECK(kEmitCompilerReadBarrier);
+    DCHECK(entrypoint.IsRegister());
+  }
+
+  const char* GetDescription() const override { return "ReadBarrierMarkSlowPathLoongarch64"; }
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    XRegister ref_reg = ref_.AsRegister<XRegister>();
+    DCHECK(locations->CanCall());
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(ref_reg)) << ref_reg;
+    DCHECK(instruction_->IsInstanceFieldGet() ||
+           instruction_->IsPredicatedInstanceFieldGet() ||
+           instruction_->IsStaticFieldGet() ||
+           instruction_->IsArrayGet() ||
+           instruction_->IsLoadClass() ||
+           instruction_->IsLoadString() ||
+           instruction_->IsInstanceOf() ||
+           instruction_->IsCheckCast() ||
+           (instruction_->IsInvoke() && instruction_->GetLocations()->Intrinsified()))
+        << "Unexpected instruction in read barrier marking slow path: "
+        << instruction_->DebugName();
+
+    __ Bind(GetEntryLabel());
+    // No need to save live registers; it's taken care of by the
+    // entrypoint. Also, there is no need to update the stack mask,
+    // as this runtime call will not trigger a garbage collection.
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    DCHECK(ref_reg >= A0 && ref_reg != TR && ref_reg != TMP && ref_reg != TMP2) << ref_reg;
+    // "Compact" slow path, saving two moves.
+    //
+    // Instead of using the standard runtime calling convention (input
+    // and output in A0):
+    //
+    //   A0 <- ref
+    //   A0 <- ReadBarrierMark(A0)
+    //   ref <- A0
+    //
+    // we just use rX (the register containing `ref`) as input and output
+    // of a dedicated entrypoint:
+    //
+    //   rX <- ReadBarrierMarkRegX(rX)
+    //
+    loongarch64_codegen->ValidateInvokeRuntimeWithoutRecordingPcInfo(instruction_, this);
+    __ Jalr(entrypoint_.AsRegister<XRegister>());
+    __ B(GetExitLabel());
+  }
+
+ private:
+  // The location (register) of the marked object reference.
+  const Location ref_;
+
+  // The location of the already loaded entrypoint.
+  const Location entrypoint_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadBarrierMarkSlowPathLoongarch64);
+};
+
+// Slow path generating a read barrier for a heap reference.
+class ReadBarrierForHeapReferenceSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  ReadBarrierForHeapReferenceSlowPathLoongarch64(HInstruction* instruction,
+                                                 Location out,
+                                                 Location ref,
+                                                 Location obj,
+                                                 uint32_t offset,
+                                                 Location index)
+      : SlowPathCodeLoongarch64(instruction),
+        out_(out),
+        ref_(ref),
+        obj_(obj),
+        offset_(offset),
+        index_(index) {
+    DCHECK(kEmitCompilerReadBarrier);
+    // If `obj` is equal to `out` or `ref`, it means the initial object
+    // has been overwritten by (or after) the heap object reference load
+    // to be instrumented, e.g.:
+    //
+    //   __ LoadFromOffset(kLoadUnsignedWord, out, out, offset);
+    //   codegen_->GenerateReadBarrierSlow(instruction, out_loc, out_loc, out_loc, offset);
+    //
+    // In that case, we have lost the information about the original
+    // object, and the emitted read barrier cannot work properly.
+    DCHECK(!obj.Equals(out)) << "obj=" << obj << " out=" << out;
+    DCHECK(!obj.Equals(ref)) << "obj=" << obj << " ref=" << ref;
+  }
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    LocationSummary* locations = instruction_->GetLocations();
+    DataType::Type type = DataType::Type::kReference;
+    XRegister reg_out = out_.AsRegister<XRegister>();
+    DCHECK(locations->CanCall());
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(reg_out));
+    DCHECK(instruction_->IsInstanceFieldGet() ||
+           instruction_->IsPredicatedInstanceFieldGet() ||
+           instruction_->IsStaticFieldGet() ||
+           instruction_->IsArrayGet() ||
+           instruction_->IsInstanceOf() ||
+           instruction_->IsCheckCast() ||
+           (instruction_->IsInvoke() && instruction_->GetLocations()->Intrinsified()))
+        << "Unexpected instruction in read barrier for heap reference slow path: "
+        << instruction_->DebugName();
+
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    // We may have to change the index's value, but as `index_` is a
+    // constant member (like other "inputs" of this slow path),
+    // introduce a copy of it, `index`.
+    Location index = index_;
+    if (index_.IsValid()) {
+      // Handle `index_` for HArrayGet and UnsafeGetObject/UnsafeGetObjectVolatile intrinsics.
+      if (instruction_->IsArrayGet()) {
+        // Compute the actual memory offset and store it in `index`.
+        XRegister index_reg = index_.AsRegister<XRegister>();
+        DCHECK(locations->GetLiveRegisters()->ContainsCoreRegister(index_reg));
+        if (codegen->IsCoreCalleeSaveRegister(index_reg)) {
+          // We are about to change the value of `index_reg` (see the
+          // calls to art::loongarch64::Loongarch64Assembler::SlliD and
+          // art::loongarch64::Loongarch64Assembler::AddiD below), but it
+          // has not been saved by the previous call to
+          // art::SlowPathCode::SaveLiveRegisters, as it is a
+          // callee-save register --
+          // art::SlowPathCode::SaveLiveRegisters does not consider
+          // callee-save registers, as it has been designed with the
+          // assumption that callee-save registers are supposed to be
+          // handled by the called function.  So, as a callee-save
+          // register, `index_reg` _would_ eventually be saved onto
+          // the stack, but it would be too late: we would have
+          // changed its value earlier.  Therefore, we manually save
+          // it here into another freely available register,
+          // `free_reg`, chosen of course among the caller-save
+          // registers (as a callee-save `free_reg` register would
+          // exhibit the same problem).
+          //
+          // Note we could have requested a temporary register from
+          // the register allocator instead; but we prefer not to, as
+          // this is a slow path, and we know we can find a
+          // caller-save register that is available.
+          XRegister free_reg = FindAvailableCallerSaveRegister(codegen);
+          __ Move(free_reg, index_reg);
+          index_reg = free_reg;
+          index = Location::RegisterLocation(index_reg);
+        } else {
+          // The initial register stored in `index_` has already been
+          // saved in the call to art::SlowPathCode::SaveLiveRegisters
+          // (as it is not a callee-save register), so we can freely
+          // use it.
+        }
+        // Shifting the index value contained in `index_reg` by the scale
+        // factor (2) cannot overflow in practice, as the runtime is
+        // unable to allocate object arrays with a size larger than
+        // 2^26 - 1 (that is, 2^28 - 4 bytes).
+        __ SlliD(index_reg, index_reg, DataType::SizeShift(type));
+        static_assert(
+            sizeof(mirror::HeapReference<mirror::Object>) == sizeof(int32_t),
+            "art::mirror::HeapReference<art::mirror::Object> and int32_t have different sizes.");
+        __ AddConst64(index_reg, index_reg, offset_);
+      } else {
+        // In the case of the UnsafeGetObject/UnsafeGetObjectVolatile
+        // intrinsics, `index_` is not shifted by a scale factor of 2
+        // (as in the case of ArrayGet), as it is actually an offset
+        // to an object field within an object.
+        DCHECK(instruction_->IsInvoke()) << instruction_->DebugName();
+        DCHECK(instruction_->GetLocations()->Intrinsified());
+        DCHECK_EQ(offset_, 0U);
+        DCHECK(index_.IsRegister());
+      }
+    }
+
+    // We're moving two or three locations to locations that could
+    // overlap, so we need a parallel move resolver.
+    InvokeRuntimeCallingConvention calling_convention;
+    HParallelMove parallel_move(codegen->GetGraph()->GetAllocator());
+    parallel_move.AddMove(ref_,
+                          Location::RegisterLocation(calling_convention.GetRegisterAt(0)),
+                          DataType::Type::kReference,
+                          nullptr);
+    parallel_move.AddMove(obj_,
+                          Location::RegisterLocation(calling_convention.GetRegisterAt(1)),
+                          DataType::Type::kReference,
+                          nullptr);
+    if (index.IsValid()) {
+      parallel_move.AddMove(index,
+                            Location::RegisterLocation(calling_convention.GetRegisterAt(2)),
+                            DataType::Type::kInt32,
+                            nullptr);
+      codegen->GetMoveResolver()->EmitNativeCode(&parallel_move);
+    } else {
+      codegen->GetMoveResolver()->EmitNativeCode(&parallel_move);
+      __ LoadConst32(calling_convention.GetRegisterAt(2), offset_);
+    }
+    loongarch64_codegen->InvokeRuntime(kQuickReadBarrierSlow,
+                                       instruction_,
+                                       instruction_->GetDexPc(),
+                                       this);
+    CheckEntrypointTypes<
+        kQuickReadBarrierSlow, mirror::Object*, mirror::Object*, mirror::Object*, uint32_t>();
+    loongarch64_codegen->MoveLocation(out_, calling_convention.GetReturnLocation(type), type);
+
+    RestoreLiveRegisters(codegen, locations);
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override {
+    return "ReadBarrierForHeapReferenceSlowPathLoongarch64";
+  }
+
+ private:
+  XRegister FindAvailableCallerSaveRegister(CodeGenerator* codegen) {
+    size_t ref = static_cast<int>(ref_.AsRegister<XRegister>());
+    size_t obj = static_cast<int>(obj_.AsRegister<XRegister>());
+    for (size_t i = 0, e = codegen->GetNumberOfCoreRegisters(); i < e; ++i) {
+      if (i != ref &&
+          i != obj &&
+          !codegen->IsCoreCalleeSaveRegister(i) &&
+          !codegen->IsBlockedCoreRegister(i)) {
+        return static_cast<XRegister>(i);
+      }
+    }
+    // We shall never fail to find a free caller-save register, as
+    // there are more than two core caller-save registers on LOONGARCH64
+    // (meaning it is possible to find one which is different from
+    // `ref` and `obj`).
+    DCHECK_GT(codegen->GetNumberOfCoreCallerSaveRegisters(), 2u);
+    LOG(FATAL) << "Could not find a free caller-save register";
+    UNREACHABLE();
+  }
+
+  const Location out_;
+  const Location ref_;
+  const Location obj_;
+  const uint32_t offset_;
+  // An additional location containing an index to an array.
+  // Only used for HArrayGet and the UnsafeGetObject &
+  // UnsafeGetObjectVolatile intrinsics.
+  const Location index_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadBarrierForHeapReferenceSlowPathLoongarch64);
+};
+
+// Slow path generating a read barrier for a GC root.
+class ReadBarrierForRootSlowPathLoongarch64 : public SlowPathCodeLoongarch64 {
+ public:
+  ReadBarrierForRootSlowPathLoongarch64(HInstruction* instruction, Location out, Location root)
+      : SlowPathCodeLoongarch64(instruction), out_(out), root_(root) {
+    DCHECK(kEmitCompilerReadBarrier);
+  }
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    DataType::Type type = DataType::Type::kReference;
+    XRegister reg_out = out_.AsRegister<XRegister>();
+    DCHECK(locations->CanCall());
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(reg_out));
+    DCHECK(instruction_->IsLoadClass() ||
+           instruction_->IsLoadString() ||
+           (instruction_->IsInvoke() && instruction_->GetLocations()->Intrinsified()))
+        << "Unexpected instruction in read barrier for GC root slow path: "
+        << instruction_->DebugName();
+
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    CodeGeneratorLoongarch64* loongarch64_codegen = down_cast<CodeGeneratorLoongarch64*>(codegen);
+    // The argument of the ReadBarrierForRootSlow is not a managed
+    // reference (`mirror::Object*`), but a `GcRoot<mirror::Object>*`;
+    // thus we need a 64-bit move here.
+    __ Move(calling_convention.GetRegisterAt(0), root_.AsRegister<XRegister>());
+    loongarch64_codegen->InvokeRuntime(kQuickReadBarrierForRootSlow,
+                                       instruction_,
+                                       instruction_->GetDexPc(),
+                                       this);
+    CheckEntrypointTypes<kQuickReadBarrierForRootSlow, mirror::Object*, GcRoot<mirror::Object>*>();
+    loongarch64_codegen->MoveLocation(out_, calling_convention.GetReturnLocation(type), type);
+
+    RestoreLiveRegisters(codegen, locations);
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "ReadBarrierForRootSlowPathLoongarch64"; }
+
+ private:
+  const Location out_;
+  const Location root_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadBarrierForRootSlowPathLoongarch64);
+};
+
+#undef __
+
+static dwarf::Reg DWARFReg(XRegister reg) {
+  return dwarf::Reg::Loongarch64Core(static_cast<int>(reg));
+}
+
+static dwarf::Reg DWARFReg(FRegister reg) {
+  return dwarf::Reg::Loongarch64Fp(static_cast<int>(reg));
+}
+
+CodeGeneratorLoongarch64::CodeGeneratorLoongarch64(HGraph* graph,
+                                                   const CompilerOptions& compiler_options,
+                                                   OptimizingCompilerStats* stats)
+    : CodeGenerator(graph,
+                    kNumberOfXRegisters,
+                    kNumberOfFRegisters,
+                    /* number_of_register_pairs= */ 0,
+                    ComputeRegisterMask(reinterpret_cast<const int*>(kCoreCalleeSaves),
+                                        arraysize(kCoreCalleeSaves)),
+                    ComputeRegisterMask(reinterpret_cast<const int*>(kFpuCalleeSaves),
+                                        arraysize(kFpuCalleeSaves)),
+                    compiler_options,
+                    stats),
+      block_labels_(nullptr),
+      location_builder_(graph, this),
+      instruction_visitor_(graph, this),
+      move_resolver_(graph->GetAllocator(), this),
+      assembler_(graph->GetAllocator(),
+                 compiler_options.GetInstructionSetFeatures()->AsLoongarch64InstructionSetFeatures()),
+      boot_image_method_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      method_bss_entry_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      boot_image_type_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      type_bss_entry_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      public_type_bss_entry_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      package_type_bss_entry_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      boot_image_string_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      string_bss_entry_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      boot_image_jni_entrypoint_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      boot_image_other_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      jit_string_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      jit_class_patches_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)) {
+  // Save RA (containing the return address) to mimic Quick.
+  AddAllocatedRegister(Location::RegisterLocation(RA));
+}
+
+#define __ GetAssembler()->
+
+void CodeGeneratorLoongarch64::Finalize(CodeAllocator* allocator) {
+  // Ensure that we fix up branches.
+  __ FinalizeCode();
+
+  // Adjust native pc offsets in stack maps.
+  StackMapStream* stack_map_stream = GetStackMapStream();
+  for (size_t i = 0, num = stack_map_stream->GetNumberOfStackMaps(); i != num; ++i) {
+    uint32_t old_position = stack_map_stream->GetStackMapNativePcOffset(i);
+    uint32_t new_position = __ GetAdjustedPosition(old_position);
+    DCHECK_GE(new_position, old_position);
+    stack_map_stream->SetStackMapNativePcOffset(i, new_position);
+  }
+
+  // Adjust pc offsets for the disassembly information.
+  if (disasm_info_ != nullptr) {
+    GeneratedCodeInterval* frame_entry_interval = disasm_info_->GetFrameEntryInterval();
+    frame_entry_interval->start = __ GetAdjustedPosition(frame_entry_interval->start);
+    frame_entry_interval->end = __ GetAdjustedPosition(frame_entry_interval->end);
+    for (auto& it : *disasm_info_->GetInstructionIntervals()) {
+      it.second.start = __ GetAdjustedPosition(it.second.start);
+      it.second.end = __ GetAdjustedPosition(it.second.end);
+    }
+    for (auto& it : *disasm_info_->GetSlowPathIntervals()) {
+      it.code_interval.start = __ GetAdjustedPosition(it.code_interval.start);
+      it.code_interval.end = __ GetAdjustedPosition(it.code_interval.end);
+    }
+  }
+
+  CodeGenerator::Finalize(allocator);
+}
+
+Loongarch64Assembler* ParallelMoveResolverLoongarch64::GetAssembler() const {
+  return codegen_->GetAssembler();
+}
+
+void ParallelMoveResolverLoongarch64::EmitMove(size_t index) {
+  MoveOperands* move = moves_[index];
+  codegen_->MoveLocation(move->GetDestination(), move->GetSource(), move->GetType());
+}
+
+void ParallelMoveResolverLoongarch64::EmitSwap(size_t index) {
+  MoveOperands* move = moves_[index];
+  codegen_->SwapLocations(move->GetDestination(), move->GetSource(), move->GetType());
+}
+
+void ParallelMoveResolverLoongarch64::RestoreScratch(int reg) {
+  // Pop reg
+  __ LdD(XRegister(reg), SP, 0);
+  __ AddiD(SP, SP, kLoongarch64WordSize);
+  __ cfi().AdjustCFAOffset(-kLoongarch64WordSize);
+}
+
+void ParallelMoveResolverLoongarch64::SpillScratch(int reg) {
+  // Push reg
+  __ AddiD(SP, SP, -kLoongarch64WordSize);
+  __ cfi().AdjustCFAOffset(kLoongarch64WordSize);
+  __ StD(XRegister(reg), SP, 0);
+}
+
+void ParallelMoveResolverLoongarch64::Exchange(int index1, int index2, bool double_slot) {
+  LoadOperandType load_type = double_slot ? kLoadDoubleword : kLoadWord;
+  StoreOperandType store_type = double_slot ? kStoreDoubleword : kStoreWord;
+  // Allocate a scratch register other than TMP, which the load/store macros may
+  // need for offsets that do not fit the instruction encoding, and use FTMP as
+  // the second scratch register.
+  XRegister tmp_reg = TMP2;
+  __ LoadFromOffset(load_type, tmp_reg, SP, index1);
+  __ LoadFpuFromOffset(load_type, FTMP, SP, index2);
+  __ StoreToOffset(store_type, tmp_reg, SP, index2);
+  __ StoreFpuToOffset(store_type, FTMP, SP, index1);
+}
+
+void CodeGeneratorLoongarch64::ComputeSpillMask() {
+  core_spill_mask_ = allocated_registers_.GetCoreRegisters() & core_callee_save_mask_;
+  fpu_spill_mask_ = allocated_registers_.GetFloatingPointRegisters() & fpu_callee_save_mask_;
+  // The runtime expects at least one callee-save register besides RA in every
+  // non-empty frame (see Loongarch64Context::FillCalleeSaves), so always spill FP.
+  core_spill_mask_ |= (1u << FP);
+}
+
+void CodeGeneratorLoongarch64::GenerateFrameEntry() {
+  __ Bind(&frame_entry_label_);
+
+  bool do_overflow_check =
+      FrameNeedsStackCheck(GetFrameSize(), InstructionSet::kLoongarch64) || !IsLeafMethod();
+
+  if (do_overflow_check) {
+    DCHECK(GetCompilerOptions().GetImplicitStackOverflowChecks());
+    __ AddConst64(
+        TMP,
+        SP,
+        -static_cast<int64_t>(GetStackOverflowReservedBytes(InstructionSet::kLoongarch64)));
+    __ LdW(Zero, TMP, 0);
+    RecordPcInfo(nullptr, 0);
+  }
+
+  if (!HasEmptyFrame()) {
+    // Stack layout:
+    //      sp[frame_size - 8]        : ra.
+    //      ...                       : other preserved core registers.
+    //      ...                       : other preserved fp registers.
+    //      ...                       : reserved frame space.
+    //      sp[0]                     : current method.
+    int32_t frame_size = dchecked_integral_cast<int32_t>(GetFrameSize());
+    __ AddConst64(SP, SP, -frame_size);
+    __ cfi().AdjustCFAOffset(frame_size);
+
+    // Save callee-saved registers in the order expected by Loongarch64Context::FillCalleeSaves:
+    // RA at the top, then the other core registers and the FP registers, highest first.
+    int32_t ofs = frame_size;
+    ofs -= kLoongarch64WordSize;
+    __ StoreToOffset(kStoreDoubleword, RA, SP, ofs);
+    __ cfi().RelOffset(DWARFReg(RA), ofs);
+    for (uint32_t reg : HighToLowBits(core_spill_mask_ & ~(1u << RA))) {
+      ofs -= kLoongarch64WordSize;
+      __ StoreToOffset(kStoreDoubleword, XRegister(reg), SP, ofs);
+      __ cfi().RelOffset(DWARFReg(XRegister(reg)), ofs);
+    }
+    for (uint32_t reg : HighToLowBits(fpu_spill_mask_)) {
+      ofs -= kLoongarch64WordSize;
+      __ StoreFpuToOffset(kStoreDoubleword, FRegister(reg), SP, ofs);
+      __ cfi().RelOffset(DWARFReg(FRegister(reg)), ofs);
+    }
+
+    // Save the current method if we need it. Note that we do not
+    // do this in HCurrentMethod, as the instruction might have been removed
+    // in the SSA graph.
+    if (RequiresCurrentMethod()) {
+      __ StoreToOffset(kStoreDoubleword, kMethodRegisterArgument, SP, kCurrentMethodStackOffset);
+    }
+
+    if (GetGraph()->HasShouldDeoptimizeFlag()) {
+      // Initialize should_deoptimize flag to 0.
+      __ StoreToOffset(kStoreWord, Zero, SP, GetStackOffsetOfShouldDeoptimizeFlag());
+    }
+  }
+  MaybeIncrementHotness(/* is_frame_entry= */ true);
+}
+
+void CodeGeneratorLoongarch64::GenerateFrameExit() {
+  __ cfi().RememberState();
+
+  if (!HasEmptyFrame()) {
+    // Restore callee-saved registers in the reverse order of GenerateFrameEntry().
+    int32_t frame_size = dchecked_integral_cast<int32_t>(GetFrameSize());
+    int32_t ofs = frame_size - dchecked_integral_cast<int32_t>(FrameEntrySpillSize());
+    for (uint32_t reg : LowToHighBits(fpu_spill_mask_)) {
+      __ LoadFpuFromOffset(kLoadDoubleword, FRegister(reg), SP, ofs);
+      __ cfi().Restore(DWARFReg(FRegister(reg)));
+      ofs += kLoongarch64WordSize;
+    }
+    for (uint32_t reg : LowToHighBits(core_spill_mask_ & ~(1u << RA))) {
+      __ LoadFromOffset(kLoadDoubleword, XRegister(reg), SP, ofs);
+      __ cfi().Restore(DWARFReg(XRegister(reg)));
+      ofs += kLoongarch64WordSize;
+    }
+    DCHECK_EQ(ofs, frame_size - static_cast<int32_t>(kLoongarch64WordSize));
+    __ LoadFromOffset(kLoadDoubleword, RA, SP, ofs);
+    __ cfi().Restore(DWARFReg(RA));
+
+    __ AddConst64(SP, SP, frame_size);
+    __ cfi().AdjustCFAOffset(-frame_size);
+  }
+
+  __ Ret();
+
+  __ cfi().RestoreState();
+  __ cfi().DefCFAOffset(GetFrameSize());
+}
+
+void CodeGeneratorLoongarch64::Bind(HBasicBlock* block) {
+  __ Bind(GetLabelOf(block));
+}
+
+void CodeGeneratorLoongarch64::MoveLocation(Location destination,
+                                            Location source,
+                                            DataType::Type dst_type) {
+  if (source.Equals(destination)) {
+    return;
+  }
+
+  // A valid move can always be inferred from the destination and source
+  // locations. When moving from and to a register, the argument type can be
+  // used to generate 32bit instead of 64bit moves.
+  bool unspecified_type = (dst_type == DataType::Type::kVoid);
+
+  if (destination.IsRegister() || destination.IsFpuRegister()) {
+    if (unspecified_type) {
+      HConstant* src_cst = source.IsConstant() ? source.GetConstant() : nullptr;
+      if (source.IsStackSlot() ||
+          (src_cst != nullptr && (src_cst->IsIntConstant()
+                                  || src_cst->IsFloatConstant()
+                                  || src_cst->IsNullConstant()))) {
+        // For stack slots and 32bit constants, a 32bit type is appropriate.
+        dst_type = destination.IsRegister() ? DataType::Type::kInt32 : DataType::Type::kFloat32;
+      } else {
+        // If the source is a double stack slot or a 64bit constant, a 64bit
+        // type is appropriate. Else the source is a register, and since the
+        // type has not been specified, we chose a 64bit type to force a 64bit
+        // move.
+        dst_type = destination.IsRegister() ? DataType::Type::kInt64 : DataType::Type::kFloat64;
+      }
+    }
+    DCHECK((destination.IsFpuRegister() && DataType::IsFloatingPointType(dst_type)) ||
+           (destination.IsRegister() && !DataType::IsFloatingPointType(dst_type)));
+    if (source.IsStackSlot() || source.IsDoubleStackSlot()) {
+      // Move to GPR/FPR from stack
+      if (DataType::IsFloatingPointType(dst_type)) {
+        LoadOperandType load_type = source.IsStackSlot() ? kLoadWord : kLoadDoubleword;
+        __ LoadFpuFromOffset(load_type,
+                             destination.AsFpuRegister<FRegister>(),
+                             SP,
+                             source.GetStackIndex());
+      } else {
+        // References are kept zero-extended in registers, other 32-bit values sign-extended.
+        LoadOperandType load_type = source.IsDoubleStackSlot()
+            ? kLoadDoubleword
+            : (dst_type == DataType::Type::kReference ? kLoadUnsignedWord : kLoadWord);
+        __ LoadFromOffset(load_type,
+                          destination.AsRegister<XRegister>(),
+                          SP,
+                          source.GetStackIndex());
+      }
+    } else if (source.IsSIMDStackSlot()) {
+      // Move to SIMD register from SIMD stack slot
+      DCHECK(destination.IsFpuRegister());
+      __ LoadVFromOffset(destination.AsFpuRegister<VRegister>(), SP, source.GetStackIndex());
+    } else if (source.IsConstant()) {
+      // Move to GPR/FPR from constant
+      XRegister gpr = TMP2;
+      if (!DataType::IsFloatingPointType(dst_type)) {
+        gpr = destination.AsRegister<XRegister>();
+      }
+      if (dst_type == DataType::Type::kInt32 || dst_type == DataType::Type::kFloat32) {
+        int32_t value = GetInt32ValueOf(source.GetConstant()->AsConstant());
+        if (DataType::IsFloatingPointType(dst_type) && value == 0) {
+          gpr = Zero;
+        } else {
+          __ LoadConst32(gpr, value);
+        }
+      } else {
+        int64_t value = GetInt64ValueOf(source.GetConstant()->AsConstant());
+        if (DataType::IsFloatingPointType(dst_type) && value == 0) {
+          gpr = Zero;
+        } else {
+          __ LoadConst64(gpr, value);
+        }
+      }
+      if (dst_type == DataType::Type::kFloat32) {
+        __ Movgr2frW(destination.AsFpuRegister<FRegister>(), gpr);
+      } else if (dst_type == DataType::Type::kFloat64) {
+        __ Movgr2frD(destination.AsFpuRegister<FRegister>(), gpr);
+      }
+    } else if (source.IsRegister()) {
+      if (destination.IsRegister()) {
+        // Move to GPR from GPR
+        __ Move(destination.AsRegister<XRegister>(), source.AsRegister<XRegister>());
+      } else {
+        DCHECK(destination.IsFpuRegister());
+        if (DataType::Is64BitType(dst_type)) {
+          __ Movgr2frD(destination.AsFpuRegister<FRegister>(), source.AsRegister<XRegister>());
+        } else {
+          __ Movgr2frW(destination.AsFpuRegister<FRegister>(), source.AsRegister<XRegister>());
+        }
+      }
+    } else if (source.IsFpuRegister()) {
+      if (destination.IsFpuRegister()) {
+        // Move to FPR from FPR
+        if (GetGraph()->HasSIMD()) {
+          // The value may be a vector; move the whole 128-bit register.
+          __ MoveV(destination.AsFpuRegister<VRegister>(), source.AsFpuRegister<VRegister>());
+        } else if (dst_type == DataType::Type::kFloat32) {
+          __ FmovS(destination.AsFpuRegister<FRegister>(), source.AsFpuRegister<FRegister>());
+        } else {
+          DCHECK_EQ(dst_type, DataType::Type::kFloat64);
+          __ FmovD(destination.AsFpuRegister<FRegister>(), source.AsFpuRegister<FRegister>());
+        }
+      } else {
+        DCHECK(destination.IsRegister());
+        if (DataType::Is64BitType(dst_type)) {
+          __ Movfr2grD(destination.AsRegister<XRegister>(), source.AsFpuRegister<FRegister>());
+        } else {
+          __ Movfr2grS(destination.AsRegister<XRegister>(), source.AsFpuRegister<FRegister>());
+        }
+      }
+    }
+  } else if (destination.IsSIMDStackSlot()) {
+    if (source.IsFpuRegister()) {
+      // Move to SIMD stack slot from SIMD register
+      __ StoreVToOffset(source.AsFpuRegister<VRegister>(), SP, destination.GetStackIndex());
+    } else {
+      // Move to SIMD stack slot from SIMD stack slot
+      DCHECK(source.IsSIMDStackSlot());
+      __ LoadVFromOffset(VTMP, SP, source.GetStackIndex());
+      __ StoreVToOffset(VTMP, SP, destination.GetStackIndex());
+    }
+  } else {  // The destination is not a register. It must be a stack slot.
+    DCHECK(destination.IsStackSlot() || destination.IsDoubleStackSlot());
+    if (source.IsRegister() || source.IsFpuRegister()) {
+      if (unspecified_type) {
+        if (source.IsRegister()) {
+          dst_type = destination.IsStackSlot() ? DataType::Type::kInt32 : DataType::Type::kInt64;
+        } else {
+          dst_type =
+              destination.IsStackSlot() ? DataType::Type::kFloat32 : DataType::Type::kFloat64;
+        }
+      }
+      DCHECK((destination.IsDoubleStackSlot() == DataType::Is64BitType(dst_type)) &&
+             (source.IsFpuRegister() == DataType::IsFloatingPointType(dst_type)));
+      // Move to stack from GPR/FPR
+      StoreOperandType store_type = destination.IsStackSlot() ? kStoreWord : kStoreDoubleword;
+      if (source.IsRegister()) {
+        __ StoreToOffset(store_type,
+                         source.AsRegister<XRegister>(),
+                         SP,
+                         destination.GetStackIndex());
+      } else {
+        __ StoreFpuToOffset(store_type,
+                            source.AsFpuRegister<FRegister>(),
+                            SP,
+                            destination.GetStackIndex());
+      }
+    } else if (source.IsConstant()) {
+      // Move to stack from constant
+      HConstant* src_cst = source.GetConstant();
+      StoreOperandType store_type = destination.IsStackSlot() ? kStoreWord : kStoreDoubleword;
+      XRegister gpr = Zero;
+      if (destination.IsStackSlot()) {
+        int32_t value = GetInt32ValueOf(src_cst->AsConstant());
+        if (value != 0) {
+          gpr = TMP2;
+          __ LoadConst32(gpr, value);
+        }
+      } else {
+        DCHECK(destination.IsDoubleStackSlot());
+        int64_t value = GetInt64ValueOf(src_cst->AsConstant());
+        if (value != 0) {
+          gpr = TMP2;
+          __ LoadConst64(gpr, value);
+        }
+      }
+      __ StoreToOffset(store_type, gpr, SP, destination.GetStackIndex());
+    } else {
+      DCHECK(source.IsStackSlot() || source.IsDoubleStackSlot());
+      DCHECK_EQ(source.IsDoubleStackSlot(), destination.IsDoubleStackSlot());
+      // Move to stack from stack
+      if (destination.IsStackSlot()) {
+        __ LoadFromOffset(kLoadWord, TMP2, SP, source.GetStackIndex());
+        __ StoreToOffset(kStoreWord, TMP2, SP, destination.GetStackIndex());
+      } else {
+        __ LoadFromOffset(kLoadDoubleword, TMP2, SP, source.GetStackIndex());
+        __ StoreToOffset(kStoreDoubleword, TMP2, SP, destination.GetStackIndex());
+      }
+    }
+  }
+}
+
+void CodeGeneratorLoongarch64::SwapLocations(Location loc1, Location loc2, DataType::Type type) {
+  DCHECK(!loc1.IsConstant());
+  DCHECK(!loc2.IsConstant());
+
+  if (loc1.Equals(loc2)) {
+    return;
+  }
+
+  bool is_slot1 = loc1.IsStackSlot() || loc1.IsDoubleStackSlot();
+  bool is_slot2 = loc2.IsStackSlot() || loc2.IsDoubleStackSlot();
+  bool is_simd1 = loc1.IsSIMDStackSlot();
+  bool is_simd2 = loc2.IsSIMDStackSlot();
+  bool is_fp_reg1 = loc1.IsFpuRegister();
+  bool is_fp_reg2 = loc2.IsFpuRegister();
+
+  if (loc2.IsRegister() && loc1.IsRegister()) {
+    // Swap 2 GPRs
+    XRegister r1 = loc1.AsRegister<XRegister>();
+    XRegister r2 = loc2.AsRegister<XRegister>();
+    __ Move(TMP2, r2);
+    __ Move(r2, r1);
+    __ Move(r1, TMP2);
+  } else if (is_fp_reg2 && is_fp_reg1) {
+    // Swap 2 FPRs
+    if (GetGraph()->HasSIMD()) {
+      // The values may be vectors; swap the whole 128-bit registers.
+      VRegister r1 = loc1.AsFpuRegister<VRegister>();
+      VRegister r2 = loc2.AsFpuRegister<VRegister>();
+      __ MoveV(VTMP, r2);
+      __ MoveV(r2, r1);
+      __ MoveV(r1, VTMP);
+    } else {
+      FRegister r1 = loc1.AsFpuRegister<FRegister>();
+      FRegister r2 = loc2.AsFpuRegister<FRegister>();
+      // Swap the whole 64-bit registers; the upper halves of single-precision
+      // values are irrelevant.
+      __ FmovD(FTMP, r2);
+      __ FmovD(r2, r1);
+      __ FmovD(r1, FTMP);
+    }
+  } else if (is_slot1 != is_slot2) {
+    // Swap GPR/FPR and stack slot
+    Location reg_loc = is_slot1 ? loc2 : loc1;
+    Location mem_loc = is_slot1 ? loc1 : loc2;
+    LoadOperandType load_type = mem_loc.IsStackSlot() ? kLoadWord : kLoadDoubleword;
+    StoreOperandType store_type = mem_loc.IsStackSlot() ? kStoreWord : kStoreDoubleword;
+    // References are kept zero-extended in registers.
+    if (type == DataType::Type::kReference) {
+      DCHECK(mem_loc.IsStackSlot());
+      load_type = kLoadUnsignedWord;
+    }
+    __ LoadFromOffset(load_type, TMP2, SP, mem_loc.GetStackIndex());
+    if (reg_loc.IsFpuRegister()) {
+      __ StoreFpuToOffset(store_type,
+                          reg_loc.AsFpuRegister<FRegister>(),
+                          SP,
+                          mem_loc.GetStackIndex());
+      if (mem_loc.IsStackSlot()) {
+        __ Movgr2frW(reg_loc.AsFpuRegister<FRegister>(), TMP2);
+      } else {
+        DCHECK(mem_loc.IsDoubleStackSlot());
+        __ Movgr2frD(reg_loc.AsFpuRegister<FRegister>(), TMP2);
+      }
+    } else {
+      __ StoreToOffset(store_type, reg_loc.AsRegister<XRegister>(), SP, mem_loc.GetStackIndex());
+      __ Move(reg_loc.AsRegister<XRegister>(), TMP2);
+    }
+  } else if (is_slot1 && is_slot2) {
+    move_resolver_.Exchange(loc1.GetStackIndex(),
+                            loc2.GetStackIndex(),
+                            loc1.IsDoubleStackSlot());
+  } else if (is_simd1 && is_simd2) {
+    // Swap 2 SIMD stack slots
+    __ LoadVFromOffset(VTMP, SP, loc1.GetStackIndex());
+    __ LoadVFromOffset(VTMP2, SP, loc2.GetStackIndex());
+    __ StoreVToOffset(VTMP, SP, loc2.GetStackIndex());
+    __ StoreVToOffset(VTMP2, SP, loc1.GetStackIndex());
+  } else if ((is_simd1 && is_fp_reg2) || (is_simd2 && is_fp_reg1)) {
+    // Swap SIMD register and SIMD stack slot
+    Location reg_loc = is_simd1 ? loc2 : loc1;
+    Location mem_loc = is_simd1 ? loc1 : loc2;
+    VRegister reg = reg_loc.AsFpuRegister<VRegister>();
+    __ LoadVFromOffset(VTMP, SP, mem_loc.GetStackIndex());
+    __ StoreVToOffset(reg, SP, mem_loc.GetStackIndex());
+    __ MoveV(reg, VTMP);
+  } else {
+    LOG(FATAL) << "Unimplemented swap between locations " << loc1 << " and " << loc2;
+  }
+}
+
+void CodeGeneratorLoongarch64::MoveConstant(Location location, int32_t value) {
+  DCHECK(location.IsRegister());
+  __ LoadConst32(location.AsRegister<XRegister>(), value);
+}
+
+void CodeGeneratorLoongarch64::AddLocationAsTemp(Location location, LocationSummary* locations) {
+  if (location.IsRegister()) {
+    locations->AddTemp(location);
+  } else {
+    UNIMPLEMENTED(FATAL) << "AddLocationAsTemp not implemented for location " << location;
+  }
+}
+
+void CodeGeneratorLoongarch64::MarkGCCard(XRegister object,
+                                          XRegister value,
+                                          bool value_can_be_null) {
+  Loongarch64Label done;
+  XRegister card = TMP;
+  XRegister temp = TMP2;
+  if (value_can_be_null) {
+    __ Beqz(value, &done);
+  }
+  // Load the address of the card table into `card`.
+  __ LoadFromOffset(kLoadDoubleword,
+                    card,
+                    TR,
+                    Thread::CardTableOffset<kLoongarch64PointerSize>().Int32Value());
+  // Calculate the address of the card corresponding to `object`.
+  __ SrliD(temp, object, gc::accounting::CardTable::kCardShift);
+  __ AddD(temp, card, temp);
+  // Write the `art::gc::accounting::CardTable::kCardDirty` value into the
+  // `object`'s card.
+  //
+  // Register `card` contains the address of the card table. Note that the card
+  // table's base is biased during its creation so that it always starts at an
+  // address whose least-significant byte is equal to `kCardDirty` (see
+  // art::gc::accounting::CardTable::Create). Therefore the SB instruction
+  // below writes the `kCardDirty` (byte) value into the `object`'s card
+  // (located at `card + object >> kCardShift`).
+  //
+  // This dual use of the value in register `card` (1. to calculate the location
+  // of the card to mark; and 2. to load the `kCardDirty` value) saves a load
+  // (no need to explicitly load `kCardDirty` as an immediate value).
+  __ StoreToOffset(kStoreByte, card, temp, 0);
+  if (value_can_be_null) {
+    __ Bind(&done);
+  }
+}
+
+void CodeGeneratorLoongarch64::SetupBlockedRegisters() const {
+  // ZERO, RA, TP, SP and R21 can not be used.
+  blocked_core_registers_[Zero] = true;
+  blocked_core_registers_[RA] = true;
+  blocked_core_registers_[TP] = true;
+  blocked_core_registers_[SP] = true;
+  blocked_core_registers_[R21] = true;
+
+  // TMP, TMP2 and FTMP, FTMP2 are used as temporary/scratch registers.
+  blocked_core_registers_[TMP] = true;
+  blocked_core_registers_[TMP2] = true;
+  blocked_fpu_registers_[FTMP] = true;
+  blocked_fpu_registers_[FTMP2] = true;
+
+  // Reserve the thread register.
+  blocked_core_registers_[TR] = true;
+
+  if (GetGraph()->IsDebuggable()) {
+    // Stubs do not save callee-save floating point registers. If the graph
+    // is debuggable, we need to deal with these registers differently. For
+    // now, just block them.
+    for (size_t i = 0; i < arraysize(kFpuCalleeSaves); ++i) {
+      blocked_fpu_registers_[kFpuCalleeSaves[i]] = true;
+    }
+  }
+}
+
+size_t CodeGeneratorLoongarch64::SaveCoreRegister(size_t stack_index, uint32_t reg_id) {
+  __ StoreToOffset(kStoreDoubleword, XRegister(reg_id), SP, stack_index);
+  return kLoongarch64WordSize;
+}
+
+size_t CodeGeneratorLoongarch64::RestoreCoreRegister(size_t stack_index, uint32_t reg_id) {
+  __ LoadFromOffset(kLoadDoubleword, XRegister(reg_id), SP, stack_index);
+  return kLoongarch64WordSize;
+}
+
+size_t CodeGeneratorLoongarch64::SaveFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
+  if (GetGraph()->HasSIMD()) {
+    __ StoreVToOffset(VRegister(reg_id), SP, stack_index);
+  } else {
+    __ StoreFpuToOffset(kStoreDoubleword, FRegister(reg_id), SP, stack_index);
+  }
+  return GetSlowPathFPWidth();
+}
+
+size_t CodeGeneratorLoongarch64::RestoreFloatingPointRegister(size_t stack_index,
+                                                              uint32_t reg_id) {
+  if (GetGraph()->HasSIMD()) {
+    __ LoadVFromOffset(VRegister(reg_id), SP, stack_index);
+  } else {
+    __ LoadFpuFromOffset(kLoadDoubleword, FRegister(reg_id), SP, stack_index);
+  }
+  return GetSlowPathFPWidth();
+}
+
+void CodeGeneratorLoongarch64::DumpCoreRegister(std::ostream& stream, int reg) const {
+  stream << XRegister(reg);
+}
+
+void CodeGeneratorLoongarch64::DumpFloatingPointRegister(std::ostream& stream, int reg) const {
+  stream << FRegister(reg);
+}
+
+const Loongarch64InstructionSetFeatures& CodeGeneratorLoongarch64::GetInstructionSetFeatures()
+    const {
+  return *GetCompilerOptions().GetInstructionSetFeatures()->AsLoongarch64InstructionSetFeatures();
+}
+
+void CodeGeneratorLoongarch64::InvokeRuntime(QuickEntrypointEnum entrypoint,
+                                             HInstruction* instruction,
+                                             uint32_t dex_pc,
+                                             SlowPathCode* slow_path) {
+  ValidateInvokeRuntime(entrypoint, instruction, slow_path);
+  GenerateInvokeRuntime(GetThreadOffset<kLoongarch64PointerSize>(entrypoint).Int32Value());
+  if (EntrypointRequiresStackMap(entrypoint)) {
+    RecordPcInfo(instruction, dex_pc, slow_path);
+  }
+}
+
+void CodeGeneratorLoongarch64::InvokeRuntimeWithoutRecordingPcInfo(int32_t entry_point_offset,
+                                                                   HInstruction* instruction,
+                                                                   SlowPathCode* slow_path) {
+  ValidateInvokeRuntimeWithoutRecordingPcInfo(instruction, slow_path);
+  GenerateInvokeRuntime(entry_point_offset);
+}
+
+void CodeGeneratorLoongarch64::GenerateInvokeRuntime(int32_t entry_point_offset) {
+  __ LoadFromOffset(kLoadDoubleword, RA, TR, entry_point_offset);
+  __ Jalr(RA);
+}
+
+void CodeGeneratorLoongarch64::IncreaseFrame(size_t adjustment) {
+  int32_t adjustment32 = dchecked_integral_cast<int32_t>(adjustment);
+  __ AddConst64(SP, SP, -adjustment32);
+  GetAssembler()->cfi().AdjustCFAOffset(adjustment32);
+}
+
+void CodeGeneratorLoongarch64::DecreaseFrame(size_t adjustment) {
+  int32_t adjustment32 = dchecked_integral_cast<int32_t>(adjustment);
+  __ AddConst64(SP, SP, adjustment32);
+  GetAssembler()->cfi().AdjustCFAOffset(-adjustment32);
+}
+
+void CodeGeneratorLoongarch64::GenerateNop() {
+  __ Nop();
+}
+
+void CodeGeneratorLoongarch64::GenerateImplicitNullCheck(HNullCheck* instruction) {
+  if (CanMoveNullCheckToUser(instruction)) {
+    return;
+  }
+  Location obj = instruction->GetLocations()->InAt(0);
+
+  __ LdW(Zero, obj.AsRegister<XRegister>(), 0);
+  RecordPcInfo(instruction, instruction->GetDexPc());
+}
+
+void CodeGeneratorLoongarch64::GenerateExplicitNullCheck(HNullCheck* instruction) {
+  SlowPathCodeLoongarch64* slow_path =
+      new (GetScopedAllocator()) NullCheckSlowPathLoongarch64(instruction);
+  AddSlowPath(slow_path);
+
+  Location obj = instruction->GetLocations()->InAt(0);
+
+  __ Beqz(obj.AsRegister<XRegister>(), slow_path->GetEntryLabel());
+}
+
+void CodeGeneratorLoongarch64::MaybeIncrementHotness(bool is_frame_entry) {
+  if (GetCompilerOptions().CountHotnessInCompiledCode()) {
+    XRegister method = is_frame_entry ? kMethodRegisterArgument : TMP;
+    XRegister counter = TMP2;
+    if (!is_frame_entry) {
+      __ LoadFromOffset(kLoadDoubleword, method, SP, kCurrentMethodStackOffset);
+    }
+    // The counter saturates at 0xffff; load it sign-extended so that the saturated
+    // value becomes zero after the increment and the store can be skipped.
+    Loongarch64Label done;
+    __ LdH(counter, method, ArtMethod::HotnessCountOffset().Int32Value());
+    __ AddiW(counter, counter, 1);
+    __ Beqz(counter, &done);
+    __ StH(counter, method, ArtMethod::HotnessCountOffset().Int32Value());
+    __ Bind(&done);
+  }
+
+  if (GetGraph()->IsCompilingBaseline() && !Runtime::Current()->IsAotCompiler()) {
+    ScopedProfilingInfoUse spiu(
+        Runtime::Current()->GetJit(), GetGraph()->GetArtMethod(), Thread::Current());
+    ProfilingInfo* info = spiu.GetProfilingInfo();
+    if (info != nullptr) {
+      uint64_t address = reinterpret_cast64<uint64_t>(info);
+      Loongarch64Label done;
+      XRegister temp = TMP;
+      XRegister counter = TMP2;
+      __ LoadConst64(temp, address);
+      __ LdHu(counter, temp, ProfilingInfo::BaselineHotnessCountOffset().Int32Value());
+      __ AddiD(counter, counter, 1);
+      static_assert(interpreter::kTieredHotnessMask == 0xffff);
+      __ BstrpickD(counter, counter, 15, 0);
+      __ StH(counter, temp, ProfilingInfo::BaselineHotnessCountOffset().Int32Value());
+      __ Bnez(counter, &done);
+      if (is_frame_entry) {
+        if (HasEmptyFrame()) {
+          // The entrypoint expects the method at the bottom of the stack. We
+          // claim stack space necessary for alignment.
+          IncreaseFrame(kStackAlignment);
+          __ StD(kMethodRegisterArgument, SP, 0);
+          __ StD(RA, SP, kLoongarch64WordSize);
+        } else if (!RequiresCurrentMethod()) {
+          __ StD(kMethodRegisterArgument, SP, 0);
+        }
+      } else {
+        CHECK(RequiresCurrentMethod());
+      }
+      uint32_t entrypoint_offset =
+          GetThreadOffset<kLoongarch64PointerSize>(kQuickCompileOptimized).Int32Value();
+      __ LoadFromOffset(kLoadDoubleword, RA, TR, entrypoint_offset);
+      // Note: we don't record the call here (and therefore don't generate a stack
+      // map), as the entrypoint should never be suspended.
+      __ Jalr(RA);
+      if (HasEmptyFrame()) {
+        CHECK(is_frame_entry);
+        __ LdD(RA, SP, kLoongarch64WordSize);
+        DecreaseFrame(kStackAlignment);
+      }
+      __ Bind(&done);
+    }
+  }
+}
+
+void CodeGeneratorLoongarch64::MaybeGenerateInlineCacheCheck(HInstruction* instruction,
+                                                             XRegister klass) {
+  DCHECK_EQ(klass, A0);
+  // We know the destination of an intrinsic, so no need to record inline
+  // caches.
+  if (!instruction->GetLocations()->Intrinsified() &&
+      GetGraph()->IsCompilingBaseline() &&
+      !Runtime::Current()->IsAotCompiler()) {
+    DCHECK(!instruction->GetEnvironment()->IsFromInlinedInvoke());
+    ScopedProfilingInfoUse spiu(
+        Runtime::Current()->GetJit(), GetGraph()->GetArtMethod(), Thread::Current());
+    ProfilingInfo* info = spiu.GetProfilingInfo();
+    if (info != nullptr) {
+      InlineCache* cache = info->GetInlineCache(instruction->GetDexPc());
+      uint64_t address = reinterpret_cast64<uint64_t>(cache);
+      Loongarch64Label done;
+      // The `art_quick_update_inline_cache` entrypoint expects the inline cache in TMP
+      // and the class in A0.
+      __ LoadConst64(TMP, address);
+      __ LoadFromOffset(kLoadUnsignedWord, TMP2, TMP, InlineCache::ClassesOffset().Int32Value());
+      // Fast path for a monomorphic cache.
+      __ Beq(klass, TMP2, &done);
+      InvokeRuntime(kQuickUpdateInlineCache, instruction, instruction->GetDexPc());
+      __ Bind(&done);
+    }
+  }
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewBootImageIntrinsicPatch(
+    uint32_t intrinsic_data,
+    const PcRelativePatchInfo* info_high) {
+  return NewPcRelativePatch(
+      /* dex_file= */ nullptr, intrinsic_data, info_high, &boot_image_other_patches_);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewBootImageRelRoPatch(
+    uint32_t boot_image_offset,
+    const PcRelativePatchInfo* info_high) {
+  return NewPcRelativePatch(
+      /* dex_file= */ nullptr, boot_image_offset, info_high, &boot_image_other_patches_);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewBootImageMethodPatch(
+    MethodReference target_method,
+    const PcRelativePatchInfo* info_high) {
+  return NewPcRelativePatch(
+      target_method.dex_file, target_method.index, info_high, &boot_image_method_patches_);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewMethodBssEntryPatch(
+    MethodReference target_method,
+    const PcRelativePatchInfo* info_high) {
+  return NewPcRelativePatch(
+      target_method.dex_file, target_method.index, info_high, &method_bss_entry_patches_);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo*
+CodeGeneratorLoongarch64::NewBootImageJniEntrypointPatch(MethodReference target_method,
+                                                         const PcRelativePatchInfo* info_high) {
+  return NewPcRelativePatch(
+      target_method.dex_file, target_method.index, info_high, &boot_image_jni_entrypoint_patches_);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewBootImageTypePatch(
+    const DexFile& dex_file,
+    dex::TypeIndex type_index,
+    const PcRelativePatchInfo* info_high) {
+  return NewPcRelativePatch(&dex_file, type_index.index_, info_high, &boot_image_type_patches_);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewTypeBssEntryPatch(
+    HLoadClass* load_class,
+    const PcRelativePatchInfo* info_high) {
+  const DexFile& dex_file = load_class->GetDexFile();
+  dex::TypeIndex type_index = load_class->GetTypeIndex();
+  ArenaDeque<PcRelativePatchInfo>* patches = nullptr;
+  switch (load_class->GetLoadKind()) {
+    case HLoadClass::LoadKind::kBssEntry:
+      patches = &type_bss_entry_patches_;
+      break;
+    case HLoadClass::LoadKind::kBssEntryPublic:
+      patches = &public_type_bss_entry_patches_;
+      break;
+    case HLoadClass::LoadKind::kBssEntryPackage:
+      patches = &package_type_bss_entry_patches_;
+      break;
+    default:
+      LOG(FATAL) << "Unexpected load kind: " << load_class->GetLoadKind();
+      UNREACHABLE();
+  }
+  return NewPcRelativePatch(&dex_file, type_index.index_, info_high, patches);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewBootImageStringPatch(
+    const DexFile& dex_file,
+    dex::StringIndex string_index,
+    const PcRelativePatchInfo* info_high) {
+  return NewPcRelativePatch(&dex_file, string_index.index_, info_high, &boot_image_string_patches_);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewStringBssEntryPatch(
+    const DexFile& dex_file,
+    dex::StringIndex string_index,
+    const PcRelativePatchInfo* info_high) {
+  return NewPcRelativePatch(&dex_file, string_index.index_, info_high, &string_bss_entry_patches_);
+}
+
+CodeGeneratorLoongarch64::PcRelativePatchInfo* CodeGeneratorLoongarch64::NewPcRelativePatch(
+    const DexFile* dex_file,
+    uint32_t offset_or_index,
+    const PcRelativePatchInfo* info_high,
+    ArenaDeque<PcRelativePatchInfo>* patches) {
+  patches->emplace_back(dex_file, offset_or_index, info_high);
+  return &patches->back();
+}
+
+void CodeGeneratorLoongarch64::EmitPcRelativeAddressPlaceholderHigh(PcRelativePatchInfo* info_high,
+                                                                    XRegister out) {
+  DCHECK(info_high->patch_info_high == nullptr);
+  __ Bind(&info_high->label);
+  // Add the high 20 bits of a 32-bit offset to PC.
+  __ Pcaddu12i(out, kPcRelativePlaceholderHigh);
+}
+
+void CodeGeneratorLoongarch64::EmitPcRelativeAddressPlaceholderLow(PcRelativePatchInfo* info_low,
+                                                                   XRegister rd,
+                                                                   XRegister rj) {
+  DCHECK(info_low->patch_info_high != nullptr);
+  __ Bind(&info_low->label);
+  // Add the sign-extended low 12 bits of the offset.
+  __ AddiD(rd, rj, kPcRelativePlaceholderLow);
+}
+
+void CodeGeneratorLoongarch64::EmitPcRelativeLoadPlaceholderLow(PcRelativePatchInfo* info_low,
+                                                                XRegister rd,
+                                                                XRegister rj,
+                                                                LoadOperandType type) {
+  DCHECK(info_low->patch_info_high != nullptr);
+  DCHECK(type == kLoadUnsignedWord || type == kLoadDoubleword) << type;
+  __ Bind(&info_low->label);
+  // Load from the address with the sign-extended low 12 bits of the offset.
+  __ LoadFromOffset(type, rd, rj, kPcRelativePlaceholderLow);
+}
+
+template <linker::LinkerPatch (*Factory)(size_t, const DexFile*, uint32_t, uint32_t)>
+inline void CodeGeneratorLoongarch64::EmitPcRelativeLinkerPatches(
+    const ArenaDeque<PcRelativePatchInfo>& infos,
+    ArenaVector<linker::LinkerPatch>* linker_patches) {
+  for (const PcRelativePatchInfo& info : infos) {
+    const DexFile* dex_file = info.target_dex_file;
+    size_t offset_or_index = info.offset_or_index;
+    DCHECK(info.label.IsBound());
+    uint32_t literal_offset = __ GetLabelLocation(&info.label);
+    // On LOONGARCH64 the high and low parts of the offset are patched separately; both
+    // are relative to the PC of the `pcaddu12i` instruction.
+    const PcRelativePatchInfo& info_high =
+        (info.patch_info_high != nullptr) ? *info.patch_info_high : info;
+    uint32_t pc_rel_offset = __ GetLabelLocation(&info_high.label);
+    linker_patches->push_back(Factory(literal_offset, dex_file, pc_rel_offset, offset_or_index));
+  }
+}
+
+template <linker::LinkerPatch (*Factory)(size_t, uint32_t, uint32_t)>
+linker::LinkerPatch NoDexFileAdapter(size_t literal_offset,
+                                     const DexFile* target_dex_file,
+                                     uint32_t pc_insn_offset,
+                                     uint32_t boot_image_offset) {
+  DCHECK(target_dex_file == nullptr);  // Unused for these patches, should be null.
+  return Factory(literal_offset, pc_insn_offset, boot_image_offset);
+}
+
+void CodeGeneratorLoongarch64::EmitLinkerPatches(ArenaVector<linker::LinkerPatch>* linker_patches) {
+  DCHECK(linker_patches->empty());
+  size_t size =
+      boot_image_method_patches_.size() +
+      method_bss_entry_patches_.size() +
+      boot_image_type_patches_.size() +
+      type_bss_entry_patches_.size() +
+      public_type_bss_entry_patches_.size() +
+      package_type_bss_entry_patches_.size() +
+      boot_image_string_patches_.size() +
+      string_bss_entry_patches_.size() +
+      boot_image_jni_entrypoint_patches_.size() +
+      boot_image_other_patches_.size();
+  linker_patches->reserve(size);
+  if (GetCompilerOptions().IsBootImage() || GetCompilerOptions().IsBootImageExtension()) {
+    EmitPcRelativeLinkerPatches<linker::LinkerPatch::RelativeMethodPatch>(
+        boot_image_method_patches_, linker_patches);
+    EmitPcRelativeLinkerPatches<linker::LinkerPatch::RelativeTypePatch>(
+        boot_image_type_patches_, linker_patches);
+    EmitPcRelativeLinkerPatches<linker::LinkerPatch::RelativeStringPatch>(
+        boot_image_string_patches_, linker_patches);
+  } else {
+    DCHECK(boot_image_method_patches_.empty());
+    DCHECK(boot_image_type_patches_.empty());
+    DCHECK(boot_image_string_patches_.empty());
+  }
+  if (GetCompilerOptions().IsBootImage()) {
+    EmitPcRelativeLinkerPatches<NoDexFileAdapter<linker::LinkerPatch::IntrinsicReferencePatch>>(
+        boot_image_other_patches_, linker_patches);
+  } else {
+    EmitPcRelativeLinkerPatches<NoDexFileAdapter<linker::LinkerPatch::DataBimgRelRoPatch>>(
+        boot_image_other_patches_, linker_patches);
+  }
+  EmitPcRelativeLinkerPatches<linker::LinkerPatch::MethodBssEntryPatch>(
+      method_bss_entry_patches_, linker_patches);
+  EmitPcRelativeLinkerPatches<linker::LinkerPatch::TypeBssEntryPatch>(
+      type_bss_entry_patches_, linker_patches);
+  EmitPcRelativeLinkerPatches<linker::LinkerPatch::PublicTypeBssEntryPatch>(
+      public_type_bss_entry_patches_, linker_patches);
+  EmitPcRelativeLinkerPatches<linker::LinkerPatch::PackageTypeBssEntryPatch>(
+      package_type_bss_entry_patches_, linker_patches);
+  EmitPcRelativeLinkerPatches<linker::LinkerPatch::StringBssEntryPatch>(
+      string_bss_entry_patches_, linker_patches);
+  EmitPcRelativeLinkerPatches<linker::LinkerPatch::RelativeJniEntrypointPatch>(
+      boot_image_jni_entrypoint_patches_, linker_patches);
+  DCHECK_EQ(size, linker_patches->size());
+}
+
+void CodeGeneratorLoongarch64::LoadBootImageAddress(XRegister reg,
+                                                    uint32_t boot_image_reference) {
+  if (GetCompilerOptions().IsBootImage()) {
+    PcRelativePatchInfo* info_high = NewBootImageIntrinsicPatch(boot_image_reference);
+    PcRelativePatchInfo* info_low = NewBootImageIntrinsicPatch(boot_image_reference, info_high);
+    EmitPcRelativeAddressPlaceholderHigh(info_high, reg);
+    EmitPcRelativeAddressPlaceholderLow(info_low, reg, reg);
+  } else if (GetCompilerOptions().GetCompilePic()) {
+    PcRelativePatchInfo* info_high = NewBootImageRelRoPatch(boot_image_reference);
+    PcRelativePatchInfo* info_low = NewBootImageRelRoPatch(boot_image_reference, info_high);
+    EmitPcRelativeAddressPlaceholderHigh(info_high, reg);
+    // Note: Boot image is in the low 4GiB and the entry is 32-bit, so emit a 32-bit load.
+    EmitPcRelativeLoadPlaceholderLow(info_low, reg, reg, kLoadUnsignedWord);
+  } else {
+    DCHECK(GetCompilerOptions().IsJitCompiler());
+    gc::Heap* heap = Runtime::Current()->GetHeap();
+    DCHECK(!heap->GetBootImageSpaces().empty());
+    const uint8_t* address = heap->GetBootImageSpaces()[0]->Begin() + boot_image_reference;
+    __ LoadConst64(reg, dchecked_integral_cast<uint32_t>(reinterpret_cast<uintptr_t>(address)));
+  }
+}
+
+void CodeGeneratorLoongarch64::LoadIntrinsicDeclaringClass(XRegister reg, HInvoke* invoke) {
+  DCHECK_NE(invoke->GetIntrinsic(), Intrinsics::kNone);
+  if (GetCompilerOptions().IsBootImage()) {
+    // Load the class the same way as for HLoadClass::LoadKind::kBootImageLinkTimePcRelative.
+    MethodReference target_method = invoke->GetResolvedMethodReference();
+    dex::TypeIndex type_idx = target_method.dex_file->GetMethodId(target_method.index).class_idx_;
+    PcRelativePatchInfo* info_high = NewBootImageTypePatch(*target_method.dex_file, type_idx);
+    PcRelativePatchInfo* info_low =
+        NewBootImageTypePatch(*target_method.dex_file, type_idx, info_high);
+    EmitPcRelativeAddressPlaceholderHigh(info_high, reg);
+    EmitPcRelativeAddressPlaceholderLow(info_low, reg, reg);
+  } else {
+    uint32_t boot_image_offset = GetBootImageOffsetOfIntrinsicDeclaringClass(invoke);
+    LoadBootImageAddress(reg, boot_image_offset);
+  }
+}
+
+CodeGeneratorLoongarch64::JitPatchInfo* CodeGeneratorLoongarch64::NewJitRootStringPatch(
+    const DexFile& dex_file,
+    dex::StringIndex string_index,
+    Handle<mirror::String> handle) {
+  ReserveJitStringRoot(StringReference(&dex_file, string_index), handle);
+  jit_string_patches_.emplace_back(dex_file, string_index.index_);
+  return &jit_string_patches_.back();
+}
+
+CodeGeneratorLoongarch64::JitPatchInfo* CodeGeneratorLoongarch64::NewJitRootClassPatch(
+    const DexFile& dex_file,
+    dex::TypeIndex type_index,
+    Handle<mirror::Class> handle) {
+  ReserveJitClassRoot(TypeReference(&dex_file, type_index), handle);
+  jit_class_patches_.emplace_back(dex_file, type_index.index_);
+  return &jit_class_patches_.back();
+}
+
+void CodeGeneratorLoongarch64::EmitJitRootAddressPlaceholder(JitPatchInfo* info, XRegister out) {
+  __ Bind(&info->label);
+  // Materialize the 64-bit address of the root table entry; the immediates are
+  // filled in by PatchJitRootUse().
+  __ Lu12iW(out, /* placeholder */ 0);
+  __ Ori(out, out, /* placeholder */ 0u);
+  __ Lu32iD(out, /* placeholder */ 0);
+  __ Lu52iD(out, out, /* placeholder */ 0);
+}
+
+void CodeGeneratorLoongarch64::PatchJitRootUse(uint8_t* code,
+                                               const uint8_t* roots_data,
+                                               const JitPatchInfo& info,
+                                               uint64_t index_in_table) const {
+  uint32_t literal_offset = GetAssembler().GetLabelLocation(&info.label);
+  uintptr_t address =
+      reinterpret_cast<uintptr_t>(roots_data) + index_in_table * sizeof(GcRoot<mirror::Object>);
+  uint64_t addr = static_cast<uint64_t>(address);
+  uint32_t* insns = reinterpret_cast<uint32_t*>(code + literal_offset);
+  // lu12i.w: bits [31:12] of the address in the 20-bit immediate at bits [24:5].
+  DCHECK_EQ(insns[0] & 0xfe000000u, 0x14000000u);
+  insns[0] = (insns[0] & ~(0xfffffu << 5)) | (static_cast<uint32_t>((addr >> 12) & 0xfffffu) << 5);
+  // ori: bits [11:0] of the address in the 12-bit immediate at bits [21:10].
+  DCHECK_EQ(insns[1] & 0xffc00000u, 0x03800000u);
+  insns[1] = (insns[1] & ~(0xfffu << 10)) | (static_cast<uint32_t>(addr & 0xfffu) << 10);
+  // lu32i.d: bits [51:32] of the address in the 20-bit immediate at bits [24:5].
+  DCHECK_EQ(insns[2] & 0xfe000000u, 0x16000000u);
+  insns[2] = (insns[2] & ~(0xfffffu << 5)) | (static_cast<uint32_t>((addr >> 32) & 0xfffffu) << 5);
+  // lu52i.d: bits [63:52] of the address in the 12-bit immediate at bits [21:10].
+  DCHECK_EQ(insns[3] & 0xffc00000u, 0x03000000u);
+  insns[3] = (insns[3] & ~(0xfffu << 10)) | (static_cast<uint32_t>((addr >> 52) & 0xfffu) << 10);
+}
+
+void CodeGeneratorLoongarch64::EmitJitRootPatches(uint8_t* code, const uint8_t* roots_data) {
+  for (const JitPatchInfo& info : jit_string_patches_) {
+    StringReference string_reference(&info.target_dex_file, dex::StringIndex(info.index));
+    uint64_t index_in_table = GetJitStringRootIndex(string_reference);
+    PatchJitRootUse(code, roots_data, info, index_in_table);
+  }
+  for (const JitPatchInfo& info : jit_class_patches_) {
+    TypeReference type_reference(&info.target_dex_file, dex::TypeIndex(info.index));
+    uint64_t index_in_table = GetJitClassRootIndex(type_reference);
+    PatchJitRootUse(code, roots_data, info, index_in_table);
+  }
+}
+
+HLoadString::LoadKind CodeGeneratorLoongarch64::GetSupportedLoadStringKind(
+    HLoadString::LoadKind desired_string_load_kind) {
+  switch (desired_string_load_kind) {
+    case HLoadString::LoadKind::kBootImageLinkTimePcRelative:
+    case HLoadString::LoadKind::kBootImageRelRo:
+    case HLoadString::LoadKind::kBssEntry:
+      DCHECK(!GetCompilerOptions().IsJitCompiler());
+      break;
+    case HLoadString::LoadKind::kJitBootImageAddress:
+    case HLoadString::LoadKind::kJitTableAddress:
+      DCHECK(GetCompilerOptions().IsJitCompiler());
+      break;
+    case HLoadString::LoadKind::kRuntimeCall:
+      break;
+  }
+  return desired_string_load_kind;
+}
+
+HLoadClass::LoadKind CodeGeneratorLoongarch64::GetSupportedLoadClassKind(
+    HLoadClass::LoadKind desired_class_load_kind) {
+  switch (desired_class_load_kind) {
+    case HLoadClass::LoadKind::kInvalid:
+      LOG(FATAL) << "UNREACHABLE";
+      UNREACHABLE();
+    case HLoadClass::LoadKind::kReferrersClass:
+      break;
+    case HLoadClass::LoadKind::kBootImageLinkTimePcRelative:
+    case HLoadClass::LoadKind::kBootImageRelRo:
+    case HLoadClass::LoadKind::kBssEntry:
+    case HLoadClass::LoadKind::kBssEntryPublic:
+    case HLoadClass::LoadKind::kBssEntryPackage:
+      DCHECK(!GetCompilerOptions().IsJitCompiler());
+      break;
+    case HLoadClass::LoadKind::kJitBootImageAddress:
+    case HLoadClass::LoadKind::kJitTableAddress:
+      DCHECK(GetCompilerOptions().IsJitCompiler());
+      break;
+    case HLoadClass::LoadKind::kRuntimeCall:
+      break;
+  }
+  return desired_class_load_kind;
+}
+
+HInvokeStaticOrDirect::DispatchInfo CodeGeneratorLoongarch64::GetSupportedInvokeStaticOrDirectDispatch(
+      const HInvokeStaticOrDirect::DispatchInfo& desired_dispatch_info,
+      ArtMethod* method ATTRIBUTE_UNUSED) {
+  // On LOONGARCH64 we support all dispatch types.
+  return desired_dispatch_info;
+}
+
+void CodeGeneratorLoongarch64::LoadMethod(MethodLoadKind load_kind, Location temp, HInvoke* invoke) {
+  switch (load_kind) {
+    case MethodLoadKind::kBootImageLinkTimePcRelative: {
+      DCHECK(GetCompilerOptions().IsBootImage() || GetCompilerOptions().IsBootImageExtension());
+      PcRelativePatchInfo* info_high =
+          NewBootImageMethodPatch(invoke->GetResolvedMethodReference());
+      PcRelativePatchInfo* info_low =
+          NewBootImageMethodPatch(invoke->GetResolvedMethodReference(), info_high);
+      EmitPcRelativeAddressPlaceholderHigh(info_high, temp.AsRegister<XRegister>());
+      EmitPcRelativeAddressPlaceholderLow(
+          info_low, temp.AsRegister<XRegister>(), temp.AsRegister<XRegister>());
+      break;
+    }
+    case MethodLoadKind::kBootImageRelRo: {
+      uint32_t boot_image_offset = GetBootImageOffset(invoke);
+      PcRelativePatchInfo* info_high = NewBootImageRelRoPatch(boot_image_offset);
+      PcRelativePatchInfo* info_low = NewBootImageRelRoPatch(boot_image_offset, info_high);
+      EmitPcRelativeAddressPlaceholderHigh(info_high, temp.AsRegister<XRegister>());
+      // Note: Boot image is in the low 4GiB and the entry is 32-bit, so emit a 32-bit load.
+      EmitPcRelativeLoadPlaceholderLow(
+          info_low, temp.AsRegister<XRegister>(), temp.AsRegister<XRegister>(), kLoadUnsignedWord);
+      break;
+    }
+    case MethodLoadKind::kBssEntry: {
+      PcRelativePatchInfo* info_high = NewMethodBssEntryPatch(invoke->GetMethodReference());
+      PcRelativePatchInfo* info_low =
+          NewMethodBssEntryPatch(invoke->GetMethodReference(), info_high);
+      EmitPcRelativeAddressPlaceholderHigh(info_high, temp.AsRegister<XRegister>());
+      EmitPcRelativeLoadPlaceholderLow(
+          info_low, temp.AsRegister<XRegister>(), temp.AsRegister<XRegister>(), kLoadDoubleword);
+      break;
+    }
+    case MethodLoadKind::kJitDirectAddress: {
+      __ LoadConst64(temp.AsRegister<XRegister>(),
+                     reinterpret_cast<uint64_t>(invoke->GetResolvedMethod()));
+      break;
+    }
+    case MethodLoadKind::kRuntimeCall: {
+      // Test situation, don't do anything.
+      break;
+    }
+    default: {
+      LOG(FATAL) << "Load kind should have already been handled " << load_kind;
+      UNREACHABLE();
+    }
+  }
+}
+
+void CodeGeneratorLoongarch64::GenerateStaticOrDirectCall(HInvokeStaticOrDirect* invoke,
+                                                          Location temp,
+                                                          SlowPathCode* slow_path) {
+  // All registers are assumed to be correctly set up per the calling convention.
+  Location callee_method = temp;  // For all kinds except kRecursive, callee will be in temp.
+
+  switch (invoke->GetMethodLoadKind()) {
+    case MethodLoadKind::kStringInit: {
+      // temp = thread->string_init_entrypoint
+      uint32_t offset =
+          GetThreadOffset<kLoongarch64PointerSize>(invoke->GetStringInitEntryPoint()).Int32Value();
+      __ LoadFromOffset(kLoadDoubleword, temp.AsRegister<XRegister>(), TR, offset);
+      break;
+    }
+    case MethodLoadKind::kRecursive:
+      callee_method = invoke->GetLocations()->InAt(invoke->GetCurrentMethodIndex());
+      break;
+    case MethodLoadKind::kRuntimeCall:
+      GenerateInvokeStaticOrDirectRuntimeCall(invoke, temp, slow_path);
+      return;  // No code pointer retrieval; the runtime performs the call directly.
+    case MethodLoadKind::kBootImageLinkTimePcRelative:
+      DCHECK(GetCompilerOptions().IsBootImage() || GetCompilerOptions().IsBootImageExtension());
+      if (invoke->GetCodePtrLocation() == CodePtrLocation::kCallCriticalNative) {
+        // Do not materialize the method pointer, load directly the entrypoint.
+        PcRelativePatchInfo* info_high =
+            NewBootImageJniEntrypointPatch(invoke->GetResolvedMethodReference());
+        PcRelativePatchInfo* info_low =
+            NewBootImageJniEntrypointPatch(invoke->GetResolvedMethodReference(), info_high);
+        EmitPcRelativeAddressPlaceholderHigh(info_high, RA);
+        EmitPcRelativeLoadPlaceholderLow(info_low, RA, RA, kLoadDoubleword);
+        break;
+      }
+      FALLTHROUGH_INTENDED;
+    default:
+      LoadMethod(invoke->GetMethodLoadKind(), temp, invoke);
+      break;
+  }
+
+  switch (invoke->GetCodePtrLocation()) {
+    case CodePtrLocation::kCallSelf:
+      __ Bl(&frame_entry_label_);
+      RecordPcInfo(invoke, invoke->GetDexPc(), slow_path);
+      break;
+    case CodePtrLocation::kCallCriticalNative: {
+      size_t out_frame_size =
+          PrepareCriticalNativeCall<CriticalNativeCallingConventionVisitorLoongarch64,
+                                    kLoongarch64StackAlignment,
+                                    GetCriticalNativeDirectCallFrameSize>(invoke);
+      if (invoke->GetMethodLoadKind() != MethodLoadKind::kBootImageLinkTimePcRelative) {
+        // RA = callee_method->ptr_sized_fields_.data_;  // EntryPointFromJni
+        MemberOffset offset = ArtMethod::EntryPointFromJniOffset(kLoongarch64PointerSize);
+        __ LoadFromOffset(
+            kLoadDoubleword, RA, callee_method.AsRegister<XRegister>(), offset.Int32Value());
+      }
+      // RA()
+      __ Jalr(RA);
+      RecordPcInfo(invoke, invoke->GetDexPc(), slow_path);
+      // Zero-/sign-extend the result when needed due to native and managed ABI mismatch.
+      switch (invoke->GetType()) {
+        case DataType::Type::kBool:
+          __ Andi(A0, A0, 0xff);
+          break;
+        case DataType::Type::kInt8:
+          __ ExtWB(A0, A0);
+          break;
+        case DataType::Type::kUint16:
+          __ BstrpickD(A0, A0, 15, 0);
+          break;
+        case DataType::Type::kInt16:
+          __ ExtWH(A0, A0);
+          break;
+        case DataType::Type::kInt32:
+        case DataType::Type::kInt64:
+        case DataType::Type::kFloat32:
+        case DataType::Type::kFloat64:
+        case DataType::Type::kVoid:
+          break;
+        default:
+          DCHECK(false) << invoke->GetType();
+          break;
+      }
+      if (out_frame_size != 0u) {
+        DecreaseFrame(out_frame_size);
+      }
+      break;
+    }
+    case CodePtrLocation::kCallArtMethod:
+      // RA = callee_method->entry_point_from_quick_compiled_code_;
+      __ LoadFromOffset(kLoadDoubleword,
+                        RA,
+                        callee_method.AsRegister<XRegister>(),
+                        ArtMethod::EntryPointFromQuickCompiledCodeOffset(
+                            kLoongarch64PointerSize).Int32Value());
+      // RA()
+      __ Jalr(RA);
+      RecordPcInfo(invoke, invoke->GetDexPc(), slow_path);
+      break;
+  }
+
+  DCHECK(!IsLeafMethod());
+}
+
+void CodeGeneratorLoongarch64::GenerateVirtualCall(HInvokeVirtual* invoke,
+                                                   Location temp_location,
+                                                   SlowPathCode* slow_path) {
+  // Use the calling convention instead of the location of the receiver, as
+  // intrinsics may have put the receiver in a different register. In the intrinsics
+  // slow path, the arguments have been moved to the right place, so here we are
+  // guaranteed that the receiver is the first register of the calling convention.
+  InvokeDexCallingConvention calling_convention;
+  XRegister receiver = calling_convention.GetRegisterAt(0);
+
+  XRegister temp = temp_location.AsRegister<XRegister>();
+  size_t method_offset = mirror::Class::EmbeddedVTableEntryOffset(
+      invoke->GetVTableIndex(), kLoongarch64PointerSize).SizeValue();
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  Offset entry_point = ArtMethod::EntryPointFromQuickCompiledCodeOffset(kLoongarch64PointerSize);
+
+  // temp = object->GetClass();
+  __ LoadFromOffset(kLoadUnsignedWord, temp, receiver, class_offset);
+  MaybeRecordImplicitNullCheck(invoke);
+  // Instead of simply (possibly) unpoisoning `temp` here, we should
+  // emit a read barrier for the previous class reference load.
+  // However this is not required in practice, as this is an
+  // intermediate/temporary reference and because the current
+  // concurrent copying collector keeps the from-space memory
+  // intact/accessible until the end of the marking phase (the
+  // concurrent copying collector may not in the future).
+  __ MaybeUnpoisonHeapReference(temp);
+
+  // If we're compiling baseline, update the inline cache.
+  MaybeGenerateInlineCacheCheck(invoke, temp);
+
+  // temp = temp->GetMethodAt(method_offset);
+  __ LoadFromOffset(kLoadDoubleword, temp, temp, method_offset);
+  // RA = temp->GetEntryPoint();
+  __ LoadFromOffset(kLoadDoubleword, RA, temp, entry_point.Int32Value());
+  // RA();
+  __ Jalr(RA);
+  RecordPcInfo(invoke, invoke->GetDexPc(), slow_path);
+}
+
+void CodeGeneratorLoongarch64::MoveFromReturnRegister(Location trg, DataType::Type type) {
+  if (!trg.IsValid()) {
+    DCHECK_EQ(type, DataType::Type::kVoid);
+    return;
+  }
+
+  DCHECK_NE(type, DataType::Type::kVoid);
+
+  if (DataType::IsIntegralType(type) || type == DataType::Type::kReference) {
+    XRegister trg_reg = trg.AsRegister<XRegister>();
+    if (trg_reg != A0) {
+      __ Move(trg_reg, A0);
+    }
+  } else {
+    FRegister trg_reg = trg.AsFpuRegister<FRegister>();
+    if (trg_reg != FA0) {
+      __ FmovD(trg_reg, FA0);
+    }
+  }
+}
+
+void CodeGeneratorLoongarch64::GenerateGcRootFieldLoad(HInstruction* instruction,
+                                                       Location root,
+                                                       XRegister obj,
+                                                       uint32_t offset,
+                                                       ReadBarrierOption read_barrier_option,
+                                                       Loongarch64Label* label_low) {
+  if (label_low != nullptr) {
+    DCHECK_EQ(offset, static_cast<uint32_t>(kPcRelativePlaceholderLow));
+    __ Bind(label_low);
+  }
+  XRegister root_reg = root.AsRegister<XRegister>();
+  // /* GcRoot<mirror::Object> */ root = *(obj + offset)
+  __ LoadFromOffset(kLoadUnsignedWord, root_reg, obj, offset);
+  static_assert(
+      sizeof(mirror::CompressedReference<mirror::Object>) == sizeof(GcRoot<mirror::Object>),
+      "art::mirror::CompressedReference<mirror::Object> and art::GcRoot<mirror::Object> "
+      "have different sizes.");
+  static_assert(sizeof(mirror::CompressedReference<mirror::Object>) == sizeof(int32_t),
+                "art::mirror::CompressedReference<mirror::Object> and int32_t "
+                "have different sizes.");
+  if (read_barrier_option == kWithReadBarrier) {
+    DCHECK(kEmitCompilerReadBarrier);
+    if (kUseBakerReadBarrier) {
+      // Fast path implementation of art::ReadBarrier::BarrierForRoot when
+      // Baker's read barrier are used:
+      //
+      //   root = obj.field;
+      //   temp = Thread::Current()->pReadBarrierMarkReg ## root.reg()
+      //   if (temp != null) {
+      //     root = temp(root)
+      //   }
+      //
+      // The entrypoint is null when the GC is not marking.
+      Location temp = Location::RegisterLocation(TMP);
+      __ LoadFromOffset(kLoadDoubleword, TMP, TR, ReadBarrierMarkEntrypointOffset(root_reg));
+      SlowPathCodeLoongarch64* slow_path = new (GetScopedAllocator())
+          ReadBarrierMarkSlowPathLoongarch64(instruction, root, temp);
+      AddSlowPath(slow_path);
+      __ Bnez(TMP, slow_path->GetEntryLabel());
+      __ Bind(slow_path->GetExitLabel());
+    } else {
+      // GC root loaded through a slow path for read barriers other
+      // than Baker's.
+      // /* GcRoot<mirror::Object>* */ root = obj + offset
+      __ AddConst64(root_reg, obj, offset);
+      // /* mirror::Object* */ root = root->Read()
+      GenerateReadBarrierForRootSlow(instruction, root, root);
+    }
+  } else {
+    // Plain GC root load with no read barrier.
+    // Note that GC roots are not affected by heap poisoning, thus we
+    // do not have to unpoison `root_reg` here.
+  }
+}
+
+void CodeGeneratorLoongarch64::GenerateFieldLoadWithBakerReadBarrier(HInstruction* instruction,
+                                                                     Location ref,
+                                                                     XRegister obj,
+                                                                     uint32_t offset,
+                                                                     Location temp,
+                                                                     bool needs_null_check) {
+  DCHECK(kEmitCompilerReadBarrier);
+  DCHECK(kUseBakerReadBarrier);
+
+  // /* HeapReference<Object> */ ref = *(obj + offset)
+  Location no_index = Location::NoLocation();
+  GenerateReferenceLoadWithBakerReadBarrier(instruction,
+                                            ref,
+                                            obj,
+                                            offset,
+                                            no_index,
+                                            /* scale_factor= */ 0u,
+                                            temp,
+                                            needs_null_check);
+}
+
+void CodeGeneratorLoongarch64::GenerateArrayLoadWithBakerReadBarrier(HInstruction* instruction,
+                                                                     Location ref,
+                                                                     XRegister obj,
+                                                                     uint32_t data_offset,
+                                                                     Location index,
+                                                                     Location temp,
+                                                                     bool needs_null_check) {
+  DCHECK(kEmitCompilerReadBarrier);
+  DCHECK(kUseBakerReadBarrier);
+
+  static_assert(
+      sizeof(mirror::HeapReference<mirror::Object>) == sizeof(int32_t),
+      "art::mirror::HeapReference<art::mirror::Object> and int32_t have different sizes.");
+  // /* HeapReference<Object> */ ref =
+  //     *(obj + data_offset + index * sizeof(HeapReference<Object>))
+  size_t scale_factor = DataType::SizeShift(DataType::Type::kReference);
+  GenerateReferenceLoadWithBakerReadBarrier(instruction,
+                                            ref,
+                                            obj,
+                                            data_offset,
+                                            index,
+                                            scale_factor,
+                                            temp,
+                                            needs_null_check);
+}
+
+void CodeGeneratorLoongarch64::GenerateReferenceLoadWithBakerReadBarrier(HInstruction* instruction,
+                                                                         Location ref,
+                                                                         XRegister obj,
+                                                                         uint32_t offset,
+                                                                         Location index,
+                                                                         size_t scale_factor,
+                                                                         Location temp,
+                                                                         bool needs_null_check) {
+  DCHECK(kEmitCompilerReadBarrier);
+  DCHECK(kUseBakerReadBarrier);
+
+  // In slow path based read barriers, the read barrier call is
+  // inserted after the original load. However, in fast path based
+  // Baker's read barriers, we need to perform the load of
+  // mirror::Object::monitor_ *before* the original reference load.
+  // Here the marking entrypoint doubles as the "is marking" flag:
+  //
+  //   temp = Thread::Current()->pReadBarrierMarkReg ## ref.reg()
+  //   ref = *(obj + offset + (index << scale_factor))
+  //   if (temp != null) {
+  //     ref = temp(ref)
+  //   }
+  //
+  // The entrypoint is null when the GC is not marking; otherwise it checks
+  // the object's gray bit itself and returns the to-space reference.
+  XRegister ref_reg = ref.AsRegister<XRegister>();
+  XRegister temp_reg = temp.AsRegister<XRegister>();
+  __ LoadFromOffset(kLoadDoubleword, temp_reg, TR, ReadBarrierMarkEntrypointOffset(ref_reg));
+
+  if (index.IsValid()) {
+    if (index.IsConstant()) {
+      size_t computed_offset =
+          (index.GetConstant()->AsIntConstant()->GetValue() << scale_factor) + offset;
+      __ LoadFromOffset(kLoadUnsignedWord, ref_reg, obj, computed_offset);
+    } else {
+      XRegister index_reg = index.AsRegister<XRegister>();
+      if (scale_factor == 0u) {
+        __ AddD(TMP2, index_reg, obj);
+      } else {
+        __ AlslD(TMP2, index_reg, obj, scale_factor);
+      }
+      __ LoadFromOffset(kLoadUnsignedWord, ref_reg, TMP2, offset);
+    }
+  } else {
+    // /* HeapReference<Object> */ ref = *(obj + offset)
+    __ LoadFromOffset(kLoadUnsignedWord, ref_reg, obj, offset);
+  }
+  if (needs_null_check) {
+    MaybeRecordImplicitNullCheck(instruction);
+  }
+  // Object* ref = ref_addr->AsMirrorPtr()
+  __ MaybeUnpoisonHeapReference(ref_reg);
+
+  SlowPathCodeLoongarch64* slow_path = new (GetScopedAllocator())
+      ReadBarrierMarkSlowPathLoongarch64(instruction, ref, temp);
+  AddSlowPath(slow_path);
+  __ Bnez(temp_reg, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void CodeGeneratorLoongarch64::GenerateReadBarrierSlow(HInstruction* instruction,
+                                                       Location out,
+                                                       Location ref,
+                                                       Location obj,
+                                                       uint32_t offset,
+                                                       Location index) {
+  DCHECK(kEmitCompilerReadBarrier);
+
+  // Insert a slow path based read barrier *after* the reference load.
+  //
+  // If heap poisoning is enabled, the unpoisoning of the loaded
+  // reference will be carried out by the runtime within the slow
+  // path.
+  //
+  // Note that `ref` currently does not get unpoisoned (when heap
+  // poisoning is enabled), which is alright as the `ref` argument is
+  // not used by the artReadBarrierSlow entry point.
+  //
+  // TODO: Unpoison `ref` when it is used by artReadBarrierSlow.
+  SlowPathCodeLoongarch64* slow_path = new (GetScopedAllocator())
+      ReadBarrierForHeapReferenceSlowPathLoongarch64(instruction, out, ref, obj, offset, index);
+  AddSlowPath(slow_path);
+
+  __ B(slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void CodeGeneratorLoongarch64::MaybeGenerateReadBarrierSlow(HInstruction* instruction,
+                                                            Location out,
+                                                            Location ref,
+                                                            Location obj,
+                                                            uint32_t offset,
+                                                            Location index) {
+  if (kEmitCompilerReadBarrier) {
+    // Baker's read barriers shall be handled by the fast path
+    // (CodeGeneratorLoongarch64::GenerateReferenceLoadWithBakerReadBarrier).
+    DCHECK(!kUseBakerReadBarrier);
+    // If heap poisoning is enabled, unpoisoning will be taken care of
+    // by the runtime within the slow path.
+    GenerateReadBarrierSlow(instruction, out, ref, obj, offset, index);
+  } else if (kPoisonHeapReferences) {
+    __ UnpoisonHeapReference(out.AsRegister<XRegister>());
+  }
+}
+
+void CodeGeneratorLoongarch64::GenerateReadBarrierForRootSlow(HInstruction* instruction,
+                                                              Location out,
+                                                              Location root) {
+  DCHECK(kEmitCompilerReadBarrier);
+
+  // Insert a slow path based read barrier *after* the GC root load.
+  //
+  // Note that GC roots are not affected by heap poisoning, so we do
+  // not need to do anything special for this here.
+  SlowPathCodeLoongarch64* slow_path =
+      new (GetScopedAllocator()) ReadBarrierForRootSlowPathLoongarch64(instruction, out, root);
+  AddSlowPath(slow_path);
+
+  __ B(slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
+InstructionCodeGeneratorLoongarch64::InstructionCodeGeneratorLoongarch64(
+    HGraph* graph, CodeGeneratorLoongarch64* codegen)
+    : InstructionCodeGenerator(graph, codegen),
+      assembler_(codegen->GetAssembler()),
+      codegen_(codegen) {}
+
+void InstructionCodeGeneratorLoongarch64::GenerateMemoryBarrier(
+    MemBarrierKind kind ATTRIBUTE_UNUSED) {
+  // `dbar` with hint 0 is a full barrier. Cores that do not implement the finer
+  // grained hints treat every hint as 0, so we always use the full barrier.
+  __ Dbar(0);
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateSuspendCheck(HSuspendCheck* instruction,
+                                                               HBasicBlock* successor) {
+  SuspendCheckSlowPathLoongarch64* slow_path =
+      down_cast<SuspendCheckSlowPathLoongarch64*>(instruction->GetSlowPath());
+
+  if (slow_path == nullptr) {
+    slow_path =
+        new (codegen_->GetScopedAllocator()) SuspendCheckSlowPathLoongarch64(instruction, successor);
+    instruction->SetSlowPath(slow_path);
+    codegen_->AddSlowPath(slow_path);
+    if (successor != nullptr) {
+      DCHECK(successor->IsLoopHeader());
+    }
+  } else {
+    DCHECK_EQ(slow_path->GetSuccessor(), successor);
+  }
+
+  __ LoadFromOffset(kLoadUnsignedHalfword,
+                    TMP,
+                    TR,
+                    Thread::ThreadFlagsOffset<kLoongarch64PointerSize>().Int32Value());
+  if (successor == nullptr) {
+    __ Bnez(TMP, slow_path->GetEntryLabel());
+    __ Bind(slow_path->GetReturnLabel());
+  } else {
+    __ Beqz(TMP, codegen_->GetLabelOf(successor));
+    __ B(slow_path->GetEntryLabel());
+    // slow_path will return to GetLabelOf(successor).
+  }
+}
+
+void LocationsBuilderLoongarch64::HandleBinaryOp(HBinaryOperation* instruction) {
+  DCHECK_EQ(instruction->InputCount(), 2U);
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  DataType::Type type = instruction->GetResultType();
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64: {
+      locations->SetInAt(0, Location::RequiresRegister());
+      HInstruction* right = instruction->InputAt(1);
+      bool can_use_imm = false;
+      if (right->IsConstant()) {
+        int64_t imm = CodeGenerator::GetInt64ValueOf(right->AsConstant());
+        if (instruction->IsAnd() || instruction->IsOr() || instruction->IsXor()) {
+          can_use_imm = IsUint<12>(imm);
+        } else if (instruction->IsAdd()) {
+          can_use_imm = IsInt<12>(imm);
+        } else {
+          DCHECK(instruction->IsSub());
+          // The subtraction is emitted as an addition of the negated immediate.
+          can_use_imm = (imm != std::numeric_limits<int64_t>::min()) && IsInt<12>(-imm);
+        }
+      }
+      if (can_use_imm) {
+        locations->SetInAt(1, Location::ConstantLocation(right->AsConstant()));
+      } else {
+        locations->SetInAt(1, Location::RequiresRegister());
+      }
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+    }
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected " << instruction->DebugName() << " type " << type;
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::HandleBinaryOp(HBinaryOperation* instruction) {
+  DataType::Type type = instruction->GetType();
+  LocationSummary* locations = instruction->GetLocations();
+
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64: {
+      XRegister dst = locations->Out().AsRegister<XRegister>();
+      XRegister lhs = locations->InAt(0).AsRegister<XRegister>();
+      Location rhs_location = locations->InAt(1);
+
+      XRegister rhs_reg = Zero;
+      int64_t rhs_imm = 0;
+      bool use_imm = rhs_location.IsConstant();
+      if (use_imm) {
+        rhs_imm = CodeGenerator::GetInt64ValueOf(rhs_location.GetConstant());
+      } else {
+        rhs_reg = rhs_location.AsRegister<XRegister>();
+      }
+
+      if (instruction->IsAnd()) {
+        if (use_imm) {
+          __ Andi(dst, lhs, rhs_imm);
+        } else {
+          __ And(dst, lhs, rhs_reg);
+        }
+      } else if (instruction->IsOr()) {
+        if (use_imm) {
+          __ Ori(dst, lhs, rhs_imm);
+        } else {
+          __ Or(dst, lhs, rhs_reg);
+        }
+      } else if (instruction->IsXor()) {
+        if (use_imm) {
+          __ Xori(dst, lhs, rhs_imm);
+        } else {
+          __ Xor(dst, lhs, rhs_reg);
+        }
+      } else if (instruction->IsAdd()) {
+        if (type == DataType::Type::kInt32) {
+          if (use_imm) {
+            __ AddiW(dst, lhs, rhs_imm);
+          } else {
+            __ AddW(dst, lhs, rhs_reg);
+          }
+        } else {
+          if (use_imm) {
+            __ AddiD(dst, lhs, rhs_imm);
+          } else {
+            __ AddD(dst, lhs, rhs_reg);
+          }
+        }
+      } else {
+        DCHECK(instruction->IsSub());
+        if (type == DataType::Type::kInt32) {
+          if (use_imm) {
+            __ AddiW(dst, lhs, -rhs_imm);
+          } else {
+            __ SubW(dst, lhs, rhs_reg);
+          }
+        } else {
+          if (use_imm) {
+            __ AddiD(dst, lhs, -rhs_imm);
+          } else {
+            __ SubD(dst, lhs, rhs_reg);
+          }
+        }
+      }
+      break;
+    }
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64: {
+      FRegister dst = locations->Out().AsFpuRegister<FRegister>();
+      FRegister lhs = locations->InAt(0).AsFpuRegister<FRegister>();
+      FRegister rhs = locations->InAt(1).AsFpuRegister<FRegister>();
+      if (instruction->IsAdd()) {
+        if (type == DataType::Type::kFloat32) {
+          __ FaddS(dst, lhs, rhs);
+        } else {
+          __ FaddD(dst, lhs, rhs);
+        }
+      } else if (instruction->IsSub()) {
+        if (type == DataType::Type::kFloat32) {
+          __ FsubS(dst, lhs, rhs);
+        } else {
+          __ FsubD(dst, lhs, rhs);
+        }
+      } else {
+        LOG(FATAL) << "Unexpected floating-point binary operation";
+      }
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected binary operation type " << type;
+  }
+}
+
+void LocationsBuilderLoongarch64::HandleShift(HBinaryOperation* instr) {
+  DCHECK(instr->IsShl() || instr->IsShr() || instr->IsUShr() || instr->IsRor());
+
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instr);
+  DataType::Type type = instr->GetResultType();
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64: {
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RegisterOrConstant(instr->InputAt(1)));
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected shift type " << type;
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::HandleShift(HBinaryOperation* instr) {
+  DCHECK(instr->IsShl() || instr->IsShr() || instr->IsUShr() || instr->IsRor());
+  LocationSummary* locations = instr->GetLocations();
+  DataType::Type type = instr->GetType();
+
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64: {
+      XRegister dst = locations->Out().AsRegister<XRegister>();
+      XRegister lhs = locations->InAt(0).AsRegister<XRegister>();
+      Location rhs_location = locations->InAt(1);
+
+      if (rhs_location.IsConstant()) {
+        int64_t rhs_imm = CodeGenerator::GetInt64ValueOf(rhs_location.GetConstant());
+        if (type == DataType::Type::kInt32) {
+          uint32_t shift_value = rhs_imm & kMaxIntShiftDistance;
+          if (instr->IsShl()) {
+            __ SlliW(dst, lhs, shift_value);
+          } else if (instr->IsShr()) {
+            __ SraiW(dst, lhs, shift_value);
+          } else if (instr->IsUShr()) {
+            __ SrliW(dst, lhs, shift_value);
+          } else {
+            __ RotriW(dst, lhs, shift_value);
+          }
+        } else {
+          uint32_t shift_value = rhs_imm & kMaxLongShiftDistance;
+          if (instr->IsShl()) {
+            __ SlliD(dst, lhs, shift_value);
+          } else if (instr->IsShr()) {
+            __ SraiD(dst, lhs, shift_value);
+          } else if (instr->IsUShr()) {
+            __ SrliD(dst, lhs, shift_value);
+          } else {
+            __ RotriD(dst, lhs, shift_value);
+          }
+        }
+      } else {
+        // The register forms only use the low 5 (32-bit) or 6 (64-bit) bits
+        // of the shift distance, which matches the Java semantics.
+        XRegister rhs_reg = rhs_location.AsRegister<XRegister>();
+        if (type == DataType::Type::kInt32) {
+          if (instr->IsShl()) {
+            __ SllW(dst, lhs, rhs_reg);
+          } else if (instr->IsShr()) {
+            __ SraW(dst, lhs, rhs_reg);
+          } else if (instr->IsUShr()) {
+            __ SrlW(dst, lhs, rhs_reg);
+          } else {
+            __ RotrW(dst, lhs, rhs_reg);
+          }
+        } else {
+          if (instr->IsShl()) {
+            __ SllD(dst, lhs, rhs_reg);
+          } else if (instr->IsShr()) {
+            __ SraD(dst, lhs, rhs_reg);
+          } else if (instr->IsUShr()) {
+            __ SrlD(dst, lhs, rhs_reg);
+          } else {
+            __ RotrD(dst, lhs, rhs_reg);
+          }
+        }
+      }
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected shift operation type " << type;
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitAdd(HAdd* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitAdd(HAdd* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void LocationsBuilderLoongarch64::VisitAnd(HAnd* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitAnd(HAnd* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void LocationsBuilderLoongarch64::VisitOr(HOr* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitOr(HOr* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void LocationsBuilderLoongarch64::VisitXor(HXor* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitXor(HXor* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void LocationsBuilderLoongarch64::VisitSub(HSub* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitSub(HSub* instruction) {
+  HandleBinaryOp(instruction);
+}
+
+void LocationsBuilderLoongarch64::VisitShl(HShl* shl) {
+  HandleShift(shl);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitShl(HShl* shl) {
+  HandleShift(shl);
+}
+
+void LocationsBuilderLoongarch64::VisitShr(HShr* shr) {
+  HandleShift(shr);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitShr(HShr* shr) {
+  HandleShift(shr);
+}
+
+void LocationsBuilderLoongarch64::VisitUShr(HUShr* ushr) {
+  HandleShift(ushr);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitUShr(HUShr* ushr) {
+  HandleShift(ushr);
+}
+
+void LocationsBuilderLoongarch64::VisitRor(HRor* ror) {
+  HandleShift(ror);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitRor(HRor* ror) {
+  HandleShift(ror);
+}
+
+void LocationsBuilderLoongarch64::VisitMul(HMul* mul) {
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(mul, LocationSummary::kNoCall);
+  switch (mul->GetResultType()) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RequiresRegister());
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected mul type " << mul->GetResultType();
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitMul(HMul* instruction) {
+  DataType::Type type = instruction->GetType();
+  LocationSummary* locations = instruction->GetLocations();
+
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64: {
+      XRegister dst = locations->Out().AsRegister<XRegister>();
+      XRegister lhs = locations->InAt(0).AsRegister<XRegister>();
+      XRegister rhs = locations->InAt(1).AsRegister<XRegister>();
+      if (type == DataType::Type::kInt32) {
+        __ MulW(dst, lhs, rhs);
+      } else {
+        __ MulD(dst, lhs, rhs);
+      }
+      break;
+    }
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64: {
+      FRegister dst = locations->Out().AsFpuRegister<FRegister>();
+      FRegister lhs = locations->InAt(0).AsFpuRegister<FRegister>();
+      FRegister rhs = locations->InAt(1).AsFpuRegister<FRegister>();
+      if (type == DataType::Type::kFloat32) {
+        __ FmulS(dst, lhs, rhs);
+      } else {
+        __ FmulD(dst, lhs, rhs);
+      }
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected mul type " << type;
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::DivRemOneOrMinusOne(HBinaryOperation* instruction) {
+  DCHECK(instruction->IsDiv() || instruction->IsRem());
+
+  LocationSummary* locations = instruction->GetLocations();
+  Location second = locations->InAt(1);
+  DCHECK(second.IsConstant());
+
+  XRegister out = locations->Out().AsRegister<XRegister>();
+  XRegister dividend = locations->InAt(0).AsRegister<XRegister>();
+  int64_t imm = CodeGenerator::GetInt64ValueOf(second.GetConstant());
+  DCHECK(imm == 1 || imm == -1);
+
+  if (instruction->IsRem()) {
+    __ Clear(out);
+  } else {
+    if (imm == -1) {
+      if (instruction->GetResultType() == DataType::Type::kInt32) {
+        __ SubW(out, Zero, dividend);
+      } else {
+        DCHECK_EQ(instruction->GetResultType(), DataType::Type::kInt64);
+        __ SubD(out, Zero, dividend);
+      }
+    } else if (out != dividend) {
+      __ Move(out, dividend);
+    }
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::DivRemByPowerOfTwo(HBinaryOperation* instruction) {
+  DCHECK(instruction->IsDiv() || instruction->IsRem());
+
+  LocationSummary* locations = instruction->GetLocations();
+  Location second = locations->InAt(1);
+  DCHECK(second.IsConstant());
+
+  XRegister out = locations->Out().AsRegister<XRegister>();
+  XRegister dividend = locations->InAt(0).AsRegister<XRegister>();
+  int64_t imm = CodeGenerator::GetInt64ValueOf(second.GetConstant());
+  uint64_t abs_imm = static_cast<uint64_t>(AbsOrMin(imm));
+  int ctz_imm = CTZ(abs_imm);
+  DCHECK_GE(ctz_imm, 1);
+  bool is_64bit = (instruction->GetResultType() == DataType::Type::kInt64);
+
+  // Compute in TMP the bias (abs_imm - 1) to add to negative dividends so that
+  // the arithmetic shift below rounds towards zero.
+  if (ctz_imm == 1) {
+    // Fast path for division by +/-2, which is very common.
+    if (is_64bit) {
+      __ SrliD(TMP, dividend, 63);
+    } else {
+      __ SrliW(TMP, dividend, 31);
+    }
+  } else {
+    if (is_64bit) {
+      __ SraiD(TMP, dividend, 63);
+      __ SrliD(TMP, TMP, 64 - ctz_imm);
+    } else {
+      __ SraiW(TMP, dividend, 31);
+      __ SrliW(TMP, TMP, 32 - ctz_imm);
+    }
+  }
+
+  if (instruction->IsDiv()) {
+    if (is_64bit) {
+      __ AddD(out, dividend, TMP);
+      __ SraiD(out, out, ctz_imm);
+      if (imm < 0) {
+        __ SubD(out, Zero, out);
+      }
+    } else {
+      __ AddW(out, dividend, TMP);
+      __ SraiW(out, out, ctz_imm);
+      if (imm < 0) {
+        __ SubW(out, Zero, out);
+      }
+    }
+  } else {
+    if (is_64bit) {
+      __ AddD(out, dividend, TMP);
+      __ BstrpickD(out, out, ctz_imm - 1, 0);
+      __ SubD(out, out, TMP);
+    } else {
+      __ AddW(out, dividend, TMP);
+      __ BstrpickD(out, out, ctz_imm - 1, 0);
+      __ SubW(out, out, TMP);
+    }
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateDivRemWithAnyConstant(
+    HBinaryOperation* instruction) {
+  DCHECK(instruction->IsDiv() || instruction->IsRem());
+
+  LocationSummary* locations = instruction->GetLocations();
+  Location second = locations->InAt(1);
+  DCHECK(second.IsConstant());
+
+  XRegister out = locations->Out().AsRegister<XRegister>();
+  XRegister dividend = locations->InAt(0).AsRegister<XRegister>();
+  int64_t imm = CodeGenerator::GetInt64ValueOf(second.GetConstant());
+  bool is_64bit = (instruction->GetResultType() == DataType::Type::kInt64);
+
+  int64_t magic;
+  int shift;
+  CalculateMagicAndShiftForDivRem(imm, is_64bit, &magic, &shift);
+
+  __ LoadConst64(TMP, magic);
+  if (is_64bit) {
+    __ MulhD(TMP, dividend, TMP);
+    if (imm > 0 && magic < 0) {
+      __ AddD(TMP, TMP, dividend);
+    } else if (imm < 0 && magic > 0) {
+      __ SubD(TMP, TMP, dividend);
+    }
+    if (shift != 0) {
+      __ SraiD(TMP, TMP, shift);
+    }
+    if (instruction->IsDiv()) {
+      __ SraiD(out, TMP, 63);
+      __ SubD(out, TMP, out);
+    } else {
+      __ SraiD(TMP2, TMP, 63);
+      __ SubD(TMP, TMP, TMP2);
+      __ LoadConst64(TMP2, imm);
+      __ MulD(TMP, TMP, TMP2);
+      __ SubD(out, dividend, TMP);
+    }
+  } else {
+    __ MulhW(TMP, dividend, TMP);
+    if (imm > 0 && magic < 0) {
+      __ AddW(TMP, TMP, dividend);
+    } else if (imm < 0 && magic > 0) {
+      __ SubW(TMP, TMP, dividend);
+    }
+    if (shift != 0) {
+      __ SraiW(TMP, TMP, shift);
+    }
+    if (instruction->IsDiv()) {
+      __ SraiW(out, TMP, 31);
+      __ SubW(out, TMP, out);
+    } else {
+      __ SraiW(TMP2, TMP, 31);
+      __ SubW(TMP, TMP, TMP2);
+      __ LoadConst32(TMP2, dchecked_integral_cast<int32_t>(imm));
+      __ MulW(TMP, TMP, TMP2);
+      __ SubW(out, dividend, TMP);
+    }
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateDivRemIntegral(HBinaryOperation* instruction) {
+  DCHECK(instruction->IsDiv() || instruction->IsRem());
+  DataType::Type type = instruction->GetResultType();
+  DCHECK(type == DataType::Type::kInt32 || type == DataType::Type::kInt64) << type;
+
+  LocationSummary* locations = instruction->GetLocations();
+  XRegister out = locations->Out().AsRegister<XRegister>();
+  Location second = locations->InAt(1);
+
+  if (second.IsConstant()) {
+    int64_t imm = CodeGenerator::GetInt64ValueOf(second.GetConstant());
+    if (imm == 0) {
+      // Do not generate anything. DivZeroCheck would prevent any code to be executed.
+    } else if (imm == 1 || imm == -1) {
+      DivRemOneOrMinusOne(instruction);
+    } else if (IsPowerOfTwo(AbsOrMin(imm))) {
+      DivRemByPowerOfTwo(instruction);
+    } else {
+      DCHECK(imm <= -2 || imm >= 2);
+      GenerateDivRemWithAnyConstant(instruction);
+    }
+  } else {
+    XRegister dividend = locations->InAt(0).AsRegister<XRegister>();
+    XRegister divisor = second.AsRegister<XRegister>();
+    if (instruction->IsDiv()) {
+      if (type == DataType::Type::kInt32) {
+        __ DivW(out, dividend, divisor);
+      } else {
+        __ DivD(out, dividend, divisor);
+      }
+    } else {
+      if (type == DataType::Type::kInt32) {
+        __ ModW(out, dividend, divisor);
+      } else {
+        __ ModD(out, dividend, divisor);
+      }
+    }
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitDiv(HDiv* div) {
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(div, LocationSummary::kNoCall);
+  switch (div->GetResultType()) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RegisterOrConstant(div->InputAt(1)));
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected div type " << div->GetResultType();
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitDiv(HDiv* instruction) {
+  DataType::Type type = instruction->GetType();
+  LocationSummary* locations = instruction->GetLocations();
+
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      GenerateDivRemIntegral(instruction);
+      break;
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64: {
+      FRegister dst = locations->Out().AsFpuRegister<FRegister>();
+      FRegister lhs = locations->InAt(0).AsFpuRegister<FRegister>();
+      FRegister rhs = locations->InAt(1).AsFpuRegister<FRegister>();
+      if (type == DataType::Type::kFloat32) {
+        __ FdivS(dst, lhs, rhs);
+      } else {
+        __ FdivD(dst, lhs, rhs);
+      }
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected div type " << type;
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitRem(HRem* rem) {
+  DataType::Type type = rem->GetResultType();
+  LocationSummary::CallKind call_kind =
+      DataType::IsFloatingPointType(type) ? LocationSummary::kCallOnMainOnly
+                                          : LocationSummary::kNoCall;
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(rem, call_kind);
+
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RegisterOrConstant(rem->InputAt(1)));
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64: {
+      InvokeRuntimeCallingConvention calling_convention;
+      locations->SetInAt(0, Location::FpuRegisterLocation(calling_convention.GetFpuRegisterAt(0)));
+      locations->SetInAt(1, Location::FpuRegisterLocation(calling_convention.GetFpuRegisterAt(1)));
+      locations->SetOut(calling_convention.GetReturnLocation(type));
+      break;
+    }
+
+    default:
+      LOG(FATAL) << "Unexpected rem type " << type;
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitRem(HRem* instruction) {
+  DataType::Type type = instruction->GetType();
+
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      GenerateDivRemIntegral(instruction);
+      break;
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64: {
+      QuickEntrypointEnum entrypoint =
+          (type == DataType::Type::kFloat32) ? kQuickFmodf : kQuickFmod;
+      codegen_->InvokeRuntime(entrypoint, instruction, instruction->GetDexPc());
+      if (type == DataType::Type::kFloat32) {
+        CheckEntrypointTypes<kQuickFmodf, float, float, float>();
+      } else {
+        CheckEntrypointTypes<kQuickFmod, double, double, double>();
+      }
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected rem type " << type;
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  LocationSummary* locations = codegen_->CreateThrowingSlowPathLocations(instruction);
+  locations->SetInAt(0, Location::RegisterOrConstant(instruction->InputAt(0)));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitDivZeroCheck(HDivZeroCheck* instruction) {
+  SlowPathCodeLoongarch64* slow_path =
+      new (codegen_->GetScopedAllocator()) DivZeroCheckSlowPathLoongarch64(instruction);
+  codegen_->AddSlowPath(slow_path);
+  Location value = instruction->GetLocations()->InAt(0);
+
+  DataType::Type type = instruction->GetType();
+
+  if (!DataType::IsIntegralType(type)) {
+    LOG(FATAL) << "Unexpected type " << type << " for DivZeroCheck.";
+    UNREACHABLE();
+  }
+
+  if (value.IsConstant()) {
+    int64_t divisor = CodeGenerator::GetInt64ValueOf(value.GetConstant()->AsConstant());
+    if (divisor == 0) {
+      __ B(slow_path->GetEntryLabel());
+    } else {
+      // A division by a non-null constant is valid. We don't need to perform
+      // any check, so simply fall through.
+    }
+  } else {
+    __ Beqz(value.AsRegister<XRegister>(), slow_path->GetEntryLabel());
+  }
+}
+
+bool InstructionCodeGeneratorLoongarch64::MaterializeIntLongCompare(IfCondition cond,
+                                                                    bool is_64bit,
+                                                                    LocationSummary* locations,
+                                                                    XRegister dst) {
+  XRegister lhs = locations->InAt(0).AsRegister<XRegister>();
+  Location rhs_location = locations->InAt(1);
+  XRegister rhs_reg = Zero;
+  int64_t rhs_imm = 0;
+  bool use_imm = rhs_location.IsConstant();
+  if (use_imm) {
+    rhs_imm = CodeGenerator::GetInt64ValueOf(rhs_location.GetConstant());
+  } else {
+    rhs_reg = rhs_location.AsRegister<XRegister>();
+  }
+  // 32-bit values are kept sign-extended, so the 64-bit comparisons below are
+  // correct for them as well; `is_64bit` only bounds the immediate range.
+  int64_t max_imm = is_64bit ? std::numeric_limits<int64_t>::max()
+                             : std::numeric_limits<int32_t>::max();
+
+  switch (cond) {
+    case kCondEQ:
+    case kCondNE:
+      if (use_imm && IsUint<12>(rhs_imm)) {
+        __ Xori(dst, lhs, rhs_imm);
+      } else if (use_imm && rhs_imm != std::numeric_limits<int64_t>::min() && IsInt<12>(-rhs_imm)) {
+        __ AddiD(dst, lhs, -rhs_imm);
+      } else {
+        if (use_imm) {
+          rhs_reg = TMP;
+          __ LoadConst64(rhs_reg, rhs_imm);
+        }
+        __ Xor(dst, lhs, rhs_reg);
+      }
+      return (cond == kCondEQ);
+
+    case kCondLT:
+    case kCondGE:
+      if (use_imm && IsInt<12>(rhs_imm)) {
+        __ Slti(dst, lhs, rhs_imm);
+      } else {
+        if (use_imm) {
+          rhs_reg = TMP;
+          __ LoadConst64(rhs_reg, rhs_imm);
+        }
+        __ Slt(dst, lhs, rhs_reg);
+      }
+      return (cond == kCondGE);
+
+    case kCondLE:
+    case kCondGT:
+      if (use_imm && rhs_imm != max_imm && IsInt<12>(rhs_imm + 1)) {
+        // Simulate lhs <= rhs via lhs < rhs + 1.
+        __ Slti(dst, lhs, rhs_imm + 1);
+        return (cond == kCondGT);
+      } else {
+        if (use_imm) {
+          rhs_reg = TMP;
+          __ LoadConst64(rhs_reg, rhs_imm);
+        }
+        __ Slt(dst, rhs_reg, lhs);
+        return (cond == kCondLE);
+      }
+
+    case kCondB:
+    case kCondAE:
+      if (use_imm && IsInt<12>(rhs_imm)) {
+        // Sltui sign-extends its 12-bit immediate before the unsigned comparison.
+        __ Sltui(dst, lhs, rhs_imm);
+      } else {
+        if (use_imm) {
+          rhs_reg = TMP;
+          __ LoadConst64(rhs_reg, rhs_imm);
+        }
+        __ Sltu(dst, lhs, rhs_reg);
+      }
+      return (cond == kCondAE);
+
+    case kCondBE:
+    case kCondA:
+      if (use_imm && (rhs_imm != -1) && IsInt<12>(rhs_imm + 1)) {
+        // Simulate lhs <= rhs via lhs < rhs + 1.
+        // Note that this only works if rhs + 1 does not overflow to 0,
+        // hence the check above.
+        __ Sltui(dst, lhs, rhs_imm + 1);
+        return (cond == kCondA);
+      } else {
+        if (use_imm) {
+          rhs_reg = TMP;
+          __ LoadConst64(rhs_reg, rhs_imm);
+        }
+        __ Sltu(dst, rhs_reg, lhs);
+        return (cond == kCondBE);
+      }
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateIntLongCompare(IfCondition cond,
+                                                                 bool is_64bit,
+                                                                 LocationSummary* locations) {
+  XRegister dst = locations->Out().AsRegister<XRegister>();
+  bool inverted = MaterializeIntLongCompare(cond, is_64bit, locations, dst);
+  if (cond == kCondEQ || cond == kCondNE) {
+    // `dst` holds the difference of the operands; normalize it to 0 or 1.
+    if (cond == kCondEQ) {
+      __ Sltui(dst, dst, 1);
+    } else {
+      __ Sltu(dst, Zero, dst);
+    }
+  } else if (inverted) {
+    __ Xori(dst, dst, 1);
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateIntLongCompareAndBranch(
+    IfCondition cond,
+    bool is_64bit ATTRIBUTE_UNUSED,
+    LocationSummary* locations,
+    Loongarch64Label* label) {
+  XRegister lhs = locations->InAt(0).AsRegister<XRegister>();
+  Location rhs_location = locations->InAt(1);
+
+  if (rhs_location.IsConstant() &&
+      CodeGenerator::GetInt64ValueOf(rhs_location.GetConstant()) == 0) {
+    switch (cond) {
+      case kCondEQ:
+      case kCondBE:  // <= 0 if zero
+        __ Beqz(lhs, label);
+        break;
+      case kCondNE:
+      case kCondA:  // > 0 if non-zero
+        __ Bnez(lhs, label);
+        break;
+      case kCondLT:
+        __ Blt(lhs, Zero, label);
+        break;
+      case kCondGE:
+        __ Bge(lhs, Zero, label);
+        break;
+      case kCondLE:
+        __ Ble(lhs, Zero, label);
+        break;
+      case kCondGT:
+        __ Bgt(lhs, Zero, label);
+        break;
+      case kCondB:  // always false
+        break;
+      case kCondAE:  // always true
+        __ B(label);
+        break;
+    }
+    return;
+  }
+
+  XRegister rhs_reg;
+  if (rhs_location.IsConstant()) {
+    rhs_reg = TMP;
+    __ LoadConst64(rhs_reg, CodeGenerator::GetInt64ValueOf(rhs_location.GetConstant()));
+  } else {
+    rhs_reg = rhs_location.AsRegister<XRegister>();
+  }
+  switch (cond) {
+    case kCondEQ:
+      __ Beq(lhs, rhs_reg, label);
+      break;
+    case kCondNE:
+      __ Bne(lhs, rhs_reg, label);
+      break;
+    case kCondLT:
+      __ Blt(lhs, rhs_reg, label);
+      break;
+    case kCondGE:
+      __ Bge(lhs, rhs_reg, label);
+      break;
+    case kCondLE:
+      __ Ble(lhs, rhs_reg, label);
+      break;
+    case kCondGT:
+      __ Bgt(lhs, rhs_reg, label);
+      break;
+    case kCondB:
+      __ Bltu(lhs, rhs_reg, label);
+      break;
+    case kCondAE:
+      __ Bgeu(lhs, rhs_reg, label);
+      break;
+    case kCondBE:
+      __ Bleu(lhs, rhs_reg, label);
+      break;
+    case kCondA:
+      __ Bgtu(lhs, rhs_reg, label);
+      break;
+  }
+}
+
+bool InstructionCodeGeneratorLoongarch64::MaterializeFpCompare(IfCondition cond,
+                                                               bool gt_bias,
+                                                               DataType::Type type,
+                                                               LocationSummary* locations) {
+  FRegister lhs = locations->InAt(0).AsFpuRegister<FRegister>();
+  FRegister rhs = locations->InAt(1).AsFpuRegister<FRegister>();
+
+  // Conditions that are true for unordered operands use the unordered
+  // ("U") variants of `fcmp`. Greater-than conditions swap the operands.
+  FpCondition fp_cond;
+  bool swap_operands = false;
+  switch (cond) {
+    case kCondEQ:
+      fp_cond = kCEQ;
+      break;
+    case kCondNE:
+      fp_cond = kCUNE;
+      break;
+    case kCondLT:
+      fp_cond = gt_bias ? kCLT : kCULT;
+      break;
+    case kCondLE:
+      fp_cond = gt_bias ? kCLE : kCULE;
+      break;
+    case kCondGT:
+      fp_cond = gt_bias ? kCULT : kCLT;
+      swap_operands = true;
+      break;
+    case kCondGE:
+      fp_cond = gt_bias ? kCULE : kCLE;
+      swap_operands = true;
+      break;
+    default:
+      LOG(FATAL) << "Unexpected non-floating-point condition " << cond;
+      UNREACHABLE();
+  }
+  if (swap_operands) {
+    std::swap(lhs, rhs);
+  }
+  if (type == DataType::Type::kFloat32) {
+    __ FcmpS(fp_cond, FCC0, lhs, rhs);
+  } else {
+    DCHECK_EQ(type, DataType::Type::kFloat64);
+    __ FcmpD(fp_cond, FCC0, lhs, rhs);
+  }
+  return false;
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateFpCompare(IfCondition cond,
+                                                            bool gt_bias,
+                                                            DataType::Type type,
+                                                            LocationSummary* locations) {
+  XRegister dst = locations->Out().AsRegister<XRegister>();
+  bool inverted = MaterializeFpCompare(cond, gt_bias, type, locations);
+  __ Movcf2gr(dst, FCC0);
+  if (inverted) {
+    __ Xori(dst, dst, 1);
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateFpCompareAndBranch(IfCondition cond,
+                                                                     bool gt_bias,
+                                                                     DataType::Type type,
+                                                                     LocationSummary* locations,
+                                                                     Loongarch64Label* label) {
+  bool inverted = MaterializeFpCompare(cond, gt_bias, type, locations);
+  if (inverted) {
+    __ Bceqz(FCC0, label);
+  } else {
+    __ Bcnez(FCC0, label);
+  }
+}
+
+void LocationsBuilderLoongarch64::HandleCondition(HCondition* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  switch (instruction->InputAt(0)->GetType()) {
+    default:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RegisterOrConstant(instruction->InputAt(1)));
+      break;
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      break;
+  }
+  if (!instruction->IsEmittedAtUseSite()) {
+    locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::HandleCondition(HCondition* instruction) {
+  if (instruction->IsEmittedAtUseSite()) {
+    return;
+  }
+
+  DataType::Type type = instruction->InputAt(0)->GetType();
+  LocationSummary* locations = instruction->GetLocations();
+
+  switch (type) {
+    default:
+      // Integer case.
+      GenerateIntLongCompare(instruction->GetCondition(), /* is_64bit= */ false, locations);
+      return;
+    case DataType::Type::kInt64:
+      GenerateIntLongCompare(instruction->GetCondition(), /* is_64bit= */ true, locations);
+      return;
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      GenerateFpCompare(instruction->GetCondition(), instruction->IsGtBias(), type, locations);
+      return;
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitEqual(HEqual* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitEqual(HEqual* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitNotEqual(HNotEqual* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitNotEqual(HNotEqual* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitLessThan(HLessThan* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitLessThan(HLessThan* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitLessThanOrEqual(HLessThanOrEqual* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitLessThanOrEqual(HLessThanOrEqual* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitGreaterThan(HGreaterThan* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitGreaterThan(HGreaterThan* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitGreaterThanOrEqual(HGreaterThanOrEqual* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitGreaterThanOrEqual(HGreaterThanOrEqual* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitBelow(HBelow* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitBelow(HBelow* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitBelowOrEqual(HBelowOrEqual* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitBelowOrEqual(HBelowOrEqual* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitAbove(HAbove* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitAbove(HAbove* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitAboveOrEqual(HAboveOrEqual* comp) {
+  HandleCondition(comp);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitAboveOrEqual(HAboveOrEqual* comp) {
+  HandleCondition(comp);
+}
+
+void LocationsBuilderLoongarch64::VisitCompare(HCompare* compare) {
+  DataType::Type in_type = compare->InputAt(0)->GetType();
+
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(compare);
+
+  switch (in_type) {
+    case DataType::Type::kBool:
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RegisterOrConstant(compare->InputAt(1)));
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected type for compare operation " << in_type;
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitCompare(HCompare* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  XRegister res = locations->Out().AsRegister<XRegister>();
+  DataType::Type in_type = instruction->InputAt(0)->GetType();
+
+  //  0 if: left == right
+  //  1 if: left  > right
+  // -1 if: left  < right
+  switch (in_type) {
+    case DataType::Type::kBool:
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64: {
+      XRegister lhs = locations->InAt(0).AsRegister<XRegister>();
+      Location rhs_location = locations->InAt(1);
+      XRegister rhs = Zero;
+      if (rhs_location.IsConstant()) {
+        int64_t value = CodeGenerator::GetInt64ValueOf(rhs_location.GetConstant());
+        if (value != 0) {
+          rhs = TMP2;
+          __ LoadConst64(rhs, value);
+        }
+      } else {
+        rhs = rhs_location.AsRegister<XRegister>();
+      }
+      __ Slt(TMP, lhs, rhs);
+      __ Slt(res, rhs, lhs);
+      __ SubW(res, res, TMP);
+      break;
+    }
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64: {
+      FRegister lhs = locations->InAt(0).AsFpuRegister<FRegister>();
+      FRegister rhs = locations->InAt(1).AsFpuRegister<FRegister>();
+      // With gt bias an unordered comparison yields 1, otherwise -1.
+      bool gt_bias = instruction->IsGtBias();
+      if (in_type == DataType::Type::kFloat32) {
+        __ FcmpS(gt_bias ? kCLT : kCULT, FCC0, lhs, rhs);
+        __ Movcf2gr(TMP, FCC0);
+        __ FcmpS(gt_bias ? kCULT : kCLT, FCC0, rhs, lhs);
+      } else {
+        __ FcmpD(gt_bias ? kCLT : kCULT, FCC0, lhs, rhs);
+        __ Movcf2gr(TMP, FCC0);
+        __ FcmpD(gt_bias ? kCULT : kCLT, FCC0, rhs, lhs);
+      }
+      __ Movcf2gr(res, FCC0);
+      __ SubW(res, res, TMP);
+      break;
+    }
+
+    default:
+      LOG(FATAL) << "Unimplemented compare type " << in_type;
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::HandleGoto(HInstruction* got, HBasicBlock* successor) {
+  if (successor->IsExitBlock()) {
+    DCHECK(got->GetPrevious()->AlwaysThrows());
+    return;  // no code needed
+  }
+
+  HBasicBlock* block = got->GetBlock();
+  HInstruction* previous = got->GetPrevious();
+  HLoopInformation* info = block->GetLoopInformation();
+
+  if (info != nullptr && info->IsBackEdge(*block) && info->HasSuspendCheck()) {
+    codegen_->MaybeIncrementHotness(/* is_frame_entry= */ false);
+    GenerateSuspendCheck(info->GetSuspendCheck(), successor);
+    return;
+  }
+  if (block->IsEntryBlock() && (previous != nullptr) && previous->IsSuspendCheck()) {
+    GenerateSuspendCheck(previous->AsSuspendCheck(), nullptr);
+  }
+  if (!codegen_->GoesToNextBlock(block, successor)) {
+    __ B(codegen_->GetLabelOf(successor));
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitGoto(HGoto* got) {
+  got->SetLocations(nullptr);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitGoto(HGoto* got) {
+  HandleGoto(got, got->GetSuccessor());
+}
+
+void LocationsBuilderLoongarch64::VisitTryBoundary(HTryBoundary* try_boundary) {
+  try_boundary->SetLocations(nullptr);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitTryBoundary(HTryBoundary* try_boundary) {
+  HBasicBlock* successor = try_boundary->GetNormalFlowSuccessor();
+  if (!successor->IsExitBlock()) {
+    HandleGoto(try_boundary, successor);
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitExit(HExit* exit) {
+  exit->SetLocations(nullptr);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitExit(HExit* exit ATTRIBUTE_UNUSED) {
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateTestAndBranch(HInstruction* instruction,
+                                                                size_t condition_input_index,
+                                                                Loongarch64Label* true_target,
+                                                                Loongarch64Label* false_target) {
+  HInstruction* cond = instruction->InputAt(condition_input_index);
+
+  if (true_target == nullptr && false_target == nullptr) {
+    // Nothing to do. The code always falls through.
+    return;
+  } else if (cond->IsIntConstant()) {
+    // Constant condition, statically compared against "true" (integer value 1).
+    if (cond->AsIntConstant()->IsTrue()) {
+      if (true_target != nullptr) {
+        __ B(true_target);
+      }
+    } else {
+      DCHECK(cond->AsIntConstant()->IsFalse()) << cond->AsIntConstant()->GetValue();
+      if (false_target != nullptr) {
+        __ B(false_target);
+      }
+    }
+    return;
+  }
+
+  // The following code generates these patterns:
+  //  (1) true_target == nullptr && false_target != nullptr
+  //        - opposite condition true => branch to false_target
+  //  (2) true_target != nullptr && false_target == nullptr
+  //        - condition true => branch to true_target
+  //  (3) true_target != nullptr && false_target != nullptr
+  //        - condition true => branch to true_target
+  //        - branch to false_target
+  if (IsBooleanValueOrMaterializedCondition(cond)) {
+    // The condition instruction has been materialized, compare the output to 0.
+    Location cond_val = instruction->GetLocations()->InAt(condition_input_index);
+    DCHECK(cond_val.IsRegister());
+    if (true_target == nullptr) {
+      __ Beqz(cond_val.AsRegister<XRegister>(), false_target);
+    } else {
+      __ Bnez(cond_val.AsRegister<XRegister>(), true_target);
+    }
+  } else {
+    // The condition instruction has not been materialized, use its inputs as
+    // the comparison and its condition as the branch condition.
+    HCondition* condition = cond->AsCondition();
+    DataType::Type type = condition->InputAt(0)->GetType();
+    LocationSummary* locations = condition->GetLocations();
+    IfCondition if_cond = condition->GetCondition();
+    Loongarch64Label* branch_target = true_target;
+
+    if (true_target == nullptr) {
+      if_cond = condition->GetOppositeCondition();
+      branch_target = false_target;
+    }
+
+    switch (type) {
+      default:
+        GenerateIntLongCompareAndBranch(if_cond, /* is_64bit= */ false, locations, branch_target);
+        break;
+      case DataType::Type::kInt64:
+        GenerateIntLongCompareAndBranch(if_cond, /* is_64bit= */ true, locations, branch_target);
+        break;
+      case DataType::Type::kFloat32:
+      case DataType::Type::kFloat64:
+        GenerateFpCompareAndBranch(if_cond, condition->IsGtBias(), type, locations, branch_target);
+        break;
+    }
+  }
+
+  // If neither branch falls through (case 3), the conditional branch to `true_target`
+  // was already emitted (case 2) and we need to emit a jump to `false_target`.
+  if (true_target != nullptr && false_target != nullptr) {
+    __ B(false_target);
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitIf(HIf* if_instr) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(if_instr);
+  if (IsBooleanValueOrMaterializedCondition(if_instr->InputAt(0))) {
+    locations->SetInAt(0, Location::RequiresRegister());
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitIf(HIf* if_instr) {
+  HBasicBlock* true_successor = if_instr->IfTrueSuccessor();
+  HBasicBlock* false_successor = if_instr->IfFalseSuccessor();
+  Loongarch64Label* true_target = codegen_->GoesToNextBlock(if_instr->GetBlock(), true_successor)
+      ? nullptr
+      : codegen_->GetLabelOf(true_successor);
+  Loongarch64Label* false_target = codegen_->GoesToNextBlock(if_instr->GetBlock(), false_successor)
+      ? nullptr
+      : codegen_->GetLabelOf(false_successor);
+  BranchCache* cache = codegen_->GetBranchCacheForProfiling(if_instr);
+  if (cache != nullptr) {
+    // Record which side of the branch is taken before jumping to it.
+    Loongarch64Label true_taken;
+    GenerateTestAndBranch(if_instr, /* condition_input_index= */ 0, &true_taken, nullptr);
+    GenerateBranchProfileUpdate(cache, /* taken= */ false);
+    if (false_target != nullptr) {
+      __ B(false_target);
+    }
+    __ Bind(&true_taken);
+    GenerateBranchProfileUpdate(cache, /* taken= */ true);
+    if (true_target != nullptr) {
+      __ B(true_target);
+    }
+    return;
+  }
+  GenerateTestAndBranch(if_instr, /* condition_input_index= */ 0, true_target, false_target);
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateBranchProfileUpdate(BranchCache* cache,
+                                                                      bool taken) {
+  MemberOffset offset = taken ? BranchCache::TrueOffset() : BranchCache::FalseOffset();
+  XRegister temp = TMP;
+  XRegister counter = TMP2;
+  // Load the counter sign-extended so that the saturated value becomes zero after the
+  // increment and the store can be skipped.
+  Loongarch64Label done;
+  __ LoadConst64(temp, reinterpret_cast64<uint64_t>(cache));
+  __ LdH(counter, temp, offset.Int32Value());
+  __ AddiW(counter, counter, 1);
+  __ Beqz(counter, &done);
+  __ StH(counter, temp, offset.Int32Value());
+  __ Bind(&done);
+}
+
+void LocationsBuilderLoongarch64::VisitDeoptimize(HDeoptimize* deoptimize) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator())
+      LocationSummary(deoptimize, LocationSummary::kCallOnSlowPath);
+  InvokeRuntimeCallingConvention calling_convention;
+  RegisterSet caller_saves = RegisterSet::Empty();
+  caller_saves.Add(Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+  locations->SetCustomSlowPathCallerSaves(caller_saves);
+  if (IsBooleanValueOrMaterializedCondition(deoptimize->InputAt(0))) {
+    locations->SetInAt(0, Location::RequiresRegister());
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitDeoptimize(HDeoptimize* deoptimize) {
+  SlowPathCodeLoongarch64* slow_path =
+      deopt_slow_paths_.NewSlowPath<DeoptimizationSlowPathLoongarch64>(deoptimize);
+  GenerateTestAndBranch(deoptimize,
+                        /* condition_input_index= */ 0,
+                        slow_path->GetEntryLabel(),
+                        /* false_target= */ nullptr);
+}
+
+void LocationsBuilderLoongarch64::VisitShouldDeoptimizeFlag(HShouldDeoptimizeFlag* flag) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator())
+      LocationSummary(flag, LocationSummary::kNoCall);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitShouldDeoptimizeFlag(HShouldDeoptimizeFlag* flag) {
+  __ LoadFromOffset(kLoadWord,
+                    flag->GetLocations()->Out().AsRegister<XRegister>(),
+                    SP,
+                    codegen_->GetStackOffsetOfShouldDeoptimizeFlag());
+}
+
+void InstructionCodeGeneratorLoongarch64::GenConditionalMove(HSelect* select) {
+  LocationSummary* locations = select->GetLocations();
+  HInstruction* cond = select->GetCondition();
+  XRegister cond_reg = TMP;
+  bool cond_inverted = false;
+  bool cond_in_fcc = false;
+
+  if (IsBooleanValueOrMaterializedCondition(cond)) {
+    cond_reg = locations->InAt(/* at= */ 2).AsRegister<XRegister>();
+  } else {
+    HCondition* condition = cond->AsCondition();
+    LocationSummary* cond_locations = cond->GetLocations();
+    IfCondition if_cond = condition->GetCondition();
+    DataType::Type cond_type = condition->InputAt(0)->GetType();
+    switch (cond_type) {
+      default:
+        cond_inverted = MaterializeIntLongCompare(if_cond,
+                                                  /* is_64bit= */ false,
+                                                  cond_locations,
+                                                  cond_reg);
+        break;
+      case DataType::Type::kInt64:
+        cond_inverted = MaterializeIntLongCompare(if_cond,
+                                                  /* is_64bit= */ true,
+                                                  cond_locations,
+                                                  cond_reg);
+        break;
+      case DataType::Type::kFloat32:
+      case DataType::Type::kFloat64:
+        cond_inverted = MaterializeFpCompare(if_cond,
+                                             condition->IsGtBias(),
+                                             cond_type,
+                                             cond_locations);
+        cond_in_fcc = true;
+        break;
+    }
+  }
+
+  if (DataType::IsFloatingPointType(select->GetType())) {
+    FRegister dst = locations->Out().AsFpuRegister<FRegister>();
+    FRegister false_reg = locations->InAt(0).AsFpuRegister<FRegister>();
+    FRegister true_reg = locations->InAt(1).AsFpuRegister<FRegister>();
+    if (!cond_in_fcc) {
+      // `movgr2cf` only transfers bit 0, so normalize any non-zero value to 1.
+      if (cond_reg == TMP) {
+        __ Sltu(TMP, Zero, TMP);
+      }
+      __ Movgr2cf(FCC0, cond_reg);
+    }
+    if (cond_inverted) {
+      std::swap(false_reg, true_reg);
+    }
+    __ Fsel(dst, false_reg, true_reg, FCC0);
+  } else {
+    if (cond_in_fcc) {
+      __ Movcf2gr(cond_reg, FCC0);
+    }
+    XRegister dst = locations->Out().AsRegister<XRegister>();
+    Location false_src = locations->InAt(0);
+    Location true_src = locations->InAt(1);
+    if (cond_inverted) {
+      std::swap(false_src, true_src);
+    }
+    // Here `true_src` is selected if `cond_reg` is non-zero, `false_src` otherwise.
+    if (true_src.IsConstant()) {
+      DCHECK(true_src.GetConstant()->IsZeroBitPattern());
+      XRegister false_reg = false_src.IsConstant() ? Zero : false_src.AsRegister<XRegister>();
+      __ Masknez(dst, false_reg, cond_reg);
+    } else if (false_src.IsConstant()) {
+      DCHECK(false_src.GetConstant()->IsZeroBitPattern());
+      __ Maskeqz(dst, true_src.AsRegister<XRegister>(), cond_reg);
+    } else {
+      __ Masknez(TMP2, false_src.AsRegister<XRegister>(), cond_reg);
+      __ Maskeqz(dst, true_src.AsRegister<XRegister>(), cond_reg);
+      __ Or(dst, dst, TMP2);
+    }
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitSelect(HSelect* select) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(select);
+  if (DataType::IsFloatingPointType(select->GetType())) {
+    locations->SetInAt(0, Location::RequiresFpuRegister());
+    locations->SetInAt(1, Location::RequiresFpuRegister());
+    locations->SetOut(Location::RequiresFpuRegister());
+  } else {
+    locations->SetInAt(0, RegisterOrZeroConstant(select->GetFalseValue()));
+    locations->SetInAt(1, RegisterOrZeroConstant(select->GetTrueValue()));
+    locations->SetOut(Location::RequiresRegister());
+  }
+  if (IsBooleanValueOrMaterializedCondition(select->GetCondition())) {
+    locations->SetInAt(2, Location::RequiresRegister());
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitSelect(HSelect* select) {
+  GenConditionalMove(select);
+}
+
+void LocationsBuilderLoongarch64::VisitNativeDebugInfo(HNativeDebugInfo* info) {
+  new (GetGraph()->GetAllocator()) LocationSummary(info);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitNativeDebugInfo(HNativeDebugInfo*) {
+  // MaybeRecordNativeDebugInfo is already called implicitly in CodeGenerator::Compile.
+}
+
+void LocationsBuilderLoongarch64::VisitMin(HMin* min) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(min);
+  switch (min->GetResultType()) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RequiresRegister());
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected type for HMin " << min->GetResultType();
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateMinMaxInt(LocationSummary* locations,
+                                                            bool is_min) {
+  XRegister lhs = locations->InAt(0).AsRegister<XRegister>();
+  XRegister rhs = locations->InAt(1).AsRegister<XRegister>();
+  XRegister out = locations->Out().AsRegister<XRegister>();
+
+  if (lhs == rhs) {
+    if (out != lhs) {
+      __ Move(out, lhs);
+    }
+    return;
+  }
+
+  // TMP = (lhs < rhs); select lhs for min (rhs for max) if set.
+  __ Slt(TMP, lhs, rhs);
+  if (is_min) {
+    __ Maskeqz(TMP2, lhs, TMP);
+    __ Masknez(out, rhs, TMP);
+  } else {
+    __ Maskeqz(TMP2, rhs, TMP);
+    __ Masknez(out, lhs, TMP);
+  }
+  __ Or(out, out, TMP2);
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateMinMaxFP(LocationSummary* locations,
+                                                           bool is_min,
+                                                           DataType::Type type) {
+  FRegister lhs = locations->InAt(0).AsFpuRegister<FRegister>();
+  FRegister rhs = locations->InAt(1).AsFpuRegister<FRegister>();
+  FRegister out = locations->Out().AsFpuRegister<FRegister>();
+
+  // `fmin`/`fmax` follow IEEE 754 minNum/maxNum which return the non-NaN operand and
+  // do not order -0.0 and +0.0. Java requires NaN propagation and -0.0 < +0.0, so
+  // handle unordered and equal operands separately.
+  Loongarch64Label nan, equal, done;
+  if (type == DataType::Type::kFloat32) {
+    __ FcmpS(kCUN, FCC0, lhs, rhs);
+    __ Bcnez(FCC0, &nan);
+    __ FcmpS(kCEQ, FCC0, lhs, rhs);
+    __ Bcnez(FCC0, &equal);
+    if (is_min) {
+      __ FminS(out, lhs, rhs);
+    } else {
+      __ FmaxS(out, lhs, rhs);
+    }
+    __ B(&done);
+
+    // Equal operands only differ in the sign of a zero: OR the sign bits for min,
+    // AND them for max.
+    __ Bind(&equal);
+    __ Movfr2grS(TMP, lhs);
+    __ Movfr2grS(TMP2, rhs);
+    if (is_min) {
+      __ Or(TMP, TMP, TMP2);
+    } else {
+      __ And(TMP, TMP, TMP2);
+    }
+    __ Movgr2frW(out, TMP);
+    __ B(&done);
+
+    __ Bind(&nan);
+    __ FaddS(out, lhs, rhs);  // Propagates the NaN.
+  } else {
+    DCHECK_EQ(type, DataType::Type::kFloat64);
+    __ FcmpD(kCUN, FCC0, lhs, rhs);
+    __ Bcnez(FCC0, &nan);
+    __ FcmpD(kCEQ, FCC0, lhs, rhs);
+    __ Bcnez(FCC0, &equal);
+    if (is_min) {
+      __ FminD(out, lhs, rhs);
+    } else {
+      __ FmaxD(out, lhs, rhs);
+    }
+    __ B(&done);
+
+    __ Bind(&equal);
+    __ Movfr2grD(TMP, lhs);
+    __ Movfr2grD(TMP2, rhs);
+    if (is_min) {
+      __ Or(TMP, TMP, TMP2);
+    } else {
+      __ And(TMP, TMP, TMP2);
+    }
+    __ Movgr2frD(out, TMP);
+    __ B(&done);
+
+    __ Bind(&nan);
+    __ FaddD(out, lhs, rhs);  // Propagates the NaN.
+  }
+  __ Bind(&done);
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateMinMax(HBinaryOperation* minmax, bool is_min) {
+  DataType::Type type = minmax->GetResultType();
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      GenerateMinMaxInt(minmax->GetLocations(), is_min);
+      break;
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      GenerateMinMaxFP(minmax->GetLocations(), is_min, type);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected type for HMinMax " << type;
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitMin(HMin* min) {
+  GenerateMinMax(min, /*is_min*/ true);
+}
+
+void LocationsBuilderLoongarch64::VisitMax(HMax* max) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(max);
+  switch (max->GetResultType()) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetInAt(1, Location::RequiresRegister());
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected type for HMax " << max->GetResultType();
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitMax(HMax* max) {
+  GenerateMinMax(max, /*is_min*/ false);
+}
+
+void LocationsBuilderLoongarch64::VisitAbs(HAbs* abs) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(abs);
+  switch (abs->GetResultType()) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected abs type " << abs->GetResultType();
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitAbs(HAbs* abs) {
+  LocationSummary* locations = abs->GetLocations();
+  switch (abs->GetResultType()) {
+    case DataType::Type::kInt32: {
+      XRegister in  = locations->InAt(0).AsRegister<XRegister>();
+      XRegister out = locations->Out().AsRegister<XRegister>();
+      __ SraiW(TMP, in, 31);
+      __ Xor(out, in, TMP);
+      __ SubW(out, out, TMP);
+      break;
+    }
+    case DataType::Type::kInt64: {
+      XRegister in  = locations->InAt(0).AsRegister<XRegister>();
+      XRegister out = locations->Out().AsRegister<XRegister>();
+      __ SraiD(TMP, in, 63);
+      __ Xor(out, in, TMP);
+      __ SubD(out, out, TMP);
+      break;
+    }
+    case DataType::Type::kFloat32: {
+      FRegister in = locations->InAt(0).AsFpuRegister<FRegister>();
+      FRegister out = locations->Out().AsFpuRegister<FRegister>();
+      __ FabsS(out, in);
+      break;
+    }
+    case DataType::Type::kFloat64: {
+      FRegister in = locations->InAt(0).AsFpuRegister<FRegister>();
+      FRegister out = locations->Out().AsFpuRegister<FRegister>();
+      __ FabsD(out, in);
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected abs type " << abs->GetResultType();
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitNeg(HNeg* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  DataType::Type type = instruction->GetType();
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+      break;
+
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+      break;
+
+    default:
+      LOG(FATAL) << "Unexpected neg type " << type;
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitNeg(HNeg* instruction) {
+  DataType::Type type = instruction->GetType();
+  LocationSummary* locations = instruction->GetLocations();
+
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64: {
+      XRegister dst = locations->Out().AsRegister<XRegister>();
+      XRegister src = locations->InAt(0).AsRegister<XRegister>();
+      if (type == DataType::Type::kInt32) {
+        __ SubW(dst, Zero, src);
+      } else {
+        __ SubD(dst, Zero, src);
+      }
+      break;
+    }
+    case DataType::Type::kFloat32:
+    case DataType::Type::kFloat64: {
+      FRegister dst = locations->Out().AsFpuRegister<FRegister>();
+      FRegister src = locations->InAt(0).AsFpuRegister<FRegister>();
+      if (type == DataType::Type::kFloat32) {
+        __ FnegS(dst, src);
+      } else {
+        __ FnegD(dst, src);
+      }
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unexpected neg type " << type;
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitNot(HNot* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitNot(HNot* instruction) {
+  DataType::Type type = instruction->GetType();
+  LocationSummary* locations = instruction->GetLocations();
+
+  switch (type) {
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64: {
+      XRegister dst = locations->Out().AsRegister<XRegister>();
+      XRegister src = locations->InAt(0).AsRegister<XRegister>();
+      __ Nor(dst, src, Zero);
+      break;
+    }
+
+    default:
+      LOG(FATAL) << "Unexpected type for not operation " << instruction->GetResultType();
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitBooleanNot(HBooleanNot* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitBooleanNot(HBooleanNot* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  __ Xori(locations->Out().AsRegister<XRegister>(), locations->InAt(0).AsRegister<XRegister>(), 1);
+}
+
+void LocationsBuilderLoongarch64::VisitTypeConversion(HTypeConversion* conversion) {
+  DataType::Type input_type = conversion->GetInputType();
+  DataType::Type result_type = conversion->GetResultType();
+  DCHECK(!DataType::IsTypeConversionImplicit(input_type, result_type))
+      << input_type << " -> " << result_type;
+
+  if ((input_type == DataType::Type::kReference) || (input_type == DataType::Type::kVoid) ||
+      (result_type == DataType::Type::kReference) || (result_type == DataType::Type::kVoid)) {
+    LOG(FATAL) << "Unexpected type conversion from " << input_type << " to " << result_type;
+  }
+
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(conversion);
+
+  if (DataType::IsFloatingPointType(input_type)) {
+    locations->SetInAt(0, Location::RequiresFpuRegister());
+  } else {
+    locations->SetInAt(0, Location::RequiresRegister());
+  }
+
+  if (DataType::IsFloatingPointType(result_type)) {
+    locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+  } else {
+    locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitTypeConversion(HTypeConversion* conversion) {
+  LocationSummary* locations = conversion->GetLocations();
+  DataType::Type result_type = conversion->GetResultType();
+  DataType::Type input_type = conversion->GetInputType();
+
+  DCHECK(!DataType::IsTypeConversionImplicit(input_type, result_type))
+      << input_type << " -> " << result_type;
+
+  if (DataType::IsIntegralType(result_type) && DataType::IsIntegralType(input_type)) {
+    XRegister dst = locations->Out().AsRegister<XRegister>();
+    XRegister src = locations->InAt(0).AsRegister<XRegister>();
+
+    switch (result_type) {
+      case DataType::Type::kUint8:
+        __ Andi(dst, src, 0xFF);
+        break;
+      case DataType::Type::kInt8:
+        __ ExtWB(dst, src);
+        break;
+      case DataType::Type::kUint16:
+        __ BstrpickD(dst, src, 15, 0);
+        break;
+      case DataType::Type::kInt16:
+        __ ExtWH(dst, src);
+        break;
+      case DataType::Type::kInt32:
+        // Sign-extend the low 32 bits of the long value.
+        __ AddiW(dst, src, 0);
+        break;
+      case DataType::Type::kInt64:
+        // Sign-extension of the 32-bit value is already done by every 32-bit operation.
+        if (dst != src) {
+          __ Move(dst, src);
+        }
+        break;
+      default:
+        LOG(FATAL) << "Unexpected type conversion from " << input_type
+                   << " to " << result_type;
+    }
+  } else if (DataType::IsFloatingPointType(result_type) && DataType::IsIntegralType(input_type)) {
+    FRegister dst = locations->Out().AsFpuRegister<FRegister>();
+    XRegister src = locations->InAt(0).AsRegister<XRegister>();
+    if (input_type == DataType::Type::kInt64) {
+      __ Movgr2frD(FTMP, src);
+      if (result_type == DataType::Type::kFloat32) {
+        __ FfintSL(dst, FTMP);
+      } else {
+        __ FfintDL(dst, FTMP);
+      }
+    } else {
+      __ Movgr2frW(FTMP, src);
+      if (result_type == DataType::Type::kFloat32) {
+        __ FfintSW(dst, FTMP);
+      } else {
+        __ FfintDW(dst, FTMP);
+      }
+    }
+  } else if (DataType::IsIntegralType(result_type) && DataType::IsFloatingPointType(input_type)) {
+    CHECK(result_type == DataType::Type::kInt32 || result_type == DataType::Type::kInt64);
+    XRegister dst = locations->Out().AsRegister<XRegister>();
+    FRegister src = locations->InAt(0).AsFpuRegister<FRegister>();
+    // The `ftintrz` instructions convert NaN to 0 and saturate out-of-range values,
+    // as required by Java.
+    if (result_type == DataType::Type::kInt64) {
+      if (input_type == DataType::Type::kFloat32) {
+        __ FtintrzLS(FTMP, src);
+      } else {
+        __ FtintrzLD(FTMP, src);
+      }
+      __ Movfr2grD(dst, FTMP);
+    } else {
+      if (input_type == DataType::Type::kFloat32) {
+        __ FtintrzWS(FTMP, src);
+      } else {
+        __ FtintrzWD(FTMP, src);
+      }
+      __ Movfr2grS(dst, FTMP);
+    }
+  } else if (DataType::IsFloatingPointType(result_type) &&
+             DataType::IsFloatingPointType(input_type)) {
+    FRegister dst = locations->Out().AsFpuRegister<FRegister>();
+    FRegister src = locations->InAt(0).AsFpuRegister<FRegister>();
+    if (result_type == DataType::Type::kFloat32) {
+      __ FcvtSD(dst, src);
+    } else {
+      __ FcvtDS(dst, src);
+    }
+  } else {
+    LOG(FATAL) << "Unexpected or unimplemented type conversion from " << input_type
+               << " to " << result_type;
+  }
+}
+
+static LoadOperandType GetLoadOperandType(DataType::Type type) {
+  switch (type) {
+    case DataType::Type::kBool:
+    case DataType::Type::kUint8:
+      return kLoadUnsignedByte;
+    case DataType::Type::kInt8:
+      return kLoadSignedByte;
+    case DataType::Type::kUint16:
+      return kLoadUnsignedHalfword;
+    case DataType::Type::kInt16:
+      return kLoadSignedHalfword;
+    case DataType::Type::kInt32:
+    case DataType::Type::kFloat32:
+      return kLoadWord;
+    case DataType::Type::kReference:
+      return kLoadUnsignedWord;
+    case DataType::Type::kInt64:
+    case DataType::Type::kFloat64:
+      return kLoadDoubleword;
+    default:
+      LOG(FATAL) << "Unreachable type " << type;
+      UNREACHABLE();
+  }
+}
+
+static StoreOperandType GetStoreOperandType(DataType::Type type) {
+  switch (type) {
+    case DataType::Type::kBool:
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+      return kStoreByte;
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+      return kStoreHalfword;
+    case DataType::Type::kInt32:
+    case DataType::Type::kFloat32:
+    case DataType::Type::kReference:
+      return kStoreWord;
+    case DataType::Type::kInt64:
+    case DataType::Type::kFloat64:
+      return kStoreDoubleword;
+    default:
+      LOG(FATAL) << "Unreachable type " << type;
+      UNREACHABLE();
+  }
+}
+
+Location LocationsBuilderLoongarch64::RegisterOrZeroConstant(HInstruction* instruction) {
+  return (instruction->IsConstant() && instruction->AsConstant()->IsZeroBitPattern())
+      ? Location::ConstantLocation(instruction->AsConstant())
+      : Location::RequiresRegister();
+}
+
+Location LocationsBuilderLoongarch64::FpuRegisterOrConstantForStore(HInstruction* instruction) {
+  // We can store the bit pattern of a floating-point constant from a core register.
+  return instruction->IsConstant()
+      ? Location::ConstantLocation(instruction->AsConstant())
+      : Location::RequiresFpuRegister();
+}
+
+void LocationsBuilderLoongarch64::HandleFieldGet(HInstruction* instruction,
+                                                 const FieldInfo& field_info ATTRIBUTE_UNUSED) {
+  DCHECK(instruction->IsInstanceFieldGet() ||
+         instruction->IsStaticFieldGet() ||
+         instruction->IsPredicatedInstanceFieldGet());
+
+  bool is_predicated = instruction->IsPredicatedInstanceFieldGet();
+
+  bool object_field_get_with_read_barrier =
+      kEmitCompilerReadBarrier && (instruction->GetType() == DataType::Type::kReference);
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(instruction,
+                                                       object_field_get_with_read_barrier
+                                                           ? LocationSummary::kCallOnSlowPath
+                                                           : LocationSummary::kNoCall);
+  if (object_field_get_with_read_barrier && kUseBakerReadBarrier) {
+    locations->SetCustomSlowPathCallerSaves(RegisterSet::Empty());  // No caller-save registers.
+    // We need a temporary register holding the marking entrypoint in
+    // CodeGeneratorLoongarch64::GenerateFieldLoadWithBakerReadBarrier().
+    locations->AddTemp(Location::RequiresRegister());
+  }
+  // Input for object receiver.
+  locations->SetInAt(is_predicated ? 1 : 0, Location::RequiresRegister());
+  if (DataType::IsFloatingPointType(instruction->GetType())) {
+    if (is_predicated) {
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetOut(Location::SameAsFirstInput());
+    } else {
+      locations->SetOut(Location::RequiresFpuRegister());
+    }
+  } else {
+    if (is_predicated) {
+      locations->SetInAt(0, Location::RequiresRegister());
+      locations->SetOut(Location::SameAsFirstInput());
+    } else {
+      // The output overlaps for an object field get when read barriers
+      // are enabled: we do not want the load to overwrite the object's
+      // location, as we need it to emit the read barrier.
+      locations->SetOut(Location::RequiresRegister(),
+                        object_field_get_with_read_barrier ? Location::kOutputOverlap
+                                                           : Location::kNoOutputOverlap);
+    }
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::HandleFieldGet(HInstruction* instruction,
+                                                         const FieldInfo& field_info) {
+  DCHECK(instruction->IsInstanceFieldGet() ||
+         instruction->IsStaticFieldGet() ||
+         instruction->IsPredicatedInstanceFieldGet());
+  bool is_predicated = instruction->IsPredicatedInstanceFieldGet();
+  DataType::Type type = instruction->GetType();
+  DCHECK_EQ(DataType::Size(field_info.GetFieldType()), DataType::Size(type));
+  LocationSummary* locations = instruction->GetLocations();
+  Location obj_loc = locations->InAt(is_predicated ? 1 : 0);
+  XRegister obj = obj_loc.AsRegister<XRegister>();
+  Location dst_loc = locations->Out();
+  uint32_t offset = field_info.GetFieldOffset().Uint32Value();
+
+  if (type == DataType::Type::kReference && kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
+    // /* HeapReference<Object> */ dst = *(obj + offset)
+    Location temp_loc = locations->GetTemp(0);
+    // Note that a potential implicit null check is handled in this
+    // CodeGeneratorLoongarch64::GenerateFieldLoadWithBakerReadBarrier call.
+    codegen_->GenerateFieldLoadWithBakerReadBarrier(instruction,
+                                                    dst_loc,
+                                                    obj,
+                                                    offset,
+                                                    temp_loc,
+                                                    /* needs_null_check= */ true);
+  } else {
+    LoadOperandType load_type = GetLoadOperandType(type);
+    if (DataType::IsFloatingPointType(type)) {
+      __ LoadFpuFromOffset(load_type, dst_loc.AsFpuRegister<FRegister>(), obj, offset);
+    } else {
+      __ LoadFromOffset(load_type, dst_loc.AsRegister<XRegister>(), obj, offset);
+    }
+    codegen_->MaybeRecordImplicitNullCheck(instruction);
+    if (type == DataType::Type::kReference) {
+      // If read barriers are enabled, emit read barriers other than
+      // Baker's using a slow path (and also unpoison the loaded
+      // reference, if heap poisoning is enabled).
+      codegen_->MaybeGenerateReadBarrierSlow(instruction, dst_loc, dst_loc, obj_loc, offset);
+    }
+  }
+
+  if (field_info.IsVolatile()) {
+    GenerateMemoryBarrier(MemBarrierKind::kLoadAny);
+  }
+}
+
+void LocationsBuilderLoongarch64::HandleFieldSet(HInstruction* instruction,
+                                                 const FieldInfo& field_info ATTRIBUTE_UNUSED) {
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (DataType::IsFloatingPointType(instruction->InputAt(1)->GetType())) {
+    locations->SetInAt(1, FpuRegisterOrConstantForStore(instruction->InputAt(1)));
+  } else {
+    locations->SetInAt(1, RegisterOrZeroConstant(instruction->InputAt(1)));
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::HandleFieldSet(HInstruction* instruction,
+                                                         const FieldInfo& field_info,
+                                                         bool value_can_be_null) {
+  DCHECK(instruction->IsInstanceFieldSet() || instruction->IsStaticFieldSet());
+  bool is_predicated =
+      instruction->IsInstanceFieldSet() && instruction->AsInstanceFieldSet()->GetIsPredicatedSet();
+  DataType::Type type = field_info.GetFieldType();
+  LocationSummary* locations = instruction->GetLocations();
+  XRegister obj = locations->InAt(0).AsRegister<XRegister>();
+  Location value_location = locations->InAt(1);
+  StoreOperandType store_type = GetStoreOperandType(type);
+  bool is_volatile = field_info.IsVolatile();
+  uint32_t offset = field_info.GetFieldOffset().Uint32Value();
+  WriteBarrierKind write_barrier_kind = CodeGenerator::GetWriteBarrierKind(instruction);
+  bool needs_write_barrier =
+      CodeGenerator::StoreNeedsWriteBarrier(type, instruction->InputAt(1), write_barrier_kind);
+
+  Loongarch64Label pred_is_null;
+  if (is_predicated) {
+    __ Beqz(obj, &pred_is_null);
+  }
+
+  if (is_volatile) {
+    GenerateMemoryBarrier(MemBarrierKind::kAnyStore);
+  }
+
+  if (value_location.IsConstant()) {
+    int64_t value = CodeGenerator::GetInt64ValueOf(value_location.GetConstant());
+    XRegister src = Zero;
+    if (value != 0) {
+      src = TMP2;
+      __ LoadConst64(src, value);
+    }
+    __ StoreToOffset(store_type, src, obj, offset);
+  } else if (DataType::IsFloatingPointType(type)) {
+    __ StoreFpuToOffset(store_type, value_location.AsFpuRegister<FRegister>(), obj, offset);
+  } else {
+    XRegister src = value_location.AsRegister<XRegister>();
+    if (kPoisonHeapReferences && type == DataType::Type::kReference) {
+      __ Move(TMP2, src);
+      __ PoisonHeapReference(TMP2);
+      src = TMP2;
+    }
+    __ StoreToOffset(store_type, src, obj, offset);
+  }
+  codegen_->MaybeRecordImplicitNullCheck(instruction);
+
+  if (is_volatile) {
+    GenerateMemoryBarrier(MemBarrierKind::kAnyAny);
+  }
+
+  if (needs_write_barrier) {
+    DCHECK(value_location.IsRegister());
+    codegen_->MarkGCCard(
+        obj,
+        value_location.AsRegister<XRegister>(),
+        value_can_be_null && write_barrier_kind == WriteBarrierKind::kEmitWithNullCheck);
+  }
+
+  if (is_predicated) {
+    __ Bind(&pred_is_null);
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldInfo());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldInfo());
+}
+
+void LocationsBuilderLoongarch64::VisitPredicatedInstanceFieldGet(
+    HPredicatedInstanceFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldInfo());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitPredicatedInstanceFieldGet(
+    HPredicatedInstanceFieldGet* instruction) {
+  Loongarch64Label finish;
+  __ Beqz(instruction->GetLocations()->InAt(1).AsRegister<XRegister>(), &finish);
+  HandleFieldGet(instruction, instruction->GetFieldInfo());
+  __ Bind(&finish);
+}
+
+void LocationsBuilderLoongarch64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldInfo());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInstanceFieldSet(HInstanceFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldInfo(), instruction->GetValueCanBeNull());
+}
+
+void LocationsBuilderLoongarch64::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldInfo());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitStaticFieldGet(HStaticFieldGet* instruction) {
+  HandleFieldGet(instruction, instruction->GetFieldInfo());
+}
+
+void LocationsBuilderLoongarch64::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldInfo());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitStaticFieldSet(HStaticFieldSet* instruction) {
+  HandleFieldSet(instruction, instruction->GetFieldInfo(), instruction->GetValueCanBeNull());
+}
+
+void LocationsBuilderLoongarch64::VisitUnresolvedInstanceFieldGet(
+    HUnresolvedInstanceFieldGet* instruction) {
+  FieldAccessCallingConventionLoongarch64 calling_convention;
+  codegen_->CreateUnresolvedFieldLocationSummary(
+      instruction, instruction->GetFieldType(), calling_convention);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitUnresolvedInstanceFieldGet(
+    HUnresolvedInstanceFieldGet* instruction) {
+  FieldAccessCallingConventionLoongarch64 calling_convention;
+  codegen_->GenerateUnresolvedFieldAccess(instruction,
+                                          instruction->GetFieldType(),
+                                          instruction->GetFieldIndex(),
+                                          instruction->GetDexPc(),
+                                          calling_convention);
+}
+
+void LocationsBuilderLoongarch64::VisitUnresolvedInstanceFieldSet(
+    HUnresolvedInstanceFieldSet* instruction) {
+  FieldAccessCallingConventionLoongarch64 calling_convention;
+  codegen_->CreateUnresolvedFieldLocationSummary(
+      instruction, instruction->GetFieldType(), calling_convention);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitUnresolvedInstanceFieldSet(
+    HUnresolvedInstanceFieldSet* instruction) {
+  FieldAccessCallingConventionLoongarch64 calling_convention;
+  codegen_->GenerateUnresolvedFieldAccess(instruction,
+                                          instruction->GetFieldType(),
+                                          instruction->GetFieldIndex(),
+                                          instruction->GetDexPc(),
+                                          calling_convention);
+}
+
+void LocationsBuilderLoongarch64::VisitUnresolvedStaticFieldGet(
+    HUnresolvedStaticFieldGet* instruction) {
+  FieldAccessCallingConventionLoongarch64 calling_convention;
+  codegen_->CreateUnresolvedFieldLocationSummary(
+      instruction, instruction->GetFieldType(), calling_convention);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitUnresolvedStaticFieldGet(
+    HUnresolvedStaticFieldGet* instruction) {
+  FieldAccessCallingConventionLoongarch64 calling_convention;
+  codegen_->GenerateUnresolvedFieldAccess(instruction,
+                                          instruction->GetFieldType(),
+                                          instruction->GetFieldIndex(),
+                                          instruction->GetDexPc(),
+                                          calling_convention);
+}
+
+void LocationsBuilderLoongarch64::VisitUnresolvedStaticFieldSet(
+    HUnresolvedStaticFieldSet* instruction) {
+  FieldAccessCallingConventionLoongarch64 calling_convention;
+  codegen_->CreateUnresolvedFieldLocationSummary(
+      instruction, instruction->GetFieldType(), calling_convention);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitUnresolvedStaticFieldSet(
+    HUnresolvedStaticFieldSet* instruction) {
+  FieldAccessCallingConventionLoongarch64 calling_convention;
+  codegen_->GenerateUnresolvedFieldAccess(instruction,
+                                          instruction->GetFieldType(),
+                                          instruction->GetFieldIndex(),
+                                          instruction->GetDexPc(),
+                                          calling_convention);
+}
+
+void LocationsBuilderLoongarch64::VisitArrayGet(HArrayGet* instruction) {
+  DataType::Type type = instruction->GetType();
+  bool object_array_get_with_read_barrier =
+      kEmitCompilerReadBarrier && (type == DataType::Type::kReference);
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(instruction,
+                                                       object_array_get_with_read_barrier
+                                                           ? LocationSummary::kCallOnSlowPath
+                                                           : LocationSummary::kNoCall);
+  if (object_array_get_with_read_barrier && kUseBakerReadBarrier) {
+    locations->SetCustomSlowPathCallerSaves(RegisterSet::Empty());  // No caller-save registers.
+    // We need a temporary register holding the marking entrypoint in
+    // CodeGeneratorLoongarch64::GenerateArrayLoadWithBakerReadBarrier().
+    locations->AddTemp(Location::RequiresRegister());
+  }
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RegisterOrConstant(instruction->InputAt(1)));
+  if (DataType::IsFloatingPointType(type)) {
+    locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+  } else {
+    // The output overlaps in the case of an object array get with
+    // read barriers enabled: we do not want the move to overwrite the
+    // array's location, as we need it to emit the read barrier.
+    locations->SetOut(Location::RequiresRegister(),
+                      object_array_get_with_read_barrier ? Location::kOutputOverlap
+                                                         : Location::kNoOutputOverlap);
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitArrayGet(HArrayGet* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Location obj_loc = locations->InAt(0);
+  XRegister obj = obj_loc.AsRegister<XRegister>();
+  Location out_loc = locations->Out();
+  Location index = locations->InAt(1);
+  uint32_t data_offset = CodeGenerator::GetArrayDataOffset(instruction);
+  DataType::Type type = instruction->GetType();
+  const bool maybe_compressed_char_at =
+      mirror::kUseStringCompression && instruction->IsStringCharAt();
+
+  if (type == DataType::Type::kReference && kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
+    // /* HeapReference<Object> */ out =
+    //     *(obj + data_offset + index * sizeof(HeapReference<Object>))
+    // Note that a potential implicit null check is handled in the
+    // CodeGeneratorLoongarch64::GenerateArrayLoadWithBakerReadBarrier call.
+    codegen_->GenerateArrayLoadWithBakerReadBarrier(instruction,
+                                                    out_loc,
+                                                    obj,
+                                                    data_offset,
+                                                    index,
+                                                    locations->GetTemp(0),
+                                                    /* needs_null_check= */ true);
+  } else if (maybe_compressed_char_at) {
+    XRegister out = out_loc.AsRegister<XRegister>();
+    uint32_t count_offset = mirror::String::CountOffset().Uint32Value();
+    __ LoadFromOffset(kLoadWord, TMP, obj, count_offset);
+    codegen_->MaybeRecordImplicitNullCheck(instruction);
+    __ Andi(TMP, TMP, 1);
+    static_assert(static_cast<uint32_t>(mirror::StringCompressionFlag::kCompressed) == 0u,
+                  "Expecting 0=compressed, 1=uncompressed");
+    Loongarch64Label uncompressed_load, done;
+    __ Bnez(TMP, &uncompressed_load);
+    if (index.IsConstant()) {
+      int32_t const_index = index.GetConstant()->AsIntConstant()->GetValue();
+      __ LoadFromOffset(kLoadUnsignedByte, out, obj, data_offset + const_index);
+      __ B(&done);
+      __ Bind(&uncompressed_load);
+      __ LoadFromOffset(kLoadUnsignedHalfword, out, obj, data_offset + (const_index << 1));
+    } else {
+      XRegister index_reg = index.AsRegister<XRegister>();
+      __ AddD(TMP2, obj, index_reg);
+      __ LoadFromOffset(kLoadUnsignedByte, out, TMP2, data_offset);
+      __ B(&done);
+      __ Bind(&uncompressed_load);
+      __ AlslD(TMP2, index_reg, obj, 1);
+      __ LoadFromOffset(kLoadUnsignedHalfword, out, TMP2, data_offset);
+    }
+    __ Bind(&done);
+  } else {
+    LoadOperandType load_type = GetLoadOperandType(type);
+    size_t shift = DataType::SizeShift(type);
+    XRegister base = obj;
+    uint32_t offset = data_offset;
+    if (index.IsConstant()) {
+      offset += index.GetConstant()->AsIntConstant()->GetValue() << shift;
+    } else {
+      XRegister index_reg = index.AsRegister<XRegister>();
+      if (shift == 0u) {
+        __ AddD(TMP2, obj, index_reg);
+      } else {
+        __ AlslD(TMP2, index_reg, obj, shift);
+      }
+      base = TMP2;
+    }
+    if (DataType::IsFloatingPointType(type)) {
+      __ LoadFpuFromOffset(load_type, out_loc.AsFpuRegister<FRegister>(), base, offset);
+    } else {
+      __ LoadFromOffset(load_type, out_loc.AsRegister<XRegister>(), base, offset);
+    }
+    codegen_->MaybeRecordImplicitNullCheck(instruction);
+
+    if (type == DataType::Type::kReference) {
+      static_assert(
+          sizeof(mirror::HeapReference<mirror::Object>) == sizeof(int32_t),
+          "art::mirror::HeapReference<art::mirror::Object> and int32_t have different sizes.");
+      if (index.IsConstant()) {
+        codegen_->MaybeGenerateReadBarrierSlow(instruction, out_loc, out_loc, obj_loc, offset);
+      } else {
+        codegen_->MaybeGenerateReadBarrierSlow(
+            instruction, out_loc, out_loc, obj_loc, data_offset, index);
+      }
+    }
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitArrayLength(HArrayLength* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kNoOutputOverlap);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitArrayLength(HArrayLength* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  uint32_t offset = CodeGenerator::GetArrayLengthOffset(instruction);
+  XRegister obj = locations->InAt(0).AsRegister<XRegister>();
+  XRegister out = locations->Out().AsRegister<XRegister>();
+  __ LoadFromOffset(kLoadWord, out, obj, offset);
+  codegen_->MaybeRecordImplicitNullCheck(instruction);
+  // Mask out compression flag from String's array length.
+  if (mirror::kUseStringCompression && instruction->IsStringLength()) {
+    __ SrliW(out, out, 1u);
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitArraySet(HArraySet* instruction) {
+  DataType::Type value_type = instruction->GetComponentType();
+
+  bool needs_type_check = instruction->NeedsTypeCheck();
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+      instruction,
+      needs_type_check ? LocationSummary::kCallOnSlowPath : LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RegisterOrConstant(instruction->InputAt(1)));
+  if (DataType::IsFloatingPointType(instruction->InputAt(2)->GetType())) {
+    locations->SetInAt(2, FpuRegisterOrConstantForStore(instruction->InputAt(2)));
+  } else {
+    locations->SetInAt(2, RegisterOrZeroConstant(instruction->InputAt(2)));
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitArraySet(HArraySet* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  XRegister array = locations->InAt(0).AsRegister<XRegister>();
+  Location index = locations->InAt(1);
+  Location value_location = locations->InAt(2);
+  DataType::Type value_type = instruction->GetComponentType();
+  bool needs_type_check = instruction->NeedsTypeCheck();
+  bool needs_write_barrier =
+      CodeGenerator::StoreNeedsWriteBarrier(value_type, instruction->GetValue());
+  bool can_value_be_null = instruction->GetValueCanBeNull();
+  uint32_t data_offset = mirror::Array::DataOffset(DataType::Size(value_type)).Uint32Value();
+  size_t shift = DataType::SizeShift(value_type);
+  SlowPathCodeLoongarch64* slow_path = nullptr;
+
+  if (needs_write_barrier) {
+    DCHECK_EQ(value_type, DataType::Type::kReference);
+    DCHECK(value_location.IsRegister());
+    XRegister value = value_location.AsRegister<XRegister>();
+
+    Loongarch64Label do_store;
+    if (can_value_be_null) {
+      __ Beqz(value, &do_store);
+    }
+
+    if (needs_type_check) {
+      slow_path = new (codegen_->GetScopedAllocator()) ArraySetSlowPathLoongarch64(instruction);
+      codegen_->AddSlowPath(slow_path);
+
+      uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+      uint32_t super_offset = mirror::Class::SuperClassOffset().Int32Value();
+      uint32_t component_offset = mirror::Class::ComponentTypeOffset().Int32Value();
+
+      // Note that when read barriers are enabled, the type checks
+      // are performed without read barriers.  This is fine, even in
+      // the case where a class object is in the from-space after
+      // the flip, as a comparison involving such a type would not
+      // produce a false positive; it may of course produce a false
+      // negative, in which case we would take the ArraySet slow
+      // path.
+
+      // /* HeapReference<Class> */ TMP = array->klass_
+      __ LoadFromOffset(kLoadUnsignedWord, TMP, array, class_offset);
+      codegen_->MaybeRecordImplicitNullCheck(instruction);
+      __ MaybeUnpoisonHeapReference(TMP);
+
+      // /* HeapReference<Class> */ TMP = TMP->component_type_
+      __ LoadFromOffset(kLoadUnsignedWord, TMP, TMP, component_offset);
+      // /* HeapReference<Class> */ TMP2 = value->klass_
+      __ LoadFromOffset(kLoadUnsignedWord, TMP2, value, class_offset);
+      // If heap poisoning is enabled, no need to unpoison `TMP`
+      // nor `TMP2`, as we are comparing two poisoned references.
+
+      if (instruction->StaticTypeOfArrayIsObjectArray()) {
+        Loongarch64Label do_put;
+        __ Beq(TMP, TMP2, &do_put);
+        // If heap poisoning is enabled, the `TMP` reference has
+        // not been unpoisoned yet; unpoison it now.
+        __ MaybeUnpoisonHeapReference(TMP);
+
+        // /* HeapReference<Class> */ TMP = TMP->super_class_
+        __ LoadFromOffset(kLoadUnsignedWord, TMP, TMP, super_offset);
+        // If heap poisoning is enabled, no need to unpoison
+        // `TMP`, as we are comparing against null below.
+        __ Bnez(TMP, slow_path->GetEntryLabel());
+        __ Bind(&do_put);
+      } else {
+        __ Bne(TMP, TMP2, slow_path->GetEntryLabel());
+      }
+    }
+
+    codegen_->MarkGCCard(array, value, /* value_can_be_null= */ false);
+
+    if (can_value_be_null) {
+      __ Bind(&do_store);
+    }
+  }
+
+  // Compute the address. A register index is folded into TMP; the remaining
+  // offset is then small, so the store below does not need TMP itself.
+  XRegister base = array;
+  uint32_t offset = data_offset;
+  if (index.IsConstant()) {
+    offset += index.GetConstant()->AsIntConstant()->GetValue() << shift;
+  } else {
+    XRegister index_reg = index.AsRegister<XRegister>();
+    if (shift == 0u) {
+      __ AddD(TMP, array, index_reg);
+    } else {
+      __ AlslD(TMP, index_reg, array, shift);
+    }
+    base = TMP;
+  }
+
+  StoreOperandType store_type = GetStoreOperandType(value_type);
+  if (value_location.IsConstant()) {
+    int64_t value = CodeGenerator::GetInt64ValueOf(value_location.GetConstant());
+    XRegister src = Zero;
+    if (value != 0) {
+      src = TMP2;
+      __ LoadConst64(src, value);
+    }
+    __ StoreToOffset(store_type, src, base, offset);
+  } else if (DataType::IsFloatingPointType(value_type)) {
+    __ StoreFpuToOffset(store_type, value_location.AsFpuRegister<FRegister>(), base, offset);
+  } else {
+    XRegister src = value_location.AsRegister<XRegister>();
+    if (kPoisonHeapReferences && value_type == DataType::Type::kReference) {
+      __ Move(TMP2, src);
+      __ PoisonHeapReference(TMP2);
+      src = TMP2;
+    }
+    __ StoreToOffset(store_type, src, base, offset);
+  }
+  if (!needs_type_check || can_value_be_null) {
+    codegen_->MaybeRecordImplicitNullCheck(instruction);
+  }
+
+  if (slow_path != nullptr) {
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitBoundsCheck(HBoundsCheck* instruction) {
+  RegisterSet caller_saves = RegisterSet::Empty();
+  InvokeRuntimeCallingConvention calling_convention;
+  caller_saves.Add(Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+  caller_saves.Add(Location::RegisterLocation(calling_convention.GetRegisterAt(1)));
+  LocationSummary* locations = codegen_->CreateThrowingSlowPathLocations(instruction, caller_saves);
+
+  HInstruction* index = instruction->InputAt(0);
+  HInstruction* length = instruction->InputAt(1);
+  locations->SetInAt(0, Location::RegisterOrConstant(index));
+  locations->SetInAt(1, Location::RegisterOrConstant(length));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitBoundsCheck(HBoundsCheck* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  BoundsCheckSlowPathLoongarch64* slow_path =
+      new (codegen_->GetScopedAllocator()) BoundsCheckSlowPathLoongarch64(instruction);
+  codegen_->AddSlowPath(slow_path);
+
+  Location index_loc = locations->InAt(0);
+  Location length_loc = locations->InAt(1);
+
+  // Both values are sign-extended 32-bit integers, so a single unsigned
+  // comparison also catches negative indexes.
+  if (length_loc.IsConstant()) {
+    int32_t length = length_loc.GetConstant()->AsIntConstant()->GetValue();
+    if (index_loc.IsConstant()) {
+      int32_t index = index_loc.GetConstant()->AsIntConstant()->GetValue();
+      if (index < 0 || index >= length) {
+        __ B(slow_path->GetEntryLabel());
+      } else {
+        // Nothing to be done.
+      }
+      return;
+    }
+    __ LoadConst64(TMP, length);
+    __ Bgeu(index_loc.AsRegister<XRegister>(), TMP, slow_path->GetEntryLabel());
+  } else {
+    XRegister length = length_loc.AsRegister<XRegister>();
+    if (index_loc.IsConstant()) {
+      int32_t index = index_loc.GetConstant()->AsIntConstant()->GetValue();
+      if (index == 0) {
+        __ Beqz(length, slow_path->GetEntryLabel());
+      } else {
+        __ LoadConst64(TMP, index);
+        __ Bgeu(TMP, length, slow_path->GetEntryLabel());
+      }
+    } else {
+      __ Bgeu(index_loc.AsRegister<XRegister>(), length, slow_path->GetEntryLabel());
+    }
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitNullCheck(HNullCheck* instruction) {
+  LocationSummary* locations = codegen_->CreateThrowingSlowPathLocations(instruction);
+  locations->SetInAt(0, Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitNullCheck(HNullCheck* instruction) {
+  codegen_->GenerateNullCheck(instruction);
+}
+
+void LocationsBuilderLoongarch64::VisitIntermediateAddress(
+    HIntermediateAddress* instruction ATTRIBUTE_UNUSED) {
+  LOG(FATAL) << "Unreachable";
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitIntermediateAddress(
+    HIntermediateAddress* instruction ATTRIBUTE_UNUSED) {
+  LOG(FATAL) << "Unreachable";
+}
+
+void LocationsBuilderLoongarch64::VisitIntConstant(HIntConstant* constant) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(constant);
+  locations->SetOut(Location::ConstantLocation(constant));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitIntConstant(
+    HIntConstant* constant ATTRIBUTE_UNUSED) {
+  // Will be generated at use site.
+}
+
+void LocationsBuilderLoongarch64::VisitLongConstant(HLongConstant* constant) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(constant);
+  locations->SetOut(Location::ConstantLocation(constant));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitLongConstant(
+    HLongConstant* constant ATTRIBUTE_UNUSED) {
+  // Will be generated at use site.
+}
+
+void LocationsBuilderLoongarch64::VisitFloatConstant(HFloatConstant* constant) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(constant);
+  locations->SetOut(Location::ConstantLocation(constant));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitFloatConstant(
+    HFloatConstant* constant ATTRIBUTE_UNUSED) {
+  // Will be generated at use site.
+}
+
+void LocationsBuilderLoongarch64::VisitDoubleConstant(HDoubleConstant* constant) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(constant);
+  locations->SetOut(Location::ConstantLocation(constant));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitDoubleConstant(
+    HDoubleConstant* constant ATTRIBUTE_UNUSED) {
+  // Will be generated at use site.
+}
+
+void LocationsBuilderLoongarch64::VisitNullConstant(HNullConstant* constant) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(constant);
+  locations->SetOut(Location::ConstantLocation(constant));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitNullConstant(
+    HNullConstant* constant ATTRIBUTE_UNUSED) {
+  // Will be generated at use site.
+}
+
+void LocationsBuilderLoongarch64::VisitParameterValue(HParameterValue* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  Location location = parameter_visitor_.GetNextLocation(instruction->GetType());
+  if (location.IsStackSlot()) {
+    location = Location::StackSlot(location.GetStackIndex() + codegen_->GetFrameSize());
+  } else if (location.IsDoubleStackSlot()) {
+    location = Location::DoubleStackSlot(location.GetStackIndex() + codegen_->GetFrameSize());
+  }
+  locations->SetOut(location);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitParameterValue(
+    HParameterValue* instruction ATTRIBUTE_UNUSED) {
+  // Nothing to do, the parameter is already at its location.
+}
+
+void LocationsBuilderLoongarch64::VisitCurrentMethod(HCurrentMethod* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetOut(Location::RegisterLocation(kMethodRegisterArgument));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitCurrentMethod(
+    HCurrentMethod* instruction ATTRIBUTE_UNUSED) {
+  // Nothing to do, the method is already at its location.
+}
+
+void LocationsBuilderLoongarch64::VisitPhi(HPhi* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  for (size_t i = 0, e = locations->GetInputCount(); i < e; ++i) {
+    locations->SetInAt(i, Location::Any());
+  }
+  locations->SetOut(Location::Any());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitPhi(HPhi* instruction ATTRIBUTE_UNUSED) {
+  LOG(FATAL) << "Unreachable";
+}
+
+void LocationsBuilderLoongarch64::VisitParallelMove(HParallelMove* instruction ATTRIBUTE_UNUSED) {
+  LOG(FATAL) << "Unreachable";
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitParallelMove(HParallelMove* instruction) {
+  if (instruction->GetNext()->IsSuspendCheck() &&
+      instruction->GetBlock()->GetLoopInformation() != nullptr) {
+    HSuspendCheck* suspend_check = instruction->GetNext()->AsSuspendCheck();
+    // The back edge will generate the suspend check.
+    codegen_->ClearSpillSlotsFromLoopPhisInStackMap(suspend_check, instruction);
+  }
+
+  codegen_->GetMoveResolver()->EmitNativeCode(instruction);
+}
+
+void LocationsBuilderLoongarch64::VisitReturn(HReturn* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  DataType::Type return_type = instruction->InputAt(0)->GetType();
+  locations->SetInAt(0, Loongarch64ReturnLocation(return_type));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitReturn(HReturn* ret) {
+  if (GetGraph()->IsCompilingOsr()) {
+    // To simplify callers of an OSR method, we put the return value in both
+    // floating point and core register.
+    switch (ret->InputAt(0)->GetType()) {
+      case DataType::Type::kFloat32:
+        __ Movfr2grS(A0, FA0);
+        break;
+      case DataType::Type::kFloat64:
+        __ Movfr2grD(A0, FA0);
+        break;
+      default:
+        break;
+    }
+  }
+  codegen_->GenerateFrameExit();
+}
+
+void LocationsBuilderLoongarch64::VisitReturnVoid(HReturnVoid* instruction) {
+  instruction->SetLocations(nullptr);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitReturnVoid(
+    HReturnVoid* instruction ATTRIBUTE_UNUSED) {
+  codegen_->GenerateFrameExit();
+}
+
+void LocationsBuilderLoongarch64::VisitMemoryBarrier(HMemoryBarrier* memory_barrier) {
+  memory_barrier->SetLocations(nullptr);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitMemoryBarrier(HMemoryBarrier* memory_barrier) {
+  GenerateMemoryBarrier(memory_barrier->GetBarrierKind());
+}
+
+void LocationsBuilderLoongarch64::VisitConstructorFence(HConstructorFence* constructor_fence) {
+  constructor_fence->SetLocations(nullptr);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitConstructorFence(
+    HConstructorFence* constructor_fence ATTRIBUTE_UNUSED) {
+  GenerateMemoryBarrier(MemBarrierKind::kStoreStore);
+}
+
+void LocationsBuilderLoongarch64::VisitBoundType(HBoundType* instruction ATTRIBUTE_UNUSED) {
+  // Nothing to do, this should be removed during prepare for register allocator.
+  LOG(FATAL) << "Unreachable";
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitBoundType(
+    HBoundType* instruction ATTRIBUTE_UNUSED) {
+  // Nothing to do, this should be removed during prepare for register allocator.
+  LOG(FATAL) << "Unreachable";
+}
+
+static int32_t GetExceptionTlsOffset() {
+  return Thread::ExceptionOffset<kLoongarch64PointerSize>().Int32Value();
+}
+
+void LocationsBuilderLoongarch64::VisitLoadException(HLoadException* load) {
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(load, LocationSummary::kNoCall);
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitLoadException(HLoadException* load) {
+  XRegister out = load->GetLocations()->Out().AsRegister<XRegister>();
+  __ LoadFromOffset(kLoadUnsignedWord, out, TR, GetExceptionTlsOffset());
+}
+
+void LocationsBuilderLoongarch64::VisitClearException(HClearException* clear) {
+  new (GetGraph()->GetAllocator()) LocationSummary(clear, LocationSummary::kNoCall);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitClearException(
+    HClearException* clear ATTRIBUTE_UNUSED) {
+  __ StoreToOffset(kStoreWord, Zero, TR, GetExceptionTlsOffset());
+}
+
+void LocationsBuilderLoongarch64::VisitThrow(HThrow* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+      instruction, LocationSummary::kCallOnMainOnly);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitThrow(HThrow* instruction) {
+  codegen_->InvokeRuntime(kQuickDeliverException, instruction, instruction->GetDexPc());
+  CheckEntrypointTypes<kQuickDeliverException, void, mirror::Object*>();
+}
+
+void LocationsBuilderLoongarch64::VisitClassTableGet(HClassTableGet* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitClassTableGet(HClassTableGet* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  XRegister in = locations->InAt(0).AsRegister<XRegister>();
+  XRegister out = locations->Out().AsRegister<XRegister>();
+  if (instruction->GetTableKind() == HClassTableGet::TableKind::kVTable) {
+    uint32_t method_offset = mirror::Class::EmbeddedVTableEntryOffset(
+        instruction->GetIndex(), kLoongarch64PointerSize).SizeValue();
+    __ LoadFromOffset(kLoadDoubleword, out, in, method_offset);
+  } else {
+    uint32_t method_offset = static_cast<uint32_t>(ImTable::OffsetOfElement(
+        instruction->GetIndex(), kLoongarch64PointerSize));
+    __ LoadFromOffset(kLoadDoubleword,
+                      out,
+                      in,
+                      mirror::Class::ImtPtrOffset(kLoongarch64PointerSize).Uint32Value());
+    __ LoadFromOffset(kLoadDoubleword, out, out, method_offset);
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitStringBuilderAppend(HStringBuilderAppend* instruction) {
+  codegen_->CreateStringBuilderAppendLocations(instruction, Location::RegisterLocation(A0));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitStringBuilderAppend(
+    HStringBuilderAppend* instruction) {
+  __ LoadConst32(A0, instruction->GetFormat()->GetValue());
+  codegen_->InvokeRuntime(kQuickStringBuilderAppend, instruction, instruction->GetDexPc());
+}
+
+void LocationsBuilderLoongarch64::VisitSuspendCheck(HSuspendCheck* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+      instruction, LocationSummary::kCallOnSlowPath);
+  // In suspend check slow path, usually there are no caller-save registers at all.
+  // If SIMD instructions are present, however, we force spilling all live SIMD
+  // registers in full width (since the runtime only saves/restores lower part).
+  locations->SetCustomSlowPathCallerSaves(
+      GetGraph()->HasSIMD() ? RegisterSet::AllFpu() : RegisterSet::Empty());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitSuspendCheck(HSuspendCheck* instruction) {
+  HBasicBlock* block = instruction->GetBlock();
+  if (block->GetLoopInformation() != nullptr) {
+    DCHECK(block->GetLoopInformation()->GetSuspendCheck() == instruction);
+    // The back edge will generate the suspend check.
+    return;
+  }
+  if (block->IsEntryBlock() && instruction->GetNext()->IsGoto()) {
+    // The goto will generate the suspend check.
+    return;
+  }
+  GenerateSuspendCheck(instruction, nullptr);
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateReferenceLoadOneRegister(
+    HInstruction* instruction,
+    Location out,
+    uint32_t offset,
+    Location maybe_temp,
+    ReadBarrierOption read_barrier_option) {
+  XRegister out_reg = out.AsRegister<XRegister>();
+  if (read_barrier_option == kWithReadBarrier) {
+    CHECK(kEmitCompilerReadBarrier);
+    if (kUseBakerReadBarrier) {
+      // Load with fast path based Baker's read barrier.
+      // /* HeapReference<Object> */ out = *(out + offset)
+      codegen_->GenerateFieldLoadWithBakerReadBarrier(instruction,
+                                                      out,
+                                                      out_reg,
+                                                      offset,
+                                                      maybe_temp,
+                                                      /* needs_null_check= */ false);
+    } else {
+      // Load with slow path based read barrier.
+      // Save the value of `out` into `maybe_temp` before overwriting it
+      // in the following move operation, as we will need it for the
+      // read barrier below.
+      __ Move(maybe_temp.AsRegister<XRegister>(), out_reg);
+      // /* HeapReference<Object> */ out = *(out + offset)
+      __ LoadFromOffset(kLoadUnsignedWord, out_reg, out_reg, offset);
+      codegen_->GenerateReadBarrierSlow(instruction, out, out, maybe_temp, offset);
+    }
+  } else {
+    // Plain load with no read barrier.
+    // /* HeapReference<Object> */ out = *(out + offset)
+    __ LoadFromOffset(kLoadUnsignedWord, out_reg, out_reg, offset);
+    __ MaybeUnpoisonHeapReference(out_reg);
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateReferenceLoadTwoRegisters(
+    HInstruction* instruction,
+    Location out,
+    Location obj,
+    uint32_t offset,
+    Location maybe_temp,
+    ReadBarrierOption read_barrier_option) {
+  XRegister out_reg = out.AsRegister<XRegister>();
+  XRegister obj_reg = obj.AsRegister<XRegister>();
+  if (read_barrier_option == kWithReadBarrier) {
+    CHECK(kEmitCompilerReadBarrier);
+    if (kUseBakerReadBarrier) {
+      // Load with fast path based Baker's read barrier.
+      // /* HeapReference<Object> */ out = *(obj + offset)
+      codegen_->GenerateFieldLoadWithBakerReadBarrier(instruction,
+                                                      out,
+                                                      obj_reg,
+                                                      offset,
+                                                      maybe_temp,
+                                                      /* needs_null_check= */ false);
+    } else {
+      // Load with slow path based read barrier.
+      // /* HeapReference<Object> */ out = *(obj + offset)
+      __ LoadFromOffset(kLoadUnsignedWord, out_reg, obj_reg, offset);
+      codegen_->GenerateReadBarrierSlow(instruction, out, out, obj, offset);
+    }
+  } else {
+    // Plain load with no read barrier.
+    // /* HeapReference<Object> */ out = *(obj + offset)
+    __ LoadFromOffset(kLoadUnsignedWord, out_reg, obj_reg, offset);
+    __ MaybeUnpoisonHeapReference(out_reg);
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateClassInitializationCheck(
+    SlowPathCodeLoongarch64* slow_path, XRegister class_reg) {
+  constexpr size_t status_lsb_position = SubtypeCheckBits::BitStructSizeOf();
+  const size_t status_byte_offset =
+      mirror::Class::StatusOffset().SizeValue() + (status_lsb_position / kBitsPerByte);
+  constexpr uint32_t shifted_visibly_initialized_value =
+      enum_cast<uint32_t>(ClassStatus::kVisiblyInitialized) << (status_lsb_position % kBitsPerByte);
+
+  // Load only the high byte of the status word; the shifted value fits in the
+  // immediate of `sltui`.
+  static_assert(IsUint<11>(shifted_visibly_initialized_value), "Unexpected status value");
+  __ LoadFromOffset(kLoadUnsignedByte, TMP, class_reg, status_byte_offset);
+  __ Sltui(TMP, TMP, shifted_visibly_initialized_value);
+  __ Bnez(TMP, slow_path->GetEntryLabel());
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void InstructionCodeGeneratorLoongarch64::GenerateBitstringTypeCheckCompare(
+    HTypeCheckInstruction* check, XRegister temp) {
+  uint32_t path_to_root = check->GetBitstringPathToRoot();
+  uint32_t mask = check->GetBitstringMask();
+  DCHECK(IsPowerOfTwo(mask + 1));
+  size_t mask_bits = WhichPowerOf2(mask + 1);
+
+  if (mask_bits == 16u) {
+    // Load only the bitstring part of the status word.
+    __ LoadFromOffset(
+        kLoadUnsignedHalfword, temp, temp, mirror::Class::StatusOffset().Int32Value());
+  } else {
+    // /* uint32_t */ temp = temp->status_
+    __ LoadFromOffset(kLoadWord, temp, temp, mirror::Class::StatusOffset().Int32Value());
+    // Extract the bitstring bits.
+    __ BstrpickD(temp, temp, mask_bits - 1, 0);
+  }
+  // Compare the bitstring bits to `path_to_root`; `temp` is zero if they match.
+  __ LoadConst32(TMP, path_to_root);
+  __ Xor(temp, temp, TMP);
+}
+
+void LocationsBuilderLoongarch64::VisitClinitCheck(HClinitCheck* check) {
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(check, LocationSummary::kCallOnSlowPath);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (check->HasUses()) {
+    locations->SetOut(Location::SameAsFirstInput());
+  }
+  // Rely on the type initialization to save everything we need.
+  locations->SetCustomSlowPathCallerSaves(OneRegInReferenceOutSaveEverythingCallerSaves());
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitClinitCheck(HClinitCheck* check) {
+  // We assume the class is not null.
+  SlowPathCodeLoongarch64* slow_path = new (codegen_->GetScopedAllocator())
+      LoadClassSlowPathLoongarch64(check->GetLoadClass(), check);
+  codegen_->AddSlowPath(slow_path);
+  GenerateClassInitializationCheck(slow_path,
+                                   check->GetLocations()->InAt(0).AsRegister<XRegister>());
+}
+
+// Temp is used for read barrier.
+static size_t NumberOfInstanceOfTemps(TypeCheckKind type_check_kind) {
+  if (kEmitCompilerReadBarrier &&
+      (kUseBakerReadBarrier ||
+          type_check_kind == TypeCheckKind::kAbstractClassCheck ||
+          type_check_kind == TypeCheckKind::kClassHierarchyCheck ||
+          type_check_kind == TypeCheckKind::kArrayObjectCheck)) {
+    return 1;
+  }
+  return 0;
+}
+
+// Interface case has 3 temps, one for holding the number of interfaces, one for the current
+// interface pointer, one for loading the current interface.
+// The other checks have one temp for loading the object's class.
+static size_t NumberOfCheckCastTemps(TypeCheckKind type_check_kind) {
+  if (type_check_kind == TypeCheckKind::kInterfaceCheck) {
+    return 3;
+  }
+  return 1 + NumberOfInstanceOfTemps(type_check_kind);
+}
+
+void LocationsBuilderLoongarch64::VisitInstanceOf(HInstanceOf* instruction) {
+  LocationSummary::CallKind call_kind = LocationSummary::kNoCall;
+  TypeCheckKind type_check_kind = instruction->GetTypeCheckKind();
+  bool baker_read_barrier_slow_path = false;
+  switch (type_check_kind) {
+    case TypeCheckKind::kExactCheck:
+    case TypeCheckKind::kAbstractClassCheck:
+    case TypeCheckKind::kClassHierarchyCheck:
+    case TypeCheckKind::kArrayObjectCheck: {
+      bool needs_read_barrier = CodeGenerator::InstanceOfNeedsReadBarrier(instruction);
+      call_kind = needs_read_barrier ? LocationSummary::kCallOnSlowPath : LocationSummary::kNoCall;
+      baker_read_barrier_slow_path = kUseBakerReadBarrier && needs_read_barrier;
+      break;
+    }
+    case TypeCheckKind::kArrayCheck:
+    case TypeCheckKind::kUnresolvedCheck:
+    case TypeCheckKind::kInterfaceCheck:
+      call_kind = LocationSummary::kCallOnSlowPath;
+      break;
+    case TypeCheckKind::kBitstringCheck:
+      break;
+  }
+
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(instruction, call_kind);
+  if (baker_read_barrier_slow_path) {
+    locations->SetCustomSlowPathCallerSaves(RegisterSet::Empty());  // No caller-save registers.
+  }
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (type_check_kind == TypeCheckKind::kBitstringCheck) {
+    locations->SetInAt(1, Location::ConstantLocation(instruction->InputAt(1)->AsConstant()));
+    locations->SetInAt(2, Location::ConstantLocation(instruction->InputAt(2)->AsConstant()));
+    locations->SetInAt(3, Location::ConstantLocation(instruction->InputAt(3)->AsConstant()));
+  } else {
+    locations->SetInAt(1, Location::RequiresRegister());
+  }
+  // The output does overlap inputs.
+  // Note that TypeCheckSlowPathLoongarch64 uses this register too.
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+  locations->AddRegisterTemps(NumberOfInstanceOfTemps(type_check_kind));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInstanceOf(HInstanceOf* instruction) {
+  TypeCheckKind type_check_kind = instruction->GetTypeCheckKind();
+  LocationSummary* locations = instruction->GetLocations();
+  Location obj_loc = locations->InAt(0);
+  XRegister obj = obj_loc.AsRegister<XRegister>();
+  Location cls = locations->InAt(1);
+  Location out_loc = locations->Out();
+  XRegister out = out_loc.AsRegister<XRegister>();
+  const size_t num_temps = NumberOfInstanceOfTemps(type_check_kind);
+  DCHECK_LE(num_temps, 1u);
+  Location maybe_temp_loc = (num_temps >= 1) ? locations->GetTemp(0) : Location::NoLocation();
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  uint32_t super_offset = mirror::Class::SuperClassOffset().Int32Value();
+  uint32_t component_offset = mirror::Class::ComponentTypeOffset().Int32Value();
+  uint32_t primitive_offset = mirror::Class::PrimitiveTypeOffset().Int32Value();
+  Loongarch64Label done;
+  SlowPathCodeLoongarch64* slow_path = nullptr;
+
+  // Return 0 if `obj` is null.
+  // Avoid this check if we know `obj` is not null.
+  if (instruction->MustDoNullCheck()) {
+    __ Move(out, Zero);
+    __ Beqz(obj, &done);
+  }
+
+  switch (type_check_kind) {
+    case TypeCheckKind::kExactCheck: {
+      ReadBarrierOption read_barrier_option =
+          CodeGenerator::ReadBarrierOptionForInstanceOf(instruction);
+      // /* HeapReference<Class> */ out = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        out_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp_loc,
+                                        read_barrier_option);
+      // Classes must be equal for the instanceof to succeed.
+      __ Xor(out, out, cls.AsRegister<XRegister>());
+      __ Sltui(out, out, 1);
+      break;
+    }
+
+    case TypeCheckKind::kAbstractClassCheck: {
+      ReadBarrierOption read_barrier_option =
+          CodeGenerator::ReadBarrierOptionForInstanceOf(instruction);
+      // /* HeapReference<Class> */ out = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        out_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp_loc,
+                                        read_barrier_option);
+      // If the class is abstract, we eagerly fetch the super class of the
+      // object to avoid doing a comparison we know will fail.
+      Loongarch64Label loop;
+      __ Bind(&loop);
+      // /* HeapReference<Class> */ out = out->super_class_
+      GenerateReferenceLoadOneRegister(instruction,
+                                       out_loc,
+                                       super_offset,
+                                       maybe_temp_loc,
+                                       read_barrier_option);
+      // If `out` is null, we use it for the result, and jump to `done`.
+      __ Beqz(out, &done);
+      __ Bne(out, cls.AsRegister<XRegister>(), &loop);
+      __ LoadConst32(out, 1);
+      break;
+    }
+
+    case TypeCheckKind::kClassHierarchyCheck: {
+      ReadBarrierOption read_barrier_option =
+          CodeGenerator::ReadBarrierOptionForInstanceOf(instruction);
+      // /* HeapReference<Class> */ out = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        out_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp_loc,
+                                        read_barrier_option);
+      // Walk over the class hierarchy to find a match.
+      Loongarch64Label loop, success;
+      __ Bind(&loop);
+      __ Beq(out, cls.AsRegister<XRegister>(), &success);
+      // /* HeapReference<Class> */ out = out->super_class_
+      GenerateReferenceLoadOneRegister(instruction,
+                                       out_loc,
+                                       super_offset,
+                                       maybe_temp_loc,
+                                       read_barrier_option);
+      __ Bnez(out, &loop);
+      // If `out` is null, we use it for the result, and jump to `done`.
+      __ B(&done);
+      __ Bind(&success);
+      __ LoadConst32(out, 1);
+      break;
+    }
+
+    case TypeCheckKind::kArrayObjectCheck: {
+      ReadBarrierOption read_barrier_option =
+          CodeGenerator::ReadBarrierOptionForInstanceOf(instruction);
+      // /* HeapReference<Class> */ out = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        out_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp_loc,
+                                        read_barrier_option);
+      // Do an exact check.
+      Loongarch64Label success;
+      __ Beq(out, cls.AsRegister<XRegister>(), &success);
+      // Otherwise, we need to check that the object's class is a non-primitive array.
+      // /* HeapReference<Class> */ out = out->component_type_
+      GenerateReferenceLoadOneRegister(instruction,
+                                       out_loc,
+                                       component_offset,
+                                       maybe_temp_loc,
+                                       read_barrier_option);
+      // If `out` is null, we use it for the result, and jump to `done`.
+      __ Beqz(out, &done);
+      __ LoadFromOffset(kLoadUnsignedHalfword, out, out, primitive_offset);
+      static_assert(Primitive::kPrimNot == 0, "Expected 0 for kPrimNot");
+      __ Sltui(out, out, 1);
+      __ B(&done);
+      __ Bind(&success);
+      __ LoadConst32(out, 1);
+      break;
+    }
+
+    case TypeCheckKind::kArrayCheck: {
+      // No read barrier since the slow path will retry upon failure.
+      // /* HeapReference<Class> */ out = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        out_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp_loc,
+                                        kWithoutReadBarrier);
+      DCHECK(locations->OnlyCallsOnSlowPath());
+      slow_path = new (codegen_->GetScopedAllocator())
+          TypeCheckSlowPathLoongarch64(instruction, /* is_fatal= */ false);
+      codegen_->AddSlowPath(slow_path);
+      __ Bne(out, cls.AsRegister<XRegister>(), slow_path->GetEntryLabel());
+      __ LoadConst32(out, 1);
+      break;
+    }
+
+    case TypeCheckKind::kUnresolvedCheck:
+    case TypeCheckKind::kInterfaceCheck: {
+      // Note that we indeed only call on slow path, but we always go
+      // into the slow path for the unresolved and interface check
+      // cases.
+      //
+      // We cannot directly call the InstanceofNonTrivial runtime
+      // entry point without resorting to a type checking slow path
+      // here (i.e. by calling InvokeRuntime directly), as it would
+      // require to assign fixed registers for the inputs of this
+      // HInstanceOf instruction (following the runtime calling
+      // convention), which might be cluttered by the potential first
+      // read barrier emission at the beginning of this method.
+      DCHECK(locations->OnlyCallsOnSlowPath());
+      slow_path = new (codegen_->GetScopedAllocator())
+          TypeCheckSlowPathLoongarch64(instruction, /* is_fatal= */ false);
+      codegen_->AddSlowPath(slow_path);
+      __ B(slow_path->GetEntryLabel());
+      break;
+    }
+
+    case TypeCheckKind::kBitstringCheck: {
+      // /* HeapReference<Class> */ temp = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        out_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp_loc,
+                                        kWithoutReadBarrier);
+
+      GenerateBitstringTypeCheckCompare(instruction, out);
+      __ Sltui(out, out, 1);
+      break;
+    }
+  }
+
+  __ Bind(&done);
+
+  if (slow_path != nullptr) {
+    __ Bind(slow_path->GetExitLabel());
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitCheckCast(HCheckCast* instruction) {
+  TypeCheckKind type_check_kind = instruction->GetTypeCheckKind();
+  LocationSummary::CallKind call_kind = CodeGenerator::GetCheckCastCallKind(instruction);
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(instruction, call_kind);
+  locations->SetInAt(0, Location::RequiresRegister());
+  if (type_check_kind == TypeCheckKind::kBitstringCheck) {
+    locations->SetInAt(1, Location::ConstantLocation(instruction->InputAt(1)->AsConstant()));
+    locations->SetInAt(2, Location::ConstantLocation(instruction->InputAt(2)->AsConstant()));
+    locations->SetInAt(3, Location::ConstantLocation(instruction->InputAt(3)->AsConstant()));
+  } else {
+    locations->SetInAt(1, Location::RequiresRegister());
+  }
+  locations->AddRegisterTemps(NumberOfCheckCastTemps(type_check_kind));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitCheckCast(HCheckCast* instruction) {
+  TypeCheckKind type_check_kind = instruction->GetTypeCheckKind();
+  LocationSummary* locations = instruction->GetLocations();
+  Location obj_loc = locations->InAt(0);
+  XRegister obj = obj_loc.AsRegister<XRegister>();
+  Location cls = locations->InAt(1);
+  Location temp_loc = locations->GetTemp(0);
+  XRegister temp = temp_loc.AsRegister<XRegister>();
+  const size_t num_temps = NumberOfCheckCastTemps(type_check_kind);
+  DCHECK_GE(num_temps, 1u);
+  DCHECK_LE(num_temps, 3u);
+  Location maybe_temp2_loc = (num_temps >= 2) ? locations->GetTemp(1) : Location::NoLocation();
+  Location maybe_temp3_loc = (num_temps >= 3) ? locations->GetTemp(2) : Location::NoLocation();
+  const uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  const uint32_t super_offset = mirror::Class::SuperClassOffset().Int32Value();
+  const uint32_t component_offset = mirror::Class::ComponentTypeOffset().Int32Value();
+  const uint32_t primitive_offset = mirror::Class::PrimitiveTypeOffset().Int32Value();
+  const uint32_t iftable_offset = mirror::Class::IfTableOffset().Uint32Value();
+  const uint32_t array_length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t object_array_data_offset =
+      mirror::Array::DataOffset(kHeapReferenceSize).Uint32Value();
+  Loongarch64Label done;
+
+  bool is_type_check_slow_path_fatal = CodeGenerator::IsTypeCheckSlowPathFatal(instruction);
+  SlowPathCodeLoongarch64* slow_path =
+      new (codegen_->GetScopedAllocator()) TypeCheckSlowPathLoongarch64(
+          instruction, is_type_check_slow_path_fatal);
+  codegen_->AddSlowPath(slow_path);
+
+  // Avoid this check if we know `obj` is not null.
+  if (instruction->MustDoNullCheck()) {
+    __ Beqz(obj, &done);
+  }
+
+  switch (type_check_kind) {
+    case TypeCheckKind::kExactCheck:
+    case TypeCheckKind::kArrayCheck: {
+      // /* HeapReference<Class> */ temp = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        temp_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp2_loc,
+                                        kWithoutReadBarrier);
+      // Jump to slow path for throwing the exception or doing a
+      // more involved array check.
+      __ Bne(temp, cls.AsRegister<XRegister>(), slow_path->GetEntryLabel());
+      break;
+    }
+
+    case TypeCheckKind::kAbstractClassCheck: {
+      // /* HeapReference<Class> */ temp = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        temp_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp2_loc,
+                                        kWithoutReadBarrier);
+      // If the class is abstract, we eagerly fetch the super class of the
+      // object to avoid doing a comparison we know will fail.
+      Loongarch64Label loop;
+      __ Bind(&loop);
+      // /* HeapReference<Class> */ temp = temp->super_class_
+      GenerateReferenceLoadOneRegister(instruction,
+                                       temp_loc,
+                                       super_offset,
+                                       maybe_temp2_loc,
+                                       kWithoutReadBarrier);
+      // If the class reference currently in `temp` is null, jump to the slow path to throw the
+      // exception.
+      __ Beqz(temp, slow_path->GetEntryLabel());
+      // Otherwise, compare the classes.
+      __ Bne(temp, cls.AsRegister<XRegister>(), &loop);
+      break;
+    }
+
+    case TypeCheckKind::kClassHierarchyCheck: {
+      // /* HeapReference<Class> */ temp = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        temp_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp2_loc,
+                                        kWithoutReadBarrier);
+      // Walk over the class hierarchy to find a match.
+      Loongarch64Label loop;
+      __ Bind(&loop);
+      __ Beq(temp, cls.AsRegister<XRegister>(), &done);
+      // /* HeapReference<Class> */ temp = temp->super_class_
+      GenerateReferenceLoadOneRegister(instruction,
+                                       temp_loc,
+                                       super_offset,
+                                       maybe_temp2_loc,
+                                       kWithoutReadBarrier);
+      // If the class reference currently in `temp` is null, jump to the slow path to throw the
+      // exception. Otherwise, jump to the beginning of the loop.
+      __ Bnez(temp, &loop);
+      __ B(slow_path->GetEntryLabel());
+      break;
+    }
+
+    case TypeCheckKind::kArrayObjectCheck: {
+      // /* HeapReference<Class> */ temp = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        temp_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp2_loc,
+                                        kWithoutReadBarrier);
+      // Do an exact check.
+      __ Beq(temp, cls.AsRegister<XRegister>(), &done);
+      // Otherwise, we need to check that the object's class is a non-primitive array.
+      // /* HeapReference<Class> */ temp = temp->component_type_
+      GenerateReferenceLoadOneRegister(instruction,
+                                       temp_loc,
+                                       component_offset,
+                                       maybe_temp2_loc,
+                                       kWithoutReadBarrier);
+      // If the component type is null, jump to the slow path to throw the exception.
+      __ Beqz(temp, slow_path->GetEntryLabel());
+      // Otherwise, the object is indeed an array, further check that this component
+      // type is not a primitive type.
+      __ LoadFromOffset(kLoadUnsignedHalfword, temp, temp, primitive_offset);
+      static_assert(Primitive::kPrimNot == 0, "Expected 0 for kPrimNot");
+      __ Bnez(temp, slow_path->GetEntryLabel());
+      break;
+    }
+
+    case TypeCheckKind::kUnresolvedCheck:
+      // We always go into the type check slow path for the unresolved check case.
+      // We cannot directly call the CheckCast runtime entry point
+      // without resorting to a type checking slow path here (i.e. by
+      // calling InvokeRuntime directly), as it would require to
+      // assign fixed registers for the inputs of this HInstanceOf
+      // instruction (following the runtime calling convention), which
+      // might be cluttered by the potential first read barrier
+      // emission at the beginning of this method.
+      __ B(slow_path->GetEntryLabel());
+      break;
+
+    case TypeCheckKind::kInterfaceCheck: {
+      // Avoid read barriers to improve performance of the fast path. We can not get false
+      // positives by doing this.
+      // /* HeapReference<Class> */ temp = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        temp_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp2_loc,
+                                        kWithoutReadBarrier);
+      // /* HeapReference<Class> */ temp = temp->iftable_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        temp_loc,
+                                        temp_loc,
+                                        iftable_offset,
+                                        maybe_temp2_loc,
+                                        kWithoutReadBarrier);
+      XRegister temp2 = maybe_temp2_loc.AsRegister<XRegister>();
+      XRegister temp3 = maybe_temp3_loc.AsRegister<XRegister>();
+      // Iftable is never null.
+      __ LoadFromOffset(kLoadWord, temp2, temp, array_length_offset);
+      // Loop through the iftable and check if any class matches.
+      Loongarch64Label loop;
+      __ Bind(&loop);
+      __ Beqz(temp2, slow_path->GetEntryLabel());
+      __ LoadFromOffset(kLoadUnsignedWord, temp3, temp, object_array_data_offset);
+      __ MaybeUnpoisonHeapReference(temp3);
+      // Go to next interface.
+      __ AddiD(temp, temp, 2 * kHeapReferenceSize);
+      __ AddiW(temp2, temp2, -2);
+      // Compare the classes and continue the loop if they do not match.
+      __ Bne(temp3, cls.AsRegister<XRegister>(), &loop);
+      break;
+    }
+
+    case TypeCheckKind::kBitstringCheck: {
+      // /* HeapReference<Class> */ temp = obj->klass_
+      GenerateReferenceLoadTwoRegisters(instruction,
+                                        temp_loc,
+                                        obj_loc,
+                                        class_offset,
+                                        maybe_temp2_loc,
+                                        kWithoutReadBarrier);
+
+      GenerateBitstringTypeCheckCompare(instruction, temp);
+      __ Bnez(temp, slow_path->GetEntryLabel());
+      break;
+    }
+  }
+
+  __ Bind(&done);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void LocationsBuilderLoongarch64::HandleInvoke(HInvoke* invoke) {
+  InvokeDexCallingConventionVisitorLoongarch64 calling_convention_visitor;
+  CodeGenerator::CreateCommonInvokeLocationSummary(invoke, &calling_convention_visitor);
+}
+
+void LocationsBuilderLoongarch64::VisitInvokeUnresolved(HInvokeUnresolved* invoke) {
+  // The trampoline uses the same calling convention as dex calling conventions,
+  // except instead of loading A0 with the target Method*, A0 will contain
+  // the method_idx.
+  HandleInvoke(invoke);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInvokeUnresolved(HInvokeUnresolved* invoke) {
+  codegen_->GenerateInvokeUnresolvedRuntimeCall(invoke);
+}
+
+void LocationsBuilderLoongarch64::VisitInvokeInterface(HInvokeInterface* invoke) {
+  HandleInvoke(invoke);
+  if (invoke->GetHiddenArgumentLoadKind() == MethodLoadKind::kRecursive) {
+    // We cannot request T8 as it's blocked by the register allocator.
+    invoke->GetLocations()->SetInAt(invoke->GetNumberOfArguments() - 1, Location::Any());
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInvokeInterface(HInvokeInterface* invoke) {
+  // TODO: b/18116999, our IMTs can miss an IncompatibleClassChangeError.
+  LocationSummary* locations = invoke->GetLocations();
+  XRegister temp = locations->GetTemp(0).AsRegister<XRegister>();
+  Location receiver = locations->InAt(0);
+  uint32_t class_offset = mirror::Object::ClassOffset().Int32Value();
+  Offset entry_point = ArtMethod::EntryPointFromQuickCompiledCodeOffset(kLoongarch64PointerSize);
+
+  // /* HeapReference<Class> */ temp = receiver->klass_
+  if (receiver.IsStackSlot()) {
+    __ LoadFromOffset(kLoadUnsignedWord, temp, SP, receiver.GetStackIndex());
+    __ LoadFromOffset(kLoadUnsignedWord, temp, temp, class_offset);
+  } else {
+    __ LoadFromOffset(kLoadUnsignedWord, temp, receiver.AsRegister<XRegister>(), class_offset);
+  }
+  codegen_->MaybeRecordImplicitNullCheck(invoke);
+  // Instead of simply (possibly) unpoisoning `temp` here, we should
+  // emit a read barrier for the previous class reference load.
+  // However this is not required in practice, as this is an
+  // intermediate/temporary reference and because the current
+  // concurrent copying collector keeps the from-space memory
+  // intact/accessible until the end of the marking phase (the
+  // concurrent copying collector may not in the future).
+  __ MaybeUnpoisonHeapReference(temp);
+
+  // If we're compiling baseline, update the inline cache.
+  codegen_->MaybeGenerateInlineCacheCheck(invoke, temp);
+
+  // The hidden argument is passed to art_quick_imt_conflict_trampoline in T8 (TMP2).
+  // It is loaded after the inline cache check, which clobbers TMP2.
+  if (invoke->GetHiddenArgumentLoadKind() == MethodLoadKind::kRecursive) {
+    Location interface_method = locations->InAt(invoke->GetNumberOfArguments() - 1);
+    if (interface_method.IsStackSlot()) {
+      __ LoadFromOffset(kLoadDoubleword, TMP2, SP, interface_method.GetStackIndex());
+    } else {
+      __ Move(TMP2, interface_method.AsRegister<XRegister>());
+    }
+  // If the load kind is through a runtime call, we will pass the method we
+  // fetch the IMT, which will either be a no-op if we don't hit the conflict
+  // stub, or will make us always go through the trampoline when there is a
+  // conflict.
+  } else if (invoke->GetHiddenArgumentLoadKind() != MethodLoadKind::kRuntimeCall) {
+    codegen_->LoadMethod(
+        invoke->GetHiddenArgumentLoadKind(), Location::RegisterLocation(TMP2), invoke);
+  }
+
+  __ LoadFromOffset(kLoadDoubleword,
+                    temp,
+                    temp,
+                    mirror::Class::ImtPtrOffset(kLoongarch64PointerSize).Uint32Value());
+  uint32_t method_offset = static_cast<uint32_t>(ImTable::OffsetOfElement(
+      invoke->GetImtIndex(), kLoongarch64PointerSize));
+  // temp = temp->GetImtEntryAt(method_offset);
+  __ LoadFromOffset(kLoadDoubleword, temp, temp, method_offset);
+  if (invoke->GetHiddenArgumentLoadKind() == MethodLoadKind::kRuntimeCall) {
+    // We pass the method from the IMT in case of a conflict. This will ensure
+    // we go into the runtime to resolve the actual method.
+    __ Move(TMP2, temp);
+  }
+  // RA = temp->GetEntryPoint();
+  __ LoadFromOffset(kLoadDoubleword, RA, temp, entry_point.Int32Value());
+  // RA();
+  __ Jalr(RA);
+  DCHECK(!codegen_->IsLeafMethod());
+  codegen_->RecordPcInfo(invoke, invoke->GetDexPc());
+}
+
+void LocationsBuilderLoongarch64::VisitInvokeVirtual(HInvokeVirtual* invoke) {
+  HandleInvoke(invoke);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInvokeVirtual(HInvokeVirtual* invoke) {
+  codegen_->GenerateVirtualCall(invoke, invoke->GetLocations()->GetTemp(0));
+  DCHECK(!codegen_->IsLeafMethod());
+}
+
+void LocationsBuilderLoongarch64::VisitInvokeStaticOrDirect(HInvokeStaticOrDirect* invoke) {
+  // Explicit clinit checks triggered by static invokes must have been pruned by
+  // art::PrepareForRegisterAllocation.
+  DCHECK(!invoke->IsStaticWithExplicitClinitCheck());
+
+  if (invoke->GetCodePtrLocation() == CodePtrLocation::kCallCriticalNative) {
+    CriticalNativeCallingConventionVisitorLoongarch64 calling_convention_visitor(
+        /*for_register_allocation=*/ true);
+    CodeGenerator::CreateCommonInvokeLocationSummary(invoke, &calling_convention_visitor);
+  } else {
+    HandleInvoke(invoke);
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInvokeStaticOrDirect(
+    HInvokeStaticOrDirect* invoke) {
+  // Explicit clinit checks triggered by static invokes must have been pruned by
+  // art::PrepareForRegisterAllocation.
+  DCHECK(!invoke->IsStaticWithExplicitClinitCheck());
+
+  LocationSummary* locations = invoke->GetLocations();
+  codegen_->GenerateStaticOrDirectCall(
+      invoke, locations->HasTemps() ? locations->GetTemp(0) : Location::NoLocation());
+}
+
+void LocationsBuilderLoongarch64::VisitInvokePolymorphic(HInvokePolymorphic* invoke) {
+  HandleInvoke(invoke);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInvokePolymorphic(HInvokePolymorphic* invoke) {
+  codegen_->GenerateInvokePolymorphicCall(invoke);
+}
+
+void LocationsBuilderLoongarch64::VisitInvokeCustom(HInvokeCustom* invoke) {
+  HandleInvoke(invoke);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitInvokeCustom(HInvokeCustom* invoke) {
+  codegen_->GenerateInvokeCustomCall(invoke);
+}
+
+void LocationsBuilderLoongarch64::VisitLoadClass(HLoadClass* cls) {
+  HLoadClass::LoadKind load_kind = cls->GetLoadKind();
+  if (load_kind == HLoadClass::LoadKind::kRuntimeCall) {
+    InvokeRuntimeCallingConvention calling_convention;
+    Location loc = Location::RegisterLocation(calling_convention.GetRegisterAt(0));
+    CodeGenerator::CreateLoadClassRuntimeCallLocationSummary(cls, loc, loc);
+    return;
+  }
+  DCHECK_EQ(cls->NeedsAccessCheck(),
+            load_kind == HLoadClass::LoadKind::kBssEntryPublic ||
+                load_kind == HLoadClass::LoadKind::kBssEntryPackage);
+
+  const bool requires_read_barrier = kEmitCompilerReadBarrier && !cls->IsInBootImage();
+  LocationSummary::CallKind call_kind = (cls->NeedsEnvironment() || requires_read_barrier)
+      ? LocationSummary::kCallOnSlowPath
+      : LocationSummary::kNoCall;
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(cls, call_kind);
+  if (kUseBakerReadBarrier && requires_read_barrier && !cls->NeedsEnvironment()) {
+    locations->SetCustomSlowPathCallerSaves(RegisterSet::Empty());  // No caller-save registers.
+  }
+  if (load_kind == HLoadClass::LoadKind::kReferrersClass) {
+    locations->SetInAt(0, Location::RequiresRegister());
+  }
+  locations->SetOut(Location::RequiresRegister());
+  if (load_kind == HLoadClass::LoadKind::kBssEntry ||
+      load_kind == HLoadClass::LoadKind::kBssEntryPublic ||
+      load_kind == HLoadClass::LoadKind::kBssEntryPackage) {
+    if (!kUseReadBarrier || kUseBakerReadBarrier) {
+      // Rely on the type resolution or initialization and marking to save everything we need.
+      locations->SetCustomSlowPathCallerSaves(OneRegInReferenceOutSaveEverythingCallerSaves());
+    } else {
+      // For non-Baker read barriers we have a temp-clobbering call.
+    }
+  }
+}
+
+// NO_THREAD_SAFETY_ANALYSIS as we manipulate handles whose internal object we know does not
+// move.
+void InstructionCodeGeneratorLoongarch64::VisitLoadClass(HLoadClass* cls)
+    NO_THREAD_SAFETY_ANALYSIS {
+  HLoadClass::LoadKind load_kind = cls->GetLoadKind();
+  if (load_kind == HLoadClass::LoadKind::kRuntimeCall) {
+    codegen_->GenerateLoadClassRuntimeCall(cls);
+    return;
+  }
+  DCHECK_EQ(cls->NeedsAccessCheck(),
+            load_kind == HLoadClass::LoadKind::kBssEntryPublic ||
+                load_kind == HLoadClass::LoadKind::kBssEntryPackage);
+
+  LocationSummary* locations = cls->GetLocations();
+  Location out_loc = locations->Out();
+  XRegister out = out_loc.AsRegister<XRegister>();
+  const ReadBarrierOption read_barrier_option = cls->IsInBootImage()
+      ? kWithoutReadBarrier
+      : kCompilerReadBarrierOption;
+  bool generate_null_check = false;
+  switch (load_kind) {
+    case HLoadClass::LoadKind::kReferrersClass: {
+      DCHECK(!cls->CanCallRuntime());
+      DCHECK(!cls->MustGenerateClinitCheck());
+      // /* GcRoot<mirror::Class> */ out = current_method->declaring_class_
+      XRegister current_method = locations->InAt(0).AsRegister<XRegister>();
+      codegen_->GenerateGcRootFieldLoad(cls,
+                                        out_loc,
+                                        current_method,
+                                        ArtMethod::DeclaringClassOffset().Int32Value(),
+                                        read_barrier_option);
+      break;
+    }
+    case HLoadClass::LoadKind::kBootImageLinkTimePcRelative: {
+      DCHECK(codegen_->GetCompilerOptions().IsBootImage() ||
+             codegen_->GetCompilerOptions().IsBootImageExtension());
+      DCHECK_EQ(read_barrier_option, kWithoutReadBarrier);
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_high =
+          codegen_->NewBootImageTypePatch(cls->GetDexFile(), cls->GetTypeIndex());
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_low =
+          codegen_->NewBootImageTypePatch(cls->GetDexFile(), cls->GetTypeIndex(), info_high);
+      codegen_->EmitPcRelativeAddressPlaceholderHigh(info_high, out);
+      codegen_->EmitPcRelativeAddressPlaceholderLow(info_low, out, out);
+      break;
+    }
+    case HLoadClass::LoadKind::kBootImageRelRo: {
+      DCHECK(!codegen_->GetCompilerOptions().IsBootImage());
+      uint32_t boot_image_offset = CodeGenerator::GetBootImageOffset(cls);
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_high =
+          codegen_->NewBootImageRelRoPatch(boot_image_offset);
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_low =
+          codegen_->NewBootImageRelRoPatch(boot_image_offset, info_high);
+      codegen_->EmitPcRelativeAddressPlaceholderHigh(info_high, out);
+      codegen_->EmitPcRelativeLoadPlaceholderLow(info_low, out, out, kLoadUnsignedWord);
+      break;
+    }
+    case HLoadClass::LoadKind::kBssEntry:
+    case HLoadClass::LoadKind::kBssEntryPublic:
+    case HLoadClass::LoadKind::kBssEntryPackage: {
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* bss_info_high =
+          codegen_->NewTypeBssEntryPatch(cls);
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_low =
+          codegen_->NewTypeBssEntryPatch(cls, bss_info_high);
+      codegen_->EmitPcRelativeAddressPlaceholderHigh(bss_info_high, out);
+      // /* GcRoot<mirror::Class> */ out = *(out + offset)  /* PC-relative */
+      codegen_->GenerateGcRootFieldLoad(cls,
+                                        out_loc,
+                                        out,
+                                        kPcRelativePlaceholderLow,
+                                        read_barrier_option,
+                                        &info_low->label);
+      generate_null_check = true;
+      break;
+    }
+    case HLoadClass::LoadKind::kJitBootImageAddress: {
+      DCHECK_EQ(read_barrier_option, kWithoutReadBarrier);
+      uint32_t address = reinterpret_cast32<uint32_t>(cls->GetClass().Get());
+      DCHECK_NE(address, 0u);
+      __ LoadConst64(out, address);
+      break;
+    }
+    case HLoadClass::LoadKind::kJitTableAddress: {
+      CodeGeneratorLoongarch64::JitPatchInfo* info =
+          codegen_->NewJitRootClassPatch(cls->GetDexFile(), cls->GetTypeIndex(), cls->GetClass());
+      codegen_->EmitJitRootAddressPlaceholder(info, out);
+      codegen_->GenerateGcRootFieldLoad(cls, out_loc, out, /* offset= */ 0, read_barrier_option);
+      break;
+    }
+    case HLoadClass::LoadKind::kRuntimeCall:
+    case HLoadClass::LoadKind::kInvalid:
+      LOG(FATAL) << "UNREACHABLE";
+      UNREACHABLE();
+  }
+
+  if (generate_null_check || cls->MustGenerateClinitCheck()) {
+    DCHECK(cls->CanCallRuntime());
+    SlowPathCodeLoongarch64* slow_path =
+        new (codegen_->GetScopedAllocator()) LoadClassSlowPathLoongarch64(cls, cls);
+    codegen_->AddSlowPath(slow_path);
+    if (generate_null_check) {
+      __ Beqz(out, slow_path->GetEntryLabel());
+    }
+    if (cls->MustGenerateClinitCheck()) {
+      GenerateClassInitializationCheck(slow_path, out);
+    } else {
+      __ Bind(slow_path->GetExitLabel());
+    }
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitLoadMethodHandle(HLoadMethodHandle* load) {
+  InvokeRuntimeCallingConvention calling_convention;
+  Location loc = Location::RegisterLocation(calling_convention.GetRegisterAt(0));
+  CodeGenerator::CreateLoadMethodHandleRuntimeCallLocationSummary(load, loc, loc);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitLoadMethodHandle(HLoadMethodHandle* load) {
+  codegen_->GenerateLoadMethodHandleRuntimeCall(load);
+}
+
+void LocationsBuilderLoongarch64::VisitLoadMethodType(HLoadMethodType* load) {
+  InvokeRuntimeCallingConvention calling_convention;
+  Location loc = Location::RegisterLocation(calling_convention.GetRegisterAt(0));
+  CodeGenerator::CreateLoadMethodTypeRuntimeCallLocationSummary(load, loc, loc);
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitLoadMethodType(HLoadMethodType* load) {
+  codegen_->GenerateLoadMethodTypeRuntimeCall(load);
+}
+
+void LocationsBuilderLoongarch64::VisitLoadString(HLoadString* load) {
+  HLoadString::LoadKind load_kind = load->GetLoadKind();
+  LocationSummary::CallKind call_kind = CodeGenerator::GetLoadStringCallKind(load);
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(load, call_kind);
+  if (load_kind == HLoadString::LoadKind::kRuntimeCall) {
+    InvokeRuntimeCallingConvention calling_convention;
+    locations->SetOut(calling_convention.GetReturnLocation(load->GetType()));
+  } else {
+    locations->SetOut(Location::RequiresRegister());
+    if (load_kind == HLoadString::LoadKind::kBssEntry) {
+      if (!kUseReadBarrier || kUseBakerReadBarrier) {
+        // Rely on the pResolveString and marking to save everything we need.
+        locations->SetCustomSlowPathCallerSaves(OneRegInReferenceOutSaveEverythingCallerSaves());
+      } else {
+        // For non-Baker read barriers we have a temp-clobbering call.
+      }
+    }
+  }
+}
+
+// NO_THREAD_SAFETY_ANALYSIS as we manipulate handles whose internal object we know does not
+// move.
+void InstructionCodeGeneratorLoongarch64::VisitLoadString(HLoadString* load)
+    NO_THREAD_SAFETY_ANALYSIS {
+  HLoadString::LoadKind load_kind = load->GetLoadKind();
+  LocationSummary* locations = load->GetLocations();
+  Location out_loc = locations->Out();
+  XRegister out = out_loc.AsRegister<XRegister>();
+
+  switch (load_kind) {
+    case HLoadString::LoadKind::kBootImageLinkTimePcRelative: {
+      DCHECK(codegen_->GetCompilerOptions().IsBootImage() ||
+             codegen_->GetCompilerOptions().IsBootImageExtension());
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_high =
+          codegen_->NewBootImageStringPatch(load->GetDexFile(), load->GetStringIndex());
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_low = codegen_->NewBootImageStringPatch(
+          load->GetDexFile(), load->GetStringIndex(), info_high);
+      codegen_->EmitPcRelativeAddressPlaceholderHigh(info_high, out);
+      codegen_->EmitPcRelativeAddressPlaceholderLow(info_low, out, out);
+      return;
+    }
+    case HLoadString::LoadKind::kBootImageRelRo: {
+      DCHECK(!codegen_->GetCompilerOptions().IsBootImage());
+      uint32_t boot_image_offset = CodeGenerator::GetBootImageOffset(load);
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_high =
+          codegen_->NewBootImageRelRoPatch(boot_image_offset);
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_low =
+          codegen_->NewBootImageRelRoPatch(boot_image_offset, info_high);
+      codegen_->EmitPcRelativeAddressPlaceholderHigh(info_high, out);
+      codegen_->EmitPcRelativeLoadPlaceholderLow(info_low, out, out, kLoadUnsignedWord);
+      return;
+    }
+    case HLoadString::LoadKind::kBssEntry: {
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_high =
+          codegen_->NewStringBssEntryPatch(load->GetDexFile(), load->GetStringIndex());
+      CodeGeneratorLoongarch64::PcRelativePatchInfo* info_low = codegen_->NewStringBssEntryPatch(
+          load->GetDexFile(), load->GetStringIndex(), info_high);
+      codegen_->EmitPcRelativeAddressPlaceholderHigh(info_high, out);
+      // /* GcRoot<mirror::String> */ out = *(out + offset)  /* PC-relative */
+      codegen_->GenerateGcRootFieldLoad(load,
+                                        out_loc,
+                                        out,
+                                        kPcRelativePlaceholderLow,
+                                        kCompilerReadBarrierOption,
+                                        &info_low->label);
+      SlowPathCodeLoongarch64* slow_path =
+          new (codegen_->GetScopedAllocator()) LoadStringSlowPathLoongarch64(load);
+      codegen_->AddSlowPath(slow_path);
+      __ Beqz(out, slow_path->GetEntryLabel());
+      __ Bind(slow_path->GetExitLabel());
+      return;
+    }
+    case HLoadString::LoadKind::kJitBootImageAddress: {
+      uint32_t address = reinterpret_cast32<uint32_t>(load->GetString().Get());
+      DCHECK_NE(address, 0u);
+      __ LoadConst64(out, address);
+      return;
+    }
+    case HLoadString::LoadKind::kJitTableAddress: {
+      CodeGeneratorLoongarch64::JitPatchInfo* info = codegen_->NewJitRootStringPatch(
+          load->GetDexFile(), load->GetStringIndex(), load->GetString());
+      codegen_->EmitJitRootAddressPlaceholder(info, out);
+      codegen_->GenerateGcRootFieldLoad(
+          load, out_loc, out, /* offset= */ 0, kCompilerReadBarrierOption);
+      return;
+    }
+    default:
+      break;
+  }
+
+  // TODO: Re-add the compiler code to do string dex cache lookup again.
+  DCHECK(load_kind == HLoadString::LoadKind::kRuntimeCall);
+  InvokeRuntimeCallingConvention calling_convention;
+  DCHECK_EQ(calling_convention.GetRegisterAt(0), out);
+  __ LoadConst32(calling_convention.GetRegisterAt(0), load->GetStringIndex().index_);
+  codegen_->InvokeRuntime(kQuickResolveString, load, load->GetDexPc());
+  CheckEntrypointTypes<kQuickResolveString, void*, uint32_t>();
+}
+
+void LocationsBuilderLoongarch64::VisitMonitorOperation(HMonitorOperation* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+      instruction, LocationSummary::kCallOnMainOnly);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitMonitorOperation(HMonitorOperation* instruction) {
+  codegen_->InvokeRuntime(instruction->IsEnter() ? kQuickLockObject : kQuickUnlockObject,
+                          instruction,
+                          instruction->GetDexPc());
+  if (instruction->IsEnter()) {
+    CheckEntrypointTypes<kQuickLockObject, void, mirror::Object*>();
+  } else {
+    CheckEntrypointTypes<kQuickUnlockObject, void, mirror::Object*>();
+  }
+}
+
+void LocationsBuilderLoongarch64::VisitNewArray(HNewArray* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+      instruction, LocationSummary::kCallOnMainOnly);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetOut(calling_convention.GetReturnLocation(DataType::Type::kReference));
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+  locations->SetInAt(1, Location::RegisterLocation(calling_convention.GetRegisterAt(1)));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitNewArray(HNewArray* instruction) {
+  // Note: if heap poisoning is enabled, the entry point takes care of poisoning the reference.
+  QuickEntrypointEnum entrypoint = CodeGenerator::GetArrayAllocationEntrypoint(instruction);
+  codegen_->InvokeRuntime(entrypoint, instruction, instruction->GetDexPc());
+  CheckEntrypointTypes<kQuickAllocArrayResolved, void*, mirror::Class*, int32_t>();
+}
+
+void LocationsBuilderLoongarch64::VisitNewInstance(HNewInstance* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+      instruction, LocationSummary::kCallOnMainOnly);
+  InvokeRuntimeCallingConvention calling_convention;
+  locations->SetInAt(0, Location::RegisterLocation(calling_convention.GetRegisterAt(0)));
+  locations->SetOut(calling_convention.GetReturnLocation(DataType::Type::kReference));
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitNewInstance(HNewInstance* instruction) {
+  codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
+  CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+}
+
+// Simple implementation of packed switch - generate cascaded compare/jumps.
+void LocationsBuilderLoongarch64::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  LocationSummary* locations =
+      new (GetGraph()->GetAllocator()) LocationSummary(switch_instr, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+}
+
+void InstructionCodeGeneratorLoongarch64::GenPackedSwitchWithCompares(XRegister reg,
+                                                                     int32_t lower_bound,
+                                                                     uint32_t num_entries,
+                                                                     HBasicBlock* switch_block,
+                                                                     HBasicBlock* default_block) {
+  // Create a set of compare/jumps.
+  __ LoadConst32(TMP, lower_bound);
+  __ SubW(TMP, reg, TMP);
+  // Jump to default if index is negative.
+  // Note: We don't check the case that index is positive while value < lower_bound, because in
+  // this case, index >= num_entries must be true. So that we can save one branch instruction.
+  __ Blt(TMP, Zero, codegen_->GetLabelOf(default_block));
+
+  const ArenaVector<HBasicBlock*>& successors = switch_block->GetSuccessors();
+  // Jump to successors[0] if value == lower_bound.
+  __ Beqz(TMP, codegen_->GetLabelOf(successors[0]));
+  int32_t last_index = 0;
+  for (; num_entries - last_index > 2; last_index += 2) {
+    __ AddiW(TMP, TMP, -2);
+    // Jump to successors[last_index + 1] if value < case_value[last_index + 2].
+    __ Blt(TMP, Zero, codegen_->GetLabelOf(successors[last_index + 1]));
+    // Jump to successors[last_index + 2] if value == case_value[last_index + 2].
+    __ Beqz(TMP, codegen_->GetLabelOf(successors[last_index + 2]));
+  }
+  if (num_entries - last_index == 2) {
+    // The last missing case_value.
+    __ AddiW(TMP, TMP, -1);
+    __ Beqz(TMP, codegen_->GetLabelOf(successors[last_index + 1]));
+  }
+
+  // And the default for any other value.
+  if (!codegen_->GoesToNextBlock(switch_block, default_block)) {
+    __ B(codegen_->GetLabelOf(default_block));
+  }
+}
+
+void InstructionCodeGeneratorLoongarch64::VisitPackedSwitch(HPackedSwitch* switch_instr) {
+  int32_t lower_bound = switch_instr->GetStartValue();
+  uint32_t num_entries = switch_instr->GetNumEntries();
+  LocationSummary* locations = switch_instr->GetLocations();
+  XRegister value_reg = locations->InAt(0).AsRegister<XRegister>();
+  HBasicBlock* switch_block = switch_instr->GetBlock();
+  HBasicBlock* default_block = switch_instr->GetDefaultBlock();
+
+  GenPackedSwitchWithCompares(value_reg, lower_bound, num_entries, switch_block, default_block);
+}
+
+#undef __
+#undef QUICK_ENTRY_POINT
+
+}  // namespace loongarch64
+}  // namespace art
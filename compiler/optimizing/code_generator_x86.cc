@@ -1976,9 +1976,37 @@ void InstructionCodeGeneratorX86::VisitIf(HIf* if_instr) {
       nullptr : codegen_->GetLabelOf(true_successor);
   Label* false_target = codegen_->GoesToNextBlock(if_instr->GetBlock(), false_successor) ?
       nullptr : codegen_->GetLabelOf(false_successor);
+  BranchCache* cache = codegen_->GetBranchCacheForProfiling(if_instr);
+  if (cache != nullptr) {
+    // Record which side of the branch is taken before jumping to it.
+    NearLabel true_taken;
+    GenerateTestAndBranch<NearLabel>(
+        if_instr, /* condition_input_index= */ 0, &true_taken, /* false_target= */ nullptr);
+    GenerateBranchProfileUpdate(cache, /* taken= */ false);
+    if (false_target != nullptr) {
+      __ jmp(false_target);
+    }
+    __ Bind(&true_taken);
+    GenerateBranchProfileUpdate(cache, /* taken= */ true);
+    if (true_target != nullptr) {
+      __ jmp(true_target);
+    }
+    return;
+  }
   GenerateTestAndBranch(if_instr, /* condition_input_index= */ 0, true_target, false_target);
 }
 
+void InstructionCodeGeneratorX86::GenerateBranchProfileUpdate(BranchCache* cache, bool taken) {
+  MemberOffset offset = taken ? BranchCache::TrueOffset() : BranchCache::FalseOffset();
+  Address counter =
+      Address::Absolute(reinterpret_cast32<uint32_t>(cache) + offset.Uint32Value());
+  NearLabel overflow;
+  __ cmpw(counter, Immediate(std::numeric_limits<uint16_t>::max()));
+  __ j(kEqual, &overflow);
+  __ addw(counter, Immediate(1));
+  __ Bind(&overflow);
+}
+
 void LocationsBuilderX86::VisitDeoptimize(HDeoptimize* deoptimize) {
   LocationSummary* locations = new (GetGraph()->GetAllocator())
       LocationSummary(deoptimize, LocationSummary::kCallOnSlowPath);
@@ -5846,11 +5874,16 @@ void LocationsBuilderX86::HandleFieldSet(HInstruction* instruction, const FieldI
   } else {
     locations->SetInAt(1, Location::RegisterOrConstant(instruction->InputAt(1)));
 
-    if (CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(1))) {
+    if (CodeGenerator::StoreNeedsWriteBarrier(
+            field_type, instruction->InputAt(1), CodeGenerator::GetWriteBarrierKind(instruction))) {
       // Temporary registers for the write barrier.
       locations->AddTemp(Location::RequiresRegister());  // May be used for reference poisoning too.
       // Ensure the card is in a byte register.
       locations->AddTemp(Location::RegisterLocation(ECX));
+    } else if (kPoisonHeapReferences &&
+               CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(1))) {
+      // Temporary register for the reference poisoning.
+      locations->AddTemp(Location::RequiresRegister());
     }
   }
 }
@@ -5974,10 +6007,17 @@ void InstructionCodeGeneratorX86::HandleFieldSet(HInstruction* instruction,
     codegen_->MaybeRecordImplicitNullCheck(instruction);
   }
 
-  if (needs_write_barrier) {
+  WriteBarrierKind write_barrier_kind = CodeGenerator::GetWriteBarrierKind(instruction);
+  if (CodeGenerator::StoreNeedsWriteBarrier(
+          field_type, instruction->InputAt(value_index), write_barrier_kind)) {
     Register temp = locations->GetTemp(0).AsRegister<Register>();
     Register card = locations->GetTemp(1).AsRegister<Register>();
-    codegen_->MarkGCCard(temp, card, base, value.AsRegister<Register>(), value_can_be_null);
+    codegen_->MarkGCCard(
+        temp,
+        card,
+        base,
+        value.AsRegister<Register>(),
+        value_can_be_null && write_barrier_kind == WriteBarrierKind::kEmitWithNullCheck);
   }
 
   if (is_volatile) {
@@ -322,6 +322,8 @@ class InstructionCodeGeneratorX86 : public InstructionCodeGenerator {
                              size_t condition_input_index,
                              LabelType* true_target,
                              LabelType* false_target);
+  // Increment the (saturating) counter of `cache` for the `taken` side of a branch.
+  void GenerateBranchProfileUpdate(BranchCache* cache, bool taken);
   template<class LabelType>
   void GenerateCompareTestAndBranch(HCondition* condition,
                                     LabelType* true_target,
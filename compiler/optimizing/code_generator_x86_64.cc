@@ -1972,9 +1972,37 @@ void InstructionCodeGeneratorX86_64::VisitIf(HIf* if_instr) {
       nullptr : codegen_->GetLabelOf(true_successor);
   Label* false_target = codegen_->GoesToNextBlock(if_instr->GetBlock(), false_successor) ?
       nullptr : codegen_->GetLabelOf(false_successor);
+  BranchCache* cache = codegen_->GetBranchCacheForProfiling(if_instr);
+  if (cache != nullptr) {
+    // Record which side of the branch is taken before jumping to it.
+    NearLabel true_taken;
+    GenerateTestAndBranch<NearLabel>(
+        if_instr, /* condition_input_index= */ 0, &true_taken, /* false_target= */ nullptr);
+    GenerateBranchProfileUpdate(cache, /* taken= */ false);
+    if (false_target != nullptr) {
+      __ jmp(false_target);
+    }
+    __ Bind(&true_taken);
+    GenerateBranchProfileUpdate(cache, /* taken= */ true);
+    if (true_target != nullptr) {
+      __ jmp(true_target);
+    }
+    return;
+  }
   GenerateTestAndBranch(if_instr, /* condition_input_index= */ 0, true_target, false_target);
 }
 
+void InstructionCodeGeneratorX86_64::GenerateBranchProfileUpdate(BranchCache* cache, bool taken) {
+  MemberOffset offset = taken ? BranchCache::TrueOffset() : BranchCache::FalseOffset();
+  NearLabel overflow;
+  __ movq(CpuRegister(TMP), Immediate(reinterpret_cast64<int64_t>(cache)));
+  __ cmpw(Address(CpuRegister(TMP), offset.Int32Value()),
+          Immediate(std::numeric_limits<uint16_t>::max()));
+  __ j(kEqual, &overflow);
+  __ addw(Address(CpuRegister(TMP), offset.Int32Value()), Immediate(1));
+  __ Bind(&overflow);
+}
+
 void LocationsBuilderX86_64::VisitDeoptimize(HDeoptimize* deoptimize) {
   LocationSummary* locations = new (GetGraph()->GetAllocator())
       LocationSummary(deoptimize, LocationSummary::kCallOnSlowPath);
@@ -5011,8 +5039,8 @@ void LocationsBuilderX86_64::HandleFieldSet(HInstruction* instruction,
       new (GetGraph()->GetAllocator()) LocationSummary(instruction, LocationSummary::kNoCall);
   DataType::Type field_type = field_info.GetFieldType();
   bool is_volatile = field_info.IsVolatile();
-  bool needs_write_barrier =
-      CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(1));
+  bool needs_write_barrier = CodeGenerator::StoreNeedsWriteBarrier(
+      field_type, instruction->InputAt(1), CodeGenerator::GetWriteBarrierKind(instruction));
 
   locations->SetInAt(0, Location::RequiresRegister());
   if (DataType::IsFloatingPointType(instruction->InputAt(1)->GetType())) {
@@ -5163,10 +5191,17 @@ void InstructionCodeGeneratorX86_64::HandleFieldSet(HInstruction* instruction,
     codegen_->MaybeRecordImplicitNullCheck(instruction);
   }
 
-  if (CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(1))) {
+  WriteBarrierKind write_barrier_kind = CodeGenerator::GetWriteBarrierKind(instruction);
+  if (CodeGenerator::StoreNeedsWriteBarrier(
+          field_type, instruction->InputAt(1), write_barrier_kind)) {
     CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
     CpuRegister card = locations->GetTemp(1).AsRegister<CpuRegister>();
-    codegen_->MarkGCCard(temp, card, base, value.AsRegister<CpuRegister>(), value_can_be_null);
+    codegen_->MarkGCCard(
+        temp,
+        card,
+        base,
+        value.AsRegister<CpuRegister>(),
+        value_can_be_null && write_barrier_kind == WriteBarrierKind::kEmitWithNullCheck);
   }
 
   if (is_volatile) {
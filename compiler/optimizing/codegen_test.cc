@@ -47,6 +47,9 @@ static ::std::vector<CodegenTargetConfig> GetTargetConfigs() {
 #ifdef ART_ENABLE_CODEGEN_arm64
     CodegenTargetConfig(InstructionSet::kArm64, create_codegen_arm64),
 #endif
+#ifdef ART_ENABLE_CODEGEN_loongarch64
+    CodegenTargetConfig(InstructionSet::kLoongarch64, create_codegen_loongarch64),
+#endif
 #ifdef ART_ENABLE_CODEGEN_x86
     CodegenTargetConfig(InstructionSet::kX86, create_codegen_x86),
 #endif
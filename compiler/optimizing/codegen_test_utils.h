@@ -337,7 +337,10 @@ inline CodeGenerator* create_codegen_arm64(HGraph* graph, const CompilerOptions&
 #endif
 
 #ifdef ART_ENABLE_CODEGEN_loongarch64
-inline CodeGenerator* create_codegen_loongarch64(HGraph*, const CompilerOptions&) { return nullptr; }
+inline CodeGenerator* create_codegen_loongarch64(HGraph* graph,
+                                                 const CompilerOptions& compiler_options) {
+  return new (graph->GetAllocator()) loongarch64::CodeGeneratorLoongarch64(graph, compiler_options);
+}
 #endif
 
 #ifdef ART_ENABLE_CODEGEN_x86
@@ -28,9 +28,12 @@
 
 namespace art {
 
-ExecutionSubgraph::ExecutionSubgraph(HGraph* graph, ScopedArenaAllocator* allocator)
+ExecutionSubgraph::ExecutionSubgraph(HGraph* graph,
+                                     ScopedArenaAllocator* allocator,
+                                     const HBasicBlock* allocation_block)
     : graph_(graph),
       allocator_(allocator),
+      allocation_block_(allocation_block),
       allowed_successors_(graph_->GetBlocks().size(),
                           ~(std::bitset<kMaxFilterableSuccessors> {}),
                           allocator_->Adapter(kArenaAllocLSA)),
@@ -245,6 +248,26 @@ void ExecutionSubgraph::RemoveConcavity() {
     return;
   }
   DCHECK(!needs_prune_);
+  if (allocation_block_ != nullptr) {
+    {
+      ScopedArenaAllocator temporaries(graph_->GetArenaStack());
+      const size_t num_blocks = graph_->GetBlocks().size();
+      ArenaBitVector after_removed(&temporaries, num_blocks, false, kArenaAllocLSA);
+      ArenaBitVector before_removed(&temporaries, num_blocks, false, kArenaAllocLSA);
+      MarkReachableAvoidingAllocation(unreachable_blocks_, /*forward=*/ true, &after_removed);
+      MarkReachableAvoidingAllocation(unreachable_blocks_, /*forward=*/ false, &before_removed);
+      for (const HBasicBlock* blk : graph_->GetBlocks()) {
+        if (blk != nullptr &&
+            !unreachable_blocks_.IsBitSet(blk->GetBlockId()) &&
+            after_removed.IsBitSet(blk->GetBlockId()) &&
+            before_removed.IsBitSet(blk->GetBlockId())) {
+          RemoveBlock(blk);
+        }
+      }
+    }
+    Prune();
+    return;
+  }
   for (const HBasicBlock* blk : graph_->GetBlocks()) {
     if (blk == nullptr || unreachable_blocks_.IsBitSet(blk->GetBlockId())) {
       continue;
@@ -314,6 +337,44 @@ void ExecutionSubgraph::RecalculateExcludedCohort() {
         cohort.exit_blocks_.SetBit(blk->GetBlockId());
       }
     }
+    if (allocation_block_ != nullptr) {
+      cohort.allocation_relative_ = true;
+      MarkReachableAvoidingAllocation(
+          cohort.blocks_, /*forward=*/ true, &cohort.reachable_from_cohort_);
+      MarkReachableAvoidingAllocation(cohort.blocks_, /*forward=*/ false, &cohort.reaching_cohort_);
+    }
+  }
+}
+
+void ExecutionSubgraph::MarkReachableAvoidingAllocation(const ArenaBitVector& from,
+                                                        bool forward,
+                                                        ArenaBitVector* result) const {
+  DCHECK(allocation_block_ != nullptr);
+  ScopedArenaAllocator alloc(graph_->GetArenaStack());
+  ScopedArenaVector<const HBasicBlock*> worklist(alloc.Adapter(kArenaAllocLSA));
+  auto push_neighbors = [&](const HBasicBlock* blk) {
+    const ArenaVector<HBasicBlock*>& next =
+        forward ? blk->GetSuccessors() : blk->GetPredecessors();
+    worklist.insert(worklist.end(), next.begin(), next.end());
+  };
+  for (uint32_t id : from.Indexes()) {
+    push_neighbors(graph_->GetBlocks()[id]);
+  }
+  while (!worklist.empty()) {
+    const HBasicBlock* cur = worklist.back();
+    worklist.pop_back();
+    if (result->IsBitSet(cur->GetBlockId())) {
+      continue;
+    }
+    if (cur == allocation_block_) {
+      // A new object is created here. Don't look any further.
+      if (!forward) {
+        result->SetBit(cur->GetBlockId());
+      }
+      continue;
+    }
+    result->SetBit(cur->GetBlockId());
+    push_neighbors(cur);
   }
 }
 
@@ -108,11 +108,14 @@ class BlockIdFilterThunk {
 // boundary between the cohort and the rest of the graph to insert
 // materialization blocks for partial LSE.
 //
-// TODO We really should expand this to take into account where the object
-// allocation takes place directly. Currently we always act as though it were
-// allocated in the entry block. This is a massively simplifying assumption but
-// means we can't partially remove objects that are repeatedly allocated in a
-// loop.
+// By default we act as though the object were allocated in the entry block.
+// This is a massively simplifying assumption but means that an escape inside a
+// loop makes the whole loop escape. For objects that are repeatedly allocated
+// in a loop the subgraph can instead be given the block of the allocation. Each
+// execution of that block creates a new object so paths running through it are
+// not considered when removing concavity or when deciding whether a cohort
+// precedes or succeeds a block. This is only valid if the reference can not
+// flow around a back-edge (see ReferenceInfo::FindLoopAllocationBlock).
 class ExecutionSubgraph : public DeletableArenaObject<kArenaAllocLSA> {
  public:
   using BitVecBlockRange =
@@ -130,7 +133,11 @@ class ExecutionSubgraph : public DeletableArenaObject<kArenaAllocLSA> {
         : graph_(graph),
           entry_blocks_(allocator, graph_->GetBlocks().size(), false, kArenaAllocLSA),
           exit_blocks_(allocator, graph_->GetBlocks().size(), false, kArenaAllocLSA),
-          blocks_(allocator, graph_->GetBlocks().size(), false, kArenaAllocLSA) {}
+          blocks_(allocator, graph_->GetBlocks().size(), false, kArenaAllocLSA),
+          allocation_relative_(false),
+          reachable_from_cohort_(
+              allocator, graph_->GetBlocks().size(), false, kArenaAllocLSA),
+          reaching_cohort_(allocator, graph_->GetBlocks().size(), false, kArenaAllocLSA) {}
 
     ~ExcludedCohort() = default;
 
@@ -175,6 +182,9 @@ class ExecutionSubgraph : public DeletableArenaObject<kArenaAllocLSA> {
       if (ContainsBlock(blk)) {
         return false;
       }
+      if (allocation_relative_) {
+        return reaching_cohort_.IsBitSet(blk->GetBlockId());
+      }
       auto idxs = entry_blocks_.Indexes();
       return std::any_of(idxs.begin(), idxs.end(), [&](uint32_t entry) -> bool {
         return blk->GetGraph()->PathBetween(blk->GetBlockId(), entry);
@@ -188,6 +198,9 @@ class ExecutionSubgraph : public DeletableArenaObject<kArenaAllocLSA> {
       if (ContainsBlock(blk)) {
         return false;
       }
+      if (allocation_relative_) {
+        return reachable_from_cohort_.IsBitSet(blk->GetBlockId());
+      }
       auto idxs = exit_blocks_.Indexes();
       return std::any_of(idxs.begin(), idxs.end(), [&](uint32_t exit) -> bool {
         return blk->GetGraph()->PathBetween(exit, blk->GetBlockId());
@@ -209,6 +222,12 @@ class ExecutionSubgraph : public DeletableArenaObject<kArenaAllocLSA> {
     ArenaBitVector entry_blocks_;
     ArenaBitVector exit_blocks_;
     ArenaBitVector blocks_;
+    // Set if the subgraph tracks the allocation block. The following two
+    // vectors then hold the blocks with a path from (resp. to) the cohort which
+    // does not run through the allocation block.
+    bool allocation_relative_;
+    ArenaBitVector reachable_from_cohort_;
+    ArenaBitVector reaching_cohort_;
 
     friend class ExecutionSubgraph;
     friend class LoadStoreAnalysisTest;
@@ -225,8 +244,12 @@ class ExecutionSubgraph : public DeletableArenaObject<kArenaAllocLSA> {
   // Instantiate a subgraph. The subgraph can be instantiated only if partial-escape
   // analysis is desired (eg not when being used for instruction scheduling) and
   // when the branching factor in the graph is not too high. These conditions
-  // are determined once and passed down for performance reasons.
-  ExecutionSubgraph(HGraph* graph, ScopedArenaAllocator* allocator);
+  // are determined once and passed down for performance reasons. If
+  // 'allocation_block' is not null escapes are tracked relative to it (see
+  // above), otherwise the allocation is assumed to be in the entry block.
+  ExecutionSubgraph(HGraph* graph,
+                    ScopedArenaAllocator* allocator,
+                    const HBasicBlock* allocation_block = nullptr);
 
   void Invalidate() {
     valid_ = false;
@@ -320,7 +343,9 @@ class ExecutionSubgraph : public DeletableArenaObject<kArenaAllocLSA> {
   // with only conditionally materializing objects depending on if we already materialized them
   // Ensure that for all blocks A, B, C: Unreachable(A) && Unreachable(C) && PathBetween(A, B) &&
   // PathBetween(A, C) implies Unreachable(B). This simplifies later transforms since it ensures
-  // that no execution can leave and then re-enter any exclusion.
+  // that no execution can leave and then re-enter any exclusion. If the
+  // allocation block is known paths running through it are ignored since an
+  // execution re-entering an exclusion after it deals with a new object.
   void RemoveConcavity();
 
   // Removes sink nodes. Sink nodes are nodes where there is no execution which
@@ -329,8 +354,20 @@ class ExecutionSubgraph : public DeletableArenaObject<kArenaAllocLSA> {
 
   void RecalculateExcludedCohort();
 
+  // Marks in 'result' every block reachable from a block in 'from' without
+  // running through allocation_block_. Successor edges are followed if
+  // 'forward' is true and predecessor edges otherwise. The allocation block is
+  // itself marked only when going backwards since it reaches 'from' with the
+  // same object but is never reached from 'from' with it.
+  void MarkReachableAvoidingAllocation(const ArenaBitVector& from,
+                                       bool forward,
+                                       ArenaBitVector* result) const;
+
   HGraph* graph_;
   ScopedArenaAllocator* allocator_;
+  // The block the tracked object is allocated in, or null if it is treated as
+  // allocated in the entry block.
+  const HBasicBlock* allocation_block_;
   // The map from block_id -> allowed-successors.
   // This is the canonical representation of this subgraph. If a bit in the
   // bitset is not set then the corresponding outgoing edge of that block is not
@@ -972,4 +972,91 @@ TEST_F(ExecutionSubgraphTest, CanNotAnalyseBig) {
   AdjacencyListGraph blks(SetupFromAdjacencyList("entry", "exit", edges));
   ASSERT_FALSE(ExecutionSubgraph::CanAnalyse(graph_));
 }
+
+// An object allocated in 'alloc' escapes in 'left' on some iterations.
+//                 +-------+
+//                 | entry |
+//                 +-------+
+//                   |
+//                   v
+//                 +--------+     +-------+     +------+
+//   +-----------> | header | --> | after | --> | exit |
+//   |             +--------+     +-------+     +------+
+//   |               |
+//   |               v
+//   |             +-------+
+//   |             | alloc | ---------+
+//   |             +-------+          |
+//   |               |                |
+//   |               v                v
+//   |           + - - - - +      +-------+
+//   |           ' left    '      | right |
+//   |           + - - - - +      +-------+
+//   |               |                |
+//   |               v                |
+//   |             +-------+          |
+//   +------------ | latch | <--------+
+//                 +-------+
+TEST_F(ExecutionSubgraphTest, AllocationInLoop) {
+  AdjacencyListGraph blks(SetupFromAdjacencyList("entry",
+                                                 "exit",
+                                                 { { "entry", "header" },
+                                                   { "header", "alloc" },
+                                                   { "header", "after" },
+                                                   { "alloc", "left" },
+                                                   { "alloc", "right" },
+                                                   { "left", "latch" },
+                                                   { "right", "latch" },
+                                                   { "latch", "header" },
+                                                   { "after", "exit" } }));
+  ASSERT_TRUE(ExecutionSubgraph::CanAnalyse(graph_));
+  ExecutionSubgraph esg(graph_, GetScopedAllocator(), blks.Get("alloc"));
+  esg.RemoveBlock(blks.Get("left"));
+  esg.Finalize();
+  ASSERT_TRUE(esg.IsValid());
+  ASSERT_TRUE(IsValidSubgraph(esg));
+  std::unordered_set<const HBasicBlock*> contents(esg.ReachableBlocks().begin(),
+                                                  esg.ReachableBlocks().end());
+
+  // Every path from 'left' back to itself allocates a new object so the rest of
+  // the loop stays in the subgraph.
+  ASSERT_EQ(contents.size(), 7u);
+  ASSERT_TRUE(contents.find(blks.Get("left")) == contents.end());
+  ASSERT_TRUE(contents.find(blks.Get("alloc")) != contents.end());
+  ASSERT_TRUE(contents.find(blks.Get("right")) != contents.end());
+  ASSERT_TRUE(contents.find(blks.Get("latch")) != contents.end());
+  ASSERT_TRUE(contents.find(blks.Get("header")) != contents.end());
+
+  ArrayRef<const ExecutionSubgraph::ExcludedCohort> exclusions(esg.GetExcludedCohorts());
+  ASSERT_EQ(exclusions.size(), 1u);
+  const ExecutionSubgraph::ExcludedCohort& cohort = exclusions.front();
+  EXPECT_TRUE(cohort.PrecedesBlock(blks.Get("latch")));
+  EXPECT_TRUE(cohort.PrecedesBlock(blks.Get("header")));
+  EXPECT_TRUE(cohort.PrecedesBlock(blks.Get("after")));
+  EXPECT_FALSE(cohort.PrecedesBlock(blks.Get("alloc")));
+  EXPECT_FALSE(cohort.PrecedesBlock(blks.Get("right")));
+  EXPECT_TRUE(cohort.SucceedsBlock(blks.Get("alloc")));
+  EXPECT_FALSE(cohort.SucceedsBlock(blks.Get("header")));
+  EXPECT_FALSE(cohort.SucceedsBlock(blks.Get("right")));
+}
+
+// Without the allocation block the same escape removes the whole loop.
+TEST_F(ExecutionSubgraphTest, AllocationInLoopUnknown) {
+  AdjacencyListGraph blks(SetupFromAdjacencyList("entry",
+                                                 "exit",
+                                                 { { "entry", "header" },
+                                                   { "header", "alloc" },
+                                                   { "header", "after" },
+                                                   { "alloc", "left" },
+                                                   { "alloc", "right" },
+                                                   { "left", "latch" },
+                                                   { "right", "latch" },
+                                                   { "latch", "header" },
+                                                   { "after", "exit" } }));
+  ASSERT_TRUE(ExecutionSubgraph::CanAnalyse(graph_));
+  ExecutionSubgraph esg(graph_, GetScopedAllocator());
+  esg.RemoveBlock(blks.Get("left"));
+  esg.Finalize();
+  ASSERT_FALSE(esg.IsValid());
+}
 }  // namespace art
@@ -451,6 +451,13 @@ bool HInliner::TryInline(HInvoke* invoke_instruction) {
   ScopedObjectAccess soa(Thread::Current());
   LOG_TRY() << invoke_instruction->GetMethodReference().PrettyMethod();
 
+  // Do not spend the inlining budget on calls the branch profile shows are (almost) never made.
+  if (invoke_instruction->GetBlock()->IsColdByBranchProfile()) {
+    LOG_FAIL(stats_, MethodCompilationStat::kNotInlinedColdBlock)
+        << "Not inlining a call in a cold block";
+    return false;
+  }
+
   ArtMethod* resolved_method = invoke_instruction->GetResolvedMethod();
   if (resolved_method == nullptr) {
     DCHECK(invoke_instruction->IsInvokeStaticOrDirect());
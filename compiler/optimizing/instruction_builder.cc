@@ -32,6 +32,7 @@
 #include "intrinsics.h"
 #include "intrinsics_utils.h"
 #include "jit/jit.h"
+#include "jit/profiling_info.h"
 #include "mirror/dex_cache.h"
 #include "oat_file.h"
 #include "optimizing_compiler_stats.h"
@@ -648,7 +649,7 @@ void HInstructionBuilder::If_22t(const Instruction& instruction, uint32_t dex_pc
   HInstruction* second = LoadLocal(instruction.VRegB(), DataType::Type::kInt32);
   T* comparison = new (allocator_) T(first, second, dex_pc);
   AppendInstruction(comparison);
-  AppendInstruction(new (allocator_) HIf(comparison, dex_pc));
+  AppendInstruction(BuildIf(comparison, dex_pc));
   current_block_ = nullptr;
 }
 
@@ -657,10 +658,22 @@ void HInstructionBuilder::If_21t(const Instruction& instruction, uint32_t dex_pc
   HInstruction* value = LoadLocal(instruction.VRegA(), DataType::Type::kInt32);
   T* comparison = new (allocator_) T(value, graph_->GetIntConstant(0, dex_pc), dex_pc);
   AppendInstruction(comparison);
-  AppendInstruction(new (allocator_) HIf(comparison, dex_pc));
+  AppendInstruction(BuildIf(comparison, dex_pc));
   current_block_ = nullptr;
 }
 
+HIf* HInstructionBuilder::BuildIf(HInstruction* condition, uint32_t dex_pc) {
+  HIf* if_instr = new (allocator_) HIf(condition, dex_pc);
+  ProfilingInfo* info = graph_->GetProfilingInfo();
+  if (info != nullptr && !graph_->IsCompilingBaseline()) {
+    BranchCache* cache = info->GetBranchCache(dex_pc);
+    if (cache != nullptr) {
+      if_instr->SetBranchProfile(cache->GetTrue(), cache->GetFalse());
+    }
+  }
+  return if_instr;
+}
+
 template<typename T>
 void HInstructionBuilder::Unop_12x(const Instruction& instruction,
                                    DataType::Type type,
@@ -118,6 +118,10 @@ class HInstructionBuilder : public ValueObject {
   template<typename T> void If_21t(const Instruction& instruction, uint32_t dex_pc);
   template<typename T> void If_22t(const Instruction& instruction, uint32_t dex_pc);
 
+  // Builds an HIf for the conditional branch at `dex_pc`, with the branch profile collected by
+  // baseline code when compiling optimized.
+  HIf* BuildIf(HInstruction* condition, uint32_t dex_pc);
+
   void Conversion_12x(const Instruction& instruction,
                       DataType::Type input_type,
                       DataType::Type result_type,
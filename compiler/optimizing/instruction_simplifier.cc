@@ -1109,6 +1109,7 @@ void InstructionSimplifierVisitor::VisitIf(HIf* instruction) {
     // Swap successors if input is negated.
     instruction->ReplaceInput(condition->InputAt(0), 0);
     instruction->GetBlock()->SwapSuccessors();
+    instruction->SwapBranchProfile();
     RecordSimplification();
   }
 }
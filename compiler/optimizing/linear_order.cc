@@ -16,6 +16,7 @@
 
 #include "linear_order.h"
 
+#include "base/array_ref.h"
 #include "base/scoped_arena_allocator.h"
 #include "base/scoped_arena_containers.h"
 
@@ -54,6 +55,34 @@ static void AddToListForLinearization(ScopedArenaVector<HBasicBlock*>* worklist,
   worklist->insert(insert_pos.base(), block);
 }
 
+// Helper method to add a block the branch profile shows is cold to the work list: it is
+// placed as deep as possible, so that it is linearized after the other blocks of its loop, or
+// at the end of the method if it is not in a loop.
+static void AddColdBlockToListForLinearization(ScopedArenaVector<HBasicBlock*>* worklist,
+                                               HBasicBlock* block) {
+  HLoopInformation* block_loop = block->GetLoopInformation();
+  auto insert_pos = worklist->begin();
+  if (IsLoop(block_loop)) {
+    // Skip the blocks outside of the loop, they must come after it.
+    for (auto end = worklist->end(); insert_pos != end; ++insert_pos) {
+      HLoopInformation* current_loop = (*insert_pos)->GetLoopInformation();
+      if (IsLoop(current_loop) && current_loop->IsIn(*block_loop)) {
+        break;
+      }
+    }
+  }
+  worklist->insert(insert_pos, block);
+}
+
+// Orders the successors of `if_instr` such that the most likely one is added last to the work
+// list, and is therefore linearized right after the branch.
+static void OrderSuccessorsByBranchProfile(HIf* if_instr, /*out*/ HBasicBlock* ordered[2]) {
+  DCHECK(if_instr->HasBranchProfile());
+  bool true_is_likely = if_instr->GetTrueCount() > if_instr->GetFalseCount();
+  ordered[0] = true_is_likely ? if_instr->IfFalseSuccessor() : if_instr->IfTrueSuccessor();
+  ordered[1] = true_is_likely ? if_instr->IfTrueSuccessor() : if_instr->IfFalseSuccessor();
+}
+
 // Helper method to validate linear order.
 static bool IsLinearOrderWellFormed(const HGraph* graph, ArrayRef<HBasicBlock*> linear_order) {
   for (HBasicBlock* header : graph->GetBlocks()) {
@@ -108,6 +137,9 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   //      iterate over the successors. When all non-back edge predecessors of a
   //      successor block are visited, the successor block is added in the worklist
   //      following an order that satisfies the requirements to build our linear graph.
+  //      When the branch profile of an HIf is known, the more likely successor is added last so
+  //      that it follows the branch, and successors that are cold are pushed to the end of
+  //      their loop or of the method.
   ScopedArenaVector<HBasicBlock*> worklist(allocator.Adapter(kArenaAllocLinearOrder));
   worklist.push_back(graph->GetEntryBlock());
   size_t num_added = 0u;
@@ -116,11 +148,25 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
     worklist.pop_back();
     linear_order[num_added] = current;
     ++num_added;
-    for (HBasicBlock* successor : current->GetSuccessors()) {
+    HIf* profiled_if = current->GetLastInstruction()->AsIf();
+    if (profiled_if != nullptr && !profiled_if->HasBranchProfile()) {
+      profiled_if = nullptr;
+    }
+    HBasicBlock* ordered_successors[2];
+    ArrayRef<HBasicBlock* const> successors(current->GetSuccessors());
+    if (profiled_if != nullptr) {
+      OrderSuccessorsByBranchProfile(profiled_if, ordered_successors);
+      successors = ArrayRef<HBasicBlock* const>(ordered_successors, 2u);
+    }
+    for (HBasicBlock* successor : successors) {
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
       if (number_of_remaining_predecessors == 1) {
-        AddToListForLinearization(&worklist, successor);
+        if (profiled_if != nullptr && profiled_if->IsColdSuccessor(successor)) {
+          AddColdBlockToListForLinearization(&worklist, successor);
+        } else {
+          AddToListForLinearization(&worklist, successor);
+        }
       }
       forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
     }
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <fstream>
+#include <tuple>
 
 #include "base/arena_allocator.h"
 #include "builder.h"
@@ -246,4 +248,58 @@ TEST_F(LinearizeTest, CFG7) {
   TestCode(data, blocks);
 }
 
+TEST_F(LinearizeTest, BranchProfile) {
+  //            Block0
+  //              |
+  //            Block1 (if)
+  //            /    \
+  //       (false)  (true)
+  //            \    /
+  //             Exit
+  const std::vector<uint16_t> data = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::RETURN_VOID,
+    Instruction::RETURN_VOID);
+
+  std::unique_ptr<CompilerOptions> compiler_options =
+      CommonCompilerTest::CreateCompilerOptions(kRuntimeISA, "default");
+  auto linearize = [&](uint16_t true_count, uint16_t false_count) {
+    HGraph* graph = CreateCFG(data);
+    HIf* if_instr = nullptr;
+    for (HBasicBlock* block : graph->GetReversePostOrder()) {
+      if (block->GetLastInstruction()->IsIf()) {
+        if_instr = block->GetLastInstruction()->AsIf();
+      }
+    }
+    CHECK(if_instr != nullptr);
+    if_instr->SetBranchProfile(true_count, false_count);
+    std::unique_ptr<CodeGenerator> codegen = CodeGenerator::Create(graph, *compiler_options);
+    CHECK(codegen != nullptr);
+    SsaLivenessAnalysis liveness(graph, codegen.get(), GetScopedAllocator());
+    liveness.Analyze();
+    const ArenaVector<HBasicBlock*>& order = graph->GetLinearOrder();
+    auto index_of = [&](HBasicBlock* block) {
+      return std::find(order.begin(), order.end(), block) - order.begin();
+    };
+    return std::make_tuple(index_of(if_instr->GetBlock()),
+                           index_of(if_instr->IfTrueSuccessor()),
+                           index_of(if_instr->IfFalseSuccessor()));
+  };
+
+  // Without a profile, the false successor follows the branch.
+  auto [if_index, true_index, false_index] = linearize(0u, 0u);
+  EXPECT_EQ(if_index + 1, false_index);
+  EXPECT_GT(true_index, false_index);
+
+  // The more likely successor follows the branch.
+  std::tie(if_index, true_index, false_index) = linearize(1000u, 10u);
+  EXPECT_EQ(if_index + 1, true_index);
+  EXPECT_GT(false_index, true_index);
+
+  std::tie(if_index, true_index, false_index) = linearize(10u, 100u);
+  EXPECT_EQ(if_index + 1, false_index);
+  EXPECT_GT(true_index, false_index);
+}
+
 }  // namespace art
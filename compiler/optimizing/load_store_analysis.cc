@@ -149,6 +149,38 @@ bool HeapLocationCollector::InstructionEligibleForLSERemoval(HInstruction* inst)
   }
 }
 
+const HBasicBlock* ReferenceInfo::FindLoopAllocationBlock() const {
+  const HBasicBlock* allocation_block = reference_->GetBlock();
+  HGraph* graph = allocation_block->GetGraph();
+  if (!allocation_block->IsInLoop() || graph->HasIrreducibleLoops()) {
+    return nullptr;
+  }
+  ScopedArenaAllocator saa(graph->GetArenaStack());
+  ArenaBitVector seen_instructions(&saa, graph->GetCurrentInstructionId(), false, kArenaAllocLSA);
+  ScopedArenaVector<const HInstruction*> aliases(saa.Adapter(kArenaAllocLSA));
+  aliases.push_back(reference_);
+  while (!aliases.empty()) {
+    const HInstruction* alias = aliases.back();
+    aliases.pop_back();
+    for (const HUseListNode<HInstruction*>& use : alias->GetUses()) {
+      const HInstruction* user = use.GetUser();
+      if (!(user->IsPhi() || user->IsSelect()) || seen_instructions.IsBitSet(user->GetId())) {
+        continue;
+      }
+      const HBasicBlock* user_block = user->GetBlock();
+      if (user->IsPhi() &&
+          user_block->IsLoopHeader() &&
+          user_block->GetLoopInformation()->Contains(*allocation_block)) {
+        // The object can be live across iterations.
+        return nullptr;
+      }
+      seen_instructions.SetBit(user->GetId());
+      aliases.push_back(user);
+    }
+  }
+  return allocation_block;
+}
+
 void ReferenceInfo::CollectPartialEscapes(HGraph* graph) {
   ScopedArenaAllocator saa(graph->GetArenaStack());
   ArenaBitVector seen_instructions(&saa, graph->GetCurrentInstructionId(), false, kArenaAllocLSA);
@@ -57,8 +57,9 @@ class ReferenceInfo : public DeletableArenaObject<kArenaAllocLSA> {
     bool can_be_partial = elimination_type != LoadStoreAnalysisType::kBasic &&
                           (/* reference_->IsNewArray() || */ reference_->IsNewInstance());
     if (can_be_partial) {
-      subgraph_.reset(
-          new (allocator) ExecutionSubgraph(reference->GetBlock()->GetGraph(), allocator));
+      const HBasicBlock* loop_allocation_block = FindLoopAllocationBlock();
+      subgraph_.reset(new (allocator) ExecutionSubgraph(
+          reference->GetBlock()->GetGraph(), allocator, loop_allocation_block));
       CollectPartialEscapes(reference_->GetBlock()->GetGraph());
     }
     CalculateEscape(reference_,
@@ -125,6 +126,11 @@ class ReferenceInfo : public DeletableArenaObject<kArenaAllocLSA> {
   }
 
  private:
+  // Returns the block of reference_ if it is allocated in a loop and no value of
+  // it can reach a header of that loop through a back-edge. Partial escapes
+  // can then be tracked relative to the allocation (see ExecutionSubgraph).
+  // Returns null otherwise.
+  const HBasicBlock* FindLoopAllocationBlock() const;
   void CollectPartialEscapes(HGraph* graph);
   void HandleEscape(HBasicBlock* escape) {
     DCHECK(subgraph_ != nullptr);
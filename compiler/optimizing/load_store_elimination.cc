@@ -1184,6 +1184,11 @@ class LSEVisitor final : private HGraphDelegateVisitor {
           heap_location_collector_.GetHeapLocation(i)->GetReferenceInfo()->GetReference();
       size_t offset = heap_location_collector_.GetHeapLocation(i)->GetOffset();
       if (ref == new_instance) {
+        if (!ref_info->IsSingleton() && ref_info->IsPartialSingleton()) {
+          // When allocating in a loop the stores reaching here are to the object
+          // of a previous iteration which may have escaped.
+          KeepStores(heap_values[i].stored_by);
+        }
         if (offset >= mirror::kObjectHeaderSize ||
             MemberOffset(offset) == mirror::Object::MonitorOffset()) {
           // Instance fields except the header fields are set to default heap values.
@@ -3087,22 +3092,20 @@ class PartialLoadStoreEliminationHelper {
       if (blk->IsExitBlock()) {
         return;
       } else if (blk->IsLoopHeader()) {
-        // See comment in execution_subgraph.h. Currently we act as though every
-        // allocation for partial elimination takes place in the entry block.
-        // This simplifies the analysis by making it so any escape cohort
-        // expands to contain any loops it is a part of. This is something that
-        // we should rectify at some point. In either case however we can still
-        // special case the loop-header since (1) currently the loop can't have
-        // any merges between different cohort entries since the pre-header will
-        // be the earliest place entry can happen and (2) even if the analysis
-        // is improved to consider lifetime of the object WRT loops any values
-        // which would require loop-phis would have to make the whole loop
-        // escape anyway.
+        // See comment in execution_subgraph.h. Unless the object is allocated
+        // inside this loop we act as though the allocation takes place in the
+        // entry block so any escape cohort expands to contain any loops it is a
+        // part of. This means (1) the loop can't have any merges between
+        // different cohort entries since the pre-header will be the earliest
+        // place entry can happen and (2) any values which would require
+        // loop-phis make the whole loop escape anyway. If the object is
+        // allocated inside the loop it never flows around the back-edge (see
+        // ReferenceInfo::FindLoopAllocationBlock) so the value in the header is
+        // dead and the allocation block itself is materialized as null by
+        // BeforeAllEscapes.
         // This all means we can always use value from the pre-header when the
         // block is the loop-header and we didn't already create a
-        // materialization block. (NB when we do improve the analysis we will
-        // need to modify the materialization creation code to deal with this
-        // correctly.)
+        // materialization block.
         HInstruction* pre_header_val =
             GetMaterialization(blk->GetLoopInformation()->GetPreHeader());
         AddMaterialization(blk, pre_header_val);
@@ -8245,6 +8245,132 @@ TEST_F(LoadStoreEliminationTest, PartialIrreducibleLoop) {
   EXPECT_INS_EQ(pred_get->GetTarget()->InputAt(1), mat);
 }
 
+// // ENTRY
+// while (test()) {
+//   obj = new Obj();
+//   obj.foo = 11;
+//   if (param) {
+//     // LEFT
+//     escape(obj);
+//   } else {
+//     // RIGHT
+//   }
+//   // LOOP_MERGE
+//   // predicated-ELIMINATE
+//   use(obj.foo);
+// }
+// // BRETURN
+// return;
+TEST_F(LoadStoreEliminationTest, PartialAllocationInLoop) {
+  ScopedObjectAccess soa(Thread::Current());
+  VariableSizedHandleScope vshs(soa.Self());
+  CreateGraph(/*handles=*/&vshs);
+  AdjacencyListGraph blks(SetupFromAdjacencyList("entry",
+                                                 "exit",
+                                                 {{"entry", "loop_pre_header"},
+                                                  {"loop_pre_header", "loop_header"},
+                                                  {"loop_header", "loop_body"},
+                                                  {"loop_header", "breturn"},
+                                                  {"loop_body", "left"},
+                                                  {"loop_body", "right"},
+                                                  {"left", "loop_merge"},
+                                                  {"right", "loop_merge"},
+                                                  {"loop_merge", "loop_header"},
+                                                  {"breturn", "exit"}}));
+#define GET_BLOCK(name) HBasicBlock* name = blks.Get(#name)
+  GET_BLOCK(entry);
+  GET_BLOCK(exit);
+  GET_BLOCK(breturn);
+  GET_BLOCK(loop_pre_header);
+  GET_BLOCK(loop_header);
+  GET_BLOCK(loop_body);
+  GET_BLOCK(left);
+  GET_BLOCK(right);
+  GET_BLOCK(loop_merge);
+#undef GET_BLOCK
+  EnsurePredecessorOrder(loop_header, {loop_pre_header, loop_merge});
+  EnsurePredecessorOrder(loop_merge, {left, right});
+  HInstruction* bool_value = MakeParam(DataType::Type::kBool);
+  HInstruction* c11 = graph_->GetIntConstant(11);
+
+  HInstruction* cls = MakeClassLoad();
+  HInstruction* entry_goto = new (GetAllocator()) HGoto();
+  entry->AddInstruction(cls);
+  entry->AddInstruction(entry_goto);
+  ManuallyBuildEnvFor(cls, {});
+
+  loop_pre_header->AddInstruction(new (GetAllocator()) HGoto());
+
+  HInstruction* suspend_check_header = new (GetAllocator()) HSuspendCheck();
+  HInstruction* call_header = MakeInvoke(DataType::Type::kBool, {});
+  HInstruction* if_header = new (GetAllocator()) HIf(call_header);
+  loop_header->AddInstruction(suspend_check_header);
+  loop_header->AddInstruction(call_header);
+  loop_header->AddInstruction(if_header);
+  suspend_check_header->CopyEnvironmentFrom(cls->GetEnvironment());
+  call_header->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  HInstruction* new_inst = MakeNewInstance(cls);
+  HInstruction* write_body = MakeIFieldSet(new_inst, c11, MemberOffset(32));
+  HInstruction* if_body = new (GetAllocator()) HIf(bool_value);
+  loop_body->AddInstruction(new_inst);
+  loop_body->AddInstruction(write_body);
+  loop_body->AddInstruction(if_body);
+  new_inst->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  HInstruction* call_left = MakeInvoke(DataType::Type::kVoid, { new_inst });
+  HInstruction* goto_left = new (GetAllocator()) HGoto();
+  left->AddInstruction(call_left);
+  left->AddInstruction(goto_left);
+  call_left->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  right->AddInstruction(new (GetAllocator()) HGoto());
+
+  HInstruction* read_merge = MakeIFieldGet(new_inst, DataType::Type::kInt32, MemberOffset(32));
+  HInstruction* call_merge = MakeInvoke(DataType::Type::kVoid, { read_merge });
+  HInstruction* goto_merge = new (GetAllocator()) HGoto();
+  loop_merge->AddInstruction(read_merge);
+  loop_merge->AddInstruction(call_merge);
+  loop_merge->AddInstruction(goto_merge);
+  call_merge->CopyEnvironmentFrom(cls->GetEnvironment());
+
+  breturn->AddInstruction(new (GetAllocator()) HReturnVoid());
+
+  SetupExit(exit);
+
+  // PerformLSE expects this to be empty.
+  graph_->ClearDominanceInformation();
+  LOG(INFO) << "Pre LSE " << blks;
+  PerformLSEWithPartial();
+  LOG(INFO) << "Post LSE " << blks;
+
+  // The allocation is only done on the escaping path of each iteration.
+  EXPECT_INS_REMOVED(new_inst);
+  EXPECT_INS_REMOVED(write_body);
+  EXPECT_INS_REMOVED(read_merge);
+  EXPECT_INS_RETAINED(call_left);
+  HNewInstance* moved_new_inst = nullptr;
+  HInstanceFieldSet* moved_set = nullptr;
+  std::tie(moved_new_inst, moved_set) =
+      FindSingleInstructions<HNewInstance, HInstanceFieldSet>(graph_, left->GetSinglePredecessor());
+  ASSERT_NE(moved_new_inst, nullptr);
+  ASSERT_NE(moved_set, nullptr);
+  EXPECT_INS_EQ(moved_set->InputAt(0), moved_new_inst);
+  EXPECT_INS_EQ(moved_set->InputAt(1), c11);
+  EXPECT_INS_EQ(call_left->InputAt(0), moved_new_inst);
+
+  HPredicatedInstanceFieldGet* pred_get =
+      FindSingleInstruction<HPredicatedInstanceFieldGet>(graph_, loop_merge);
+  ASSERT_NE(pred_get, nullptr);
+  EXPECT_INS_EQ(call_merge->InputAt(0), pred_get);
+  ASSERT_TRUE(pred_get->GetTarget()->IsPhi()) << pred_get->DumpWithArgs();
+  EXPECT_INS_EQ(pred_get->GetTarget()->InputAt(0), moved_new_inst);
+  EXPECT_INS_EQ(pred_get->GetTarget()->InputAt(1), graph_->GetNullConstant());
+  ASSERT_TRUE(pred_get->GetDefaultValue()->IsPhi()) << pred_get->DumpWithArgs();
+  EXPECT_INS_EQ(pred_get->GetDefaultValue()->InputAt(0), graph_->GetIntConstant(0));
+  EXPECT_INS_EQ(pred_get->GetDefaultValue()->InputAt(1), c11);
+}
+
 enum class UsesOrder { kDefaultOrder, kReverseOrder };
 std::ostream& operator<<(std::ostream& os, const UsesOrder& ord) {
   switch (ord) {
@@ -19,9 +19,11 @@
 #include "arch/arm/instruction_set_features_arm.h"
 #include "arch/arm64/instruction_set_features_arm64.h"
 #include "arch/instruction_set.h"
+#include "arch/loongarch64/instruction_set_features_loongarch64.h"
 #include "arch/x86/instruction_set_features_x86.h"
 #include "arch/x86_64/instruction_set_features_x86_64.h"
 #include "code_generator.h"
+#include "common_dominator.h"
 #include "driver/compiler_options.h"
 #include "linear_order.h"
 #include "mirror/array-inl.h"
@@ -82,6 +84,24 @@ static bool IsEarlyExit(HLoopInformation* loop_info) {
   return false;
 }
 
+// Detect a branch inside the loop-body on a loop-invariant condition.
+static HIf* FindLoopInvariantBranch(HLoopInformation* loop_info) {
+  for (HBlocksInLoopIterator it(*loop_info); !it.Done(); it.Advance()) {
+    HIf* hif = it.Current()->GetLastInstruction()->AsIf();
+    if (hif == nullptr) {
+      continue;
+    }
+    HInstruction* condition = hif->InputAt(0);
+    if (!condition->IsConstant() &&
+        !loop_info->Contains(*condition->GetBlock()) &&
+        loop_info->Contains(*hif->IfTrueSuccessor()) &&
+        loop_info->Contains(*hif->IfFalseSuccessor())) {
+      return hif;
+    }
+  }
+  return nullptr;
+}
+
 // Forward declaration.
 static bool IsZeroExtensionAndGet(HInstruction* instruction,
                                   DataType::Type type,
@@ -473,13 +493,15 @@ HLoopOptimization::HLoopOptimization(HGraph* graph,
       iset_(nullptr),
       reductions_(nullptr),
       simplified_(false),
+      loop_nest_unswitchings_(0),
       predicated_vectorization_mode_(codegen.SupportsPredicatedSIMD()),
       vector_length_(0),
       vector_refs_(nullptr),
       vector_static_peeling_factor_(0),
       vector_dynamic_peeling_candidate_(nullptr),
-      vector_runtime_test_a_(nullptr),
-      vector_runtime_test_b_(nullptr),
+      vector_runtime_test_a_(),
+      vector_runtime_test_b_(),
+      vector_num_runtime_tests_(0),
       vector_map_(nullptr),
       vector_permanent_map_(nullptr),
       vector_mode_(kSequential),
@@ -612,6 +634,10 @@ void HLoopOptimization::RemoveLoop(LoopNode* node) {
 bool HLoopOptimization::TraverseLoopsInnerToOuter(LoopNode* node) {
   bool changed = false;
   for ( ; node != nullptr; node = node->next) {
+    if (node->outer == nullptr && !node->is_unswitched_copy) {
+      // A new top-level loop nest.
+      loop_nest_unswitchings_ = 0;
+    }
     // Visit inner loops first. Recompute induction information for this
     // loop if the induction of any inner loop has changed.
     if (TraverseLoopsInnerToOuter(node->inner)) {
@@ -620,13 +646,21 @@ bool HLoopOptimization::TraverseLoopsInnerToOuter(LoopNode* node) {
     }
     // Repeat simplifications in the loop-body until no more changes occur.
     // Note that since each simplification consists of eliminating code (without
-    // introducing new code), this process is always finite.
+    // introducing new code), this process is always finite. Unswitching an inner
+    // loop leaves a constant branch behind, so simplification is repeated after it;
+    // every unswitching removes one loop-invariant branch and the number of unswitchings
+    // per loop nest is bounded, which keeps this finite.
+    bool unswitched = false;
     do {
-      simplified_ = false;
-      SimplifyInduction(node);
-      SimplifyBlocks(node);
-      changed = simplified_ || changed;
-    } while (simplified_);
+      do {
+        simplified_ = false;
+        SimplifyInduction(node);
+        SimplifyBlocks(node);
+        changed = simplified_ || changed;
+      } while (simplified_);
+      unswitched = node->inner == nullptr && TryLoopUnswitching(node);
+      changed = unswitched || changed;
+    } while (unswitched);
     // Optimize inner loop.
     if (node->inner == nullptr) {
       changed = OptimizeInnerLoop(node) || changed;
@@ -674,7 +708,9 @@ void HLoopOptimization::SimplifyBlocks(LoopNode* node) {
     RemoveDeadInstructions(block->GetPhis());
     RemoveDeadInstructions(block->GetInstructions());
     // Remove trivial control flow blocks from the loop-body.
-    if (block->GetPredecessors().size() == 1 &&
+    if (TryRemoveDeadBranch(node, block)) {
+      simplified_ = true;
+    } else if (block->GetPredecessors().size() == 1 &&
         block->GetSuccessors().size() == 1 &&
         block->GetSingleSuccessor()->GetPredecessors().size() == 1) {
       simplified_ = true;
@@ -703,6 +739,41 @@ void HLoopOptimization::SimplifyBlocks(LoopNode* node) {
   }
 }
 
+bool HLoopOptimization::TryRemoveDeadBranch(LoopNode* node, HBasicBlock* block) {
+  HIf* hif = block->GetLastInstruction()->AsIf();
+  if (hif == nullptr || !hif->InputAt(0)->IsIntConstant()) {
+    return false;
+  }
+  HBasicBlock* dead = hif->InputAt(0)->AsIntConstant()->IsTrue()
+      ? hif->IfFalseSuccessor()
+      : hif->IfTrueSuccessor();
+  // Only remove a single block that merges back into the loop-body, which keeps
+  // the dominator update local.
+  HLoopInformation* loop_info = node->loop_info;
+  if (dead->GetPredecessors().size() != 1 ||
+      dead->GetSuccessors().size() != 1 ||
+      !dead->GetDominatedBlocks().empty() ||
+      loop_info->IsBackEdge(*dead) ||
+      !loop_info->Contains(*dead->GetSingleSuccessor())) {
+    return false;
+  }
+  HBasicBlock* meet = dead->GetSingleSuccessor();
+  dead->DisconnectAndDelete();  // replaces the HIf with an HGoto
+  if (meet->GetDominator() == block) {
+    CommonDominator finder(meet->GetPredecessors()[0]);
+    for (HBasicBlock* predecessor : meet->GetPredecessors()) {
+      finder.Update(predecessor);
+    }
+    HBasicBlock* dominator = finder.Get();
+    if (dominator != block) {
+      block->RemoveDominatedBlock(meet);
+      dominator->AddDominatedBlock(meet);
+      meet->SetDominator(dominator);
+    }
+  }
+  return true;
+}
+
 bool HLoopOptimization::TryOptimizeInnerLoopFinite(LoopNode* node) {
   HBasicBlock* header = node->loop_info->GetHeader();
   HBasicBlock* preheader = node->loop_info->GetPreHeader();
@@ -912,6 +983,79 @@ bool HLoopOptimization::TryPeelingAndUnrolling(LoopNode* node) {
          TryUnrollingForBranchPenaltyReduction(&analysis_info);
 }
 
+bool HLoopOptimization::TryLoopUnswitching(LoopNode* node) {
+  HLoopInformation* loop_info = node->loop_info;
+  // Unswitching duplicates the loop like peeling does, so it shares its heuristics. The number
+  // of unswitchings per loop nest is bounded on top of that.
+  if (!arch_loop_helper_->IsLoopPeelingEnabled() ||
+      loop_nest_unswitchings_ == kMaxUnswitchingsPerLoopNest) {
+    return false;
+  }
+  HIf* hif = FindLoopInvariantBranch(loop_info);
+  if (hif == nullptr) {
+    return false;
+  }
+
+  int64_t trip_count = LoopAnalysis::GetLoopTripCount(loop_info, &induction_range_);
+  LoopAnalysisInfo analysis_info(loop_info);
+  LoopAnalysis::CalculateLoopBasicProperties(loop_info, &analysis_info, trip_count);
+  if (analysis_info.HasInstructionsPreventingScalarOpts() ||
+      arch_loop_helper_->IsLoopNonBeneficialForScalarOpts(&analysis_info)) {
+    return false;
+  }
+
+  // Run 'IsLoopClonable' the last as it might be time-consuming.
+  if (!LoopClonerHelper::IsLoopClonable(loop_info)) {
+    return false;
+  }
+
+  // Version the loop on the invariant condition:
+  //
+  //   for (..) {                   if (cond) {
+  //     if (cond) {                  for (..) { <then> }
+  //       <then>             =>    } else {
+  //     } else {                     for (..) { <else> }
+  //       <else>                   }
+  //     }
+  //   }
+  //
+  // The original loop keeps the true branch and the copy the false branch. The branches left
+  // inside the loops are on a constant and get removed by SimplifyBlocks().
+  HBasicBlock* preheader = loop_info->GetPreHeader();
+  HInstruction* condition = hif->InputAt(0);
+  LoopClonerSimpleHelper helper(loop_info, &induction_range_);
+  helper.DoVersioning();
+  HInstruction* copy_hif = helper.GetInstructionMap()->Get(hif);
+  hif->ReplaceInput(graph_->GetIntConstant(1), 0u);
+  copy_hif->ReplaceInput(graph_->GetIntConstant(0), 0u);
+
+  // The old preheader now jumps to both loops, the original one being its first successor.
+  DCHECK_EQ(preheader->GetSuccessors().size(), 2u);
+  DCHECK(preheader->GetSuccessors()[0]->Dominates(loop_info->GetHeader()));
+  preheader->ReplaceAndRemoveInstructionWith(preheader->GetLastInstruction(),
+                                             new (global_allocator_) HIf(condition));
+
+  // Analyze the induction of both loops and add the copy to the loop hierarchy,
+  // so that it is simplified and optimized when the traversal reaches it.
+  HLoopInformation* copy_loop_info =
+      helper.GetBasicBlockMap()->Get(loop_info->GetHeader())->GetLoopInformation();
+  induction_range_.ReVisit(loop_info);
+  induction_range_.ReVisit(copy_loop_info);
+  LoopNode* copy_node = new (loop_allocator_) LoopNode(copy_loop_info);
+  copy_node->is_unswitched_copy = true;
+  copy_node->outer = node->outer;
+  copy_node->previous = node;
+  copy_node->next = node->next;
+  if (node->next != nullptr) {
+    node->next->previous = copy_node;
+  }
+  node->next = copy_node;
+  ++loop_nest_unswitchings_;
+
+  MaybeRecordStat(stats_, MethodCompilationStat::kLoopUnswitched);
+  return true;
+}
+
 //
 // Loop vectorization. The implementation is based on the book by Aart J.C. Bik:
 // "The Software Vectorization Handbook. Applying Multimedia Extensions for Maximum Performance."
@@ -924,8 +1068,7 @@ bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int6
   vector_refs_->clear();
   vector_static_peeling_factor_ = 0;
   vector_dynamic_peeling_candidate_ = nullptr;
-  vector_runtime_test_a_ =
-  vector_runtime_test_b_ = nullptr;
+  vector_num_runtime_tests_ = 0;
 
   // Phis in the loop-body prevent vectorization.
   if (!block->GetPhis().IsEmpty()) {
@@ -984,16 +1127,14 @@ bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int6
           // Found a[i+x] vs. b[i+y]. Accept if x == y (at worst loop-independent data dependence).
           // Conservatively assume a potential loop-carried data dependence otherwise, avoided by
           // generating an explicit a != b disambiguation runtime test on the two references.
-          if (x != y) {
-            // To avoid excessive overhead, we only accept one a != b test.
-            if (vector_runtime_test_a_ == nullptr) {
-              // First test found.
-              vector_runtime_test_a_ = a;
-              vector_runtime_test_b_ = b;
-            } else if ((vector_runtime_test_a_ != a || vector_runtime_test_b_ != b) &&
-                       (vector_runtime_test_a_ != b || vector_runtime_test_b_ != a)) {
-              return false;  // second test would be needed
+          if (x != y && !HasVectorRuntimeTest(a, b)) {
+            // To avoid excessive overhead, we only accept a few a != b tests.
+            if (vector_num_runtime_tests_ == kMaxVectorRuntimeTests) {
+              return false;  // too many tests would be needed
             }
+            vector_runtime_test_a_[vector_num_runtime_tests_] = a;
+            vector_runtime_test_b_[vector_num_runtime_tests_] = b;
+            ++vector_num_runtime_tests_;
           }
         }
       }
@@ -1127,12 +1268,13 @@ void HLoopOptimization::Vectorize(LoopNode* node,
   }
   vector_index_ = graph_->GetConstant(induc_type, 0);
 
-  // Generate runtime disambiguation test:
+  // Generate runtime disambiguation tests, running all iterations in the cleanup
+  // loop if any of the tests fails:
   // vtc = a != b ? vtc : 0;
-  if (vector_runtime_test_a_ != nullptr) {
+  for (size_t i = 0; i < vector_num_runtime_tests_; ++i) {
     HInstruction* rt = Insert(
         preheader,
-        new (global_allocator_) HNotEqual(vector_runtime_test_a_, vector_runtime_test_b_));
+        new (global_allocator_) HNotEqual(vector_runtime_test_a_[i], vector_runtime_test_b_[i]));
     vtc = Insert(preheader,
                  new (global_allocator_)
                  HSelect(rt, vtc, graph_->GetConstant(induc_type, 0), kNoDexPc));
@@ -1175,7 +1317,7 @@ void HLoopOptimization::Vectorize(LoopNode* node,
   // for ( ; i < stc; i += 1)
   //    <loop-body>
   if (needs_cleanup) {
-    DCHECK(!IsInPredicatedVectorizationMode() || vector_runtime_test_a_ != nullptr);
+    DCHECK(!IsInPredicatedVectorizationMode() || vector_num_runtime_tests_ != 0);
     vector_mode_ = kSequential;
     GenerateNewLoop(node,
                     block,
@@ -1725,6 +1867,36 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
         }  // switch type
       }
       return false;
+    case InstructionSet::kLoongarch64:
+      // Allow vectorization for LSX-enabled LOONGARCH64 devices only (128-bit SIMD).
+      if (features->AsLoongarch64InstructionSetFeatures()->HasLsx()) {
+        switch (type) {
+          case DataType::Type::kBool:
+          case DataType::Type::kUint8:
+          case DataType::Type::kInt8:
+            *restrictions |= kNoDiv;
+            return TrySetVectorLength(type, 16);
+          case DataType::Type::kUint16:
+          case DataType::Type::kInt16:
+            *restrictions |= kNoDiv;
+            return TrySetVectorLength(type, 8);
+          case DataType::Type::kInt32:
+            *restrictions |= kNoDiv;
+            return TrySetVectorLength(type, 4);
+          case DataType::Type::kInt64:
+            *restrictions |= kNoDiv;
+            return TrySetVectorLength(type, 2);
+          case DataType::Type::kFloat32:
+            *restrictions |= kNoReduction;
+            return TrySetVectorLength(type, 4);
+          case DataType::Type::kFloat64:
+            *restrictions |= kNoReduction;
+            return TrySetVectorLength(type, 2);
+          default:
+            break;
+        }  // switch type
+      }
+      return false;
     default:
       return false;
   }  // switch instruction set
@@ -2345,6 +2517,16 @@ bool HLoopOptimization::IsVectorizationProfitable(int64_t trip_count) {
   return true;
 }
 
+bool HLoopOptimization::HasVectorRuntimeTest(HInstruction* a, HInstruction* b) const {
+  for (size_t i = 0; i < vector_num_runtime_tests_; ++i) {
+    if ((vector_runtime_test_a_[i] == a && vector_runtime_test_b_[i] == b) ||
+        (vector_runtime_test_a_[i] == b && vector_runtime_test_b_[i] == a)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 //
 // Helpers.
 //
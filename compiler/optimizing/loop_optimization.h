@@ -57,12 +57,16 @@ class HLoopOptimization : public HOptimization {
           outer(nullptr),
           inner(nullptr),
           previous(nullptr),
-          next(nullptr) {}
+          next(nullptr),
+          is_unswitched_copy(false) {}
     HLoopInformation* loop_info;
     LoopNode* outer;
     LoopNode* inner;
     LoopNode* previous;
     LoopNode* next;
+    // Whether the loop is a copy made by loop unswitching. A top-level copy shares the
+    // unswitching budget of the loop nest it was copied from.
+    bool is_unswitched_copy;
   };
 
   /*
@@ -138,6 +142,10 @@ class HLoopOptimization : public HOptimization {
   void SimplifyInduction(LoopNode* node);
   void SimplifyBlocks(LoopNode* node);
 
+  // Removes the never taken branch of an HIf on a constant in the loop-body, as left behind by
+  // loop unswitching. Returns true if anything changed.
+  bool TryRemoveDeadBranch(LoopNode* node, HBasicBlock* block);
+
   // Performs optimizations specific to inner loop with finite header logic (empty loop removal,
   // unrolling, vectorization). Returns true if anything changed.
   bool TryOptimizeInnerLoopFinite(LoopNode* node);
@@ -166,6 +174,11 @@ class HLoopOptimization : public HOptimization {
   // Tries to apply scalar loop peeling and unrolling.
   bool TryPeelingAndUnrolling(LoopNode* node);
 
+  // Tries to move a branch on a loop-invariant condition out of the loop by versioning the loop
+  // on that condition. The copy is added to the loop hierarchy right after the original loop.
+  // Returns whether transformation happened.
+  bool TryLoopUnswitching(LoopNode* node);
+
   //
   // Vectorization analysis and synthesis.
   //
@@ -242,6 +255,7 @@ class HLoopOptimization : public HOptimization {
                             const ArrayReference* peeling_candidate);
   uint32_t MaxNumberPeeled();
   bool IsVectorizationProfitable(int64_t trip_count);
+  bool HasVectorRuntimeTest(HInstruction* a, HInstruction* b) const;
 
   //
   // Helpers.
@@ -308,6 +322,11 @@ class HLoopOptimization : public HOptimization {
   // Flag that tracks if any simplifications have occurred.
   bool simplified_;
 
+  // Number of loop unswitchings in the current top-level loop nest. Every unswitching duplicates
+  // a loop, so a loop with k invariant branches would otherwise end up in 2^k versions.
+  static constexpr uint32_t kMaxUnswitchingsPerLoopNest = 3;
+  uint32_t loop_nest_unswitchings_;
+
   // Whether to use predicated loop vectorization (e.g. for arm64 SVE target).
   bool predicated_vectorization_mode_;
 
@@ -322,9 +341,12 @@ class HLoopOptimization : public HOptimization {
   uint32_t vector_static_peeling_factor_;
   const ArrayReference* vector_dynamic_peeling_candidate_;
 
-  // Dynamic data dependence test of the form a != b.
-  HInstruction* vector_runtime_test_a_;
-  HInstruction* vector_runtime_test_b_;
+  // Dynamic data dependence tests of the form a != b, which must all hold for the vector loop
+  // to run.
+  static constexpr size_t kMaxVectorRuntimeTests = 4;
+  HInstruction* vector_runtime_test_a_[kMaxVectorRuntimeTests];
+  HInstruction* vector_runtime_test_b_[kMaxVectorRuntimeTests];
+  size_t vector_num_runtime_tests_;
 
   // Mapping used during vectorization synthesis for both the scalar peeling/cleanup
   // loop (mode is kSequential) and the actual vector loop (mode is kVector). The data
@@ -90,6 +90,31 @@ class LoopOptimizationTest : public OptimizingUnitTest {
     return header;
   }
 
+  /** Turns the body of the loop with the given header into a diamond on condition. */
+  void AddDiamond(HBasicBlock* header, HInstruction* condition, HInstruction* array) {
+    HBasicBlock* body = header->GetSuccessors()[0];
+    HBasicBlock* if_true = new (GetAllocator()) HBasicBlock(graph_);
+    HBasicBlock* if_false = new (GetAllocator()) HBasicBlock(graph_);
+    HBasicBlock* join = new (GetAllocator()) HBasicBlock(graph_);
+    graph_->AddBlock(if_true);
+    graph_->AddBlock(if_false);
+    graph_->AddBlock(join);
+    header->ReplacePredecessor(body, join);
+    body->AddSuccessor(if_true);
+    body->AddSuccessor(if_false);
+    if_true->AddSuccessor(join);
+    if_false->AddSuccessor(join);
+    body->ReplaceAndRemoveInstructionWith(body->GetLastInstruction(),
+                                          new (GetAllocator()) HIf(condition));
+    if_true->AddInstruction(new (GetAllocator()) HArraySet(
+        array, graph_->GetIntConstant(0), graph_->GetIntConstant(1), DataType::Type::kInt32, 0));
+    if_true->AddInstruction(new (GetAllocator()) HGoto());
+    if_false->AddInstruction(new (GetAllocator()) HArraySet(
+        array, graph_->GetIntConstant(0), graph_->GetIntConstant(2), DataType::Type::kInt32, 0));
+    if_false->AddInstruction(new (GetAllocator()) HGoto());
+    join->AddInstruction(new (GetAllocator()) HGoto());
+  }
+
   /** Performs analysis. */
   void PerformAnalysis() {
     graph_->BuildDominatorTree();
@@ -336,4 +361,66 @@ TEST_F(LoopOptimizationTest, SimplifyLoopSinglePreheader) {
   EXPECT_EQ(header_phi->InputAt(1), body_add);
 }
 
+// Checks that a branch on a loop-invariant condition is moved out of the loop by
+// versioning the loop, and that the constant branches left behind are removed.
+TEST_F(LoopOptimizationTest, LoopUnswitching) {
+  HInstruction* array = new (GetAllocator()) HParameterValue(graph_->GetDexFile(),
+                                                             dex::TypeIndex(0),
+                                                             1,
+                                                             DataType::Type::kReference);
+  HInstruction* condition = new (GetAllocator()) HParameterValue(graph_->GetDexFile(),
+                                                                 dex::TypeIndex(0),
+                                                                 2,
+                                                                 DataType::Type::kBool);
+  entry_block_->AddInstruction(array);
+  entry_block_->AddInstruction(condition);
+
+  // Turn the loop-body into a diamond on the invariant condition.
+  HBasicBlock* header = AddLoop(entry_block_, return_block_);
+  AddDiamond(header, condition, array);
+
+  PerformAnalysis();
+  EXPECT_EQ("[][]", LoopStructure());
+
+  // The only remaining branch on the condition selects between the two loops.
+  ASSERT_TRUE(condition->HasOnlyOneNonEnvironmentUse());
+  HInstruction* hif = condition->GetUses().front().GetUser();
+  EXPECT_TRUE(hif->IsIf());
+  EXPECT_FALSE(hif->GetBlock()->IsInLoop());
+}
+
+// Check that loop unswitching stops once the loop nest used up its budget.
+TEST_F(LoopOptimizationTest, LoopUnswitchingBudgetPerLoopNest) {
+  HInstruction* array = new (GetAllocator()) HParameterValue(graph_->GetDexFile(),
+                                                             dex::TypeIndex(0),
+                                                             1,
+                                                             DataType::Type::kReference);
+  HInstruction* condition = new (GetAllocator()) HParameterValue(graph_->GetDexFile(),
+                                                                 dex::TypeIndex(0),
+                                                                 2,
+                                                                 DataType::Type::kBool);
+  entry_block_->AddInstruction(array);
+  entry_block_->AddInstruction(condition);
+
+  // An outer loop with a sequence of inner loops, each with a diamond on the invariant
+  // condition. Each inner loop exits into a block of its own, which is the preheader of
+  // the next inner loop or the back edge of the outer loop.
+  HBasicBlock* outer = AddLoop(entry_block_, return_block_);
+  HBasicBlock* position = outer->GetSuccessors()[0];
+  // One more inner loop than the loop nest may unswitch.
+  for (int i = 0; i < 4; i++) {
+    HBasicBlock* inner = AddLoop(position, outer);
+    position = new (GetAllocator()) HBasicBlock(graph_);
+    graph_->AddBlock(position);
+    inner->ReplaceSuccessor(outer, position);
+    position->AddSuccessor(outer);
+    position->AddInstruction(new (GetAllocator()) HGoto());
+    AddDiamond(inner, condition, array);
+  }
+
+  PerformAnalysis();
+  // All inner loops but the last one were unswitched.
+  EXPECT_EQ("[[][][][][][][]]", LoopStructure());
+}
+
 }  // namespace art
@@ -2248,6 +2248,18 @@ bool HBasicBlock::IsSingleGoto() const {
   return HasOnlyOneInstruction(*this) && GetLastInstruction()->IsGoto();
 }
 
+bool HBasicBlock::IsColdByBranchProfile() const {
+  for (const HBasicBlock* block = this; block != nullptr; block = block->GetDominator()) {
+    if (block->GetPredecessors().size() == 1u) {
+      HInstruction* last = block->GetSinglePredecessor()->GetLastInstruction();
+      if (last->IsIf() && last->AsIf()->IsColdSuccessor(block)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool HBasicBlock::IsSingleReturn() const {
   return HasOnlyOneInstruction(*this) && GetLastInstruction()->IsReturn();
 }
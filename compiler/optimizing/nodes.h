@@ -75,6 +75,7 @@ class HTryBoundary;
 class FieldInfo;
 class LiveInterval;
 class LocationSummary;
+class ProfilingInfo;
 class SlowPathCode;
 class SsaBuilder;
 
@@ -420,6 +421,7 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         cached_double_constants_(std::less<int64_t>(), allocator->Adapter(kArenaAllocConstantsMap)),
         cached_current_method_(nullptr),
         art_method_(nullptr),
+        profiling_info_(nullptr),
         compilation_kind_(compilation_kind),
         cha_single_implementation_list_(allocator->Adapter(kArenaAllocCHA)) {
     blocks_.reserve(kDefaultNumberOfBlocks);
@@ -704,6 +706,9 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   ArtMethod* GetArtMethod() const { return art_method_; }
   void SetArtMethod(ArtMethod* method) { art_method_ = method; }
 
+  ProfilingInfo* GetProfilingInfo() const { return profiling_info_; }
+  void SetProfilingInfo(ProfilingInfo* info) { profiling_info_ = info; }
+
   // Returns an instruction with the opposite Boolean value from 'cond'.
   // The instruction has been inserted into the graph, either as a constant, or
   // before cursor.
@@ -870,6 +875,10 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // (such as when the superclass could not be found).
   ArtMethod* art_method_;
 
+  // The JIT profiling info of `art_method_`, if any. It is kept alive by the compiler for the
+  // duration of the compilation.
+  ProfilingInfo* profiling_info_;
+
   // How we are compiling the graph: either optimized, osr, or baseline.
   // For osr, we will make all loops seen as irreducible and emit special
   // stack maps to mark compiled code entries which the interpreter can
@@ -1130,6 +1139,10 @@ class HBasicBlock : public ArenaObject<kArenaAllocBasicBlock> {
   bool IsSingleReturnOrReturnVoidAllowingPhis() const;
   bool IsSingleTryBoundary() const;
 
+  // Returns whether the branch profile shows this block is (almost) never executed, that is
+  // whether it is dominated by a branch edge that was (almost) never taken.
+  bool IsColdByBranchProfile() const;
+
   // Returns true if this block emits nothing but a jump.
   bool IsSingleJump() const {
     HLoopInformation* loop_info = GetLoopInformation();
@@ -3414,7 +3427,9 @@ class HDoubleConstant final : public HConstant {
 class HIf final : public HExpression<1> {
  public:
   explicit HIf(HInstruction* input, uint32_t dex_pc = kNoDexPc)
-      : HExpression(kIf, SideEffects::None(), dex_pc) {
+      : HExpression(kIf, SideEffects::None(), dex_pc),
+        true_count_(0u),
+        false_count_(0u) {
     SetRawInputAt(0, input);
   }
 
@@ -3429,10 +3444,47 @@ class HIf final : public HExpression<1> {
     return GetBlock()->GetSuccessors()[1];
   }
 
+  // How many times baseline code took each successor, as recorded in the JIT profiling info.
+  // Both are zero when there is no profile for this branch.
+  uint16_t GetTrueCount() const { return true_count_; }
+  uint16_t GetFalseCount() const { return false_count_; }
+  bool HasBranchProfile() const { return true_count_ != 0u || false_count_ != 0u; }
+
+  void SetBranchProfile(uint16_t true_count, uint16_t false_count) {
+    true_count_ = true_count;
+    false_count_ = false_count;
+  }
+
+  // Must be called when the successors of the block are swapped.
+  void SwapBranchProfile() {
+    std::swap(true_count_, false_count_);
+  }
+
+  uint16_t GetCountOf(const HBasicBlock* successor) const {
+    DCHECK(successor == IfTrueSuccessor() || successor == IfFalseSuccessor());
+    return (successor == IfTrueSuccessor()) ? true_count_ : false_count_;
+  }
+
+  // Returns whether the profile shows the edge to `successor` was taken in less than
+  // 1/kColdBranchRatio of the executions of this branch.
+  bool IsColdSuccessor(const HBasicBlock* successor) const {
+    uint32_t total = static_cast<uint32_t>(true_count_) + false_count_;
+    return total >= kMinimumCountForColdBranch &&
+        static_cast<uint32_t>(GetCountOf(successor)) * kColdBranchRatio < total;
+  }
+
   DECLARE_INSTRUCTION(If);
 
  protected:
   DEFAULT_COPY_CONSTRUCTOR(If);
+
+ private:
+  // Below this number of recorded executions, the profile is not considered meaningful.
+  static constexpr uint32_t kMinimumCountForColdBranch = 128u;
+  static constexpr uint32_t kColdBranchRatio = 100u;
+
+  uint16_t true_count_;
+  uint16_t false_count_;
 };
 
 
@@ -6299,6 +6351,18 @@ class HPredicatedInstanceFieldGet final : public HExpression<2> {
   const FieldInfo field_info_;
 };
 
+// Whether a reference store marks the card of its holder. Refined by WriteBarrierElimination.
+enum class WriteBarrierKind {
+  // Mark the card unless the stored value is null.
+  kEmitWithNullCheck,
+  // Mark the card unconditionally. Used when the mark also covers later stores to the same holder.
+  kEmitNoNullCheck,
+  // Do not mark the card, it was already marked by an earlier store to the same holder.
+  kDontEmit,
+  kLast = kDontEmit
+};
+std::ostream& operator<<(std::ostream& os, WriteBarrierKind rhs);
+
 class HInstanceFieldSet final : public HExpression<2> {
  public:
   HInstanceFieldSet(HInstruction* object,
@@ -6323,6 +6387,7 @@ class HInstanceFieldSet final : public HExpression<2> {
                     dex_file) {
     SetPackedFlag<kFlagValueCanBeNull>(true);
     SetPackedFlag<kFlagIsPredicatedSet>(false);
+    SetPackedField<WriteBarrierKindField>(WriteBarrierKind::kEmitWithNullCheck);
     SetRawInputAt(0, object);
     SetRawInputAt(1, value);
   }
@@ -6343,6 +6408,10 @@ class HInstanceFieldSet final : public HExpression<2> {
   void ClearValueCanBeNull() { SetPackedFlag<kFlagValueCanBeNull>(false); }
   bool GetIsPredicatedSet() const { return GetPackedFlag<kFlagIsPredicatedSet>(); }
   void SetIsPredicatedSet(bool value = true) { SetPackedFlag<kFlagIsPredicatedSet>(value); }
+  WriteBarrierKind GetWriteBarrierKind() const { return GetPackedField<WriteBarrierKindField>(); }
+  void SetWriteBarrierKind(WriteBarrierKind kind) {
+    SetPackedField<WriteBarrierKindField>(kind);
+  }
 
   DECLARE_INSTRUCTION(InstanceFieldSet);
 
@@ -6352,9 +6421,15 @@ class HInstanceFieldSet final : public HExpression<2> {
  private:
   static constexpr size_t kFlagValueCanBeNull = kNumberOfGenericPackedBits;
   static constexpr size_t kFlagIsPredicatedSet = kFlagValueCanBeNull + 1;
-  static constexpr size_t kNumberOfInstanceFieldSetPackedBits = kFlagIsPredicatedSet + 1;
+  static constexpr size_t kFieldWriteBarrierKind = kFlagIsPredicatedSet + 1;
+  static constexpr size_t kFieldWriteBarrierKindSize =
+      MinimumBitsToStore(static_cast<size_t>(WriteBarrierKind::kLast));
+  static constexpr size_t kNumberOfInstanceFieldSetPackedBits =
+      kFieldWriteBarrierKind + kFieldWriteBarrierKindSize;
   static_assert(kNumberOfInstanceFieldSetPackedBits <= kMaxNumberOfPackedBits,
                 "Too many packed fields.");
+  using WriteBarrierKindField =
+      BitField<WriteBarrierKind, kFieldWriteBarrierKind, kFieldWriteBarrierKindSize>;
 
   const FieldInfo field_info_;
 };
@@ -7328,6 +7403,7 @@ class HStaticFieldSet final : public HExpression<2> {
                     declaring_class_def_index,
                     dex_file) {
     SetPackedFlag<kFlagValueCanBeNull>(true);
+    SetPackedField<WriteBarrierKindField>(WriteBarrierKind::kEmitWithNullCheck);
     SetRawInputAt(0, cls);
     SetRawInputAt(1, value);
   }
@@ -7342,6 +7418,10 @@ class HStaticFieldSet final : public HExpression<2> {
   HInstruction* GetValue() const { return InputAt(1); }
   bool GetValueCanBeNull() const { return GetPackedFlag<kFlagValueCanBeNull>(); }
   void ClearValueCanBeNull() { SetPackedFlag<kFlagValueCanBeNull>(false); }
+  WriteBarrierKind GetWriteBarrierKind() const { return GetPackedField<WriteBarrierKindField>(); }
+  void SetWriteBarrierKind(WriteBarrierKind kind) {
+    SetPackedField<WriteBarrierKindField>(kind);
+  }
 
   DECLARE_INSTRUCTION(StaticFieldSet);
 
@@ -7350,9 +7430,15 @@ class HStaticFieldSet final : public HExpression<2> {
 
  private:
   static constexpr size_t kFlagValueCanBeNull = kNumberOfGenericPackedBits;
-  static constexpr size_t kNumberOfStaticFieldSetPackedBits = kFlagValueCanBeNull + 1;
+  static constexpr size_t kFieldWriteBarrierKind = kFlagValueCanBeNull + 1;
+  static constexpr size_t kFieldWriteBarrierKindSize =
+      MinimumBitsToStore(static_cast<size_t>(WriteBarrierKind::kLast));
+  static constexpr size_t kNumberOfStaticFieldSetPackedBits =
+      kFieldWriteBarrierKind + kFieldWriteBarrierKindSize;
   static_assert(kNumberOfStaticFieldSetPackedBits <= kMaxNumberOfPackedBits,
                 "Too many packed fields.");
+  using WriteBarrierKindField =
+      BitField<WriteBarrierKind, kFieldWriteBarrierKind, kFieldWriteBarrierKindSize>;
 
   const FieldInfo field_info_;
 };
@@ -18,6 +18,7 @@
 
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <sstream>
 
 #include <stdint.h>
@@ -50,6 +51,7 @@
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
 #include "jit/jit_logger.h"
+#include "jit/profiling_info.h"
 #include "jni/quick/jni_compiler.h"
 #include "linker/linker_patch.h"
 #include "nodes.h"
@@ -460,6 +462,7 @@ bool OptimizingCompiler::CanCompileMethod(uint32_t method_idx ATTRIBUTE_UNUSED,
 static bool IsInstructionSetSupported(InstructionSet instruction_set) {
   return instruction_set == InstructionSet::kArm
       || instruction_set == InstructionSet::kArm64
+      || instruction_set == InstructionSet::kLoongarch64
       || instruction_set == InstructionSet::kThumb2
       || instruction_set == InstructionSet::kX86
       || instruction_set == InstructionSet::kX86_64;
@@ -563,6 +566,9 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
         OptDef(OptimizationPass::kInstructionSimplifierX86_64),
         OptDef(OptimizationPass::kSideEffectsAnalysis),
         OptDef(OptimizationPass::kGlobalValueNumbering, "GVN$after_arch"),
+        // Schedule before the memory operand generation, which relies on the order of
+        // instructions to fold array lengths into their bounds checks.
+        OptDef(OptimizationPass::kScheduling),
         OptDef(OptimizationPass::kX86MemoryOperandGeneration)
       };
       return RunOptimizations(graph,
@@ -571,6 +577,18 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
                               pass_observer,
                               x86_64_optimizations);
     }
+#endif
+#ifdef ART_ENABLE_CODEGEN_loongarch64
+    case InstructionSet::kLoongarch64: {
+      OptimizationDef loongarch64_optimizations[] = {
+        OptDef(OptimizationPass::kScheduling)
+      };
+      return RunOptimizations(graph,
+                              codegen,
+                              dex_compilation_unit,
+                              pass_observer,
+                              loongarch64_optimizations);
+    }
 #endif
     default:
       UNUSED(graph);
@@ -701,6 +719,17 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
                    optimizations);
 
   RunArchOptimizations(graph, codegen, dex_compilation_unit, pass_observer);
+
+  // Coalesce card marks after scheduling, which could otherwise move an instruction that
+  // triggers a GC between two stores sharing one card mark.
+  OptimizationDef final_optimizations[] = {
+    OptDef(OptimizationPass::kWriteBarrierElimination)
+  };
+  RunOptimizations(graph,
+                   codegen,
+                   dex_compilation_unit,
+                   pass_observer,
+                   final_optimizations);
 }
 
 static ArenaVector<linker::LinkerPatch> EmitAndSortLinkerPatches(CodeGenerator* codegen) {
@@ -822,6 +851,14 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
     graph->SetArtMethod(method);
   }
 
+  // Baseline code records the branch profile in the ProfilingInfo of the method, and the
+  // optimizing compiler lays out blocks following it.
+  std::optional<ScopedProfilingInfoUse> profiling_info_use;
+  if (compiler_options.IsJitCompiler() && method != nullptr) {
+    profiling_info_use.emplace(Runtime::Current()->GetJit(), method, Thread::Current());
+    graph->SetProfilingInfo(profiling_info_use->GetProfilingInfo());
+  }
+
   std::unique_ptr<CodeGenerator> codegen(
       CodeGenerator::Create(graph,
                             compiler_options,
@@ -21,6 +21,7 @@
 #include "base/scoped_arena_allocator.h"
 #include "base/scoped_arena_containers.h"
 #include "data_type-inl.h"
+#include "driver/compiler_options.h"
 #include "optimizing/load_store_analysis.h"
 #include "prepare_for_register_allocation.h"
 
@@ -32,6 +33,14 @@
 #include "scheduler_arm.h"
 #endif
 
+#ifdef ART_ENABLE_CODEGEN_loongarch64
+#include "scheduler_loongarch64.h"
+#endif
+
+#ifdef ART_ENABLE_CODEGEN_x86_64
+#include "scheduler_x86_64.h"
+#endif
+
 namespace art {
 
 void SchedulingGraph::AddDependency(SchedulingNode* node,
@@ -792,9 +801,15 @@ bool HScheduler::IsSchedulingBarrier(const HInstruction* instr) const {
       instr->IsSuspendCheck();
 }
 
+const InstructionSetFeatures* HInstructionScheduling::GetInstructionSetFeatures() const {
+  return (codegen_ != nullptr) ? codegen_->GetCompilerOptions().GetInstructionSetFeatures()
+                               : nullptr;
+}
+
 bool HInstructionScheduling::Run(bool only_optimize_loop_blocks,
                                  bool schedule_randomly) {
-#if defined(ART_ENABLE_CODEGEN_arm64) || defined(ART_ENABLE_CODEGEN_arm)
+#if defined(ART_ENABLE_CODEGEN_arm64) || defined(ART_ENABLE_CODEGEN_arm) || \
+    defined(ART_ENABLE_CODEGEN_loongarch64) || defined(ART_ENABLE_CODEGEN_x86_64)
   // Phase-local allocator that allocates scheduler internal data structures like
   // scheduling nodes, internel nodes map, dependencies, etc.
   CriticalPathSchedulingNodeSelector critical_path_selector;
@@ -827,6 +842,22 @@ bool HInstructionScheduling::Run(bool only_optimize_loop_blocks,
       scheduler.Schedule(graph_);
       break;
     }
+#endif
+#ifdef ART_ENABLE_CODEGEN_loongarch64
+    case InstructionSet::kLoongarch64: {
+      loongarch64::HSchedulerLoongarch64 scheduler(selector, GetInstructionSetFeatures());
+      scheduler.SetOnlyOptimizeLoopBlocks(only_optimize_loop_blocks);
+      scheduler.Schedule(graph_);
+      break;
+    }
+#endif
+#ifdef ART_ENABLE_CODEGEN_x86_64
+    case InstructionSet::kX86_64: {
+      x86_64::HSchedulerX86_64 scheduler(selector, GetInstructionSetFeatures());
+      scheduler.SetOnlyOptimizeLoopBlocks(only_optimize_loop_blocks);
+      scheduler.Schedule(graph_);
+      break;
+    }
 #endif
     default:
       break;
@@ -564,6 +564,10 @@ class HInstructionScheduling : public HOptimization {
   static constexpr const char* kInstructionSchedulingPassName = "scheduler";
 
  private:
+  // The features select the latency model of the target microarchitecture. Without a code
+  // generator, as in some tests, the schedulers use their default model.
+  const InstructionSetFeatures* GetInstructionSetFeatures() const;
+
   CodeGenerator* const codegen_;
   const InstructionSet instruction_set_;
   DISALLOW_COPY_AND_ASSIGN(HInstructionScheduling);
@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scheduler_loongarch64.h"
+
+#include "arch/loongarch64/instruction_set_features_loongarch64.h"
+#include "code_generator_utils.h"
+#include "mirror/array-inl.h"
+#include "mirror/string.h"
+
+namespace art {
+namespace loongarch64 {
+
+// The latencies below are approximations taken from public measurements. They only need to be
+// accurate relative to each other for the scheduling heuristics to be useful.
+
+// LA464 cores (Loongson 3A5000, 3C5000).
+static constexpr Loongarch64SchedulingLatencies kLa464Latencies = {
+  /* integer_op */ 1,
+  /* memory_load */ 4,
+  /* memory_store */ 1,
+  /* branch */ 1,
+  /* call */ 5,
+  /* call_internal */ 10,
+  /* load_string_internal */ 7,
+  /* mul_integer */ 4,
+  /* div_int */ 11,
+  /* div_long */ 18,
+  /* floating_point_op */ 5,
+  /* mul_floating_point */ 5,
+  /* div_float */ 11,
+  /* div_double */ 18,
+  /* type_conversion_floating_point_integer */ 4,
+  /* simd_integer_op */ 2,
+  /* simd_floating_point_op */ 5,
+  /* simd_mul_integer */ 4,
+  /* simd_mul_floating_point */ 5,
+  /* simd_div_float */ 11,
+  /* simd_div_double */ 18,
+  /* simd_memory_load */ 5,
+  /* simd_memory_store */ 1,
+  /* simd_replicate_op */ 3,
+  /* simd_type_conversion_int_to_fp */ 4,
+};
+
+// LA664 cores (Loongson 3A6000).
+static constexpr Loongarch64SchedulingLatencies kLa664Latencies = {
+  /* integer_op */ 1,
+  /* memory_load */ 4,
+  /* memory_store */ 1,
+  /* branch */ 1,
+  /* call */ 5,
+  /* call_internal */ 10,
+  /* load_string_internal */ 7,
+  /* mul_integer */ 4,
+  /* div_int */ 9,
+  /* div_long */ 13,
+  /* floating_point_op */ 3,
+  /* mul_floating_point */ 4,
+  /* div_float */ 8,
+  /* div_double */ 12,
+  /* type_conversion_floating_point_integer */ 3,
+  /* simd_integer_op */ 1,
+  /* simd_floating_point_op */ 3,
+  /* simd_mul_integer */ 4,
+  /* simd_mul_floating_point */ 4,
+  /* simd_div_float */ 8,
+  /* simd_div_double */ 12,
+  /* simd_memory_load */ 5,
+  /* simd_memory_store */ 1,
+  /* simd_replicate_op */ 3,
+  /* simd_type_conversion_int_to_fp */ 3,
+};
+
+static const Loongarch64SchedulingLatencies& SelectLatencies(
+    const InstructionSetFeatures* features) {
+  if (features != nullptr && features->AsLoongarch64InstructionSetFeatures()->IsLa664()) {
+    return kLa664Latencies;
+  }
+  return kLa464Latencies;
+}
+
+SchedulingLatencyVisitorLoongarch64::SchedulingLatencyVisitorLoongarch64(
+    const InstructionSetFeatures* features)
+    : latencies_(SelectLatencies(features)) {}
+
+void SchedulingLatencyVisitorLoongarch64::VisitBinaryOperation(HBinaryOperation* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? latencies_.floating_point_op
+      : latencies_.integer_op;
+}
+
+void SchedulingLatencyVisitorLoongarch64::HandleArrayAddress(HInstruction* index) {
+  if (!index->IsConstant()) {
+    // The element address is computed with an `alsl.d`.
+    last_visited_internal_latency_ += latencies_.integer_op;
+  }
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitArrayGet(HArrayGet* instruction) {
+  if (instruction->IsStringCharAt() && mirror::kUseStringCompression) {
+    // Set latencies for the uncompressed case.
+    last_visited_internal_latency_ = latencies_.memory_load + latencies_.branch;
+  }
+  HandleArrayAddress(instruction->GetIndex());
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitArrayLength(HArrayLength* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitArraySet(HArraySet* instruction) {
+  HandleArrayAddress(instruction->GetIndex());
+  last_visited_latency_ = latencies_.memory_store;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitBoundsCheck(HBoundsCheck* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.integer_op;
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorLoongarch64::HandleDivRemConstantIntegral(
+    HBinaryOperation* instruction) {
+  // Follow the code path used by code generation.
+  int64_t imm = Int64FromConstant(instruction->GetRight()->AsConstant());
+  if (imm == 0) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = 0;
+  } else if (imm == 1 || imm == -1) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = latencies_.integer_op;
+  } else if (IsPowerOfTwo(AbsOrMin(imm))) {
+    last_visited_internal_latency_ = 3 * latencies_.integer_op;
+    last_visited_latency_ = latencies_.integer_op;
+  } else {
+    DCHECK(imm <= -2 || imm >= 2);
+    // Materialization of the magic number, `mulh` and shifts and adds to correct the result.
+    last_visited_internal_latency_ = latencies_.mul_integer + 4 * latencies_.integer_op;
+    last_visited_latency_ = instruction->IsRem()
+        ? latencies_.mul_integer + latencies_.integer_op
+        : latencies_.integer_op;
+  }
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitDiv(HDiv* instr) {
+  DataType::Type type = instr->GetResultType();
+  switch (type) {
+    case DataType::Type::kFloat32:
+      last_visited_latency_ = latencies_.div_float;
+      break;
+    case DataType::Type::kFloat64:
+      last_visited_latency_ = latencies_.div_double;
+      break;
+    default:
+      if (instr->GetRight()->IsConstant()) {
+        HandleDivRemConstantIntegral(instr);
+      } else {
+        last_visited_latency_ =
+            (type == DataType::Type::kInt64) ? latencies_.div_long : latencies_.div_int;
+      }
+      break;
+  }
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitInstanceFieldGet(
+    HInstanceFieldGet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitInstanceOf(HInstanceOf* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.call_internal;
+  last_visited_latency_ = latencies_.integer_op;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitInvoke(HInvoke* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.call_internal;
+  last_visited_latency_ = latencies_.call;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitLoadString(HLoadString* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.load_string_internal;
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitMul(HMul* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? latencies_.mul_floating_point
+      : latencies_.mul_integer;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitNewArray(HNewArray* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.integer_op + latencies_.call_internal;
+  last_visited_latency_ = latencies_.call;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitNewInstance(HNewInstance* instruction) {
+  if (instruction->IsStringAlloc()) {
+    last_visited_internal_latency_ = 2 + latencies_.memory_load + latencies_.call_internal;
+  } else {
+    last_visited_internal_latency_ = latencies_.call_internal;
+  }
+  last_visited_latency_ = latencies_.call;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitRem(HRem* instruction) {
+  DataType::Type type = instruction->GetResultType();
+  if (DataType::IsFloatingPointType(type)) {
+    last_visited_internal_latency_ = latencies_.call_internal;
+    last_visited_latency_ = latencies_.call;
+  } else if (instruction->GetRight()->IsConstant()) {
+    HandleDivRemConstantIntegral(instruction);
+  } else {
+    // `mod.w` and `mod.d` take as long as the divisions.
+    last_visited_latency_ =
+        (type == DataType::Type::kInt64) ? latencies_.div_long : latencies_.div_int;
+  }
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitStaticFieldGet(HStaticFieldGet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitSuspendCheck(HSuspendCheck* instruction) {
+  HBasicBlock* block = instruction->GetBlock();
+  DCHECK((block->GetLoopInformation() != nullptr) ||
+         (block->IsEntryBlock() && instruction->GetNext()->IsGoto()));
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitTypeConversion(HTypeConversion* instr) {
+  if (DataType::IsFloatingPointType(instr->GetResultType()) ||
+      DataType::IsFloatingPointType(instr->GetInputType())) {
+    last_visited_latency_ = latencies_.type_conversion_floating_point_integer;
+  } else {
+    last_visited_latency_ = latencies_.integer_op;
+  }
+}
+
+void SchedulingLatencyVisitorLoongarch64::HandleSimpleArithmeticSIMD(HVecOperation *instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = latencies_.simd_floating_point_op;
+  } else {
+    last_visited_latency_ = latencies_.simd_integer_op;
+  }
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecReplicateScalar(
+    HVecReplicateScalar* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_replicate_op;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecExtractScalar(HVecExtractScalar* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecReduce(HVecReduce* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecCnv(HVecCnv* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_type_conversion_int_to_fp;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecNeg(HVecNeg* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecAbs(HVecAbs* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecNot(HVecNot* instr) {
+  if (instr->GetPackedType() == DataType::Type::kBool) {
+    last_visited_internal_latency_ = latencies_.simd_integer_op;
+  }
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecAdd(HVecAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecHalvingAdd(HVecHalvingAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecSub(HVecSub* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecMul(HVecMul* instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = latencies_.simd_mul_floating_point;
+  } else {
+    last_visited_latency_ = latencies_.simd_mul_integer;
+  }
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecDiv(HVecDiv* instr) {
+  if (instr->GetPackedType() == DataType::Type::kFloat32) {
+    last_visited_latency_ = latencies_.simd_div_float;
+  } else {
+    DCHECK(instr->GetPackedType() == DataType::Type::kFloat64);
+    last_visited_latency_ = latencies_.simd_div_double;
+  }
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecMin(HVecMin* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecMax(HVecMax* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecAnd(HVecAnd* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecAndNot(HVecAndNot* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecOr(HVecOr* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecXor(HVecXor* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecShl(HVecShl* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecShr(HVecShr* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecUShr(HVecUShr* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecSetScalars(HVecSetScalars* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecMultiplyAccumulate(
+    HVecMultiplyAccumulate* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_mul_integer;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecLoad(HVecLoad* instr) {
+  last_visited_internal_latency_ = 0;
+  if (instr->GetPackedType() == DataType::Type::kUint16
+      && mirror::kUseStringCompression
+      && instr->IsStringCharAt()) {
+    // Set latencies for the uncompressed case.
+    last_visited_internal_latency_ = latencies_.memory_load + latencies_.branch;
+  }
+  HandleArrayAddress(instr->GetIndex());
+  last_visited_latency_ = latencies_.simd_memory_load;
+}
+
+void SchedulingLatencyVisitorLoongarch64::VisitVecStore(HVecStore* instr) {
+  last_visited_internal_latency_ = 0;
+  HandleArrayAddress(instr->GetIndex());
+  last_visited_latency_ = latencies_.simd_memory_store;
+}
+
+}  // namespace loongarch64
+}  // namespace art
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_SCHEDULER_LOONGARCH64_H_
+#define ART_COMPILER_OPTIMIZING_SCHEDULER_LOONGARCH64_H_
+
+#include "scheduler.h"
+
+namespace art {
+
+class InstructionSetFeatures;
+
+namespace loongarch64 {
+
+// Instruction latencies, in cycles, of one LoongArch64 microarchitecture.
+struct Loongarch64SchedulingLatencies {
+  uint32_t integer_op;
+  uint32_t memory_load;
+  uint32_t memory_store;
+  uint32_t branch;
+  uint32_t call;
+  uint32_t call_internal;
+  uint32_t load_string_internal;
+  uint32_t mul_integer;
+  uint32_t div_int;
+  uint32_t div_long;
+  uint32_t floating_point_op;
+  uint32_t mul_floating_point;
+  uint32_t div_float;
+  uint32_t div_double;
+  uint32_t type_conversion_floating_point_integer;
+  uint32_t simd_integer_op;
+  uint32_t simd_floating_point_op;
+  uint32_t simd_mul_integer;
+  uint32_t simd_mul_floating_point;
+  uint32_t simd_div_float;
+  uint32_t simd_div_double;
+  uint32_t simd_memory_load;
+  uint32_t simd_memory_store;
+  uint32_t simd_replicate_op;
+  uint32_t simd_type_conversion_int_to_fp;
+};
+
+class SchedulingLatencyVisitorLoongarch64 : public SchedulingLatencyVisitor {
+ public:
+  // LA664 latencies are used when the instruction set features ask for LA664 tuning (see the
+  // `la664` variant and feature), LA464 latencies otherwise, including for a null `features`.
+  explicit SchedulingLatencyVisitorLoongarch64(const InstructionSetFeatures* features);
+
+  // Default visitor for instructions not handled specifically below.
+  void VisitInstruction(HInstruction* ATTRIBUTE_UNUSED) override {
+    last_visited_latency_ = latencies_.integer_op;
+  }
+
+// We add a second unused parameter to be able to use this macro like the others
+// defined in `nodes.h`.
+#define FOR_EACH_SCHEDULED_LOONGARCH64_INSTRUCTION(M) \
+  M(ArrayGet             , unused)                    \
+  M(ArrayLength          , unused)                    \
+  M(ArraySet             , unused)                    \
+  M(BoundsCheck          , unused)                    \
+  M(Div                  , unused)                    \
+  M(InstanceFieldGet     , unused)                    \
+  M(InstanceOf           , unused)                    \
+  M(LoadString           , unused)                    \
+  M(Mul                  , unused)                    \
+  M(NewArray             , unused)                    \
+  M(NewInstance          , unused)                    \
+  M(Rem                  , unused)                    \
+  M(StaticFieldGet       , unused)                    \
+  M(SuspendCheck         , unused)                    \
+  M(TypeConversion       , unused)                    \
+  M(VecReplicateScalar   , unused)                    \
+  M(VecExtractScalar     , unused)                    \
+  M(VecReduce            , unused)                    \
+  M(VecCnv               , unused)                    \
+  M(VecNeg               , unused)                    \
+  M(VecAbs               , unused)                    \
+  M(VecNot               , unused)                    \
+  M(VecAdd               , unused)                    \
+  M(VecHalvingAdd        , unused)                    \
+  M(VecSub               , unused)                    \
+  M(VecMul               , unused)                    \
+  M(VecDiv               , unused)                    \
+  M(VecMin               , unused)                    \
+  M(VecMax               , unused)                    \
+  M(VecAnd               , unused)                    \
+  M(VecAndNot            , unused)                    \
+  M(VecOr                , unused)                    \
+  M(VecXor               , unused)                    \
+  M(VecShl               , unused)                    \
+  M(VecShr               , unused)                    \
+  M(VecUShr              , unused)                    \
+  M(VecSetScalars        , unused)                    \
+  M(VecMultiplyAccumulate, unused)                    \
+  M(VecLoad              , unused)                    \
+  M(VecStore             , unused)
+
+#define FOR_EACH_SCHEDULED_ABSTRACT_LOONGARCH64_INSTRUCTION(M) \
+  M(BinaryOperation      , unused)                           \
+  M(Invoke               , unused)
+
+#define DECLARE_VISIT_INSTRUCTION(type, unused)  \
+  void Visit##type(H##type* instruction) override;
+
+  FOR_EACH_SCHEDULED_LOONGARCH64_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_SCHEDULED_ABSTRACT_LOONGARCH64_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+
+#undef DECLARE_VISIT_INSTRUCTION
+
+ private:
+  void HandleArrayAddress(HInstruction* index);
+  void HandleDivRemConstantIntegral(HBinaryOperation* instruction);
+  void HandleSimpleArithmeticSIMD(HVecOperation *instr);
+
+  const Loongarch64SchedulingLatencies& latencies_;
+};
+
+class HSchedulerLoongarch64 : public HScheduler {
+ public:
+  HSchedulerLoongarch64(SchedulingNodeSelector* selector, const InstructionSetFeatures* features)
+      : HScheduler(&loongarch64_latency_visitor_, selector),
+        loongarch64_latency_visitor_(features) {}
+  ~HSchedulerLoongarch64() override {}
+
+  bool IsSchedulable(const HInstruction* instruction) const override {
+#define CASE_INSTRUCTION_KIND(type, unused) case \
+  HInstruction::InstructionKind::k##type:
+    switch (instruction->GetKind()) {
+      FOR_EACH_SCHEDULED_LOONGARCH64_INSTRUCTION(CASE_INSTRUCTION_KIND)
+        return true;
+      default:
+        return HScheduler::IsSchedulable(instruction);
+    }
+#undef CASE_INSTRUCTION_KIND
+  }
+
+  // Treat as scheduling barriers those vector instructions whose live ranges exceed the vectorized
+  // loop boundaries. As on ARM64, this works around the lack of notion of SIMD register in the
+  // compiler: only the lower 64 bits of the callee-save FS0-FS7 registers are preserved across
+  // calls, so don't reorder such vector instructions.
+  bool IsSchedulingBarrier(const HInstruction* instr) const override {
+    return HScheduler::IsSchedulingBarrier(instr) ||
+           instr->IsVecReduce() ||
+           instr->IsVecExtractScalar() ||
+           instr->IsVecSetScalars() ||
+           instr->IsVecReplicateScalar();
+  }
+
+ private:
+  SchedulingLatencyVisitorLoongarch64 loongarch64_latency_visitor_;
+  DISALLOW_COPY_AND_ASSIGN(HSchedulerLoongarch64);
+};
+
+}  // namespace loongarch64
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_SCHEDULER_LOONGARCH64_H_
@@ -34,6 +34,16 @@
 #include "scheduler_arm.h"
 #endif
 
+#ifdef ART_ENABLE_CODEGEN_loongarch64
+#include "arch/loongarch64/instruction_set_features_loongarch64.h"
+#include "scheduler_loongarch64.h"
+#endif
+
+#ifdef ART_ENABLE_CODEGEN_x86_64
+#include "arch/x86_64/instruction_set_features_x86_64.h"
+#include "scheduler_x86_64.h"
+#endif
+
 namespace art {
 
 // Return all combinations of ISA and code generator that are executable on
@@ -351,6 +361,158 @@ class SchedulerTest : public OptimizingUnitTest {
     scheduler->Schedule(graph_);
   }
 
+  // Straight-line kernels modelled on the bodies of hot loops. Each one is built in source order,
+  // the way the graph builder emits it, into the only block between the entry and exit blocks.
+  enum class Kernel {
+    kIntDotProduct,    // a[0] * b[0] + ... + a[3] * b[3]
+    kFloatDotProduct,  // The same on floats.
+    kSumAndDivide,     // a[0] + ... + a[3] + (x / y) * (x / y) on floats.
+    kHash,             // h = (h ^ a[i]) * 31 for i in [0, 3]
+  };
+
+  HBasicBlock* BuildKernel(Kernel kernel) {
+    graph_ = CreateGraph();
+    HBasicBlock* entry = new (GetAllocator()) HBasicBlock(graph_);
+    HBasicBlock* body = new (GetAllocator()) HBasicBlock(graph_);
+    HBasicBlock* exit = new (GetAllocator()) HBasicBlock(graph_);
+    graph_->AddBlock(entry);
+    graph_->AddBlock(body);
+    graph_->AddBlock(exit);
+    graph_->SetEntryBlock(entry);
+    graph_->SetExitBlock(exit);
+    entry->AddSuccessor(body);
+    body->AddSuccessor(exit);
+
+    HInstruction* a = new (GetAllocator()) HParameterValue(graph_->GetDexFile(),
+                                                           dex::TypeIndex(0),
+                                                           0,
+                                                           DataType::Type::kReference);
+    HInstruction* b = new (GetAllocator()) HParameterValue(graph_->GetDexFile(),
+                                                           dex::TypeIndex(0),
+                                                           1,
+                                                           DataType::Type::kReference);
+    HInstruction* x = new (GetAllocator()) HParameterValue(graph_->GetDexFile(),
+                                                           dex::TypeIndex(1),
+                                                           2,
+                                                           DataType::Type::kFloat32);
+    HInstruction* y = new (GetAllocator()) HParameterValue(graph_->GetDexFile(),
+                                                           dex::TypeIndex(1),
+                                                           3,
+                                                           DataType::Type::kFloat32);
+    for (HInstruction* parameter : {a, b, x, y}) {
+      entry->AddInstruction(parameter);
+    }
+    entry->AddInstruction(new (GetAllocator()) HGoto());
+    exit->AddInstruction(new (GetAllocator()) HExit());
+
+    DataType::Type type = (kernel == Kernel::kIntDotProduct || kernel == Kernel::kHash)
+        ? DataType::Type::kInt32
+        : DataType::Type::kFloat32;
+    auto emit = [&](HInstruction* instruction) {
+      body->AddInstruction(instruction);
+      return instruction;
+    };
+    auto load = [&](HInstruction* array, int32_t index) {
+      return emit(new (GetAllocator()) HArrayGet(array, graph_->GetIntConstant(index), type, 0));
+    };
+
+    HInstruction* result = nullptr;
+    switch (kernel) {
+      case Kernel::kIntDotProduct:
+      case Kernel::kFloatDotProduct:
+        for (int32_t i = 0; i != 4; ++i) {
+          HInstruction* a_i = load(a, i);
+          HInstruction* b_i = load(b, i);
+          HInstruction* product = emit(new (GetAllocator()) HMul(type, a_i, b_i));
+          result = (result == nullptr)
+              ? product
+              : emit(new (GetAllocator()) HAdd(type, result, product));
+        }
+        break;
+      case Kernel::kSumAndDivide: {
+        for (int32_t i = 0; i != 4; ++i) {
+          HInstruction* a_i = load(a, i);
+          result = (result == nullptr) ? a_i : emit(new (GetAllocator()) HAdd(type, result, a_i));
+        }
+        HInstruction* quotient = emit(new (GetAllocator()) HDiv(type, x, y, 0));
+        HInstruction* square = emit(new (GetAllocator()) HMul(type, quotient, quotient));
+        result = emit(new (GetAllocator()) HAdd(type, result, square));
+        break;
+      }
+      case Kernel::kHash:
+        result = graph_->GetIntConstant(17);
+        for (int32_t i = 0; i != 4; ++i) {
+          HInstruction* a_i = load(a, i);
+          HInstruction* mix = emit(new (GetAllocator()) HXor(type, result, a_i));
+          result = emit(new (GetAllocator()) HMul(type, mix, graph_->GetIntConstant(31)));
+        }
+        break;
+    }
+    emit(new (GetAllocator()) HReturn(result));
+
+    graph_->BuildDominatorTree();
+    return body;
+  }
+
+  // Estimate how many cycles `block` takes on a single-issue, in-order core whose instructions
+  // have the latencies reported by `latency_visitor`.
+  uint32_t EstimateScheduleLength(HBasicBlock* block, SchedulingLatencyVisitor* latency_visitor) {
+    std::map<const HInstruction*, uint32_t> ready_cycles;
+    uint32_t cycle = 0u;
+    uint32_t length = 0u;
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      SchedulingNode node(instruction, GetScopedAllocator(), /*is_scheduling_barrier=*/ false);
+      latency_visitor->CalculateLatency(&node);
+      // Wait for the inputs.
+      for (HInstruction* input : instruction->GetInputs()) {
+        auto it_ready = ready_cycles.find(input);
+        if (it_ready != ready_cycles.end()) {
+          cycle = std::max(cycle, it_ready->second);
+        }
+      }
+      cycle += latency_visitor->GetLastVisitedInternalLatency();
+      uint32_t ready_cycle = cycle + latency_visitor->GetLastVisitedLatency();
+      ready_cycles[instruction] = ready_cycle;
+      length = std::max(length, ready_cycle);
+      ++cycle;
+    }
+    return std::max(length, cycle);
+  }
+
+  // Schedule every kernel and report the estimated lengths of the kernels before and after
+  // scheduling. Scheduling must not lengthen any kernel and must shorten the corpus as a whole.
+  template <typename Scheduler, typename LatencyVisitor>
+  void TestScheduleLengths(const char* model, const InstructionSetFeatures* features) {
+    static const std::pair<Kernel, const char*> kCorpus[] = {
+      { Kernel::kIntDotProduct, "int dot product" },
+      { Kernel::kFloatDotProduct, "float dot product" },
+      { Kernel::kSumAndDivide, "sum and divide" },
+      { Kernel::kHash, "hash" },
+    };
+    uint32_t total_before = 0u;
+    uint32_t total_after = 0u;
+    for (const auto& [kernel, name] : kCorpus) {
+      HBasicBlock* body = BuildKernel(kernel);
+      LatencyVisitor latency_visitor(features);
+      uint32_t before = EstimateScheduleLength(body, &latency_visitor);
+
+      CriticalPathSchedulingNodeSelector critical_path_selector;
+      Scheduler scheduler(&critical_path_selector, features);
+      scheduler.SetOnlyOptimizeLoopBlocks(false);
+      scheduler.Schedule(graph_);
+
+      uint32_t after = EstimateScheduleLength(body, &latency_visitor);
+      LOG(INFO) << model << ", " << name << ": " << before << " -> " << after << " cycles";
+      EXPECT_LE(after, before) << model << ", " << name;
+      total_before += before;
+      total_after += after;
+    }
+    LOG(INFO) << model << ", corpus: " << total_before << " -> " << total_after << " cycles ("
+              << (100u * (total_before - total_after) / total_before) << "% shorter)";
+    EXPECT_LT(total_after, total_before) << model;
+  }
+
   class TestSchedulingGraph : public SchedulingGraph {
    public:
     explicit TestSchedulingGraph(ScopedArenaAllocator* allocator,
@@ -419,6 +581,56 @@ TEST_F(SchedulerTest, ArrayAccessAliasingARM) {
 }
 #endif
 
+#if defined(ART_ENABLE_CODEGEN_loongarch64)
+TEST_F(SchedulerTest, DependencyGraphAndSchedulerLOONGARCH64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  loongarch64::HSchedulerLoongarch64 scheduler(&critical_path_selector, /*features=*/ nullptr);
+  TestBuildDependencyGraphAndSchedule(&scheduler);
+}
+
+TEST_F(SchedulerTest, ArrayAccessAliasingLOONGARCH64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  loongarch64::HSchedulerLoongarch64 scheduler(&critical_path_selector, /*features=*/ nullptr);
+  TestDependencyGraphOnAliasingArrayAccesses(&scheduler);
+}
+
+TEST_F(SchedulerTest, ScheduleLengthsLOONGARCH64) {
+  for (const char* variant : {"la464", "la664"}) {
+    std::string error_msg;
+    Loongarch64FeaturesUniquePtr features =
+        Loongarch64InstructionSetFeatures::FromVariant(variant, &error_msg);
+    ASSERT_TRUE(features != nullptr) << error_msg;
+    TestScheduleLengths<loongarch64::HSchedulerLoongarch64,
+                        loongarch64::SchedulingLatencyVisitorLoongarch64>(variant, features.get());
+  }
+}
+#endif
+
+#if defined(ART_ENABLE_CODEGEN_x86_64)
+TEST_F(SchedulerTest, DependencyGraphAndSchedulerX86_64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  x86_64::HSchedulerX86_64 scheduler(&critical_path_selector, /*features=*/ nullptr);
+  TestBuildDependencyGraphAndSchedule(&scheduler);
+}
+
+TEST_F(SchedulerTest, ArrayAccessAliasingX86_64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  x86_64::HSchedulerX86_64 scheduler(&critical_path_selector, /*features=*/ nullptr);
+  TestDependencyGraphOnAliasingArrayAccesses(&scheduler);
+}
+
+TEST_F(SchedulerTest, ScheduleLengthsX86_64) {
+  for (const char* variant : {"atom", "silvermont", "kabylake"}) {
+    std::string error_msg;
+    X86_64FeaturesUniquePtr features =
+        X86_64InstructionSetFeatures::FromVariant(variant, &error_msg);
+    ASSERT_TRUE(features != nullptr) << error_msg;
+    TestScheduleLengths<x86_64::HSchedulerX86_64, x86_64::SchedulingLatencyVisitorX86_64>(
+        variant, features.get());
+  }
+}
+#endif
+
 TEST_F(SchedulerTest, RandomScheduling) {
   //
   // Java source: crafted code to make sure (random) scheduling should get correct result.
@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scheduler_x86_64.h"
+
+#include "arch/x86_64/instruction_set_features_x86_64.h"
+#include "code_generator_utils.h"
+#include "mirror/array-inl.h"
+#include "mirror/string.h"
+
+namespace art {
+namespace x86_64 {
+
+// The latencies below are approximations taken from public instruction tables. They only need
+// to be accurate relative to each other for the scheduling heuristics to be useful.
+
+// Skylake, Kaby Lake and later big cores.
+static constexpr X86_64SchedulingLatencies kSkylakeLatencies = {
+  /* integer_op */ 1,
+  /* memory_load */ 5,
+  /* memory_store */ 1,
+  /* branch */ 1,
+  /* call */ 5,
+  /* call_internal */ 10,
+  /* load_string_internal */ 7,
+  /* mul_integer */ 3,
+  /* div_int */ 26,
+  /* div_long */ 42,
+  /* floating_point_op */ 4,
+  /* mul_floating_point */ 4,
+  /* div_float */ 11,
+  /* div_double */ 14,
+  /* type_conversion_floating_point_integer */ 6,
+  /* simd_integer_op */ 1,
+  /* simd_floating_point_op */ 4,
+  /* simd_mul_integer */ 10,
+  /* simd_mul_floating_point */ 4,
+  /* simd_div_float */ 11,
+  /* simd_div_double */ 14,
+  /* simd_memory_load */ 6,
+  /* simd_memory_store */ 1,
+  /* simd_replicate_op */ 3,
+  /* simd_type_conversion_int_to_fp */ 4,
+};
+
+// Silvermont, Goldmont and Tremont.
+static constexpr X86_64SchedulingLatencies kSilvermontLatencies = {
+  /* integer_op */ 1,
+  /* memory_load */ 3,
+  /* memory_store */ 1,
+  /* branch */ 1,
+  /* call */ 5,
+  /* call_internal */ 10,
+  /* load_string_internal */ 7,
+  /* mul_integer */ 3,
+  /* div_int */ 30,
+  /* div_long */ 70,
+  /* floating_point_op */ 3,
+  /* mul_floating_point */ 5,
+  /* div_float */ 19,
+  /* div_double */ 34,
+  /* type_conversion_floating_point_integer */ 5,
+  /* simd_integer_op */ 1,
+  /* simd_floating_point_op */ 3,
+  /* simd_mul_integer */ 11,
+  /* simd_mul_floating_point */ 5,
+  /* simd_div_float */ 39,
+  /* simd_div_double */ 69,
+  /* simd_memory_load */ 4,
+  /* simd_memory_store */ 1,
+  /* simd_replicate_op */ 4,
+  /* simd_type_conversion_int_to_fp */ 5,
+};
+
+// In-order Bonnell (Atom) cores.
+static constexpr X86_64SchedulingLatencies kBonnellLatencies = {
+  /* integer_op */ 1,
+  /* memory_load */ 3,
+  /* memory_store */ 1,
+  /* branch */ 1,
+  /* call */ 5,
+  /* call_internal */ 10,
+  /* load_string_internal */ 7,
+  /* mul_integer */ 5,
+  /* div_int */ 50,
+  /* div_long */ 130,
+  /* floating_point_op */ 5,
+  /* mul_floating_point */ 5,
+  /* div_float */ 31,
+  /* div_double */ 60,
+  /* type_conversion_floating_point_integer */ 8,
+  /* simd_integer_op */ 1,
+  /* simd_floating_point_op */ 5,
+  /* simd_mul_integer */ 10,
+  /* simd_mul_floating_point */ 5,
+  /* simd_div_float */ 70,
+  /* simd_div_double */ 125,
+  /* simd_memory_load */ 3,
+  /* simd_memory_store */ 1,
+  /* simd_replicate_op */ 4,
+  /* simd_type_conversion_int_to_fp */ 6,
+};
+
+static const X86_64SchedulingLatencies& SelectLatencies(const InstructionSetFeatures* features) {
+  if (features == nullptr) {
+    return kSkylakeLatencies;
+  }
+  const X86_64InstructionSetFeatures* x86_64_features = features->AsX86_64InstructionSetFeatures();
+  if (x86_64_features->HasAVX2()) {
+    return kSkylakeLatencies;
+  } else if (x86_64_features->HasSSE4_1()) {
+    return kSilvermontLatencies;
+  } else if (x86_64_features->HasSSSE3()) {
+    return kBonnellLatencies;
+  }
+  return kSkylakeLatencies;
+}
+
+SchedulingLatencyVisitorX86_64::SchedulingLatencyVisitorX86_64(
+    const InstructionSetFeatures* features)
+    : latencies_(SelectLatencies(features)) {}
+
+void SchedulingLatencyVisitorX86_64::VisitBinaryOperation(HBinaryOperation* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? latencies_.floating_point_op
+      : latencies_.integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitX86AndNot(HX86AndNot* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitX86MaskOrResetLeastSetBit(
+    HX86MaskOrResetLeastSetBit* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitArrayGet(HArrayGet* instruction) {
+  if (instruction->IsStringCharAt() && mirror::kUseStringCompression) {
+    // Set latencies for the uncompressed case.
+    last_visited_internal_latency_ = latencies_.memory_load + latencies_.branch;
+  }
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitArrayLength(HArrayLength* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitArraySet(HArraySet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.memory_store;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitBoundsCheck(HBoundsCheck* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.integer_op;
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorX86_64::HandleDivRemConstantIntegral(HBinaryOperation* instruction) {
+  // Follow the code path used by code generation.
+  int64_t imm = Int64FromConstant(instruction->GetRight()->AsConstant());
+  if (imm == 0) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = 0;
+  } else if (imm == 1 || imm == -1) {
+    last_visited_internal_latency_ = 0;
+    last_visited_latency_ = latencies_.integer_op;
+  } else if (IsPowerOfTwo(AbsOrMin(imm))) {
+    last_visited_internal_latency_ = 3 * latencies_.integer_op;
+    last_visited_latency_ = latencies_.integer_op;
+  } else {
+    DCHECK(imm <= -2 || imm >= 2);
+    // Multiplication by the magic number, then shifts and adds to correct the result.
+    last_visited_internal_latency_ = latencies_.mul_integer + 2 * latencies_.integer_op;
+    last_visited_latency_ = instruction->IsRem()
+        ? latencies_.mul_integer + latencies_.integer_op
+        : latencies_.integer_op;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitDiv(HDiv* instr) {
+  DataType::Type type = instr->GetResultType();
+  switch (type) {
+    case DataType::Type::kFloat32:
+      last_visited_latency_ = latencies_.div_float;
+      break;
+    case DataType::Type::kFloat64:
+      last_visited_latency_ = latencies_.div_double;
+      break;
+    default:
+      if (instr->GetRight()->IsConstant()) {
+        HandleDivRemConstantIntegral(instr);
+      } else {
+        // The `idiv` is preceded by a sign extension of the dividend.
+        last_visited_internal_latency_ = latencies_.integer_op;
+        last_visited_latency_ =
+            (type == DataType::Type::kInt64) ? latencies_.div_long : latencies_.div_int;
+      }
+      break;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitInstanceFieldGet(HInstanceFieldGet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitInstanceOf(HInstanceOf* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.call_internal;
+  last_visited_latency_ = latencies_.integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitInvoke(HInvoke* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.call_internal;
+  last_visited_latency_ = latencies_.call;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitLoadString(HLoadString* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.load_string_internal;
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitMul(HMul* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? latencies_.mul_floating_point
+      : latencies_.mul_integer;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitNewArray(HNewArray* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = latencies_.integer_op + latencies_.call_internal;
+  last_visited_latency_ = latencies_.call;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitNewInstance(HNewInstance* instruction) {
+  if (instruction->IsStringAlloc()) {
+    last_visited_internal_latency_ = 2 + latencies_.memory_load + latencies_.call_internal;
+  } else {
+    last_visited_internal_latency_ = latencies_.call_internal;
+  }
+  last_visited_latency_ = latencies_.call;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitRem(HRem* instruction) {
+  DataType::Type type = instruction->GetResultType();
+  if (DataType::IsFloatingPointType(type)) {
+    // The code generator emits an x87 `fprem` loop, which costs about as much as a call.
+    last_visited_internal_latency_ = latencies_.call_internal;
+    last_visited_latency_ = latencies_.call;
+  } else if (instruction->GetRight()->IsConstant()) {
+    HandleDivRemConstantIntegral(instruction);
+  } else {
+    last_visited_internal_latency_ = latencies_.integer_op;
+    last_visited_latency_ =
+        (type == DataType::Type::kInt64) ? latencies_.div_long : latencies_.div_int;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitStaticFieldGet(HStaticFieldGet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.memory_load;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitSuspendCheck(HSuspendCheck* instruction) {
+  HBasicBlock* block = instruction->GetBlock();
+  DCHECK((block->GetLoopInformation() != nullptr) ||
+         (block->IsEntryBlock() && instruction->GetNext()->IsGoto()));
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitTypeConversion(HTypeConversion* instr) {
+  if (DataType::IsFloatingPointType(instr->GetResultType()) ||
+      DataType::IsFloatingPointType(instr->GetInputType())) {
+    last_visited_latency_ = latencies_.type_conversion_floating_point_integer;
+  } else {
+    last_visited_latency_ = latencies_.integer_op;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::HandleSimpleArithmeticSIMD(HVecOperation *instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = latencies_.simd_floating_point_op;
+  } else {
+    last_visited_latency_ = latencies_.simd_integer_op;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecReplicateScalar(
+    HVecReplicateScalar* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_replicate_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecExtractScalar(HVecExtractScalar* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecReduce(HVecReduce* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecCnv(HVecCnv* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_type_conversion_int_to_fp;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecNeg(HVecNeg* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecAbs(HVecAbs* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecNot(HVecNot* instr) {
+  if (instr->GetPackedType() == DataType::Type::kBool) {
+    last_visited_internal_latency_ = latencies_.simd_integer_op;
+  }
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecAdd(HVecAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecHalvingAdd(HVecHalvingAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecSub(HVecSub* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecMul(HVecMul* instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = latencies_.simd_mul_floating_point;
+  } else {
+    last_visited_latency_ = latencies_.simd_mul_integer;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecDiv(HVecDiv* instr) {
+  if (instr->GetPackedType() == DataType::Type::kFloat32) {
+    last_visited_latency_ = latencies_.simd_div_float;
+  } else {
+    DCHECK(instr->GetPackedType() == DataType::Type::kFloat64);
+    last_visited_latency_ = latencies_.simd_div_double;
+  }
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecMin(HVecMin* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecMax(HVecMax* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecAnd(HVecAnd* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecAndNot(HVecAndNot* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecOr(HVecOr* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecXor(HVecXor* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = latencies_.simd_integer_op;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecShl(HVecShl* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecShr(HVecShr* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecUShr(HVecUShr* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecSetScalars(HVecSetScalars* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecLoad(HVecLoad* instr) {
+  // Complex addressing modes make the address computation free.
+  last_visited_internal_latency_ = 0;
+  if (instr->GetPackedType() == DataType::Type::kUint16
+      && mirror::kUseStringCompression
+      && instr->IsStringCharAt()) {
+    // Set latencies for the uncompressed case.
+    last_visited_internal_latency_ = latencies_.memory_load + latencies_.branch;
+  }
+  last_visited_latency_ = latencies_.simd_memory_load;
+}
+
+void SchedulingLatencyVisitorX86_64::VisitVecStore(HVecStore* instr ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = 0;
+  last_visited_latency_ = latencies_.simd_memory_store;
+}
+
+}  // namespace x86_64
+}  // namespace art
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
+#define ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
+
+#include "scheduler.h"
+
+namespace art {
+
+class InstructionSetFeatures;
+
+namespace x86_64 {
+
+// Instruction latencies, in cycles, of one x86-64 microarchitecture.
+struct X86_64SchedulingLatencies {
+  uint32_t integer_op;
+  uint32_t memory_load;
+  uint32_t memory_store;
+  uint32_t branch;
+  uint32_t call;
+  uint32_t call_internal;
+  uint32_t load_string_internal;
+  uint32_t mul_integer;
+  uint32_t div_int;
+  uint32_t div_long;
+  uint32_t floating_point_op;
+  uint32_t mul_floating_point;
+  uint32_t div_float;
+  uint32_t div_double;
+  uint32_t type_conversion_floating_point_integer;
+  uint32_t simd_integer_op;
+  uint32_t simd_floating_point_op;
+  uint32_t simd_mul_integer;
+  uint32_t simd_mul_floating_point;
+  uint32_t simd_div_float;
+  uint32_t simd_div_double;
+  uint32_t simd_memory_load;
+  uint32_t simd_memory_store;
+  uint32_t simd_replicate_op;
+  uint32_t simd_type_conversion_int_to_fp;
+};
+
+class SchedulingLatencyVisitorX86_64 : public SchedulingLatencyVisitor {
+ public:
+  // The latency table is picked from the instruction set features, which are derived from the
+  // `--instruction-set-variant`:
+  //   - AVX2 (kabylake and newer big cores): Skylake latencies,
+  //   - SSE4.1 without AVX2 (silvermont, sandybridge): Silvermont latencies,
+  //   - SSSE3 only (atom): Bonnell latencies.
+  // Variants that do not declare any of these features, and a null `features`, get the
+  // Skylake latencies.
+  explicit SchedulingLatencyVisitorX86_64(const InstructionSetFeatures* features);
+
+  // Default visitor for instructions not handled specifically below.
+  void VisitInstruction(HInstruction* ATTRIBUTE_UNUSED) override {
+    last_visited_latency_ = latencies_.integer_op;
+  }
+
+// We add a second unused parameter to be able to use this macro like the others
+// defined in `nodes.h`.
+#define FOR_EACH_SCHEDULED_X86_64_INSTRUCTION(M)     \
+  M(ArrayGet             , unused)                   \
+  M(ArrayLength          , unused)                   \
+  M(ArraySet             , unused)                   \
+  M(BoundsCheck          , unused)                   \
+  M(Div                  , unused)                   \
+  M(InstanceFieldGet     , unused)                   \
+  M(InstanceOf           , unused)                   \
+  M(LoadString           , unused)                   \
+  M(Mul                  , unused)                   \
+  M(NewArray             , unused)                   \
+  M(NewInstance          , unused)                   \
+  M(Rem                  , unused)                   \
+  M(StaticFieldGet       , unused)                   \
+  M(SuspendCheck         , unused)                   \
+  M(TypeConversion       , unused)                   \
+  M(VecReplicateScalar   , unused)                   \
+  M(VecExtractScalar     , unused)                   \
+  M(VecReduce            , unused)                   \
+  M(VecCnv               , unused)                   \
+  M(VecNeg               , unused)                   \
+  M(VecAbs               , unused)                   \
+  M(VecNot               , unused)                   \
+  M(VecAdd               , unused)                   \
+  M(VecHalvingAdd        , unused)                   \
+  M(VecSub               , unused)                   \
+  M(VecMul               , unused)                   \
+  M(VecDiv               , unused)                   \
+  M(VecMin               , unused)                   \
+  M(VecMax               , unused)                   \
+  M(VecAnd               , unused)                   \
+  M(VecAndNot            , unused)                   \
+  M(VecOr                , unused)                   \
+  M(VecXor               , unused)                   \
+  M(VecShl               , unused)                   \
+  M(VecShr               , unused)                   \
+  M(VecUShr              , unused)                   \
+  M(VecSetScalars        , unused)                   \
+  M(VecLoad              , unused)                   \
+  M(VecStore             , unused)
+
+#define FOR_EACH_SCHEDULED_ABSTRACT_X86_64_INSTRUCTION(M) \
+  M(BinaryOperation      , unused)                      \
+  M(Invoke               , unused)
+
+#define DECLARE_VISIT_INSTRUCTION(type, unused)  \
+  void Visit##type(H##type* instruction) override;
+
+  FOR_EACH_SCHEDULED_X86_64_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_SCHEDULED_ABSTRACT_X86_64_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(DECLARE_VISIT_INSTRUCTION)
+
+#undef DECLARE_VISIT_INSTRUCTION
+
+ private:
+  void HandleDivRemConstantIntegral(HBinaryOperation* instruction);
+  void HandleSimpleArithmeticSIMD(HVecOperation *instr);
+
+  const X86_64SchedulingLatencies& latencies_;
+};
+
+class HSchedulerX86_64 : public HScheduler {
+ public:
+  HSchedulerX86_64(SchedulingNodeSelector* selector, const InstructionSetFeatures* features)
+      : HScheduler(&x86_64_latency_visitor_, selector),
+        x86_64_latency_visitor_(features) {}
+  ~HSchedulerX86_64() override {}
+
+  bool IsSchedulable(const HInstruction* instruction) const override {
+#define CASE_INSTRUCTION_KIND(type, unused) case \
+  HInstruction::InstructionKind::k##type:
+    switch (instruction->GetKind()) {
+      FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(CASE_INSTRUCTION_KIND)
+        return true;
+      FOR_EACH_SCHEDULED_X86_64_INSTRUCTION(CASE_INSTRUCTION_KIND)
+        return true;
+      default:
+        return HScheduler::IsSchedulable(instruction);
+    }
+#undef CASE_INSTRUCTION_KIND
+  }
+
+  // Treat as scheduling barriers those vector instructions whose live ranges exceed the vectorized
+  // loop boundaries. As on ARM64, this works around the lack of notion of SIMD register in the
+  // compiler: only the lower 64 bits of the callee-save XMM registers are preserved across calls,
+  // so don't reorder such vector instructions.
+  bool IsSchedulingBarrier(const HInstruction* instr) const override {
+    return HScheduler::IsSchedulingBarrier(instr) ||
+           instr->IsVecReduce() ||
+           instr->IsVecExtractScalar() ||
+           instr->IsVecSetScalars() ||
+           instr->IsVecReplicateScalar();
+  }
+
+ private:
+  SchedulingLatencyVisitorX86_64 x86_64_latency_visitor_;
+  DISALLOW_COPY_AND_ASSIGN(HSchedulerX86_64);
+};
+
+}  // namespace x86_64
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "write_barrier_elimination.h"
+
+#include "base/arena_allocator.h"
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
+#include "code_generator.h"
+
+namespace art {
+
+class WBEVisitor : public HGraphVisitor {
+ public:
+  WBEVisitor(HGraph* graph, OptimizingCompilerStats* stats)
+      : HGraphVisitor(graph),
+        scoped_allocator_(graph->GetArenaStack()),
+        current_write_barriers_(scoped_allocator_.Adapter(kArenaAllocWBE)),
+        stats_(stats) {}
+
+  void VisitBasicBlock(HBasicBlock* block) override {
+    // Card marks are only coalesced within a block.
+    current_write_barriers_.clear();
+    HGraphVisitor::VisitBasicBlock(block);
+  }
+
+  void VisitInstanceFieldSet(HInstanceFieldSet* instruction) override {
+    // A predicated set may skip its store and card mark, so it cannot mark for a later store.
+    if (instruction->GetIsPredicatedSet()) {
+      return;
+    }
+    VisitFieldSet(instruction, instruction->GetFieldType(), instruction->GetValue());
+  }
+
+  void VisitStaticFieldSet(HStaticFieldSet* instruction) override {
+    VisitFieldSet(instruction, instruction->GetFieldType(), instruction->GetValue());
+  }
+
+  void VisitInstruction(HInstruction* instruction) override {
+    if (instruction->GetSideEffects().Includes(SideEffects::CanTriggerGC())) {
+      current_write_barriers_.clear();
+    }
+  }
+
+ private:
+  void VisitFieldSet(HInstruction* instruction, DataType::Type type, HInstruction* value) {
+    DCHECK(!instruction->GetSideEffects().Includes(SideEffects::CanTriggerGC()));
+    if (!CodeGenerator::StoreNeedsWriteBarrier(type, value)) {
+      return;
+    }
+    MaybeRecordStat(stats_, MethodCompilationStat::kPossibleWriteBarrier);
+
+    HInstruction* holder = HuntForOriginalReference(instruction->InputAt(0));
+    auto it = current_write_barriers_.find(holder);
+    if (it == current_write_barriers_.end()) {
+      current_write_barriers_.insert({holder, instruction});
+      return;
+    }
+
+    SetWriteBarrierKind(it->second, WriteBarrierKind::kEmitNoNullCheck);
+    SetWriteBarrierKind(instruction, WriteBarrierKind::kDontEmit);
+    MaybeRecordStat(stats_, MethodCompilationStat::kRemovedWriteBarrier);
+  }
+
+  static void SetWriteBarrierKind(HInstruction* instruction, WriteBarrierKind kind) {
+    if (instruction->IsInstanceFieldSet()) {
+      instruction->AsInstanceFieldSet()->SetWriteBarrierKind(kind);
+    } else {
+      DCHECK(instruction->IsStaticFieldSet());
+      instruction->AsStaticFieldSet()->SetWriteBarrierKind(kind);
+    }
+  }
+
+  // Null checks and bound types do not change the address of the holder.
+  static HInstruction* HuntForOriginalReference(HInstruction* ref) {
+    while (ref->IsNullCheck() || ref->IsBoundType()) {
+      ref = ref->InputAt(0);
+    }
+    return ref;
+  }
+
+  ScopedArenaAllocator scoped_allocator_;
+
+  // Maps each holder to the first store in the current block that marks its card. There is no
+  // instruction that can trigger a GC between that store and the current instruction.
+  ScopedArenaHashMap<HInstruction*, HInstruction*> current_write_barriers_;
+
+  // Used to record stats about the optimization.
+  OptimizingCompilerStats* const stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(WBEVisitor);
+};
+
+bool WriteBarrierElimination::Run() {
+  WBEVisitor wbe_visitor(graph_, stats_);
+  wbe_visitor.VisitReversePostOrder();
+  return true;
+}
+
+}  // namespace art
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_WRITE_BARRIER_ELIMINATION_H_
+#define ART_COMPILER_OPTIMIZING_WRITE_BARRIER_ELIMINATION_H_
+
+#include "optimization.h"
+
+namespace art {
+
+/*
+ * Write Barrier Elimination (WBE).
+ *
+ * A local optimization pass that coalesces the card marks of reference stores
+ * to the same holder within the same basic block.
+ *
+ * A card mark only depends on the address of the holder, so when there is no
+ * instruction that can trigger a GC (and thus move the holder or scan the card
+ * table) between two stores to the same holder, the first store can mark the
+ * card for both:
+ * - The first store marks the card unconditionally (`kEmitNoNullCheck`), since
+ *   a later store may write a non-null value even if this one writes null.
+ * - The later stores do not mark the card at all (`kDontEmit`).
+ *
+ * The pass must run after any pass that may reorder instructions, such as
+ * instruction scheduling.
+ */
+class WriteBarrierElimination : public HOptimization {
+ public:
+  WriteBarrierElimination(HGraph* graph,
+                          OptimizingCompilerStats* stats,
+                          const char* name = kWBEPassName)
+      : HOptimization(graph, name, stats) {}
+
+  bool Run() override;
+
+  static constexpr const char* kWBEPassName = "write_barrier_elimination";
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(WriteBarrierElimination);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_WRITE_BARRIER_ELIMINATION_H_
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "write_barrier_elimination.h"
+
+#include "gtest/gtest.h"
+
+#include "nodes.h"
+#include "optimizing_unit_test.h"
+
+namespace art {
+
+class WriteBarrierEliminationTest : public OptimizingUnitTest {
+ protected:
+  // Builds entry -> body -> exit, with the parameters in `entry`. The caller fills `body`.
+  void InitBlocks() {
+    CreateGraph();
+    AdjacencyListGraph blks(SetupFromAdjacencyList(
+        "entry", "exit", {{"entry", "body"}, {"body", "exit"}}));
+    entry_ = blks.Get("entry");
+    body_ = blks.Get("body");
+    SetupExit(blks.Get("exit"));
+    obj_ = MakeParam(DataType::Type::kReference);
+    other_obj_ = MakeParam(DataType::Type::kReference);
+    value_ = MakeParam(DataType::Type::kReference);
+    entry_->AddInstruction(new (GetAllocator()) HGoto());
+  }
+
+  void PerformWBE() {
+    body_->AddInstruction(new (GetAllocator()) HReturnVoid());
+    graph_->BuildDominatorTree();
+    EXPECT_TRUE(CheckGraph());
+    WriteBarrierElimination(graph_, /* stats= */ nullptr).Run();
+  }
+
+  HInstanceFieldSet* AddIFieldSet(HInstruction* obj, HInstruction* value, uint32_t offset) {
+    HInstanceFieldSet* set = MakeIFieldSet(obj, value, MemberOffset(offset));
+    body_->AddInstruction(set);
+    return set;
+  }
+
+  HBasicBlock* entry_ = nullptr;
+  HBasicBlock* body_ = nullptr;
+  HInstruction* obj_ = nullptr;
+  HInstruction* other_obj_ = nullptr;
+  HInstruction* value_ = nullptr;
+};
+
+// obj.a = value;  // Marks the card for both stores, even if `value` is null.
+// obj.b = value;  // No card mark.
+TEST_F(WriteBarrierEliminationTest, CoalesceSameHolder) {
+  InitBlocks();
+  HInstanceFieldSet* first = AddIFieldSet(obj_, value_, 32);
+  HInstanceFieldSet* second = AddIFieldSet(obj_, value_, 40);
+  PerformWBE();
+
+  EXPECT_EQ(first->GetWriteBarrierKind(), WriteBarrierKind::kEmitNoNullCheck);
+  EXPECT_EQ(second->GetWriteBarrierKind(), WriteBarrierKind::kDontEmit);
+}
+
+// obj.a = value;
+// other.b = value;
+// obj.c = value;  // Only marks the card of `obj`, which was already marked.
+TEST_F(WriteBarrierEliminationTest, CoalesceAcrossOtherHolder) {
+  InitBlocks();
+  HInstanceFieldSet* first = AddIFieldSet(obj_, value_, 32);
+  HInstanceFieldSet* other = AddIFieldSet(other_obj_, value_, 32);
+  HInstanceFieldSet* third = AddIFieldSet(obj_, value_, 40);
+  PerformWBE();
+
+  EXPECT_EQ(first->GetWriteBarrierKind(), WriteBarrierKind::kEmitNoNullCheck);
+  EXPECT_EQ(other->GetWriteBarrierKind(), WriteBarrierKind::kEmitWithNullCheck);
+  EXPECT_EQ(third->GetWriteBarrierKind(), WriteBarrierKind::kDontEmit);
+}
+
+// obj.a = null;   // Needs no card mark, so cannot mark it for later stores.
+// obj.b = value;
+// obj.c = 42;     // Not a reference store.
+TEST_F(WriteBarrierEliminationTest, IgnoreStoresWithoutBarrier) {
+  InitBlocks();
+  HInstanceFieldSet* null_set = AddIFieldSet(obj_, graph_->GetNullConstant(), 32);
+  HInstanceFieldSet* ref_set = AddIFieldSet(obj_, value_, 40);
+  HInstanceFieldSet* int_set = AddIFieldSet(obj_, graph_->GetIntConstant(42), 48);
+  PerformWBE();
+
+  EXPECT_EQ(null_set->GetWriteBarrierKind(), WriteBarrierKind::kEmitWithNullCheck);
+  EXPECT_EQ(ref_set->GetWriteBarrierKind(), WriteBarrierKind::kEmitWithNullCheck);
+  EXPECT_EQ(int_set->GetWriteBarrierKind(), WriteBarrierKind::kEmitWithNullCheck);
+}
+
+// obj.a = value;
+// call();         // May trigger a GC and move `obj`.
+// obj.b = value;
+TEST_F(WriteBarrierEliminationTest, KeepAcrossGC) {
+  InitBlocks();
+  HInstanceFieldSet* first = AddIFieldSet(obj_, value_, 32);
+  HInstruction* call = MakeInvoke(DataType::Type::kVoid, {});
+  body_->AddInstruction(call);
+  ManuallyBuildEnvFor(call, {});
+  HInstanceFieldSet* second = AddIFieldSet(obj_, value_, 40);
+  PerformWBE();
+
+  EXPECT_EQ(first->GetWriteBarrierKind(), WriteBarrierKind::kEmitWithNullCheck);
+  EXPECT_EQ(second->GetWriteBarrierKind(), WriteBarrierKind::kEmitWithNullCheck);
+}
+
+// ENTRY:
+//   obj.a = value;
+// BODY:
+//   obj.b = value;  // Card marks are not coalesced across blocks.
+TEST_F(WriteBarrierEliminationTest, KeepAcrossBlocks) {
+  InitBlocks();
+  HInstanceFieldSet* first = MakeIFieldSet(obj_, value_, MemberOffset(32));
+  entry_->InsertInstructionBefore(first, entry_->GetLastInstruction());
+  HInstanceFieldSet* second = AddIFieldSet(obj_, value_, 40);
+  PerformWBE();
+
+  EXPECT_EQ(first->GetWriteBarrierKind(), WriteBarrierKind::kEmitWithNullCheck);
+  EXPECT_EQ(second->GetWriteBarrierKind(), WriteBarrierKind::kEmitWithNullCheck);
+}
+
+}  // namespace art
@@ -28,6 +28,10 @@
 #include "utils/arm64/assembler_arm64.h"
 #endif
 
+#ifdef ART_ENABLE_CODEGEN_loongarch64
+#include "utils/loongarch64/assembler_loongarch64.h"
+#endif
+
 #ifdef ART_ENABLE_CODEGEN_x86
 #include "utils/x86/assembler_x86.h"
 #endif
@@ -130,44 +134,33 @@ static std::unique_ptr<const std::vector<uint8_t>> CreateTrampoline(
 #ifdef ART_ENABLE_CODEGEN_loongarch64
 namespace loongarch64 {
 static std::unique_ptr<const std::vector<uint8_t>> CreateTrampoline(
-    ArenaAllocator* /*allocator*/, EntryPointCallingConvention abi, ThreadOffset64 offset) {
-
-  // TODO(loongarch64): reimplement once we have macro-assembler for LOONGARCH.
-  // do not use the t0 register as it has already been assigned as a hidden register.
-  if (abi == kJniAbi) {
-    // Load via Thread* held in JNIEnv* in first argument (A0).
-    std::unique_ptr<std::vector<uint8_t>> entry_stub(new std::vector<uint8_t>(12));
-    uint8_t* bytes = entry_stub->data();
-
-    // xxxxxxxx     ld.d $t1, $a0, xxx
-    *reinterpret_cast<uint32_t*>(bytes) = 0x28c0008d | ((JNIEnvExt::SelfOffset(8).Int32Value() & 0xfff) << 10);
-    // xxxxxxxx     ld.d $t1, $t1, xxx
-    *reinterpret_cast<uint32_t*>(&bytes[4]) = 0x28c001ad | ((offset.Int32Value() & 0xfff) << 10);
-    // xxxxxxxx     jr $t1
-    *reinterpret_cast<uint32_t*>(&bytes[8]) = 0x4c0001a0;
-
-    return std::move(entry_stub);
-  } else {
-    CHECK_LE(offset.Int32Value(), 0x7ff);
-
-    std::unique_ptr<std::vector<uint8_t>> entry_stub(new std::vector<uint8_t>(8));
-    uint8_t* bytes = entry_stub->data();
-
-    if (abi == kInterpreterAbi) {
-      // Thread* is first argument (A0) in interpreter ABI.
-      // xxxxxxxx     ld.d $t1, $a0, xxx
-      *reinterpret_cast<uint32_t*>(bytes) = 0x28c0008d | ((offset.Int32Value() & 0xfff) << 10);
-    } else {
-      // abi == kQuickAbi: TR holds Thread*.
-      // xxxxxxxx     ld.d $t1, $s1, xxx
-      *reinterpret_cast<uint32_t*>(bytes) = 0x28c0030d  | ((offset.Int32Value() & 0xfff) << 10);
-    }
-
-    // xxxxxxxx    jr $t1
-    *reinterpret_cast<uint32_t*>(&bytes[4]) = 0x4c0001a0;
+    ArenaAllocator* allocator, EntryPointCallingConvention abi, ThreadOffset64 offset) {
+  Loongarch64Assembler assembler(allocator);
 
-    return std::move(entry_stub);
+  // Use TMP as the scratch register; T0 and T8 carry hidden arguments
+  // to @CriticalNative methods and the IMT conflict trampoline.
+  switch (abi) {
+    case kInterpreterAbi:  // Thread* is first argument (A0) in interpreter ABI.
+      __ LoadFromOffset(kLoadDoubleword, TMP, A0, offset.Int32Value());
+      break;
+    case kJniAbi:  // Load via Thread* held in JNIEnv* in first argument (A0).
+      __ LoadFromOffset(kLoadDoubleword, TMP, A0, JNIEnvExt::SelfOffset(8).Int32Value());
+      __ LoadFromOffset(kLoadDoubleword, TMP, TMP, offset.Int32Value());
+      break;
+    case kQuickAbi:  // TR holds Thread*.
+      __ LoadFromOffset(kLoadDoubleword, TMP, TR, offset.Int32Value());
+      break;
   }
+  __ Jr(TMP);
+  __ Break(0);
+
+  __ FinalizeCode();
+  size_t cs = __ CodeSize();
+  std::unique_ptr<std::vector<uint8_t>> entry_stub(new std::vector<uint8_t>(cs));
+  MemoryRegion code(entry_stub->data(), entry_stub->size());
+  __ FinalizeInstructions(code);
+
+  return std::move(entry_stub);
 }
 }  // namespace loongarch64
 #endif  // ART_ENABLE_CODEGEN_loongarch64
@@ -29,6 +29,9 @@ class AssemblerFixup;
 namespace arm64 {
 class Arm64Assembler;
 }  // namespace arm64
+namespace loongarch64 {
+class Loongarch64Assembler;
+}  // namespace loongarch64
 namespace x86 {
 class X86Assembler;
 class NearLabel;
@@ -107,6 +110,7 @@ class Label {
   }
 
   friend class arm64::Arm64Assembler;
+  friend class loongarch64::Loongarch64Assembler;
   friend class x86::X86Assembler;
   friend class x86::NearLabel;
   friend class x86_64::X86_64Assembler;
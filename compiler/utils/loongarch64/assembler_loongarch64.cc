@@ -0,0 +1,2957 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "assembler_loongarch64.h"
+
+#include "base/bit_utils.h"
+#include "base/casts.h"
+#include "base/logging.h"
+#include "base/memory_region.h"
+
+namespace art {
+namespace loongarch64 {
+
+static_assert(kLoongarch64PointerSize == PointerSize::k64, "Unexpected LoongArch64 pointer size.");
+
+void Loongarch64Assembler::FinalizeCode() {
+  Assembler::FinalizeCode();
+  EmitLiterals();
+  PromoteBranches();
+  AlignLongLiterals();
+}
+
+void Loongarch64Assembler::FinalizeInstructions(const MemoryRegion& region) {
+  EmitBranches();
+  Assembler::FinalizeInstructions(region);
+  PatchCFI();
+}
+
+void Loongarch64Assembler::PatchCFI() {
+  if (cfi().NumberOfDelayedAdvancePCs() == 0u) {
+    return;
+  }
+
+  using DelayedAdvancePC = DebugFrameOpCodeWriterForAssembler::DelayedAdvancePC;
+  const auto data = cfi().ReleaseStreamAndPrepareForDelayedAdvancePC();
+  const std::vector<uint8_t>& old_stream = data.first;
+  const std::vector<DelayedAdvancePC>& advances = data.second;
+
+  // Refill our data buffer with patched opcodes.
+  cfi().ReserveCFIStream(old_stream.size() + advances.size() + 16);
+  size_t stream_pos = 0;
+  for (const DelayedAdvancePC& advance : advances) {
+    DCHECK_GE(advance.stream_pos, stream_pos);
+    // Copy old data up to the point where advance was issued.
+    cfi().AppendRawData(old_stream, stream_pos, advance.stream_pos);
+    stream_pos = advance.stream_pos;
+    // Insert the advance command with its final offset.
+    size_t final_pc = GetAdjustedPosition(advance.pc);
+    cfi().AdvancePC(final_pc);
+  }
+  // Copy the final segment if any.
+  cfi().AppendRawData(old_stream, stream_pos, old_stream.size());
+}
+
+void Loongarch64Assembler::Emit(uint32_t value) {
+  if (overwriting_) {
+    // Branches to labels are emitted into their placeholders here.
+    buffer_.Store<uint32_t>(overwrite_location_, value);
+    overwrite_location_ += sizeof(uint32_t);
+  } else {
+    // Other instructions are simply appended at the end here.
+    AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+    buffer_.Emit<uint32_t>(value);
+  }
+}
+
+void Loongarch64Assembler::Emit2R(uint32_t opcode, uint32_t rj, uint32_t rd) {
+  DCHECK_LT(rj, 32u);
+  DCHECK_LT(rd, 32u);
+  Emit(opcode | (rj << 5) | rd);
+}
+
+void Loongarch64Assembler::Emit3R(uint32_t opcode, uint32_t rk, uint32_t rj, uint32_t rd) {
+  DCHECK_LT(rk, 32u);
+  DCHECK_LT(rj, 32u);
+  DCHECK_LT(rd, 32u);
+  Emit(opcode | (rk << 10) | (rj << 5) | rd);
+}
+
+void Loongarch64Assembler::Emit4R(
+    uint32_t opcode, uint32_t ra, uint32_t rk, uint32_t rj, uint32_t rd) {
+  DCHECK_LT(ra, 32u);
+  DCHECK_LT(rk, 32u);
+  DCHECK_LT(rj, 32u);
+  DCHECK_LT(rd, 32u);
+  Emit(opcode | (ra << 15) | (rk << 10) | (rj << 5) | rd);
+}
+
+void Loongarch64Assembler::Emit2RI12(uint32_t opcode, int32_t imm12, uint32_t rj, uint32_t rd) {
+  DCHECK_LT(rj, 32u);
+  DCHECK_LT(rd, 32u);
+  Emit(opcode | ((static_cast<uint32_t>(imm12) & 0xfff) << 10) | (rj << 5) | rd);
+}
+
+void Loongarch64Assembler::Emit2RI14(uint32_t opcode, int32_t imm14, uint32_t rj, uint32_t rd) {
+  CHECK(IsInt<14>(imm14)) << imm14;
+  DCHECK_LT(rj, 32u);
+  DCHECK_LT(rd, 32u);
+  Emit(opcode | ((static_cast<uint32_t>(imm14) & 0x3fff) << 10) | (rj << 5) | rd);
+}
+
+void Loongarch64Assembler::Emit2RI16(uint32_t opcode, int32_t imm16, uint32_t rj, uint32_t rd) {
+  CHECK(IsInt<16>(imm16)) << imm16;
+  DCHECK_LT(rj, 32u);
+  DCHECK_LT(rd, 32u);
+  Emit(opcode | ((static_cast<uint32_t>(imm16) & 0xffff) << 10) | (rj << 5) | rd);
+}
+
+void Loongarch64Assembler::Emit1RI20(uint32_t opcode, int32_t imm20, uint32_t rd) {
+  CHECK(IsInt<20>(imm20)) << imm20;
+  DCHECK_LT(rd, 32u);
+  Emit(opcode | ((static_cast<uint32_t>(imm20) & 0xfffff) << 5) | rd);
+}
+
+void Loongarch64Assembler::Emit1RI21(uint32_t opcode, int32_t imm21, uint32_t rj) {
+  CHECK(IsInt<21>(imm21)) << imm21;
+  DCHECK_LT(rj, 32u);
+  uint32_t imm = static_cast<uint32_t>(imm21);
+  Emit(opcode | ((imm & 0xffff) << 10) | (rj << 5) | ((imm >> 16) & 0x1f));
+}
+
+void Loongarch64Assembler::EmitI26(uint32_t opcode, int32_t imm26) {
+  CHECK(IsInt<26>(imm26)) << imm26;
+  uint32_t imm = static_cast<uint32_t>(imm26);
+  Emit(opcode | ((imm & 0xffff) << 10) | ((imm >> 16) & 0x3ff));
+}
+
+void Loongarch64Assembler::EmitBranch2RI16(uint32_t opcode,
+                                           int32_t offset,
+                                           uint32_t rj,
+                                           uint32_t rd) {
+  CHECK(IsAligned<4>(offset)) << offset;
+  Emit2RI16(opcode, offset >> 2, rj, rd);
+}
+
+/////////////////////////////// LoongArch64 instructions ///////////////////////////////
+
+void Loongarch64Assembler::AddW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00100000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AddD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00108000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::SubW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00110000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::SubD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00118000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Slt(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00120000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Sltu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00128000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Maskeqz(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00130000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Masknez(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00138000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Nor(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00140000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::And(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00148000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Or(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00150000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Xor(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00158000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Orn(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00160000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Andn(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00168000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::SllW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00170000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::SrlW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00178000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::SraW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00180000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::SllD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00188000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::SrlD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00190000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::SraD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00198000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::RotrW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x001b0000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::RotrD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x001b8000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::MulW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x001c0000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::MulhW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x001c8000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::MulhWu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x001d0000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::MulD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x001d8000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::MulhD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x001e0000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::MulhDu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x001e8000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::DivW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00200000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::ModW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00208000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::DivWu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00210000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::ModWu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00218000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::DivD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00220000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::ModD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00228000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::DivDu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00230000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::ModDu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x00238000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AlslW(XRegister rd, XRegister rj, XRegister rk, int sa) {
+  CHECK(1 <= sa && sa <= 4) << sa;
+  Emit3R(0x00040000 | (static_cast<uint32_t>(sa - 1) << 15), rk, rj, rd);
+}
+
+void Loongarch64Assembler::AlslWu(XRegister rd, XRegister rj, XRegister rk, int sa) {
+  CHECK(1 <= sa && sa <= 4) << sa;
+  Emit3R(0x00060000 | (static_cast<uint32_t>(sa - 1) << 15), rk, rj, rd);
+}
+
+void Loongarch64Assembler::AlslD(XRegister rd, XRegister rj, XRegister rk, int sa) {
+  CHECK(1 <= sa && sa <= 4) << sa;
+  Emit3R(0x002c0000 | (static_cast<uint32_t>(sa - 1) << 15), rk, rj, rd);
+}
+
+void Loongarch64Assembler::CloW(XRegister rd, XRegister rj) {
+  Emit2R(0x00001000, rj, rd);
+}
+
+void Loongarch64Assembler::ClzW(XRegister rd, XRegister rj) {
+  Emit2R(0x00001400, rj, rd);
+}
+
+void Loongarch64Assembler::CtoW(XRegister rd, XRegister rj) {
+  Emit2R(0x00001800, rj, rd);
+}
+
+void Loongarch64Assembler::CtzW(XRegister rd, XRegister rj) {
+  Emit2R(0x00001c00, rj, rd);
+}
+
+void Loongarch64Assembler::CloD(XRegister rd, XRegister rj) {
+  Emit2R(0x00002000, rj, rd);
+}
+
+void Loongarch64Assembler::ClzD(XRegister rd, XRegister rj) {
+  Emit2R(0x00002400, rj, rd);
+}
+
+void Loongarch64Assembler::CtoD(XRegister rd, XRegister rj) {
+  Emit2R(0x00002800, rj, rd);
+}
+
+void Loongarch64Assembler::CtzD(XRegister rd, XRegister rj) {
+  Emit2R(0x00002c00, rj, rd);
+}
+
+void Loongarch64Assembler::Revb2H(XRegister rd, XRegister rj) {
+  Emit2R(0x00003000, rj, rd);
+}
+
+void Loongarch64Assembler::Revb4H(XRegister rd, XRegister rj) {
+  Emit2R(0x00003400, rj, rd);
+}
+
+void Loongarch64Assembler::Revb2W(XRegister rd, XRegister rj) {
+  Emit2R(0x00003800, rj, rd);
+}
+
+void Loongarch64Assembler::RevbD(XRegister rd, XRegister rj) {
+  Emit2R(0x00003c00, rj, rd);
+}
+
+void Loongarch64Assembler::Revh2W(XRegister rd, XRegister rj) {
+  Emit2R(0x00004000, rj, rd);
+}
+
+void Loongarch64Assembler::RevhD(XRegister rd, XRegister rj) {
+  Emit2R(0x00004400, rj, rd);
+}
+
+void Loongarch64Assembler::Bitrev4B(XRegister rd, XRegister rj) {
+  Emit2R(0x00004800, rj, rd);
+}
+
+void Loongarch64Assembler::Bitrev8B(XRegister rd, XRegister rj) {
+  Emit2R(0x00004c00, rj, rd);
+}
+
+void Loongarch64Assembler::BitrevW(XRegister rd, XRegister rj) {
+  Emit2R(0x00005000, rj, rd);
+}
+
+void Loongarch64Assembler::BitrevD(XRegister rd, XRegister rj) {
+  Emit2R(0x00005400, rj, rd);
+}
+
+void Loongarch64Assembler::ExtWH(XRegister rd, XRegister rj) {
+  Emit2R(0x00005800, rj, rd);
+}
+
+void Loongarch64Assembler::ExtWB(XRegister rd, XRegister rj) {
+  Emit2R(0x00005c00, rj, rd);
+}
+
+void Loongarch64Assembler::SlliW(XRegister rd, XRegister rj, int shamt) {
+  CHECK(IsUint<5>(shamt)) << shamt;
+  Emit2R(0x00408000 | (static_cast<uint32_t>(shamt) << 10), rj, rd);
+}
+
+void Loongarch64Assembler::SlliD(XRegister rd, XRegister rj, int shamt) {
+  CHECK(IsUint<6>(shamt)) << shamt;
+  Emit2R(0x00410000 | (static_cast<uint32_t>(shamt) << 10), rj, rd);
+}
+
+void Loongarch64Assembler::SrliW(XRegister rd, XRegister rj, int shamt) {
+  CHECK(IsUint<5>(shamt)) << shamt;
+  Emit2R(0x00448000 | (static_cast<uint32_t>(shamt) << 10), rj, rd);
+}
+
+void Loongarch64Assembler::SrliD(XRegister rd, XRegister rj, int shamt) {
+  CHECK(IsUint<6>(shamt)) << shamt;
+  Emit2R(0x00450000 | (static_cast<uint32_t>(shamt) << 10), rj, rd);
+}
+
+void Loongarch64Assembler::SraiW(XRegister rd, XRegister rj, int shamt) {
+  CHECK(IsUint<5>(shamt)) << shamt;
+  Emit2R(0x00488000 | (static_cast<uint32_t>(shamt) << 10), rj, rd);
+}
+
+void Loongarch64Assembler::SraiD(XRegister rd, XRegister rj, int shamt) {
+  CHECK(IsUint<6>(shamt)) << shamt;
+  Emit2R(0x00490000 | (static_cast<uint32_t>(shamt) << 10), rj, rd);
+}
+
+void Loongarch64Assembler::RotriW(XRegister rd, XRegister rj, int shamt) {
+  CHECK(IsUint<5>(shamt)) << shamt;
+  Emit2R(0x004c8000 | (static_cast<uint32_t>(shamt) << 10), rj, rd);
+}
+
+void Loongarch64Assembler::RotriD(XRegister rd, XRegister rj, int shamt) {
+  CHECK(IsUint<6>(shamt)) << shamt;
+  Emit2R(0x004d0000 | (static_cast<uint32_t>(shamt) << 10), rj, rd);
+}
+
+void Loongarch64Assembler::BstrinsW(XRegister rd, XRegister rj, int msb, int lsb) {
+  CHECK(0 <= lsb && lsb <= msb && msb < 32) << msb << " " << lsb;
+  Emit2R(0x00600000 | (static_cast<uint32_t>(msb) << 16) | (static_cast<uint32_t>(lsb) << 10),
+         rj,
+         rd);
+}
+
+void Loongarch64Assembler::BstrpickW(XRegister rd, XRegister rj, int msb, int lsb) {
+  CHECK(0 <= lsb && lsb <= msb && msb < 32) << msb << " " << lsb;
+  Emit2R(0x00608000 | (static_cast<uint32_t>(msb) << 16) | (static_cast<uint32_t>(lsb) << 10),
+         rj,
+         rd);
+}
+
+void Loongarch64Assembler::BstrinsD(XRegister rd, XRegister rj, int msb, int lsb) {
+  CHECK(0 <= lsb && lsb <= msb && msb < 64) << msb << " " << lsb;
+  Emit2R(0x00800000 | (static_cast<uint32_t>(msb) << 16) | (static_cast<uint32_t>(lsb) << 10),
+         rj,
+         rd);
+}
+
+void Loongarch64Assembler::BstrpickD(XRegister rd, XRegister rj, int msb, int lsb) {
+  CHECK(0 <= lsb && lsb <= msb && msb < 64) << msb << " " << lsb;
+  Emit2R(0x00c00000 | (static_cast<uint32_t>(msb) << 16) | (static_cast<uint32_t>(lsb) << 10),
+         rj,
+         rd);
+}
+
+void Loongarch64Assembler::Slti(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x02000000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::Sltui(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x02400000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::AddiW(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x02800000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::AddiD(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x02c00000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::Lu52iD(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x03000000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::Andi(XRegister rd, XRegister rj, uint32_t ui12) {
+  CHECK(IsUint<12>(ui12)) << ui12;
+  Emit2RI12(0x03400000, static_cast<int32_t>(ui12), rj, rd);
+}
+
+void Loongarch64Assembler::Ori(XRegister rd, XRegister rj, uint32_t ui12) {
+  CHECK(IsUint<12>(ui12)) << ui12;
+  Emit2RI12(0x03800000, static_cast<int32_t>(ui12), rj, rd);
+}
+
+void Loongarch64Assembler::Xori(XRegister rd, XRegister rj, uint32_t ui12) {
+  CHECK(IsUint<12>(ui12)) << ui12;
+  Emit2RI12(0x03c00000, static_cast<int32_t>(ui12), rj, rd);
+}
+
+void Loongarch64Assembler::Addu16iD(XRegister rd, XRegister rj, int32_t si16) {
+  Emit2RI16(0x10000000, si16, rj, rd);
+}
+
+void Loongarch64Assembler::Lu12iW(XRegister rd, int32_t si20) {
+  Emit1RI20(0x14000000, si20, rd);
+}
+
+void Loongarch64Assembler::Lu32iD(XRegister rd, int32_t si20) {
+  Emit1RI20(0x16000000, si20, rd);
+}
+
+void Loongarch64Assembler::Pcaddi(XRegister rd, int32_t si20) {
+  Emit1RI20(0x18000000, si20, rd);
+}
+
+void Loongarch64Assembler::Pcalau12i(XRegister rd, int32_t si20) {
+  Emit1RI20(0x1a000000, si20, rd);
+}
+
+void Loongarch64Assembler::Pcaddu12i(XRegister rd, int32_t si20) {
+  Emit1RI20(0x1c000000, si20, rd);
+}
+
+void Loongarch64Assembler::Pcaddu18i(XRegister rd, int32_t si20) {
+  Emit1RI20(0x1e000000, si20, rd);
+}
+
+void Loongarch64Assembler::LdB(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x28000000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::LdH(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x28400000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::LdW(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x28800000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::LdD(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x28c00000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::LdBu(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2a000000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::LdHu(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2a400000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::LdWu(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2a800000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::StB(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x29000000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::StH(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x29400000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::StW(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x29800000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::StD(XRegister rd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x29c00000, si12, rj, rd);
+}
+
+void Loongarch64Assembler::LdxB(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38000000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::LdxH(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38040000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::LdxW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38080000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::LdxD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x380c0000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::LdxBu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38200000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::LdxHu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38240000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::LdxWu(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38280000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::StxB(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38100000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::StxH(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38140000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::StxW(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x38180000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::StxD(XRegister rd, XRegister rj, XRegister rk) {
+  Emit3R(0x381c0000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::LdptrW(XRegister rd, XRegister rj, int32_t si14) {
+  CHECK(IsAligned<4>(si14)) << si14;
+  Emit2RI14(0x24000000, si14 >> 2, rj, rd);
+}
+
+void Loongarch64Assembler::LdptrD(XRegister rd, XRegister rj, int32_t si14) {
+  CHECK(IsAligned<4>(si14)) << si14;
+  Emit2RI14(0x26000000, si14 >> 2, rj, rd);
+}
+
+void Loongarch64Assembler::StptrW(XRegister rd, XRegister rj, int32_t si14) {
+  CHECK(IsAligned<4>(si14)) << si14;
+  Emit2RI14(0x25000000, si14 >> 2, rj, rd);
+}
+
+void Loongarch64Assembler::StptrD(XRegister rd, XRegister rj, int32_t si14) {
+  CHECK(IsAligned<4>(si14)) << si14;
+  Emit2RI14(0x27000000, si14 >> 2, rj, rd);
+}
+
+void Loongarch64Assembler::LlW(XRegister rd, XRegister rj, int32_t si14) {
+  CHECK(IsAligned<4>(si14)) << si14;
+  Emit2RI14(0x20000000, si14 >> 2, rj, rd);
+}
+
+void Loongarch64Assembler::LlD(XRegister rd, XRegister rj, int32_t si14) {
+  CHECK(IsAligned<4>(si14)) << si14;
+  Emit2RI14(0x22000000, si14 >> 2, rj, rd);
+}
+
+void Loongarch64Assembler::ScW(XRegister rd, XRegister rj, int32_t si14) {
+  CHECK(IsAligned<4>(si14)) << si14;
+  Emit2RI14(0x21000000, si14 >> 2, rj, rd);
+}
+
+void Loongarch64Assembler::ScD(XRegister rd, XRegister rj, int32_t si14) {
+  CHECK(IsAligned<4>(si14)) << si14;
+  Emit2RI14(0x23000000, si14 >> 2, rj, rd);
+}
+
+void Loongarch64Assembler::AmswapW(XRegister rd, XRegister rk, XRegister rj) {
+  Emit3R(0x38600000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AmswapD(XRegister rd, XRegister rk, XRegister rj) {
+  Emit3R(0x38608000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AmaddW(XRegister rd, XRegister rk, XRegister rj) {
+  Emit3R(0x38610000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AmaddD(XRegister rd, XRegister rk, XRegister rj) {
+  Emit3R(0x38618000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AmswapDbW(XRegister rd, XRegister rk, XRegister rj) {
+  Emit3R(0x38690000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AmswapDbD(XRegister rd, XRegister rk, XRegister rj) {
+  Emit3R(0x38698000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AmaddDbW(XRegister rd, XRegister rk, XRegister rj) {
+  Emit3R(0x386a0000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::AmaddDbD(XRegister rd, XRegister rk, XRegister rj) {
+  Emit3R(0x386a8000, rk, rj, rd);
+}
+
+void Loongarch64Assembler::Dbar(uint32_t hint) {
+  CHECK(IsUint<15>(hint)) << hint;
+  Emit(0x38720000 | hint);
+}
+
+void Loongarch64Assembler::Ibar(uint32_t hint) {
+  CHECK(IsUint<15>(hint)) << hint;
+  Emit(0x38728000 | hint);
+}
+
+void Loongarch64Assembler::Jirl(XRegister rd, XRegister rj, int32_t offset) {
+  EmitBranch2RI16(0x4c000000, offset, rj, rd);
+}
+
+void Loongarch64Assembler::B(int32_t offset) {
+  CHECK(IsAligned<4>(offset)) << offset;
+  EmitI26(0x50000000, offset >> 2);
+}
+
+void Loongarch64Assembler::Bl(int32_t offset) {
+  CHECK(IsAligned<4>(offset)) << offset;
+  EmitI26(0x54000000, offset >> 2);
+}
+
+void Loongarch64Assembler::Beq(XRegister rj, XRegister rd, int32_t offset) {
+  EmitBranch2RI16(0x58000000, offset, rj, rd);
+}
+
+void Loongarch64Assembler::Bne(XRegister rj, XRegister rd, int32_t offset) {
+  EmitBranch2RI16(0x5c000000, offset, rj, rd);
+}
+
+void Loongarch64Assembler::Blt(XRegister rj, XRegister rd, int32_t offset) {
+  EmitBranch2RI16(0x60000000, offset, rj, rd);
+}
+
+void Loongarch64Assembler::Bge(XRegister rj, XRegister rd, int32_t offset) {
+  EmitBranch2RI16(0x64000000, offset, rj, rd);
+}
+
+void Loongarch64Assembler::Bltu(XRegister rj, XRegister rd, int32_t offset) {
+  EmitBranch2RI16(0x68000000, offset, rj, rd);
+}
+
+void Loongarch64Assembler::Bgeu(XRegister rj, XRegister rd, int32_t offset) {
+  EmitBranch2RI16(0x6c000000, offset, rj, rd);
+}
+
+void Loongarch64Assembler::Beqz(XRegister rj, int32_t offset) {
+  CHECK(IsAligned<4>(offset)) << offset;
+  Emit1RI21(0x40000000, offset >> 2, rj);
+}
+
+void Loongarch64Assembler::Bnez(XRegister rj, int32_t offset) {
+  CHECK(IsAligned<4>(offset)) << offset;
+  Emit1RI21(0x44000000, offset >> 2, rj);
+}
+
+void Loongarch64Assembler::Bceqz(FccRegister cj, int32_t offset) {
+  CHECK(IsAligned<4>(offset)) << offset;
+  DCHECK_LT(static_cast<uint32_t>(cj), 8u);
+  Emit1RI21(0x48000000, offset >> 2, static_cast<uint32_t>(cj));
+}
+
+void Loongarch64Assembler::Bcnez(FccRegister cj, int32_t offset) {
+  CHECK(IsAligned<4>(offset)) << offset;
+  DCHECK_LT(static_cast<uint32_t>(cj), 8u);
+  Emit1RI21(0x48000000, offset >> 2, 0x8u | static_cast<uint32_t>(cj));
+}
+
+void Loongarch64Assembler::Break(uint32_t code) {
+  CHECK(IsUint<15>(code)) << code;
+  Emit(0x002a0000 | code);
+}
+
+void Loongarch64Assembler::FaddS(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01008000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FaddD(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01010000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FsubS(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01028000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FsubD(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01030000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FmulS(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01048000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FmulD(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01050000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FdivS(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01068000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FdivD(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01070000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FmaxS(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01088000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FmaxD(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01090000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FminS(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x010a8000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FminD(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x010b0000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FcopysignS(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01128000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FcopysignD(FRegister fd, FRegister fj, FRegister fk) {
+  Emit3R(0x01130000, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FmaddS(FRegister fd, FRegister fj, FRegister fk, FRegister fa) {
+  Emit4R(0x08100000, fa, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FmaddD(FRegister fd, FRegister fj, FRegister fk, FRegister fa) {
+  Emit4R(0x08200000, fa, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FmsubS(FRegister fd, FRegister fj, FRegister fk, FRegister fa) {
+  Emit4R(0x08500000, fa, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FmsubD(FRegister fd, FRegister fj, FRegister fk, FRegister fa) {
+  Emit4R(0x08600000, fa, fk, fj, fd);
+}
+
+void Loongarch64Assembler::FabsS(FRegister fd, FRegister fj) {
+  Emit2R(0x01140400, fj, fd);
+}
+
+void Loongarch64Assembler::FabsD(FRegister fd, FRegister fj) {
+  Emit2R(0x01140800, fj, fd);
+}
+
+void Loongarch64Assembler::FnegS(FRegister fd, FRegister fj) {
+  Emit2R(0x01141400, fj, fd);
+}
+
+void Loongarch64Assembler::FnegD(FRegister fd, FRegister fj) {
+  Emit2R(0x01141800, fj, fd);
+}
+
+void Loongarch64Assembler::FclassS(FRegister fd, FRegister fj) {
+  Emit2R(0x01143400, fj, fd);
+}
+
+void Loongarch64Assembler::FclassD(FRegister fd, FRegister fj) {
+  Emit2R(0x01143800, fj, fd);
+}
+
+void Loongarch64Assembler::FsqrtS(FRegister fd, FRegister fj) {
+  Emit2R(0x01144400, fj, fd);
+}
+
+void Loongarch64Assembler::FsqrtD(FRegister fd, FRegister fj) {
+  Emit2R(0x01144800, fj, fd);
+}
+
+void Loongarch64Assembler::FmovS(FRegister fd, FRegister fj) {
+  Emit2R(0x01149400, fj, fd);
+}
+
+void Loongarch64Assembler::FmovD(FRegister fd, FRegister fj) {
+  Emit2R(0x01149800, fj, fd);
+}
+
+void Loongarch64Assembler::FcmpS(FpCondition cond, FccRegister cd, FRegister fj, FRegister fk) {
+  DCHECK_LT(static_cast<uint32_t>(cd), 8u);
+  Emit3R(0x0c100000 | (static_cast<uint32_t>(cond) << 15), fk, fj, static_cast<uint32_t>(cd));
+}
+
+void Loongarch64Assembler::FcmpD(FpCondition cond, FccRegister cd, FRegister fj, FRegister fk) {
+  DCHECK_LT(static_cast<uint32_t>(cd), 8u);
+  Emit3R(0x0c200000 | (static_cast<uint32_t>(cond) << 15), fk, fj, static_cast<uint32_t>(cd));
+}
+
+void Loongarch64Assembler::Fsel(FRegister fd, FRegister fj, FRegister fk, FccRegister ca) {
+  DCHECK_LT(static_cast<uint32_t>(ca), 8u);
+  Emit4R(0x0d000000, static_cast<uint32_t>(ca), fk, fj, fd);
+}
+
+void Loongarch64Assembler::FcvtSD(FRegister fd, FRegister fj) {
+  Emit2R(0x01191800, fj, fd);
+}
+
+void Loongarch64Assembler::FcvtDS(FRegister fd, FRegister fj) {
+  Emit2R(0x01192400, fj, fd);
+}
+
+void Loongarch64Assembler::FtintrzWS(FRegister fd, FRegister fj) {
+  Emit2R(0x011a8400, fj, fd);
+}
+
+void Loongarch64Assembler::FtintrzWD(FRegister fd, FRegister fj) {
+  Emit2R(0x011a8800, fj, fd);
+}
+
+void Loongarch64Assembler::FtintrzLS(FRegister fd, FRegister fj) {
+  Emit2R(0x011aa400, fj, fd);
+}
+
+void Loongarch64Assembler::FtintrzLD(FRegister fd, FRegister fj) {
+  Emit2R(0x011aa800, fj, fd);
+}
+
+void Loongarch64Assembler::FfintSW(FRegister fd, FRegister fj) {
+  Emit2R(0x011d1000, fj, fd);
+}
+
+void Loongarch64Assembler::FfintSL(FRegister fd, FRegister fj) {
+  Emit2R(0x011d1800, fj, fd);
+}
+
+void Loongarch64Assembler::FfintDW(FRegister fd, FRegister fj) {
+  Emit2R(0x011d2000, fj, fd);
+}
+
+void Loongarch64Assembler::FfintDL(FRegister fd, FRegister fj) {
+  Emit2R(0x011d2800, fj, fd);
+}
+
+void Loongarch64Assembler::FrintS(FRegister fd, FRegister fj) {
+  Emit2R(0x011e4400, fj, fd);
+}
+
+void Loongarch64Assembler::FrintD(FRegister fd, FRegister fj) {
+  Emit2R(0x011e4800, fj, fd);
+}
+
+void Loongarch64Assembler::Movgr2frW(FRegister fd, XRegister rj) {
+  Emit2R(0x0114a400, rj, fd);
+}
+
+void Loongarch64Assembler::Movgr2frD(FRegister fd, XRegister rj) {
+  Emit2R(0x0114a800, rj, fd);
+}
+
+void Loongarch64Assembler::Movgr2frhW(FRegister fd, XRegister rj) {
+  Emit2R(0x0114ac00, rj, fd);
+}
+
+void Loongarch64Assembler::Movfr2grS(XRegister rd, FRegister fj) {
+  Emit2R(0x0114b400, fj, rd);
+}
+
+void Loongarch64Assembler::Movfr2grD(XRegister rd, FRegister fj) {
+  Emit2R(0x0114b800, fj, rd);
+}
+
+void Loongarch64Assembler::Movfrh2grS(XRegister rd, FRegister fj) {
+  Emit2R(0x0114bc00, fj, rd);
+}
+
+void Loongarch64Assembler::Movgr2cf(FccRegister cd, XRegister rj) {
+  DCHECK_LT(static_cast<uint32_t>(cd), 8u);
+  Emit2R(0x0114d800, rj, static_cast<uint32_t>(cd));
+}
+
+void Loongarch64Assembler::Movcf2gr(XRegister rd, FccRegister cj) {
+  DCHECK_LT(static_cast<uint32_t>(cj), 8u);
+  Emit2R(0x0114dc00, static_cast<uint32_t>(cj), rd);
+}
+
+void Loongarch64Assembler::FldS(FRegister fd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2b000000, si12, rj, fd);
+}
+
+void Loongarch64Assembler::FldD(FRegister fd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2b800000, si12, rj, fd);
+}
+
+void Loongarch64Assembler::FstS(FRegister fd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2b400000, si12, rj, fd);
+}
+
+void Loongarch64Assembler::FstD(FRegister fd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2bc00000, si12, rj, fd);
+}
+
+void Loongarch64Assembler::FldxS(FRegister fd, XRegister rj, XRegister rk) {
+  Emit3R(0x38300000, rk, rj, fd);
+}
+
+void Loongarch64Assembler::FldxD(FRegister fd, XRegister rj, XRegister rk) {
+  Emit3R(0x38340000, rk, rj, fd);
+}
+
+void Loongarch64Assembler::FstxS(FRegister fd, XRegister rj, XRegister rk) {
+  Emit3R(0x38380000, rk, rj, fd);
+}
+
+void Loongarch64Assembler::FstxD(FRegister fd, XRegister rj, XRegister rk) {
+  Emit3R(0x383c0000, rk, rj, fd);
+}
+
+/////////////////////////////// LoongArch64 LSX instructions ///////////////////////////////
+
+void Loongarch64Assembler::VaddB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x700a0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VaddH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x700a8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VaddW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x700b0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VaddD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x700b8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsubB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x700c0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsubH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x700c8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsubW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x700d0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsubD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x700d8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70840000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70848000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70850000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70858000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70a80000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70a88000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70a90000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70a98000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmsubB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70aa0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmsubH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70aa8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmsubW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70ab0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmsubD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70ab8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsigncovB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x712e0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsigncovH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x712e8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsigncovW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x712f0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsigncovD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x712f8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VminB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70720000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VminH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70728000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VminW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70730000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VminD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70738000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VminBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70760000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VminHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70768000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VminWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70770000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VminDu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70778000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaxB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70700000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaxH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70708000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaxW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70710000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaxD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70718000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaxBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70740000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaxHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70748000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaxWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70750000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaxDu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70758000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsaddB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70460000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsaddH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70468000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsaddW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70470000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsaddD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70478000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsaddBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x704a0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsaddHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x704a8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsaddWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x704b0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VsaddDu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x704b8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VssubB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70480000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VssubH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70488000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VssubW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70490000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VssubD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70498000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VssubBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x704c0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VssubHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x704c8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VssubWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x704d0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VssubDu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x704d8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70640000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70648000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70650000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70658000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70660000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70668000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70670000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgDu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70678000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgrB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70680000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgrH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70688000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgrW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70690000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgrD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70698000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgrBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x706a0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgrHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x706a8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgrWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x706b0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VavgrDu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x706b8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VabsdB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70600000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VabsdH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70608000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VabsdW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70610000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VabsdD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70618000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VabsdBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70620000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VabsdHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70628000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VabsdWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70630000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VabsdDu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70638000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VhaddwHB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70540000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VhaddwWH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70548000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VhaddwDW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70550000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VhaddwQD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70558000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VhaddwHuBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70580000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VhaddwWuHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70588000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VhaddwDuWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70590000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VhaddwQuDu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70598000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwevHB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70900000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwevWH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70908000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwevDW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70910000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwevHBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70980000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwevWHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70988000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwevDWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70990000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwodHB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70920000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwodWH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70928000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwodDW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70930000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwodHBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x709a0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwodWHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x709a8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmulwodDWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x709b0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwevHB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70ac0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwevWH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70ac8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwevDW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70ad0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwevHBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70b40000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwevWHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70b48000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwevDWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70b50000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwodHB(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70ae0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwodWH(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70ae8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwodDW(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70af0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwodHBu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70b60000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwodWHu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70b68000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VmaddwodDWu(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x70b70000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VandV(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71260000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VorV(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71268000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VxorV(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71270000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VnorV(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71278000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VandnV(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71280000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfaddS(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71308000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfaddD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71310000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfsubS(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71328000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfsubD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71330000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfmulS(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71388000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfmulD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x71390000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfdivS(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x713a8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfdivD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x713b0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfminS(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x713e8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfminD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x713f0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfmaxS(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x713c8000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VfmaxD(VRegister vd, VRegister vj, VRegister vk) {
+  Emit3R(0x713d0000, vk, vj, vd);
+}
+
+void Loongarch64Assembler::VffintSW(VRegister vd, VRegister vj) {
+  Emit2R(0x729e0000, vj, vd);
+}
+
+void Loongarch64Assembler::VffintDL(VRegister vd, VRegister vj) {
+  Emit2R(0x729e0800, vj, vd);
+}
+
+void Loongarch64Assembler::VftintrzWS(VRegister vd, VRegister vj) {
+  Emit2R(0x729e4800, vj, vd);
+}
+
+void Loongarch64Assembler::VftintrzLD(VRegister vd, VRegister vj) {
+  Emit2R(0x729e4c00, vj, vd);
+}
+
+void Loongarch64Assembler::VnegB(VRegister vd, VRegister vj) {
+  Emit2R(0x729c3000, vj, vd);
+}
+
+void Loongarch64Assembler::VnegH(VRegister vd, VRegister vj) {
+  Emit2R(0x729c3400, vj, vd);
+}
+
+void Loongarch64Assembler::VnegW(VRegister vd, VRegister vj) {
+  Emit2R(0x729c3800, vj, vd);
+}
+
+void Loongarch64Assembler::VnegD(VRegister vd, VRegister vj) {
+  Emit2R(0x729c3c00, vj, vd);
+}
+
+void Loongarch64Assembler::Vreplgr2vrB(VRegister vd, XRegister rj) {
+  Emit2R(0x729f0000, rj, vd);
+}
+
+void Loongarch64Assembler::Vreplgr2vrH(VRegister vd, XRegister rj) {
+  Emit2R(0x729f0400, rj, vd);
+}
+
+void Loongarch64Assembler::Vreplgr2vrW(VRegister vd, XRegister rj) {
+  Emit2R(0x729f0800, rj, vd);
+}
+
+void Loongarch64Assembler::Vreplgr2vrD(VRegister vd, XRegister rj) {
+  Emit2R(0x729f0c00, rj, vd);
+}
+
+void Loongarch64Assembler::VreplveiB(VRegister vd, VRegister vj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x72f78000 | (static_cast<uint32_t>(ui4) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VreplveiH(VRegister vd, VRegister vj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x72f7c000 | (static_cast<uint32_t>(ui3) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VreplveiW(VRegister vd, VRegister vj, int ui2) {
+  CHECK(IsUint<2>(ui2)) << ui2;
+  Emit2R(0x72f7e000 | (static_cast<uint32_t>(ui2) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VreplveiD(VRegister vd, VRegister vj, int ui1) {
+  CHECK(IsUint<1>(ui1)) << ui1;
+  Emit2R(0x72f7f000 | (static_cast<uint32_t>(ui1) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::Vinsgr2vrB(VRegister vd, XRegister rj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x72eb8000 | (static_cast<uint32_t>(ui4) << 10), rj, vd);
+}
+
+void Loongarch64Assembler::Vinsgr2vrH(VRegister vd, XRegister rj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x72ebc000 | (static_cast<uint32_t>(ui3) << 10), rj, vd);
+}
+
+void Loongarch64Assembler::Vinsgr2vrW(VRegister vd, XRegister rj, int ui2) {
+  CHECK(IsUint<2>(ui2)) << ui2;
+  Emit2R(0x72ebe000 | (static_cast<uint32_t>(ui2) << 10), rj, vd);
+}
+
+void Loongarch64Assembler::Vinsgr2vrD(VRegister vd, XRegister rj, int ui1) {
+  CHECK(IsUint<1>(ui1)) << ui1;
+  Emit2R(0x72ebf000 | (static_cast<uint32_t>(ui1) << 10), rj, vd);
+}
+
+void Loongarch64Assembler::Vpickve2grB(XRegister rd, VRegister vj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x72ef8000 | (static_cast<uint32_t>(ui4) << 10), vj, rd);
+}
+
+void Loongarch64Assembler::Vpickve2grH(XRegister rd, VRegister vj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x72efc000 | (static_cast<uint32_t>(ui3) << 10), vj, rd);
+}
+
+void Loongarch64Assembler::Vpickve2grW(XRegister rd, VRegister vj, int ui2) {
+  CHECK(IsUint<2>(ui2)) << ui2;
+  Emit2R(0x72efe000 | (static_cast<uint32_t>(ui2) << 10), vj, rd);
+}
+
+void Loongarch64Assembler::Vpickve2grD(XRegister rd, VRegister vj, int ui1) {
+  CHECK(IsUint<1>(ui1)) << ui1;
+  Emit2R(0x72eff000 | (static_cast<uint32_t>(ui1) << 10), vj, rd);
+}
+
+void Loongarch64Assembler::Vpickve2grBu(XRegister rd, VRegister vj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x72f38000 | (static_cast<uint32_t>(ui4) << 10), vj, rd);
+}
+
+void Loongarch64Assembler::Vpickve2grHu(XRegister rd, VRegister vj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x72f3c000 | (static_cast<uint32_t>(ui3) << 10), vj, rd);
+}
+
+void Loongarch64Assembler::Vpickve2grWu(XRegister rd, VRegister vj, int ui2) {
+  CHECK(IsUint<2>(ui2)) << ui2;
+  Emit2R(0x72f3e000 | (static_cast<uint32_t>(ui2) << 10), vj, rd);
+}
+
+void Loongarch64Assembler::Vpickve2grDu(XRegister rd, VRegister vj, int ui1) {
+  CHECK(IsUint<1>(ui1)) << ui1;
+  Emit2R(0x72f3f000 | (static_cast<uint32_t>(ui1) << 10), vj, rd);
+}
+
+void Loongarch64Assembler::VrepliB(VRegister vd, int32_t si10) {
+  CHECK(IsInt<10>(si10)) << si10;
+  Emit(0x73e00000 | ((static_cast<uint32_t>(si10) & 0x3ff) << 5) | static_cast<uint32_t>(vd));
+}
+
+void Loongarch64Assembler::VrepliH(VRegister vd, int32_t si10) {
+  CHECK(IsInt<10>(si10)) << si10;
+  Emit(0x73e08000 | ((static_cast<uint32_t>(si10) & 0x3ff) << 5) | static_cast<uint32_t>(vd));
+}
+
+void Loongarch64Assembler::VrepliW(VRegister vd, int32_t si10) {
+  CHECK(IsInt<10>(si10)) << si10;
+  Emit(0x73e10000 | ((static_cast<uint32_t>(si10) & 0x3ff) << 5) | static_cast<uint32_t>(vd));
+}
+
+void Loongarch64Assembler::VrepliD(VRegister vd, int32_t si10) {
+  CHECK(IsInt<10>(si10)) << si10;
+  Emit(0x73e18000 | ((static_cast<uint32_t>(si10) & 0x3ff) << 5) | static_cast<uint32_t>(vd));
+}
+
+void Loongarch64Assembler::VslliB(VRegister vd, VRegister vj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x732c2000 | (static_cast<uint32_t>(ui3) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VslliH(VRegister vd, VRegister vj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x732c4000 | (static_cast<uint32_t>(ui4) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VslliW(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x732c8000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VslliD(VRegister vd, VRegister vj, int ui6) {
+  CHECK(IsUint<6>(ui6)) << ui6;
+  Emit2R(0x732d0000 | (static_cast<uint32_t>(ui6) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsrliB(VRegister vd, VRegister vj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x73302000 | (static_cast<uint32_t>(ui3) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsrliH(VRegister vd, VRegister vj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x73304000 | (static_cast<uint32_t>(ui4) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsrliW(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x73308000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsrliD(VRegister vd, VRegister vj, int ui6) {
+  CHECK(IsUint<6>(ui6)) << ui6;
+  Emit2R(0x73310000 | (static_cast<uint32_t>(ui6) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsraiB(VRegister vd, VRegister vj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x73342000 | (static_cast<uint32_t>(ui3) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsraiH(VRegister vd, VRegister vj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x73344000 | (static_cast<uint32_t>(ui4) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsraiW(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x73348000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsraiD(VRegister vd, VRegister vj, int ui6) {
+  CHECK(IsUint<6>(ui6)) << ui6;
+  Emit2R(0x73350000 | (static_cast<uint32_t>(ui6) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VbitclriW(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x73108000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VbitclriD(VRegister vd, VRegister vj, int ui6) {
+  CHECK(IsUint<6>(ui6)) << ui6;
+  Emit2R(0x73110000 | (static_cast<uint32_t>(ui6) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VbitreviW(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x73188000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VbitreviD(VRegister vd, VRegister vj, int ui6) {
+  CHECK(IsUint<6>(ui6)) << ui6;
+  Emit2R(0x73190000 | (static_cast<uint32_t>(ui6) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VbsrlV(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x728e8000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VbsllV(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x728e0000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsllwilHB(VRegister vd, VRegister vj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x73082000 | (static_cast<uint32_t>(ui3) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsllwilWH(VRegister vd, VRegister vj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x73084000 | (static_cast<uint32_t>(ui4) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsllwilDW(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x73088000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsllwilHuBu(VRegister vd, VRegister vj, int ui3) {
+  CHECK(IsUint<3>(ui3)) << ui3;
+  Emit2R(0x730c2000 | (static_cast<uint32_t>(ui3) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsllwilWuHu(VRegister vd, VRegister vj, int ui4) {
+  CHECK(IsUint<4>(ui4)) << ui4;
+  Emit2R(0x730c4000 | (static_cast<uint32_t>(ui4) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::VsllwilDuWu(VRegister vd, VRegister vj, int ui5) {
+  CHECK(IsUint<5>(ui5)) << ui5;
+  Emit2R(0x730c8000 | (static_cast<uint32_t>(ui5) << 10), vj, vd);
+}
+
+void Loongarch64Assembler::Vld(VRegister vd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2c000000, si12, rj, vd);
+}
+
+void Loongarch64Assembler::Vst(VRegister vd, XRegister rj, int32_t si12) {
+  CHECK(IsInt<12>(si12)) << si12;
+  Emit2RI12(0x2c400000, si12, rj, vd);
+}
+
+void Loongarch64Assembler::Vldx(VRegister vd, XRegister rj, XRegister rk) {
+  Emit3R(0x38400000, rk, rj, vd);
+}
+
+void Loongarch64Assembler::Vstx(VRegister vd, XRegister rj, XRegister rk) {
+  Emit3R(0x38440000, rk, rj, vd);
+}
+
+/////////////////////////////// LoongArch64 pseudo instructions ///////////////////////////////
+
+void Loongarch64Assembler::Nop() {
+  Andi(Zero, Zero, 0);
+}
+
+void Loongarch64Assembler::Move(XRegister rd, XRegister rj) {
+  Or(rd, rj, Zero);
+}
+
+void Loongarch64Assembler::Clear(XRegister rd) {
+  Or(rd, Zero, Zero);
+}
+
+void Loongarch64Assembler::Not(XRegister rd, XRegister rj) {
+  Nor(rd, rj, Zero);
+}
+
+void Loongarch64Assembler::Jr(XRegister rj) {
+  Jirl(Zero, rj, 0);
+}
+
+void Loongarch64Assembler::Jalr(XRegister rj) {
+  Jirl(RA, rj, 0);
+}
+
+void Loongarch64Assembler::Ret() {
+  Jirl(Zero, RA, 0);
+}
+
+void Loongarch64Assembler::MoveV(VRegister vd, VRegister vj) {
+  VorV(vd, vj, vj);
+}
+
+/////////////////////////////// LoongArch64 macro instructions ///////////////////////////////
+
+void Loongarch64Assembler::LoadConst32(XRegister rd, int32_t value) {
+  LoadConst64(rd, value);
+}
+
+void Loongarch64Assembler::LoadConst64(XRegister rd, int64_t value) {
+  if (IsInt<12>(value)) {
+    AddiD(rd, Zero, dchecked_integral_cast<int32_t>(value));
+    return;
+  }
+  if (IsUint<12>(value)) {
+    Ori(rd, Zero, dchecked_integral_cast<uint32_t>(value));
+    return;
+  }
+  uint64_t uvalue = static_cast<uint64_t>(value);
+  // `lu12i.w` sets bits [31:12] and sign-extends into the upper half.
+  int32_t bits_31_12 = static_cast<int32_t>((uvalue >> 12) & 0xfffffu);
+  uint32_t bits_11_0 = static_cast<uint32_t>(uvalue & 0xfffu);
+  Lu12iW(rd, (bits_31_12 ^ 0x80000) - 0x80000);
+  if (bits_11_0 != 0u) {
+    Ori(rd, rd, bits_11_0);
+  }
+  if (!IsInt<32>(value)) {
+    // `lu32i.d` sets bits [51:32] and sign-extends into bits [63:52].
+    int32_t bits_51_32 = static_cast<int32_t>((uvalue >> 32) & 0xfffffu);
+    Lu32iD(rd, (bits_51_32 ^ 0x80000) - 0x80000);
+    if (!IsInt<52>(value)) {
+      // `lu52i.d` sets bits [63:52].
+      int32_t bits_63_52 = static_cast<int32_t>(uvalue >> 52);
+      Lu52iD(rd, rd, (bits_63_52 ^ 0x800) - 0x800);
+    }
+  }
+}
+
+void Loongarch64Assembler::AddConst32(XRegister rd, XRegister rj, int32_t value) {
+  if (IsInt<12>(value)) {
+    AddiW(rd, rj, value);
+    return;
+  }
+  CHECK_NE(rj, TMP);
+  LoadConst32(TMP, value);
+  AddW(rd, rj, TMP);
+}
+
+void Loongarch64Assembler::AddConst64(XRegister rd, XRegister rj, int64_t value) {
+  static constexpr int64_t kMaxSi12 = (1 << 11) - 1;
+  static constexpr int64_t kMinSi12 = -(1 << 11);
+  if (IsInt<12>(value)) {
+    AddiD(rd, rj, dchecked_integral_cast<int32_t>(value));
+    return;
+  }
+  // Two `addi.d` instructions cover a slightly larger range than one.
+  if (value > 0 && value <= 2 * kMaxSi12) {
+    AddiD(rd, rj, kMaxSi12);
+    AddiD(rd, rd, dchecked_integral_cast<int32_t>(value - kMaxSi12));
+    return;
+  }
+  if (value < 0 && value >= 2 * kMinSi12) {
+    AddiD(rd, rj, kMinSi12);
+    AddiD(rd, rd, dchecked_integral_cast<int32_t>(value - kMinSi12));
+    return;
+  }
+  if (IsInt<32>(value) && (value & 0xffff) == 0) {
+    Addu16iD(rd, rj, dchecked_integral_cast<int32_t>(value >> 16));
+    return;
+  }
+  CHECK_NE(rj, TMP);
+  LoadConst64(TMP, value);
+  AddD(rd, rj, TMP);
+}
+
+void Loongarch64Assembler::LoadFromOffset(LoadOperandType type,
+                                          XRegister reg,
+                                          XRegister base,
+                                          int32_t offset) {
+  if (!IsInt<12>(offset)) {
+    // Use the indexed form with the offset in TMP. The load remains the last emitted
+    // instruction, so implicit null checks recorded right after it stay accurate.
+    CHECK_NE(base, TMP);
+    LoadConst32(TMP, offset);
+    switch (type) {
+      case kLoadSignedByte:
+        LdxB(reg, base, TMP);
+        break;
+      case kLoadUnsignedByte:
+        LdxBu(reg, base, TMP);
+        break;
+      case kLoadSignedHalfword:
+        LdxH(reg, base, TMP);
+        break;
+      case kLoadUnsignedHalfword:
+        LdxHu(reg, base, TMP);
+        break;
+      case kLoadWord:
+        LdxW(reg, base, TMP);
+        break;
+      case kLoadUnsignedWord:
+        LdxWu(reg, base, TMP);
+        break;
+      case kLoadDoubleword:
+        LdxD(reg, base, TMP);
+        break;
+    }
+    return;
+  }
+
+  switch (type) {
+    case kLoadSignedByte:
+      LdB(reg, base, offset);
+      break;
+    case kLoadUnsignedByte:
+      LdBu(reg, base, offset);
+      break;
+    case kLoadSignedHalfword:
+      LdH(reg, base, offset);
+      break;
+    case kLoadUnsignedHalfword:
+      LdHu(reg, base, offset);
+      break;
+    case kLoadWord:
+      LdW(reg, base, offset);
+      break;
+    case kLoadUnsignedWord:
+      LdWu(reg, base, offset);
+      break;
+    case kLoadDoubleword:
+      LdD(reg, base, offset);
+      break;
+  }
+}
+
+void Loongarch64Assembler::StoreToOffset(StoreOperandType type,
+                                         XRegister reg,
+                                         XRegister base,
+                                         int32_t offset) {
+  if (!IsInt<12>(offset)) {
+    CHECK_NE(base, TMP);
+    CHECK_NE(reg, TMP);
+    LoadConst32(TMP, offset);
+    switch (type) {
+      case kStoreByte:
+        StxB(reg, base, TMP);
+        break;
+      case kStoreHalfword:
+        StxH(reg, base, TMP);
+        break;
+      case kStoreWord:
+        StxW(reg, base, TMP);
+        break;
+      case kStoreDoubleword:
+        StxD(reg, base, TMP);
+        break;
+    }
+    return;
+  }
+
+  switch (type) {
+    case kStoreByte:
+      StB(reg, base, offset);
+      break;
+    case kStoreHalfword:
+      StH(reg, base, offset);
+      break;
+    case kStoreWord:
+      StW(reg, base, offset);
+      break;
+    case kStoreDoubleword:
+      StD(reg, base, offset);
+      break;
+  }
+}
+
+void Loongarch64Assembler::LoadFpuFromOffset(LoadOperandType type,
+                                             FRegister reg,
+                                             XRegister base,
+                                             int32_t offset) {
+  DCHECK(type == kLoadWord || type == kLoadDoubleword) << type;
+  if (!IsInt<12>(offset)) {
+    CHECK_NE(base, TMP);
+    LoadConst32(TMP, offset);
+    if (type == kLoadWord) {
+      FldxS(reg, base, TMP);
+    } else {
+      FldxD(reg, base, TMP);
+    }
+    return;
+  }
+  if (type == kLoadWord) {
+    FldS(reg, base, offset);
+  } else {
+    FldD(reg, base, offset);
+  }
+}
+
+void Loongarch64Assembler::StoreFpuToOffset(StoreOperandType type,
+                                            FRegister reg,
+                                            XRegister base,
+                                            int32_t offset) {
+  DCHECK(type == kStoreWord || type == kStoreDoubleword) << type;
+  if (!IsInt<12>(offset)) {
+    CHECK_NE(base, TMP);
+    LoadConst32(TMP, offset);
+    if (type == kStoreWord) {
+      FstxS(reg, base, TMP);
+    } else {
+      FstxD(reg, base, TMP);
+    }
+    return;
+  }
+  if (type == kStoreWord) {
+    FstS(reg, base, offset);
+  } else {
+    FstD(reg, base, offset);
+  }
+}
+
+void Loongarch64Assembler::LoadVFromOffset(VRegister reg, XRegister base, int32_t offset) {
+  if (!IsInt<12>(offset)) {
+    CHECK_NE(base, TMP);
+    LoadConst32(TMP, offset);
+    Vldx(reg, base, TMP);
+    return;
+  }
+  Vld(reg, base, offset);
+}
+
+void Loongarch64Assembler::StoreVToOffset(VRegister reg, XRegister base, int32_t offset) {
+  if (!IsInt<12>(offset)) {
+    CHECK_NE(base, TMP);
+    LoadConst32(TMP, offset);
+    Vstx(reg, base, TMP);
+    return;
+  }
+  Vst(reg, base, offset);
+}
+
+void Loongarch64Assembler::PoisonHeapReference(XRegister reg) {
+  // reg = -reg.
+  SubW(reg, Zero, reg);
+}
+
+void Loongarch64Assembler::UnpoisonHeapReference(XRegister reg) {
+  // reg = -reg.
+  SubW(reg, Zero, reg);
+  // Heap references are kept zero-extended in registers.
+  BstrpickD(reg, reg, 31, 0);
+}
+
+void Loongarch64Assembler::MaybePoisonHeapReference(XRegister reg) {
+  if (kPoisonHeapReferences) {
+    PoisonHeapReference(reg);
+  }
+}
+
+void Loongarch64Assembler::MaybeUnpoisonHeapReference(XRegister reg) {
+  if (kPoisonHeapReferences) {
+    UnpoisonHeapReference(reg);
+  }
+}
+
+/////////////////////////////// Branches to labels ///////////////////////////////
+
+const Loongarch64Assembler::Branch::BranchInfo Loongarch64Assembler::Branch::branch_info_[] = {
+    // Short branches.
+    {1, 0, Loongarch64Assembler::Branch::kOffset28},  // kUncondBranch
+    {1, 0, Loongarch64Assembler::Branch::kOffset18},  // kCondBranch
+    {1, 0, Loongarch64Assembler::Branch::kOffset23},  // kCondBranchZ
+    {1, 0, Loongarch64Assembler::Branch::kOffset23},  // kFpuCondBranch
+    {1, 0, Loongarch64Assembler::Branch::kOffset28},  // kCall
+    // Long branches.
+    {2, 0, Loongarch64Assembler::Branch::kOffset38},  // kLongUncondBranch
+    {2, 1, Loongarch64Assembler::Branch::kOffset28},  // kLongCondBranch
+    {2, 1, Loongarch64Assembler::Branch::kOffset28},  // kLongCondBranchZ
+    {2, 1, Loongarch64Assembler::Branch::kOffset28},  // kLongFpuCondBranch
+    {2, 0, Loongarch64Assembler::Branch::kOffset38},  // kLongCall
+    // PC-relative loads.
+    {2, 0, Loongarch64Assembler::Branch::kOffset32},  // kLabel
+    {2, 0, Loongarch64Assembler::Branch::kOffset32},  // kLiteral
+    {2, 0, Loongarch64Assembler::Branch::kOffset32},  // kLiteralUnsigned
+    {2, 0, Loongarch64Assembler::Branch::kOffset32},  // kLiteralLong
+};
+
+void Loongarch64Assembler::Branch::InitShortOrLong(Loongarch64Assembler::Branch::OffsetBits offset_size,
+                                                   Loongarch64Assembler::Branch::Type short_type,
+                                                   Loongarch64Assembler::Branch::Type long_type) {
+  type_ = (offset_size <= branch_info_[short_type].offset_size) ? short_type : long_type;
+}
+
+void Loongarch64Assembler::Branch::InitializeType(Type initial_type) {
+  OffsetBits offset_size_needed = GetOffsetSizeNeeded(location_, target_);
+  switch (initial_type) {
+    case kUncondBranch:
+      InitShortOrLong(offset_size_needed, kUncondBranch, kLongUncondBranch);
+      break;
+    case kCall:
+      InitShortOrLong(offset_size_needed, kCall, kLongCall);
+      break;
+    case kCondBranch:
+      switch (condition_) {
+        case kCondEQZ:
+        case kCondNEZ:
+          InitShortOrLong(offset_size_needed, kCondBranchZ, kLongCondBranchZ);
+          break;
+        case kCondF:
+        case kCondT:
+          InitShortOrLong(offset_size_needed, kFpuCondBranch, kLongFpuCondBranch);
+          break;
+        default:
+          InitShortOrLong(offset_size_needed, kCondBranch, kLongCondBranch);
+          break;
+      }
+      break;
+    case kLabel:
+    case kLiteral:
+    case kLiteralUnsigned:
+    case kLiteralLong:
+      // PC-relative loads have a single form that can reach anywhere in the code.
+      type_ = initial_type;
+      break;
+    default:
+      LOG(FATAL) << "Unexpected branch type " << initial_type;
+      UNREACHABLE();
+  }
+  old_type_ = type_;
+}
+
+bool Loongarch64Assembler::Branch::IsNop(BranchCondition condition, uint32_t lhs, uint32_t rhs) {
+  switch (condition) {
+    case kCondNE:
+    case kCondLT:
+    case kCondLTU:
+      return lhs == rhs;
+    case kCondNEZ:
+      return lhs == static_cast<uint32_t>(Zero);
+    default:
+      return false;
+  }
+}
+
+bool Loongarch64Assembler::Branch::IsUncond(BranchCondition condition,
+                                            uint32_t lhs,
+                                            uint32_t rhs) {
+  switch (condition) {
+    case kUncond:
+      return true;
+    case kCondEQ:
+    case kCondGE:
+    case kCondGEU:
+      return lhs == rhs;
+    case kCondEQZ:
+      return lhs == static_cast<uint32_t>(Zero);
+    default:
+      return false;
+  }
+}
+
+Loongarch64Assembler::Branch::Branch(uint32_t location, uint32_t target, bool is_call)
+    : old_location_(location),
+      location_(location),
+      target_(target),
+      lhs_reg_(0),
+      rhs_reg_(0),
+      condition_(kUncond) {
+  InitializeType(is_call ? kCall : kUncondBranch);
+}
+
+Loongarch64Assembler::Branch::Branch(uint32_t location,
+                                     uint32_t target,
+                                     Loongarch64Assembler::BranchCondition condition,
+                                     uint32_t lhs_reg,
+                                     uint32_t rhs_reg)
+    : old_location_(location),
+      location_(location),
+      target_(target),
+      lhs_reg_(lhs_reg),
+      rhs_reg_(rhs_reg),
+      condition_(condition) {
+  CHECK_NE(condition, kUncond);
+  CHECK(!IsNop(condition, lhs_reg, rhs_reg));
+  CHECK(!IsUncond(condition, lhs_reg, rhs_reg));
+  InitializeType(kCondBranch);
+}
+
+Loongarch64Assembler::Branch::Branch(uint32_t location,
+                                     XRegister dest_reg,
+                                     Type label_or_literal_type)
+    : old_location_(location),
+      location_(location),
+      target_(kUnresolved),
+      lhs_reg_(dest_reg),
+      rhs_reg_(0),
+      condition_(kUncond) {
+  CHECK_NE(dest_reg, Zero);
+  InitializeType(label_or_literal_type);
+}
+
+Loongarch64Assembler::BranchCondition Loongarch64Assembler::Branch::OppositeCondition(
+    Loongarch64Assembler::BranchCondition cond) {
+  switch (cond) {
+    case kCondEQ:
+      return kCondNE;
+    case kCondNE:
+      return kCondEQ;
+    case kCondLT:
+      return kCondGE;
+    case kCondGE:
+      return kCondLT;
+    case kCondLTU:
+      return kCondGEU;
+    case kCondGEU:
+      return kCondLTU;
+    case kCondEQZ:
+      return kCondNEZ;
+    case kCondNEZ:
+      return kCondEQZ;
+    case kCondF:
+      return kCondT;
+    case kCondT:
+      return kCondF;
+    case kUncond:
+      LOG(FATAL) << "Unexpected branch condition " << cond;
+  }
+  UNREACHABLE();
+}
+
+Loongarch64Assembler::Branch::Type Loongarch64Assembler::Branch::GetType() const {
+  return type_;
+}
+
+Loongarch64Assembler::BranchCondition Loongarch64Assembler::Branch::GetCondition() const {
+  return condition_;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetLeftRegister() const {
+  return lhs_reg_;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetRightRegister() const {
+  return rhs_reg_;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetTarget() const {
+  return target_;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetLocation() const {
+  return location_;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetOldLocation() const {
+  return old_location_;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetLength() const {
+  return branch_info_[type_].length;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetOldLength() const {
+  return branch_info_[old_type_].length;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetSize() const {
+  return GetLength() * sizeof(uint32_t);
+}
+
+uint32_t Loongarch64Assembler::Branch::GetOldSize() const {
+  return GetOldLength() * sizeof(uint32_t);
+}
+
+uint32_t Loongarch64Assembler::Branch::GetEndLocation() const {
+  return GetLocation() + GetSize();
+}
+
+uint32_t Loongarch64Assembler::Branch::GetOldEndLocation() const {
+  return GetOldLocation() + GetOldSize();
+}
+
+bool Loongarch64Assembler::Branch::IsLong() const {
+  switch (type_) {
+    // Short branches.
+    case kUncondBranch:
+    case kCondBranch:
+    case kCondBranchZ:
+    case kFpuCondBranch:
+    case kCall:
+      return false;
+    // Long branches.
+    case kLongUncondBranch:
+    case kLongCondBranch:
+    case kLongCondBranchZ:
+    case kLongFpuCondBranch:
+    case kLongCall:
+    // PC-relative loads (never promoted).
+    case kLabel:
+    case kLiteral:
+    case kLiteralUnsigned:
+    case kLiteralLong:
+      return true;
+  }
+  UNREACHABLE();
+}
+
+bool Loongarch64Assembler::Branch::IsResolved() const {
+  return target_ != kUnresolved;
+}
+
+Loongarch64Assembler::Branch::OffsetBits Loongarch64Assembler::Branch::GetOffsetSize() const {
+  return branch_info_[type_].offset_size;
+}
+
+Loongarch64Assembler::Branch::OffsetBits Loongarch64Assembler::Branch::GetOffsetSizeNeeded(
+    uint32_t location, uint32_t target) {
+  // For unresolved targets assume the shortest encoding
+  // (later it will be made longer if needed).
+  if (target == kUnresolved) {
+    return kOffset18;
+  }
+  int64_t distance = static_cast<int64_t>(target) - location;
+  // To simplify calculations in composite branches consisting of multiple instructions
+  // bump up the distance by a value larger than the max byte size of a composite branch.
+  distance += (distance >= 0) ? kMaxBranchLength : -kMaxBranchLength;
+  if (IsInt<kOffset18>(distance)) {
+    return kOffset18;
+  } else if (IsInt<kOffset23>(distance)) {
+    return kOffset23;
+  } else if (IsInt<kOffset28>(distance)) {
+    return kOffset28;
+  }
+  return kOffset38;
+}
+
+void Loongarch64Assembler::Branch::Resolve(uint32_t target) {
+  target_ = target;
+}
+
+void Loongarch64Assembler::Branch::Relocate(uint32_t expand_location, uint32_t delta) {
+  if (location_ > expand_location) {
+    location_ += delta;
+  }
+  if (!IsResolved()) {
+    return;  // Don't know the target yet.
+  }
+  if (target_ > expand_location) {
+    target_ += delta;
+  }
+}
+
+void Loongarch64Assembler::Branch::PromoteToLong() {
+  switch (type_) {
+    // Short branches.
+    case kUncondBranch:
+      type_ = kLongUncondBranch;
+      break;
+    case kCondBranch:
+      type_ = kLongCondBranch;
+      break;
+    case kCondBranchZ:
+      type_ = kLongCondBranchZ;
+      break;
+    case kFpuCondBranch:
+      type_ = kLongFpuCondBranch;
+      break;
+    case kCall:
+      type_ = kLongCall;
+      break;
+    default:
+      // Note: 'type_' is already long.
+      break;
+  }
+  CHECK(IsLong());
+}
+
+uint32_t Loongarch64Assembler::Branch::PromoteIfNeeded() {
+  // If the branch is still unresolved or already long, nothing to do.
+  if (IsLong() || !IsResolved()) {
+    return 0;
+  }
+  // Promote the short branch to long if the offset size is too small
+  // to hold the distance between location_ and target_.
+  if (GetOffsetSizeNeeded(GetOffsetLocation(), target_) > GetOffsetSize()) {
+    PromoteToLong();
+    uint32_t old_size = GetOldSize();
+    uint32_t new_size = GetSize();
+    CHECK_GT(new_size, old_size);
+    return new_size - old_size;
+  }
+  return 0;
+}
+
+uint32_t Loongarch64Assembler::Branch::GetOffsetLocation() const {
+  return location_ + branch_info_[type_].instr_offset * sizeof(uint32_t);
+}
+
+int32_t Loongarch64Assembler::Branch::GetOffset() const {
+  CHECK(IsResolved());
+  // All LoongArch64 PC-relative offsets are relative to the address of the instruction
+  // holding the offset.
+  int32_t offset = static_cast<int32_t>(target_ - GetOffsetLocation());
+  CHECK(IsInt(static_cast<size_t>(GetOffsetSize()), static_cast<int64_t>(offset))) << offset;
+  return offset;
+}
+
+Loongarch64Assembler::Branch* Loongarch64Assembler::GetBranch(uint32_t branch_id) {
+  CHECK_LT(branch_id, branches_.size());
+  return &branches_[branch_id];
+}
+
+const Loongarch64Assembler::Branch* Loongarch64Assembler::GetBranch(uint32_t branch_id) const {
+  CHECK_LT(branch_id, branches_.size());
+  return &branches_[branch_id];
+}
+
+void Loongarch64Assembler::Bind(Loongarch64Label* label) {
+  CHECK(!label->IsBound());
+  uint32_t bound_pc = buffer_.Size();
+
+  // Walk the list of branches referring to and preceding this label.
+  // Store the previously unknown target addresses in them.
+  while (label->IsLinked()) {
+    uint32_t branch_id = label->Position();
+    Branch* branch = GetBranch(branch_id);
+    branch->Resolve(bound_pc);
+
+    uint32_t branch_location = branch->GetLocation();
+    // Extract the location of the previous branch in the list (walking the list backwards;
+    // the previous branch ID was stored in the space reserved for this branch).
+    uint32_t prev = buffer_.Load<uint32_t>(branch_location);
+
+    // On to the previous branch in the list...
+    label->position_ = prev;
+  }
+
+  // Now make the label object contain its own location (relative to the end of the preceding
+  // branch, if any; it will be used by the branches referring to and following this label).
+  label->prev_branch_id_plus_one_ = branches_.size();
+  if (label->prev_branch_id_plus_one_) {
+    uint32_t branch_id = label->prev_branch_id_plus_one_ - 1;
+    const Branch* branch = GetBranch(branch_id);
+    bound_pc -= branch->GetEndLocation();
+  }
+  label->BindTo(bound_pc);
+}
+
+uint32_t Loongarch64Assembler::GetLabelLocation(const Loongarch64Label* label) const {
+  CHECK(label->IsBound());
+  uint32_t target = label->Position();
+  if (label->prev_branch_id_plus_one_) {
+    // Get label location based on the branch preceding it.
+    uint32_t branch_id = label->prev_branch_id_plus_one_ - 1;
+    const Branch* branch = GetBranch(branch_id);
+    target += branch->GetEndLocation();
+  }
+  return target;
+}
+
+uint32_t Loongarch64Assembler::GetAdjustedPosition(uint32_t old_position) {
+  // We can reconstruct the adjustment by going through all the branches from the beginning
+  // up to the old_position. Since we expect GetAdjustedPosition() to be called in a loop
+  // with increasing old_position, we can use the data from last GetAdjustedPosition() to
+  // continue where we left off and the whole loop should be O(m+n) where m is the number
+  // of positions to adjust and n is the number of branches.
+  if (old_position < last_old_position_) {
+    last_position_adjustment_ = 0;
+    last_old_position_ = 0;
+    last_branch_id_ = 0;
+  }
+  while (last_branch_id_ != branches_.size()) {
+    const Branch* branch = GetBranch(last_branch_id_);
+    if (branch->GetLocation() >= old_position + last_position_adjustment_) {
+      break;
+    }
+    last_position_adjustment_ += branch->GetSize() - branch->GetOldSize();
+    ++last_branch_id_;
+  }
+  last_old_position_ = old_position;
+  return old_position + last_position_adjustment_;
+}
+
+void Loongarch64Assembler::FinalizeLabeledBranch(Loongarch64Label* label) {
+  uint32_t length = branches_.back().GetLength();
+  if (!label->IsBound()) {
+    // Branch forward (to a following label), distance is unknown.
+    // The first branch forward will contain 0, serving as the terminator of
+    // the list of forward-reaching branches.
+    Emit(label->position_);
+    length--;
+    // Now make the label object point to this branch
+    // (this forms a linked list of branches preceding this label).
+    uint32_t branch_id = branches_.size() - 1;
+    label->LinkTo(branch_id);
+  }
+  // Reserve space for the branch.
+  for (; length != 0u; --length) {
+    Nop();
+  }
+}
+
+void Loongarch64Assembler::Buncond(Loongarch64Label* label, bool is_call) {
+  uint32_t target = label->IsBound() ? GetLabelLocation(label) : Branch::kUnresolved;
+  branches_.emplace_back(buffer_.Size(), target, is_call);
+  FinalizeLabeledBranch(label);
+}
+
+void Loongarch64Assembler::Bcond(Loongarch64Label* label,
+                                 BranchCondition condition,
+                                 uint32_t lhs,
+                                 uint32_t rhs) {
+  // If lhs = rhs, this can be a NOP.
+  if (Branch::IsNop(condition, lhs, rhs)) {
+    return;
+  }
+  if (Branch::IsUncond(condition, lhs, rhs)) {
+    Buncond(label, /* is_call= */ false);
+    return;
+  }
+  uint32_t target = label->IsBound() ? GetLabelLocation(label) : Branch::kUnresolved;
+  branches_.emplace_back(buffer_.Size(), target, condition, lhs, rhs);
+  FinalizeLabeledBranch(label);
+}
+
+void Loongarch64Assembler::LoadLabelAddress(XRegister dest_reg, Loongarch64Label* label) {
+  branches_.emplace_back(buffer_.Size(), dest_reg, Branch::kLabel);
+  FinalizeLabeledBranch(label);
+}
+
+Literal* Loongarch64Assembler::NewLiteral(size_t size, const uint8_t* data) {
+  // We don't support byte and half-word literals.
+  if (size == 4u) {
+    literals_.emplace_back(size, data);
+    return &literals_.back();
+  } else {
+    DCHECK_EQ(size, 8u);
+    long_literals_.emplace_back(size, data);
+    return &long_literals_.back();
+  }
+}
+
+void Loongarch64Assembler::LoadLiteral(XRegister dest_reg,
+                                       LoadOperandType load_type,
+                                       Literal* literal) {
+  Branch::Type literal_type;
+  switch (load_type) {
+    case kLoadWord:
+      DCHECK_EQ(literal->GetSize(), 4u);
+      literal_type = Branch::kLiteral;
+      break;
+    case kLoadUnsignedWord:
+      DCHECK_EQ(literal->GetSize(), 4u);
+      literal_type = Branch::kLiteralUnsigned;
+      break;
+    case kLoadDoubleword:
+      DCHECK_EQ(literal->GetSize(), 8u);
+      literal_type = Branch::kLiteralLong;
+      break;
+    default:
+      LOG(FATAL) << "Unexpected literal load type " << load_type;
+      UNREACHABLE();
+  }
+  Loongarch64Label* label = literal->GetLabel();
+  branches_.emplace_back(buffer_.Size(), dest_reg, literal_type);
+  FinalizeLabeledBranch(label);
+}
+
+void Loongarch64Assembler::EmitLiterals() {
+  if (!literals_.empty()) {
+    for (Literal& literal : literals_) {
+      Loongarch64Label* label = literal.GetLabel();
+      Bind(label);
+      AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+      DCHECK_EQ(literal.GetSize(), 4u);
+      for (size_t i = 0, size = literal.GetSize(); i != size; ++i) {
+        buffer_.Emit<uint8_t>(literal.GetData()[i]);
+      }
+    }
+  }
+  if (!long_literals_.empty()) {
+    // Reserve 4 bytes for potential alignment. If after the branch promotion the 64-bit
+    // literals aren't 8-byte-aligned, they will be moved down 4 bytes.
+    Nop();
+    for (Literal& literal : long_literals_) {
+      Loongarch64Label* label = literal.GetLabel();
+      Bind(label);
+      AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+      DCHECK_EQ(literal.GetSize(), 8u);
+      for (size_t i = 0, size = literal.GetSize(); i != size; ++i) {
+        buffer_.Emit<uint8_t>(literal.GetData()[i]);
+      }
+    }
+  }
+}
+
+void Loongarch64Assembler::AlignLongLiterals() {
+  // Align 64-bit literals by moving them down by 4 bytes if needed. This reduces
+  // the PC-relative distance, which is safe for all literal loads.
+  if (long_literals_.empty()) {
+    return;
+  }
+  uint32_t first_literal_location = GetLabelLocation(long_literals_.front().GetLabel());
+  size_t lit_size = long_literals_.size() * sizeof(uint64_t);
+  size_t buf_size = buffer_.Size();
+  // 64-bit literals must be at the very end of the buffer.
+  CHECK_EQ(first_literal_location + lit_size, buf_size);
+  if (!IsAligned<sizeof(uint64_t)>(first_literal_location)) {
+    buffer_.Move(first_literal_location - sizeof(uint32_t), first_literal_location, lit_size);
+    // The 4 reserved bytes proved useless, reduce the buffer size.
+    buffer_.Resize(buf_size - sizeof(uint32_t));
+    // Reduce target addresses in literal loads by 4 bytes in order for correct
+    // offsets to be computed later in EmitBranches().
+    for (auto& branch : branches_) {
+      uint32_t target = branch.GetTarget();
+      if (target >= first_literal_location) {
+        branch.Resolve(target - sizeof(uint32_t));
+      }
+    }
+    // If after this we ever call GetLabelLocation() to get the location of a 64-bit literal,
+    // we need to adjust the location of the literal's label as well.
+    for (Literal& literal : long_literals_) {
+      // Bound label position is negative, hence incrementing it.
+      literal.GetLabel()->position_ += sizeof(uint32_t);
+    }
+  }
+}
+
+void Loongarch64Assembler::PromoteBranches() {
+  // Promote short branches to long as necessary.
+  bool changed;
+  do {
+    changed = false;
+    for (auto& branch : branches_) {
+      CHECK(branch.IsResolved());
+      uint32_t delta = branch.PromoteIfNeeded();
+      // If this branch has been promoted and needs to expand in size,
+      // relocate all branches by the expansion size.
+      if (delta != 0u) {
+        changed = true;
+        uint32_t expand_location = branch.GetLocation();
+        for (auto& branch2 : branches_) {
+          branch2.Relocate(expand_location, delta);
+        }
+      }
+    }
+  } while (changed);
+
+  // Account for branch expansion by resizing the code buffer
+  // and moving the code in it to its final location.
+  size_t branch_count = branches_.size();
+  if (branch_count > 0) {
+    // Resize.
+    Branch& last_branch = branches_[branch_count - 1];
+    uint32_t size_delta = last_branch.GetEndLocation() - last_branch.GetOldEndLocation();
+    uint32_t old_size = buffer_.Size();
+    buffer_.Resize(old_size + size_delta);
+    // Move the code residing between branch placeholders.
+    uint32_t end = old_size;
+    for (size_t i = branch_count; i > 0; ) {
+      Branch& branch = branches_[--i];
+      uint32_t size = end - branch.GetOldEndLocation();
+      buffer_.Move(branch.GetEndLocation(), branch.GetOldEndLocation(), size);
+      end = branch.GetOldLocation();
+    }
+  }
+}
+
+void Loongarch64Assembler::EmitBcond(BranchCondition cond,
+                                     uint32_t lhs,
+                                     uint32_t rhs,
+                                     int32_t offset) {
+  XRegister rj = static_cast<XRegister>(lhs);
+  XRegister rd = static_cast<XRegister>(rhs);
+  switch (cond) {
+    case kCondEQ:
+      Beq(rj, rd, offset);
+      break;
+    case kCondNE:
+      Bne(rj, rd, offset);
+      break;
+    case kCondLT:
+      Blt(rj, rd, offset);
+      break;
+    case kCondGE:
+      Bge(rj, rd, offset);
+      break;
+    case kCondLTU:
+      Bltu(rj, rd, offset);
+      break;
+    case kCondGEU:
+      Bgeu(rj, rd, offset);
+      break;
+    case kCondEQZ:
+      Beqz(rj, offset);
+      break;
+    case kCondNEZ:
+      Bnez(rj, offset);
+      break;
+    case kCondF:
+      Bceqz(static_cast<FccRegister>(lhs), offset);
+      break;
+    case kCondT:
+      Bcnez(static_cast<FccRegister>(lhs), offset);
+      break;
+    case kUncond:
+      LOG(FATAL) << "Unexpected branch condition " << cond;
+      UNREACHABLE();
+  }
+}
+
+void Loongarch64Assembler::EmitBranch(Loongarch64Assembler::Branch* branch) {
+  CHECK(overwriting_);
+  overwrite_location_ = branch->GetLocation();
+  int32_t offset = branch->GetOffset();
+  BranchCondition condition = branch->GetCondition();
+  uint32_t lhs = branch->GetLeftRegister();
+  uint32_t rhs = branch->GetRightRegister();
+  // Long unconditional branches and calls split the offset into the 20-bit `pcaddu18i`
+  // immediate (bits [37:18]) and the sign-extended 16-bit `jirl` immediate (bits [17:2]).
+  int32_t offset_lo = ((((offset >> 2) & 0xffff) ^ 0x8000) - 0x8000) * 4;
+  int32_t offset_hi = (offset - offset_lo) >> 18;
+  // PC-relative loads split the offset into the 20-bit `pcaddu12i` immediate and
+  // the sign-extended 12-bit immediate of the following instruction.
+  int32_t imm12 = ((offset & 0xfff) ^ 0x800) - 0x800;
+  int32_t imm20 = (offset - imm12) >> 12;
+  XRegister dest = static_cast<XRegister>(lhs);
+  switch (branch->GetType()) {
+    // Short branches.
+    case Branch::kUncondBranch:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      B(offset);
+      break;
+    case Branch::kCondBranch:
+    case Branch::kCondBranchZ:
+    case Branch::kFpuCondBranch:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      EmitBcond(condition, lhs, rhs, offset);
+      break;
+    case Branch::kCall:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      Bl(offset);
+      break;
+
+    // Long branches.
+    case Branch::kLongUncondBranch:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      Pcaddu18i(TMP, offset_hi);
+      Jirl(Zero, TMP, offset_lo);
+      break;
+    case Branch::kLongCondBranch:
+    case Branch::kLongCondBranchZ:
+    case Branch::kLongFpuCondBranch:
+      // Skip the following `b` if the original condition does not hold.
+      EmitBcond(Branch::OppositeCondition(condition), lhs, rhs, 2 * sizeof(uint32_t));
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      B(offset);
+      break;
+    case Branch::kLongCall:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      Pcaddu18i(RA, offset_hi);
+      Jirl(RA, RA, offset_lo);
+      break;
+
+    // PC-relative loads.
+    case Branch::kLabel:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      Pcaddu12i(dest, imm20);
+      AddiD(dest, dest, imm12);
+      break;
+    case Branch::kLiteral:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      Pcaddu12i(dest, imm20);
+      LdW(dest, dest, imm12);
+      break;
+    case Branch::kLiteralUnsigned:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      Pcaddu12i(dest, imm20);
+      LdWu(dest, dest, imm12);
+      break;
+    case Branch::kLiteralLong:
+      CHECK_EQ(overwrite_location_, branch->GetOffsetLocation());
+      Pcaddu12i(dest, imm20);
+      LdD(dest, dest, imm12);
+      break;
+  }
+  CHECK_EQ(overwrite_location_, branch->GetEndLocation());
+  CHECK_LE(branch->GetSize(), static_cast<uint32_t>(Branch::kMaxBranchLength));
+}
+
+void Loongarch64Assembler::EmitBranches() {
+  CHECK(!overwriting_);
+  // Switch from appending instructions at the end of the buffer to overwriting
+  // existing instructions (branch placeholders) in the buffer.
+  overwriting_ = true;
+  for (auto& branch : branches_) {
+    EmitBranch(&branch);
+  }
+  overwriting_ = false;
+}
+
+void Loongarch64Assembler::B(Loongarch64Label* label) {
+  Buncond(label, /* is_call= */ false);
+}
+
+void Loongarch64Assembler::Bl(Loongarch64Label* label) {
+  Buncond(label, /* is_call= */ true);
+}
+
+void Loongarch64Assembler::Beq(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  if (rd == Zero) {
+    Bcond(label, kCondEQZ, rj);
+  } else if (rj == Zero) {
+    Bcond(label, kCondEQZ, rd);
+  } else {
+    Bcond(label, kCondEQ, rj, rd);
+  }
+}
+
+void Loongarch64Assembler::Bne(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  if (rd == Zero) {
+    Bcond(label, kCondNEZ, rj);
+  } else if (rj == Zero) {
+    Bcond(label, kCondNEZ, rd);
+  } else {
+    Bcond(label, kCondNE, rj, rd);
+  }
+}
+
+void Loongarch64Assembler::Blt(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  Bcond(label, kCondLT, rj, rd);
+}
+
+void Loongarch64Assembler::Bge(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  Bcond(label, kCondGE, rj, rd);
+}
+
+void Loongarch64Assembler::Bltu(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  Bcond(label, kCondLTU, rj, rd);
+}
+
+void Loongarch64Assembler::Bgeu(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  Bcond(label, kCondGEU, rj, rd);
+}
+
+void Loongarch64Assembler::Bgt(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  Bcond(label, kCondLT, rd, rj);
+}
+
+void Loongarch64Assembler::Ble(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  Bcond(label, kCondGE, rd, rj);
+}
+
+void Loongarch64Assembler::Bgtu(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  Bcond(label, kCondLTU, rd, rj);
+}
+
+void Loongarch64Assembler::Bleu(XRegister rj, XRegister rd, Loongarch64Label* label) {
+  Bcond(label, kCondGEU, rd, rj);
+}
+
+void Loongarch64Assembler::Beqz(XRegister rj, Loongarch64Label* label) {
+  Bcond(label, kCondEQZ, rj);
+}
+
+void Loongarch64Assembler::Bnez(XRegister rj, Loongarch64Label* label) {
+  Bcond(label, kCondNEZ, rj);
+}
+
+void Loongarch64Assembler::Bceqz(FccRegister cj, Loongarch64Label* label) {
+  Bcond(label, kCondF, static_cast<uint32_t>(cj));
+}
+
+void Loongarch64Assembler::Bcnez(FccRegister cj, Loongarch64Label* label) {
+  Bcond(label, kCondT, static_cast<uint32_t>(cj));
+}
+
+std::ostream& operator<<(std::ostream& os, const Loongarch64Assembler::BranchCondition& rhs) {
+  switch (rhs) {
+    case Loongarch64Assembler::kCondEQ:
+      return os << "eq";
+    case Loongarch64Assembler::kCondNE:
+      return os << "ne";
+    case Loongarch64Assembler::kCondLT:
+      return os << "lt";
+    case Loongarch64Assembler::kCondGE:
+      return os << "ge";
+    case Loongarch64Assembler::kCondLTU:
+      return os << "ltu";
+    case Loongarch64Assembler::kCondGEU:
+      return os << "geu";
+    case Loongarch64Assembler::kCondEQZ:
+      return os << "eqz";
+    case Loongarch64Assembler::kCondNEZ:
+      return os << "nez";
+    case Loongarch64Assembler::kCondF:
+      return os << "cf";
+    case Loongarch64Assembler::kCondT:
+      return os << "ct";
+    case Loongarch64Assembler::kUncond:
+      return os << "uncond";
+  }
+  return os << "BranchCondition[" << static_cast<int>(rhs) << "]";
+}
+
+}  // namespace loongarch64
+}  // namespace art
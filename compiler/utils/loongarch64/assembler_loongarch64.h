@@ -0,0 +1,918 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_UTILS_LOONGARCH64_ASSEMBLER_LOONGARCH64_H_
+#define ART_COMPILER_UTILS_LOONGARCH64_ASSEMBLER_LOONGARCH64_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arch/loongarch64/instruction_set_features_loongarch64.h"
+#include "arch/loongarch64/registers_loongarch64.h"
+#include "base/arena_containers.h"
+#include "base/enums.h"
+#include "base/globals.h"
+#include "base/macros.h"
+#include "base/stl_util_identity.h"
+#include "heap_poisoning.h"
+#include "utils/assembler.h"
+#include "utils/label.h"
+
+namespace art {
+namespace loongarch64 {
+
+// Scratch registers used by the assembler for synthesized instruction sequences
+// (long branches, out-of-range offsets and constants). These must never be allocated.
+static constexpr XRegister TMP = T7;
+static constexpr XRegister TMP2 = T8;
+static constexpr FRegister FTMP = FT14;
+static constexpr FRegister FTMP2 = FT15;
+// LSX views of FTMP and FTMP2 (VRn overlaps FRegister n).
+static constexpr VRegister VTMP = static_cast<VRegister>(FTMP);
+static constexpr VRegister VTMP2 = static_cast<VRegister>(FTMP2);
+
+// Floating-point condition flag registers written by `fcmp.cond.{s,d}`.
+enum FccRegister {
+  FCC0 = 0,
+  FCC1 = 1,
+  FCC2 = 2,
+  FCC3 = 3,
+  FCC4 = 4,
+  FCC5 = 5,
+  FCC6 = 6,
+  FCC7 = 7,
+  kNumberOfFccRegisters = 8,
+};
+
+// Conditions for `fcmp.cond.{s,d}`. The quiet variants are listed; the signaling
+// variant of each condition has the lowest bit set.
+enum FpCondition {
+  kCAF = 0x0,   // Always false.
+  kCLT = 0x2,   // Ordered and less than.
+  kCEQ = 0x4,   // Ordered and equal.
+  kCLE = 0x6,   // Ordered and less than or equal.
+  kCUN = 0x8,   // Unordered.
+  kCULT = 0xa,  // Unordered or less than.
+  kCUEQ = 0xc,  // Unordered or equal.
+  kCULE = 0xe,  // Unordered or less than or equal.
+  kCNE = 0x10,  // Ordered and not equal.
+  kCOR = 0x14,  // Ordered.
+  kCUNE = 0x18,  // Unordered or not equal.
+};
+
+enum LoadOperandType {
+  kLoadSignedByte,
+  kLoadUnsignedByte,
+  kLoadSignedHalfword,
+  kLoadUnsignedHalfword,
+  kLoadWord,
+  kLoadUnsignedWord,
+  kLoadDoubleword
+};
+
+enum StoreOperandType {
+  kStoreByte,
+  kStoreHalfword,
+  kStoreWord,
+  kStoreDoubleword
+};
+
+class Loongarch64Label : public Label {
+ public:
+  Loongarch64Label() : prev_branch_id_plus_one_(0) {}
+
+  Loongarch64Label(Loongarch64Label&& src)
+      : Label(std::move(src)), prev_branch_id_plus_one_(src.prev_branch_id_plus_one_) {}
+
+ private:
+  uint32_t prev_branch_id_plus_one_;  // To get distance from preceding branch, if any.
+
+  friend class Loongarch64Assembler;
+  DISALLOW_COPY_AND_ASSIGN(Loongarch64Label);
+};
+
+// Assembler literal is a value embedded in code, retrieved using a PC-relative load.
+class Literal {
+ public:
+  static constexpr size_t kMaxSize = 8;
+
+  Literal(uint32_t size, const uint8_t* data)
+      : label_(), size_(size) {
+    DCHECK_LE(size, Literal::kMaxSize);
+    memcpy(data_, data, size);
+  }
+
+  template <typename T>
+  T GetValue() const {
+    DCHECK_EQ(size_, sizeof(T));
+    T value;
+    memcpy(&value, data_, sizeof(T));
+    return value;
+  }
+
+  uint32_t GetSize() const {
+    return size_;
+  }
+
+  const uint8_t* GetData() const {
+    return data_;
+  }
+
+  Loongarch64Label* GetLabel() {
+    return &label_;
+  }
+
+  const Loongarch64Label* GetLabel() const {
+    return &label_;
+  }
+
+ private:
+  Loongarch64Label label_;
+  const uint32_t size_;
+  uint8_t data_[kMaxSize];
+
+  DISALLOW_COPY_AND_ASSIGN(Literal);
+};
+
+class Loongarch64Assembler final : public Assembler {
+ public:
+  explicit Loongarch64Assembler(ArenaAllocator* allocator,
+                                const Loongarch64InstructionSetFeatures* instruction_set_features =
+                                    nullptr)
+      : Assembler(allocator),
+        branches_(allocator->Adapter(kArenaAllocAssembler)),
+        literals_(allocator->Adapter(kArenaAllocAssembler)),
+        long_literals_(allocator->Adapter(kArenaAllocAssembler)),
+        overwriting_(false),
+        overwrite_location_(0),
+        last_position_adjustment_(0),
+        last_old_position_(0),
+        last_branch_id_(0) {
+    UNUSED(instruction_set_features);
+    cfi().DelayEmittingAdvancePCs();
+  }
+
+  virtual ~Loongarch64Assembler() {
+    for (auto& branch : branches_) {
+      CHECK(branch.IsResolved());
+    }
+  }
+
+  size_t CodeSize() const override { return Assembler::CodeSize(); }
+  DebugFrameOpCodeWriterForAssembler& cfi() { return Assembler::cfi(); }
+
+  // Emit Machine Instructions.
+
+  // Integer arithmetic and logic, 3R format.
+  void AddW(XRegister rd, XRegister rj, XRegister rk);
+  void AddD(XRegister rd, XRegister rj, XRegister rk);
+  void SubW(XRegister rd, XRegister rj, XRegister rk);
+  void SubD(XRegister rd, XRegister rj, XRegister rk);
+  void Slt(XRegister rd, XRegister rj, XRegister rk);
+  void Sltu(XRegister rd, XRegister rj, XRegister rk);
+  void Maskeqz(XRegister rd, XRegister rj, XRegister rk);
+  void Masknez(XRegister rd, XRegister rj, XRegister rk);
+  void Nor(XRegister rd, XRegister rj, XRegister rk);
+  void And(XRegister rd, XRegister rj, XRegister rk);
+  void Or(XRegister rd, XRegister rj, XRegister rk);
+  void Xor(XRegister rd, XRegister rj, XRegister rk);
+  void Orn(XRegister rd, XRegister rj, XRegister rk);
+  void Andn(XRegister rd, XRegister rj, XRegister rk);
+  void SllW(XRegister rd, XRegister rj, XRegister rk);
+  void SrlW(XRegister rd, XRegister rj, XRegister rk);
+  void SraW(XRegister rd, XRegister rj, XRegister rk);
+  void SllD(XRegister rd, XRegister rj, XRegister rk);
+  void SrlD(XRegister rd, XRegister rj, XRegister rk);
+  void SraD(XRegister rd, XRegister rj, XRegister rk);
+  void RotrW(XRegister rd, XRegister rj, XRegister rk);
+  void RotrD(XRegister rd, XRegister rj, XRegister rk);
+  void MulW(XRegister rd, XRegister rj, XRegister rk);
+  void MulhW(XRegister rd, XRegister rj, XRegister rk);
+  void MulhWu(XRegister rd, XRegister rj, XRegister rk);
+  void MulD(XRegister rd, XRegister rj, XRegister rk);
+  void MulhD(XRegister rd, XRegister rj, XRegister rk);
+  void MulhDu(XRegister rd, XRegister rj, XRegister rk);
+  void DivW(XRegister rd, XRegister rj, XRegister rk);
+  void ModW(XRegister rd, XRegister rj, XRegister rk);
+  void DivWu(XRegister rd, XRegister rj, XRegister rk);
+  void ModWu(XRegister rd, XRegister rj, XRegister rk);
+  void DivD(XRegister rd, XRegister rj, XRegister rk);
+  void ModD(XRegister rd, XRegister rj, XRegister rk);
+  void DivDu(XRegister rd, XRegister rj, XRegister rk);
+  void ModDu(XRegister rd, XRegister rj, XRegister rk);
+  // rd = (rj << sa) + rk, with 1 <= sa <= 4.
+  void AlslW(XRegister rd, XRegister rj, XRegister rk, int sa);
+  void AlslWu(XRegister rd, XRegister rj, XRegister rk, int sa);
+  void AlslD(XRegister rd, XRegister rj, XRegister rk, int sa);
+
+  // Bit manipulation, 2R format.
+  void CloW(XRegister rd, XRegister rj);
+  void ClzW(XRegister rd, XRegister rj);
+  void CtoW(XRegister rd, XRegister rj);
+  void CtzW(XRegister rd, XRegister rj);
+  void CloD(XRegister rd, XRegister rj);
+  void ClzD(XRegister rd, XRegister rj);
+  void CtoD(XRegister rd, XRegister rj);
+  void CtzD(XRegister rd, XRegister rj);
+  void Revb2H(XRegister rd, XRegister rj);
+  void Revb4H(XRegister rd, XRegister rj);
+  void Revb2W(XRegister rd, XRegister rj);
+  void RevbD(XRegister rd, XRegister rj);
+  void Revh2W(XRegister rd, XRegister rj);
+  void RevhD(XRegister rd, XRegister rj);
+  void Bitrev4B(XRegister rd, XRegister rj);
+  void Bitrev8B(XRegister rd, XRegister rj);
+  void BitrevW(XRegister rd, XRegister rj);
+  void BitrevD(XRegister rd, XRegister rj);
+  void ExtWH(XRegister rd, XRegister rj);
+  void ExtWB(XRegister rd, XRegister rj);
+
+  // Shifts and bit fields with immediate operands.
+  void SlliW(XRegister rd, XRegister rj, int shamt);
+  void SlliD(XRegister rd, XRegister rj, int shamt);
+  void SrliW(XRegister rd, XRegister rj, int shamt);
+  void SrliD(XRegister rd, XRegister rj, int shamt);
+  void SraiW(XRegister rd, XRegister rj, int shamt);
+  void SraiD(XRegister rd, XRegister rj, int shamt);
+  void RotriW(XRegister rd, XRegister rj, int shamt);
+  void RotriD(XRegister rd, XRegister rj, int shamt);
+  void BstrinsW(XRegister rd, XRegister rj, int msb, int lsb);
+  void BstrpickW(XRegister rd, XRegister rj, int msb, int lsb);
+  void BstrinsD(XRegister rd, XRegister rj, int msb, int lsb);
+  void BstrpickD(XRegister rd, XRegister rj, int msb, int lsb);
+
+  // Arithmetic and logic with immediate operands.
+  void Slti(XRegister rd, XRegister rj, int32_t si12);
+  void Sltui(XRegister rd, XRegister rj, int32_t si12);
+  void AddiW(XRegister rd, XRegister rj, int32_t si12);
+  void AddiD(XRegister rd, XRegister rj, int32_t si12);
+  void Lu52iD(XRegister rd, XRegister rj, int32_t si12);
+  void Andi(XRegister rd, XRegister rj, uint32_t ui12);
+  void Ori(XRegister rd, XRegister rj, uint32_t ui12);
+  void Xori(XRegister rd, XRegister rj, uint32_t ui12);
+  void Addu16iD(XRegister rd, XRegister rj, int32_t si16);
+  void Lu12iW(XRegister rd, int32_t si20);
+  void Lu32iD(XRegister rd, int32_t si20);
+  void Pcaddi(XRegister rd, int32_t si20);
+  void Pcalau12i(XRegister rd, int32_t si20);
+  void Pcaddu12i(XRegister rd, int32_t si20);
+  void Pcaddu18i(XRegister rd, int32_t si20);
+
+  // Loads and stores.
+  void LdB(XRegister rd, XRegister rj, int32_t si12);
+  void LdH(XRegister rd, XRegister rj, int32_t si12);
+  void LdW(XRegister rd, XRegister rj, int32_t si12);
+  void LdD(XRegister rd, XRegister rj, int32_t si12);
+  void LdBu(XRegister rd, XRegister rj, int32_t si12);
+  void LdHu(XRegister rd, XRegister rj, int32_t si12);
+  void LdWu(XRegister rd, XRegister rj, int32_t si12);
+  void StB(XRegister rd, XRegister rj, int32_t si12);
+  void StH(XRegister rd, XRegister rj, int32_t si12);
+  void StW(XRegister rd, XRegister rj, int32_t si12);
+  void StD(XRegister rd, XRegister rj, int32_t si12);
+  void LdxB(XRegister rd, XRegister rj, XRegister rk);
+  void LdxH(XRegister rd, XRegister rj, XRegister rk);
+  void LdxW(XRegister rd, XRegister rj, XRegister rk);
+  void LdxD(XRegister rd, XRegister rj, XRegister rk);
+  void LdxBu(XRegister rd, XRegister rj, XRegister rk);
+  void LdxHu(XRegister rd, XRegister rj, XRegister rk);
+  void LdxWu(XRegister rd, XRegister rj, XRegister rk);
+  void StxB(XRegister rd, XRegister rj, XRegister rk);
+  void StxH(XRegister rd, XRegister rj, XRegister rk);
+  void StxW(XRegister rd, XRegister rj, XRegister rk);
+  void StxD(XRegister rd, XRegister rj, XRegister rk);
+  // The `si14` offsets of the `*ptr*` and LL/SC instructions are byte offsets
+  // and must be multiples of 4.
+  void LdptrW(XRegister rd, XRegister rj, int32_t si14);
+  void LdptrD(XRegister rd, XRegister rj, int32_t si14);
+  void StptrW(XRegister rd, XRegister rj, int32_t si14);
+  void StptrD(XRegister rd, XRegister rj, int32_t si14);
+  void LlW(XRegister rd, XRegister rj, int32_t si14);
+  void LlD(XRegister rd, XRegister rj, int32_t si14);
+  void ScW(XRegister rd, XRegister rj, int32_t si14);
+  void ScD(XRegister rd, XRegister rj, int32_t si14);
+
+  // Atomic memory operations; `rj` holds the address.
+  void AmswapW(XRegister rd, XRegister rk, XRegister rj);
+  void AmswapD(XRegister rd, XRegister rk, XRegister rj);
+  void AmaddW(XRegister rd, XRegister rk, XRegister rj);
+  void AmaddD(XRegister rd, XRegister rk, XRegister rj);
+  void AmswapDbW(XRegister rd, XRegister rk, XRegister rj);
+  void AmswapDbD(XRegister rd, XRegister rk, XRegister rj);
+  void AmaddDbW(XRegister rd, XRegister rk, XRegister rj);
+  void AmaddDbD(XRegister rd, XRegister rk, XRegister rj);
+
+  // Barriers.
+  void Dbar(uint32_t hint);
+  void Ibar(uint32_t hint);
+
+  // Jumps and branches with raw byte offsets relative to the instruction itself.
+  void Jirl(XRegister rd, XRegister rj, int32_t offset);
+  void B(int32_t offset);
+  void Bl(int32_t offset);
+  void Beq(XRegister rj, XRegister rd, int32_t offset);
+  void Bne(XRegister rj, XRegister rd, int32_t offset);
+  void Blt(XRegister rj, XRegister rd, int32_t offset);
+  void Bge(XRegister rj, XRegister rd, int32_t offset);
+  void Bltu(XRegister rj, XRegister rd, int32_t offset);
+  void Bgeu(XRegister rj, XRegister rd, int32_t offset);
+  void Beqz(XRegister rj, int32_t offset);
+  void Bnez(XRegister rj, int32_t offset);
+  void Bceqz(FccRegister cj, int32_t offset);
+  void Bcnez(FccRegister cj, int32_t offset);
+
+  // Miscellaneous.
+  void Break(uint32_t code);
+
+  // Floating point arithmetic.
+  void FaddS(FRegister fd, FRegister fj, FRegister fk);
+  void FaddD(FRegister fd, FRegister fj, FRegister fk);
+  void FsubS(FRegister fd, FRegister fj, FRegister fk);
+  void FsubD(FRegister fd, FRegister fj, FRegister fk);
+  void FmulS(FRegister fd, FRegister fj, FRegister fk);
+  void FmulD(FRegister fd, FRegister fj, FRegister fk);
+  void FdivS(FRegister fd, FRegister fj, FRegister fk);
+  void FdivD(FRegister fd, FRegister fj, FRegister fk);
+  void FmaxS(FRegister fd, FRegister fj, FRegister fk);
+  void FmaxD(FRegister fd, FRegister fj, FRegister fk);
+  void FminS(FRegister fd, FRegister fj, FRegister fk);
+  void FminD(FRegister fd, FRegister fj, FRegister fk);
+  void FcopysignS(FRegister fd, FRegister fj, FRegister fk);
+  void FcopysignD(FRegister fd, FRegister fj, FRegister fk);
+  void FmaddS(FRegister fd, FRegister fj, FRegister fk, FRegister fa);
+  void FmaddD(FRegister fd, FRegister fj, FRegister fk, FRegister fa);
+  void FmsubS(FRegister fd, FRegister fj, FRegister fk, FRegister fa);
+  void FmsubD(FRegister fd, FRegister fj, FRegister fk, FRegister fa);
+  void FabsS(FRegister fd, FRegister fj);
+  void FabsD(FRegister fd, FRegister fj);
+  void FnegS(FRegister fd, FRegister fj);
+  void FnegD(FRegister fd, FRegister fj);
+  void FclassS(FRegister fd, FRegister fj);
+  void FclassD(FRegister fd, FRegister fj);
+  void FsqrtS(FRegister fd, FRegister fj);
+  void FsqrtD(FRegister fd, FRegister fj);
+  void FmovS(FRegister fd, FRegister fj);
+  void FmovD(FRegister fd, FRegister fj);
+
+  // Floating point comparison and selection.
+  void FcmpS(FpCondition cond, FccRegister cd, FRegister fj, FRegister fk);
+  void FcmpD(FpCondition cond, FccRegister cd, FRegister fj, FRegister fk);
+  // fd = (ca != 0) ? fk : fj.
+  void Fsel(FRegister fd, FRegister fj, FRegister fk, FccRegister ca);
+
+  // Floating point conversions.
+  void FcvtSD(FRegister fd, FRegister fj);
+  void FcvtDS(FRegister fd, FRegister fj);
+  void FtintrzWS(FRegister fd, FRegister fj);
+  void FtintrzWD(FRegister fd, FRegister fj);
+  void FtintrzLS(FRegister fd, FRegister fj);
+  void FtintrzLD(FRegister fd, FRegister fj);
+  void FfintSW(FRegister fd, FRegister fj);
+  void FfintSL(FRegister fd, FRegister fj);
+  void FfintDW(FRegister fd, FRegister fj);
+  void FfintDL(FRegister fd, FRegister fj);
+  void FrintS(FRegister fd, FRegister fj);
+  void FrintD(FRegister fd, FRegister fj);
+
+  // Moves between register files.
+  void Movgr2frW(FRegister fd, XRegister rj);
+  void Movgr2frD(FRegister fd, XRegister rj);
+  void Movgr2frhW(FRegister fd, XRegister rj);
+  void Movfr2grS(XRegister rd, FRegister fj);
+  void Movfr2grD(XRegister rd, FRegister fj);
+  void Movfrh2grS(XRegister rd, FRegister fj);
+  void Movgr2cf(FccRegister cd, XRegister rj);
+  void Movcf2gr(XRegister rd, FccRegister cj);
+
+  // Floating point loads and stores.
+  void FldS(FRegister fd, XRegister rj, int32_t si12);
+  void FldD(FRegister fd, XRegister rj, int32_t si12);
+  void FstS(FRegister fd, XRegister rj, int32_t si12);
+  void FstD(FRegister fd, XRegister rj, int32_t si12);
+  void FldxS(FRegister fd, XRegister rj, XRegister rk);
+  void FldxD(FRegister fd, XRegister rj, XRegister rk);
+  void FstxS(FRegister fd, XRegister rj, XRegister rk);
+  void FstxD(FRegister fd, XRegister rj, XRegister rk);
+
+  // LSX integer arithmetic. Vector registers alias the FPRs: the low 64 bits of `vrN` are `fN`.
+  // `vhaddw.*` adds the odd elements of `vj` to the even elements of `vk`, widening the result;
+  // `vmulwev.*`/`vmulwod.*` (and the `vmaddw*` variants) multiply the even/odd elements, widening.
+  void VaddB(VRegister vd, VRegister vj, VRegister vk);
+  void VaddH(VRegister vd, VRegister vj, VRegister vk);
+  void VaddW(VRegister vd, VRegister vj, VRegister vk);
+  void VaddD(VRegister vd, VRegister vj, VRegister vk);
+  void VsubB(VRegister vd, VRegister vj, VRegister vk);
+  void VsubH(VRegister vd, VRegister vj, VRegister vk);
+  void VsubW(VRegister vd, VRegister vj, VRegister vk);
+  void VsubD(VRegister vd, VRegister vj, VRegister vk);
+  void VmulB(VRegister vd, VRegister vj, VRegister vk);
+  void VmulH(VRegister vd, VRegister vj, VRegister vk);
+  void VmulW(VRegister vd, VRegister vj, VRegister vk);
+  void VmulD(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddB(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddH(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddW(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddD(VRegister vd, VRegister vj, VRegister vk);
+  void VmsubB(VRegister vd, VRegister vj, VRegister vk);
+  void VmsubH(VRegister vd, VRegister vj, VRegister vk);
+  void VmsubW(VRegister vd, VRegister vj, VRegister vk);
+  void VmsubD(VRegister vd, VRegister vj, VRegister vk);
+  void VsigncovB(VRegister vd, VRegister vj, VRegister vk);
+  void VsigncovH(VRegister vd, VRegister vj, VRegister vk);
+  void VsigncovW(VRegister vd, VRegister vj, VRegister vk);
+  void VsigncovD(VRegister vd, VRegister vj, VRegister vk);
+  void VminB(VRegister vd, VRegister vj, VRegister vk);
+  void VminH(VRegister vd, VRegister vj, VRegister vk);
+  void VminW(VRegister vd, VRegister vj, VRegister vk);
+  void VminD(VRegister vd, VRegister vj, VRegister vk);
+  void VminBu(VRegister vd, VRegister vj, VRegister vk);
+  void VminHu(VRegister vd, VRegister vj, VRegister vk);
+  void VminWu(VRegister vd, VRegister vj, VRegister vk);
+  void VminDu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaxB(VRegister vd, VRegister vj, VRegister vk);
+  void VmaxH(VRegister vd, VRegister vj, VRegister vk);
+  void VmaxW(VRegister vd, VRegister vj, VRegister vk);
+  void VmaxD(VRegister vd, VRegister vj, VRegister vk);
+  void VmaxBu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaxHu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaxWu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaxDu(VRegister vd, VRegister vj, VRegister vk);
+  void VsaddB(VRegister vd, VRegister vj, VRegister vk);
+  void VsaddH(VRegister vd, VRegister vj, VRegister vk);
+  void VsaddW(VRegister vd, VRegister vj, VRegister vk);
+  void VsaddD(VRegister vd, VRegister vj, VRegister vk);
+  void VsaddBu(VRegister vd, VRegister vj, VRegister vk);
+  void VsaddHu(VRegister vd, VRegister vj, VRegister vk);
+  void VsaddWu(VRegister vd, VRegister vj, VRegister vk);
+  void VsaddDu(VRegister vd, VRegister vj, VRegister vk);
+  void VssubB(VRegister vd, VRegister vj, VRegister vk);
+  void VssubH(VRegister vd, VRegister vj, VRegister vk);
+  void VssubW(VRegister vd, VRegister vj, VRegister vk);
+  void VssubD(VRegister vd, VRegister vj, VRegister vk);
+  void VssubBu(VRegister vd, VRegister vj, VRegister vk);
+  void VssubHu(VRegister vd, VRegister vj, VRegister vk);
+  void VssubWu(VRegister vd, VRegister vj, VRegister vk);
+  void VssubDu(VRegister vd, VRegister vj, VRegister vk);
+  void VavgB(VRegister vd, VRegister vj, VRegister vk);
+  void VavgH(VRegister vd, VRegister vj, VRegister vk);
+  void VavgW(VRegister vd, VRegister vj, VRegister vk);
+  void VavgD(VRegister vd, VRegister vj, VRegister vk);
+  void VavgBu(VRegister vd, VRegister vj, VRegister vk);
+  void VavgHu(VRegister vd, VRegister vj, VRegister vk);
+  void VavgWu(VRegister vd, VRegister vj, VRegister vk);
+  void VavgDu(VRegister vd, VRegister vj, VRegister vk);
+  void VavgrB(VRegister vd, VRegister vj, VRegister vk);
+  void VavgrH(VRegister vd, VRegister vj, VRegister vk);
+  void VavgrW(VRegister vd, VRegister vj, VRegister vk);
+  void VavgrD(VRegister vd, VRegister vj, VRegister vk);
+  void VavgrBu(VRegister vd, VRegister vj, VRegister vk);
+  void VavgrHu(VRegister vd, VRegister vj, VRegister vk);
+  void VavgrWu(VRegister vd, VRegister vj, VRegister vk);
+  void VavgrDu(VRegister vd, VRegister vj, VRegister vk);
+  void VabsdB(VRegister vd, VRegister vj, VRegister vk);
+  void VabsdH(VRegister vd, VRegister vj, VRegister vk);
+  void VabsdW(VRegister vd, VRegister vj, VRegister vk);
+  void VabsdD(VRegister vd, VRegister vj, VRegister vk);
+  void VabsdBu(VRegister vd, VRegister vj, VRegister vk);
+  void VabsdHu(VRegister vd, VRegister vj, VRegister vk);
+  void VabsdWu(VRegister vd, VRegister vj, VRegister vk);
+  void VabsdDu(VRegister vd, VRegister vj, VRegister vk);
+  void VhaddwHB(VRegister vd, VRegister vj, VRegister vk);
+  void VhaddwWH(VRegister vd, VRegister vj, VRegister vk);
+  void VhaddwDW(VRegister vd, VRegister vj, VRegister vk);
+  void VhaddwQD(VRegister vd, VRegister vj, VRegister vk);
+  void VhaddwHuBu(VRegister vd, VRegister vj, VRegister vk);
+  void VhaddwWuHu(VRegister vd, VRegister vj, VRegister vk);
+  void VhaddwDuWu(VRegister vd, VRegister vj, VRegister vk);
+  void VhaddwQuDu(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwevHB(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwevWH(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwevDW(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwevHBu(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwevWHu(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwevDWu(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwodHB(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwodWH(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwodDW(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwodHBu(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwodWHu(VRegister vd, VRegister vj, VRegister vk);
+  void VmulwodDWu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwevHB(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwevWH(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwevDW(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwevHBu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwevWHu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwevDWu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwodHB(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwodWH(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwodDW(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwodHBu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwodWHu(VRegister vd, VRegister vj, VRegister vk);
+  void VmaddwodDWu(VRegister vd, VRegister vj, VRegister vk);
+
+  // LSX bitwise logic. `vandn.v` computes `vd = ~vj & vk`.
+  void VandV(VRegister vd, VRegister vj, VRegister vk);
+  void VorV(VRegister vd, VRegister vj, VRegister vk);
+  void VxorV(VRegister vd, VRegister vj, VRegister vk);
+  void VnorV(VRegister vd, VRegister vj, VRegister vk);
+  void VandnV(VRegister vd, VRegister vj, VRegister vk);
+
+  // LSX floating point arithmetic.
+  void VfaddS(VRegister vd, VRegister vj, VRegister vk);
+  void VfaddD(VRegister vd, VRegister vj, VRegister vk);
+  void VfsubS(VRegister vd, VRegister vj, VRegister vk);
+  void VfsubD(VRegister vd, VRegister vj, VRegister vk);
+  void VfmulS(VRegister vd, VRegister vj, VRegister vk);
+  void VfmulD(VRegister vd, VRegister vj, VRegister vk);
+  void VfdivS(VRegister vd, VRegister vj, VRegister vk);
+  void VfdivD(VRegister vd, VRegister vj, VRegister vk);
+  void VfminS(VRegister vd, VRegister vj, VRegister vk);
+  void VfminD(VRegister vd, VRegister vj, VRegister vk);
+  void VfmaxS(VRegister vd, VRegister vj, VRegister vk);
+  void VfmaxD(VRegister vd, VRegister vj, VRegister vk);
+  void VffintSW(VRegister vd, VRegister vj);
+  void VffintDL(VRegister vd, VRegister vj);
+  void VftintrzWS(VRegister vd, VRegister vj);
+  void VftintrzLD(VRegister vd, VRegister vj);
+
+  // LSX unary operations and conversions.
+  void VnegB(VRegister vd, VRegister vj);
+  void VnegH(VRegister vd, VRegister vj);
+  void VnegW(VRegister vd, VRegister vj);
+  void VnegD(VRegister vd, VRegister vj);
+
+  // LSX element moves and replication. `vrepli.*` replicates a sign-extended 10-bit immediate.
+  void Vreplgr2vrB(VRegister vd, XRegister rj);
+  void Vreplgr2vrH(VRegister vd, XRegister rj);
+  void Vreplgr2vrW(VRegister vd, XRegister rj);
+  void Vreplgr2vrD(VRegister vd, XRegister rj);
+  void VreplveiB(VRegister vd, VRegister vj, int ui4);
+  void VreplveiH(VRegister vd, VRegister vj, int ui3);
+  void VreplveiW(VRegister vd, VRegister vj, int ui2);
+  void VreplveiD(VRegister vd, VRegister vj, int ui1);
+  void Vinsgr2vrB(VRegister vd, XRegister rj, int ui4);
+  void Vinsgr2vrH(VRegister vd, XRegister rj, int ui3);
+  void Vinsgr2vrW(VRegister vd, XRegister rj, int ui2);
+  void Vinsgr2vrD(VRegister vd, XRegister rj, int ui1);
+  void Vpickve2grB(XRegister rd, VRegister vj, int ui4);
+  void Vpickve2grH(XRegister rd, VRegister vj, int ui3);
+  void Vpickve2grW(XRegister rd, VRegister vj, int ui2);
+  void Vpickve2grD(XRegister rd, VRegister vj, int ui1);
+  void Vpickve2grBu(XRegister rd, VRegister vj, int ui4);
+  void Vpickve2grHu(XRegister rd, VRegister vj, int ui3);
+  void Vpickve2grWu(XRegister rd, VRegister vj, int ui2);
+  void Vpickve2grDu(XRegister rd, VRegister vj, int ui1);
+  void VrepliB(VRegister vd, int32_t si10);
+  void VrepliH(VRegister vd, int32_t si10);
+  void VrepliW(VRegister vd, int32_t si10);
+  void VrepliD(VRegister vd, int32_t si10);
+
+  // LSX shifts and bit operations with immediate operands. `vsllwil.*` with a zero shift
+  // widens the elements of the low half of `vj`.
+  void VslliB(VRegister vd, VRegister vj, int ui3);
+  void VslliH(VRegister vd, VRegister vj, int ui4);
+  void VslliW(VRegister vd, VRegister vj, int ui5);
+  void VslliD(VRegister vd, VRegister vj, int ui6);
+  void VsrliB(VRegister vd, VRegister vj, int ui3);
+  void VsrliH(VRegister vd, VRegister vj, int ui4);
+  void VsrliW(VRegister vd, VRegister vj, int ui5);
+  void VsrliD(VRegister vd, VRegister vj, int ui6);
+  void VsraiB(VRegister vd, VRegister vj, int ui3);
+  void VsraiH(VRegister vd, VRegister vj, int ui4);
+  void VsraiW(VRegister vd, VRegister vj, int ui5);
+  void VsraiD(VRegister vd, VRegister vj, int ui6);
+  void VbitclriW(VRegister vd, VRegister vj, int ui5);
+  void VbitclriD(VRegister vd, VRegister vj, int ui6);
+  void VbitreviW(VRegister vd, VRegister vj, int ui5);
+  void VbitreviD(VRegister vd, VRegister vj, int ui6);
+  void VbsrlV(VRegister vd, VRegister vj, int ui5);
+  void VbsllV(VRegister vd, VRegister vj, int ui5);
+  void VsllwilHB(VRegister vd, VRegister vj, int ui3);
+  void VsllwilWH(VRegister vd, VRegister vj, int ui4);
+  void VsllwilDW(VRegister vd, VRegister vj, int ui5);
+  void VsllwilHuBu(VRegister vd, VRegister vj, int ui3);
+  void VsllwilWuHu(VRegister vd, VRegister vj, int ui4);
+  void VsllwilDuWu(VRegister vd, VRegister vj, int ui5);
+
+  // LSX loads and stores of a full 128-bit vector register.
+  void Vld(VRegister vd, XRegister rj, int32_t si12);
+  void Vst(VRegister vd, XRegister rj, int32_t si12);
+  void Vldx(VRegister vd, XRegister rj, XRegister rk);
+  void Vstx(VRegister vd, XRegister rj, XRegister rk);
+
+  // Pseudo instructions.
+  void Nop();
+  void Move(XRegister rd, XRegister rj);
+  void Clear(XRegister rd);
+  void Not(XRegister rd, XRegister rj);
+  void Jr(XRegister rj);
+  void Jalr(XRegister rj);
+  void Ret();
+  // Copy a whole 128-bit vector register.
+  void MoveV(VRegister vd, VRegister vj);
+
+  // Macro instructions. These may use TMP for intermediate values.
+  void LoadConst32(XRegister rd, int32_t value);
+  void LoadConst64(XRegister rd, int64_t value);
+  void AddConst32(XRegister rd, XRegister rj, int32_t value);
+  void AddConst64(XRegister rd, XRegister rj, int64_t value);
+
+  void LoadFromOffset(LoadOperandType type, XRegister reg, XRegister base, int32_t offset);
+  void StoreToOffset(StoreOperandType type, XRegister reg, XRegister base, int32_t offset);
+  void LoadFpuFromOffset(LoadOperandType type, FRegister reg, XRegister base, int32_t offset);
+  void StoreFpuToOffset(StoreOperandType type, FRegister reg, XRegister base, int32_t offset);
+  void LoadVFromOffset(VRegister reg, XRegister base, int32_t offset);
+  void StoreVToOffset(VRegister reg, XRegister base, int32_t offset);
+
+  //
+  // Heap poisoning.
+  //
+
+  // Poison a heap reference contained in `reg`.
+  void PoisonHeapReference(XRegister reg);
+  // Unpoison a heap reference contained in `reg`.
+  void UnpoisonHeapReference(XRegister reg);
+  // Poison a heap reference contained in `reg` if heap poisoning is enabled.
+  void MaybePoisonHeapReference(XRegister reg);
+  // Unpoison a heap reference contained in `reg` if heap poisoning is enabled.
+  void MaybeUnpoisonHeapReference(XRegister reg);
+
+  // Branches to labels. Short forms are used whenever the target is in range,
+  // otherwise the branch is expanded when the code is finalized.
+  void B(Loongarch64Label* label);
+  void Bl(Loongarch64Label* label);
+  void Beq(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Bne(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Blt(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Bge(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Bltu(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Bgeu(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Bgt(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Ble(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Bgtu(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Bleu(XRegister rj, XRegister rd, Loongarch64Label* label);
+  void Beqz(XRegister rj, Loongarch64Label* label);
+  void Bnez(XRegister rj, Loongarch64Label* label);
+  void Bceqz(FccRegister cj, Loongarch64Label* label);
+  void Bcnez(FccRegister cj, Loongarch64Label* label);
+
+  void Bind(Label* label) override {
+    Bind(down_cast<Loongarch64Label*>(label));
+  }
+  void Jump(Label* label) override {
+    B(down_cast<Loongarch64Label*>(label));
+  }
+
+  void Bind(Loongarch64Label* label);
+
+  // Load the address of a label: `pcaddu12i` followed by `addi.d`.
+  void LoadLabelAddress(XRegister dest_reg, Loongarch64Label* label);
+
+  // Create a new literal with the given data.
+  Literal* NewLiteral(size_t size, const uint8_t* data);
+
+  // Create a new literal with a given value.
+  // NOTE: Force the template parameter to be explicitly specified.
+  template <typename T>
+  Literal* NewLiteral(typename Identity<T>::type value) {
+    static_assert(std::is_integral<T>::value, "T must be an integral type.");
+    return NewLiteral(sizeof(value), reinterpret_cast<const uint8_t*>(&value));
+  }
+
+  // Load a literal: `pcaddu12i` followed by a load of the literal's size. 32-bit literals
+  // can be loaded with `kLoadWord` or `kLoadUnsignedWord`, 64-bit ones with `kLoadDoubleword`.
+  void LoadLiteral(XRegister dest_reg, LoadOperandType load_type, Literal* literal);
+
+  // Get the final position of a label after local fixup based on the old position
+  // recorded before FinalizeCode().
+  uint32_t GetAdjustedPosition(uint32_t old_position);
+
+  // Returns the (always-)current location of a label (can be used in class CodeGeneratorLoongarch64,
+  // must be used instead of Loongarch64Label::GetPosition()).
+  uint32_t GetLabelLocation(const Loongarch64Label* label) const;
+
+  // Promote branches that cannot reach their targets with the short encodings.
+  void FinalizeCode() override;
+
+  // Emit the final branch encodings, copy the code to `region` and fix up the CFI.
+  void FinalizeInstructions(const MemoryRegion& region) override;
+
+ private:
+  enum BranchCondition : uint8_t {
+    kCondEQ,
+    kCondNE,
+    kCondLT,
+    kCondGE,
+    kCondLTU,
+    kCondGEU,
+    kCondEQZ,
+    kCondNEZ,
+    kCondF,  // FPU condition flag is false.
+    kCondT,  // FPU condition flag is true.
+    kUncond,
+  };
+
+  class Branch {
+   public:
+    enum Type {
+      // Short branches.
+      kUncondBranch,
+      kCondBranch,
+      kCondBranchZ,
+      kFpuCondBranch,
+      kCall,
+      // Long branches.
+      kLongUncondBranch,
+      kLongCondBranch,
+      kLongCondBranchZ,
+      kLongFpuCondBranch,
+      kLongCall,
+      // PC-relative loads of label addresses and literals. These always use the
+      // 32-bit `pcaddu12i` form and are never promoted.
+      kLabel,
+      kLiteral,
+      kLiteralUnsigned,
+      kLiteralLong,
+    };
+
+    // Bit sizes of offsets defined as enums to minimize chance of typos.
+    enum OffsetBits {
+      kOffset18 = 18,
+      kOffset23 = 23,
+      kOffset28 = 28,
+      kOffset32 = 32,
+      kOffset38 = 38,
+    };
+
+    static constexpr uint32_t kUnresolved = 0xffffffff;  // Unresolved target_
+    static constexpr int32_t kMaxBranchLength = 12;  // In bytes.
+
+    struct BranchInfo {
+      // Branch length as a number of 4-byte-long instructions.
+      uint32_t length;
+      // Instruction index (0-based) of the instruction holding the PC-relative offset
+      // (or the first of the instructions holding it for a long branch). The offset
+      // is always relative to that instruction.
+      uint32_t instr_offset;
+      // How large (in bits) a PC-relative offset can be for a given type of branch.
+      OffsetBits offset_size;
+    };
+    static const BranchInfo branch_info_[/* Type */];
+
+    // Unconditional branch or call.
+    Branch(uint32_t location, uint32_t target, bool is_call);
+    // Conditional branch.
+    Branch(uint32_t location,
+           uint32_t target,
+           BranchCondition condition,
+           uint32_t lhs_reg,
+           uint32_t rhs_reg);
+    // Label address or literal load.
+    Branch(uint32_t location, XRegister dest_reg, Type label_or_literal_type);
+
+    // Some conditional branches with lhs = rhs are effectively NOPs, while some
+    // others are effectively unconditional.
+    static bool IsNop(BranchCondition condition, uint32_t lhs, uint32_t rhs);
+    static bool IsUncond(BranchCondition condition, uint32_t lhs, uint32_t rhs);
+
+    static BranchCondition OppositeCondition(BranchCondition cond);
+
+    Type GetType() const;
+    BranchCondition GetCondition() const;
+    uint32_t GetLeftRegister() const;
+    uint32_t GetRightRegister() const;
+    uint32_t GetTarget() const;
+    uint32_t GetLocation() const;
+    uint32_t GetOldLocation() const;
+    uint32_t GetLength() const;
+    uint32_t GetOldLength() const;
+    uint32_t GetSize() const;
+    uint32_t GetOldSize() const;
+    uint32_t GetEndLocation() const;
+    uint32_t GetOldEndLocation() const;
+    bool IsLong() const;
+    bool IsResolved() const;
+
+    // Returns the bit size of the signed offset that the branch instruction can handle.
+    OffsetBits GetOffsetSize() const;
+
+    // Calculates the distance between two byte locations in the assembler buffer and
+    // returns the number of bits needed to represent the distance as a signed integer.
+    static OffsetBits GetOffsetSizeNeeded(uint32_t location, uint32_t target);
+
+    // Resolve a branch when the target is known.
+    void Resolve(uint32_t target);
+
+    // Relocate a branch by a given delta if needed due to expansion of this or another
+    // branch at a given location by this delta (just changes location_ and target_).
+    void Relocate(uint32_t expand_location, uint32_t delta);
+
+    // If the branch is short, changes its type to long.
+    void PromoteToLong();
+
+    // If necessary, updates the type by promoting a short branch to a long branch
+    // based on the branch location and target. Returns the amount (in bytes) by
+    // which the branch size has increased.
+    uint32_t PromoteIfNeeded();
+
+    // Returns the location of the instruction(s) containing the offset.
+    uint32_t GetOffsetLocation() const;
+
+    // Calculates and returns the offset ready for encoding in the branch instruction(s).
+    int32_t GetOffset() const;
+
+   private:
+    // Completes branch construction by determining and recording its type.
+    void InitializeType(Type initial_type);
+    // Helper for the above.
+    void InitShortOrLong(OffsetBits ofs_size, Type short_type, Type long_type);
+
+    uint32_t old_location_;  // Offset into assembler buffer in bytes.
+    uint32_t location_;      // Offset into assembler buffer in bytes.
+    uint32_t target_;        // Offset into assembler buffer in bytes.
+
+    uint32_t lhs_reg_;          // Left-hand side register in conditional branches or
+                                // FPU condition flag register in FPU conditional branches or
+                                // destination register in label address and literal loads.
+    uint32_t rhs_reg_;          // Right-hand side register in conditional branches.
+    BranchCondition condition_;  // Condition for conditional branches.
+
+    Type type_;      // Current type of the branch.
+    Type old_type_;  // Initial type of the branch.
+  };
+
+  friend std::ostream& operator<<(std::ostream& os, const BranchCondition& rhs);
+
+  void Emit(uint32_t value);
+
+  // Emit helpers, named after the instruction formats of the LoongArch reference manual.
+  void Emit2R(uint32_t opcode, uint32_t rj, uint32_t rd);
+  void Emit3R(uint32_t opcode, uint32_t rk, uint32_t rj, uint32_t rd);
+  void Emit4R(uint32_t opcode, uint32_t ra, uint32_t rk, uint32_t rj, uint32_t rd);
+  void Emit2RI12(uint32_t opcode, int32_t imm12, uint32_t rj, uint32_t rd);
+  void Emit2RI14(uint32_t opcode, int32_t imm14, uint32_t rj, uint32_t rd);
+  void Emit2RI16(uint32_t opcode, int32_t imm16, uint32_t rj, uint32_t rd);
+  void Emit1RI20(uint32_t opcode, int32_t imm20, uint32_t rd);
+  void Emit1RI21(uint32_t opcode, int32_t imm21, uint32_t rj);
+  void EmitI26(uint32_t opcode, int32_t imm26);
+  // Branch offsets are byte offsets which are encoded shifted right by 2.
+  void EmitBranch2RI16(uint32_t opcode, int32_t offset, uint32_t rj, uint32_t rd);
+
+  // Emit a branch of the given type with a raw byte offset, used when fixing up branches.
+  void EmitBcond(BranchCondition cond, uint32_t lhs, uint32_t rhs, int32_t offset);
+
+  void Buncond(Loongarch64Label* label, bool is_call);
+  void Bcond(Loongarch64Label* label, BranchCondition condition, uint32_t lhs, uint32_t rhs = 0);
+
+  Branch* GetBranch(uint32_t branch_id);
+  const Branch* GetBranch(uint32_t branch_id) const;
+
+  void EmitBranch(Branch* branch);
+  void EmitBranches();
+  void FinalizeLabeledBranch(Loongarch64Label* label);
+  void PromoteBranches();
+  void EmitLiterals();
+  void AlignLongLiterals();
+  void PatchCFI();
+
+  // List of branches in order of their locations.
+  ArenaVector<Branch> branches_;
+
+  // Use `std::deque<>` for literal labels to allow insertions at the end
+  // without invalidating pointers and references to existing elements.
+  ArenaDeque<Literal> literals_;
+  ArenaDeque<Literal> long_literals_;  // 64-bit literals separated for alignment reasons.
+
+  // Whether appending instructions at the end of the buffer or overwriting the existing ones.
+  bool overwriting_;
+  // The current overwrite location.
+  uint32_t overwrite_location_;
+
+  // Data for GetAdjustedPosition(), see the description there.
+  uint32_t last_position_adjustment_;
+  uint32_t last_old_position_;
+  uint32_t last_branch_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(Loongarch64Assembler);
+};
+
+}  // namespace loongarch64
+}  // namespace art
+
+#endif  // ART_COMPILER_UTILS_LOONGARCH64_ASSEMBLER_LOONGARCH64_H_
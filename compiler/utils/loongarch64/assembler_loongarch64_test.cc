@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "assembler_loongarch64.h"
+
+#include <vector>
+
+#include "base/array_ref.h"
+#include "base/malloc_arena_pool.h"
+#include "gtest/gtest.h"
+#include "jni_macro_assembler_loongarch64.h"
+#include "managed_register_loongarch64.h"
+#include "utils/managed_register.h"
+
+namespace art {
+namespace loongarch64 {
+
+// The expected encodings below are checked in rather than produced by an external
+// assembler, so that the tests can run on any host without a LoongArch toolchain.
+class AssemblerLoongarch64Test : public ::testing::Test {
+ public:
+  AssemblerLoongarch64Test() : pool_(), allocator_(&pool_), assembler_(&allocator_) {}
+
+ protected:
+  static std::vector<uint32_t> Finalize(Assembler* assembler) {
+    assembler->FinalizeCode();
+    size_t code_size = assembler->CodeSize();
+    EXPECT_TRUE(IsAligned<sizeof(uint32_t)>(code_size)) << code_size;
+    std::vector<uint32_t> code(code_size / sizeof(uint32_t));
+    MemoryRegion region(code.data(), code_size);
+    assembler->FinalizeInstructions(region);
+    return code;
+  }
+
+  void EmitNops(size_t count) {
+    for (size_t i = 0; i != count; ++i) {
+      assembler_.Nop();
+    }
+  }
+
+  static constexpr uint32_t kNop = 0x03400000u;  // andi $zero, $zero, 0
+
+  MallocArenaPool pool_;
+  ArenaAllocator allocator_;
+  Loongarch64Assembler assembler_;
+};
+
+#define __ assembler_.
+
+TEST_F(AssemblerLoongarch64Test, BasicEncodings) {
+  __ AddD(A0, A1, A2);
+  __ AddiD(SP, SP, -16);
+  __ LdD(RA, SP, 8);
+  __ StW(T0, A7, -4);
+  __ Move(A0, A1);
+  __ Nop();
+  __ Jr(TMP);
+  __ Break(0);
+
+  std::vector<uint32_t> expected = {
+      0x001098a4u,  // add.d   $a0, $a1, $a2
+      0x02ffc063u,  // addi.d  $sp, $sp, -16
+      0x28c02061u,  // ld.d    $ra, $sp, 8
+      0x29bff16cu,  // st.w    $t0, $a7, -4
+      0x001500a4u,  // or      $a0, $a1, $zero
+      kNop,         // nop
+      0x4c000260u,  // jirl    $zero, $t7, 0
+      0x002a0000u,  // break   0
+  };
+  EXPECT_EQ(expected, Finalize(&assembler_));
+}
+
+TEST_F(AssemblerLoongarch64Test, ShortBranches) {
+  Loongarch64Label forward;
+  Loongarch64Label backward;
+  __ Beqz(A0, &forward);
+  __ Nop();
+  __ Bind(&forward);
+  __ Bind(&backward);
+  __ Nop();
+  __ B(&backward);
+  __ Bnez(A1, &backward);
+
+  std::vector<uint32_t> expected = {
+      0x40000880u,  // beqz    $a0, 8
+      kNop,
+      kNop,
+      0x53ffffffu,  // b       -4
+      0x47fff8bfu,  // bnez    $a1, -8
+  };
+  EXPECT_EQ(expected, Finalize(&assembler_));
+}
+
+TEST_F(AssemblerLoongarch64Test, CondBranchAtShortLimit) {
+  // The largest gap that still fits the 16-bit offset of `beq` once the
+  // composite branch slack is accounted for.
+  static constexpr size_t kNopCount = 32763u;
+  Loongarch64Label label;
+  __ Beq(A0, A1, &label);
+  EmitNops(kNopCount);
+  __ Bind(&label);
+
+  std::vector<uint32_t> code = Finalize(&assembler_);
+  ASSERT_EQ(1u + kNopCount, code.size());
+  EXPECT_EQ(0x59fff085u, code[0]);  // beq     $a0, $a1, 131056
+  EXPECT_EQ(kNop, code.back());
+}
+
+TEST_F(AssemblerLoongarch64Test, LongCondBranch) {
+  // One instruction more than fits the 16-bit offset; the branch is relaxed
+  // to an inverted-condition branch over an unconditional `b`.
+  static constexpr size_t kNopCount = 32768u;
+  Loongarch64Label label;
+  __ Beq(A0, A1, &label);
+  EmitNops(kNopCount);
+  __ Bind(&label);
+
+  std::vector<uint32_t> code = Finalize(&assembler_);
+  ASSERT_EQ(2u + kNopCount, code.size());
+  EXPECT_EQ(0x5c000885u, code[0]);  // bne     $a0, $a1, 8
+  EXPECT_EQ(0x52000400u, code[1]);  // b       131076
+  EXPECT_EQ(kNop, code.back());
+}
+
+TEST_F(AssemblerLoongarch64Test, LoadLabelAddress) {
+  Loongarch64Label label;
+  __ LoadLabelAddress(A0, &label);
+  __ Nop();
+  __ Bind(&label);
+
+  std::vector<uint32_t> expected = {
+      0x1c000004u,  // pcaddu12i $a0, 0
+      0x02c03084u,  // addi.d    $a0, $a0, 12
+      kNop,
+  };
+  EXPECT_EQ(expected, Finalize(&assembler_));
+}
+
+TEST_F(AssemblerLoongarch64Test, LoadLabelAddressRoundsHighPart) {
+  // An offset of 0x808 needs a negative low part and a rounded-up high part.
+  Loongarch64Label label;
+  __ LoadLabelAddress(A0, &label);
+  EmitNops(0x200u);
+  __ Bind(&label);
+
+  std::vector<uint32_t> code = Finalize(&assembler_);
+  ASSERT_EQ(2u + 0x200u, code.size());
+  EXPECT_EQ(0x1c000024u, code[0]);  // pcaddu12i $a0, 1
+  EXPECT_EQ(0x02e02084u, code[1]);  // addi.d    $a0, $a0, -2040
+}
+
+TEST_F(AssemblerLoongarch64Test, Literals) {
+  Literal* literal32 = __ NewLiteral<uint32_t>(0x12345678u);
+  Literal* literal64 = __ NewLiteral<uint64_t>(UINT64_C(0x0123456789abcdef));
+  __ LoadLiteral(A0, kLoadWord, literal32);
+  __ LoadLiteral(A1, kLoadDoubleword, literal64);
+
+  std::vector<uint32_t> expected = {
+      0x1c000004u,  // pcaddu12i $a0, 0
+      0x28804084u,  // ld.w      $a0, $a0, 16
+      0x1c000005u,  // pcaddu12i $a1, 0
+      0x28c040a5u,  // ld.d      $a1, $a1, 16
+      0x12345678u,
+      kNop,         // Padding keeping the 64-bit literal aligned.
+      0x89abcdefu,
+      0x01234567u,
+  };
+  EXPECT_EQ(expected, Finalize(&assembler_));
+  EXPECT_EQ(16u, __ GetLabelLocation(literal32->GetLabel()));
+  EXPECT_EQ(24u, __ GetLabelLocation(literal64->GetLabel()));
+}
+
+TEST_F(AssemblerLoongarch64Test, LongLiteralAlignment) {
+  // Without 32-bit literals the reserved padding is not needed and is removed.
+  Literal* literal64 = __ NewLiteral<uint64_t>(UINT64_C(0x0123456789abcdef));
+  __ LoadLiteral(A1, kLoadDoubleword, literal64);
+
+  std::vector<uint32_t> expected = {
+      0x1c000005u,  // pcaddu12i $a1, 0
+      0x28c020a5u,  // ld.d      $a1, $a1, 8
+      0x89abcdefu,
+      0x01234567u,
+  };
+  EXPECT_EQ(expected, Finalize(&assembler_));
+  EXPECT_EQ(8u, __ GetLabelLocation(literal64->GetLabel()));
+}
+
+TEST_F(AssemblerLoongarch64Test, LsxEncodings) {
+  __ VaddW(VR0, VR1, VR2);
+  __ VsubD(VR3, VR4, VR5);
+  __ VmulH(VR6, VR7, VR8);
+  __ VmaddW(VR0, VR1, VR2);
+  __ VminBu(VR1, VR2, VR3);
+  __ VsaddH(VR1, VR2, VR3);
+  __ VavgrBu(VR1, VR2, VR3);
+  __ VabsdB(VR1, VR2, VR3);
+  __ VhaddwDW(VR4, VR5, VR5);
+  __ VmulwevHBu(VR4, VR5, VR6);
+  __ VandnV(VR7, VR8, VR9);
+  __ VfmulD(VR10, VR11, VR12);
+  __ VnegB(VR13, VR14);
+  __ VffintSW(VR15, VR16);
+  __ Vreplgr2vrW(VR0, A0);
+  __ VreplveiD(VR1, VR2, 1);
+  __ Vinsgr2vrH(VR3, A1, 7);
+  __ Vpickve2grWu(A2, VR4, 3);
+  __ VslliB(VR5, VR6, 7);
+  __ VsraiD(VR5, VR6, 63);
+  __ VbitreviW(VR7, VR8, 31);
+  __ VbsrlV(VR9, VR10, 8);
+  __ VsllwilHuBu(VR11, VR12, 0);
+  __ VrepliB(VR13, -1);
+  __ Vld(VR14, SP, -16);
+  __ Vst(VR15, A0, 2032);
+  __ Vldx(VR16, A1, A2);
+  __ MoveV(VR17, VR18);
+
+  std::vector<uint32_t> expected = {
+      0x700b0820u,  // vadd.w  $vr0, $vr1, $vr2
+      0x700d9483u,  // vsub.d  $vr3, $vr4, $vr5
+      0x7084a0e6u,  // vmul.h  $vr6, $vr7, $vr8
+      0x70a90820u,  // vmadd.w $vr0, $vr1, $vr2
+      0x70760c41u,  // vmin.bu $vr1, $vr2, $vr3
+      0x70468c41u,  // vsadd.h $vr1, $vr2, $vr3
+      0x706a0c41u,  // vavgr.bu $vr1, $vr2, $vr3
+      0x70600c41u,  // vabsd.b $vr1, $vr2, $vr3
+      0x705514a4u,  // vhaddw.d.w $vr4, $vr5, $vr5
+      0x709818a4u,  // vmulwev.h.bu $vr4, $vr5, $vr6
+      0x71282507u,  // vandn.v $vr7, $vr8, $vr9
+      0x7139316au,  // vfmul.d $vr10, $vr11, $vr12
+      0x729c31cdu,  // vneg.b  $vr13, $vr14
+      0x729e020fu,  // vffint.s.w $vr15, $vr16
+      0x729f0880u,  // vreplgr2vr.w $vr0, $a0
+      0x72f7f441u,  // vreplvei.d $vr1, $vr2, 1
+      0x72ebdca3u,  // vinsgr2vr.h $vr3, $a1, 7
+      0x72f3ec86u,  // vpickve2gr.wu $a2, $vr4, 3
+      0x732c3cc5u,  // vslli.b $vr5, $vr6, 7
+      0x7335fcc5u,  // vsrai.d $vr5, $vr6, 63
+      0x7318fd07u,  // vbitrevi.w $vr7, $vr8, 31
+      0x728ea149u,  // vbsrl.v $vr9, $vr10, 8
+      0x730c218bu,  // vsllwil.hu.bu $vr11, $vr12, 0
+      0x73e07fedu,  // vrepli.b $vr13, -1
+      0x2c3fc06eu,  // vld     $vr14, $sp, -16
+      0x2c5fc08fu,  // vst     $vr15, $a0, 2032
+      0x384018b0u,  // vldx    $vr16, $a1, $a2
+      0x7126ca51u,  // vor.v   $vr17, $vr18, $vr18
+  };
+  EXPECT_EQ(expected, Finalize(&assembler_));
+}
+
+TEST_F(AssemblerLoongarch64Test, LsxLoadStoreOffsets) {
+  __ LoadVFromOffset(VR1, SP, 4096);
+  __ StoreVToOffset(VR2, SP, 2047);
+  __ StoreVToOffset(VR2, SP, 4096);
+
+  std::vector<uint32_t> expected = {
+      0x14000033u,  // lu12i.w $t7, 1
+      0x38404c61u,  // vldx    $vr1, $sp, $t7
+      0x2c5ffc62u,  // vst     $vr2, $sp, 2047
+      0x14000033u,  // lu12i.w $t7, 1
+      0x38444c62u,  // vstx    $vr2, $sp, $t7
+  };
+  EXPECT_EQ(expected, Finalize(&assembler_));
+}
+
+#undef __
+
+TEST_F(AssemblerLoongarch64Test, JniFrame) {
+  Loongarch64JNIMacroAssembler jni_asm(&allocator_);
+  const ManagedRegister callee_saves[] = {
+      Loongarch64ManagedRegister::FromXRegister(RA),
+      Loongarch64ManagedRegister::FromXRegister(S0),
+      Loongarch64ManagedRegister::FromFRegister(FS0),
+  };
+  ArrayRef<const ManagedRegister> callee_saves_ref(callee_saves);
+  jni_asm.BuildFrame(32u, Loongarch64ManagedRegister::FromXRegister(A0), callee_saves_ref);
+  jni_asm.RemoveFrame(32u, callee_saves_ref, /* may_suspend= */ true);
+
+  std::vector<uint32_t> expected = {
+      0x02ff8063u,  // addi.d  $sp, $sp, -32
+      0x29c06061u,  // st.d    $ra, $sp, 24
+      0x29c04077u,  // st.d    $s0, $sp, 16
+      0x2bc02078u,  // fst.d   $fs0, $sp, 8
+      0x29c00064u,  // st.d    $a0, $sp, 0
+      0x28c06061u,  // ld.d    $ra, $sp, 24
+      0x28c04077u,  // ld.d    $s0, $sp, 16
+      0x2b802078u,  // fld.d   $fs0, $sp, 8
+      0x02c08063u,  // addi.d  $sp, $sp, 32
+      0x4c000020u,  // jirl    $zero, $ra, 0
+  };
+  jni_asm.FinalizeCode();
+  size_t code_size = jni_asm.CodeSize();
+  std::vector<uint32_t> code(code_size / sizeof(uint32_t));
+  MemoryRegion region(code.data(), code_size);
+  jni_asm.FinalizeInstructions(region);
+  EXPECT_EQ(expected, code);
+}
+
+}  // namespace loongarch64
+}  // namespace art
@@ -0,0 +1,680 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jni_macro_assembler_loongarch64.h"
+
+#include "base/bit_utils_iterator.h"
+#include "dwarf/register.h"
+#include "entrypoints/quick/quick_entrypoints.h"
+#include "managed_register_loongarch64.h"
+#include "offsets.h"
+#include "thread.h"
+
+namespace art {
+namespace loongarch64 {
+
+#ifdef __
+#error "LOONGARCH64 Assembler macro already defined."
+#else
+#define __ asm_.
+#endif
+
+static dwarf::Reg DWARFReg(XRegister reg) {
+  return dwarf::Reg::Loongarch64Core(static_cast<int>(reg));
+}
+
+static dwarf::Reg DWARFReg(FRegister reg) {
+  return dwarf::Reg::Loongarch64Fp(static_cast<int>(reg));
+}
+
+static constexpr size_t kSpillSize = 8u;  // Both GPRs and FPRs are spilled as 64-bit values.
+
+Loongarch64JNIMacroAssembler::~Loongarch64JNIMacroAssembler() {
+}
+
+void Loongarch64JNIMacroAssembler::FinalizeCode() {
+  for (const std::unique_ptr<Loongarch64Exception>& exception : exception_blocks_) {
+    EmitExceptionPoll(exception.get());
+  }
+  __ FinalizeCode();
+}
+
+void Loongarch64JNIMacroAssembler::BuildFrame(size_t frame_size,
+                                              ManagedRegister method_reg,
+                                              ArrayRef<const ManagedRegister> callee_save_regs) {
+  // Collect the callee-save registers to spill.
+  uint32_t core_spill_mask = 0u;
+  uint32_t fp_spill_mask = 0u;
+  for (const ManagedRegister& r : callee_save_regs) {
+    Loongarch64ManagedRegister reg = r.AsLoongarch64();
+    if (reg.IsXRegister()) {
+      core_spill_mask |= 1u << reg.AsXRegister();
+    } else {
+      DCHECK(reg.IsFRegister());
+      fp_spill_mask |= 1u << reg.AsFRegister();
+    }
+  }
+  DCHECK_LE((POPCOUNT(core_spill_mask) + POPCOUNT(fp_spill_mask)) * kSpillSize, frame_size);
+
+  IncreaseFrameSize(frame_size);
+
+  // Save callee-saves. RA is always at the top, matching the managed frame layout
+  // expected by the stack walker and `Loongarch64Context::FillCalleeSaves()`.
+  size_t offset = frame_size;
+  if ((core_spill_mask & (1u << RA)) != 0u) {
+    offset -= kSpillSize;
+    __ StoreToOffset(kStoreDoubleword, RA, SP, offset);
+    cfi().RelOffset(DWARFReg(RA), offset);
+  }
+  for (uint32_t reg : HighToLowBits(core_spill_mask & ~(1u << RA))) {
+    offset -= kSpillSize;
+    __ StoreToOffset(kStoreDoubleword, enum_cast<XRegister>(reg), SP, offset);
+    cfi().RelOffset(DWARFReg(enum_cast<XRegister>(reg)), offset);
+  }
+  for (uint32_t reg : HighToLowBits(fp_spill_mask)) {
+    offset -= kSpillSize;
+    __ StoreFpuToOffset(kStoreDoubleword, enum_cast<FRegister>(reg), SP, offset);
+    cfi().RelOffset(DWARFReg(enum_cast<FRegister>(reg)), offset);
+  }
+
+  if (method_reg.IsRegister()) {
+    // Write ArtMethod*.
+    DCHECK_EQ(A0, method_reg.AsLoongarch64().AsXRegister());
+    __ StoreToOffset(kStoreDoubleword, A0, SP, 0);
+  }
+}
+
+void Loongarch64JNIMacroAssembler::RemoveFrame(size_t frame_size,
+                                               ArrayRef<const ManagedRegister> callee_save_regs,
+                                               bool may_suspend ATTRIBUTE_UNUSED) {
+  cfi().RememberState();
+
+  uint32_t core_spill_mask = 0u;
+  uint32_t fp_spill_mask = 0u;
+  for (const ManagedRegister& r : callee_save_regs) {
+    Loongarch64ManagedRegister reg = r.AsLoongarch64();
+    if (reg.IsXRegister()) {
+      core_spill_mask |= 1u << reg.AsXRegister();
+    } else {
+      DCHECK(reg.IsFRegister());
+      fp_spill_mask |= 1u << reg.AsFRegister();
+    }
+  }
+
+  // Restore callee-saves in the same order as they were saved.
+  size_t offset = frame_size;
+  if ((core_spill_mask & (1u << RA)) != 0u) {
+    offset -= kSpillSize;
+    __ LoadFromOffset(kLoadDoubleword, RA, SP, offset);
+    cfi().Restore(DWARFReg(RA));
+  }
+  for (uint32_t reg : HighToLowBits(core_spill_mask & ~(1u << RA))) {
+    offset -= kSpillSize;
+    __ LoadFromOffset(kLoadDoubleword, enum_cast<XRegister>(reg), SP, offset);
+    cfi().Restore(DWARFReg(enum_cast<XRegister>(reg)));
+  }
+  for (uint32_t reg : HighToLowBits(fp_spill_mask)) {
+    offset -= kSpillSize;
+    __ LoadFpuFromOffset(kLoadDoubleword, enum_cast<FRegister>(reg), SP, offset);
+    cfi().Restore(DWARFReg(enum_cast<FRegister>(reg)));
+  }
+
+  // There is no marking register on LoongArch64, so nothing needs to be refreshed
+  // after a suspend check; `may_suspend` is irrelevant here.
+  DecreaseFrameSize(frame_size);
+  __ Ret();
+
+  // The CFI should be restored for any code that follows the exit block.
+  cfi().RestoreState();
+  cfi().DefCFAOffset(frame_size);
+}
+
+void Loongarch64JNIMacroAssembler::IncreaseFrameSize(size_t adjust) {
+  if (adjust != 0u) {
+    CHECK_ALIGNED(adjust, kStackAlignment);
+    __ AddConst64(SP, SP, -static_cast<int64_t>(adjust));
+    cfi().AdjustCFAOffset(adjust);
+  }
+}
+
+void Loongarch64JNIMacroAssembler::DecreaseFrameSize(size_t adjust) {
+  if (adjust != 0u) {
+    CHECK_ALIGNED(adjust, kStackAlignment);
+    __ AddConst64(SP, SP, static_cast<int64_t>(adjust));
+    cfi().AdjustCFAOffset(-static_cast<int>(adjust));
+  }
+}
+
+void Loongarch64JNIMacroAssembler::Store(Loongarch64ManagedRegister src,
+                                         XRegister base,
+                                         int32_t offset,
+                                         size_t size) {
+  if (src.IsNoRegister()) {
+    CHECK_EQ(0u, size);
+  } else if (src.IsXRegister()) {
+    CHECK(size == 4u || size == 8u) << size;
+    __ StoreToOffset(size == 4u ? kStoreWord : kStoreDoubleword, src.AsXRegister(), base, offset);
+  } else {
+    CHECK(src.IsFRegister()) << src;
+    CHECK(size == 4u || size == 8u) << size;
+    __ StoreFpuToOffset(size == 4u ? kStoreWord : kStoreDoubleword,
+                        src.AsFRegister(),
+                        base,
+                        offset);
+  }
+}
+
+void Loongarch64JNIMacroAssembler::Load(Loongarch64ManagedRegister dest,
+                                        XRegister base,
+                                        int32_t offset,
+                                        size_t size) {
+  if (dest.IsNoRegister()) {
+    CHECK_EQ(0u, size) << dest;
+  } else if (dest.IsXRegister()) {
+    CHECK(size == 1u || size == 4u || size == 8u) << size;
+    LoadOperandType type =
+        (size == 1u) ? kLoadUnsignedByte : (size == 4u) ? kLoadWord : kLoadDoubleword;
+    __ LoadFromOffset(type, dest.AsXRegister(), base, offset);
+  } else {
+    CHECK(dest.IsFRegister()) << dest;
+    CHECK(size == 4u || size == 8u) << size;
+    __ LoadFpuFromOffset(size == 4u ? kLoadWord : kLoadDoubleword,
+                         dest.AsFRegister(),
+                         base,
+                         offset);
+  }
+}
+
+void Loongarch64JNIMacroAssembler::Store(FrameOffset offs, ManagedRegister m_src, size_t size) {
+  Store(m_src.AsLoongarch64(), SP, offs.Int32Value(), size);
+}
+
+void Loongarch64JNIMacroAssembler::StoreRef(FrameOffset offs, ManagedRegister m_src) {
+  Loongarch64ManagedRegister src = m_src.AsLoongarch64();
+  CHECK(src.IsXRegister()) << src;
+  __ StoreToOffset(kStoreWord, src.AsXRegister(), SP, offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::StoreRawPtr(FrameOffset offs, ManagedRegister m_src) {
+  Loongarch64ManagedRegister src = m_src.AsLoongarch64();
+  CHECK(src.IsXRegister()) << src;
+  __ StoreToOffset(kStoreDoubleword, src.AsXRegister(), SP, offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::StoreImmediateToFrame(FrameOffset offs, uint32_t imm) {
+  __ LoadConst32(TMP2, imm);
+  __ StoreToOffset(kStoreWord, TMP2, SP, offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::StoreStackOffsetToThread(ThreadOffset64 thr_offs,
+                                                            FrameOffset fr_offs) {
+  __ AddConst64(TMP2, SP, fr_offs.Int32Value());
+  __ StoreToOffset(kStoreDoubleword, TMP2, TR, thr_offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::StoreStackPointerToThread(ThreadOffset64 thr_offs) {
+  __ StoreToOffset(kStoreDoubleword, SP, TR, thr_offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::StoreSpanning(FrameOffset dest ATTRIBUTE_UNUSED,
+                                                 ManagedRegister src ATTRIBUTE_UNUSED,
+                                                 FrameOffset in_off ATTRIBUTE_UNUSED) {
+  UNIMPLEMENTED(FATAL);  // This case is not applicable to LoongArch64.
+}
+
+void Loongarch64JNIMacroAssembler::Load(ManagedRegister m_dest, FrameOffset src, size_t size) {
+  Load(m_dest.AsLoongarch64(), SP, src.Int32Value(), size);
+}
+
+void Loongarch64JNIMacroAssembler::LoadFromThread(ManagedRegister m_dest,
+                                                  ThreadOffset64 src,
+                                                  size_t size) {
+  Load(m_dest.AsLoongarch64(), TR, src.Int32Value(), size);
+}
+
+void Loongarch64JNIMacroAssembler::LoadRef(ManagedRegister m_dest, FrameOffset src) {
+  Loongarch64ManagedRegister dest = m_dest.AsLoongarch64();
+  CHECK(dest.IsXRegister()) << dest;
+  __ LoadFromOffset(kLoadUnsignedWord, dest.AsXRegister(), SP, src.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::LoadRef(ManagedRegister m_dest,
+                                           ManagedRegister m_base,
+                                           MemberOffset offs,
+                                           bool unpoison_reference) {
+  Loongarch64ManagedRegister dest = m_dest.AsLoongarch64();
+  Loongarch64ManagedRegister base = m_base.AsLoongarch64();
+  CHECK(dest.IsXRegister()) << dest;
+  CHECK(base.IsXRegister()) << base;
+  __ LoadFromOffset(kLoadUnsignedWord, dest.AsXRegister(), base.AsXRegister(), offs.Int32Value());
+  if (unpoison_reference) {
+    __ MaybeUnpoisonHeapReference(dest.AsXRegister());
+  }
+}
+
+void Loongarch64JNIMacroAssembler::LoadRawPtr(ManagedRegister m_dest,
+                                              ManagedRegister m_base,
+                                              Offset offs) {
+  Loongarch64ManagedRegister dest = m_dest.AsLoongarch64();
+  Loongarch64ManagedRegister base = m_base.AsLoongarch64();
+  CHECK(dest.IsXRegister()) << dest;
+  CHECK(base.IsXRegister()) << base;
+  __ LoadFromOffset(kLoadDoubleword, dest.AsXRegister(), base.AsXRegister(), offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::LoadRawPtrFromThread(ManagedRegister m_dest,
+                                                        ThreadOffset64 offs) {
+  Loongarch64ManagedRegister dest = m_dest.AsLoongarch64();
+  CHECK(dest.IsXRegister()) << dest;
+  __ LoadFromOffset(kLoadDoubleword, dest.AsXRegister(), TR, offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::MoveArguments(ArrayRef<ArgumentLocation> dests,
+                                                 ArrayRef<ArgumentLocation> srcs) {
+  DCHECK_EQ(dests.size(), srcs.size());
+  auto get_mask = [](ManagedRegister reg) -> uint64_t {
+    Loongarch64ManagedRegister loongarch64_reg = reg.AsLoongarch64();
+    if (loongarch64_reg.IsXRegister()) {
+      size_t core_reg_number = static_cast<size_t>(loongarch64_reg.AsXRegister());
+      DCHECK_LT(core_reg_number, 32u);
+      return UINT64_C(1) << core_reg_number;
+    } else {
+      DCHECK(loongarch64_reg.IsFRegister());
+      size_t fp_reg_number = static_cast<size_t>(loongarch64_reg.AsFRegister());
+      DCHECK_LT(fp_reg_number, 32u);
+      return (UINT64_C(1) << 32u) << fp_reg_number;
+    }
+  };
+  // Collect registers to move while storing/copying args to stack slots.
+  uint64_t src_regs = 0u;
+  uint64_t dest_regs = 0u;
+  for (size_t i = 0, arg_count = srcs.size(); i != arg_count; ++i) {
+    const ArgumentLocation& src = srcs[i];
+    const ArgumentLocation& dest = dests[i];
+    DCHECK_EQ(src.GetSize(), dest.GetSize());
+    if (dest.IsRegister()) {
+      if (src.IsRegister() && src.GetRegister().Equals(dest.GetRegister())) {
+        // Nothing to do.
+      } else {
+        if (src.IsRegister()) {
+          src_regs |= get_mask(src.GetRegister());
+        }
+        dest_regs |= get_mask(dest.GetRegister());
+      }
+    } else {
+      if (src.IsRegister()) {
+        Store(dest.GetFrameOffset(), src.GetRegister(), dest.GetSize());
+      } else {
+        Copy(dest.GetFrameOffset(), src.GetFrameOffset(), dest.GetSize());
+      }
+    }
+  }
+  // Fill destination registers.
+  // There should be no cycles, so this simple algorithm should make progress.
+  while (dest_regs != 0u) {
+    uint64_t old_dest_regs = dest_regs;
+    for (size_t i = 0, arg_count = srcs.size(); i != arg_count; ++i) {
+      const ArgumentLocation& src = srcs[i];
+      const ArgumentLocation& dest = dests[i];
+      if (!dest.IsRegister()) {
+        continue;  // Stored in first loop above.
+      }
+      uint64_t dest_reg_mask = get_mask(dest.GetRegister());
+      if ((dest_reg_mask & dest_regs) == 0u) {
+        continue;  // Equals source, or already filled in one of previous iterations.
+      }
+      if ((dest_reg_mask & src_regs) != 0u) {
+        continue;  // Cannot clobber this register yet.
+      }
+      if (src.IsRegister()) {
+        Move(dest.GetRegister(), src.GetRegister(), dest.GetSize());
+        src_regs &= ~get_mask(src.GetRegister());  // Allow clobbering source register.
+      } else {
+        Load(dest.GetRegister(), src.GetFrameOffset(), dest.GetSize());
+      }
+      dest_regs &= ~get_mask(dest.GetRegister());  // Destination register was filled.
+    }
+    CHECK_NE(old_dest_regs, dest_regs);
+    DCHECK_EQ(0u, dest_regs & ~old_dest_regs);
+  }
+}
+
+void Loongarch64JNIMacroAssembler::Move(ManagedRegister m_dest, ManagedRegister m_src, size_t size) {
+  Loongarch64ManagedRegister dest = m_dest.AsLoongarch64();
+  Loongarch64ManagedRegister src = m_src.AsLoongarch64();
+  DCHECK(dest.IsXRegister() || dest.IsFRegister()) << dest;
+  DCHECK(dest.IsXRegister() ? (dest.AsXRegister() != TMP && dest.AsXRegister() != TMP2) : true);
+  if (dest.Equals(src)) {
+    return;
+  }
+  // The native ABI passes FP args in GPRs once the FP argument registers are used up,
+  // so moves between register kinds are needed as well.
+  CHECK(size == 4u || size == 8u) << size;
+  if (dest.IsXRegister()) {
+    if (src.IsXRegister()) {
+      __ Move(dest.AsXRegister(), src.AsXRegister());
+    } else if (size == 4u) {
+      __ Movfr2grS(dest.AsXRegister(), src.AsFRegister());
+    } else {
+      __ Movfr2grD(dest.AsXRegister(), src.AsFRegister());
+    }
+  } else if (src.IsFRegister()) {
+    if (size == 4u) {
+      __ FmovS(dest.AsFRegister(), src.AsFRegister());
+    } else {
+      __ FmovD(dest.AsFRegister(), src.AsFRegister());
+    }
+  } else if (size == 4u) {
+    __ Movgr2frW(dest.AsFRegister(), src.AsXRegister());
+  } else {
+    __ Movgr2frD(dest.AsFRegister(), src.AsXRegister());
+  }
+}
+
+void Loongarch64JNIMacroAssembler::CopyRawPtrFromThread(FrameOffset fr_offs,
+                                                        ThreadOffset64 thr_offs) {
+  __ LoadFromOffset(kLoadDoubleword, TMP2, TR, thr_offs.Int32Value());
+  __ StoreToOffset(kStoreDoubleword, TMP2, SP, fr_offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::CopyRawPtrToThread(ThreadOffset64 thr_offs,
+                                                      FrameOffset fr_offs,
+                                                      ManagedRegister m_scratch) {
+  Loongarch64ManagedRegister scratch = m_scratch.AsLoongarch64();
+  CHECK(scratch.IsXRegister()) << scratch;
+  __ LoadFromOffset(kLoadDoubleword, scratch.AsXRegister(), SP, fr_offs.Int32Value());
+  __ StoreToOffset(kStoreDoubleword, scratch.AsXRegister(), TR, thr_offs.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::CopyRef(FrameOffset dest, FrameOffset src) {
+  __ LoadFromOffset(kLoadUnsignedWord, TMP2, SP, src.Int32Value());
+  __ StoreToOffset(kStoreWord, TMP2, SP, dest.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::CopyRef(FrameOffset dest,
+                                           ManagedRegister m_base,
+                                           MemberOffset offs,
+                                           bool unpoison_reference) {
+  Loongarch64ManagedRegister base = m_base.AsLoongarch64();
+  CHECK(base.IsXRegister()) << base;
+  __ LoadFromOffset(kLoadUnsignedWord, TMP2, base.AsXRegister(), offs.Int32Value());
+  if (unpoison_reference) {
+    __ MaybeUnpoisonHeapReference(TMP2);
+  }
+  __ StoreToOffset(kStoreWord, TMP2, SP, dest.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::Copy(FrameOffset dest, FrameOffset src, size_t size) {
+  DCHECK(size == 4u || size == 8u) << size;
+  __ LoadFromOffset(size == 4u ? kLoadWord : kLoadDoubleword, TMP2, SP, src.Int32Value());
+  __ StoreToOffset(size == 4u ? kStoreWord : kStoreDoubleword, TMP2, SP, dest.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::Copy(FrameOffset dest,
+                                        ManagedRegister m_src_base,
+                                        Offset src_offset,
+                                        ManagedRegister m_scratch,
+                                        size_t size) {
+  Loongarch64ManagedRegister scratch = m_scratch.AsLoongarch64();
+  Loongarch64ManagedRegister base = m_src_base.AsLoongarch64();
+  CHECK(base.IsXRegister()) << base;
+  CHECK(scratch.IsXRegister()) << scratch;
+  CHECK(size == 4u || size == 8u) << size;
+  __ LoadFromOffset(size == 4u ? kLoadWord : kLoadDoubleword,
+                    scratch.AsXRegister(),
+                    base.AsXRegister(),
+                    src_offset.Int32Value());
+  __ StoreToOffset(size == 4u ? kStoreWord : kStoreDoubleword,
+                   scratch.AsXRegister(),
+                   SP,
+                   dest.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::Copy(ManagedRegister m_dest_base,
+                                        Offset dest_offset,
+                                        FrameOffset src,
+                                        ManagedRegister m_scratch,
+                                        size_t size) {
+  Loongarch64ManagedRegister scratch = m_scratch.AsLoongarch64();
+  Loongarch64ManagedRegister base = m_dest_base.AsLoongarch64();
+  CHECK(base.IsXRegister()) << base;
+  CHECK(scratch.IsXRegister()) << scratch;
+  CHECK(size == 4u || size == 8u) << size;
+  __ LoadFromOffset(size == 4u ? kLoadWord : kLoadDoubleword,
+                    scratch.AsXRegister(),
+                    SP,
+                    src.Int32Value());
+  __ StoreToOffset(size == 4u ? kStoreWord : kStoreDoubleword,
+                   scratch.AsXRegister(),
+                   base.AsXRegister(),
+                   dest_offset.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::Copy(FrameOffset /*dest*/,
+                                        FrameOffset /*src_base*/,
+                                        Offset /*src_offset*/,
+                                        ManagedRegister /*m_scratch*/,
+                                        size_t /*size*/) {
+  UNIMPLEMENTED(FATAL) << "Unimplemented Copy() variant";
+}
+
+void Loongarch64JNIMacroAssembler::Copy(ManagedRegister m_dest,
+                                        Offset dest_offset,
+                                        ManagedRegister m_src,
+                                        Offset src_offset,
+                                        ManagedRegister m_scratch,
+                                        size_t size) {
+  Loongarch64ManagedRegister scratch = m_scratch.AsLoongarch64();
+  Loongarch64ManagedRegister src = m_src.AsLoongarch64();
+  Loongarch64ManagedRegister dest = m_dest.AsLoongarch64();
+  CHECK(dest.IsXRegister()) << dest;
+  CHECK(src.IsXRegister()) << src;
+  CHECK(scratch.IsXRegister()) << scratch;
+  CHECK(size == 4u || size == 8u) << size;
+  __ LoadFromOffset(size == 4u ? kLoadWord : kLoadDoubleword,
+                    scratch.AsXRegister(),
+                    src.AsXRegister(),
+                    src_offset.Int32Value());
+  __ StoreToOffset(size == 4u ? kStoreWord : kStoreDoubleword,
+                   scratch.AsXRegister(),
+                   dest.AsXRegister(),
+                   dest_offset.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::Copy(FrameOffset /*dest*/,
+                                        Offset /*dest_offset*/,
+                                        FrameOffset /*src*/,
+                                        Offset /*src_offset*/,
+                                        ManagedRegister /*m_scratch*/,
+                                        size_t /*size*/) {
+  UNIMPLEMENTED(FATAL) << "Unimplemented Copy() variant";
+}
+
+void Loongarch64JNIMacroAssembler::MemoryBarrier(ManagedRegister m_scratch ATTRIBUTE_UNUSED) {
+  __ Dbar(0);
+}
+
+void Loongarch64JNIMacroAssembler::SignExtend(ManagedRegister m_reg, size_t size) {
+  Loongarch64ManagedRegister reg = m_reg.AsLoongarch64();
+  CHECK(reg.IsXRegister()) << reg;
+  CHECK(size == 1u || size == 2u) << size;
+  if (size == 1u) {
+    __ ExtWB(reg.AsXRegister(), reg.AsXRegister());
+  } else {
+    __ ExtWH(reg.AsXRegister(), reg.AsXRegister());
+  }
+}
+
+void Loongarch64JNIMacroAssembler::ZeroExtend(ManagedRegister m_reg, size_t size) {
+  Loongarch64ManagedRegister reg = m_reg.AsLoongarch64();
+  CHECK(reg.IsXRegister()) << reg;
+  CHECK(size == 1u || size == 2u) << size;
+  if (size == 1u) {
+    __ Andi(reg.AsXRegister(), reg.AsXRegister(), 0xff);
+  } else {
+    __ BstrpickD(reg.AsXRegister(), reg.AsXRegister(), 15, 0);
+  }
+}
+
+void Loongarch64JNIMacroAssembler::GetCurrentThread(ManagedRegister m_dest) {
+  Loongarch64ManagedRegister dest = m_dest.AsLoongarch64();
+  CHECK(dest.IsXRegister()) << dest;
+  __ Move(dest.AsXRegister(), TR);
+}
+
+void Loongarch64JNIMacroAssembler::GetCurrentThread(FrameOffset offset) {
+  __ StoreToOffset(kStoreDoubleword, TR, SP, offset.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::CreateJObject(ManagedRegister m_out_reg,
+                                                 FrameOffset spilled_reference_offset,
+                                                 ManagedRegister m_in_reg,
+                                                 bool null_allowed) {
+  Loongarch64ManagedRegister out_reg = m_out_reg.AsLoongarch64();
+  Loongarch64ManagedRegister in_reg = m_in_reg.AsLoongarch64();
+  CHECK(out_reg.IsXRegister()) << out_reg;
+  CHECK(in_reg.IsXRegister() || in_reg.IsNoRegister()) << in_reg;
+  if (null_allowed) {
+    // Null values get a jobject value null. Otherwise, the jobject is
+    // the address of the spilled reference.
+    // e.g. out_reg = (in == 0) ? 0 : (SP+spilled_reference_offset)
+    if (in_reg.IsNoRegister()) {
+      __ LoadFromOffset(kLoadUnsignedWord,
+                        out_reg.AsXRegister(),
+                        SP,
+                        spilled_reference_offset.Int32Value());
+      in_reg = out_reg;
+    }
+    __ AddConst64(TMP2, SP, spilled_reference_offset.Int32Value());
+    __ Maskeqz(out_reg.AsXRegister(), TMP2, in_reg.AsXRegister());
+  } else {
+    __ AddConst64(out_reg.AsXRegister(), SP, spilled_reference_offset.Int32Value());
+  }
+}
+
+void Loongarch64JNIMacroAssembler::CreateJObject(FrameOffset out_off,
+                                                 FrameOffset spilled_reference_offset,
+                                                 bool null_allowed) {
+  __ AddConst64(TMP2, SP, spilled_reference_offset.Int32Value());
+  if (null_allowed) {
+    __ LoadFromOffset(kLoadUnsignedWord, TMP, SP, spilled_reference_offset.Int32Value());
+    __ Maskeqz(TMP2, TMP2, TMP);
+  }
+  __ StoreToOffset(kStoreDoubleword, TMP2, SP, out_off.Int32Value());
+}
+
+void Loongarch64JNIMacroAssembler::VerifyObject(ManagedRegister /*src*/, bool /*could_be_null*/) {
+  // TODO: not validating references.
+}
+
+void Loongarch64JNIMacroAssembler::VerifyObject(FrameOffset /*src*/, bool /*could_be_null*/) {
+  // TODO: not validating references.
+}
+
+void Loongarch64JNIMacroAssembler::Jump(ManagedRegister m_base, Offset offs) {
+  Loongarch64ManagedRegister base = m_base.AsLoongarch64();
+  CHECK(base.IsXRegister()) << base;
+  __ LoadFromOffset(kLoadDoubleword, TMP, base.AsXRegister(), offs.Int32Value());
+  __ Jr(TMP);
+}
+
+void Loongarch64JNIMacroAssembler::Call(ManagedRegister m_base, Offset offs) {
+  Loongarch64ManagedRegister base = m_base.AsLoongarch64();
+  CHECK(base.IsXRegister()) << base;
+  __ LoadFromOffset(kLoadDoubleword, RA, base.AsXRegister(), offs.Int32Value());
+  __ Jalr(RA);
+}
+
+void Loongarch64JNIMacroAssembler::Call(FrameOffset base, Offset offs) {
+  // Use RA as the scratch register; it is clobbered by the call anyway.
+  __ LoadFromOffset(kLoadDoubleword, RA, SP, base.Int32Value());
+  __ LoadFromOffset(kLoadDoubleword, RA, RA, offs.Int32Value());
+  __ Jalr(RA);
+}
+
+void Loongarch64JNIMacroAssembler::CallFromThread(ThreadOffset64 offset) {
+  __ LoadFromOffset(kLoadDoubleword, RA, TR, offset.Int32Value());
+  __ Jalr(RA);
+}
+
+void Loongarch64JNIMacroAssembler::ExceptionPoll(size_t stack_adjust) {
+  CHECK_ALIGNED(stack_adjust, kStackAlignment);
+  exception_blocks_.emplace_back(new Loongarch64Exception(TMP2, stack_adjust));
+  __ LoadFromOffset(kLoadDoubleword,
+                    TMP2,
+                    TR,
+                    Thread::ExceptionOffset<kLoongarch64PointerSize>().Int32Value());
+  __ Bnez(TMP2, exception_blocks_.back()->Entry());
+}
+
+std::unique_ptr<JNIMacroLabel> Loongarch64JNIMacroAssembler::CreateLabel() {
+  return std::unique_ptr<JNIMacroLabel>(new Loongarch64JNIMacroLabel());
+}
+
+void Loongarch64JNIMacroAssembler::Jump(JNIMacroLabel* label) {
+  CHECK(label != nullptr);
+  __ B(Loongarch64JNIMacroLabel::Cast(label)->AsLoongarch64());
+}
+
+void Loongarch64JNIMacroAssembler::TestGcMarking(JNIMacroLabel* label,
+                                                 JNIMacroUnaryCondition cond) {
+  CHECK(label != nullptr);
+
+  DCHECK_EQ(Thread::IsGcMarkingSize(), 4u);
+  DCHECK(kUseReadBarrier);
+  // There is no marking register on LoongArch64, always load the flag from the thread.
+  int32_t is_gc_marking_offset = Thread::IsGcMarkingOffset<kLoongarch64PointerSize>().Int32Value();
+  __ LoadFromOffset(kLoadWord, TMP2, TR, is_gc_marking_offset);
+  switch (cond) {
+    case JNIMacroUnaryCondition::kZero:
+      __ Beqz(TMP2, Loongarch64JNIMacroLabel::Cast(label)->AsLoongarch64());
+      break;
+    case JNIMacroUnaryCondition::kNotZero:
+      __ Bnez(TMP2, Loongarch64JNIMacroLabel::Cast(label)->AsLoongarch64());
+      break;
+    default:
+      LOG(FATAL) << "Not implemented unary condition: " << static_cast<int>(cond);
+      UNREACHABLE();
+  }
+}
+
+void Loongarch64JNIMacroAssembler::Bind(JNIMacroLabel* label) {
+  CHECK(label != nullptr);
+  __ Bind(Loongarch64JNIMacroLabel::Cast(label)->AsLoongarch64());
+}
+
+void Loongarch64JNIMacroAssembler::EmitExceptionPoll(Loongarch64Exception* exception) {
+  // Bind exception poll entry.
+  __ Bind(exception->Entry());
+  if (exception->stack_adjust_ != 0) {  // Fix up the frame.
+    DecreaseFrameSize(exception->stack_adjust_);
+  }
+  // Pass exception object as argument.
+  // Don't care about preserving A0 as this won't return.
+  __ Move(A0, exception->scratch_);
+  __ LoadFromOffset(kLoadDoubleword,
+                    RA,
+                    TR,
+                    QUICK_ENTRYPOINT_OFFSET(kLoongarch64PointerSize, pDeliverException).Int32Value());
+  __ Jalr(RA);
+  // Call should never return.
+  __ Break(0);
+}
+
+#undef __
+
+}  // namespace loongarch64
+}  // namespace art
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "managed_register_loongarch64.h"
+
+#include "base/globals.h"
+
+namespace art {
+namespace loongarch64 {
+
+bool Loongarch64ManagedRegister::Overlaps(const Loongarch64ManagedRegister& other) const {
+  if (IsNoRegister() || other.IsNoRegister()) {
+    return false;
+  }
+  // Core and floating-point registers are in separate register files and
+  // there are no register pairs, so registers overlap only if they are equal.
+  return Equals(other);
+}
+
+void Loongarch64ManagedRegister::Print(std::ostream& os) const {
+  if (!IsValidManagedRegister()) {
+    os << "No Register";
+  } else if (IsXRegister()) {
+    os << "XRegister: " << static_cast<int>(AsXRegister());
+  } else if (IsFRegister()) {
+    os << "FRegister: " << static_cast<int>(AsFRegister());
+  } else {
+    os << "??: " << RegId();
+  }
+}
+
+std::ostream& operator<<(std::ostream& os, const Loongarch64ManagedRegister& reg) {
+  reg.Print(os);
+  return os;
+}
+
+}  // namespace loongarch64
+}  // namespace art
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_UTILS_LOONGARCH64_MANAGED_REGISTER_LOONGARCH64_H_
+#define ART_COMPILER_UTILS_LOONGARCH64_MANAGED_REGISTER_LOONGARCH64_H_
+
+#include <android-base/logging.h>
+
+#include "arch/loongarch64/registers_loongarch64.h"
+#include "utils/managed_register.h"
+
+namespace art {
+namespace loongarch64 {
+
+const int kNumberOfXRegIds = kNumberOfXRegisters;
+const int kNumberOfFRegIds = kNumberOfFRegisters;
+
+const int kNumberOfRegIds = kNumberOfXRegIds + kNumberOfFRegIds;
+
+// Register ids map:
+//  [0..X[  core registers (enum XRegister)
+//  [X..F[  floating-point registers (enum FRegister)
+//
+// where:
+//  X = kNumberOfXRegIds
+//  F = X + kNumberOfFRegIds
+//
+// An instance of class 'ManagedRegister' represents a single LoongArch64 register.
+// A register can be one of the following:
+//  * core register (enum XRegister)
+//  * floating-point register (enum FRegister)
+//
+// 32-bit values live in the low half of the 64-bit registers, so there are no
+// separate ids for them. There is a one to one mapping between ManagedRegister
+// and register id.
+
+class Loongarch64ManagedRegister : public ManagedRegister {
+ public:
+  constexpr XRegister AsXRegister() const {
+    CHECK(IsXRegister());
+    return static_cast<XRegister>(id_);
+  }
+
+  constexpr FRegister AsFRegister() const {
+    CHECK(IsFRegister());
+    return static_cast<FRegister>(id_ - kNumberOfXRegIds);
+  }
+
+  constexpr bool IsXRegister() const {
+    CHECK(IsValidManagedRegister());
+    return (0 <= id_) && (id_ < kNumberOfXRegIds);
+  }
+
+  constexpr bool IsFRegister() const {
+    CHECK(IsValidManagedRegister());
+    const int test = id_ - kNumberOfXRegIds;
+    return (0 <= test) && (test < kNumberOfFRegIds);
+  }
+
+  // Returns true if the two managed-registers ('this' and 'other') overlap.
+  // Either managed-register may be the NoRegister. If both are the NoRegister
+  // then false is returned.
+  bool Overlaps(const Loongarch64ManagedRegister& other) const;
+
+  void Print(std::ostream& os) const;
+
+  static constexpr Loongarch64ManagedRegister FromXRegister(XRegister r) {
+    CHECK_NE(r, kNoRegister);
+    return FromRegId(r);
+  }
+
+  static constexpr Loongarch64ManagedRegister FromFRegister(FRegister r) {
+    return FromRegId(r + kNumberOfXRegIds);
+  }
+
+ private:
+  constexpr bool IsValidManagedRegister() const {
+    return (0 <= id_) && (id_ < kNumberOfRegIds);
+  }
+
+  constexpr int RegId() const {
+    CHECK(!IsNoRegister());
+    return id_;
+  }
+
+  friend class ManagedRegister;
+
+  explicit constexpr Loongarch64ManagedRegister(int reg_id) : ManagedRegister(reg_id) {}
+
+  static constexpr Loongarch64ManagedRegister FromRegId(int reg_id) {
+    Loongarch64ManagedRegister reg(reg_id);
+    CHECK(reg.IsValidManagedRegister());
+    return reg;
+  }
+};
+
+std::ostream& operator<<(std::ostream& os, const Loongarch64ManagedRegister& reg);
+
+}  // namespace loongarch64
+
+constexpr loongarch64::Loongarch64ManagedRegister ManagedRegister::AsLoongarch64() const {
+  loongarch64::Loongarch64ManagedRegister reg(id_);
+  CHECK(reg.IsNoRegister() || reg.IsValidManagedRegister());
+  return reg;
+}
+
+}  // namespace art
+
+#endif  // ART_COMPILER_UTILS_LOONGARCH64_MANAGED_REGISTER_LOONGARCH64_H_
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "managed_register_loongarch64.h"
+
+#include "base/globals.h"
+#include "gtest/gtest.h"
+
+namespace art {
+namespace loongarch64 {
+
+TEST(Loongarch64ManagedRegister, NoRegister) {
+  Loongarch64ManagedRegister reg = ManagedRegister::NoRegister().AsLoongarch64();
+  EXPECT_TRUE(reg.IsNoRegister());
+  EXPECT_TRUE(!reg.Overlaps(reg));
+}
+
+TEST(Loongarch64ManagedRegister, XRegister) {
+  Loongarch64ManagedRegister reg = Loongarch64ManagedRegister::FromXRegister(Zero);
+  EXPECT_TRUE(!reg.IsNoRegister());
+  EXPECT_TRUE(reg.IsXRegister());
+  EXPECT_TRUE(!reg.IsFRegister());
+  EXPECT_EQ(Zero, reg.AsXRegister());
+
+  reg = Loongarch64ManagedRegister::FromXRegister(A0);
+  EXPECT_TRUE(!reg.IsNoRegister());
+  EXPECT_TRUE(reg.IsXRegister());
+  EXPECT_TRUE(!reg.IsFRegister());
+  EXPECT_EQ(A0, reg.AsXRegister());
+
+  reg = Loongarch64ManagedRegister::FromXRegister(TR);
+  EXPECT_TRUE(!reg.IsNoRegister());
+  EXPECT_TRUE(reg.IsXRegister());
+  EXPECT_TRUE(!reg.IsFRegister());
+  EXPECT_EQ(S1, reg.AsXRegister());
+
+  reg = Loongarch64ManagedRegister::FromXRegister(S8);
+  EXPECT_TRUE(!reg.IsNoRegister());
+  EXPECT_TRUE(reg.IsXRegister());
+  EXPECT_TRUE(!reg.IsFRegister());
+  EXPECT_EQ(S8, reg.AsXRegister());
+}
+
+TEST(Loongarch64ManagedRegister, FRegister) {
+  Loongarch64ManagedRegister reg = Loongarch64ManagedRegister::FromFRegister(FA0);
+  EXPECT_TRUE(!reg.IsNoRegister());
+  EXPECT_TRUE(!reg.IsXRegister());
+  EXPECT_TRUE(reg.IsFRegister());
+  EXPECT_EQ(FA0, reg.AsFRegister());
+
+  reg = Loongarch64ManagedRegister::FromFRegister(FT15);
+  EXPECT_TRUE(!reg.IsNoRegister());
+  EXPECT_TRUE(!reg.IsXRegister());
+  EXPECT_TRUE(reg.IsFRegister());
+  EXPECT_EQ(FT15, reg.AsFRegister());
+
+  reg = Loongarch64ManagedRegister::FromFRegister(FS7);
+  EXPECT_TRUE(!reg.IsNoRegister());
+  EXPECT_TRUE(!reg.IsXRegister());
+  EXPECT_TRUE(reg.IsFRegister());
+  EXPECT_EQ(FS7, reg.AsFRegister());
+}
+
+TEST(Loongarch64ManagedRegister, Equals) {
+  ManagedRegister reg_a0 = Loongarch64ManagedRegister::FromXRegister(A0);
+  EXPECT_TRUE(reg_a0.Equals(Loongarch64ManagedRegister::FromXRegister(A0)));
+  EXPECT_TRUE(!reg_a0.Equals(Loongarch64ManagedRegister::FromXRegister(A1)));
+  EXPECT_TRUE(!reg_a0.Equals(Loongarch64ManagedRegister::FromFRegister(FA0)));
+
+  ManagedRegister reg_fa0 = Loongarch64ManagedRegister::FromFRegister(FA0);
+  EXPECT_TRUE(!reg_fa0.Equals(Loongarch64ManagedRegister::FromXRegister(A0)));
+  EXPECT_TRUE(reg_fa0.Equals(Loongarch64ManagedRegister::FromFRegister(FA0)));
+  EXPECT_TRUE(!reg_fa0.Equals(Loongarch64ManagedRegister::FromFRegister(FA1)));
+}
+
+TEST(Loongarch64ManagedRegister, Overlaps) {
+  Loongarch64ManagedRegister reg = Loongarch64ManagedRegister::FromXRegister(A0);
+  EXPECT_TRUE(reg.Overlaps(Loongarch64ManagedRegister::FromXRegister(A0)));
+  EXPECT_TRUE(!reg.Overlaps(Loongarch64ManagedRegister::FromXRegister(A1)));
+  // FA4 has the same register number as A0 but lives in a different register file.
+  EXPECT_TRUE(!reg.Overlaps(Loongarch64ManagedRegister::FromFRegister(FA4)));
+
+  reg = Loongarch64ManagedRegister::FromFRegister(FS0);
+  EXPECT_TRUE(reg.Overlaps(Loongarch64ManagedRegister::FromFRegister(FS0)));
+  EXPECT_TRUE(!reg.Overlaps(Loongarch64ManagedRegister::FromFRegister(FS1)));
+  EXPECT_TRUE(!reg.Overlaps(Loongarch64ManagedRegister::FromXRegister(S0)));
+}
+
+}  // namespace loongarch64
+}  // namespace art
@@ -31,6 +31,10 @@ namespace arm64 {
 class Arm64ManagedRegister;
 }  // namespace arm64
 
+namespace loongarch64 {
+class Loongarch64ManagedRegister;
+}  // namespace loongarch64
+
 namespace x86 {
 class X86ManagedRegister;
 }  // namespace x86
@@ -50,6 +54,7 @@ class ManagedRegister : public ValueObject {
 
   constexpr arm::ArmManagedRegister AsArm() const;
   constexpr arm64::Arm64ManagedRegister AsArm64() const;
+  constexpr loongarch64::Loongarch64ManagedRegister AsLoongarch64() const;
   constexpr x86::X86ManagedRegister AsX86() const;
   constexpr x86_64::X86_64ManagedRegister AsX86_64() const;
 
@@ -1402,9 +1402,12 @@ class ParallelCompilationManager {
     CHECK_GT(work_units, 0U);
 
     index_.store(begin, std::memory_order_relaxed);
+    std::vector<Task*> tasks;
+    tasks.reserve(work_units);
     for (size_t i = 0; i < work_units; ++i) {
-      thread_pool_->AddTask(self, new ForAllClosureLambda<Fn>(this, end, fn));
+      tasks.push_back(new ForAllClosureLambda<Fn>(this, end, fn));
     }
+    thread_pool_->AddTasks(self, tasks);
     thread_pool_->StartWorkers(self);
 
     // Ensure we're suspended while we're blocked waiting for the other threads to finish (worker
@@ -2780,8 +2783,11 @@ std::string CompilerDriver::GetMemoryUsageString(bool extended) const {
 
 void CompilerDriver::InitializeThreadPools() {
   size_t parallel_count = parallel_thread_count_ > 0 ? parallel_thread_count_ - 1 : 0;
-  parallel_thread_pool_.reset(
-      new ThreadPool("Compiler driver thread pool", parallel_count));
+  parallel_thread_pool_.reset(new ThreadPool("Compiler driver thread pool",
+                                             parallel_count,
+                                             /*create_peers=*/ false,
+                                             ThreadPoolWorker::kDefaultStackSize,
+                                             /*work_stealing=*/ true));
   single_thread_pool_.reset(new ThreadPool("Single-threaded Compiler driver thread pool", 0));
 }
 
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "linker/loongarch64/relative_patcher_loongarch64.h"
+
+#include "compiled_method.h"
+#include "debug/method_debug_info.h"
+#include "linker/linker_patch.h"
+
+namespace art {
+namespace linker {
+
+// The opcode bits of `pcaddu12i rd, si20`; the low part of a PC-relative pair is either
+// `addi.d rd, rj, si12` or a load with a 12-bit signed offset in bits 21..10.
+static constexpr uint32_t kPcaddu12iMask = 0xfe000000u;
+static constexpr uint32_t kPcaddu12i = 0x1c000000u;
+
+uint32_t Loongarch64RelativePatcher::ReserveSpace(
+    uint32_t offset,
+    const CompiledMethod* compiled_method ATTRIBUTE_UNUSED,
+    MethodReference method_ref ATTRIBUTE_UNUSED) {
+  return offset;  // No space reserved; no thunks needed.
+}
+
+uint32_t Loongarch64RelativePatcher::ReserveSpaceEnd(uint32_t offset) {
+  return offset;  // No space reserved; no thunks needed.
+}
+
+uint32_t Loongarch64RelativePatcher::WriteThunks(OutputStream* out ATTRIBUTE_UNUSED,
+                                                 uint32_t offset) {
+  return offset;  // No thunks added.
+}
+
+void Loongarch64RelativePatcher::PatchCall(std::vector<uint8_t>* code ATTRIBUTE_UNUSED,
+                                           uint32_t literal_offset ATTRIBUTE_UNUSED,
+                                           uint32_t patch_offset ATTRIBUTE_UNUSED,
+                                           uint32_t target_offset ATTRIBUTE_UNUSED) {
+  LOG(FATAL) << "Unexpected relative call patch.";
+}
+
+void Loongarch64RelativePatcher::PatchPcRelativeReference(std::vector<uint8_t>* code,
+                                                          const LinkerPatch& patch,
+                                                          uint32_t patch_offset,
+                                                          uint32_t target_offset) {
+  uint32_t literal_offset = patch.LiteralOffset();
+  DCHECK_LE(literal_offset + 4u, code->size());
+  DCHECK_ALIGNED(literal_offset, 4u);
+  DCHECK_ALIGNED(patch_offset, 4u);
+  // Both halves are relative to the PC of the `pcaddu12i`.
+  uint32_t anchor_offset = patch_offset - literal_offset + patch.PcInsnOffset();
+  // Unsigned arithmetic with its well-defined overflow behavior is just fine here.
+  uint32_t diff = target_offset - anchor_offset;
+
+  using unaligned_uint32_t __attribute__((__aligned__(1))) = uint32_t;
+  unaligned_uint32_t* insn = reinterpret_cast<unaligned_uint32_t*>(&(*code)[literal_offset]);
+  if ((*insn & kPcaddu12iMask) == kPcaddu12i) {
+    DCHECK_EQ(literal_offset, patch.PcInsnOffset());
+    // The low 12 bits are sign-extended by the second instruction; compensate here.
+    uint32_t imm20 = ((diff + 0x800u) >> 12) & 0xfffffu;
+    *insn = (*insn & ~(0xfffffu << 5)) | (imm20 << 5);
+  } else {
+    DCHECK_NE(literal_offset, patch.PcInsnOffset());
+    uint32_t imm12 = diff & 0xfffu;
+    *insn = (*insn & ~(0xfffu << 10)) | (imm12 << 10);
+  }
+}
+
+void Loongarch64RelativePatcher::PatchEntrypointCall(std::vector<uint8_t>* code ATTRIBUTE_UNUSED,
+                                                     const LinkerPatch& patch ATTRIBUTE_UNUSED,
+                                                     uint32_t patch_offset ATTRIBUTE_UNUSED) {
+  LOG(FATAL) << "Unexpected entrypoint call patch.";
+}
+
+void Loongarch64RelativePatcher::PatchBakerReadBarrierBranch(
+    std::vector<uint8_t>* code ATTRIBUTE_UNUSED,
+    const LinkerPatch& patch ATTRIBUTE_UNUSED,
+    uint32_t patch_offset ATTRIBUTE_UNUSED) {
+  LOG(FATAL) << "Unexpected baker read barrier branch patch.";
+}
+
+std::vector<debug::MethodDebugInfo> Loongarch64RelativePatcher::GenerateThunkDebugInfo(
+    uint32_t executable_offset ATTRIBUTE_UNUSED) {
+  return std::vector<debug::MethodDebugInfo>();  // No thunks added.
+}
+
+}  // namespace linker
+}  // namespace art
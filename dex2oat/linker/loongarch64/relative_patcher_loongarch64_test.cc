@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "linker/loongarch64/relative_patcher_loongarch64.h"
+
+#include "linker/relative_patcher_test.h"
+
+namespace art {
+namespace linker {
+
+class Loongarch64RelativePatcherTest : public RelativePatcherTest {
+ public:
+  Loongarch64RelativePatcherTest() : RelativePatcherTest(InstructionSet::kLoongarch64, "generic") { }
+
+ protected:
+  // pcaddu12i $a0, 0x12345
+  static constexpr uint32_t kPcaddu12iA0 = 0x1c000000u | (0x12345u << 5) | 4u;
+  // addi.d $a0, $a0, 0x678
+  static constexpr uint32_t kAddiDA0A0 = 0x02c00000u | (0x678u << 10) | (4u << 5) | 4u;
+  // ld.wu $a0, $a0, 0x678
+  static constexpr uint32_t kLdWuA0A0 = 0x2a800000u | (0x678u << 10) | (4u << 5) | 4u;
+
+  static std::vector<uint8_t> RawCode(std::initializer_list<uint32_t> insns) {
+    std::vector<uint8_t> raw_code;
+    raw_code.reserve(insns.size() * 4u);
+    for (uint32_t insn : insns) {
+      raw_code.push_back(static_cast<uint8_t>(insn));
+      raw_code.push_back(static_cast<uint8_t>(insn >> 8));
+      raw_code.push_back(static_cast<uint8_t>(insn >> 16));
+      raw_code.push_back(static_cast<uint8_t>(insn >> 24));
+    }
+    return raw_code;
+  }
+
+  static uint32_t PatchHigh(uint32_t insn, uint32_t diff) {
+    return (insn & ~(0xfffffu << 5)) | ((((diff + 0x800u) >> 12) & 0xfffffu) << 5);
+  }
+
+  static uint32_t PatchLow(uint32_t insn, uint32_t diff) {
+    return (insn & ~(0xfffu << 10)) | ((diff & 0xfffu) << 10);
+  }
+
+  void TestPcRelativePatch(uint32_t low_insn,
+                           uint32_t target_offset,
+                           LinkerPatch (*factory)(size_t, const DexFile*, uint32_t, uint32_t),
+                           uint32_t target_index) {
+    std::vector<uint8_t> code = RawCode({kPcaddu12iA0, low_insn});
+    LinkerPatch patches[] = {
+        factory(0u, nullptr, 0u, target_index),
+        factory(4u, nullptr, 0u, target_index),
+    };
+    AddCompiledMethod(
+        MethodRef(1u), ArrayRef<const uint8_t>(code), ArrayRef<const LinkerPatch>(patches));
+    Link();
+
+    auto result = method_offset_map_.FindMethodOffset(MethodRef(1u));
+    ASSERT_TRUE(result.first);
+    uint32_t diff = target_offset - result.second;
+    std::vector<uint8_t> expected_code =
+        RawCode({PatchHigh(kPcaddu12iA0, diff), PatchLow(low_insn, diff)});
+    EXPECT_TRUE(CheckLinkedMethod(MethodRef(1u), ArrayRef<const uint8_t>(expected_code)));
+  }
+};
+
+TEST_F(Loongarch64RelativePatcherTest, StringBssEntry) {
+  bss_begin_ = 0x12345678;
+  constexpr size_t kStringEntryOffset = 0x1234;
+  constexpr uint32_t kStringIndex = 1u;
+  string_index_to_offset_map_.Put(kStringIndex, kStringEntryOffset);
+  TestPcRelativePatch(kLdWuA0A0,
+                      bss_begin_ + kStringEntryOffset,
+                      LinkerPatch::StringBssEntryPatch,
+                      kStringIndex);
+}
+
+TEST_F(Loongarch64RelativePatcherTest, StringReference) {
+  constexpr uint32_t kStringIndex = 1u;
+  constexpr uint32_t kStringOffset = 0x12345678;
+  string_index_to_offset_map_.Put(kStringIndex, kStringOffset);
+  TestPcRelativePatch(kAddiDA0A0, kStringOffset, LinkerPatch::RelativeStringPatch, kStringIndex);
+}
+
+}  // namespace linker
+}  // namespace art
@@ -0,0 +1,839 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "disassembler_loongarch64.h"
+
+#include <string.h>
+
+#include <ostream>
+#include <sstream>
+
+#include "android-base/logging.h"
+#include "android-base/stringprintf.h"
+
+#include "base/bit_utils.h"
+
+using android::base::StringPrintf;
+
+namespace art {
+namespace loongarch64 {
+
+static constexpr size_t kInstructionSize = 4u;
+
+// Register holding the current Thread*, see `TR` in registers_loongarch64.h.
+static constexpr uint32_t kThreadRegister = 24u;
+
+// Operand layouts. The field positions follow the LoongArch reference manual:
+// rd/fd/vd at [4:0], rj/fj/vj at [9:5], rk/fk/vk at [14:10] and fa at [19:15].
+enum class Format : uint8_t {
+  kRdRjRk,       // rd, rj, rk
+  kRdRkRj,       // rd, rk, rj (AM* atomics)
+  kRdRjRkSa2,    // rd, rj, rk, sa2 + 1 (ALSL)
+  kRdRj,         // rd, rj
+  kRdRjUi,       // rd, rj, ui<bits>
+  kBstrW,        // rd, rj, msbw, lsbw
+  kBstrD,        // rd, rj, msbd, lsbd
+  kRdRjSi12,     // rd, rj, si12
+  kRdRjUi12,     // rd, rj, ui12
+  kRdRjSi14,     // rd, rj, si14 << 2
+  kRdRjSi16,     // rd, rj, si16
+  kRdSi20,       // rd, si20
+  kBranchRjRd,   // rj, rd, offs16 << 2
+  kJirl,         // rd, rj, offs16 << 2
+  kBranchRj,     // rj, offs21 << 2
+  kBranchCj,     // cj, offs21 << 2
+  kBranch,       // offs26 << 2
+  kCode,         // code15
+  kFdFjFk,       // fd, fj, fk
+  kFdFjFkFa,     // fd, fj, fk, fa
+  kFsel,         // fd, fj, fk, ca
+  kFcmp,         // cd, fj, fk with the condition encoded in the mnemonic
+  kFdFj,         // fd, fj
+  kFdRj,         // fd, rj
+  kRdFj,         // rd, fj
+  kCdRj,         // cd, rj
+  kRdCj,         // rd, cj
+  kFdRjSi12,     // fd, rj, si12
+  kFdRjRk,       // fd, rj, rk
+  kVdVjVk,       // vd, vj, vk
+  kVdVj,         // vd, vj
+  kVdRj,         // vd, rj
+  kVdVjUi,       // vd, vj, ui<bits>
+  kVdVjIdx,      // vd, vj, idx<bits> (no LASX counterpart with the same encoding)
+  kVdRjIdx,      // vd, rj, idx<bits>
+  kRdVjIdx,      // rd, vj, idx<bits>
+  kVdSi10,       // vd, si10
+  kVdRjSi12,     // vd, rj, si12
+  kVdRjRk,       // vd, rj, rk
+};
+
+struct Opcode {
+  uint32_t match;
+  const char* name;
+  Format format;
+  uint32_t bits;  // Width of the unsigned immediate or element index, if any.
+};
+
+// Sorted by encoding. The decoder picks the first entry whose fixed bits match.
+static constexpr Opcode kOpcodes[] = {
+  {0x00001000u, "clo.w", Format::kRdRj, 0u},
+  {0x00001400u, "clz.w", Format::kRdRj, 0u},
+  {0x00001800u, "cto.w", Format::kRdRj, 0u},
+  {0x00001c00u, "ctz.w", Format::kRdRj, 0u},
+  {0x00002000u, "clo.d", Format::kRdRj, 0u},
+  {0x00002400u, "clz.d", Format::kRdRj, 0u},
+  {0x00002800u, "cto.d", Format::kRdRj, 0u},
+  {0x00002c00u, "ctz.d", Format::kRdRj, 0u},
+  {0x00003000u, "revb.2h", Format::kRdRj, 0u},
+  {0x00003400u, "revb.4h", Format::kRdRj, 0u},
+  {0x00003800u, "revb.2w", Format::kRdRj, 0u},
+  {0x00003c00u, "revb.d", Format::kRdRj, 0u},
+  {0x00004000u, "revh.2w", Format::kRdRj, 0u},
+  {0x00004400u, "revh.d", Format::kRdRj, 0u},
+  {0x00004800u, "bitrev.4b", Format::kRdRj, 0u},
+  {0x00004c00u, "bitrev.8b", Format::kRdRj, 0u},
+  {0x00005000u, "bitrev.w", Format::kRdRj, 0u},
+  {0x00005400u, "bitrev.d", Format::kRdRj, 0u},
+  {0x00005800u, "ext.w.h", Format::kRdRj, 0u},
+  {0x00005c00u, "ext.w.b", Format::kRdRj, 0u},
+  {0x00040000u, "alsl.w", Format::kRdRjRkSa2, 0u},
+  {0x00060000u, "alsl.wu", Format::kRdRjRkSa2, 0u},
+  {0x00100000u, "add.w", Format::kRdRjRk, 0u},
+  {0x00108000u, "add.d", Format::kRdRjRk, 0u},
+  {0x00110000u, "sub.w", Format::kRdRjRk, 0u},
+  {0x00118000u, "sub.d", Format::kRdRjRk, 0u},
+  {0x00120000u, "slt", Format::kRdRjRk, 0u},
+  {0x00128000u, "sltu", Format::kRdRjRk, 0u},
+  {0x00130000u, "maskeqz", Format::kRdRjRk, 0u},
+  {0x00138000u, "masknez", Format::kRdRjRk, 0u},
+  {0x00140000u, "nor", Format::kRdRjRk, 0u},
+  {0x00148000u, "and", Format::kRdRjRk, 0u},
+  {0x00150000u, "or", Format::kRdRjRk, 0u},
+  {0x00158000u, "xor", Format::kRdRjRk, 0u},
+  {0x00160000u, "orn", Format::kRdRjRk, 0u},
+  {0x00168000u, "andn", Format::kRdRjRk, 0u},
+  {0x00170000u, "sll.w", Format::kRdRjRk, 0u},
+  {0x00178000u, "srl.w", Format::kRdRjRk, 0u},
+  {0x00180000u, "sra.w", Format::kRdRjRk, 0u},
+  {0x00188000u, "sll.d", Format::kRdRjRk, 0u},
+  {0x00190000u, "srl.d", Format::kRdRjRk, 0u},
+  {0x00198000u, "sra.d", Format::kRdRjRk, 0u},
+  {0x001b0000u, "rotr.w", Format::kRdRjRk, 0u},
+  {0x001b8000u, "rotr.d", Format::kRdRjRk, 0u},
+  {0x001c0000u, "mul.w", Format::kRdRjRk, 0u},
+  {0x001c8000u, "mulh.w", Format::kRdRjRk, 0u},
+  {0x001d0000u, "mulh.wu", Format::kRdRjRk, 0u},
+  {0x001d8000u, "mul.d", Format::kRdRjRk, 0u},
+  {0x001e0000u, "mulh.d", Format::kRdRjRk, 0u},
+  {0x001e8000u, "mulh.du", Format::kRdRjRk, 0u},
+  {0x00200000u, "div.w", Format::kRdRjRk, 0u},
+  {0x00208000u, "mod.w", Format::kRdRjRk, 0u},
+  {0x00210000u, "div.wu", Format::kRdRjRk, 0u},
+  {0x00218000u, "mod.wu", Format::kRdRjRk, 0u},
+  {0x00220000u, "div.d", Format::kRdRjRk, 0u},
+  {0x00228000u, "mod.d", Format::kRdRjRk, 0u},
+  {0x00230000u, "div.du", Format::kRdRjRk, 0u},
+  {0x00238000u, "mod.du", Format::kRdRjRk, 0u},
+  {0x002a0000u, "break", Format::kCode, 0u},
+  {0x002c0000u, "alsl.d", Format::kRdRjRkSa2, 0u},
+  {0x00408000u, "slli.w", Format::kRdRjUi, 5u},
+  {0x00410000u, "slli.d", Format::kRdRjUi, 6u},
+  {0x00448000u, "srli.w", Format::kRdRjUi, 5u},
+  {0x00450000u, "srli.d", Format::kRdRjUi, 6u},
+  {0x00488000u, "srai.w", Format::kRdRjUi, 5u},
+  {0x00490000u, "srai.d", Format::kRdRjUi, 6u},
+  {0x004c8000u, "rotri.w", Format::kRdRjUi, 5u},
+  {0x004d0000u, "rotri.d", Format::kRdRjUi, 6u},
+  {0x00600000u, "bstrins.w", Format::kBstrW, 0u},
+  {0x00608000u, "bstrpick.w", Format::kBstrW, 0u},
+  {0x00800000u, "bstrins.d", Format::kBstrD, 0u},
+  {0x00c00000u, "bstrpick.d", Format::kBstrD, 0u},
+  {0x01008000u, "fadd.s", Format::kFdFjFk, 0u},
+  {0x01010000u, "fadd.d", Format::kFdFjFk, 0u},
+  {0x01028000u, "fsub.s", Format::kFdFjFk, 0u},
+  {0x01030000u, "fsub.d", Format::kFdFjFk, 0u},
+  {0x01048000u, "fmul.s", Format::kFdFjFk, 0u},
+  {0x01050000u, "fmul.d", Format::kFdFjFk, 0u},
+  {0x01068000u, "fdiv.s", Format::kFdFjFk, 0u},
+  {0x01070000u, "fdiv.d", Format::kFdFjFk, 0u},
+  {0x01088000u, "fmax.s", Format::kFdFjFk, 0u},
+  {0x01090000u, "fmax.d", Format::kFdFjFk, 0u},
+  {0x010a8000u, "fmin.s", Format::kFdFjFk, 0u},
+  {0x010b0000u, "fmin.d", Format::kFdFjFk, 0u},
+  {0x01128000u, "fcopysign.s", Format::kFdFjFk, 0u},
+  {0x01130000u, "fcopysign.d", Format::kFdFjFk, 0u},
+  {0x01140400u, "fabs.s", Format::kFdFj, 0u},
+  {0x01140800u, "fabs.d", Format::kFdFj, 0u},
+  {0x01141400u, "fneg.s", Format::kFdFj, 0u},
+  {0x01141800u, "fneg.d", Format::kFdFj, 0u},
+  {0x01143400u, "fclass.s", Format::kFdFj, 0u},
+  {0x01143800u, "fclass.d", Format::kFdFj, 0u},
+  {0x01144400u, "fsqrt.s", Format::kFdFj, 0u},
+  {0x01144800u, "fsqrt.d", Format::kFdFj, 0u},
+  {0x01149400u, "fmov.s", Format::kFdFj, 0u},
+  {0x01149800u, "fmov.d", Format::kFdFj, 0u},
+  {0x0114a400u, "movgr2fr.w", Format::kFdRj, 0u},
+  {0x0114a800u, "movgr2fr.d", Format::kFdRj, 0u},
+  {0x0114ac00u, "movgr2frh.w", Format::kFdRj, 0u},
+  {0x0114b400u, "movfr2gr.s", Format::kRdFj, 0u},
+  {0x0114b800u, "movfr2gr.d", Format::kRdFj, 0u},
+  {0x0114bc00u, "movfrh2gr.s", Format::kRdFj, 0u},
+  {0x0114d800u, "movgr2cf", Format::kCdRj, 0u},
+  {0x0114dc00u, "movcf2gr", Format::kRdCj, 0u},
+  {0x01191800u, "fcvt.s.d", Format::kFdFj, 0u},
+  {0x01192400u, "fcvt.d.s", Format::kFdFj, 0u},
+  {0x011a8400u, "ftintrz.w.s", Format::kFdFj, 0u},
+  {0x011a8800u, "ftintrz.w.d", Format::kFdFj, 0u},
+  {0x011aa400u, "ftintrz.l.s", Format::kFdFj, 0u},
+  {0x011aa800u, "ftintrz.l.d", Format::kFdFj, 0u},
+  {0x011d1000u, "ffint.s.w", Format::kFdFj, 0u},
+  {0x011d1800u, "ffint.s.l", Format::kFdFj, 0u},
+  {0x011d2000u, "ffint.d.w", Format::kFdFj, 0u},
+  {0x011d2800u, "ffint.d.l", Format::kFdFj, 0u},
+  {0x011e4400u, "frint.s", Format::kFdFj, 0u},
+  {0x011e4800u, "frint.d", Format::kFdFj, 0u},
+  {0x02000000u, "slti", Format::kRdRjSi12, 0u},
+  {0x02400000u, "sltui", Format::kRdRjSi12, 0u},
+  {0x02800000u, "addi.w", Format::kRdRjSi12, 0u},
+  {0x02c00000u, "addi.d", Format::kRdRjSi12, 0u},
+  {0x03000000u, "lu52i.d", Format::kRdRjSi12, 0u},
+  {0x03400000u, "andi", Format::kRdRjUi12, 0u},
+  {0x03800000u, "ori", Format::kRdRjUi12, 0u},
+  {0x03c00000u, "xori", Format::kRdRjUi12, 0u},
+  {0x08100000u, "fmadd.s", Format::kFdFjFkFa, 0u},
+  {0x08200000u, "fmadd.d", Format::kFdFjFkFa, 0u},
+  {0x08500000u, "fmsub.s", Format::kFdFjFkFa, 0u},
+  {0x08600000u, "fmsub.d", Format::kFdFjFkFa, 0u},
+  {0x0c100000u, "fcmp.s", Format::kFcmp, 0u},
+  {0x0c200000u, "fcmp.d", Format::kFcmp, 0u},
+  {0x0d000000u, "fsel", Format::kFsel, 0u},
+  {0x10000000u, "addu16i.d", Format::kRdRjSi16, 0u},
+  {0x14000000u, "lu12i.w", Format::kRdSi20, 0u},
+  {0x16000000u, "lu32i.d", Format::kRdSi20, 0u},
+  {0x18000000u, "pcaddi", Format::kRdSi20, 0u},
+  {0x1a000000u, "pcalau12i", Format::kRdSi20, 0u},
+  {0x1c000000u, "pcaddu12i", Format::kRdSi20, 0u},
+  {0x1e000000u, "pcaddu18i", Format::kRdSi20, 0u},
+  {0x20000000u, "ll.w", Format::kRdRjSi14, 0u},
+  {0x21000000u, "sc.w", Format::kRdRjSi14, 0u},
+  {0x22000000u, "ll.d", Format::kRdRjSi14, 0u},
+  {0x23000000u, "sc.d", Format::kRdRjSi14, 0u},
+  {0x24000000u, "ldptr.w", Format::kRdRjSi14, 0u},
+  {0x25000000u, "stptr.w", Format::kRdRjSi14, 0u},
+  {0x26000000u, "ldptr.d", Format::kRdRjSi14, 0u},
+  {0x27000000u, "stptr.d", Format::kRdRjSi14, 0u},
+  {0x28000000u, "ld.b", Format::kRdRjSi12, 0u},
+  {0x28400000u, "ld.h", Format::kRdRjSi12, 0u},
+  {0x28800000u, "ld.w", Format::kRdRjSi12, 0u},
+  {0x28c00000u, "ld.d", Format::kRdRjSi12, 0u},
+  {0x29000000u, "st.b", Format::kRdRjSi12, 0u},
+  {0x29400000u, "st.h", Format::kRdRjSi12, 0u},
+  {0x29800000u, "st.w", Format::kRdRjSi12, 0u},
+  {0x29c00000u, "st.d", Format::kRdRjSi12, 0u},
+  {0x2a000000u, "ld.bu", Format::kRdRjSi12, 0u},
+  {0x2a400000u, "ld.hu", Format::kRdRjSi12, 0u},
+  {0x2a800000u, "ld.wu", Format::kRdRjSi12, 0u},
+  {0x2b000000u, "fld.s", Format::kFdRjSi12, 0u},
+  {0x2b400000u, "fst.s", Format::kFdRjSi12, 0u},
+  {0x2b800000u, "fld.d", Format::kFdRjSi12, 0u},
+  {0x2bc00000u, "fst.d", Format::kFdRjSi12, 0u},
+  {0x2c000000u, "vld", Format::kVdRjSi12, 0u},
+  {0x2c400000u, "vst", Format::kVdRjSi12, 0u},
+  {0x38000000u, "ldx.b", Format::kRdRjRk, 0u},
+  {0x38040000u, "ldx.h", Format::kRdRjRk, 0u},
+  {0x38080000u, "ldx.w", Format::kRdRjRk, 0u},
+  {0x380c0000u, "ldx.d", Format::kRdRjRk, 0u},
+  {0x38100000u, "stx.b", Format::kRdRjRk, 0u},
+  {0x38140000u, "stx.h", Format::kRdRjRk, 0u},
+  {0x38180000u, "stx.w", Format::kRdRjRk, 0u},
+  {0x381c0000u, "stx.d", Format::kRdRjRk, 0u},
+  {0x38200000u, "ldx.bu", Format::kRdRjRk, 0u},
+  {0x38240000u, "ldx.hu", Format::kRdRjRk, 0u},
+  {0x38280000u, "ldx.wu", Format::kRdRjRk, 0u},
+  {0x38300000u, "fldx.s", Format::kFdRjRk, 0u},
+  {0x38340000u, "fldx.d", Format::kFdRjRk, 0u},
+  {0x38380000u, "fstx.s", Format::kFdRjRk, 0u},
+  {0x383c0000u, "fstx.d", Format::kFdRjRk, 0u},
+  {0x38400000u, "vldx", Format::kVdRjRk, 0u},
+  {0x38440000u, "vstx", Format::kVdRjRk, 0u},
+  {0x38600000u, "amswap.w", Format::kRdRkRj, 0u},
+  {0x38608000u, "amswap.d", Format::kRdRkRj, 0u},
+  {0x38610000u, "amadd.w", Format::kRdRkRj, 0u},
+  {0x38618000u, "amadd.d", Format::kRdRkRj, 0u},
+  {0x38690000u, "amswap_db.w", Format::kRdRkRj, 0u},
+  {0x38698000u, "amswap_db.d", Format::kRdRkRj, 0u},
+  {0x386a0000u, "amadd_db.w", Format::kRdRkRj, 0u},
+  {0x386a8000u, "amadd_db.d", Format::kRdRkRj, 0u},
+  {0x38720000u, "dbar", Format::kCode, 0u},
+  {0x38728000u, "ibar", Format::kCode, 0u},
+  {0x40000000u, "beqz", Format::kBranchRj, 0u},
+  {0x44000000u, "bnez", Format::kBranchRj, 0u},
+  {0x48000000u, "bceqz", Format::kBranchCj, 0u},
+  {0x48000100u, "bcnez", Format::kBranchCj, 0u},
+  {0x4c000000u, "jirl", Format::kJirl, 0u},
+  {0x50000000u, "b", Format::kBranch, 0u},
+  {0x54000000u, "bl", Format::kBranch, 0u},
+  {0x58000000u, "beq", Format::kBranchRjRd, 0u},
+  {0x5c000000u, "bne", Format::kBranchRjRd, 0u},
+  {0x60000000u, "blt", Format::kBranchRjRd, 0u},
+  {0x64000000u, "bge", Format::kBranchRjRd, 0u},
+  {0x68000000u, "bltu", Format::kBranchRjRd, 0u},
+  {0x6c000000u, "bgeu", Format::kBranchRjRd, 0u},
+  {0x700a0000u, "vadd.b", Format::kVdVjVk, 0u},
+  {0x700a8000u, "vadd.h", Format::kVdVjVk, 0u},
+  {0x700b0000u, "vadd.w", Format::kVdVjVk, 0u},
+  {0x700b8000u, "vadd.d", Format::kVdVjVk, 0u},
+  {0x700c0000u, "vsub.b", Format::kVdVjVk, 0u},
+  {0x700c8000u, "vsub.h", Format::kVdVjVk, 0u},
+  {0x700d0000u, "vsub.w", Format::kVdVjVk, 0u},
+  {0x700d8000u, "vsub.d", Format::kVdVjVk, 0u},
+  {0x70460000u, "vsadd.b", Format::kVdVjVk, 0u},
+  {0x70468000u, "vsadd.h", Format::kVdVjVk, 0u},
+  {0x70470000u, "vsadd.w", Format::kVdVjVk, 0u},
+  {0x70478000u, "vsadd.d", Format::kVdVjVk, 0u},
+  {0x70480000u, "vssub.b", Format::kVdVjVk, 0u},
+  {0x70488000u, "vssub.h", Format::kVdVjVk, 0u},
+  {0x70490000u, "vssub.w", Format::kVdVjVk, 0u},
+  {0x70498000u, "vssub.d", Format::kVdVjVk, 0u},
+  {0x704a0000u, "vsadd.bu", Format::kVdVjVk, 0u},
+  {0x704a8000u, "vsadd.hu", Format::kVdVjVk, 0u},
+  {0x704b0000u, "vsadd.wu", Format::kVdVjVk, 0u},
+  {0x704b8000u, "vsadd.du", Format::kVdVjVk, 0u},
+  {0x704c0000u, "vssub.bu", Format::kVdVjVk, 0u},
+  {0x704c8000u, "vssub.hu", Format::kVdVjVk, 0u},
+  {0x704d0000u, "vssub.wu", Format::kVdVjVk, 0u},
+  {0x704d8000u, "vssub.du", Format::kVdVjVk, 0u},
+  {0x70540000u, "vhaddw.h.b", Format::kVdVjVk, 0u},
+  {0x70548000u, "vhaddw.w.h", Format::kVdVjVk, 0u},
+  {0x70550000u, "vhaddw.d.w", Format::kVdVjVk, 0u},
+  {0x70558000u, "vhaddw.q.d", Format::kVdVjVk, 0u},
+  {0x70580000u, "vhaddw.hu.bu", Format::kVdVjVk, 0u},
+  {0x70588000u, "vhaddw.wu.hu", Format::kVdVjVk, 0u},
+  {0x70590000u, "vhaddw.du.wu", Format::kVdVjVk, 0u},
+  {0x70598000u, "vhaddw.qu.du", Format::kVdVjVk, 0u},
+  {0x70600000u, "vabsd.b", Format::kVdVjVk, 0u},
+  {0x70608000u, "vabsd.h", Format::kVdVjVk, 0u},
+  {0x70610000u, "vabsd.w", Format::kVdVjVk, 0u},
+  {0x70618000u, "vabsd.d", Format::kVdVjVk, 0u},
+  {0x70620000u, "vabsd.bu", Format::kVdVjVk, 0u},
+  {0x70628000u, "vabsd.hu", Format::kVdVjVk, 0u},
+  {0x70630000u, "vabsd.wu", Format::kVdVjVk, 0u},
+  {0x70638000u, "vabsd.du", Format::kVdVjVk, 0u},
+  {0x70640000u, "vavg.b", Format::kVdVjVk, 0u},
+  {0x70648000u, "vavg.h", Format::kVdVjVk, 0u},
+  {0x70650000u, "vavg.w", Format::kVdVjVk, 0u},
+  {0x70658000u, "vavg.d", Format::kVdVjVk, 0u},
+  {0x70660000u, "vavg.bu", Format::kVdVjVk, 0u},
+  {0x70668000u, "vavg.hu", Format::kVdVjVk, 0u},
+  {0x70670000u, "vavg.wu", Format::kVdVjVk, 0u},
+  {0x70678000u, "vavg.du", Format::kVdVjVk, 0u},
+  {0x70680000u, "vavgr.b", Format::kVdVjVk, 0u},
+  {0x70688000u, "vavgr.h", Format::kVdVjVk, 0u},
+  {0x70690000u, "vavgr.w", Format::kVdVjVk, 0u},
+  {0x70698000u, "vavgr.d", Format::kVdVjVk, 0u},
+  {0x706a0000u, "vavgr.bu", Format::kVdVjVk, 0u},
+  {0x706a8000u, "vavgr.hu", Format::kVdVjVk, 0u},
+  {0x706b0000u, "vavgr.wu", Format::kVdVjVk, 0u},
+  {0x706b8000u, "vavgr.du", Format::kVdVjVk, 0u},
+  {0x70700000u, "vmax.b", Format::kVdVjVk, 0u},
+  {0x70708000u, "vmax.h", Format::kVdVjVk, 0u},
+  {0x70710000u, "vmax.w", Format::kVdVjVk, 0u},
+  {0x70718000u, "vmax.d", Format::kVdVjVk, 0u},
+  {0x70720000u, "vmin.b", Format::kVdVjVk, 0u},
+  {0x70728000u, "vmin.h", Format::kVdVjVk, 0u},
+  {0x70730000u, "vmin.w", Format::kVdVjVk, 0u},
+  {0x70738000u, "vmin.d", Format::kVdVjVk, 0u},
+  {0x70740000u, "vmax.bu", Format::kVdVjVk, 0u},
+  {0x70748000u, "vmax.hu", Format::kVdVjVk, 0u},
+  {0x70750000u, "vmax.wu", Format::kVdVjVk, 0u},
+  {0x70758000u, "vmax.du", Format::kVdVjVk, 0u},
+  {0x70760000u, "vmin.bu", Format::kVdVjVk, 0u},
+  {0x70768000u, "vmin.hu", Format::kVdVjVk, 0u},
+  {0x70770000u, "vmin.wu", Format::kVdVjVk, 0u},
+  {0x70778000u, "vmin.du", Format::kVdVjVk, 0u},
+  {0x70840000u, "vmul.b", Format::kVdVjVk, 0u},
+  {0x70848000u, "vmul.h", Format::kVdVjVk, 0u},
+  {0x70850000u, "vmul.w", Format::kVdVjVk, 0u},
+  {0x70858000u, "vmul.d", Format::kVdVjVk, 0u},
+  {0x70900000u, "vmulwev.h.b", Format::kVdVjVk, 0u},
+  {0x70908000u, "vmulwev.w.h", Format::kVdVjVk, 0u},
+  {0x70910000u, "vmulwev.d.w", Format::kVdVjVk, 0u},
+  {0x70920000u, "vmulwod.h.b", Format::kVdVjVk, 0u},
+  {0x70928000u, "vmulwod.w.h", Format::kVdVjVk, 0u},
+  {0x70930000u, "vmulwod.d.w", Format::kVdVjVk, 0u},
+  {0x70980000u, "vmulwev.h.bu", Format::kVdVjVk, 0u},
+  {0x70988000u, "vmulwev.w.hu", Format::kVdVjVk, 0u},
+  {0x70990000u, "vmulwev.d.wu", Format::kVdVjVk, 0u},
+  {0x709a0000u, "vmulwod.h.bu", Format::kVdVjVk, 0u},
+  {0x709a8000u, "vmulwod.w.hu", Format::kVdVjVk, 0u},
+  {0x709b0000u, "vmulwod.d.wu", Format::kVdVjVk, 0u},
+  {0x70a80000u, "vmadd.b", Format::kVdVjVk, 0u},
+  {0x70a88000u, "vmadd.h", Format::kVdVjVk, 0u},
+  {0x70a90000u, "vmadd.w", Format::kVdVjVk, 0u},
+  {0x70a98000u, "vmadd.d", Format::kVdVjVk, 0u},
+  {0x70aa0000u, "vmsub.b", Format::kVdVjVk, 0u},
+  {0x70aa8000u, "vmsub.h", Format::kVdVjVk, 0u},
+  {0x70ab0000u, "vmsub.w", Format::kVdVjVk, 0u},
+  {0x70ab8000u, "vmsub.d", Format::kVdVjVk, 0u},
+  {0x70ac0000u, "vmaddwev.h.b", Format::kVdVjVk, 0u},
+  {0x70ac8000u, "vmaddwev.w.h", Format::kVdVjVk, 0u},
+  {0x70ad0000u, "vmaddwev.d.w", Format::kVdVjVk, 0u},
+  {0x70ae0000u, "vmaddwod.h.b", Format::kVdVjVk, 0u},
+  {0x70ae8000u, "vmaddwod.w.h", Format::kVdVjVk, 0u},
+  {0x70af0000u, "vmaddwod.d.w", Format::kVdVjVk, 0u},
+  {0x70b40000u, "vmaddwev.h.bu", Format::kVdVjVk, 0u},
+  {0x70b48000u, "vmaddwev.w.hu", Format::kVdVjVk, 0u},
+  {0x70b50000u, "vmaddwev.d.wu", Format::kVdVjVk, 0u},
+  {0x70b60000u, "vmaddwod.h.bu", Format::kVdVjVk, 0u},
+  {0x70b68000u, "vmaddwod.w.hu", Format::kVdVjVk, 0u},
+  {0x70b70000u, "vmaddwod.d.wu", Format::kVdVjVk, 0u},
+  {0x71260000u, "vand.v", Format::kVdVjVk, 0u},
+  {0x71268000u, "vor.v", Format::kVdVjVk, 0u},
+  {0x71270000u, "vxor.v", Format::kVdVjVk, 0u},
+  {0x71278000u, "vnor.v", Format::kVdVjVk, 0u},
+  {0x71280000u, "vandn.v", Format::kVdVjVk, 0u},
+  {0x712e0000u, "vsigncov.b", Format::kVdVjVk, 0u},
+  {0x712e8000u, "vsigncov.h", Format::kVdVjVk, 0u},
+  {0x712f0000u, "vsigncov.w", Format::kVdVjVk, 0u},
+  {0x712f8000u, "vsigncov.d", Format::kVdVjVk, 0u},
+  {0x71308000u, "vfadd.s", Format::kVdVjVk, 0u},
+  {0x71310000u, "vfadd.d", Format::kVdVjVk, 0u},
+  {0x71328000u, "vfsub.s", Format::kVdVjVk, 0u},
+  {0x71330000u, "vfsub.d", Format::kVdVjVk, 0u},
+  {0x71388000u, "vfmul.s", Format::kVdVjVk, 0u},
+  {0x71390000u, "vfmul.d", Format::kVdVjVk, 0u},
+  {0x713a8000u, "vfdiv.s", Format::kVdVjVk, 0u},
+  {0x713b0000u, "vfdiv.d", Format::kVdVjVk, 0u},
+  {0x713c8000u, "vfmax.s", Format::kVdVjVk, 0u},
+  {0x713d0000u, "vfmax.d", Format::kVdVjVk, 0u},
+  {0x713e8000u, "vfmin.s", Format::kVdVjVk, 0u},
+  {0x713f0000u, "vfmin.d", Format::kVdVjVk, 0u},
+  {0x728e0000u, "vbsll.v", Format::kVdVjUi, 5u},
+  {0x728e8000u, "vbsrl.v", Format::kVdVjUi, 5u},
+  {0x729c3000u, "vneg.b", Format::kVdVj, 0u},
+  {0x729c3400u, "vneg.h", Format::kVdVj, 0u},
+  {0x729c3800u, "vneg.w", Format::kVdVj, 0u},
+  {0x729c3c00u, "vneg.d", Format::kVdVj, 0u},
+  {0x729e0000u, "vffint.s.w", Format::kVdVj, 0u},
+  {0x729e0800u, "vffint.d.l", Format::kVdVj, 0u},
+  {0x729e4800u, "vftintrz.w.s", Format::kVdVj, 0u},
+  {0x729e4c00u, "vftintrz.l.d", Format::kVdVj, 0u},
+  {0x729f0000u, "vreplgr2vr.b", Format::kVdRj, 0u},
+  {0x729f0400u, "vreplgr2vr.h", Format::kVdRj, 0u},
+  {0x729f0800u, "vreplgr2vr.w", Format::kVdRj, 0u},
+  {0x729f0c00u, "vreplgr2vr.d", Format::kVdRj, 0u},
+  {0x72eb8000u, "vinsgr2vr.b", Format::kVdRjIdx, 4u},
+  {0x72ebc000u, "vinsgr2vr.h", Format::kVdRjIdx, 3u},
+  {0x72ebe000u, "vinsgr2vr.w", Format::kVdRjIdx, 2u},
+  {0x72ebf000u, "vinsgr2vr.d", Format::kVdRjIdx, 1u},
+  {0x72ef8000u, "vpickve2gr.b", Format::kRdVjIdx, 4u},
+  {0x72efc000u, "vpickve2gr.h", Format::kRdVjIdx, 3u},
+  {0x72efe000u, "vpickve2gr.w", Format::kRdVjIdx, 2u},
+  {0x72eff000u, "vpickve2gr.d", Format::kRdVjIdx, 1u},
+  {0x72f38000u, "vpickve2gr.bu", Format::kRdVjIdx, 4u},
+  {0x72f3c000u, "vpickve2gr.hu", Format::kRdVjIdx, 3u},
+  {0x72f3e000u, "vpickve2gr.wu", Format::kRdVjIdx, 2u},
+  {0x72f3f000u, "vpickve2gr.du", Format::kRdVjIdx, 1u},
+  {0x72f78000u, "vreplvei.b", Format::kVdVjIdx, 4u},
+  {0x72f7c000u, "vreplvei.h", Format::kVdVjIdx, 3u},
+  {0x72f7e000u, "vreplvei.w", Format::kVdVjIdx, 2u},
+  {0x72f7f000u, "vreplvei.d", Format::kVdVjIdx, 1u},
+  {0x73082000u, "vsllwil.h.b", Format::kVdVjUi, 3u},
+  {0x73084000u, "vsllwil.w.h", Format::kVdVjUi, 4u},
+  {0x73088000u, "vsllwil.d.w", Format::kVdVjUi, 5u},
+  {0x730c2000u, "vsllwil.hu.bu", Format::kVdVjUi, 3u},
+  {0x730c4000u, "vsllwil.wu.hu", Format::kVdVjUi, 4u},
+  {0x730c8000u, "vsllwil.du.wu", Format::kVdVjUi, 5u},
+  {0x73108000u, "vbitclri.w", Format::kVdVjUi, 5u},
+  {0x73110000u, "vbitclri.d", Format::kVdVjUi, 6u},
+  {0x73188000u, "vbitrevi.w", Format::kVdVjUi, 5u},
+  {0x73190000u, "vbitrevi.d", Format::kVdVjUi, 6u},
+  {0x732c2000u, "vslli.b", Format::kVdVjUi, 3u},
+  {0x732c4000u, "vslli.h", Format::kVdVjUi, 4u},
+  {0x732c8000u, "vslli.w", Format::kVdVjUi, 5u},
+  {0x732d0000u, "vslli.d", Format::kVdVjUi, 6u},
+  {0x73302000u, "vsrli.b", Format::kVdVjUi, 3u},
+  {0x73304000u, "vsrli.h", Format::kVdVjUi, 4u},
+  {0x73308000u, "vsrli.w", Format::kVdVjUi, 5u},
+  {0x73310000u, "vsrli.d", Format::kVdVjUi, 6u},
+  {0x73342000u, "vsrai.b", Format::kVdVjUi, 3u},
+  {0x73344000u, "vsrai.h", Format::kVdVjUi, 4u},
+  {0x73348000u, "vsrai.w", Format::kVdVjUi, 5u},
+  {0x73350000u, "vsrai.d", Format::kVdVjUi, 6u},
+  {0x73e00000u, "vrepli.b", Format::kVdSi10, 0u},
+  {0x73e08000u, "vrepli.h", Format::kVdSi10, 0u},
+  {0x73e10000u, "vrepli.w", Format::kVdSi10, 0u},
+  {0x73e18000u, "vrepli.d", Format::kVdSi10, 0u},
+};
+
+// LASX instructions whose encoding does not follow the LSX one with bit 26 set.
+static constexpr Opcode kLasxOpcodes[] = {
+  {0x2c800000u, "xvld", Format::kVdRjSi12, 0u},
+  {0x2cc00000u, "xvst", Format::kVdRjSi12, 0u},
+  {0x38480000u, "xvldx", Format::kVdRjRk, 0u},
+  {0x384c0000u, "xvstx", Format::kVdRjRk, 0u},
+  {0x76ebc000u, "xvinsgr2vr.w", Format::kVdRjIdx, 3u},
+  {0x76ebe000u, "xvinsgr2vr.d", Format::kVdRjIdx, 2u},
+  {0x76efc000u, "xvpickve2gr.w", Format::kRdVjIdx, 3u},
+  {0x76efe000u, "xvpickve2gr.d", Format::kRdVjIdx, 2u},
+  {0x76f3c000u, "xvpickve2gr.wu", Format::kRdVjIdx, 3u},
+  {0x76f3e000u, "xvpickve2gr.du", Format::kRdVjIdx, 2u},
+};
+
+static const char* const kXRegisterNames[] = {
+  "zero", "ra", "tp", "sp", "a0", "a1", "a2", "a3",
+  "a4", "a5", "a6", "a7", "t0", "t1", "t2", "t3",
+  "t4", "t5", "t6", "t7", "t8", "r21", "fp", "s0",
+  "tr", "s2", "s3", "s4", "s5", "s6", "s7", "s8"
+};
+
+static const char* const kFRegisterNames[] = {
+  "fa0", "fa1", "fa2", "fa3", "fa4", "fa5", "fa6", "fa7",
+  "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7",
+  "ft8", "ft9", "ft10", "ft11", "ft12", "ft13", "ft14", "ft15",
+  "fs0", "fs1", "fs2", "fs3", "fs4", "fs5", "fs6", "fs7",
+};
+
+// FCMP.cond.{S,D} condition names indexed by the `cond` field; reserved encodings are null.
+static const char* const kFcmpConditionNames[] = {
+  "caf", "saf", "clt", "slt", "ceq", "seq", "cle", "sle",
+  "cun", "sun", "cult", "sult", "cueq", "sueq", "cule", "sule",
+  "cne", "sne", nullptr, nullptr, "cor", "sor", nullptr, nullptr,
+  "cune", "sune", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+};
+
+// Bit 26 distinguishes most LASX instructions from their LSX counterparts.
+static constexpr uint32_t kLasxBit = 1u << 26;
+static constexpr uint32_t kLasxMajorOpcode = 0x1du;  // Bits [31:26] of 0x74000000-0x77ffffff.
+static constexpr uint32_t kLsxArithmeticBegin = 0x70000000u;
+
+static uint32_t GetMask(const Opcode& opcode) {
+  switch (opcode.format) {
+    case Format::kRdRjRk:
+    case Format::kRdRkRj:
+    case Format::kFdFjFk:
+    case Format::kFdRjRk:
+    case Format::kVdVjVk:
+    case Format::kVdRjRk:
+    case Format::kCode:
+    case Format::kVdSi10:
+      return 0xffff8000u;
+    case Format::kRdRjRkSa2:
+      return 0xfffe0000u;
+    case Format::kRdRj:
+    case Format::kFdFj:
+    case Format::kFdRj:
+    case Format::kRdFj:
+    case Format::kVdVj:
+    case Format::kVdRj:
+      return 0xfffffc00u;
+    case Format::kCdRj:
+      return 0xfffffc18u;
+    case Format::kRdCj:
+      return 0xffffff00u;
+    case Format::kRdRjUi:
+    case Format::kVdVjUi:
+    case Format::kVdVjIdx:
+    case Format::kVdRjIdx:
+    case Format::kRdVjIdx:
+      return ~((1u << (10u + opcode.bits)) - 1u);
+    case Format::kBstrW:
+      return 0xffe08000u;
+    case Format::kBstrD:
+    case Format::kRdRjSi12:
+    case Format::kRdRjUi12:
+    case Format::kFdRjSi12:
+    case Format::kVdRjSi12:
+      return 0xffc00000u;
+    case Format::kRdRjSi14:
+      return 0xff000000u;
+    case Format::kRdSi20:
+      return 0xfe000000u;
+    case Format::kRdRjSi16:
+    case Format::kBranchRjRd:
+    case Format::kJirl:
+    case Format::kBranchRj:
+    case Format::kBranch:
+      return 0xfc000000u;
+    case Format::kBranchCj:
+      return 0xfc000300u;
+    case Format::kFdFjFkFa:
+      return 0xfff00000u;
+    case Format::kFsel:
+      return 0xfffc0000u;
+    case Format::kFcmp:
+      return 0xfff00018u;
+  }
+  LOG(FATAL) << "Unexpected format " << static_cast<int>(opcode.format);
+  UNREACHABLE();
+}
+
+// Whether the LASX instruction with bit 26 set has the same operand layout as this LSX one.
+static bool HasLasxTwin(const Opcode& opcode) {
+  if (opcode.match < kLsxArithmeticBegin) {
+    return false;
+  }
+  switch (opcode.format) {
+    case Format::kVdVjVk:
+    case Format::kVdVj:
+    case Format::kVdRj:
+    case Format::kVdVjUi:
+    case Format::kVdSi10:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <size_t kSize>
+static const Opcode* FindOpcode(const Opcode (&table)[kSize], uint32_t insn) {
+  for (const Opcode& opcode : table) {
+    if ((insn & GetMask(opcode)) == opcode.match) {
+      return &opcode;
+    }
+  }
+  return nullptr;
+}
+
+static bool IsLoadOrStore(const char* name) {
+  return strncmp(name, "ld", 2u) == 0 ||
+         strncmp(name, "st", 2u) == 0 ||
+         strncmp(name, "fld", 3u) == 0 ||
+         strncmp(name, "fst", 3u) == 0;
+}
+
+std::string DisassemblerLoongarch64::FormatPcOffset(int32_t offset, const uint8_t* begin) {
+  return StringPrintf("%+d (%s)", offset, FormatInstructionPointer(begin + offset).c_str());
+}
+
+std::string DisassemblerLoongarch64::DisassembleInstruction(uint32_t insn, const uint8_t* begin) {
+  const uint32_t rd = insn & 0x1fu;
+  const uint32_t rj = (insn >> 5) & 0x1fu;
+  const uint32_t rk = (insn >> 10) & 0x1fu;
+  const uint32_t ra = (insn >> 15) & 0x1fu;
+
+  // Print the common assembler aliases the way ART writes them.
+  if (insn == 0x03400000u) {
+    return "nop";  // andi zero, zero, 0
+  }
+  if ((insn & 0xfffffc1fu) == 0x4c000000u) {
+    // jirl zero, rj, 0
+    return (rj == 1u) ? "ret" : StringPrintf("jr %s", kXRegisterNames[rj]);
+  }
+  if ((insn & 0xfffffc00u) == 0x00150000u) {
+    // or rd, rj, zero
+    return StringPrintf("move %s, %s", kXRegisterNames[rd], kXRegisterNames[rj]);
+  }
+
+  bool lasx = false;
+  const char* prefix = "";
+  const Opcode* opcode = FindOpcode(kOpcodes, insn);
+  if (opcode == nullptr && (insn >> 26) == kLasxMajorOpcode) {
+    opcode = FindOpcode(kLasxOpcodes, insn);
+    if (opcode == nullptr) {
+      opcode = FindOpcode(kOpcodes, insn & ~kLasxBit);
+      if (opcode != nullptr && !HasLasxTwin(*opcode)) {
+        opcode = nullptr;
+      }
+      prefix = "x";
+    }
+    lasx = true;
+  } else if (opcode == nullptr) {
+    opcode = FindOpcode(kLasxOpcodes, insn);
+    lasx = true;
+  }
+  if (opcode == nullptr) {
+    return "<unknown>";
+  }
+
+  auto x = [](uint32_t reg) { return kXRegisterNames[reg]; };
+  auto f = [](uint32_t reg) { return kFRegisterNames[reg]; };
+  auto v = [lasx](uint32_t reg) { return StringPrintf("%s%u", lasx ? "xr" : "vr", reg); };
+  auto si = [insn](size_t lsb, size_t width) {
+    return BitFieldExtract(static_cast<int32_t>(insn), lsb, width);
+  };
+  auto ui = [insn](size_t lsb, size_t width) {
+    return BitFieldExtract(insn, lsb, width);
+  };
+
+  std::ostringstream args;
+  int32_t thread_offset = -1;
+  switch (opcode->format) {
+    case Format::kRdRjRk:
+      args << x(rd) << ", " << x(rj) << ", " << x(rk);
+      break;
+    case Format::kRdRkRj:
+      args << x(rd) << ", " << x(rk) << ", " << x(rj);
+      break;
+    case Format::kRdRjRkSa2:
+      args << x(rd) << ", " << x(rj) << ", " << x(rk) << ", " << (ui(15, 2) + 1u);
+      break;
+    case Format::kRdRj:
+      args << x(rd) << ", " << x(rj);
+      break;
+    case Format::kRdRjUi:
+      args << x(rd) << ", " << x(rj) << ", " << ui(10, opcode->bits);
+      break;
+    case Format::kBstrW:
+      args << x(rd) << ", " << x(rj) << ", " << ui(16, 5) << ", " << ui(10, 5);
+      break;
+    case Format::kBstrD:
+      args << x(rd) << ", " << x(rj) << ", " << ui(16, 6) << ", " << ui(10, 6);
+      break;
+    case Format::kRdRjSi12:
+      args << x(rd) << ", " << x(rj) << ", " << si(10, 12);
+      if (rj == kThreadRegister && IsLoadOrStore(opcode->name)) {
+        thread_offset = si(10, 12);
+      }
+      break;
+    case Format::kRdRjUi12:
+      args << x(rd) << ", " << x(rj) << ", " << ui(10, 12);
+      break;
+    case Format::kRdRjSi14:
+      args << x(rd) << ", " << x(rj) << ", " << (si(10, 14) * 4);
+      if (rj == kThreadRegister && IsLoadOrStore(opcode->name)) {
+        thread_offset = si(10, 14) * 4;
+      }
+      break;
+    case Format::kRdRjSi16:
+      args << x(rd) << ", " << x(rj) << ", " << si(10, 16);
+      break;
+    case Format::kRdSi20:
+      args << x(rd) << ", " << si(5, 20);
+      break;
+    case Format::kBranchRjRd:
+      args << x(rj) << ", " << x(rd) << ", " << FormatPcOffset(si(10, 16) * 4, begin);
+      break;
+    case Format::kJirl:
+      args << x(rd) << ", " << x(rj) << ", " << (si(10, 16) * 4);
+      break;
+    case Format::kBranchRj:
+    case Format::kBranchCj: {
+      int32_t offset = BitFieldExtract(static_cast<int32_t>((rd << 16) | ui(10, 16)), 0, 21) * 4;
+      if (opcode->format == Format::kBranchRj) {
+        args << x(rj);
+      } else {
+        args << "fcc" << (rj & 7u);
+      }
+      args << ", " << FormatPcOffset(offset, begin);
+      break;
+    }
+    case Format::kBranch: {
+      int32_t offset = BitFieldExtract(static_cast<int32_t>((ui(0, 10) << 16) | ui(10, 16)), 0, 26);
+      args << FormatPcOffset(offset * 4, begin);
+      break;
+    }
+    case Format::kCode:
+      args << ui(0, 15);
+      break;
+    case Format::kFdFjFk:
+      args << f(rd) << ", " << f(rj) << ", " << f(rk);
+      break;
+    case Format::kFdFjFkFa:
+      args << f(rd) << ", " << f(rj) << ", " << f(rk) << ", " << f(ra);
+      break;
+    case Format::kFsel:
+      args << f(rd) << ", " << f(rj) << ", " << f(rk) << ", fcc" << (ra & 7u);
+      break;
+    case Format::kFcmp: {
+      const char* condition = kFcmpConditionNames[ra];
+      if (condition == nullptr) {
+        return "<unknown>";
+      }
+      // The table holds "fcmp.s" or "fcmp.d"; the condition goes between the two parts.
+      std::string name = StringPrintf("fcmp.%s%s", condition, opcode->name + strlen("fcmp"));
+      return StringPrintf("%s fcc%u, %s, %s", name.c_str(), rd & 7u, f(rj), f(rk));
+    }
+    case Format::kFdFj:
+      args << f(rd) << ", " << f(rj);
+      break;
+    case Format::kFdRj:
+      args << f(rd) << ", " << x(rj);
+      break;
+    case Format::kRdFj:
+      args << x(rd) << ", " << f(rj);
+      break;
+    case Format::kCdRj:
+      args << "fcc" << (rd & 7u) << ", " << x(rj);
+      break;
+    case Format::kRdCj:
+      args << x(rd) << ", fcc" << (rj & 7u);
+      break;
+    case Format::kFdRjSi12:
+      args << f(rd) << ", " << x(rj) << ", " << si(10, 12);
+      if (rj == kThreadRegister && IsLoadOrStore(opcode->name)) {
+        thread_offset = si(10, 12);
+      }
+      break;
+    case Format::kFdRjRk:
+      args << f(rd) << ", " << x(rj) << ", " << x(rk);
+      break;
+    case Format::kVdVjVk:
+      args << v(rd) << ", " << v(rj) << ", " << v(rk);
+      break;
+    case Format::kVdVj:
+      args << v(rd) << ", " << v(rj);
+      break;
+    case Format::kVdRj:
+      args << v(rd) << ", " << x(rj);
+      break;
+    case Format::kVdVjUi:
+    case Format::kVdVjIdx:
+      args << v(rd) << ", " << v(rj) << ", " << ui(10, opcode->bits);
+      break;
+    case Format::kVdRjIdx:
+      args << v(rd) << ", " << x(rj) << ", " << ui(10, opcode->bits);
+      break;
+    case Format::kRdVjIdx:
+      args << x(rd) << ", " << v(rj) << ", " << ui(10, opcode->bits);
+      break;
+    case Format::kVdSi10:
+      args << v(rd) << ", " << si(5, 10);
+      break;
+    case Format::kVdRjSi12:
+      args << v(rd) << ", " << x(rj) << ", " << si(10, 12);
+      break;
+    case Format::kVdRjRk:
+      args << v(rd) << ", " << x(rj) << ", " << x(rk);
+      break;
+  }
+
+  std::string result = StringPrintf("%s%s %s", prefix, opcode->name, args.str().c_str());
+  if (thread_offset >= 0) {
+    std::ostringstream tmp_stream;
+    GetDisassemblerOptions()->thread_offset_name_function_(tmp_stream,
+                                                           static_cast<uint32_t>(thread_offset));
+    result += " ; " + tmp_stream.str();
+  }
+  return result;
+}
+
+size_t DisassemblerLoongarch64::Dump(std::ostream& os, const uint8_t* begin) {
+  uint32_t insn;
+  memcpy(&insn, begin, sizeof(insn));
+  os << FormatInstructionPointer(begin)
+     << StringPrintf(": %08x\t%s\n", insn, DisassembleInstruction(insn, begin).c_str());
+  return kInstructionSize;
+}
+
+void DisassemblerLoongarch64::Dump(std::ostream& os, const uint8_t* begin, const uint8_t* end) {
+  for (const uint8_t* cur = begin; cur < end; cur += kInstructionSize) {
+    Dump(os, cur);
+  }
+}
+
+}  // namespace loongarch64
+}  // namespace art
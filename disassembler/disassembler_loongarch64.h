@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_DISASSEMBLER_DISASSEMBLER_LOONGARCH64_H_
+#define ART_DISASSEMBLER_DISASSEMBLER_LOONGARCH64_H_
+
+#include <string>
+
+#include "disassembler.h"
+
+namespace art {
+namespace loongarch64 {
+
+// Table-driven disassembler for the LoongArch64 base integer and floating point ISA
+// and the LSX/LASX vector extensions, covering the instructions emitted by ART.
+class DisassemblerLoongarch64 final : public Disassembler {
+ public:
+  explicit DisassemblerLoongarch64(DisassemblerOptions* options) : Disassembler(options) {}
+
+  size_t Dump(std::ostream& os, const uint8_t* begin) override;
+  void Dump(std::ostream& os, const uint8_t* begin, const uint8_t* end) override;
+
+ private:
+  // Returns the text of the instruction `insn` located at `begin`, without the address prefix.
+  std::string DisassembleInstruction(uint32_t insn, const uint8_t* begin);
+
+  // Formats a PC-relative branch or address offset together with the resolved target.
+  std::string FormatPcOffset(int32_t offset, const uint8_t* begin);
+
+  DISALLOW_COPY_AND_ASSIGN(DisassemblerLoongarch64);
+};
+
+}  // namespace loongarch64
+}  // namespace art
+
+#endif  // ART_DISASSEMBLER_DISASSEMBLER_LOONGARCH64_H_
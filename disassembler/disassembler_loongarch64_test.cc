@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "disassembler_loongarch64.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace art {
+namespace loongarch64 {
+
+class DisassemblerLoongarch64Test : public ::testing::Test {
+ protected:
+  static std::string Disassemble(const std::vector<uint32_t>& code) {
+    const uint8_t* begin = reinterpret_cast<const uint8_t*>(code.data());
+    const uint8_t* end = begin + code.size() * sizeof(uint32_t);
+    std::unique_ptr<Disassembler> disassembler(Disassembler::Create(
+        InstructionSet::kLoongarch64,
+        new DisassemblerOptions(/* absolute_addresses= */ false,
+                                begin,
+                                end,
+                                /* can_read_literals= */ false,
+                                &DumpThreadOffset)));
+    std::ostringstream os;
+    disassembler->Dump(os, begin, end);
+    return os.str();
+  }
+
+ private:
+  static void DumpThreadOffset(std::ostream& os, uint32_t offset) {
+    os << "thread+" << offset;
+  }
+};
+
+TEST_F(DisassemblerLoongarch64Test, Base) {
+  std::vector<uint32_t> code = {
+      0x001098a4u,  // add.d   $a0, $a1, $a2
+      0x02ffc063u,  // addi.d  $sp, $sp, -16
+      0x28c0e30cu,  // ld.d    $t0, $tr, 56
+      0x002d18e6u,  // alsl.d  $a2, $a3, $a2, 3
+      0x00df43ffu,  // bstrpick.d $s8, $s8, 31, 16
+      0x15ffffedu,  // lu12i.w $t1, -1
+      0x001500a4u,  // or      $a0, $a1, $zero
+      0x40000880u,  // beqz    $a0, 8
+      0x03400000u,  // andi    $zero, $zero, 0
+      0x4c000260u,  // jirl    $zero, $t7, 0
+      0x4c000020u,  // jirl    $zero, $ra, 0
+  };
+  const char* expected =
+      "0x00000000: 001098a4\tadd.d a0, a1, a2\n"
+      "0x00000004: 02ffc063\taddi.d sp, sp, -16\n"
+      "0x00000008: 28c0e30c\tld.d t0, tr, 56 ; thread+56\n"
+      "0x0000000c: 002d18e6\talsl.d a2, a3, a2, 3\n"
+      "0x00000010: 00df43ff\tbstrpick.d s8, s8, 31, 16\n"
+      "0x00000014: 15ffffed\tlu12i.w t1, -1\n"
+      "0x00000018: 001500a4\tmove a0, a1\n"
+      "0x0000001c: 40000880\tbeqz a0, +8 (0x00000024)\n"
+      "0x00000020: 03400000\tnop\n"
+      "0x00000024: 4c000260\tjr t7\n"
+      "0x00000028: 4c000020\tret\n";
+  EXPECT_EQ(expected, Disassemble(code));
+}
+
+TEST_F(DisassemblerLoongarch64Test, FloatingPoint) {
+  std::vector<uint32_t> code = {
+      0x01012020u,  // fadd.d  $fa0, $fa1, $ft0
+      0x0c256701u,  // fcmp.cult.d $fcc1, $fs0, $fs1
+      0x0d00ad49u,  // fsel    $ft1, $ft2, $ft3, $fcc1
+      0x0114a9c2u,  // movgr2fr.d $fa2, $t2
+  };
+  const char* expected =
+      "0x00000000: 01012020\tfadd.d fa0, fa1, ft0\n"
+      "0x00000004: 0c256701\tfcmp.cult.d fcc1, fs0, fs1\n"
+      "0x00000008: 0d00ad49\tfsel ft1, ft2, ft3, fcc1\n"
+      "0x0000000c: 0114a9c2\tmovgr2fr.d fa2, t2\n";
+  EXPECT_EQ(expected, Disassemble(code));
+}
+
+TEST_F(DisassemblerLoongarch64Test, Vector) {
+  std::vector<uint32_t> code = {
+      0x700b0820u,  // vadd.w  $vr0, $vr1, $vr2
+      0x729f0883u,  // vreplgr2vr.w $vr3, $a0
+      0x72efec85u,  // vpickve2gr.w $a1, $vr4, 3
+      0x2c3fc065u,  // vld     $vr5, $sp, -16
+      0x73e07fe6u,  // vrepli.b $vr6, -1
+      0x740b0820u,  // xvadd.w $xr0, $xr1, $xr2
+      0x2c800080u,  // xvld    $xr0, $a0, 0
+  };
+  const char* expected =
+      "0x00000000: 700b0820\tvadd.w vr0, vr1, vr2\n"
+      "0x00000004: 729f0883\tvreplgr2vr.w vr3, a0\n"
+      "0x00000008: 72efec85\tvpickve2gr.w a1, vr4, 3\n"
+      "0x0000000c: 2c3fc065\tvld vr5, sp, -16\n"
+      "0x00000010: 73e07fe6\tvrepli.b vr6, -1\n"
+      "0x00000014: 740b0820\txvadd.w xr0, xr1, xr2\n"
+      "0x00000018: 2c800080\txvld xr0, a0, 0\n";
+  EXPECT_EQ(expected, Disassemble(code));
+}
+
+TEST_F(DisassemblerLoongarch64Test, Unknown) {
+  std::vector<uint32_t> code = {0xffffffffu};
+  EXPECT_EQ("0x00000000: ffffffff\t<unknown>\n", Disassemble(code));
+}
+
+}  // namespace loongarch64
+}  // namespace art
@@ -74,6 +74,7 @@ const char* const ArenaAllocatorStatsImpl<kCount>::kAllocNames[] = {
   "LSA          ",
   "LSE          ",
   "CFRE         ",
+  "WBE          ",
   "LICM         ",
   "LoopOpt      ",
   "SsaLiveness  ",
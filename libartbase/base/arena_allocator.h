@@ -83,6 +83,7 @@ enum ArenaAllocKind {
   kArenaAllocLSA,
   kArenaAllocLSE,
   kArenaAllocCFRE,
+  kArenaAllocWBE,
   kArenaAllocLICM,
   kArenaAllocLoopOptimization,
   kArenaAllocSsaLiveness,
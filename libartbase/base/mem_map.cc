@@ -833,6 +833,10 @@ void MemMap::MadviseDontNeedAndZero() {
   }
 }
 
+bool MemMap::AdviseHugePages(bool enable) {
+  return art::AdviseHugePages(base_begin_, base_size_, enable);
+}
+
 int MemMap::MadviseDontFork() {
 #if defined(__linux__)
   if (base_begin_ != nullptr || base_size_ != 0) {
@@ -1221,6 +1225,23 @@ void MemMap::TryReadable() {
   }
 }
 
+bool AdviseHugePages(void* address, size_t length, bool enable) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  uint8_t* const begin = AlignUp(reinterpret_cast<uint8_t*>(address), MemMap::kHugePageSize);
+  uint8_t* const end =
+      AlignDown(reinterpret_cast<uint8_t*>(address) + length, MemMap::kHugePageSize);
+  if (begin >= end) {
+    // No huge page fits in this range.
+    return true;
+  }
+  return madvise(begin, end - begin, enable ? MADV_HUGEPAGE : MADV_NOHUGEPAGE) == 0;
+#else
+  UNUSED(address, length, enable);
+  errno = ENOSYS;
+  return false;
+#endif
+}
+
 void ZeroAndReleasePages(void* address, size_t length) {
   if (length == 0) {
     return;
@@ -25,6 +25,7 @@
 #include <string>
 
 #include "android-base/thread_annotations.h"
+#include "globals.h"
 #include "macros.h"
 
 namespace art {
@@ -59,6 +60,9 @@ class MemMap {
  public:
   static constexpr bool kCanReplaceMapping = HAVE_MREMAP_SYSCALL;
 
+  // Size of the transparent huge pages of the platforms we support.
+  static constexpr size_t kHugePageSize = 2 * MB;
+
   // Creates an invalid mapping.
   MemMap() {}
 
@@ -233,6 +237,11 @@ class MemMap {
   void MadviseDontNeedAndZero();
   int MadviseDontFork();
 
+  // Ask the kernel to back the huge-page-aligned part of the map with transparent huge pages
+  // (MADV_HUGEPAGE), or to stop doing so (MADV_NOHUGEPAGE). Return false and set errno on
+  // failure, e.g. when the kernel does not support transparent huge pages.
+  bool AdviseHugePages(bool enable);
+
   int GetProtect() const {
     return prot_;
   }
@@ -422,6 +431,10 @@ std::ostream& operator<<(std::ostream& os, const MemMap& mem_map);
 // Zero and release pages if possible, no requirements on alignments.
 void ZeroAndReleasePages(void* address, size_t length);
 
+// Apply MADV_HUGEPAGE (or MADV_NOHUGEPAGE when `enable` is false) to the huge-page-aligned part
+// of [address, address + length). Return false and set errno on failure.
+bool AdviseHugePages(void* address, size_t length, bool enable);
+
 }  // namespace art
 
 #endif  // ART_LIBARTBASE_BASE_MEM_MAP_H_
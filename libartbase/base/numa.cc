@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "numa.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+#include "android-base/file.h"
+#include "android-base/stringprintf.h"
+#include "android-base/strings.h"
+#include "macros.h"
+
+namespace art {
+
+bool ParseNumaList(const std::string& list, /*out*/ std::vector<int>* values) {
+  values->clear();
+  std::string trimmed = android::base::Trim(list);
+  if (trimmed.empty()) {
+    return true;
+  }
+  for (const std::string& range : android::base::Split(trimmed, ",")) {
+    std::vector<std::string> bounds = android::base::Split(range, "-");
+    if (bounds.size() > 2u) {
+      return false;
+    }
+    char* end;
+    long first = strtol(bounds[0].c_str(), &end, 10);
+    if (bounds[0].empty() || *end != '\0' || first < 0) {
+      return false;
+    }
+    long last = first;
+    if (bounds.size() == 2u) {
+      last = strtol(bounds[1].c_str(), &end, 10);
+      if (bounds[1].empty() || *end != '\0' || last < first) {
+        return false;
+      }
+    }
+    for (long value = first; value <= last; ++value) {
+      values->push_back(static_cast<int>(value));
+    }
+  }
+  return true;
+}
+
+size_t GetNumaNodeCount() {
+  static const size_t node_count = []() {
+    std::string online;
+    std::vector<int> nodes;
+    if (!android::base::ReadFileToString("/sys/devices/system/node/online", &online) ||
+        !ParseNumaList(online, &nodes) ||
+        nodes.empty()) {
+      return static_cast<size_t>(1u);
+    }
+    // Nodes are numbered densely on all the machines we care about; use the highest one.
+    return std::min(static_cast<size_t>(*std::max_element(nodes.begin(), nodes.end())) + 1u,
+                    kMaxNumaNodes);
+  }();
+  return node_count;
+}
+
+size_t GetCurrentNumaNode() {
+#if defined(__linux__) && defined(__NR_getcpu)
+  unsigned cpu;
+  unsigned node;
+  if (syscall(__NR_getcpu, &cpu, &node, nullptr) == 0 && node < GetNumaNodeCount()) {
+    return node;
+  }
+#endif
+  return 0u;
+}
+
+std::vector<int> GetNumaNodeCpus(size_t node) {
+  std::vector<int> cpus;
+  std::string cpu_list;
+  std::string path = android::base::StringPrintf("/sys/devices/system/node/node%zu/cpulist", node);
+  if (!android::base::ReadFileToString(path, &cpu_list) || !ParseNumaList(cpu_list, &cpus)) {
+    cpus.clear();
+  }
+  return cpus;
+}
+
+#if defined(__linux__) && defined(__NR_mbind)
+
+bool SetPreferredNumaNode(void* begin, size_t size, size_t node) {
+  if (node >= kMaxNumaNodes) {
+    errno = EINVAL;
+    return false;
+  }
+  // MPOL_PREFERRED, from linux/mempolicy.h.
+  static constexpr int kMpolPreferred = 1;
+  unsigned long node_mask = 1ul << node;
+  // The kernel reads `maxnode - 1` bits of the mask.
+  return syscall(__NR_mbind,
+                 begin,
+                 size,
+                 kMpolPreferred,
+                 &node_mask,
+                 sizeof(node_mask) * 8u + 1u,
+                 0u) == 0;
+}
+
+#else  // __linux__ && __NR_mbind
+
+bool SetPreferredNumaNode(void* begin ATTRIBUTE_UNUSED,
+                          size_t size ATTRIBUTE_UNUSED,
+                          size_t node ATTRIBUTE_UNUSED) {
+  errno = ENOSYS;
+  return false;
+}
+
+#endif  // __linux__ && __NR_mbind
+
+}  // namespace art
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_LIBARTBASE_BASE_NUMA_H_
+#define ART_LIBARTBASE_BASE_NUMA_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+namespace art {
+
+// Minimal NUMA support on top of the Linux system calls and sysfs, as libnuma is not available
+// on all platforms. On other platforms, or when the topology cannot be read, the system is
+// reported as having a single node holding all CPUs.
+
+// Maximum number of NUMA nodes supported, bounded by the node mask passed to mbind(2).
+static constexpr size_t kMaxNumaNodes = 64;
+
+// Return the number of NUMA nodes of the system, which is at least 1.
+size_t GetNumaNodeCount();
+
+// Return the NUMA node of the CPU the calling thread currently runs on, or 0 if unknown.
+size_t GetCurrentNumaNode();
+
+// Return the CPUs of NUMA node `node`, or an empty vector if unknown.
+std::vector<int> GetNumaNodeCpus(size_t node);
+
+// Parse a sysfs CPU or node list such as "0-3,8,10-11". Return false if `list` is malformed.
+bool ParseNumaList(const std::string& list, /*out*/ std::vector<int>* values);
+
+// Ask the kernel to back the pages of [`begin`, `begin` + `size`) with memory of node `node` when
+// they are first touched, falling back to other nodes when `node` is out of memory. Return false
+// and set errno on failure.
+bool SetPreferredNumaNode(void* begin, size_t size, size_t node);
+
+}  // namespace art
+
+#endif  // ART_LIBARTBASE_BASE_NUMA_H_
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "numa.h"
+
+namespace art {
+
+TEST(Numa, ParseNumaList) {
+  std::vector<int> values;
+  ASSERT_TRUE(ParseNumaList("0-3,8,10-11\n", &values));
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 8, 10, 11}), values);
+  ASSERT_TRUE(ParseNumaList("5", &values));
+  EXPECT_EQ(std::vector<int>({5}), values);
+  ASSERT_TRUE(ParseNumaList("\n", &values));
+  EXPECT_TRUE(values.empty());
+  EXPECT_FALSE(ParseNumaList("3-1", &values));
+  EXPECT_FALSE(ParseNumaList("1-2-3", &values));
+  EXPECT_FALSE(ParseNumaList("a", &values));
+  EXPECT_FALSE(ParseNumaList("1,,2", &values));
+}
+
+TEST(Numa, Topology) {
+  size_t node_count = GetNumaNodeCount();
+  ASSERT_GE(node_count, 1u);
+  ASSERT_LE(node_count, kMaxNumaNodes);
+  EXPECT_LT(GetCurrentNumaNode(), node_count);
+}
+
+}  // namespace art
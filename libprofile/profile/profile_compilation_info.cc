@@ -218,8 +218,11 @@ enum class ProfileCompilationInfo::FileSectionType : uint32_t {
   // Methods included in the profile, their hotness flags and inline caches.
   kMethods = 3,
 
+  // How many times each side of the conditional branches of hot methods was taken.
+  kBranchCounts = 4,
+
   // The number of known sections.
-  kNumberOfSections = 4
+  kNumberOfSections = 5
 };
 
 class ProfileCompilationInfo::FileSectionInfo {
@@ -931,6 +934,7 @@ bool ProfileCompilationInfo::Save(int fd) {
   uint64_t dex_files_section_size = sizeof(ProfileIndexType);  // Number of dex files.
   uint64_t classes_section_size = 0u;
   uint64_t methods_section_size = 0u;
+  uint64_t branch_counts_section_size = 0u;
   DCHECK_LE(info_.size(), MaxProfileIndex());
   for (const std::unique_ptr<DexFileData>& dex_data : info_) {
     if (dex_data->profile_key.size() > kMaxDexFileKeyLength) {
@@ -943,13 +947,15 @@ bool ProfileCompilationInfo::Save(int fd) {
         sizeof(uint16_t) + dex_data->profile_key.size();
     classes_section_size += dex_data->ClassesDataSize();
     methods_section_size += dex_data->MethodsDataSize();
+    branch_counts_section_size += dex_data->BranchCountsDataSize();
   }
 
   const uint32_t file_section_count =
       /* dex files */ 1u +
       /* extra descriptors */ (extra_descriptors_section_size != 0u ? 1u : 0u) +
       /* classes */ (classes_section_size != 0u ? 1u : 0u) +
-      /* methods */ (methods_section_size != 0u ? 1u : 0u);
+      /* methods */ (methods_section_size != 0u ? 1u : 0u) +
+      /* branch counts */ (branch_counts_section_size != 0u ? 1u : 0u);
   uint64_t header_and_infos_size =
       sizeof(FileHeader) + file_section_count * sizeof(FileSectionInfo);
 
@@ -960,7 +966,8 @@ bool ProfileCompilationInfo::Save(int fd) {
       dex_files_section_size +
       extra_descriptors_section_size +
       classes_section_size +
-      methods_section_size;
+      methods_section_size +
+      branch_counts_section_size;
   VLOG(profiler) << "Required capacity: " << total_uncompressed_size << " bytes.";
   if (total_uncompressed_size > GetSizeErrorThresholdBytes()) {
     LOG(ERROR) << "Profile data size exceeds "
@@ -1059,6 +1066,21 @@ bool ProfileCompilationInfo::Save(int fd) {
     add_section_info(FileSectionType::kMethods, buffer.Size(), methods_section_size);
   }
 
+  // Write the branch counts section.
+  if (branch_counts_section_size != 0u) {
+    SafeBuffer buffer(branch_counts_section_size);
+    for (const std::unique_ptr<DexFileData>& dex_data : info_) {
+      dex_data->WriteBranchCounts(buffer);
+    }
+    if (!buffer.Deflate()) {
+      return false;
+    }
+    if (!WriteBuffer(fd, buffer.Get(), buffer.Size())) {
+      return false;
+    }
+    add_section_info(FileSectionType::kBranchCounts, buffer.Size(), branch_counts_section_size);
+  }
+
   if (file_offset > GetSizeWarningThresholdBytes()) {
     LOG(WARNING) << "Profile data size exceeds "
         << GetSizeWarningThresholdBytes()
@@ -1270,6 +1292,20 @@ bool ProfileCompilationInfo::AddMethod(const ProfileMethodInfo& pmi,
       }
     }
   }
+
+  // Add branch counts.
+  if (!pmi.branch_counts.empty()) {
+    BranchCountMap* branch_counts = data->FindOrAddBranchCounts(pmi.ref.index);
+    DCHECK(branch_counts != nullptr);
+    for (const ProfileMethodInfo::ProfileBranchCount& count : pmi.branch_counts) {
+      if (count.dex_pc > std::numeric_limits<uint16_t>::max()) {
+        // The dex pc cannot be encoded in the profile.
+        continue;
+      }
+      DexFileData::AddBranchCounts(
+          branch_counts, count.dex_pc, count.false_count, count.true_count);
+    }
+  }
   return true;
 }
 
@@ -1671,6 +1707,41 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::ReadMethodsSec
   return ProfileLoadStatus::kSuccess;
 }
 
+ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::ReadBranchCountsSection(
+    ProfileSource& source,
+    const FileSectionInfo& section_info,
+    const dchecked_vector<ProfileIndexType>& dex_profile_index_remap,
+    /*out*/ std::string* error) {
+  DCHECK(section_info.GetType() == FileSectionType::kBranchCounts);
+  SafeBuffer buffer;
+  ProfileLoadStatus status = ReadSectionData(source, section_info, &buffer, error);
+  if (status != ProfileLoadStatus::kSuccess) {
+    return status;
+  }
+
+  while (buffer.GetAvailableBytes() != 0u) {
+    ProfileIndexType profile_index;
+    if (!buffer.ReadUintAndAdvance(&profile_index)) {
+      *error = "Error profile index in branch counts section.";
+      return ProfileLoadStatus::kBadData;
+    }
+    if (profile_index >= dex_profile_index_remap.size()) {
+      *error = "Invalid profile index in branch counts section.";
+      return ProfileLoadStatus::kBadData;
+    }
+    profile_index = dex_profile_index_remap[profile_index];
+    if (profile_index == MaxProfileIndex()) {
+      status = DexFileData::SkipBranchCounts(buffer, error);
+    } else {
+      status = info_[profile_index]->ReadBranchCounts(buffer, error);
+    }
+    if (status != ProfileLoadStatus::kSuccess) {
+      return status;
+    }
+  }
+  return ProfileLoadStatus::kSuccess;
+}
+
 // TODO(calin): fail fast if the dex checksums don't match.
 ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadInternal(
     int32_t fd,
@@ -1792,6 +1863,12 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadInternal(
               *source, section_info, dex_profile_index_remap, extra_descriptors_remap, error);
         }
         break;
+      case FileSectionType::kBranchCounts:
+        // Skip if all dex files were filtered out.
+        if (!info_.empty()) {
+          status = ReadBranchCountsSection(*source, section_info, dex_profile_index_remap, error);
+        }
+        break;
       default:
         // Unknown section. Skip it. New versions of ART are allowed
         // to add sections that shall be ignored by old versions.
@@ -1929,6 +2006,20 @@ bool ProfileCompilationInfo::MergeWith(const ProfileCompilationInfo& other,
       }
     }
 
+    // Merge the branch counts.
+    for (const auto& other_method_it : other_dex_data->branch_count_map) {
+      BranchCountMap* branch_counts = dex_data->FindOrAddBranchCounts(other_method_it.first);
+      if (branch_counts == nullptr) {
+        return false;
+      }
+      for (const auto& other_branch_it : other_method_it.second) {
+        DexFileData::AddBranchCounts(branch_counts,
+                                     other_branch_it.first,
+                                     other_branch_it.second.false_count,
+                                     other_branch_it.second.true_count);
+      }
+    }
+
     // Merge the method bitmaps.
     dex_data->MergeBitmap(*other_dex_data);
   }
@@ -2246,6 +2337,30 @@ ProfileCompilationInfo::DexFileData::FindOrAddHotMethod(uint16_t method_index) {
       InlineCacheMap(std::less<uint16_t>(), allocator_->Adapter(kArenaAllocProfile)))->second);
 }
 
+ProfileCompilationInfo::BranchCountMap*
+ProfileCompilationInfo::DexFileData::FindOrAddBranchCounts(uint16_t method_index) {
+  if (method_index >= num_method_ids) {
+    LOG(ERROR) << "Invalid method index " << method_index << ". num_method_ids=" << num_method_ids;
+    return nullptr;
+  }
+  return &(branch_count_map.FindOrAdd(
+      method_index,
+      BranchCountMap(std::less<uint16_t>(), allocator_->Adapter(kArenaAllocProfile)))->second);
+}
+
+void ProfileCompilationInfo::DexFileData::AddBranchCounts(BranchCountMap* branch_counts,
+                                                          uint16_t dex_pc,
+                                                          uint16_t false_count,
+                                                          uint16_t true_count) {
+  auto saturating_add = [](uint16_t lhs, uint16_t rhs) {
+    return dchecked_integral_cast<uint16_t>(
+        std::min<uint32_t>(lhs + rhs, std::numeric_limits<uint16_t>::max()));
+  };
+  BranchCounts* counts = &(branch_counts->FindOrAdd(dex_pc, BranchCounts{0u, 0u})->second);
+  counts->false_count = saturating_add(counts->false_count, false_count);
+  counts->true_count = saturating_add(counts->true_count, true_count);
+}
+
 // Mark a method as executed at least once.
 bool ProfileCompilationInfo::DexFileData::AddMethod(MethodHotness::Flag flags, size_t index) {
   if (index >= num_method_ids || index > kMaxSupportedMethodIndex) {
@@ -2303,6 +2418,10 @@ ProfileCompilationInfo::MethodHotness ProfileCompilationInfo::DexFileData::GetHo
     ret.SetInlineCacheMap(&it->second);
     ret.AddFlag(MethodHotness::kFlagHot);
   }
+  auto branch_it = branch_count_map.find(dex_method_index);
+  if (branch_it != branch_count_map.end()) {
+    ret.SetBranchCountMap(&branch_it->second);
+  }
   return ret;
 }
 
@@ -2839,6 +2958,144 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::DexFileData::S
   return ProfileLoadStatus::kSuccess;
 }
 
+uint32_t ProfileCompilationInfo::DexFileData::BranchCountsDataSize() const {
+  if (branch_count_map.empty()) {
+    return 0u;
+  }
+  size_t num_branches = 0u;
+  for (const auto& method_entry : branch_count_map) {
+    num_branches += method_entry.second.size();
+  }
+  constexpr size_t kPerMethodSize =
+      sizeof(uint16_t) +  // Method index diff.
+      sizeof(uint16_t);   // Number of branches.
+  constexpr size_t kPerBranchSize =
+      sizeof(uint16_t) +  // Dex PC.
+      sizeof(uint16_t) +  // False count.
+      sizeof(uint16_t);   // True count.
+  return sizeof(ProfileIndexType) +                  // Which dex file.
+         sizeof(uint32_t) +                          // Total size of following data.
+         branch_count_map.size() * kPerMethodSize +  // Data for methods.
+         num_branches * kPerBranchSize;              // Data for branches.
+}
+
+void ProfileCompilationInfo::DexFileData::WriteBranchCounts(SafeBuffer& buffer) const {
+  uint32_t branch_counts_data_size = BranchCountsDataSize();
+  if (branch_counts_data_size == 0u) {
+    return;  // No data to write.
+  }
+  DCHECK_GE(buffer.GetAvailableBytes(), branch_counts_data_size);
+  uint32_t expected_available_bytes_at_end = buffer.GetAvailableBytes() - branch_counts_data_size;
+
+  // Write the profile index.
+  buffer.WriteUintAndAdvance(profile_index);
+  // Write the total size of the following data (without the profile index
+  // and the total size itself) for easy skipping when the dex file is filtered out.
+  uint32_t following_data_size =
+      branch_counts_data_size - sizeof(ProfileIndexType) - sizeof(uint32_t);
+  buffer.WriteUintAndAdvance(following_data_size);
+
+  uint16_t last_method_index = 0;
+  for (const auto& method_entry : branch_count_map) {
+    // Store the difference between the method indices for better compression.
+    uint16_t method_index = method_entry.first;
+    DCHECK_GE(method_index, last_method_index);
+    buffer.WriteUintAndAdvance(dchecked_integral_cast<uint16_t>(method_index - last_method_index));
+    last_method_index = method_index;
+
+    const BranchCountMap& branch_counts = method_entry.second;
+    buffer.WriteUintAndAdvance(dchecked_integral_cast<uint16_t>(branch_counts.size()));
+    for (const auto& branch_entry : branch_counts) {
+      buffer.WriteUintAndAdvance(branch_entry.first);
+      buffer.WriteUintAndAdvance(branch_entry.second.false_count);
+      buffer.WriteUintAndAdvance(branch_entry.second.true_count);
+    }
+  }
+
+  // Check if we've written the right number of bytes.
+  DCHECK_EQ(buffer.GetAvailableBytes(), expected_available_bytes_at_end);
+}
+
+ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::DexFileData::ReadBranchCounts(
+    SafeBuffer& buffer,
+    std::string* error) {
+  uint32_t following_data_size;
+  if (!buffer.ReadUintAndAdvance(&following_data_size)) {
+    *error = "Error reading branch counts data size.";
+    return ProfileLoadStatus::kBadData;
+  }
+  if (following_data_size > buffer.GetAvailableBytes()) {
+    *error = "Branch counts data size exceeds available data size.";
+    return ProfileLoadStatus::kBadData;
+  }
+  uint32_t expected_available_bytes_at_end = buffer.GetAvailableBytes() - following_data_size;
+
+  uint32_t num_valid_method_indexes =
+      std::min<uint32_t>(kMaxSupportedMethodIndex + 1u, num_method_ids);
+  uint16_t method_index = 0;
+  bool first_diff = true;
+  while (buffer.GetAvailableBytes() > expected_available_bytes_at_end) {
+    uint16_t diff_with_last_method_index;
+    if (!buffer.ReadUintAndAdvance(&diff_with_last_method_index)) {
+      *error = "Error reading branch counts method index diff.";
+      return ProfileLoadStatus::kBadData;
+    }
+    if (diff_with_last_method_index == 0u && !first_diff) {
+      *error = "Duplicate branch counts method index.";
+      return ProfileLoadStatus::kBadData;
+    }
+    first_diff = false;
+    if (diff_with_last_method_index >= num_valid_method_indexes - method_index) {
+      *error = "Invalid branch counts method index.";
+      return ProfileLoadStatus::kBadData;
+    }
+    method_index += diff_with_last_method_index;
+    BranchCountMap* branch_counts = FindOrAddBranchCounts(method_index);
+    DCHECK(branch_counts != nullptr);
+
+    uint16_t num_branches;
+    if (!buffer.ReadUintAndAdvance(&num_branches)) {
+      *error = "Error reading number of branches.";
+      return ProfileLoadStatus::kBadData;
+    }
+    for (uint16_t i = 0; i != num_branches; ++i) {
+      uint16_t dex_pc;
+      uint16_t false_count;
+      uint16_t true_count;
+      if (!buffer.ReadUintAndAdvance(&dex_pc) ||
+          !buffer.ReadUintAndAdvance(&false_count) ||
+          !buffer.ReadUintAndAdvance(&true_count)) {
+        *error = "Error reading branch counts.";
+        return ProfileLoadStatus::kBadData;
+      }
+      AddBranchCounts(branch_counts, dex_pc, false_count, true_count);
+    }
+  }
+
+  if (buffer.GetAvailableBytes() != expected_available_bytes_at_end) {
+    *error = "Branch counts data did not end at expected position.";
+    return ProfileLoadStatus::kBadData;
+  }
+
+  return ProfileLoadStatus::kSuccess;
+}
+
+ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::DexFileData::SkipBranchCounts(
+    SafeBuffer& buffer,
+    std::string* error) {
+  uint32_t following_data_size;
+  if (!buffer.ReadUintAndAdvance(&following_data_size)) {
+    *error = "Error reading branch counts data size to skip.";
+    return ProfileLoadStatus::kBadData;
+  }
+  if (following_data_size > buffer.GetAvailableBytes()) {
+    *error = "Branch counts data size to skip exceeds remaining data.";
+    return ProfileLoadStatus::kBadData;
+  }
+  buffer.Advance(following_data_size);
+  return ProfileLoadStatus::kSuccess;
+}
+
 void ProfileCompilationInfo::DexFileData::WriteClassSet(
     SafeBuffer& buffer,
     const ArenaSet<dex::TypeIndex>& class_set) {
@@ -65,14 +65,34 @@ struct ProfileMethodInfo {
     const bool is_megamorphic;
   };
 
+  struct ProfileBranchCount {
+    ProfileBranchCount(uint32_t pc, uint16_t false_taken, uint16_t true_taken)
+        : dex_pc(pc),
+          false_count(false_taken),
+          true_count(true_taken) {}
+
+    const uint32_t dex_pc;
+    // How many times the false and true successors of the branch were taken.
+    const uint16_t false_count;
+    const uint16_t true_count;
+  };
+
   explicit ProfileMethodInfo(MethodReference reference) : ref(reference) {}
 
   ProfileMethodInfo(MethodReference reference, const std::vector<ProfileInlineCache>& caches)
       : ref(reference),
         inline_caches(caches) {}
 
+  ProfileMethodInfo(MethodReference reference,
+                    const std::vector<ProfileInlineCache>& caches,
+                    const std::vector<ProfileBranchCount>& counts)
+      : ref(reference),
+        inline_caches(caches),
+        branch_counts(counts) {}
+
   MethodReference ref;
   std::vector<ProfileInlineCache> inline_caches;
+  std::vector<ProfileBranchCount> branch_counts;
 };
 
 class FlattenProfileData;
@@ -170,8 +190,25 @@ class ProfileCompilationInfo {
   // Maps a method dex index to its inline cache.
   using MethodMap = ArenaSafeMap<uint16_t, InlineCacheMap>;
 
-  // Profile method hotness information for a single method. Also includes a pointer to the inline
-  // cache map.
+  // How many times each side of a conditional branch was taken. The counts saturate
+  // at the maximum value of uint16_t.
+  struct BranchCounts {
+    bool operator==(const BranchCounts& other) const {
+      return false_count == other.false_count && true_count == other.true_count;
+    }
+
+    uint16_t false_count;
+    uint16_t true_count;
+  };
+
+  // The branch count map: DexPc -> BranchCounts.
+  using BranchCountMap = ArenaSafeMap<uint16_t, BranchCounts>;
+
+  // Maps a method dex index to its branch counts.
+  using MethodBranchCountMap = ArenaSafeMap<uint16_t, BranchCountMap>;
+
+  // Profile method hotness information for a single method. Also includes pointers to the inline
+  // cache map and the branch count map.
   class MethodHotness {
    public:
     enum Flag {
@@ -244,14 +281,24 @@ class ProfileCompilationInfo {
       return inline_cache_map_;
     }
 
+    // Returns the branch counts of the method, or null if none were recorded.
+    const BranchCountMap* GetBranchCountMap() const {
+      return branch_count_map_;
+    }
+
    private:
     const InlineCacheMap* inline_cache_map_ = nullptr;
+    const BranchCountMap* branch_count_map_ = nullptr;
     uint32_t flags_ = 0;
 
     void SetInlineCacheMap(const InlineCacheMap* info) {
       inline_cache_map_ = info;
     }
 
+    void SetBranchCountMap(const BranchCountMap* info) {
+      branch_count_map_ = info;
+    }
+
     friend class ProfileCompilationInfo;
   };
 
@@ -734,6 +781,7 @@ class ProfileCompilationInfo {
           profile_index(index),
           checksum(location_checksum),
           method_map(std::less<uint16_t>(), allocator->Adapter(kArenaAllocProfile)),
+          branch_count_map(std::less<uint16_t>(), allocator->Adapter(kArenaAllocProfile)),
           class_set(std::less<dex::TypeIndex>(), allocator->Adapter(kArenaAllocProfile)),
           num_type_ids(num_types),
           num_method_ids(num_methods),
@@ -765,6 +813,7 @@ class ProfileCompilationInfo {
       return checksum == other.checksum &&
           num_method_ids == other.num_method_ids &&
           method_map == other.method_map &&
+          branch_count_map == other.branch_count_map &&
           class_set == other.class_set &&
           (BitMemoryRegion::Compare(method_bitmap, other.method_bitmap) == 0);
     }
@@ -801,6 +850,11 @@ class ProfileCompilationInfo {
         std::string* error);
     static ProfileLoadStatus SkipMethods(SafeBuffer& buffer, std::string* error);
 
+    uint32_t BranchCountsDataSize() const;
+    void WriteBranchCounts(SafeBuffer& buffer) const;
+    ProfileLoadStatus ReadBranchCounts(SafeBuffer& buffer, std::string* error);
+    static ProfileLoadStatus SkipBranchCounts(SafeBuffer& buffer, std::string* error);
+
     // The allocator used to allocate new inline cache maps.
     ArenaAllocator* const allocator_;
     // The profile key this data belongs to.
@@ -811,12 +865,22 @@ class ProfileCompilationInfo {
     uint32_t checksum;
     // The methods' profile information.
     MethodMap method_map;
+    // The branch counts of the hot methods that have any.
+    MethodBranchCountMap branch_count_map;
     // The classes which have been profiled. Note that these don't necessarily include
     // all the classes that can be found in the inline caches reference.
     ArenaSet<dex::TypeIndex> class_set;
     // Find the inline caches of the the given method index. Add an empty entry if
     // no previous data is found.
     InlineCacheMap* FindOrAddHotMethod(uint16_t method_index);
+    // Find the branch counts of the given method index. Add an empty entry if
+    // no previous data is found.
+    BranchCountMap* FindOrAddBranchCounts(uint16_t method_index);
+    // Add the given counts to the counts of the branch at the given dex pc.
+    static void AddBranchCounts(BranchCountMap* branch_counts,
+                                uint16_t dex_pc,
+                                uint16_t false_count,
+                                uint16_t true_count);
     // Num type ids.
     uint32_t num_type_ids;
     // Num method ids.
@@ -911,6 +975,12 @@ class ProfileCompilationInfo {
       const dchecked_vector<ExtraDescriptorIndex>& extra_descriptors_remap,
       /*out*/ std::string* error);
 
+  ProfileLoadStatus ReadBranchCountsSection(
+      ProfileSource& source,
+      const FileSectionInfo& section_info,
+      const dchecked_vector<ProfileIndexType>& dex_profile_index_remap,
+      /*out*/ std::string* error);
+
   // Entry point for profile loading functionality.
   ProfileLoadStatus LoadInternal(
       int32_t fd,
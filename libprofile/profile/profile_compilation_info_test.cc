@@ -799,6 +799,80 @@ TEST_F(ProfileCompilationInfoTest, MissingTypesInlineCachesMerge) {
   ASSERT_TRUE(info_no_inline_cache.Save(GetFd(profile)));
 }
 
+TEST_F(ProfileCompilationInfoTest, SaveBranchCounts) {
+  std::vector<ProfileBranchCount> branch_counts;
+  branch_counts.push_back(ProfileBranchCount(/*pc=*/ 2, /*false_taken=*/ 10, /*true_taken=*/ 1));
+  branch_counts.push_back(ProfileBranchCount(/*pc=*/ 7, /*false_taken=*/ 0, /*true_taken=*/ 300));
+
+  ProfileCompilationInfo saved_info;
+  ASSERT_TRUE(AddMethod(&saved_info, dex1, /*method_idx=*/ 3, branch_counts));
+  // A hot method without branch counts.
+  ASSERT_TRUE(AddMethod(&saved_info, dex1, /*method_idx=*/ 4));
+
+  ScratchFile profile;
+  ASSERT_TRUE(saved_info.Save(GetFd(profile)));
+  ASSERT_EQ(0, profile.GetFile()->Flush());
+
+  // Check that we get back what we saved.
+  ProfileCompilationInfo loaded_info;
+  ASSERT_TRUE(loaded_info.Load(GetFd(profile)));
+  ASSERT_TRUE(loaded_info.Equals(saved_info));
+
+  ProfileCompilationInfo::MethodHotness loaded_hotness =
+      GetMethod(loaded_info, dex1, /*method_idx=*/ 3);
+  ASSERT_TRUE(loaded_hotness.IsHot());
+  const ProfileCompilationInfo::BranchCountMap* loaded_counts =
+      loaded_hotness.GetBranchCountMap();
+  ASSERT_TRUE(loaded_counts != nullptr);
+  ASSERT_EQ(2u, loaded_counts->size());
+  EXPECT_EQ(10u, loaded_counts->Get(2).false_count);
+  EXPECT_EQ(1u, loaded_counts->Get(2).true_count);
+  EXPECT_EQ(0u, loaded_counts->Get(7).false_count);
+  EXPECT_EQ(300u, loaded_counts->Get(7).true_count);
+
+  ProfileCompilationInfo::MethodHotness loaded_hotness_no_counts =
+      GetMethod(loaded_info, dex1, /*method_idx=*/ 4);
+  ASSERT_TRUE(loaded_hotness_no_counts.IsHot());
+  ASSERT_TRUE(loaded_hotness_no_counts.GetBranchCountMap() == nullptr);
+}
+
+TEST_F(ProfileCompilationInfoTest, MergeBranchCounts) {
+  std::vector<ProfileBranchCount> branch_counts1;
+  branch_counts1.push_back(ProfileBranchCount(/*pc=*/ 2, /*false_taken=*/ 10, /*true_taken=*/ 1));
+  std::vector<ProfileBranchCount> branch_counts2;
+  branch_counts2.push_back(
+      ProfileBranchCount(/*pc=*/ 2, /*false_taken=*/ 65530, /*true_taken=*/ 5));
+  branch_counts2.push_back(ProfileBranchCount(/*pc=*/ 9, /*false_taken=*/ 1, /*true_taken=*/ 1));
+
+  ProfileCompilationInfo info1;
+  ASSERT_TRUE(AddMethod(&info1, dex1, /*method_idx=*/ 3, branch_counts1));
+  ProfileCompilationInfo info2;
+  ASSERT_TRUE(AddMethod(&info2, dex1, /*method_idx=*/ 3, branch_counts2));
+  ASSERT_TRUE(AddMethod(&info2, dex2, /*method_idx=*/ 5, branch_counts2));
+
+  // The counts of the same branch are added up and saturate.
+  ASSERT_TRUE(info1.MergeWith(info2));
+  const ProfileCompilationInfo::BranchCountMap* counts =
+      GetMethod(info1, dex1, /*method_idx=*/ 3).GetBranchCountMap();
+  ASSERT_TRUE(counts != nullptr);
+  ASSERT_EQ(2u, counts->size());
+  EXPECT_EQ(65535u, counts->Get(2).false_count);
+  EXPECT_EQ(6u, counts->Get(2).true_count);
+  EXPECT_EQ(1u, counts->Get(9).false_count);
+  EXPECT_EQ(1u, counts->Get(9).true_count);
+  counts = GetMethod(info1, dex2, /*method_idx=*/ 5).GetBranchCountMap();
+  ASSERT_TRUE(counts != nullptr);
+  ASSERT_EQ(2u, counts->size());
+
+  // The merged counts survive a round trip.
+  ScratchFile profile;
+  ASSERT_TRUE(info1.Save(GetFd(profile)));
+  ASSERT_EQ(0, profile.GetFile()->Flush());
+  ProfileCompilationInfo loaded_info;
+  ASSERT_TRUE(loaded_info.Load(GetFd(profile)));
+  ASSERT_TRUE(loaded_info.Equals(info1));
+}
+
 TEST_F(ProfileCompilationInfoTest, SampledMethodsTest) {
   ProfileCompilationInfo test_info;
   AddMethod(&test_info, dex1, 1, Hotness::kFlagStartup);
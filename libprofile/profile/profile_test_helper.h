@@ -31,6 +31,7 @@ class ProfileTestHelper {
 
   using Hotness = ProfileCompilationInfo::MethodHotness;
   using ProfileInlineCache = ProfileMethodInfo::ProfileInlineCache;
+  using ProfileBranchCount = ProfileMethodInfo::ProfileBranchCount;
   using ProfileSampleAnnotation = ProfileCompilationInfo::ProfileSampleAnnotation;
   using ProfileIndexType = ProfileCompilationInfo::ProfileIndexType;
 
@@ -72,6 +73,18 @@ class ProfileTestHelper {
         ProfileMethodInfo(MethodReference(dex, method_idx), inline_caches), flags, annotation);
   }
 
+  static bool AddMethod(
+      ProfileCompilationInfo* info,
+      const DexFile* dex,
+      uint16_t method_idx,
+      const std::vector<ProfileBranchCount>& branch_counts,
+      const ProfileSampleAnnotation& annotation = ProfileSampleAnnotation::kNone) {
+    return info->AddMethod(
+        ProfileMethodInfo(MethodReference(dex, method_idx), /*caches=*/ {}, branch_counts),
+        Hotness::kFlagHot,
+        annotation);
+  }
+
   static bool AddClass(ProfileCompilationInfo* info,
                        const DexFile* dex,
                        dex::TypeIndex type_index,
@@ -19,8 +19,14 @@
 
 #include "asm_support.h"
 
-// FS0 - FS7, S0, S2 - S9(FP), RA, ArtMethod* and padding total 8*(8 + 9 + 1 + 1 + 1) = 160
-#define FRAME_SIZE_SAVE_ALL_CALLEE_SAVES 160
+// FS0 - FS7, S0, S2 - S8, FP and RA total 8*(8 + 8 + 1 + 1) = 144
+#define CALLEE_SAVES_SIZE (10 * 8 + 8 * 8)
+
+// Callee saves, ArtMethod* and padding total 144 + 16 = 160
+#define FRAME_SIZE_SAVE_ALL_CALLEE_SAVES (CALLEE_SAVES_SIZE + 16)
+
+// S0, S2 - S8, FP, RA, ArtMethod* and padding total 8*(8 + 1 + 1 + 1 + 1) = 96
+#define FRAME_SIZE_SAVE_REFS_ONLY        96
 
 // FA0 - FA7, A1 - A7, S0, S2 - S9(FP) RA and ArtMethod* total 8*(1 + 8 + 7 + 9 + 1) = 208
 // A0 is excluded as the ArtMethod*, and S1 is excluded as the ART thread register TR.
@@ -16,9 +16,15 @@
 
 #include "instruction_set_features_loongarch64.h"
 
+#if defined(ART_TARGET_ANDROID) && defined(__loongarch64)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
 #include <fstream>
 #include <sstream>
 
+#include "android-base/stringprintf.h"
 #include "android-base/strings.h"
 #include "base/logging.h"
 
@@ -29,12 +35,48 @@ constexpr uint32_t BasicFeatures() {
   return Loongarch64InstructionSetFeatures::kExtGeneric;
 }
 
+// Vector extensions are optional, keep them consistent: LASX is only usable with LSX.
+static uint32_t NormalizeVectorFeatures(uint32_t bits) {
+  if ((bits & Loongarch64InstructionSetFeatures::kExtLasx) != 0) {
+    bits |= Loongarch64InstructionSetFeatures::kExtLsx;
+  }
+  return bits;
+}
+
 Loongarch64FeaturesUniquePtr Loongarch64InstructionSetFeatures::FromVariant(
     const std::string& variant, std::string* error_msg ATTRIBUTE_UNUSED) {
-  if (variant != "generic") {
+  // LA464/LA664 cores (Loongson 3A5000/3A6000 and relatives) implement both LSX and LASX,
+  // LA264 cores (Loongson 2K series) only implement LSX.
+  static const char* kLasxVariants[] = {
+      "la464",
+      "la664",
+      "loongson-3a5000",
+      "loongson-3c5000",
+      "loongson-3a6000",
+  };
+  static const char* kLsxVariants[] = {
+      "la264",
+      "loongson-2k1500",
+      "loongson-2k2000",
+  };
+  // LA664 cores share the LA464 instruction set, but the compiler tunes code differently for them.
+  static const char* kLa664Variants[] = {
+      "la664",
+      "loongson-3a6000",
+  };
+
+  uint32_t bits = BasicFeatures();
+  if (FindVariantInArray(kLasxVariants, arraysize(kLasxVariants), variant)) {
+    bits |= kExtLsx | kExtLasx;
+    if (FindVariantInArray(kLa664Variants, arraysize(kLa664Variants), variant)) {
+      bits |= kTuneLa664;
+    }
+  } else if (FindVariantInArray(kLsxVariants, arraysize(kLsxVariants), variant)) {
+    bits |= kExtLsx;
+  } else if (variant != "generic" && variant != "default") {
     LOG(WARNING) << "Unexpected CPU variant for Loongarch64 using defaults: " << variant;
   }
-  return Loongarch64FeaturesUniquePtr(new Loongarch64InstructionSetFeatures(BasicFeatures()));
+  return Loongarch64FeaturesUniquePtr(new Loongarch64InstructionSetFeatures(bits));
 }
 
 Loongarch64FeaturesUniquePtr Loongarch64InstructionSetFeatures::FromBitmap(uint32_t bitmap) {
@@ -42,17 +84,71 @@ Loongarch64FeaturesUniquePtr Loongarch64InstructionSetFeatures::FromBitmap(uint3
 }
 
 Loongarch64FeaturesUniquePtr Loongarch64InstructionSetFeatures::FromCppDefines() {
-  return Loongarch64FeaturesUniquePtr(new Loongarch64InstructionSetFeatures(BasicFeatures()));
+  uint32_t bits = BasicFeatures();
+#if defined(__loongarch_sx)
+  bits |= kExtLsx;
+#endif
+#if defined(__loongarch_asx)
+  bits |= kExtLasx;
+#endif
+  return Loongarch64FeaturesUniquePtr(
+      new Loongarch64InstructionSetFeatures(NormalizeVectorFeatures(bits)));
 }
 
 Loongarch64FeaturesUniquePtr Loongarch64InstructionSetFeatures::FromCpuInfo() {
-  UNIMPLEMENTED(WARNING);
-  return FromCppDefines();
+  // Look in /proc/cpuinfo for the "Features" line, e.g.
+  //   Features        : cpucfg lam ual fpu lsx lasx crc32 complex crypto lvz
+  // and for the "Model Name" line to recognize LA664 cores, e.g.
+  //   Model Name      : Loongson-3A6000
+  uint32_t bits = BasicFeatures();
+
+  std::ifstream in("/proc/cpuinfo");
+  if (!in.fail()) {
+    while (!in.eof()) {
+      std::string line;
+      std::getline(in, line);
+      if (!in.eof() && android::base::StartsWith(line, "Model Name")) {
+        if (line.find("3A6000") != std::string::npos ||
+            line.find("3C6000") != std::string::npos) {
+          bits |= kTuneLa664;
+        }
+      } else if (!in.eof() && android::base::StartsWith(line, "Features")) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+          continue;
+        }
+        for (const std::string& feature : android::base::Split(line.substr(colon + 1), " \t")) {
+          if (feature == "lsx") {
+            bits |= kExtLsx;
+          } else if (feature == "lasx") {
+            bits |= kExtLasx;
+          }
+        }
+      }
+    }
+    in.close();
+  } else {
+    LOG(ERROR) << "Failed to open /proc/cpuinfo";
+  }
+  return Loongarch64FeaturesUniquePtr(
+      new Loongarch64InstructionSetFeatures(NormalizeVectorFeatures(bits)));
 }
 
 Loongarch64FeaturesUniquePtr Loongarch64InstructionSetFeatures::FromHwcap() {
-  UNIMPLEMENTED(WARNING);
-  return FromCppDefines();
+  uint32_t bits = BasicFeatures();
+
+#if defined(ART_TARGET_ANDROID) && defined(__loongarch64)
+  uint64_t hwcaps = getauxval(AT_HWCAP);
+  if ((hwcaps & HWCAP_LOONGARCH_LSX) != 0) {
+    bits |= kExtLsx;
+  }
+  if ((hwcaps & HWCAP_LOONGARCH_LASX) != 0) {
+    bits |= kExtLasx;
+  }
+#endif
+
+  return Loongarch64FeaturesUniquePtr(
+      new Loongarch64InstructionSetFeatures(NormalizeVectorFeatures(bits)));
 }
 
 Loongarch64FeaturesUniquePtr Loongarch64InstructionSetFeatures::FromAssembly() {
@@ -72,6 +168,15 @@ bool Loongarch64InstructionSetFeatures::Equals(const InstructionSetFeatures* oth
   return bits_ == other->AsLoongarch64InstructionSetFeatures()->bits_;
 }
 
+bool Loongarch64InstructionSetFeatures::HasAtLeast(const InstructionSetFeatures* other) const {
+  if (InstructionSet::kLoongarch64 != other->GetInstructionSet()) {
+    return false;
+  }
+  // Tuning does not affect which instructions can be used.
+  uint32_t other_bits = other->AsLoongarch64InstructionSetFeatures()->bits_ & ~kTuneLa664;
+  return (bits_ & other_bits) == other_bits;
+}
+
 uint32_t Loongarch64InstructionSetFeatures::AsBitmap() const { return bits_; }
 
 std::string Loongarch64InstructionSetFeatures::GetFeatureString() const {
@@ -79,15 +184,43 @@ std::string Loongarch64InstructionSetFeatures::GetFeatureString() const {
   if (bits_ & kExtGeneric) {
     result += "g";
   }
+  result += HasLsx() ? ",lsx" : ",-lsx";
+  result += HasLasx() ? ",lasx" : ",-lasx";
+  if (IsLa664()) {
+    result += ",la664";
+  }
   return result;
 }
 
 std::unique_ptr<const InstructionSetFeatures>
 Loongarch64InstructionSetFeatures::AddFeaturesFromSplitString(
-    const std::vector<std::string>& features ATTRIBUTE_UNUSED,
-    std::string* error_msg ATTRIBUTE_UNUSED) const {
-  UNIMPLEMENTED(WARNING);
-  return std::unique_ptr<const InstructionSetFeatures>(new Loongarch64InstructionSetFeatures(bits_));
+    const std::vector<std::string>& features, std::string* error_msg) const {
+  uint32_t bits = bits_;
+  for (const std::string& feature : features) {
+    DCHECK_EQ(android::base::Trim(feature), feature)
+        << "Feature name is not trimmed: '" << feature << "'";
+    if (feature == "la64g") {
+      bits |= kExtGeneric;
+    } else if (feature == "lsx") {
+      bits |= kExtLsx;
+    } else if (feature == "-lsx") {
+      // Without LSX there is no LASX either.
+      bits &= ~(kExtLsx | kExtLasx);
+    } else if (feature == "lasx") {
+      bits |= kExtLsx | kExtLasx;
+    } else if (feature == "-lasx") {
+      bits &= ~kExtLasx;
+    } else if (feature == "la664") {
+      bits |= kTuneLa664;
+    } else if (feature == "-la664") {
+      bits &= ~kTuneLa664;
+    } else {
+      *error_msg = android::base::StringPrintf("Unknown instruction set feature: '%s'",
+                                               feature.c_str());
+      return nullptr;
+    }
+  }
+  return std::unique_ptr<const InstructionSetFeatures>(new Loongarch64InstructionSetFeatures(bits));
 }
 
 }  // namespace art
@@ -30,6 +30,9 @@ class Loongarch64InstructionSetFeatures final : public InstructionSetFeatures {
   // Bitmap positions for encoding features as a bitmap.
   enum {
     kExtGeneric = (1 << 0),     // G extension covers the basic set
+    kExtLsx = (1 << 1),         // 128-bit Loongson SIMD Extension
+    kExtLasx = (1 << 2),        // 256-bit Loongson Advanced SIMD Extension
+    kTuneLa664 = (1 << 3),      // Tune for LA664 cores, does not change the instruction set
   };
 
   static Loongarch64FeaturesUniquePtr FromVariant(const std::string& variant, std::string* error_msg);
@@ -56,12 +59,23 @@ class Loongarch64InstructionSetFeatures final : public InstructionSetFeatures {
 
   bool Equals(const InstructionSetFeatures* other) const override;
 
+  bool HasAtLeast(const InstructionSetFeatures* other) const override;
+
   InstructionSet GetInstructionSet() const override { return InstructionSet::kLoongarch64; }
 
   uint32_t AsBitmap() const override;
 
   std::string GetFeatureString() const override;
 
+  // Is the 128-bit LSX vector extension available?
+  bool HasLsx() const { return (bits_ & kExtLsx) != 0; }
+
+  // Is the 256-bit LASX vector extension available? LASX implies LSX.
+  bool HasLasx() const { return (bits_ & kExtLasx) != 0; }
+
+  // Should code be tuned for LA664 rather than LA464 cores?
+  bool IsLa664() const { return (bits_ & kTuneLa664) != 0; }
+
   virtual ~Loongarch64InstructionSetFeatures() {}
 
  protected:
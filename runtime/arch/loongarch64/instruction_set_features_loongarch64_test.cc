@@ -32,6 +32,90 @@ TEST(Loongarch64InstructionSetFeaturesTest, Loongarch64FeaturesFromDefaultVarian
 
   uint32_t expected_extensions = Loongarch64InstructionSetFeatures::kExtGeneric;
   EXPECT_EQ(loongarch64_features->AsBitmap(), expected_extensions);  // la64g
+  EXPECT_STREQ("la64g,-lsx,-lasx", loongarch64_features->GetFeatureString().c_str());
+}
+
+TEST(Loongarch64InstructionSetFeaturesTest, Loongarch64FeaturesFromVectorVariants) {
+  std::string error_msg;
+  std::unique_ptr<const InstructionSetFeatures> la464_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kLoongarch64, "la464", &error_msg));
+  ASSERT_TRUE(la464_features.get() != nullptr) << error_msg;
+  EXPECT_EQ(la464_features->AsBitmap(),
+            Loongarch64InstructionSetFeatures::kExtGeneric |
+                Loongarch64InstructionSetFeatures::kExtLsx |
+                Loongarch64InstructionSetFeatures::kExtLasx);
+  EXPECT_STREQ("la64g,lsx,lasx", la464_features->GetFeatureString().c_str());
+
+  std::unique_ptr<const InstructionSetFeatures> la264_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kLoongarch64, "la264", &error_msg));
+  ASSERT_TRUE(la264_features.get() != nullptr) << error_msg;
+  EXPECT_TRUE(la264_features->AsLoongarch64InstructionSetFeatures()->HasLsx());
+  EXPECT_FALSE(la264_features->AsLoongarch64InstructionSetFeatures()->HasLasx());
+  EXPECT_STREQ("la64g,lsx,-lasx", la264_features->GetFeatureString().c_str());
+
+  EXPECT_FALSE(la464_features->Equals(la264_features.get()));
+}
+
+TEST(Loongarch64InstructionSetFeaturesTest, Loongarch64FeaturesFromLa664Variant) {
+  std::string error_msg;
+  std::unique_ptr<const InstructionSetFeatures> la664_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kLoongarch64, "la664", &error_msg));
+  ASSERT_TRUE(la664_features.get() != nullptr) << error_msg;
+  EXPECT_TRUE(la664_features->AsLoongarch64InstructionSetFeatures()->IsLa664());
+  EXPECT_STREQ("la64g,lsx,lasx,la664", la664_features->GetFeatureString().c_str());
+
+  std::unique_ptr<const InstructionSetFeatures> la464_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kLoongarch64, "la464", &error_msg));
+  ASSERT_TRUE(la464_features.get() != nullptr) << error_msg;
+  EXPECT_FALSE(la464_features->AsLoongarch64InstructionSetFeatures()->IsLa664());
+
+  // LA664 tuning does not change the instruction set.
+  EXPECT_FALSE(la664_features->Equals(la464_features.get()));
+  EXPECT_TRUE(la664_features->HasAtLeast(la464_features.get()));
+  EXPECT_TRUE(la464_features->HasAtLeast(la664_features.get()));
+
+  std::unique_ptr<const InstructionSetFeatures> la264_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kLoongarch64, "la264", &error_msg));
+  ASSERT_TRUE(la264_features.get() != nullptr) << error_msg;
+  EXPECT_FALSE(la264_features->HasAtLeast(la664_features.get()));
+
+  std::unique_ptr<const InstructionSetFeatures> tuned_features(
+      la464_features->AddFeaturesFromString("la664", &error_msg));
+  ASSERT_TRUE(tuned_features.get() != nullptr) << error_msg;
+  EXPECT_TRUE(tuned_features->Equals(la664_features.get()));
+}
+
+TEST(Loongarch64InstructionSetFeaturesTest, Loongarch64AddFeaturesFromString) {
+  std::string error_msg;
+  std::unique_ptr<const InstructionSetFeatures> base_features(
+      InstructionSetFeatures::FromVariant(InstructionSet::kLoongarch64, "generic", &error_msg));
+  ASSERT_TRUE(base_features.get() != nullptr) << error_msg;
+
+  // LASX implies LSX.
+  std::unique_ptr<const InstructionSetFeatures> lasx_features(
+      base_features->AddFeaturesFromString("lasx", &error_msg));
+  ASSERT_TRUE(lasx_features.get() != nullptr) << error_msg;
+  EXPECT_STREQ("la64g,lsx,lasx", lasx_features->GetFeatureString().c_str());
+
+  // Disabling LSX disables LASX as well.
+  std::unique_ptr<const InstructionSetFeatures> no_lsx_features(
+      lasx_features->AddFeaturesFromString("-lsx", &error_msg));
+  ASSERT_TRUE(no_lsx_features.get() != nullptr) << error_msg;
+  EXPECT_TRUE(no_lsx_features->Equals(base_features.get()));
+
+  std::unique_ptr<const InstructionSetFeatures> lsx_features(
+      lasx_features->AddFeaturesFromString("-lasx", &error_msg));
+  ASSERT_TRUE(lsx_features.get() != nullptr) << error_msg;
+  EXPECT_STREQ("la64g,lsx,-lasx", lsx_features->GetFeatureString().c_str());
+
+  // The feature string round-trips.
+  std::unique_ptr<const InstructionSetFeatures> round_trip_features(
+      base_features->AddFeaturesFromString(lsx_features->GetFeatureString(), &error_msg));
+  ASSERT_TRUE(round_trip_features.get() != nullptr) << error_msg;
+  EXPECT_TRUE(round_trip_features->Equals(lsx_features.get()));
+
+  EXPECT_TRUE(base_features->AddFeaturesFromString("lsx,sve", &error_msg) == nullptr);
+  EXPECT_NE(error_msg.size(), 0u);
 }
 
 }  // namespace art
@@ -77,13 +77,9 @@ inline size_t GetCriticalNativeStubFrameSize(const char* shorty, uint32_t shorty
 
   // We can make a tail call if there are no stack args and we do not need
   // to extend the result. Otherwise, add space for return PC.
-  // if (size != 0u || shorty[0] == 'B' || shorty[0] == 'C' || shorty[0] == 'S' || shorty[0] == 'Z') {
-  //  size += kFramePointerSize;  // We need to spill RA with the args.
-  // }
-
-  // Add return address size.
-  size += kFramePointerSize;
-
+  if (size != 0u || shorty[0] == 'B' || shorty[0] == 'C' || shorty[0] == 'S' || shorty[0] == 'Z') {
+    size += kFramePointerSize;  // We need to spill RA with the args.
+  }
   return RoundUp(size, kLoongarch64StackAlignment);
 }
 
@@ -53,5 +53,14 @@ std::ostream& operator<<(std::ostream& os, const FRegister& rhs) {
   return os;
 }
 
+std::ostream& operator<<(std::ostream& os, const VRegister& rhs) {
+  if (rhs >= VR0 && rhs < kNumberOfVRegisters) {
+    os << "vr" << static_cast<int>(rhs);
+  } else {
+    os << "VRegister[" << static_cast<int>(rhs) << "]";
+  }
+  return os;
+}
+
 }  // namespace loongarch64
 }  // namespace art
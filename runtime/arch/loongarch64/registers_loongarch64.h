@@ -112,6 +112,47 @@ enum FRegister {
 
 std::ostream& operator<<(std::ostream& os, const FRegister& rhs);
 
+// 128-bit LSX vector registers. `VRn` shares its low 64 bits with `FRegister` n,
+// so the register allocator hands out FPU registers for vector values.
+enum VRegister {
+  VR0 = 0,
+  VR1 = 1,
+  VR2 = 2,
+  VR3 = 3,
+  VR4 = 4,
+  VR5 = 5,
+  VR6 = 6,
+  VR7 = 7,
+  VR8 = 8,
+  VR9 = 9,
+  VR10 = 10,
+  VR11 = 11,
+  VR12 = 12,
+  VR13 = 13,
+  VR14 = 14,
+  VR15 = 15,
+  VR16 = 16,
+  VR17 = 17,
+  VR18 = 18,
+  VR19 = 19,
+  VR20 = 20,
+  VR21 = 21,
+  VR22 = 22,
+  VR23 = 23,
+  VR24 = 24,
+  VR25 = 25,
+  VR26 = 26,
+  VR27 = 27,
+  VR28 = 28,
+  VR29 = 29,
+  VR30 = 30,
+  VR31 = 31,
+
+  kNumberOfVRegisters = 32,
+};
+
+std::ostream& operator<<(std::ostream& os, const VRegister& rhs);
+
 }  // namespace loongarch64
 }  // namespace art
 
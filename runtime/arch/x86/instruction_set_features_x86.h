@@ -86,6 +86,8 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
 
   virtual ~X86InstructionSetFeatures() {}
 
+  bool HasSSSE3() const { return has_SSSE3_; }
+
   bool HasSSE4_1() const { return has_SSE4_1_; }
 
   bool HasPopCnt() const { return has_POPCNT_; }
@@ -114,6 +114,12 @@ void CardTable::ClearCardRange(uint8_t* start, uint8_t* end) {
   ZeroAndReleasePages(start_card, end_card - start_card);
 }
 
+bool CardTable::AdviseHugePages(uint8_t* start, uint8_t* end) {
+  uint8_t* start_card = CardFromAddr(start);
+  uint8_t* end_card = CardFromAddr(end);
+  return art::AdviseHugePages(start_card, end_card - start_card, /*enable=*/ true);
+}
+
 bool CardTable::AddrIsInCardTable(const void* addr) const {
   return IsValidCard(biased_begin_ + ((uintptr_t)addr >> kCardShift));
 }
@@ -134,6 +134,9 @@ class CardTable {
   // Clear a range of cards that covers start to end, start and end must be aligned to kCardSize.
   void ClearCardRange(uint8_t* start, uint8_t* end);
 
+  // Back the cards of [start, end) with transparent huge pages. Return false on failure.
+  bool AdviseHugePages(uint8_t* start, uint8_t* end);
+
   // Returns the first address in the heap which maps to this card.
   void* AddrFromCard(const uint8_t *card_addr) const ALWAYS_INLINE;
 
@@ -168,6 +168,10 @@ class SpaceBitmap {
     return bitmap_size_;
   }
 
+  MemMap* GetMemMap() {
+    return &mem_map_;
+  }
+
   // Size in bytes of the memory that the bitmaps spans.
   uint64_t HeapSize() const {
     return IndexToOffset<uint64_t>(Size() / sizeof(intptr_t));
@@ -16,6 +16,7 @@
 
 #include "rosalloc-inl.h"
 
+#include <limits>
 #include <list>
 #include <map>
 #include <sstream>
@@ -27,6 +28,7 @@
 #include "base/memory_tool.h"
 #include "base/mem_map.h"
 #include "base/mutex-inl.h"
+#include "base/time_utils.h"
 #include "gc/space/memory_tool_settings.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
@@ -1981,10 +1983,17 @@ void RosAlloc::Run::Verify(Thread* self, RosAlloc* rosalloc, bool running_on_mem
 
 size_t RosAlloc::ReleasePages() {
   VLOG(heap) << "RosAlloc::ReleasePages()";
+  size_t cursor = 0;
+  size_t reclaimed_bytes = 0;
+  bool done = ReleasePagesUntil(std::numeric_limits<uint64_t>::max(), &cursor, &reclaimed_bytes);
+  DCHECK(done);
+  return reclaimed_bytes;
+}
+
+bool RosAlloc::ReleasePagesUntil(uint64_t deadline_ns, size_t* cursor, size_t* reclaimed_bytes) {
   DCHECK(!DoesReleaseAllPages());
   Thread* self = Thread::Current();
-  size_t reclaimed_bytes = 0;
-  size_t i = 0;
+  size_t i = *cursor;
   // Check the page map size which might have changed due to grow/shrink.
   while (i < page_map_size_) {
     // Reading the page map without a lock is racy but the race is benign since it should only
@@ -2011,11 +2020,16 @@ size_t RosAlloc::ReleasePages() {
             size_t fpr_size = fpr->ByteSize(this);
             DCHECK_ALIGNED(fpr_size, kPageSize);
             uint8_t* start = reinterpret_cast<uint8_t*>(fpr);
-            reclaimed_bytes += ReleasePageRange(start, start + fpr_size);
+            *reclaimed_bytes += ReleasePageRange(start, start + fpr_size);
             size_t pages = fpr_size / kPageSize;
             CHECK_GT(pages, 0U) << "Infinite loop probable";
             i += pages;
             DCHECK_LE(i, page_map_size_);
+            if (NanoTime() >= deadline_ns) {
+              // Out of time, resume from the next page in the next call.
+              *cursor = i;
+              return i >= page_map_size_;
+            }
             break;
           }
         }
@@ -2032,7 +2046,8 @@ size_t RosAlloc::ReleasePages() {
         UNREACHABLE();
     }
   }
-  return reclaimed_bytes;
+  *cursor = i;
+  return true;
 }
 
 size_t RosAlloc::ReleasePageRange(uint8_t* start, uint8_t* end) {
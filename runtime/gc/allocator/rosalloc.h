@@ -887,6 +887,11 @@ class RosAlloc {
 
   // Release empty pages.
   size_t ReleasePages() REQUIRES(!lock_);
+  // Release empty pages, starting at page map index `*cursor`, until the end of the page map is
+  // reached or `deadline_ns` has passed. Updates `*cursor` to the index to resume from and adds
+  // the number of bytes released to `*reclaimed_bytes`. Returns true once the page map is done.
+  bool ReleasePagesUntil(uint64_t deadline_ns, size_t* cursor, size_t* reclaimed_bytes)
+      REQUIRES(!lock_);
   // Returns the current footprint.
   size_t Footprint() REQUIRES(!lock_);
   // Returns the current capacity, maximum footprint.
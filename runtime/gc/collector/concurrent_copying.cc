@@ -45,6 +45,7 @@
 #include "scoped_thread_state_change-inl.h"
 #include "thread-inl.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 #include "well_known_classes.h"
 
 namespace art {
@@ -66,6 +67,9 @@ static constexpr size_t kReadBarrierMarkStackSize = 512 * KB;
 static constexpr size_t kSweepArrayChunkFreeSize = 1024;
 // Verify that there are no missing card marks.
 static constexpr bool kVerifyNoMissingCardMarks = kIsDebugBuild;
+// Minimum number of references on the revoked mark stacks for processing them with helper
+// threads. Below that, waking the helper threads up costs more than it saves.
+static constexpr size_t kMinimumParallelMarkStackSize = 4 * KB;
 
 ConcurrentCopying::ConcurrentCopying(Heap* heap,
                                      bool young_gen,
@@ -87,6 +91,7 @@ ConcurrentCopying::ConcurrentCopying(Heap* heap,
                                                          kReadBarrierMarkStackSize)),
       rb_mark_bit_stack_full_(false),
       mark_stack_lock_("concurrent copying mark stack lock", kMarkSweepMarkStackLock),
+      busy_marking_threads_(0u),
       thread_running_gc_(nullptr),
       is_marking_(false),
       is_using_read_barrier_entrypoints_(false),
@@ -104,6 +109,11 @@ ConcurrentCopying::ConcurrentCopying(Heap* heap,
       reclaimed_bytes_ratio_sum_(0.f),
       cumulative_bytes_moved_(0),
       cumulative_objects_moved_(0),
+      cumulative_mark_stack_objects_(0u),
+      cumulative_mark_stack_time_ns_(0u),
+      cumulative_parallel_mark_stack_objects_(0u),
+      cumulative_parallel_mark_stack_time_ns_(0u),
+      max_parallel_marking_threads_(0u),
       skipped_blocks_lock_("concurrent copying bytes blocks lock", kMarkSweepMarkStackLock),
       measure_read_barrier_slow_path_(measure_read_barrier_slow_path),
       mark_from_read_barrier_measurements_(false),
@@ -1824,17 +1834,7 @@ void ConcurrentCopying::PushOntoMarkStack(Thread* const self, mirror::Object* to
       if (UNLIKELY(tl_mark_stack == nullptr || tl_mark_stack->IsFull())) {
         MutexLock mu(self, mark_stack_lock_);
         // Get a new thread local mark stack.
-        accounting::AtomicStack<mirror::Object>* new_tl_mark_stack;
-        if (!pooled_mark_stacks_.empty()) {
-          // Use a pooled mark stack.
-          new_tl_mark_stack = pooled_mark_stacks_.back();
-          pooled_mark_stacks_.pop_back();
-        } else {
-          // None pooled. Create a new one.
-          new_tl_mark_stack =
-              accounting::AtomicStack<mirror::Object>::Create(
-                  "thread local mark stack", 4 * KB, 4 * KB);
-        }
+        accounting::AtomicStack<mirror::Object>* new_tl_mark_stack = AllocateMarkStackLocked();
         DCHECK(new_tl_mark_stack != nullptr);
         DCHECK(new_tl_mark_stack->IsEmpty());
         new_tl_mark_stack->PushBack(to_ref);
@@ -2077,6 +2077,7 @@ void ConcurrentCopying::ProcessMarkStack() {
   if (kVerboseMode) {
     LOG(INFO) << "ProcessMarkStack. ";
   }
+  const uint64_t start_time = NanoTime();
   bool empty_prev = false;
   while (true) {
     bool empty = ProcessMarkStackOnce();
@@ -2086,6 +2087,7 @@ void ConcurrentCopying::ProcessMarkStack() {
     }
     empty_prev = empty;
   }
+  cumulative_mark_stack_time_ns_ += NanoTime() - start_time;
 }
 
 bool ConcurrentCopying::ProcessMarkStackOnce() {
@@ -2097,12 +2099,17 @@ bool ConcurrentCopying::ProcessMarkStackOnce() {
   MarkStackMode mark_stack_mode = mark_stack_mode_.load(std::memory_order_relaxed);
   if (mark_stack_mode == kMarkStackModeThreadLocal) {
     // Process the thread-local mark stacks and the GC mark stack.
-    count += ProcessThreadLocalMarkStacks(/* disable_weak_ref_access= */ false,
-                                          /* checkpoint_callback= */ nullptr,
-                                          [this] (mirror::Object* ref)
-                                              REQUIRES_SHARED(Locks::mutator_lock_) {
-                                            ProcessMarkStackRef(ref);
-                                          });
+    const size_t thread_count = GetParallelMarkingThreadCount();
+    if (thread_count != 0u) {
+      count += ProcessMarkStackParallel(thread_count);
+    } else {
+      count += ProcessThreadLocalMarkStacks(/* disable_weak_ref_access= */ false,
+                                            /* checkpoint_callback= */ nullptr,
+                                            [this] (mirror::Object* ref)
+                                                REQUIRES_SHARED(Locks::mutator_lock_) {
+                                              ProcessMarkStackRef(ref);
+                                            });
+    }
     while (!gc_mark_stack_->IsEmpty()) {
       mirror::Object* to_ref = gc_mark_stack_->PopBack();
       ProcessMarkStackRef(to_ref);
@@ -2156,6 +2163,7 @@ bool ConcurrentCopying::ProcessMarkStackOnce() {
     gc_mark_stack_->Reset();
   }
 
+  cumulative_mark_stack_objects_ += count;
   // Return true if the stack was empty.
   return count == 0;
 }
@@ -2170,6 +2178,17 @@ size_t ConcurrentCopying::ProcessThreadLocalMarkStacks(bool disable_weak_ref_acc
     CHECK_EQ(static_cast<uint32_t>(mark_stack_mode_.load(std::memory_order_relaxed)),
              static_cast<uint32_t>(kMarkStackModeShared));
   }
+  size_t count = ProcessRevokedMarkStacks(processor);
+  if (disable_weak_ref_access) {
+    MutexLock mu(thread_running_gc_, mark_stack_lock_);
+    CHECK(revoked_mark_stacks_.empty());
+    CHECK_EQ(pooled_mark_stacks_.size(), kMarkStackPoolSize);
+  }
+  return count;
+}
+
+template <typename Processor>
+size_t ConcurrentCopying::ProcessRevokedMarkStacks(const Processor& processor) {
   size_t count = 0;
   std::vector<accounting::AtomicStack<mirror::Object>*> mark_stacks;
   {
@@ -2186,25 +2205,205 @@ size_t ConcurrentCopying::ProcessThreadLocalMarkStacks(bool disable_weak_ref_acc
     }
     {
       MutexLock mu(thread_running_gc_, mark_stack_lock_);
-      if (pooled_mark_stacks_.size() >= kMarkStackPoolSize) {
-        // The pool has enough. Delete it.
-        delete mark_stack;
-      } else {
-        // Otherwise, put it into the pool for later reuse.
-        mark_stack->Reset();
-        pooled_mark_stacks_.push_back(mark_stack);
+      RecycleMarkStackLocked(mark_stack);
+    }
+  }
+  return count;
+}
+
+void ConcurrentCopying::RecycleMarkStackLocked(accounting::ObjectStack* mark_stack) {
+  if (pooled_mark_stacks_.size() >= kMarkStackPoolSize) {
+    // The pool has enough. Delete it.
+    delete mark_stack;
+  } else {
+    // Otherwise, put it into the pool for later reuse.
+    mark_stack->Reset();
+    pooled_mark_stacks_.push_back(mark_stack);
+  }
+}
+
+accounting::ObjectStack* ConcurrentCopying::AllocateMarkStackLocked() {
+  if (!pooled_mark_stacks_.empty()) {
+    // Use a pooled mark stack.
+    accounting::ObjectStack* mark_stack = pooled_mark_stacks_.back();
+    pooled_mark_stacks_.pop_back();
+    return mark_stack;
+  }
+  // None pooled. Create a new one.
+  return accounting::ObjectStack::Create("thread local mark stack", 4 * KB, 4 * KB);
+}
+
+// Processes revoked mark stacks on a heap thread pool worker, alongside the other helper threads,
+// until none of them has a mark stack left. The references found go to the worker's thread-local
+// mark stack, like those found by mutators, and the worker revokes it after each mark stack so
+// that idle helper threads can take it.
+class ConcurrentCopying::ParallelMarkStackTask : public Task {
+ public:
+  explicit ParallelMarkStackTask(ConcurrentCopying* collector)
+      : collector_(collector),
+        objects_processed_(0u),
+        bytes_scanned_(0u),
+        live_bytes_region_(static_cast<size_t>(-1)) {}
+
+  // No thread safety analysis: the GC-running thread holds the mutator lock on behalf of the
+  // helper threads while it waits for them.
+  void Run(Thread* self) override NO_THREAD_SAFETY_ANALYSIS {
+    bool idle = false;
+    while (true) {
+      accounting::ObjectStack* mark_stack = nullptr;
+      {
+        MutexLock mu(self, collector_->mark_stack_lock_);
+        if (!collector_->revoked_mark_stacks_.empty()) {
+          mark_stack = collector_->revoked_mark_stacks_.back();
+          collector_->revoked_mark_stacks_.pop_back();
+          if (idle) {
+            idle = false;
+            ++collector_->busy_marking_threads_;
+          }
+        } else {
+          if (!idle) {
+            idle = true;
+            --collector_->busy_marking_threads_;
+          }
+          if (collector_->busy_marking_threads_ == 0u) {
+            // Busy helper threads revoke their thread-local mark stack before becoming idle, so
+            // no more mark stacks are coming from the helper threads.
+            break;
+          }
+        }
+      }
+      if (mark_stack == nullptr) {
+        sched_yield();
+        continue;
+      }
+      for (StackReference<mirror::Object>* p = mark_stack->Begin(); p != mark_stack->End(); ++p) {
+        collector_->ProcessMarkStackRef</*kFromGCThread=*/ false>(p->AsMirrorPtr(), this);
+        ++objects_processed_;
       }
+      {
+        MutexLock mu(self, collector_->mark_stack_lock_);
+        collector_->RecycleMarkStackLocked(mark_stack);
+      }
+      collector_->RevokeThreadLocalMarkStack(self);
     }
   }
-  if (disable_weak_ref_access) {
-    MutexLock mu(thread_running_gc_, mark_stack_lock_);
-    CHECK(revoked_mark_stacks_.empty());
-    CHECK_EQ(pooled_mark_stacks_.size(), kMarkStackPoolSize);
+
+  void AddBytesScanned(size_t bytes) {
+    bytes_scanned_ += bytes;
+  }
+
+  // Record live bytes of an unevacuated from-space region. Region::AddLiveBytes() is not
+  // thread-safe, so the GC-running thread adds them once the helper threads are done.
+  void AddLiveBytes(mirror::Object* ref, size_t bytes) {
+    size_t region = collector_->region_space_->RegionIdxForRefUnchecked(ref);
+    if (region == live_bytes_region_) {
+      live_bytes_.back().second += bytes;
+    } else {
+      live_bytes_.emplace_back(ref, bytes);
+      live_bytes_region_ = region;
+    }
+  }
+
+  void ApplyLiveBytes() {
+    for (const std::pair<mirror::Object*, size_t>& entry : live_bytes_) {
+      collector_->region_space_->AddLiveBytes(entry.first, entry.second);
+    }
+    live_bytes_.clear();
+  }
+
+  size_t GetObjectsProcessed() const {
+    return objects_processed_;
+  }
+
+  uint64_t GetBytesScanned() const {
+    return bytes_scanned_;
+  }
+
+ private:
+  ConcurrentCopying* const collector_;
+  size_t objects_processed_;
+  uint64_t bytes_scanned_;
+  // Live bytes to add, merged per region for consecutive objects of the same region.
+  std::vector<std::pair<mirror::Object*, size_t>> live_bytes_;
+  size_t live_bytes_region_;
+};
+
+size_t ConcurrentCopying::GetParallelMarkingThreadCount() const {
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  // Like MarkSweep, leave the CPU time to the foreground apps when in a background state.
+  if (thread_pool == nullptr || !Runtime::Current()->InJankPerceptibleProcessState()) {
+    return 0u;
+  }
+  return std::min(heap_->GetConcGCThreadCount(), thread_pool->GetThreadCount());
+}
+
+size_t ConcurrentCopying::ProcessMarkStackParallel(size_t thread_count) {
+  Thread* const self = Thread::Current();
+  DCHECK_EQ(self, thread_running_gc_);
+  RevokeThreadLocalMarkStacks(/* disable_weak_ref_access= */ false,
+                              /* checkpoint_callback= */ nullptr);
+  size_t num_refs = 0u;
+  {
+    MutexLock mu(self, mark_stack_lock_);
+    // Hand out the GC mark stack too, in chunks of the size of a thread-local mark stack.
+    StackReference<mirror::Object>* p = gc_mark_stack_->Begin();
+    while (p != gc_mark_stack_->End()) {
+      accounting::ObjectStack* mark_stack = AllocateMarkStackLocked();
+      DCHECK(mark_stack->IsEmpty());
+      for (; p != gc_mark_stack_->End() && !mark_stack->IsFull(); ++p) {
+        mark_stack->PushBack(p->AsMirrorPtr());
+      }
+      revoked_mark_stacks_.push_back(mark_stack);
+    }
+    gc_mark_stack_->Reset();
+    for (accounting::ObjectStack* mark_stack : revoked_mark_stacks_) {
+      num_refs += mark_stack->Size();
+    }
+  }
+  if (num_refs < kMinimumParallelMarkStackSize) {
+    return ProcessRevokedMarkStacks([this] (mirror::Object* ref)
+                                        REQUIRES_SHARED(Locks::mutator_lock_) {
+                                      ProcessMarkStackRef(ref);
+                                    });
+  }
+
+  TimingLogger::ScopedTiming split("ProcessMarkStackParallel", GetTimings());
+  const uint64_t start_time = NanoTime();
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  {
+    MutexLock mu(self, mark_stack_lock_);
+    busy_marking_threads_ = thread_count;
+  }
+  std::vector<std::unique_ptr<ParallelMarkStackTask>> tasks;
+  for (size_t i = 0; i != thread_count; ++i) {
+    tasks.emplace_back(new ParallelMarkStackTask(this));
+    thread_pool->AddTask(self, tasks.back().get());
+  }
+  thread_pool->SetMaxActiveWorkers(thread_count);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /* do_work= */ false, /* may_hold_locks= */ true);
+  thread_pool->StopWorkers(self);
+
+  size_t count = 0u;
+  for (const std::unique_ptr<ParallelMarkStackTask>& task : tasks) {
+    count += task->GetObjectsProcessed();
+    bytes_scanned_ += task->GetBytesScanned();
+    task->ApplyLiveBytes();
+  }
+  cumulative_parallel_mark_stack_objects_ += count;
+  cumulative_parallel_mark_stack_time_ns_ += NanoTime() - start_time;
+  max_parallel_marking_threads_ = std::max(max_parallel_marking_threads_, thread_count);
+  if (kVerboseMode) {
+    LOG(INFO) << "ProcessMarkStackParallel: " << count << " refs with " << thread_count
+              << " helper threads";
   }
   return count;
 }
 
-inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
+template <bool kFromGCThread>
+inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref,
+                                                   ParallelMarkStackTask* task) {
+  DCHECK_EQ(kFromGCThread, task == nullptr);
   DCHECK(!region_space_->IsInFromSpace(to_ref));
   size_t obj_size = 0;
   space::RegionSpace::RegionType rtype = region_space_->GetRegionType(to_ref);
@@ -2227,8 +2426,11 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
   bool perform_scan = false;
   switch (rtype) {
     case space::RegionSpace::RegionType::kRegionTypeUnevacFromSpace:
-      // Mark the bitmap only in the GC thread here so that we don't need a CAS.
-      if (!kUseBakerReadBarrier || !region_space_bitmap_->Set(to_ref)) {
+      // Mark the bitmap only in the GC thread here so that we don't need a CAS. Helper threads
+      // race with each other and need it.
+      if (!kUseBakerReadBarrier ||
+          !(kFromGCThread ? region_space_bitmap_->Set(to_ref)
+                          : region_space_bitmap_->AtomicTestAndSet(to_ref))) {
         // It may be already marked if we accidentally pushed the same object twice due to the racy
         // bitmap read in MarkUnevacFromSpaceRegion.
         if (use_generational_cc_ && young_gen_) {
@@ -2250,7 +2452,11 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
     case space::RegionSpace::RegionType::kRegionTypeToSpace:
       if (use_generational_cc_) {
         // Copied to to-space, set the bit so that the next GC can scan objects.
-        region_space_bitmap_->Set(to_ref);
+        if (kFromGCThread) {
+          region_space_bitmap_->Set(to_ref);
+        } else {
+          region_space_bitmap_->AtomicTestAndSet(to_ref);
+        }
       }
       perform_scan = true;
       break;
@@ -2280,13 +2486,14 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
           accounting::LargeObjectBitmap* los_bitmap =
               heap_->GetLargeObjectsSpace()->GetMarkBitmap();
           DCHECK(los_bitmap->HasAddress(to_ref));
-          // Only the GC thread could be setting the LOS bit map hence doesn't
-          // need to be atomically done.
-          perform_scan = !los_bitmap->Set(to_ref);
+          // Only the GC thread or its helper threads could be setting the LOS bit map hence
+          // it needs to be atomically done only with helper threads.
+          perform_scan = kFromGCThread ? !los_bitmap->Set(to_ref)
+                                       : !los_bitmap->AtomicTestAndSet(to_ref);
         } else {
-          // Only the GC thread could be setting the non-moving space bit map
-          // hence doesn't need to be atomically done.
-          perform_scan = !mark_bitmap->Set(to_ref);
+          // Same for the non-moving space bit map.
+          perform_scan = kFromGCThread ? !mark_bitmap->Set(to_ref)
+                                       : !mark_bitmap->AtomicTestAndSet(to_ref);
         }
       } else {
         perform_scan = true;
@@ -2295,9 +2502,12 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
   if (perform_scan) {
     obj_size = to_ref->SizeOf<kDefaultVerifyFlags>();
     if (use_generational_cc_ && young_gen_) {
-      Scan<true>(to_ref, obj_size);
+      Scan</*kNoUnEvac=*/ true, kFromGCThread>(to_ref, obj_size);
     } else {
-      Scan<false>(to_ref, obj_size);
+      Scan</*kNoUnEvac=*/ false, kFromGCThread>(to_ref, obj_size);
+    }
+    if (!kFromGCThread) {
+      task->AddBytesScanned(obj_size);
     }
   }
   if (kUseBakerReadBarrier) {
@@ -2339,12 +2549,17 @@ inline void ConcurrentCopying::ProcessMarkStackRef(mirror::Object* to_ref) {
 
   if (add_to_live_bytes) {
     // Add to the live bytes per unevacuated from-space. Note this code is always run by the
-    // GC-running thread (no synchronization required).
+    // GC-running thread (no synchronization required), helper threads leave it to the GC-running
+    // thread through their task.
     DCHECK(region_space_bitmap_->Test(to_ref));
     if (obj_size == 0) {
       obj_size = to_ref->SizeOf<kDefaultVerifyFlags>();
     }
-    region_space_->AddLiveBytes(to_ref, RoundUp(obj_size, space::RegionSpace::kAlignment));
+    if (kFromGCThread) {
+      region_space_->AddLiveBytes(to_ref, RoundUp(obj_size, space::RegionSpace::kAlignment));
+    } else {
+      task->AddLiveBytes(to_ref, RoundUp(obj_size, space::RegionSpace::kAlignment));
+    }
   }
   if (ReadBarrier::kEnableToSpaceInvariantChecks) {
     CHECK(to_ref != nullptr);
@@ -3108,7 +3323,7 @@ void ConcurrentCopying::AssertToSpaceInvariantInNonMovingSpace(mirror::Object* o
 }
 
 // Used to scan ref fields of an object.
-template <bool kNoUnEvac>
+template <bool kNoUnEvac, bool kFromGCThread>
 class ConcurrentCopying::RefFieldsVisitor {
  public:
   explicit RefFieldsVisitor(ConcurrentCopying* collector, Thread* const thread)
@@ -3120,7 +3335,7 @@ class ConcurrentCopying::RefFieldsVisitor {
   void operator()(mirror::Object* obj, MemberOffset offset, bool /* is_static */)
       const ALWAYS_INLINE REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES_SHARED(Locks::heap_bitmap_lock_) {
-    collector_->Process<kNoUnEvac>(obj, offset);
+    collector_->Process<kNoUnEvac, kFromGCThread>(thread_, obj, offset);
   }
 
   void operator()(ObjPtr<mirror::Class> klass, ObjPtr<mirror::Reference> ref) const
@@ -3140,7 +3355,8 @@ class ConcurrentCopying::RefFieldsVisitor {
   void VisitRoot(mirror::CompressedReference<mirror::Object>* root) const
       ALWAYS_INLINE
       REQUIRES_SHARED(Locks::mutator_lock_) {
-    collector_->MarkRoot</*kGrayImmuneObject=*/false>(thread_, root);
+    // Helper threads may see immune objects that have not been grayed by the GC-running thread.
+    collector_->MarkRoot</*kGrayImmuneObject=*/ !kFromGCThread>(thread_, root);
   }
 
  private:
@@ -3148,10 +3364,11 @@ class ConcurrentCopying::RefFieldsVisitor {
   Thread* const thread_;
 };
 
-template <bool kNoUnEvac>
+template <bool kNoUnEvac, bool kFromGCThread>
 inline void ConcurrentCopying::Scan(mirror::Object* to_ref, size_t obj_size) {
   // Cannot have `kNoUnEvac` when Generational CC collection is disabled.
   DCHECK(!kNoUnEvac || use_generational_cc_);
+  Thread* const self = kFromGCThread ? thread_running_gc_ : Thread::Current();
   if (kDisallowReadBarrierDuringScan && !Runtime::Current()->IsActiveTransaction()) {
     // Avoid all read barriers during visit references to help performance.
     // Don't do this in transaction mode because we may read the old value of an field which may
@@ -3161,28 +3378,34 @@ inline void ConcurrentCopying::Scan(mirror::Object* to_ref, size_t obj_size) {
   if (obj_size == 0) {
     obj_size = to_ref->SizeOf<kDefaultVerifyFlags>();
   }
-  bytes_scanned_ += obj_size;
+  if (kFromGCThread) {
+    // Helper threads count the scanned bytes in their task.
+    bytes_scanned_ += obj_size;
+  }
 
   DCHECK(!region_space_->IsInFromSpace(to_ref));
-  DCHECK_EQ(Thread::Current(), thread_running_gc_);
-  RefFieldsVisitor<kNoUnEvac> visitor(this, thread_running_gc_);
+  DCHECK_EQ(Thread::Current() == thread_running_gc_, kFromGCThread);
+  RefFieldsVisitor<kNoUnEvac, kFromGCThread> visitor(this, self);
   // Disable the read barrier for a performance reason.
   to_ref->VisitReferences</*kVisitNativeRoots=*/true, kDefaultVerifyFlags, kWithoutReadBarrier>(
       visitor, visitor);
   if (kDisallowReadBarrierDuringScan && !Runtime::Current()->IsActiveTransaction()) {
-    thread_running_gc_->ModifyDebugDisallowReadBarrier(-1);
+    self->ModifyDebugDisallowReadBarrier(-1);
   }
 }
 
-template <bool kNoUnEvac>
-inline void ConcurrentCopying::Process(mirror::Object* obj, MemberOffset offset) {
+template <bool kNoUnEvac, bool kFromGCThread>
+inline void ConcurrentCopying::Process(Thread* const self, mirror::Object* obj,
+                                       MemberOffset offset) {
   // Cannot have `kNoUnEvac` when Generational CC collection is disabled.
   DCHECK(!kNoUnEvac || use_generational_cc_);
-  DCHECK_EQ(Thread::Current(), thread_running_gc_);
+  DCHECK_EQ(Thread::Current(), self);
+  // Helper threads mark like mutators, as they may see immune objects that have not been grayed
+  // by the GC-running thread yet.
   mirror::Object* ref = obj->GetFieldObject<
       mirror::Object, kVerifyNone, kWithoutReadBarrier, false>(offset);
-  mirror::Object* to_ref = Mark</*kGrayImmuneObject=*/false, kNoUnEvac, /*kFromGCThread=*/true>(
-      thread_running_gc_,
+  mirror::Object* to_ref = Mark</*kGrayImmuneObject=*/ !kFromGCThread, kNoUnEvac, kFromGCThread>(
+      self,
       ref,
       /*holder=*/ obj,
       offset);
@@ -3862,6 +4085,19 @@ void ConcurrentCopying::DumpPerformanceInfo(std::ostream& os) {
 
   os << "Cumulative bytes moved " << cumulative_bytes_moved_ << "\n";
   os << "Cumulative objects moved " << cumulative_objects_moved_ << "\n";
+  if (cumulative_mark_stack_time_ns_ != 0u) {
+    os << "Mark stack objects processed " << cumulative_mark_stack_objects_ << " in "
+       << PrettyDuration(cumulative_mark_stack_time_ns_) << " ("
+       << cumulative_mark_stack_objects_ * UINT64_C(1000000000) / cumulative_mark_stack_time_ns_
+       << " objects/s)\n";
+  }
+  if (cumulative_parallel_mark_stack_time_ns_ != 0u) {
+    os << "Parallel mark stack objects processed " << cumulative_parallel_mark_stack_objects_
+       << " in " << PrettyDuration(cumulative_parallel_mark_stack_time_ns_) << " ("
+       << cumulative_parallel_mark_stack_objects_ * UINT64_C(1000000000) /
+              cumulative_parallel_mark_stack_time_ns_
+       << " objects/s) with up to " << max_parallel_marking_threads_ << " helper threads\n";
+  }
 
   os << "Peak regions allocated "
      << region_space_->GetMaxPeakNumNonFreeRegions() << " ("
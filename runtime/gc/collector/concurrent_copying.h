@@ -163,6 +163,8 @@ class ConcurrentCopying : public GarbageCollector {
   void AssertNoThreadMarkStackMapping(Thread* thread) REQUIRES(!mark_stack_lock_);
 
  private:
+  class ParallelMarkStackTask;
+
   void PushOntoMarkStack(Thread* const self, mirror::Object* obj)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
@@ -175,8 +177,9 @@ class ConcurrentCopying : public GarbageCollector {
                        MemberOffset offset)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_, !skipped_blocks_lock_, !immune_gray_stack_lock_);
-  // Scan the reference fields of object `to_ref`.
-  template <bool kNoUnEvac>
+  // Scan the reference fields of object `to_ref`. Helper threads marking in parallel with the
+  // GC-running thread (see ProcessMarkStackParallel) pass `kFromGCThread` = false.
+  template <bool kNoUnEvac, bool kFromGCThread = true>
   void Scan(mirror::Object* to_ref, size_t obj_size = 0) REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
   // Scan the reference fields of object 'obj' in the dirty cards during
@@ -187,8 +190,8 @@ class ConcurrentCopying : public GarbageCollector {
   void ScanDirtyObject(mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
   // Process a field.
-  template <bool kNoUnEvac>
-  void Process(mirror::Object* obj, MemberOffset offset)
+  template <bool kNoUnEvac, bool kFromGCThread = true>
+  void Process(Thread* const self, mirror::Object* obj, MemberOffset offset)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_ , !skipped_blocks_lock_, !immune_gray_stack_lock_);
   void VisitRoots(mirror::Object*** roots, size_t count, const RootInfo& info) override
@@ -209,8 +212,21 @@ class ConcurrentCopying : public GarbageCollector {
   void ProcessMarkStack() override REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
   bool ProcessMarkStackOnce() REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!mark_stack_lock_);
-  void ProcessMarkStackRef(mirror::Object* to_ref) REQUIRES_SHARED(Locks::mutator_lock_)
+  // Process a reference popped off a mark stack. Helper threads pass `kFromGCThread` = false and
+  // the task they run, which collects the live bytes they find.
+  template <bool kFromGCThread = true>
+  void ProcessMarkStackRef(mirror::Object* to_ref, ParallelMarkStackTask* task = nullptr)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!mark_stack_lock_);
+  // Number of heap thread pool workers that help process the thread-local mark stacks, or zero
+  // if the GC-running thread processes them alone.
+  size_t GetParallelMarkingThreadCount() const;
+  // Revoke the thread-local mark stacks and process them, together with the GC mark stack, with
+  // `thread_count` helper threads. Returns the number of references processed.
+  size_t ProcessMarkStackParallel(size_t thread_count) REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
+  // Put an emptied mark stack back into the pool, or delete it if the pool is full.
+  void RecycleMarkStackLocked(accounting::ObjectStack* mark_stack) REQUIRES(mark_stack_lock_);
+  accounting::ObjectStack* AllocateMarkStackLocked() REQUIRES(mark_stack_lock_);
   void GrayAllDirtyImmuneObjects()
       REQUIRES(Locks::mutator_lock_)
       REQUIRES(!mark_stack_lock_);
@@ -228,6 +244,10 @@ class ConcurrentCopying : public GarbageCollector {
                                       Closure* checkpoint_callback,
                                       const Processor& processor)
       REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!mark_stack_lock_);
+  // Process the mark stacks already in `revoked_mark_stacks_`.
+  template <typename Processor>
+  size_t ProcessRevokedMarkStacks(const Processor& processor)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!mark_stack_lock_);
   void RevokeThreadLocalMarkStacks(bool disable_weak_ref_access, Closure* checkpoint_callback)
       REQUIRES_SHARED(Locks::mutator_lock_);
   void SwitchToSharedMarkStackMode() REQUIRES_SHARED(Locks::mutator_lock_)
@@ -379,6 +399,8 @@ class ConcurrentCopying : public GarbageCollector {
   static constexpr size_t kMarkStackPoolSize = 256;
   std::vector<accounting::ObjectStack*> pooled_mark_stacks_
       GUARDED_BY(mark_stack_lock_);
+  // Number of helper threads currently processing a mark stack in ProcessMarkStackParallel.
+  size_t busy_marking_threads_ GUARDED_BY(mark_stack_lock_);
   Thread* thread_running_gc_;
   bool is_marking_;                       // True while marking is ongoing.
   // True while we might dispatch on the read barrier entrypoints.
@@ -441,6 +463,14 @@ class ConcurrentCopying : public GarbageCollector {
   uint64_t cumulative_bytes_moved_;
   uint64_t cumulative_objects_moved_;
 
+  // Mark stack processing throughput, over all GC cycles. The parallel counters cover the
+  // ProcessMarkStackParallel calls, which the totals include.
+  uint64_t cumulative_mark_stack_objects_;
+  uint64_t cumulative_mark_stack_time_ns_;
+  uint64_t cumulative_parallel_mark_stack_objects_;
+  uint64_t cumulative_parallel_mark_stack_time_ns_;
+  size_t max_parallel_marking_threads_;
+
   // The skipped blocks are memory blocks/chucks that were copies of
   // objects that were unused due to lost races (cas failures) at
   // object copy/forward pointer install. They may be reused.
@@ -500,7 +530,7 @@ class ConcurrentCopying : public GarbageCollector {
   template <bool kConcurrent> class GrayImmuneObjectVisitor;
   class ImmuneSpaceScanObjVisitor;
   class LostCopyVisitor;
-  template <bool kNoUnEvac> class RefFieldsVisitor;
+  template <bool kNoUnEvac, bool kFromGCThread = true> class RefFieldsVisitor;
   class RevokeThreadLocalMarkStackCheckpoint;
   class ScopedGcGraysImmuneObjects;
   class ThreadFlipVisitor;
@@ -0,0 +1,1055 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mark_compact.h"
+
+#include <fcntl.h>
+#include <linux/userfaultfd.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "base/bit_utils.h"
+#include "base/logging.h"  // For VLOG.
+#include "base/mutex-inl.h"
+#include "base/timing_logger.h"
+#include "base/utils.h"
+#include "class_linker.h"
+#include "gc/accounting/atomic_stack.h"
+#include "gc/accounting/heap_bitmap-inl.h"
+#include "gc/accounting/mod_union_table.h"
+#include "gc/accounting/space_bitmap-inl.h"
+#include "gc/heap.h"
+#include "gc/reference_processor.h"
+#include "gc/space/bump_pointer_space.h"
+#include "gc/space/image_space.h"
+#include "gc/space/large_object_space.h"
+#include "gc/space/space-inl.h"
+#include "mirror/array-inl.h"
+#include "mirror/object-inl.h"
+#include "mirror/object-refvisitor-inl.h"
+#include "mirror/reference-inl.h"
+#include "runtime.h"
+#include "sigchain.h"
+#include "thread-inl.h"
+#include "thread_list.h"
+
+using ::art::mirror::Object;
+
+namespace art {
+namespace gc {
+namespace collector {
+
+// Amount of from-space that the GC thread lets accumulate before releasing it to the kernel
+// during the concurrent compaction.
+static constexpr size_t kFromSpaceReleaseBatchSize = 256 * KB;
+
+static bool HandleSigbus(int sig ATTRIBUTE_UNUSED,
+                         siginfo_t* info,
+                         void* context ATTRIBUTE_UNUSED) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  // The handler is installed while the heap is being created.
+  MarkCompact* collector = heap != nullptr ? heap->MarkCompactCollector() : nullptr;
+  return collector != nullptr && collector->SigbusHandler(info);
+}
+
+MarkCompact::MarkCompact(Heap* heap)
+    : GarbageCollector(heap, "concurrent mark compact"),
+      mark_stack_(nullptr),
+      mark_bitmap_(nullptr),
+      self_(nullptr),
+      moving_space_(heap->bump_pointer_space_),
+      moving_space_begin_(moving_space_->Begin()),
+      pre_compact_end_(moving_space_begin_),
+      post_compact_end_(moving_space_begin_),
+      moving_pages_count_(0),
+      live_words_bitmap_(nullptr),
+      chunk_info_vec_(nullptr),
+      first_objs_moving_space_(nullptr),
+      moving_pages_status_(nullptr),
+      from_space_offset_(0),
+      free_mutator_buffers_(~static_cast<uint64_t>(0)),
+      uffd_(-1),
+      sigbus_handler_installed_(false),
+      compacting_(false),
+      concurrent_compaction_(false),
+      sigbus_in_progress_count_(kSigbusCounterCompactionDoneMask),
+      live_objects_(0),
+      live_bytes_(0),
+      mutator_compacted_pages_(0),
+      concurrently_compacted_pages_(0) {
+  static_assert(kMutatorCompactionBufferCount == BitSizeOf<uint64_t>(),
+                "One bit of free_mutator_buffers_ per mutator buffer");
+  CHECK(moving_space_ != nullptr);
+  const size_t capacity = moving_space_->Limit() - moving_space_begin_;
+  CHECK_ALIGNED(capacity, kPageSize);
+  moving_space_bitmap_ = accounting::ContinuousSpaceBitmap::Create(
+      "mark compact moving space bitmap", moving_space_begin_, capacity);
+  CHECK(moving_space_bitmap_.IsValid()) << "Failed to create the moving space bitmap";
+
+  const size_t chunks = capacity / kOffsetChunkSize;
+  const size_t pages = capacity / kPageSize;
+  const size_t info_size = chunks * sizeof(uintptr_t) +
+                           chunks * sizeof(uint32_t) +
+                           pages * sizeof(uint32_t) +
+                           pages * sizeof(Atomic<PageState>);
+  std::string error_msg;
+  info_map_ = MemMap::MapAnonymous("mark compact info",
+                                   RoundUp(info_size, kPageSize),
+                                   PROT_READ | PROT_WRITE,
+                                   /*low_4gb=*/ false,
+                                   &error_msg);
+  CHECK(info_map_.IsValid()) << "Failed to allocate the mark compact info map: " << error_msg;
+  live_words_bitmap_ = reinterpret_cast<uintptr_t*>(info_map_.Begin());
+  chunk_info_vec_ = reinterpret_cast<uint32_t*>(live_words_bitmap_ + chunks);
+  first_objs_moving_space_ = chunk_info_vec_ + chunks;
+  moving_pages_status_ = reinterpret_cast<Atomic<PageState>*>(first_objs_moving_space_ + pages);
+
+  // Only reserve the address range; the pages of the moving space are moved here during the
+  // compaction.
+  from_space_map_ = MemMap::MapAnonymous("mark compact from-space",
+                                         capacity,
+                                         PROT_NONE,
+                                         /*low_4gb=*/ false,
+                                         &error_msg);
+  CHECK(from_space_map_.IsValid()) << "Failed to reserve the from-space: " << error_msg;
+  from_space_offset_ = from_space_map_.Begin() - moving_space_begin_;
+
+  compaction_buffers_map_ = MemMap::MapAnonymous("mark compact buffers",
+                                                 (1 + kMutatorCompactionBufferCount) * kPageSize,
+                                                 PROT_READ | PROT_WRITE,
+                                                 /*low_4gb=*/ false,
+                                                 &error_msg);
+  CHECK(compaction_buffers_map_.IsValid())
+      << "Failed to allocate the compaction buffers: " << error_msg;
+
+#ifdef __NR_userfaultfd
+  // Only the faults of user-mode accesses need to be handled; ask for that if the kernel allows
+  // it, since unprivileged processes may not be allowed to handle kernel faults.
+#ifdef UFFD_USER_MODE_ONLY
+  uffd_ = syscall(__NR_userfaultfd, O_CLOEXEC | UFFD_USER_MODE_ONLY);
+  if (uffd_ < 0 && errno == EINVAL) {
+    uffd_ = syscall(__NR_userfaultfd, O_CLOEXEC);
+  }
+#else
+  uffd_ = syscall(__NR_userfaultfd, O_CLOEXEC);
+#endif
+  if (uffd_ < 0) {
+    VLOG(heap) << "userfaultfd unavailable, compacting in the pause: " << strerror(errno);
+  } else {
+    struct uffdio_api api = {.api = UFFD_API, .features = UFFD_FEATURE_SIGBUS, .ioctls = 0};
+    if (ioctl(uffd_, UFFDIO_API, &api) != 0) {
+      VLOG(heap) << "userfaultfd does not support SIGBUS, compacting in the pause: "
+                 << strerror(errno);
+      close(uffd_);
+      uffd_ = -1;
+    }
+  }
+#endif
+  // Without the signal chain, e.g. in dex2oat, the SIGBUS handler cannot be installed.
+  if (uffd_ >= 0 && !Runtime::Current()->NoSigChain()) {
+    sigset_t mask;
+    sigfillset(&mask);
+    sigdelset(&mask, SIGABRT);
+    sigdelset(&mask, SIGBUS);
+    sigdelset(&mask, SIGFPE);
+    sigdelset(&mask, SIGILL);
+    sigdelset(&mask, SIGSEGV);
+
+    SigchainAction sa = {
+      .sc_sigaction = HandleSigbus,
+      .sc_mask = mask,
+      .sc_flags = 0UL,
+    };
+
+    AddSpecialSignalHandlerFn(SIGBUS, &sa);
+    sigbus_handler_installed_ = true;
+  }
+}
+
+MarkCompact::~MarkCompact() {
+  if (sigbus_handler_installed_) {
+    RemoveSpecialSignalHandlerFn(SIGBUS, HandleSigbus);
+  }
+  if (uffd_ >= 0) {
+    close(uffd_);
+  }
+}
+
+void MarkCompact::RunPhases() {
+  Thread* self = Thread::Current();
+  InitializePhase();
+  Locks::mutator_lock_->AssertNotHeld(self);
+  {
+    ScopedPause pause(this);
+    GetHeap()->PreGcVerificationPaused(this);
+    GetHeap()->PrePauseRosAllocVerification(this);
+    MarkingPhase();
+    CompactionPause();
+  }
+  {
+    ReaderMutexLock mu(self, *Locks::mutator_lock_);
+    CompactionPhase();
+    ReclaimPhase();
+  }
+  GetHeap()->PostGcVerification(this);
+  FinishPhase();
+}
+
+void MarkCompact::InitializePhase() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  mark_stack_ = heap_->GetMarkStack();
+  DCHECK(mark_stack_ != nullptr);
+  immune_spaces_.Reset();
+  self_ = Thread::Current();
+  compacting_ = false;
+  concurrent_compaction_ = false;
+  live_objects_ = 0;
+  live_bytes_ = 0;
+  native_root_holders_.clear();
+  {
+    ReaderMutexLock mu(self_, *Locks::heap_bitmap_lock_);
+    mark_bitmap_ = heap_->GetMarkBitmap();
+  }
+}
+
+void MarkCompact::BindBitmaps() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  WriterMutexLock mu(self_, *Locks::heap_bitmap_lock_);
+  // Mark all of the spaces we never collect as immune.
+  for (const auto& space : GetHeap()->GetContinuousSpaces()) {
+    if (space->GetGcRetentionPolicy() == space::kGcRetentionPolicyNeverCollect ||
+        space->GetGcRetentionPolicy() == space::kGcRetentionPolicyFullCollect) {
+      immune_spaces_.AddSpace(space);
+    }
+  }
+}
+
+void MarkCompact::ProcessReferences(Thread* self) {
+  WriterMutexLock mu(self, *Locks::heap_bitmap_lock_);
+  GetHeap()->GetReferenceProcessor()->ProcessReferences(
+      false, GetTimings(), GetCurrentIteration()->GetClearSoftReferences(), this);
+}
+
+void MarkCompact::MarkingPhase() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  Locks::mutator_lock_->AssertExclusiveHeld(self_);
+  // Revoke the TLABs so that the objects of the moving space are all below its end.
+  RevokeAllThreadLocalBuffers();
+  pre_compact_end_ = moving_space_->End();
+  BindBitmaps();
+  // Process dirty cards and add dirty cards to mod-union tables.
+  heap_->ProcessCards(GetTimings(), /*use_rem_sets=*/false, false, true);
+  // Clear the whole card table since we cannot get any additional dirty cards during the pause.
+  t.NewTiming("ClearCardTable");
+  heap_->GetCardTable()->ClearCardTable();
+  if (kUseThreadLocalAllocationStack) {
+    TimingLogger::ScopedTiming t2("RevokeAllThreadLocalAllocationStacks", GetTimings());
+    heap_->RevokeAllThreadLocalAllocationStacks(self_);
+  }
+  heap_->SwapStacks();
+  {
+    WriterMutexLock mu(self_, *Locks::heap_bitmap_lock_);
+    MarkRoots();
+    // Recursively mark remaining objects.
+    MarkReachableObjects();
+  }
+  ProcessReferences(self_);
+}
+
+// Marks all objects in the root set.
+void MarkCompact::MarkRoots() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  Runtime::Current()->VisitRoots(this);
+}
+
+void MarkCompact::MarkReachableObjects() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  {
+    TimingLogger::ScopedTiming t2("MarkStackAsLive", GetTimings());
+    accounting::ObjectStack* live_stack = heap_->GetLiveStack();
+    heap_->MarkAllocStackAsLive(live_stack);
+    live_stack->Reset();
+  }
+  for (auto& space : heap_->GetContinuousSpaces()) {
+    accounting::ModUnionTable* table = heap_->FindModUnionTableFromSpace(space);
+    if (table != nullptr) {
+      TimingLogger::ScopedTiming t2(
+          space->IsZygoteSpace() ? "UpdateAndMarkZygoteModUnionTable" :
+                                   "UpdateAndMarkImageModUnionTable",
+                                   GetTimings());
+      table->UpdateAndMarkReferences(this);
+    } else if (space->IsImageSpace() && space->GetLiveBitmap() != nullptr) {
+      // App images have no mod-union table; scan their live objects as roots.
+      TimingLogger::ScopedTiming t2("VisitLiveBits", GetTimings());
+      space->GetLiveBitmap()->VisitMarkedRange(reinterpret_cast<uintptr_t>(space->Begin()),
+                                               reinterpret_cast<uintptr_t>(space->End()),
+                                               [this](Object* obj)
+          REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+        ScanObject(obj);
+      });
+    }
+  }
+  // Recursively process the mark stack.
+  ProcessMarkStack();
+}
+
+void MarkCompact::SetLiveWords(Object* obj, size_t size) {
+  DCHECK_ALIGNED(size, kObjectAlignment);
+  const size_t begin_bit = (reinterpret_cast<uint8_t*>(obj) - moving_space_begin_) /
+                           kObjectAlignment;
+  const size_t end_bit = begin_bit + size / kObjectAlignment - 1;
+  size_t begin_word = begin_bit / kBitsPerVectorWord;
+  const size_t end_word = end_bit / kBitsPerVectorWord;
+  uintptr_t begin_mask = ~static_cast<uintptr_t>(0) << (begin_bit % kBitsPerVectorWord);
+  const uintptr_t end_mask =
+      ~static_cast<uintptr_t>(0) >> (kBitsPerVectorWord - 1 - end_bit % kBitsPerVectorWord);
+  for (; begin_word < end_word; ++begin_word) {
+    live_words_bitmap_[begin_word] |= begin_mask;
+    begin_mask = ~static_cast<uintptr_t>(0);
+  }
+  live_words_bitmap_[end_word] |= begin_mask & end_mask;
+}
+
+Object* MarkCompact::PostCompactAddress(Object* obj) const {
+  const size_t bit = (reinterpret_cast<uint8_t*>(obj) - moving_space_begin_) / kObjectAlignment;
+  const size_t word = bit / kBitsPerVectorWord;
+  const uintptr_t mask = (static_cast<uintptr_t>(1) << (bit % kBitsPerVectorWord)) - 1;
+  const size_t offset = chunk_info_vec_[word] +
+                        POPCOUNT(live_words_bitmap_[word] & mask) * kObjectAlignment;
+  return reinterpret_cast<Object*>(moving_space_begin_ + offset);
+}
+
+inline void MarkCompact::PushOnMarkStack(Object* obj) {
+  if (UNLIKELY(mark_stack_->Size() >= mark_stack_->Capacity())) {
+    ResizeMarkStack(mark_stack_->Capacity() * 2);
+  }
+  // The object must be pushed on to the mark stack.
+  mark_stack_->PushBack(obj);
+}
+
+void MarkCompact::ResizeMarkStack(size_t new_size) {
+  std::vector<StackReference<Object>> temp(mark_stack_->Begin(), mark_stack_->End());
+  CHECK_LE(mark_stack_->Size(), new_size);
+  mark_stack_->Resize(new_size);
+  for (auto& obj : temp) {
+    mark_stack_->PushBack(obj.AsMirrorPtr());
+  }
+}
+
+inline void MarkCompact::MarkObjectNonNull(Object* obj) {
+  DCHECK(obj != nullptr);
+  if (HasMovingAddress(obj)) {
+    if (!moving_space_bitmap_.Set(obj)) {
+      const size_t size = RoundUp(obj->SizeOf<kVerifyNone>(), kObjectAlignment);
+      SetLiveWords(obj, size);
+      ++live_objects_;
+      live_bytes_ += size;
+      PushOnMarkStack(obj);
+    }
+  } else if (!immune_spaces_.IsInImmuneRegion(obj)) {
+    auto slow_path = [](const Object* ref) {
+      // Large objects are page aligned.
+      CHECK_ALIGNED(ref, kPageSize);
+    };
+    if (!mark_bitmap_->Set(obj, slow_path)) {
+      PushOnMarkStack(obj);
+    }
+  }
+}
+
+void MarkCompact::UpdateRef(mirror::HeapReference<Object>* ref) {
+  Object* old_ref = ref->AsMirrorPtr();
+  if (HasMovingAddress(old_ref)) {
+    DCHECK(moving_space_bitmap_.Test(old_ref)) << "Reference to dead object " << old_ref;
+    ref->Assign(PostCompactAddress(old_ref));
+  }
+}
+
+void MarkCompact::UpdateRoot(mirror::CompressedReference<Object>* root) {
+  Object* old_ref = root->AsMirrorPtr();
+  if (HasMovingAddress(old_ref)) {
+    DCHECK(moving_space_bitmap_.Test(old_ref)) << "Root to dead object " << old_ref;
+    root->Assign(PostCompactAddress(old_ref));
+  }
+}
+
+Object* MarkCompact::MarkObject(Object* obj) {
+  if (obj == nullptr) {
+    return nullptr;
+  }
+  if (compacting_) {
+    return HasMovingAddress(obj) ? PostCompactAddress(obj) : obj;
+  }
+  MarkObjectNonNull(obj);
+  return obj;
+}
+
+void MarkCompact::MarkHeapReference(mirror::HeapReference<Object>* obj,
+                                    bool do_atomic_update ATTRIBUTE_UNUSED) {
+  if (compacting_) {
+    UpdateRef(obj);
+  } else {
+    Object* ref = obj->AsMirrorPtr();
+    if (ref != nullptr) {
+      MarkObjectNonNull(ref);
+    }
+  }
+}
+
+void MarkCompact::VisitRoots(Object*** roots,
+                             size_t count,
+                             const RootInfo& info ATTRIBUTE_UNUSED) {
+  for (size_t i = 0; i < count; ++i) {
+    Object* obj = *roots[i];
+    if (compacting_) {
+      if (HasMovingAddress(obj)) {
+        *roots[i] = PostCompactAddress(obj);
+      }
+    } else {
+      MarkObjectNonNull(obj);
+    }
+  }
+}
+
+void MarkCompact::VisitRoots(mirror::CompressedReference<Object>** roots,
+                             size_t count,
+                             const RootInfo& info ATTRIBUTE_UNUSED) {
+  for (size_t i = 0; i < count; ++i) {
+    if (compacting_) {
+      UpdateRoot(roots[i]);
+    } else {
+      MarkObjectNonNull(roots[i]->AsMirrorPtr());
+    }
+  }
+}
+
+class MarkCompact::RefFieldsVisitor {
+ public:
+  explicit RefFieldsVisitor(MarkCompact* collector) : collector_(collector) {}
+
+  void operator()(ObjPtr<Object> obj, MemberOffset offset, bool /* is_static */) const
+      ALWAYS_INLINE REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    Object* ref = obj->GetFieldObject<Object, kVerifyNone, kWithoutReadBarrier>(offset);
+    if (ref != nullptr) {
+      collector_->MarkObjectNonNull(ref);
+    }
+  }
+
+  void operator()(ObjPtr<mirror::Class> klass, ObjPtr<mirror::Reference> ref) const
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_) {
+    collector_->DelayReferenceReferent(klass, ref);
+  }
+
+  // TODO: Remove NO_THREAD_SAFETY_ANALYSIS when clang better understands visitors.
+  void VisitRootIfNonNull(mirror::CompressedReference<Object>* root) const
+      NO_THREAD_SAFETY_ANALYSIS {
+    if (!root->IsNull()) {
+      VisitRoot(root);
+    }
+  }
+
+  void VisitRoot(mirror::CompressedReference<Object>* root) const
+      NO_THREAD_SAFETY_ANALYSIS {
+    collector_->MarkObjectNonNull(root->AsMirrorPtr());
+  }
+
+ private:
+  MarkCompact* const collector_;
+};
+
+// Visit all of the references of an object and mark them.
+void MarkCompact::ScanObject(Object* obj) {
+  if (HasMovingAddress(obj)) {
+    DCHECK(!obj->IsClass<kVerifyNone>()) << "Class " << obj << " in the moving space";
+    // The native roots of moving objects are updated from the pause, before the object moves.
+    if (obj->IsDexCache<kVerifyNone, kWithoutReadBarrier>() ||
+        obj->IsClassLoader<kVerifyNone, kWithoutReadBarrier>()) {
+      native_root_holders_.push_back(obj);
+    }
+  }
+  RefFieldsVisitor visitor(this);
+  obj->VisitReferences</*kVisitNativeRoots=*/true, kDefaultVerifyFlags, kWithoutReadBarrier>(
+      visitor, visitor);
+}
+
+// Scan anything that's on the mark stack.
+void MarkCompact::ProcessMarkStack() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  while (!mark_stack_->IsEmpty()) {
+    Object* obj = mark_stack_->PopBack();
+    ScanObject(obj);
+  }
+}
+
+// Process the "referent" field in a java.lang.ref.Reference.  If the referent has not yet been
+// marked, put it on the appropriate list in the heap for later processing.
+void MarkCompact::DelayReferenceReferent(ObjPtr<mirror::Class> klass,
+                                         ObjPtr<mirror::Reference> reference) {
+  heap_->GetReferenceProcessor()->DelayReferenceReferent(klass, reference, this);
+}
+
+Object* MarkCompact::IsMarked(Object* obj) {
+  if (HasMovingAddress(obj)) {
+    if (!moving_space_bitmap_.Test(obj)) {
+      return nullptr;
+    }
+    return compacting_ ? PostCompactAddress(obj) : obj;
+  } else if (immune_spaces_.IsInImmuneRegion(obj)) {
+    // All immune objects are assumed marked.
+    return obj;
+  }
+  return mark_bitmap_->Test(obj) ? obj : nullptr;
+}
+
+bool MarkCompact::IsNullOrMarkedHeapReference(mirror::HeapReference<Object>* object,
+                                              // The references are updated in a pause.
+                                              bool do_atomic_update ATTRIBUTE_UNUSED) {
+  Object* obj = object->AsMirrorPtr();
+  if (obj == nullptr) {
+    return true;
+  }
+  Object* new_obj = IsMarked(obj);
+  if (new_obj == nullptr) {
+    return false;
+  }
+  if (new_obj != obj) {
+    // Write barrier is not necessary since it still points to the same object, just at a different
+    // address.
+    object->Assign(new_obj);
+  }
+  return true;
+}
+
+void MarkCompact::PrepareForCompaction() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  // Turn the live words into exclusive prefix sums of the live bytes of each chunk.
+  const size_t vector_length =
+      RoundUp(pre_compact_end_ - moving_space_begin_, kOffsetChunkSize) / kOffsetChunkSize;
+  uint32_t total = 0;
+  for (size_t i = 0; i < vector_length; ++i) {
+    chunk_info_vec_[i] = total;
+    total += POPCOUNT(live_words_bitmap_[i]) * kObjectAlignment;
+  }
+  DCHECK_EQ(total, live_bytes_);
+  post_compact_end_ = moving_space_begin_ + total;
+  moving_pages_count_ = RoundUp(total, kPageSize) / kPageSize;
+  // Find the first object of every post-compact page. The objects keep their order, so walking
+  // them while accumulating their sizes gives their post-compact offsets.
+  size_t next_page = 0;
+  size_t post_compact_offset = 0;
+  moving_space_bitmap_.VisitMarkedRange(
+      reinterpret_cast<uintptr_t>(moving_space_begin_),
+      reinterpret_cast<uintptr_t>(pre_compact_end_),
+      [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+        const size_t size = RoundUp(obj->SizeOf<kVerifyNone>(), kObjectAlignment);
+        post_compact_offset += size;
+        while (next_page * kPageSize < post_compact_offset) {
+          first_objs_moving_space_[next_page++] =
+              reinterpret_cast<uint8_t*>(obj) - moving_space_begin_;
+        }
+      });
+  DCHECK_EQ(next_page, moving_pages_count_);
+}
+
+class MarkCompact::RefsUpdateVisitor {
+ public:
+  explicit RefsUpdateVisitor(MarkCompact* collector) : collector_(collector) {}
+
+  void operator()(ObjPtr<Object> obj, MemberOffset offset, bool /* is_static */) const
+      ALWAYS_INLINE REQUIRES_SHARED(Locks::mutator_lock_) {
+    collector_->UpdateRef(obj->GetFieldObjectReferenceAddr<kVerifyNone>(offset));
+  }
+
+  void operator()(ObjPtr<mirror::Class> klass ATTRIBUTE_UNUSED, ObjPtr<mirror::Reference> ref)
+      const ALWAYS_INLINE REQUIRES_SHARED(Locks::mutator_lock_) {
+    collector_->UpdateRef(
+        ref->GetFieldObjectReferenceAddr<kVerifyNone>(mirror::Reference::ReferentOffset()));
+  }
+
+  // TODO: Remove NO_THREAD_SAFETY_ANALYSIS when clang better understands visitors.
+  void VisitRootIfNonNull(mirror::CompressedReference<Object>* root) const
+      NO_THREAD_SAFETY_ANALYSIS {
+    if (!root->IsNull()) {
+      VisitRoot(root);
+    }
+  }
+
+  void VisitRoot(mirror::CompressedReference<Object>* root) const
+      NO_THREAD_SAFETY_ANALYSIS {
+    collector_->UpdateRoot(root);
+  }
+
+ private:
+  MarkCompact* const collector_;
+};
+
+// Only updates the native roots of an object; its fields are updated when its page is compacted.
+class MarkCompact::NativeRootsUpdateVisitor {
+ public:
+  explicit NativeRootsUpdateVisitor(MarkCompact* collector) : collector_(collector) {}
+
+  void operator()(ObjPtr<Object> obj ATTRIBUTE_UNUSED,
+                  MemberOffset offset ATTRIBUTE_UNUSED,
+                  bool is_static ATTRIBUTE_UNUSED) const ALWAYS_INLINE {}
+
+  // TODO: Remove NO_THREAD_SAFETY_ANALYSIS when clang better understands visitors.
+  void VisitRootIfNonNull(mirror::CompressedReference<Object>* root) const
+      NO_THREAD_SAFETY_ANALYSIS {
+    if (!root->IsNull()) {
+      VisitRoot(root);
+    }
+  }
+
+  void VisitRoot(mirror::CompressedReference<Object>* root) const
+      NO_THREAD_SAFETY_ANALYSIS {
+    collector_->UpdateRoot(root);
+  }
+
+ private:
+  MarkCompact* const collector_;
+};
+
+void MarkCompact::UpdateNonMovingReferences() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  Runtime::Current()->VisitRoots(this);
+  heap_->GetReferenceProcessor()->UpdateRoots(this);
+  RefsUpdateVisitor visitor(this);
+  auto update_refs = [&visitor](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+    obj->VisitReferences</*kVisitNativeRoots=*/true, kVerifyNone, kWithoutReadBarrier>(
+        visitor, visitor);
+  };
+  for (const auto& space : heap_->GetContinuousSpaces()) {
+    if (space == moving_space_) {
+      continue;
+    }
+    accounting::ModUnionTable* table = heap_->FindModUnionTableFromSpace(space);
+    if (table != nullptr) {
+      // With compacting_ set, the table updates the references it cached while marking.
+      table->UpdateAndMarkReferences(this);
+      continue;
+    }
+    // Every object of an immune space is live; elsewhere only the marked ones are.
+    accounting::ContinuousSpaceBitmap* bitmap = immune_spaces_.ContainsSpace(space)
+        ? space->GetLiveBitmap()
+        : space->GetMarkBitmap();
+    if (bitmap != nullptr) {
+      bitmap->VisitMarkedRange(reinterpret_cast<uintptr_t>(space->Begin()),
+                               reinterpret_cast<uintptr_t>(space->End()),
+                               update_refs);
+    }
+  }
+  space::LargeObjectSpace* los = heap_->GetLargeObjectsSpace();
+  if (los != nullptr) {
+    los->GetMarkBitmap()->VisitMarkedRange(reinterpret_cast<uintptr_t>(los->Begin()),
+                                           reinterpret_cast<uintptr_t>(los->End()),
+                                           update_refs);
+  }
+  NativeRootsUpdateVisitor native_roots_visitor(this);
+  for (Object* holder : native_root_holders_) {
+    holder->VisitReferences</*kVisitNativeRoots=*/true, kVerifyNone, kWithoutReadBarrier>(
+        native_roots_visitor, VoidFunctor());
+  }
+}
+
+void MarkCompact::MoveToFromSpace(size_t size) {
+  uint8_t* from_space = from_space_map_.Begin();
+  void* ret = mremap(moving_space_begin_,
+                     size,
+                     size,
+                     MREMAP_MAYMOVE | MREMAP_FIXED,
+                     from_space);
+  CHECK_EQ(ret, static_cast<void*>(from_space))
+      << "mremap to the from-space failed: " << strerror(errno);
+  // Keep the moving space a single mapping so that the whole of it can be registered with
+  // userfaultfd and released in one go.
+  ret = mmap(moving_space_begin_,
+             size,
+             PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+             -1,
+             0);
+  CHECK_EQ(ret, static_cast<void*>(moving_space_begin_))
+      << "mmap of the moving space failed: " << strerror(errno);
+  MemMap::SetDebugName(moving_space_begin_, moving_space_->GetName(), size);
+}
+
+void MarkCompact::ReleaseFromSpace(uint8_t* begin, uint8_t* end) {
+  DCHECK_ALIGNED(begin, kPageSize);
+  DCHECK_ALIGNED(end, kPageSize);
+  if (begin < end) {
+    CHECK_EQ(madvise(begin, end - begin, MADV_DONTNEED), 0)
+        << "madvise of the from-space failed: " << strerror(errno);
+  }
+}
+
+void MarkCompact::CompactionPause() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  PrepareForCompaction();
+  // From now on the visitors update references instead of marking.
+  compacting_ = true;
+  {
+    ReaderMutexLock mu(self_, *Locks::heap_bitmap_lock_);
+    SweepSystemWeaks();
+  }
+  Runtime::Current()->BroadcastForNewSystemWeaks();
+  Runtime::Current()->GetClassLinker()->CleanupClassLoaders();
+  {
+    WriterMutexLock mu(self_, *Locks::heap_bitmap_lock_);
+    UpdateNonMovingReferences();
+  }
+  GetHeap()->RecordFreeRevoke();  // This is for the non-moving rosalloc space.
+  // Record freed memory.
+  const uint64_t objects_allocated = moving_space_->GetObjectsAllocated();
+  const uint64_t bytes_allocated = moving_space_->GetBytesAllocated();
+  CHECK_LE(live_objects_, objects_allocated);
+  RecordFree(ObjectBytePair(objects_allocated - live_objects_, bytes_allocated - live_bytes_));
+  moving_space_->SetCompactedEnd(post_compact_end_, live_objects_, live_bytes_);
+
+  if (pre_compact_end_ > moving_space_begin_) {
+    MoveToFromSpace(moving_space_->Limit() - moving_space_begin_);
+    if (IsConcurrentCompaction() && moving_pages_count_ > 0) {
+      struct uffdio_register reg;
+      reg.range.start = reinterpret_cast<uintptr_t>(moving_space_begin_);
+      reg.range.len = moving_pages_count_ * kPageSize;
+      reg.mode = UFFDIO_REGISTER_MODE_MISSING;
+      CHECK_EQ(ioctl(uffd_, UFFDIO_REGISTER, &reg), 0)
+          << "userfaultfd register failed: " << strerror(errno);
+      sigbus_in_progress_count_.fetch_and(~kSigbusCounterCompactionDoneMask,
+                                          std::memory_order_seq_cst);
+      concurrent_compaction_ = true;
+    } else {
+      uint8_t* to_addr = moving_space_begin_;
+      for (size_t i = 0; i < moving_pages_count_; ++i, to_addr += kPageSize) {
+        CompactPage(i, to_addr);
+      }
+      ReleaseFromSpace(from_space_map_.Begin(), from_space_map_.End());
+    }
+  }
+  heap_->PreSweepingGcVerification(this);
+}
+
+void MarkCompact::SweepSystemWeaks() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  Runtime::Current()->SweepSystemWeaks(this);
+}
+
+// Updates the references of an object copied into a compaction buffer. Only the references
+// within the buffer are updated, since the other parts of the object belong to other pages.
+class MarkCompact::PageRefsUpdateVisitor {
+ public:
+  PageRefsUpdateVisitor(MarkCompact* collector, uint8_t* obj, uint8_t* begin, uint8_t* end)
+      : collector_(collector), obj_(obj), begin_(begin), end_(end) {}
+
+  void operator()(ObjPtr<Object> obj ATTRIBUTE_UNUSED,
+                  MemberOffset offset,
+                  bool /* is_static */) const ALWAYS_INLINE REQUIRES_SHARED(Locks::mutator_lock_) {
+    UpdateRefAt(offset);
+  }
+
+  void operator()(ObjPtr<mirror::Class> klass ATTRIBUTE_UNUSED,
+                  ObjPtr<mirror::Reference> ref ATTRIBUTE_UNUSED) const
+      ALWAYS_INLINE REQUIRES_SHARED(Locks::mutator_lock_) {
+    UpdateRefAt(mirror::Reference::ReferentOffset());
+  }
+
+  // Native roots are updated in the pause.
+  void VisitRootIfNonNull(mirror::CompressedReference<Object>* root ATTRIBUTE_UNUSED) const {}
+  void VisitRoot(mirror::CompressedReference<Object>* root ATTRIBUTE_UNUSED) const {}
+
+  void UpdateRefAt(MemberOffset offset) const REQUIRES_SHARED(Locks::mutator_lock_) {
+    uint8_t* addr = obj_ + offset.Int32Value();
+    if (addr >= begin_ && addr < end_) {
+      collector_->UpdateRef(reinterpret_cast<mirror::HeapReference<Object>*>(addr));
+    }
+  }
+
+ private:
+  MarkCompact* const collector_;
+  // Where the object starts in the buffer, which may be before `begin_`.
+  uint8_t* const obj_;
+  uint8_t* const begin_;
+  uint8_t* const end_;
+};
+
+void MarkCompact::CompactPage(size_t page_idx, uint8_t* dest) {
+  DCHECK_LT(page_idx, moving_pages_count_);
+  const size_t page_offset = page_idx * kPageSize;
+  uint8_t* const page_begin = moving_space_begin_ + page_offset;
+  Object* first_obj =
+      reinterpret_cast<Object*>(moving_space_begin_ + first_objs_moving_space_[page_idx]);
+  // The first object of the next page may also start in this page.
+  const uintptr_t visit_end = page_idx + 1 < moving_pages_count_
+      ? reinterpret_cast<uintptr_t>(moving_space_begin_) +
+            first_objs_moving_space_[page_idx + 1] + kObjectAlignment
+      : reinterpret_cast<uintptr_t>(pre_compact_end_);
+  uint8_t* to_addr = reinterpret_cast<uint8_t*>(PostCompactAddress(first_obj));
+  uint8_t* const page_end = page_begin + kPageSize;
+  moving_space_bitmap_.VisitMarkedRange(
+      reinterpret_cast<uintptr_t>(first_obj),
+      visit_end,
+      [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+        Object* from_obj = FromSpaceAddress(obj);
+        const size_t size = RoundUp(from_obj->SizeOf<kVerifyNone>(), kObjectAlignment);
+        uint8_t* copy_begin = std::max(to_addr, page_begin);
+        uint8_t* copy_end = std::min(to_addr + size, page_end);
+        if (copy_begin < copy_end) {
+          memcpy(dest + (copy_begin - page_begin),
+                 reinterpret_cast<uint8_t*>(from_obj) + (copy_begin - to_addr),
+                 copy_end - copy_begin);
+          PageRefsUpdateVisitor visitor(
+              this, dest + (to_addr - page_begin), dest, dest + kPageSize);
+          if (size > kPageSize && from_obj->IsObjectArray<kVerifyNone>()) {
+            // Only visit the elements which are in this page. The class does not move.
+            const int32_t length = from_obj->AsArray<kVerifyNone>()->GetLength<kVerifyNone>();
+            const size_t data_offset =
+                mirror::Array::DataOffset(sizeof(mirror::HeapReference<Object>)).SizeValue();
+            uint8_t* data = to_addr + data_offset;
+            size_t begin_idx = copy_begin > data
+                ? (copy_begin - data) / sizeof(mirror::HeapReference<Object>)
+                : 0;
+            size_t end_idx = copy_end > data
+                ? RoundUp(copy_end - data, sizeof(mirror::HeapReference<Object>)) /
+                      sizeof(mirror::HeapReference<Object>)
+                : 0;
+            end_idx = std::min(end_idx, static_cast<size_t>(length));
+            for (size_t i = begin_idx; i < end_idx; ++i) {
+              visitor.UpdateRefAt(
+                  MemberOffset(data_offset + i * sizeof(mirror::HeapReference<Object>)));
+            }
+          } else {
+            from_obj->VisitReferences</*kVisitNativeRoots=*/false,
+                                      kVerifyNone,
+                                      kWithoutReadBarrier>(visitor, visitor);
+          }
+        }
+        to_addr += size;
+      });
+  if (to_addr < page_end) {
+    DCHECK_EQ(page_idx + 1, moving_pages_count_);
+    memset(dest + (to_addr - page_begin), 0, page_end - to_addr);
+  }
+}
+
+void MarkCompact::CopyIoctl(uint8_t* dst, uint8_t* buffer) {
+  struct uffdio_copy copy;
+  copy.dst = reinterpret_cast<uintptr_t>(dst);
+  copy.src = reinterpret_cast<uintptr_t>(buffer);
+  copy.len = kPageSize;
+  copy.mode = 0;
+  copy.copy = 0;
+  CHECK_EQ(ioctl(uffd_, UFFDIO_COPY, &copy), 0)
+      << "userfaultfd copy failed: " << strerror(errno) << " dst:" << static_cast<void*>(dst);
+  DCHECK_EQ(copy.copy, static_cast<int64_t>(kPageSize));
+}
+
+bool MarkCompact::ConcurrentlyProcessPage(size_t page_idx, uint8_t* buffer) {
+  PageState expected = PageState::kUnprocessed;
+  if (moving_pages_status_[page_idx].CompareAndSetStrongSequentiallyConsistent(
+          expected, PageState::kProcessing)) {
+    CompactPage(page_idx, buffer);
+    CopyIoctl(moving_space_begin_ + page_idx * kPageSize, buffer);
+    moving_pages_status_[page_idx].store(PageState::kProcessed, std::memory_order_release);
+    return true;
+  }
+  // Another thread is compacting the page; it is mapped once it is processed.
+  while (moving_pages_status_[page_idx].load(std::memory_order_acquire) !=
+         PageState::kProcessed) {
+    sched_yield();
+  }
+  return false;
+}
+
+uint8_t* MarkCompact::AcquireMutatorBuffer() {
+  while (true) {
+    uint64_t free_buffers = free_mutator_buffers_.load(std::memory_order_relaxed);
+    if (free_buffers == 0) {
+      sched_yield();
+      continue;
+    }
+    const size_t idx = CTZ(free_buffers);
+    if (free_mutator_buffers_.CompareAndSetWeakAcquire(
+            free_buffers, free_buffers & ~(static_cast<uint64_t>(1) << idx))) {
+      // The first page is the buffer of the GC thread.
+      return compaction_buffers_map_.Begin() + (1 + idx) * kPageSize;
+    }
+  }
+}
+
+void MarkCompact::ReleaseMutatorBuffer(uint8_t* buffer) {
+  const size_t idx = (buffer - compaction_buffers_map_.Begin()) / kPageSize - 1;
+  DCHECK_LT(idx, kMutatorCompactionBufferCount);
+  free_mutator_buffers_.fetch_or(static_cast<uint64_t>(1) << idx, std::memory_order_release);
+}
+
+bool MarkCompact::SigbusHandler(siginfo_t* info) {
+  class ScopedInProgressCount {
+   public:
+    explicit ScopedInProgressCount(MarkCompact* collector) : collector_(collector) {
+      compaction_done_ =
+          (collector_->sigbus_in_progress_count_.fetch_add(1, std::memory_order_acquire) &
+           kSigbusCounterCompactionDoneMask) != 0;
+    }
+
+    ~ScopedInProgressCount() {
+      collector_->sigbus_in_progress_count_.fetch_sub(1, std::memory_order_release);
+    }
+
+    bool IsCompactionDone() const {
+      return compaction_done_;
+    }
+
+   private:
+    MarkCompact* const collector_;
+    bool compaction_done_;
+  };
+
+  if (info->si_code != BUS_ADRERR) {
+    // Userfaultfd raises SIGBUS with BUS_ADRERR.
+    return false;
+  }
+  ScopedInProgressCount spc(this);
+  uint8_t* fault_page = AlignDown(reinterpret_cast<uint8_t*>(info->si_addr), kPageSize);
+  if (spc.IsCompactionDone()) {
+    // The page was mapped by the time this handler ran; retry the access.
+    return fault_page >= moving_space_begin_ && fault_page < moving_space_->Limit();
+  }
+  if (fault_page < moving_space_begin_ ||
+      fault_page >= moving_space_begin_ + moving_pages_count_ * kPageSize) {
+    return false;
+  }
+  const size_t page_idx = (fault_page - moving_space_begin_) / kPageSize;
+  if (moving_pages_status_[page_idx].load(std::memory_order_acquire) != PageState::kProcessed) {
+    uint8_t* buffer = AcquireMutatorBuffer();
+    if (ConcurrentlyProcessPage(page_idx, buffer)) {
+      mutator_compacted_pages_.fetch_add(1, std::memory_order_relaxed);
+    }
+    ReleaseMutatorBuffer(buffer);
+  }
+  return true;
+}
+
+void MarkCompact::CompactionPhase() {
+  if (!concurrent_compaction_) {
+    return;
+  }
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  uint8_t* const buffer = compaction_buffers_map_.Begin();
+  // The from-space below the first object of the lowest page not yet processed is not needed
+  // anymore; release it as the compaction progresses.
+  size_t processed_prefix = 0;
+  uint8_t* released_end = from_space_map_.Begin();
+  for (size_t i = 0; i < moving_pages_count_; ++i) {
+    ConcurrentlyProcessPage(i, buffer);
+    while (processed_prefix < moving_pages_count_ &&
+           moving_pages_status_[processed_prefix].load(std::memory_order_acquire) ==
+               PageState::kProcessed) {
+      ++processed_prefix;
+    }
+    if (processed_prefix < moving_pages_count_) {
+      uint8_t* release_end = AlignDown(
+          reinterpret_cast<uint8_t*>(FromSpaceAddress(reinterpret_cast<Object*>(
+              moving_space_begin_ + first_objs_moving_space_[processed_prefix]))),
+          kPageSize);
+      if (release_end >= released_end + kFromSpaceReleaseBatchSize) {
+        ReleaseFromSpace(released_end, release_end);
+        released_end = release_end;
+      }
+    }
+  }
+  // Wait for the SIGBUS handlers still looking at the page states.
+  sigbus_in_progress_count_.fetch_or(kSigbusCounterCompactionDoneMask, std::memory_order_seq_cst);
+  while ((sigbus_in_progress_count_.load(std::memory_order_acquire) &
+          ~kSigbusCounterCompactionDoneMask) != 0) {
+    sched_yield();
+  }
+  struct uffdio_range range;
+  range.start = reinterpret_cast<uintptr_t>(moving_space_begin_);
+  range.len = moving_pages_count_ * kPageSize;
+  CHECK_EQ(ioctl(uffd_, UFFDIO_UNREGISTER, &range), 0)
+      << "userfaultfd unregister failed: " << strerror(errno);
+  ReleaseFromSpace(released_end, from_space_map_.End());
+  concurrently_compacted_pages_ += moving_pages_count_;
+}
+
+void MarkCompact::ReclaimPhase() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  WriterMutexLock mu(self_, *Locks::heap_bitmap_lock_);
+  // Reclaim unmarked objects.
+  Sweep(false);
+  // Swap the live and mark bitmaps for each space which we modified space. This is an
+  // optimization that enables us to not clear live bits inside of the sweep. Only swaps unbound
+  // bitmaps.
+  SwapBitmaps();
+  // Unbind the live and mark bitmaps.
+  GetHeap()->UnBindBitmaps();
+}
+
+void MarkCompact::Sweep(bool swap_bitmaps) {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  DCHECK(mark_stack_->IsEmpty());
+  for (const auto& space : GetHeap()->GetContinuousSpaces()) {
+    if (space->IsContinuousMemMapAllocSpace() && space != moving_space_) {
+      space::ContinuousMemMapAllocSpace* alloc_space = space->AsContinuousMemMapAllocSpace();
+      TimingLogger::ScopedTiming split(
+          alloc_space->IsZygoteSpace() ? "SweepZygoteSpace" : "SweepAllocSpace", GetTimings());
+      RecordFree(alloc_space->Sweep(swap_bitmaps));
+    }
+  }
+  SweepLargeObjects(swap_bitmaps);
+}
+
+void MarkCompact::SweepLargeObjects(bool swap_bitmaps) {
+  space::LargeObjectSpace* los = heap_->GetLargeObjectsSpace();
+  if (los != nullptr) {
+    TimingLogger::ScopedTiming split("SweepLargeObjects", GetTimings());
+    RecordFreeLOS(los->Sweep(swap_bitmaps));
+  }
+}
+
+void MarkCompact::FinishPhase() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  compacting_ = false;
+  native_root_holders_.clear();
+  CHECK(mark_stack_->IsEmpty());
+  mark_stack_->Reset();
+  moving_space_bitmap_.Clear();
+  info_map_.MadviseDontNeedAndZero();
+  // Clear all of the spaces' mark bitmaps.
+  WriterMutexLock mu(Thread::Current(), *Locks::heap_bitmap_lock_);
+  heap_->ClearMarkedObjects();
+}
+
+void MarkCompact::RevokeAllThreadLocalBuffers() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  GetHeap()->RevokeAllThreadLocalBuffers();
+}
+
+void MarkCompact::DumpPerformanceInfo(std::ostream& os) {
+  GarbageCollector::DumpPerformanceInfo(os);
+  os << "Concurrent compaction " << (IsConcurrentCompaction() ? "enabled" : "disabled") << "\n";
+  if (concurrently_compacted_pages_ > 0) {
+    os << "Pages compacted by mutators "
+       << mutator_compacted_pages_.load(std::memory_order_relaxed) << " of "
+       << concurrently_compacted_pages_ << "\n";
+  }
+}
+
+}  // namespace collector
+}  // namespace gc
+}  // namespace art
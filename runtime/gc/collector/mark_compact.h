@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_GC_COLLECTOR_MARK_COMPACT_H_
+#define ART_RUNTIME_GC_COLLECTOR_MARK_COMPACT_H_
+
+#include <signal.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/atomic.h"
+#include "base/locks.h"
+#include "base/macros.h"
+#include "base/mem_map.h"
+#include "garbage_collector.h"
+#include "gc/accounting/heap_bitmap.h"
+#include "gc/accounting/space_bitmap.h"
+#include "gc_root.h"
+#include "immune_spaces.h"
+#include "mirror/object_reference.h"
+#include "offsets.h"
+
+namespace art {
+
+class Thread;
+
+namespace mirror {
+class Class;
+class Object;
+}  // namespace mirror
+
+namespace gc {
+
+class Heap;
+
+namespace accounting {
+template <typename T> class AtomicStack;
+typedef AtomicStack<mirror::Object> ObjectStack;
+}  // namespace accounting
+
+namespace space {
+class BumpPointerSpace;
+class ContinuousSpace;
+}  // namespace space
+
+namespace collector {
+
+// Compacting collector for the bump pointer space which runs without read barriers.
+//
+// Marking and the update of all references from outside the moving space happen in a pause,
+// after which every root and every reference held by a non-moving object already points to the
+// post-compact address of its target. The pages of the moving space are then moved (with
+// mremap) to a from-space mapping and, if the kernel supports userfaultfd with the SIGBUS
+// feature, registered with userfaultfd. The GC thread then compacts the moving space page by
+// page, concurrently with the mutators; a mutator touching a page that has not been compacted
+// yet gets a SIGBUS and compacts (or waits for) that page itself before resuming. Without
+// userfaultfd, or when the runtime does not own the signal chain, the pages are compacted in the
+// pause instead.
+//
+// Objects are slid towards the beginning of the space, keeping their order. The post-compact
+// address of an object is computed from a bitmap of live words and per-chunk prefix sums of the
+// live bytes, so no forwarding pointers are stored in the objects. Classes are never allocated
+// in the moving space when this collector is used (see Heap::CanMoveClasses()), so the class of
+// an object can always be read while its page is being compacted.
+class MarkCompact : public GarbageCollector {
+ public:
+  // Number of page-sized buffers the mutators use to compact a page before mapping it. A mutator
+  // that finds all of them busy waits for one to be released.
+  static constexpr size_t kMutatorCompactionBufferCount = 64;
+
+  explicit MarkCompact(Heap* heap);
+
+  ~MarkCompact();
+
+  void RunPhases() override NO_THREAD_SAFETY_ANALYSIS;
+
+  GcType GetGcType() const override {
+    return kGcTypePartial;
+  }
+  CollectorType GetCollectorType() const override {
+    return kCollectorTypeCMC;
+  }
+
+  // True if the pages of the moving space are compacted concurrently with the mutators.
+  bool IsConcurrentCompaction() const {
+    return uffd_ >= 0 && sigbus_handler_installed_;
+  }
+
+  mirror::Object* MarkObject(mirror::Object* obj) override
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+
+  void MarkHeapReference(mirror::HeapReference<mirror::Object>* obj,
+                         bool do_atomic_update) override
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+
+  void VisitRoots(mirror::Object*** roots, size_t count, const RootInfo& info) override
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+
+  void VisitRoots(mirror::CompressedReference<mirror::Object>** roots,
+                  size_t count,
+                  const RootInfo& info) override
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+
+  // Schedules an unmarked object for reference processing.
+  void DelayReferenceReferent(ObjPtr<mirror::Class> klass, ObjPtr<mirror::Reference> reference)
+      override REQUIRES_SHARED(Locks::heap_bitmap_lock_, Locks::mutator_lock_);
+
+  // Handles a SIGBUS caused by an access to a page of the moving space that has not been
+  // compacted yet. Returns false if the fault is not ours.
+  bool SigbusHandler(siginfo_t* info) NO_THREAD_SAFETY_ANALYSIS;
+
+  void DumpPerformanceInfo(std::ostream& os) override REQUIRES(!pause_histogram_lock_);
+
+ protected:
+  // Returns null if the object is not marked. Otherwise returns the object, or its post-compact
+  // address once the compaction has been prepared.
+  mirror::Object* IsMarked(mirror::Object* obj) override
+      REQUIRES(Locks::mutator_lock_)
+      REQUIRES_SHARED(Locks::heap_bitmap_lock_);
+
+  bool IsNullOrMarkedHeapReference(mirror::HeapReference<mirror::Object>* obj,
+                                   bool do_atomic_update) override
+      REQUIRES(Locks::mutator_lock_)
+      REQUIRES_SHARED(Locks::heap_bitmap_lock_);
+
+  // Recursively blackens objects on the mark stack.
+  void ProcessMarkStack() override
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+
+  void RevokeAllThreadLocalBuffers() override;
+
+ private:
+  // State of a page of the moving space during the concurrent compaction.
+  enum class PageState : uint8_t {
+    kUnprocessed = 0,  // Not compacted yet, the page is missing.
+    kProcessing,       // Being compacted by a thread, which maps it when done.
+    kProcessed,        // Compacted and mapped.
+  };
+
+  class NativeRootsUpdateVisitor;
+  class PageRefsUpdateVisitor;
+  class RefFieldsVisitor;
+  class RefsUpdateVisitor;
+
+  // Size of the moving space covered by one word of the live-words bitmap.
+  static constexpr size_t kBitsPerVectorWord = kBitsPerIntPtrT;
+  static constexpr size_t kOffsetChunkSize = kBitsPerVectorWord * kObjectAlignment;
+
+  // Set in sigbus_in_progress_count_ once the compaction is over, so that a late SIGBUS handler
+  // does not look at page states that may already be reset.
+  static constexpr uint32_t kSigbusCounterCompactionDoneMask = 1u << 31;
+
+  void InitializePhase();
+  void MarkingPhase() REQUIRES(Locks::mutator_lock_, !Locks::heap_bitmap_lock_);
+  // Computes the post-compact addresses, updates every reference from outside the moving space
+  // and sets up the moving space for the compaction.
+  void CompactionPause() REQUIRES(Locks::mutator_lock_, !Locks::heap_bitmap_lock_);
+  // Compacts the pages not yet compacted by the mutators, if the compaction is concurrent.
+  void CompactionPhase() REQUIRES_SHARED(Locks::mutator_lock_);
+  void ReclaimPhase() REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!Locks::heap_bitmap_lock_);
+  void FinishPhase() REQUIRES(!Locks::heap_bitmap_lock_);
+
+  // Bind the live bits to the mark bits of bitmaps for spaces that are never collected, ie
+  // the image. Mark that portion of the heap as immune.
+  void BindBitmaps() REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!Locks::heap_bitmap_lock_);
+  void MarkRoots() REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+  void MarkReachableObjects() REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+  void ProcessReferences(Thread* self) REQUIRES(Locks::mutator_lock_);
+  void SweepSystemWeaks() REQUIRES_SHARED(Locks::heap_bitmap_lock_, Locks::mutator_lock_);
+  void Sweep(bool swap_bitmaps) REQUIRES(Locks::heap_bitmap_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+  void SweepLargeObjects(bool swap_bitmaps) REQUIRES(Locks::heap_bitmap_lock_);
+
+  void MarkObjectNonNull(mirror::Object* obj)
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+  void ScanObject(mirror::Object* obj) REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+  void PushOnMarkStack(mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_);
+  void ResizeMarkStack(size_t new_size) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Computes the live-bytes prefix sums and the first object of every post-compact page.
+  void PrepareForCompaction() REQUIRES_SHARED(Locks::mutator_lock_);
+  // Updates the references held outside the moving space to the post-compact addresses.
+  void UpdateNonMovingReferences() REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
+  // Moves the pages of the moving space to the from-space and maps fresh pages in their place.
+  void MoveToFromSpace(size_t size);
+  void ReleaseFromSpace(uint8_t* begin, uint8_t* end);
+
+  // Compacts the objects which end up (partly) in the page with the given index into `dest`.
+  void CompactPage(size_t page_idx, uint8_t* dest) REQUIRES_SHARED(Locks::mutator_lock_);
+  // Claims the page with the given index, compacts and maps it, or waits until another thread
+  // has. Returns true if the page was compacted by this thread.
+  bool ConcurrentlyProcessPage(size_t page_idx, uint8_t* buffer)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+  void CopyIoctl(uint8_t* dst, uint8_t* buffer);
+  uint8_t* AcquireMutatorBuffer();
+  void ReleaseMutatorBuffer(uint8_t* buffer);
+
+  bool HasMovingAddress(const void* addr) const {
+    return moving_space_begin_ <= reinterpret_cast<const uint8_t*>(addr) &&
+           reinterpret_cast<const uint8_t*>(addr) < pre_compact_end_;
+  }
+  mirror::Object* FromSpaceAddress(mirror::Object* obj) const {
+    return reinterpret_cast<mirror::Object*>(reinterpret_cast<uint8_t*>(obj) + from_space_offset_);
+  }
+  void SetLiveWords(mirror::Object* obj, size_t size);
+  mirror::Object* PostCompactAddress(mirror::Object* obj) const;
+  void UpdateRef(mirror::HeapReference<mirror::Object>* ref)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+  void UpdateRoot(mirror::CompressedReference<mirror::Object>* root)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  accounting::ObjectStack* mark_stack_;
+  // Every object inside the immune spaces is assumed to be marked.
+  ImmuneSpaces immune_spaces_;
+  // Cached mark bitmap of the non-moving spaces as an optimization.
+  accounting::HeapBitmap* mark_bitmap_;
+  Thread* self_;
+
+  space::BumpPointerSpace* const moving_space_;
+  uint8_t* const moving_space_begin_;
+  // End of the moving space when the GC started; all the objects to compact are below it.
+  uint8_t* pre_compact_end_;
+  // End of the moving space once compacted.
+  uint8_t* post_compact_end_;
+  // Number of pages of the moving space which hold compacted objects.
+  size_t moving_pages_count_;
+  // The moving space has no mark bitmap of its own.
+  accounting::ContinuousSpaceBitmap moving_space_bitmap_;
+
+  // Holds the live-words bitmap, the chunk info vector, the first objects and the page states.
+  MemMap info_map_;
+  uintptr_t* live_words_bitmap_;
+  // For each kOffsetChunkSize chunk of the moving space, the number of live bytes before it once
+  // PrepareForCompaction() has run.
+  uint32_t* chunk_info_vec_;
+  // For each post-compact page, the offset in the moving space of the first object which ends
+  // up in that page.
+  uint32_t* first_objs_moving_space_;
+  Atomic<PageState>* moving_pages_status_;
+
+  // The pages of the moving space are moved here for the compaction.
+  MemMap from_space_map_;
+  ptrdiff_t from_space_offset_;
+  // One page for the GC thread followed by one page for each mutator buffer.
+  MemMap compaction_buffers_map_;
+  // Bit i is set if the buffer i of the mutators is free.
+  Atomic<uint64_t> free_mutator_buffers_;
+
+  int uffd_;
+  bool sigbus_handler_installed_;
+  // True once the references are updated to the post-compact addresses.
+  bool compacting_;
+  // True if the pause left the pages of the moving space for CompactionPhase() to compact.
+  bool concurrent_compaction_;
+  // Number of SIGBUS handlers in progress, ORed with kSigbusCounterCompactionDoneMask.
+  Atomic<uint32_t> sigbus_in_progress_count_;
+
+  // Moving objects holding native GC roots, whose roots are updated in the pause.
+  std::vector<mirror::Object*> native_root_holders_;
+
+  // How many objects and bytes of the moving space are live.
+  size_t live_objects_;
+  size_t live_bytes_;
+
+  // Number of pages compacted by the mutators, over the number of pages compacted concurrently.
+  Atomic<uint64_t> mutator_compacted_pages_;
+  uint64_t concurrently_compacted_pages_;
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(MarkCompact);
+};
+
+}  // namespace collector
+}  // namespace gc
+}  // namespace art
+
+#endif  // ART_RUNTIME_GC_COLLECTOR_MARK_COMPACT_H_
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mark_compact.h"
+
+#include <android-base/stringprintf.h>
+
+#include "class_linker-inl.h"
+#include "common_runtime_test.h"
+#include "gc/heap.h"
+#include "handle_scope-inl.h"
+#include "mirror/object-inl.h"
+#include "mirror/object_array-alloc-inl.h"
+#include "mirror/object_array-inl.h"
+#include "mirror/string-inl.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread_list.h"
+
+namespace art {
+namespace gc {
+namespace collector {
+
+using android::base::StringPrintf;
+
+class MarkCompactTest : public CommonRuntimeTest {
+ protected:
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    CommonRuntimeTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-Xgc:CMC", nullptr));
+  }
+};
+
+// Read barrier builds always use the concurrent copying collector.
+#define TEST_DISABLED_WITHOUT_MARK_COMPACT() \
+  if (Runtime::Current()->GetHeap()->MarkCompactCollector() == nullptr) { \
+    printf("WARNING: TEST DISABLED WITHOUT MARK-COMPACT COLLECTOR\n"); \
+    return; \
+  }
+
+// Interleave live objects with garbage in the moving space, run several mark-compact
+// collections, and check that the live objects moved and that the references to them, from a
+// handle and from other moved objects, were updated.
+TEST_F(MarkCompactTest, CompactionKeepsObjectsReachable) {
+  TEST_DISABLED_WITHOUT_MARK_COMPACT();
+  static constexpr size_t kNumObjects = 1024;
+  static constexpr size_t kNumCollections = 4;
+  Heap* heap = Runtime::Current()->GetHeap();
+  ASSERT_EQ(kCollectorTypeCMC, heap->CurrentCollectorType());
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<2> hs(soa.Self());
+  Handle<mirror::Class> c(
+      hs.NewHandle(class_linker_->FindSystemClass(soa.Self(), "[Ljava/lang/Object;")));
+  Handle<mirror::ObjectArray<mirror::Object>> live(hs.NewHandle(
+      mirror::ObjectArray<mirror::Object>::Alloc(soa.Self(), c.Get(), kNumObjects)));
+  ASSERT_TRUE(live != nullptr);
+  for (size_t i = 0; i < kNumObjects; ++i) {
+    // Garbage before each live object, so that compaction slides the live objects down.
+    ASSERT_TRUE(mirror::String::AllocFromModifiedUtf8(soa.Self(), "garbage") != nullptr);
+    ObjPtr<mirror::ObjectArray<mirror::Object>> holder =
+        mirror::ObjectArray<mirror::Object>::Alloc(soa.Self(), c.Get(), 1);
+    ASSERT_TRUE(holder != nullptr);
+    live->Set<false>(i, holder);
+    ObjPtr<mirror::String> string = mirror::String::AllocFromModifiedUtf8(
+        soa.Self(), StringPrintf("live %zu", i).c_str());
+    ASSERT_TRUE(string != nullptr);
+    live->Get(i)->AsObjectArray<mirror::Object>()->Set<false>(0, string);
+  }
+  ObjPtr<mirror::Object> last = live->Get(kNumObjects - 1);
+  ASSERT_TRUE(heap->IsMovableObject(last));
+  const uintptr_t last_address_before = reinterpret_cast<uintptr_t>(last.Ptr());
+
+  for (size_t gc = 0; gc < kNumCollections; ++gc) {
+    {
+      ScopedThreadSuspension sts(soa.Self(), kSuspended);
+      heap->CollectGarbage(/* clear_soft_references= */ false);
+    }
+    for (size_t i = 0; i < kNumObjects; ++i) {
+      ObjPtr<mirror::Object> holder = live->Get(i);
+      ASSERT_TRUE(holder != nullptr);
+      ASSERT_TRUE(holder->IsObjectArray());
+      ObjPtr<mirror::Object> string = holder->AsObjectArray<mirror::Object>()->Get(0);
+      ASSERT_TRUE(string != nullptr);
+      ASSERT_TRUE(string->IsString());
+      EXPECT_TRUE(string->AsString()->Equals(StringPrintf("live %zu", i).c_str())) << i;
+    }
+  }
+  EXPECT_NE(last_address_before, reinterpret_cast<uintptr_t>(live->Get(kNumObjects - 1).Ptr()));
+  ScopedThreadSuspension sts(soa.Self(), kSuspended);
+  ScopedSuspendAll ssa(__FUNCTION__);
+  EXPECT_EQ(0u, heap->VerifyHeapReferences());
+}
+
+}  // namespace collector
+}  // namespace gc
+}  // namespace art
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "semi_space.h"
+
+#include <android-base/stringprintf.h>
+#include <android-base/strings.h>
+
+#include "class_linker-inl.h"
+#include "class_root-inl.h"
+#include "common_runtime_test.h"
+#include "gc/heap.h"
+#include "gc/space/malloc_space.h"
+#include "handle_scope-inl.h"
+#include "mirror/array-alloc-inl.h"
+#include "mirror/array-inl.h"
+#include "mirror/object-inl.h"
+#include "mirror/object_array-alloc-inl.h"
+#include "mirror/object_array-inl.h"
+#include "mirror/string-inl.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art {
+namespace gc {
+namespace collector {
+
+using android::base::StringPrintf;
+
+class SemiSpaceTest : public CommonRuntimeTest {
+ protected:
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    CommonRuntimeTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-Xgc:GSS", nullptr));
+  }
+
+  // Runs a collection triggered by an allocation, which the generational semi-space collector
+  // limits to the bump pointer space unless too much was promoted since the last whole heap
+  // collection. Returns true if it was such a bump pointer space only collection.
+  static bool CollectForAlloc(Heap* heap) REQUIRES(!Locks::mutator_lock_) {
+    heap->CollectGarbage(/* clear_soft_references= */ false, kGcCauseForAlloc);
+    SemiSpace* collector = heap->SemiSpaceCollector();
+    EXPECT_TRUE(collector != nullptr);
+    return android::base::EndsWith(collector->GetName(), " bps");
+  }
+};
+
+// Read barrier builds always use the concurrent copying collector.
+#define TEST_DISABLED_WITHOUT_GENERATIONAL_SEMI_SPACE() \
+  if (Runtime::Current()->GetHeap()->CurrentCollectorType() != kCollectorTypeGSS) { \
+    printf("WARNING: TEST DISABLED WITHOUT GENERATIONAL SEMI-SPACE COLLECTOR\n"); \
+    return; \
+  }
+
+// A young object only referenced from an old object must be kept alive by the remembered set
+// of bump pointer space only collections, and be promoted once it survived a collection.
+TEST_F(SemiSpaceTest, OldToYoungReferenceSurvivesAndIsPromoted) {
+  TEST_DISABLED_WITHOUT_GENERATIONAL_SEMI_SPACE();
+  static constexpr size_t kNumCollections = 4;
+  Heap* heap = Runtime::Current()->GetHeap();
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<1> hs(soa.Self());
+  Handle<mirror::ObjectArray<mirror::Object>> old(hs.NewHandle(
+      mirror::ObjectArray<mirror::Object>::Alloc(
+          soa.Self(),
+          GetClassRoot<mirror::ObjectArray<mirror::Object>>(),
+          1,
+          heap->GetCurrentNonMovingAllocator())));
+  ASSERT_TRUE(old != nullptr);
+  ASSERT_FALSE(heap->IsMovableObject(old.Get()));
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    // Start from a whole heap collection, which resets the promotion counters.
+    heap->CollectGarbage(/* clear_soft_references= */ false);
+  }
+  // The old object is the only reference to the young string.
+  ObjPtr<mirror::String> young = mirror::String::AllocFromModifiedUtf8(soa.Self(), "young");
+  ASSERT_TRUE(young != nullptr);
+  ASSERT_FALSE(heap->GetPrimaryFreeListSpace()->HasAddress(young.Ptr()));
+  old->Set<false>(0, young);
+  young = nullptr;
+  for (size_t i = 0; i < kNumCollections; ++i) {
+    {
+      ScopedThreadSuspension sts(soa.Self(), kSuspended);
+      ASSERT_TRUE(CollectForAlloc(heap)) << i;
+    }
+    ObjPtr<mirror::Object> survivor = old->Get(0);
+    ASSERT_TRUE(survivor != nullptr) << i;
+    ASSERT_TRUE(survivor->IsString()) << i;
+    EXPECT_TRUE(survivor->AsString()->Equals("young")) << i;
+    // The first collection copies the young string within the bump pointer spaces, the second
+    // one promotes it to the main space.
+    EXPECT_EQ(i != 0u, heap->GetPrimaryFreeListSpace()->HasAddress(survivor.Ptr())) << i;
+  }
+}
+
+// Once enough bytes have been promoted, the next collection for an allocation collects the
+// whole heap, and the following ones are limited to the bump pointer space again.
+TEST_F(SemiSpaceTest, PromotionTriggersWholeHeapCollection) {
+  TEST_DISABLED_WITHOUT_GENERATIONAL_SEMI_SPACE();
+  // Keep promoting 1 MB until past the 4 MB promotion threshold of the collector.
+  static constexpr size_t kArraySize = 4 * KB;
+  static constexpr size_t kArraysPerBatch = MB / kArraySize;
+  static constexpr size_t kMaxBatches = 8;
+  Heap* heap = Runtime::Current()->GetHeap();
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<1> hs(soa.Self());
+  Handle<mirror::ObjectArray<mirror::Object>> live(hs.NewHandle(
+      mirror::ObjectArray<mirror::Object>::Alloc(
+          soa.Self(),
+          GetClassRoot<mirror::ObjectArray<mirror::Object>>(),
+          kMaxBatches * kArraysPerBatch)));
+  ASSERT_TRUE(live != nullptr);
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    heap->CollectGarbage(/* clear_soft_references= */ false);
+  }
+  size_t num_arrays = 0;
+  bool whole_heap_collection = false;
+  for (size_t batch = 0; batch < kMaxBatches && !whole_heap_collection; ++batch) {
+    for (size_t i = 0; i < kArraysPerBatch; ++i, ++num_arrays) {
+      ObjPtr<mirror::ByteArray> array = mirror::ByteArray::Alloc(soa.Self(), kArraySize);
+      ASSERT_TRUE(array != nullptr);
+      array->Set(0, static_cast<int8_t>(num_arrays));
+      live->Set<false>(num_arrays, array);
+    }
+    // The first collection copies the new arrays, the second one promotes them.
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    whole_heap_collection = !CollectForAlloc(heap) || !CollectForAlloc(heap);
+  }
+  ASSERT_TRUE(whole_heap_collection);
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    EXPECT_TRUE(CollectForAlloc(heap));
+  }
+  for (size_t i = 0; i < num_arrays; ++i) {
+    ObjPtr<mirror::Object> array = live->Get(i);
+    ASSERT_TRUE(array != nullptr) << StringPrintf("array %zu", i);
+    ASSERT_TRUE(array->IsByteArray()) << StringPrintf("array %zu", i);
+    EXPECT_EQ(static_cast<int8_t>(i), array->AsByteArray()->Get(0))
+        << StringPrintf("array %zu", i);
+  }
+}
+
+}  // namespace collector
+}  // namespace gc
+}  // namespace art
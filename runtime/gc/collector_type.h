@@ -32,12 +32,17 @@ enum CollectorType {
   kCollectorTypeCMS,
   // Semi-space / mark-sweep hybrid, enables compaction.
   kCollectorTypeSS,
+  // Generational semi-space: a bump pointer nursery whose survivors are promoted into the main
+  // malloc space, with card-based remembered sets for the old-to-young references.
+  kCollectorTypeGSS,
   // Heap trimming collector, doesn't do any actual collecting.
   kCollectorTypeHeapTrim,
   // A (mostly) concurrent copying collector.
   kCollectorTypeCC,
   // The background compaction of the concurrent copying collector.
   kCollectorTypeCCBackground,
+  // Concurrent mark-compact, using userfaultfd to compact concurrently without read barriers.
+  kCollectorTypeCMC,
   // Instrumentation critical section fake collector.
   kCollectorTypeInstrumentation,
   // Fake collector for adding or removing application image spaces.
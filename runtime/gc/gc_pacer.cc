@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gc_pacer.h"
+
+#include <algorithm>
+#include <ostream>
+
+#include "base/logging.h"
+#include "base/time_utils.h"
+
+namespace art {
+namespace gc {
+
+// Weight of the newest sample in the moving averages.
+static constexpr double kSampleWeight = 0.25;
+// Factors by which the multipliers move after a collection which missed, or comfortably met,
+// its target. Growing faster than shrinking makes the pacer react quickly to a latency problem
+// and give memory back slowly.
+static constexpr double kIncreaseFactor = 1.5;
+static constexpr double kDecreaseFactor = 0.9;
+
+GcPacer::GcPacer(uint64_t target_max_pause_ns, double target_gc_time_share)
+    : target_max_pause_ns_(target_max_pause_ns),
+      target_gc_time_share_(target_gc_time_share),
+      gc_time_share_(0.0),
+      last_end_time_ns_(0u),
+      growth_multiplier_(1.0),
+      headroom_multiplier_(1.0) {
+  DCHECK_GT(target_gc_time_share, 0.0);
+  std::fill_n(mean_max_pause_ns_, collector::kGcTypeMax, 0u);
+}
+
+void GcPacer::RecordCollection(collector::GcType gc_type,
+                               uint64_t end_time_ns,
+                               uint64_t duration_ns,
+                               uint64_t max_pause_ns) {
+  DCHECK(IsEnabled());
+  DCHECK_LT(gc_type, collector::kGcTypeMax);
+  uint64_t& mean_max_pause_ns = mean_max_pause_ns_[gc_type];
+  mean_max_pause_ns = (mean_max_pause_ns == 0u)
+      ? max_pause_ns
+      : static_cast<uint64_t>(kSampleWeight * max_pause_ns +
+                              (1.0 - kSampleWeight) * mean_max_pause_ns);
+  // The first collection has no period to compare its duration with.
+  if (last_end_time_ns_ != 0u && end_time_ns > last_end_time_ns_) {
+    double share =
+        std::min(static_cast<double>(duration_ns) / (end_time_ns - last_end_time_ns_), 1.0);
+    gc_time_share_ = kSampleWeight * share + (1.0 - kSampleWeight) * gc_time_share_;
+    if (gc_time_share_ > target_gc_time_share_) {
+      growth_multiplier_ = std::min(growth_multiplier_ * kIncreaseFactor, kMaxGrowthMultiplier);
+    } else if (gc_time_share_ < target_gc_time_share_ / 2) {
+      growth_multiplier_ = std::max(growth_multiplier_ * kDecreaseFactor, 1.0);
+    }
+  }
+  last_end_time_ns_ = end_time_ns;
+  // Only the latest pause drives the headroom, as a single long wait for a collection to finish
+  // is what we want to avoid.
+  if (max_pause_ns > target_max_pause_ns_) {
+    headroom_multiplier_ =
+        std::min(headroom_multiplier_ * kIncreaseFactor, kMaxHeadroomMultiplier);
+  } else if (max_pause_ns < target_max_pause_ns_ / 2) {
+    headroom_multiplier_ = std::max(headroom_multiplier_ * kDecreaseFactor, 1.0);
+  }
+}
+
+bool GcPacer::MeetsPauseTarget(collector::GcType gc_type) const {
+  return mean_max_pause_ns_[gc_type] <= target_max_pause_ns_;
+}
+
+bool GcPacer::PrefersStickyGc(collector::GcType non_sticky_gc_type) const {
+  return IsEnabled() &&
+         !MeetsPauseTarget(non_sticky_gc_type) &&
+         MeetsPauseTarget(collector::kGcTypeSticky);
+}
+
+void GcPacer::Dump(std::ostream& os) const {
+  if (!IsEnabled()) {
+    return;
+  }
+  os << "GC pacing: target max pause " << PrettyDuration(target_max_pause_ns_)
+     << ", target GC time share " << static_cast<int>(100 * target_gc_time_share_) << "%"
+     << ", measured GC time share " << static_cast<int>(100 * gc_time_share_) << "%"
+     << ", growth multiplier " << growth_multiplier_
+     << ", headroom multiplier " << headroom_multiplier_ << "\n";
+  for (int type = collector::kGcTypeSticky; type < collector::kGcTypeMax; ++type) {
+    if (mean_max_pause_ns_[type] != 0u) {
+      os << "GC pacing: mean max pause of " << static_cast<collector::GcType>(type) << " GCs "
+         << PrettyDuration(mean_max_pause_ns_[type]) << "\n";
+    }
+  }
+}
+
+}  // namespace gc
+}  // namespace art
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_GC_GC_PACER_H_
+#define ART_RUNTIME_GC_GC_PACER_H_
+
+#include <stdint.h>
+
+#include <iosfwd>
+
+#include "collector/gc_type.h"
+
+namespace art {
+namespace gc {
+
+// Steers the heap towards a target maximum pause and a maximum share of time spent collecting,
+// from the pauses and durations of the past collections. Heap::GrowForUtilization feeds it every
+// finished collection and applies its advice:
+// - the growth multiplier scales how much the heap grows after a collection: it goes up while
+//   collections take more than the target share of time, so that they run less often;
+// - the headroom multiplier scales how early a concurrent collection starts: it goes up while
+//   pauses exceed the target, which mostly happens when mutators run out of memory before the
+//   concurrent collection finishes and have to wait for it;
+// - sticky collections are preferred while non-sticky ones exceed the target pause.
+// Not thread-safe: the heap serializes the calls.
+class GcPacer {
+ public:
+  // The pacer is disabled when `target_max_pause_ns` is 0.
+  GcPacer(uint64_t target_max_pause_ns, double target_gc_time_share);
+
+  bool IsEnabled() const {
+    return target_max_pause_ns_ != 0u;
+  }
+
+  // Record a collection of type `gc_type` which ended at `end_time_ns`, took `duration_ns`, and
+  // paused the mutators for at most `max_pause_ns`.
+  void RecordCollection(collector::GcType gc_type,
+                        uint64_t end_time_ns,
+                        uint64_t duration_ns,
+                        uint64_t max_pause_ns);
+
+  double GetGrowthMultiplier() const {
+    return growth_multiplier_;
+  }
+
+  double GetHeadroomMultiplier() const {
+    return headroom_multiplier_;
+  }
+
+  // Whether the next collection should be a sticky one rather than one of type
+  // `non_sticky_gc_type`, as only the former is expected to meet the pause target.
+  bool PrefersStickyGc(collector::GcType non_sticky_gc_type) const;
+
+  void Dump(std::ostream& os) const;
+
+  // Bounds of the multipliers.
+  static constexpr double kMaxGrowthMultiplier = 4.0;
+  static constexpr double kMaxHeadroomMultiplier = 8.0;
+
+ private:
+  // Whether the recent collections of type `gc_type` met the pause target. Unknown types do.
+  bool MeetsPauseTarget(collector::GcType gc_type) const;
+
+  const uint64_t target_max_pause_ns_;
+  const double target_gc_time_share_;
+  // Moving averages of the maximum pause of the collections of each type, 0 if there was none.
+  uint64_t mean_max_pause_ns_[collector::kGcTypeMax];
+  // Moving average of the share of time spent collecting, measured between collection ends.
+  double gc_time_share_;
+  uint64_t last_end_time_ns_;
+  double growth_multiplier_;
+  double headroom_multiplier_;
+};
+
+}  // namespace gc
+}  // namespace art
+
+#endif  // ART_RUNTIME_GC_GC_PACER_H_
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gc_pacer.h"
+
+#include "base/time_utils.h"
+#include "gtest/gtest.h"
+
+namespace art {
+namespace gc {
+
+TEST(GcPacerTest, Disabled) {
+  GcPacer pacer(/*target_max_pause_ns=*/ 0u, /*target_gc_time_share=*/ 0.1);
+  EXPECT_FALSE(pacer.IsEnabled());
+  EXPECT_FALSE(pacer.PrefersStickyGc(collector::kGcTypeFull));
+  EXPECT_EQ(1.0, pacer.GetGrowthMultiplier());
+  EXPECT_EQ(1.0, pacer.GetHeadroomMultiplier());
+}
+
+TEST(GcPacerTest, LongPausesIncreaseHeadroom) {
+  GcPacer pacer(MsToNs(5), 0.1);
+  uint64_t now = MsToNs(1000);
+  for (size_t i = 0; i < 20; ++i) {
+    now += MsToNs(1000);
+    pacer.RecordCollection(collector::kGcTypeFull, now, MsToNs(10), MsToNs(20));
+  }
+  EXPECT_EQ(GcPacer::kMaxHeadroomMultiplier, pacer.GetHeadroomMultiplier());
+  // Short pauses bring the headroom back down, but not below 1.
+  for (size_t i = 0; i < 100; ++i) {
+    now += MsToNs(1000);
+    pacer.RecordCollection(collector::kGcTypeFull, now, MsToNs(10), MsToNs(1));
+  }
+  EXPECT_EQ(1.0, pacer.GetHeadroomMultiplier());
+}
+
+TEST(GcPacerTest, BusyCollectorGrowsHeap) {
+  GcPacer pacer(MsToNs(5), 0.1);
+  uint64_t now = MsToNs(1000);
+  // Collections take half of the time.
+  for (size_t i = 0; i < 20; ++i) {
+    now += MsToNs(100);
+    pacer.RecordCollection(collector::kGcTypeSticky, now, MsToNs(50), MsToNs(1));
+  }
+  EXPECT_EQ(GcPacer::kMaxGrowthMultiplier, pacer.GetGrowthMultiplier());
+  // Collections take 1% of the time.
+  for (size_t i = 0; i < 100; ++i) {
+    now += MsToNs(1000);
+    pacer.RecordCollection(collector::kGcTypeSticky, now, MsToNs(10), MsToNs(1));
+  }
+  EXPECT_EQ(1.0, pacer.GetGrowthMultiplier());
+}
+
+TEST(GcPacerTest, PrefersStickyWhenFullPausesAreTooLong) {
+  GcPacer pacer(MsToNs(5), 0.1);
+  uint64_t now = MsToNs(1000);
+  // No history: no preference.
+  EXPECT_FALSE(pacer.PrefersStickyGc(collector::kGcTypeFull));
+  now += MsToNs(1000);
+  pacer.RecordCollection(collector::kGcTypeFull, now, MsToNs(30), MsToNs(20));
+  EXPECT_TRUE(pacer.PrefersStickyGc(collector::kGcTypeFull));
+  now += MsToNs(1000);
+  pacer.RecordCollection(collector::kGcTypeSticky, now, MsToNs(30), MsToNs(20));
+  // Both kinds miss the target: let the throughput decide.
+  EXPECT_FALSE(pacer.PrefersStickyGc(collector::kGcTypeFull));
+}
+
+}  // namespace gc
+}  // namespace art
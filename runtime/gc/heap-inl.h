@@ -204,10 +204,8 @@ inline mirror::Object* Heap::AllocObjectWithAllocator(Thread* self,
       } else {
         TraceHeapSize(new_num_bytes_allocated);
       }
-      // IsGcConcurrent() isn't known at compile time so we can optimize by not checking it for the
-      // BumpPointer or TLAB allocators. This is nice since it allows the entire if statement to be
-      // optimized out. And for the other allocators, AllocatorMayHaveConcurrentGC is a constant
-      // since the allocator_type should be constant propagated.
+      // IsGcConcurrent() isn't known at compile time: the BumpPointer and TLAB allocators are used
+      // by both the semi-space and the concurrent mark-compact collectors.
       if (AllocatorMayHaveConcurrentGC(allocator) && IsGcConcurrent()
           && UNLIKELY(ShouldConcurrentGCForJava(new_num_bytes_allocated))) {
         need_gc = true;
@@ -37,6 +37,7 @@
 #include "base/logging.h"  // For VLOG.
 #include "base/memory_tool.h"
 #include "base/mutex.h"
+#include "base/numa.h"
 #include "base/os.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
@@ -54,6 +55,7 @@
 #include "gc/accounting/remembered_set.h"
 #include "gc/accounting/space_bitmap-inl.h"
 #include "gc/collector/concurrent_copying.h"
+#include "gc/collector/mark_compact.h"
 #include "gc/collector/mark_sweep.h"
 #include "gc/collector/partial_mark_sweep.h"
 #include "gc/collector/semi_space.h"
@@ -181,6 +183,9 @@ static constexpr uint32_t kAllocSpaceBeginForDeterministicAoT = 0x40000000;
 static constexpr bool kDumpRosAllocStatsOnSigQuit = false;
 
 static const char* kRegionSpaceName = "main space (region space)";
+// Capacity of each of the two bump pointer spaces which make up the GSS nursery. Survivors which
+// outgrow it are promoted into the main space, so it does not need to scale with the heap.
+static constexpr size_t kGSSBumpPointerSpaceCapacity = 32 * MB;
 
 // If true, we log all GCs in the both the foreground and background. Used for debugging.
 static constexpr bool kLogAllGCs = false;
@@ -282,7 +287,11 @@ Heap::Heap(size_t initial_size,
            bool use_generational_cc,
            uint64_t min_interval_homogeneous_space_compaction_by_oom,
            bool dump_region_info_before_gc,
-           bool dump_region_info_after_gc)
+           bool dump_region_info_after_gc,
+           bool use_numa_aware_allocation,
+           bool use_transparent_huge_pages,
+           uint64_t gc_pause_target,
+           double gc_time_share_target)
     : non_moving_space_(nullptr),
       rosalloc_space_(nullptr),
       dlmalloc_space_(nullptr),
@@ -321,6 +330,7 @@ Heap::Heap(size_t initial_size,
       // this one.
       process_state_update_lock_("process state update lock", kPostMonitorLock),
       min_foreground_target_footprint_(0),
+      gc_pacer_(gc_pause_target, gc_time_share_target),
       concurrent_start_bytes_(std::numeric_limits<size_t>::max()),
       total_bytes_freed_ever_(0),
       total_objects_freed_ever_(0),
@@ -361,6 +371,7 @@ Heap::Heap(size_t initial_size,
       verify_object_mode_(kVerifyObjectModeDisabled),
       disable_moving_gc_count_(0),
       semi_space_collector_(nullptr),
+      mark_compact_collector_(nullptr),
       active_concurrent_copying_collector_(nullptr),
       young_concurrent_copying_collector_(nullptr),
       concurrent_copying_collector_(nullptr),
@@ -376,6 +387,8 @@ Heap::Heap(size_t initial_size,
       pending_heap_trim_(nullptr),
       use_homogeneous_space_compaction_for_oom_(use_homogeneous_space_compaction_for_oom),
       use_generational_cc_(use_generational_cc),
+      use_numa_aware_allocation_(use_numa_aware_allocation),
+      use_transparent_huge_pages_(use_transparent_huge_pages),
       running_collection_is_blocking_(false),
       blocking_gc_count_(0U),
       blocking_gc_time_(0U),
@@ -426,8 +439,10 @@ Heap::Heap(size_t initial_size,
   live_bitmap_.reset(new accounting::HeapBitmap(this));
   mark_bitmap_.reset(new accounting::HeapBitmap(this));
 
-  // We don't have hspace compaction enabled with CC.
-  if (foreground_collector_type_ == kCollectorTypeCC) {
+  // We don't have hspace compaction enabled with GSS, CC or CMC.
+  if (foreground_collector_type_ == kCollectorTypeGSS ||
+      foreground_collector_type_ == kCollectorTypeCC ||
+      foreground_collector_type_ == kCollectorTypeCMC) {
     use_homogeneous_space_compaction_for_oom_ = false;
   }
   bool support_homogeneous_space_compaction =
@@ -440,6 +455,11 @@ Heap::Heap(size_t initial_size,
   bool separate_non_moving_space = is_zygote ||
       support_homogeneous_space_compaction || IsMovingGc(foreground_collector_type_) ||
       IsMovingGc(background_collector_type_);
+  if (foreground_collector_type_ == kCollectorTypeGSS) {
+    // Objects are promoted into the main space, which is never moved, so it doubles as the
+    // non-moving space.
+    separate_non_moving_space = false;
+  }
 
   // Requested begin for the alloc space, to follow the mapped image and oat files
   uint8_t* request_begin = nullptr;
@@ -590,13 +610,17 @@ Heap::Heap(size_t initial_size,
   if (foreground_collector_type_ == kCollectorTypeCC) {
     CHECK(separate_non_moving_space);
     // Reserve twice the capacity, to allow evacuating every region for explicit GCs.
-    MemMap region_space_mem_map =
-        space::RegionSpace::CreateMemMap(kRegionSpaceName, capacity_ * 2, request_begin);
+    MemMap region_space_mem_map = space::RegionSpace::CreateMemMap(
+        kRegionSpaceName, capacity_ * 2, request_begin, use_transparent_huge_pages_);
     CHECK(region_space_mem_map.IsValid()) << "No region space mem map";
     region_space_ = space::RegionSpace::Create(
-        kRegionSpaceName, std::move(region_space_mem_map), use_generational_cc_);
+        kRegionSpaceName,
+        std::move(region_space_mem_map),
+        use_generational_cc_,
+        use_numa_aware_allocation_);
     AddSpace(region_space_);
-  } else if (IsMovingGc(foreground_collector_type_)) {
+  } else if (IsMovingGc(foreground_collector_type_) &&
+             foreground_collector_type_ != kCollectorTypeGSS) {
     // Create bump pointer spaces.
     // We only to create the bump pointer if the foreground collector is a compacting GC.
     // TODO: Place bump-pointer spaces somewhere to minimize size of card table.
@@ -604,10 +628,13 @@ Heap::Heap(size_t initial_size,
                                                                     std::move(main_mem_map_1));
     CHECK(bump_pointer_space_ != nullptr) << "Failed to create bump pointer space";
     AddSpace(bump_pointer_space_);
-    temp_space_ = space::BumpPointerSpace::CreateFromMemMap("Bump pointer space 2",
-                                                            std::move(main_mem_map_2));
-    CHECK(temp_space_ != nullptr) << "Failed to create bump pointer space";
-    AddSpace(temp_space_);
+    // The mark-compact collector compacts within the bump pointer space.
+    if (main_mem_map_2.IsValid()) {
+      temp_space_ = space::BumpPointerSpace::CreateFromMemMap("Bump pointer space 2",
+                                                              std::move(main_mem_map_2));
+      CHECK(temp_space_ != nullptr) << "Failed to create bump pointer space";
+      AddSpace(temp_space_);
+    }
     CHECK(separate_non_moving_space);
   } else {
     CreateMainMallocSpace(std::move(main_mem_map_1), initial_size, growth_limit_, capacity_);
@@ -617,7 +644,19 @@ Heap::Heap(size_t initial_size,
       non_moving_space_ = main_space_;
       CHECK(!non_moving_space_->CanMoveObjects());
     }
-    if (main_mem_map_2.IsValid()) {
+    if (foreground_collector_type_ == kCollectorTypeGSS) {
+      CHECK_EQ(foreground_collector_type_, background_collector_type_);
+      // The nursery is a pair of bump pointer spaces instead of a backup main space.
+      DCHECK(!main_mem_map_2.IsValid());
+      bump_pointer_space_ = space::BumpPointerSpace::Create("Bump pointer space 1",
+                                                            kGSSBumpPointerSpaceCapacity);
+      CHECK(bump_pointer_space_ != nullptr) << "Failed to create bump pointer space";
+      AddSpace(bump_pointer_space_);
+      temp_space_ = space::BumpPointerSpace::Create("Bump pointer space 2",
+                                                    kGSSBumpPointerSpaceCapacity);
+      CHECK(temp_space_ != nullptr) << "Failed to create bump pointer space";
+      AddSpace(temp_space_);
+    } else if (main_mem_map_2.IsValid()) {
       const char* name = kUseRosAlloc ? kRosAllocSpaceName[1] : kDlMallocSpaceName[1];
       main_space_backup_.reset(CreateMallocSpaceFromMemMap(std::move(main_mem_map_2),
                                                            initial_size,
@@ -636,6 +675,10 @@ Heap::Heap(size_t initial_size,
   if (large_object_space_type == space::LargeObjectSpaceType::kFreeList) {
     large_object_space_ = space::FreeListSpace::Create("free list large object space", capacity_);
     CHECK(large_object_space_ != nullptr) << "Failed to create large object space";
+  } else if (large_object_space_type == space::LargeObjectSpaceType::kSegregatedFreeList) {
+    large_object_space_ = space::SegregatedFreeListSpace::Create(
+        "segregated free list large object space", capacity_);
+    CHECK(large_object_space_ != nullptr) << "Failed to create large object space";
   } else if (large_object_space_type == space::LargeObjectSpaceType::kMap) {
     large_object_space_ = space::LargeObjectMapSpace::Create("mem map large object space");
     CHECK(large_object_space_ != nullptr) << "Failed to create large object space";
@@ -669,6 +712,9 @@ Heap::Heap(size_t initial_size,
   card_table_.reset(accounting::CardTable::Create(reinterpret_cast<uint8_t*>(kMinHeapAddress),
                                                   4 * GB - kMinHeapAddress));
   CHECK(card_table_.get() != nullptr) << "Failed to create card table";
+  if (use_transparent_huge_pages_) {
+    AdviseHugePages();
+  }
   if (foreground_collector_type_ == kCollectorTypeCC && kUseTableLookupReadBarrier) {
     rb_table_.reset(new accounting::ReadBarrierTable());
     DCHECK(rb_table_->IsAllCleared());
@@ -728,11 +774,17 @@ Heap::Heap(size_t initial_size,
   }
   if (kMovingCollector) {
     if (MayUseCollector(kCollectorTypeSS) ||
+        MayUseCollector(kCollectorTypeGSS) ||
         MayUseCollector(kCollectorTypeHomogeneousSpaceCompact) ||
         use_homogeneous_space_compaction_for_oom_) {
-      semi_space_collector_ = new collector::SemiSpace(this);
+      const bool generational = foreground_collector_type_ == kCollectorTypeGSS;
+      semi_space_collector_ = new collector::SemiSpace(this, generational);
       garbage_collectors_.push_back(semi_space_collector_);
     }
+    if (MayUseCollector(kCollectorTypeCMC)) {
+      mark_compact_collector_ = new collector::MarkCompact(this);
+      garbage_collectors_.push_back(mark_compact_collector_);
+    }
     if (MayUseCollector(kCollectorTypeCC)) {
       concurrent_copying_collector_ = new collector::ConcurrentCopying(this,
                                                                        /*young_gen=*/false,
@@ -879,7 +931,8 @@ void Heap::CreateMainMallocSpace(MemMap&& mem_map,
   if (kCompactZygote && Runtime::Current()->IsZygote() && !can_move_objects) {
     // After the zygote we want this to be false if we don't have background compaction enabled so
     // that getting primitive array elements is faster.
-    can_move_objects = !HasZygoteSpace();
+    // GSS promotes into the main space and never compacts it, so it never needs to move objects.
+    can_move_objects = !HasZygoteSpace() && foreground_collector_type_ != kCollectorTypeGSS;
   }
   if (collector::SemiSpace::kUseRememberedSet && main_space_ != nullptr) {
     RemoveRememberedSet(main_space_);
@@ -1062,7 +1115,41 @@ void Heap::CreateThreadPool() {
   const size_t num_threads = std::max(parallel_gc_threads_, conc_gc_threads_);
   if (num_threads != 0) {
     thread_pool_.reset(new ThreadPool("Heap thread pool", num_threads));
+    const size_t num_numa_nodes = GetNumaNodeCount();
+    if (use_numa_aware_allocation_ && num_numa_nodes > 1U) {
+      // Spread the workers over the NUMA nodes so that the regions they evacuate objects to come
+      // from the pool of the node they run on.
+      const std::vector<ThreadPoolWorker*>& workers = thread_pool_->GetWorkers();
+      for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->SetCpuAffinity(GetNumaNodeCpus(i % num_numa_nodes));
+      }
+    }
+  }
+}
+
+void Heap::AdviseHugePages() {
+  for (space::ContinuousSpace* space : continuous_spaces_) {
+    if (space->IsContinuousMemMapAllocSpace() &&
+        !AdviseHugePages(space->AsContinuousMemMapAllocSpace())) {
+      // Most likely the kernel does not support transparent huge pages; don't insist.
+      return;
+    }
+  }
+}
+
+bool Heap::AdviseHugePages(space::ContinuousMemMapAllocSpace* alloc_space) {
+  bool success = alloc_space->GetMemMap()->AdviseHugePages(/*enable=*/ true) &&
+                 card_table_->AdviseHugePages(alloc_space->Begin(), alloc_space->Limit());
+  for (accounting::ContinuousSpaceBitmap* bitmap :
+           { alloc_space->GetLiveBitmap(), alloc_space->GetMarkBitmap() }) {
+    if (success && bitmap != nullptr && bitmap->IsValid()) {
+      success = bitmap->GetMemMap()->AdviseHugePages(/*enable=*/ true);
+    }
+  }
+  if (!success) {
+    PLOG(WARNING) << "Failed to back " << alloc_space->GetName() << " with huge pages";
   }
+  return success;
 }
 
 void Heap::MarkAllocStackAsLive(accounting::ObjectStack* stack) {
@@ -1246,6 +1333,15 @@ void Heap::DumpGcPerformanceInfo(std::ostream& os) {
     rosalloc_space_->DumpStats(os);
   }
 
+  if (region_space_ != nullptr) {
+    region_space_->DumpRegionAgeStats(os);
+  }
+
+  {
+    MutexLock mu(Thread::Current(), process_state_update_lock_);
+    gc_pacer_.Dump(os);
+  }
+
   os << "Native bytes total: " << GetNativeBytes()
      << " registered: " << native_bytes_registered_.load(std::memory_order_relaxed) << "\n";
 
@@ -1490,23 +1586,50 @@ void Heap::DoPendingCollectorTransition() {
 }
 
 void Heap::Trim(Thread* self) {
+  TrimProgress progress;
+  bool done = TrimSlice(self, &progress, std::numeric_limits<uint64_t>::max());
+  DCHECK(done);
+}
+
+bool Heap::TrimSlice(Thread* self, TrimProgress* progress, uint64_t deadline_ns) {
   Runtime* const runtime = Runtime::Current();
-  if (!CareAboutPauseTimes()) {
-    // Deflate the monitors, this can cause a pause but shouldn't matter since we don't care
-    // about pauses.
-    ScopedTrace trace("Deflating monitors");
-    // Avoid race conditions on the lock word for CC.
-    ScopedGCCriticalSection gcs(self, kGcCauseTrim, kCollectorTypeHeapTrim);
-    ScopedSuspendAll ssa(__FUNCTION__);
-    uint64_t start_time = NanoTime();
-    size_t count = runtime->GetMonitorList()->DeflateMonitors();
-    VLOG(heap) << "Deflating " << count << " monitors took "
-        << PrettyDuration(NanoTime() - start_time);
-  }
-  TrimIndirectReferenceTables(self);
-  TrimSpaces(self);
-  // Trim arenas that may have been used by JIT or verifier.
-  runtime->GetArenaPool()->TrimMaps();
+  do {
+    switch (progress->phase) {
+      case TrimPhase::kDeflateMonitors:
+        if (!CareAboutPauseTimes()) {
+          // Deflate the monitors, this can cause a pause but shouldn't matter since we don't care
+          // about pauses.
+          ScopedTrace trace("Deflating monitors");
+          // Avoid race conditions on the lock word for CC.
+          ScopedGCCriticalSection gcs(self, kGcCauseTrim, kCollectorTypeHeapTrim);
+          ScopedSuspendAll ssa(__FUNCTION__);
+          uint64_t start_time = NanoTime();
+          size_t count = runtime->GetMonitorList()->DeflateMonitors();
+          VLOG(heap) << "Deflating " << count << " monitors took "
+              << PrettyDuration(NanoTime() - start_time);
+        }
+        progress->phase = TrimPhase::kIndirectReferenceTables;
+        break;
+      case TrimPhase::kIndirectReferenceTables:
+        TrimIndirectReferenceTables(self);
+        progress->phase = TrimPhase::kSpaces;
+        break;
+      case TrimPhase::kSpaces:
+        if (TrimSpaces(self, progress, deadline_ns)) {
+          progress->phase = TrimPhase::kArenaPool;
+        }
+        break;
+      case TrimPhase::kArenaPool:
+        // Trim arenas that may have been used by JIT or verifier.
+        runtime->GetArenaPool()->TrimMaps();
+        progress->phase = TrimPhase::kDone;
+        break;
+      case TrimPhase::kDone:
+        LOG(FATAL) << "Unreachable";
+        UNREACHABLE();
+    }
+  } while (progress->phase != TrimPhase::kDone && NanoTime() < deadline_ns);
+  return progress->phase == TrimPhase::kDone;
 }
 
 class TrimIndirectReferenceTableClosure : public Closure {
@@ -1552,30 +1675,63 @@ void Heap::StartGC(Thread* self, GcCause cause, CollectorType collector_type) {
   thread_running_gc_ = self;
 }
 
-void Heap::TrimSpaces(Thread* self) {
+bool Heap::TrimSpaces(Thread* self, TrimProgress* progress, uint64_t deadline_ns) {
   // Pretend we are doing a GC to prevent background compaction from deleting the space we are
-  // trimming.
+  // trimming. This is only held for one slice so that GCs can run between the slices.
   StartGC(self, kGcCauseTrim, kCollectorTypeHeapTrim);
   ScopedTrace trace(__PRETTY_FUNCTION__);
   const uint64_t start_ns = NanoTime();
+  bool done;
   // Trim the managed spaces.
   uint64_t total_alloc_space_allocated = 0;
   uint64_t total_alloc_space_size = 0;
-  uint64_t managed_reclaimed = 0;
   {
     ScopedObjectAccess soa(self);
-    for (const auto& space : continuous_spaces_) {
-      if (space->IsMallocSpace()) {
-        gc::space::MallocSpace* malloc_space = space->AsMallocSpace();
-        if (malloc_space->IsRosAllocSpace() || !CareAboutPauseTimes()) {
+    // Background compaction may have replaced the spaces since the previous slice, in which case
+    // we resume part way through a different space. This only means we skip releasing some pages.
+    while (progress->space_index < continuous_spaces_.size()) {
+      space::ContinuousSpace* space = continuous_spaces_[progress->space_index];
+      bool space_done = true;
+      if (space->IsRosAllocSpace()) {
+        space_done = space->AsRosAllocSpace()->TrimUntil(deadline_ns,
+                                                         &progress->space_cursor,
+                                                         &progress->spaces_reclaimed_bytes);
+      } else if (space->IsMallocSpace()) {
+        if (!CareAboutPauseTimes()) {
           // Don't trim dlmalloc spaces if we care about pauses since this can hold the space lock
           // for a long period of time.
-          managed_reclaimed += malloc_space->Trim();
+          progress->spaces_reclaimed_bytes += space->AsMallocSpace()->Trim();
+        }
+      } else if (space == region_space_ && use_transparent_huge_pages_) {
+        space_done = region_space_->ReleaseFreeRegionsUntil(deadline_ns,
+                                                            &progress->space_cursor,
+                                                            &progress->spaces_reclaimed_bytes);
+      }
+      if (space_done) {
+        ++progress->space_index;
+        progress->space_cursor = 0u;
+      }
+      if (NanoTime() >= deadline_ns) {
+        break;
+      }
+    }
+    done = progress->space_index >= continuous_spaces_.size();
+    if (done) {
+      for (const auto& space : continuous_spaces_) {
+        if (space->IsMallocSpace()) {
+          total_alloc_space_size += space->AsMallocSpace()->Size();
         }
-        total_alloc_space_size += malloc_space->Size();
       }
     }
   }
+  uint64_t gc_heap_end_ns = NanoTime();
+  // We never move things in the native heap, so we can finish the GC at this point.
+  FinishGC(self, collector::kGcTypeNone);
+  progress->spaces_duration_ns += gc_heap_end_ns - start_ns;
+  if (!done) {
+    return false;
+  }
+
   total_alloc_space_allocated = GetBytesAllocated();
   if (large_object_space_ != nullptr) {
     total_alloc_space_allocated -= large_object_space_->GetBytesAllocated();
@@ -1588,13 +1744,11 @@ void Heap::TrimSpaces(Thread* self) {
   }
   const float managed_utilization = static_cast<float>(total_alloc_space_allocated) /
       static_cast<float>(total_alloc_space_size);
-  uint64_t gc_heap_end_ns = NanoTime();
-  // We never move things in the native heap, so we can finish the GC at this point.
-  FinishGC(self, collector::kGcTypeNone);
-
-  VLOG(heap) << "Heap trim of managed (duration=" << PrettyDuration(gc_heap_end_ns - start_ns)
-      << ", advised=" << PrettySize(managed_reclaimed) << ") heap. Managed heap utilization of "
-      << static_cast<int>(100 * managed_utilization) << "%.";
+  VLOG(heap) << "Heap trim of managed (duration=" << PrettyDuration(progress->spaces_duration_ns)
+      << ", advised=" << PrettySize(progress->spaces_reclaimed_bytes)
+      << ") heap. Managed heap utilization of " << static_cast<int>(100 * managed_utilization)
+      << "%.";
+  return true;
 }
 
 bool Heap::IsValidObjectAddress(const void* addr) const {
@@ -2146,7 +2300,9 @@ void Heap::ChangeCollector(CollectorType collector_type) {
         }
         break;
       }
-      case kCollectorTypeSS: {
+      case kCollectorTypeSS:
+      case kCollectorTypeGSS:
+      case kCollectorTypeCMC: {
         gc_plan_.push_back(collector::kGcTypeFull);
         if (use_tlab_) {
           ChangeAllocator(kAllocatorTypeTLAB);
@@ -2188,7 +2344,7 @@ void Heap::ChangeCollector(CollectorType collector_type) {
 class ZygoteCompactingCollector final : public collector::SemiSpace {
  public:
   ZygoteCompactingCollector(gc::Heap* heap, bool is_running_on_memory_tool)
-      : SemiSpace(heap, "zygote collector"),
+      : SemiSpace(heap, /*generational=*/ false, "zygote collector"),
         bin_live_bitmap_(nullptr),
         bin_mark_bitmap_(nullptr),
         is_running_on_memory_tool_(is_running_on_memory_tool) {}
@@ -2370,6 +2526,9 @@ void Heap::PreZygoteFork() {
                             mem_map.Size());
       delete old_main_space;
       AddSpace(main_space_);
+      if (use_transparent_huge_pages_) {
+        AdviseHugePages(main_space_);
+      }
     } else {
       if (collector_type_ == kCollectorTypeCC) {
         region_space_->GetMemMap()->Protect(PROT_READ | PROT_WRITE);
@@ -2420,6 +2579,10 @@ void Heap::PreZygoteFork() {
   AddSpace(zygote_space_);
   non_moving_space_->SetFootprintLimit(non_moving_space_->Capacity());
   AddSpace(non_moving_space_);
+  if (use_transparent_huge_pages_) {
+    // The new alloc space has fresh bitmaps and is where the app allocates non-movable objects.
+    AdviseHugePages(non_moving_space_);
+  }
   constexpr bool set_mark_bit = kUseBakerReadBarrier
                                 && gc::collector::ConcurrentCopying::kGrayDirtyImmuneObjects;
   if (set_mark_bit) {
@@ -2650,11 +2813,15 @@ collector::GcType Heap::CollectGarbageInternal(collector::GcType gc_type,
            current_allocator_ == kAllocatorTypeRegionTLAB);
     switch (collector_type_) {
       case kCollectorTypeSS:
+      case kCollectorTypeGSS:
         semi_space_collector_->SetFromSpace(bump_pointer_space_);
         semi_space_collector_->SetToSpace(temp_space_);
         semi_space_collector_->SetSwapSemiSpaces(true);
         collector = semi_space_collector_;
         break;
+      case kCollectorTypeCMC:
+        collector = mark_compact_collector_;
+        break;
       case kCollectorTypeCC:
         collector::ConcurrentCopying* active_cc_collector;
         if (use_generational_cc_) {
@@ -2673,7 +2840,7 @@ collector::GcType Heap::CollectGarbageInternal(collector::GcType gc_type,
       default:
         LOG(FATAL) << "Invalid collector type " << static_cast<size_t>(collector_type_);
     }
-    if (collector != active_concurrent_copying_collector_.load(std::memory_order_relaxed)) {
+    if (collector == semi_space_collector_) {
       temp_space_->GetMemMap()->Protect(PROT_READ | PROT_WRITE);
       if (kIsDebugBuild) {
         // Try to read each page of the memory map in case mprotect didn't work properly b/19894268.
@@ -3551,9 +3718,26 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
   TraceHeapSize(bytes_allocated);
   uint64_t target_size, grow_bytes;
   collector::GcType gc_type = collector_ran->GetGcType();
+  bool is_blocking;
+  {
+    MutexLock mu(Thread::Current(), *gc_complete_lock_);
+    is_blocking = running_collection_is_blocking_;
+  }
   MutexLock mu(Thread::Current(), process_state_update_lock_);
-  // Use the multiplier to grow more for foreground.
-  const double multiplier = HeapGrowthMultiplier();
+  if (gc_pacer_.IsEnabled()) {
+    // Mutators waiting for a blocking GC were paused for all of its duration.
+    uint64_t max_pause_ns = current_gc_iteration_.GetDurationNs();
+    if (!is_blocking) {
+      const std::vector<uint64_t>& pause_times = current_gc_iteration_.GetPauseTimes();
+      max_pause_ns = pause_times.empty()
+          ? 0u
+          : *std::max_element(pause_times.begin(), pause_times.end());
+    }
+    gc_pacer_.RecordCollection(
+        gc_type, NanoTime(), current_gc_iteration_.GetDurationNs(), max_pause_ns);
+  }
+  // Use the multiplier to grow more for foreground, and more again if GCs take too much time.
+  const double multiplier = HeapGrowthMultiplier() * gc_pacer_.GetGrowthMultiplier();
   if (gc_type != collector::kGcTypeSticky) {
     // Grow the heap for non sticky GC.
     uint64_t delta = bytes_allocated * (1.0 / GetTargetHeapUtilization() - 1.0);
@@ -3581,10 +3765,14 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
     // concurrent_start_bytes in case of concurrent GCs, in order to prevent a
     // pathological case where dead objects which aren't reclaimed by sticky could get accumulated
     // if the sticky GC throughput always remained >= the full/partial throughput.
+    // With a pause target, we also do another sticky collection if only sticky collections
+    // meet it.
     size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
-    if (current_gc_iteration_.GetEstimatedThroughput() * sticky_gc_throughput_adjustment >=
-        non_sticky_collector->GetEstimatedMeanThroughput() &&
-        non_sticky_collector->NumberOfIterations() > 0 &&
+    const bool sticky_gc_is_faster =
+        current_gc_iteration_.GetEstimatedThroughput() * sticky_gc_throughput_adjustment >=
+            non_sticky_collector->GetEstimatedMeanThroughput() &&
+        non_sticky_collector->NumberOfIterations() > 0;
+    if ((sticky_gc_is_faster || gc_pacer_.PrefersStickyGc(non_sticky_gc_type)) &&
         bytes_allocated <= (IsGcConcurrent() ? concurrent_start_bytes_ : target_footprint)) {
       next_gc_type_ = collector::kGcTypeSticky;
     } else {
@@ -3628,6 +3816,13 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
       remaining_bytes = std::min(remaining_bytes, kMaxConcurrentRemainingBytes);
       remaining_bytes = std::max(remaining_bytes, kMinConcurrentRemainingBytes);
       size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
+      if (gc_pacer_.IsEnabled()) {
+        // Start earlier when pauses exceed the target, so that the GC finishes before mutators run
+        // out of memory, but never in the first half of the footprint.
+        remaining_bytes = std::min(
+            static_cast<size_t>(remaining_bytes * gc_pacer_.GetHeadroomMultiplier()),
+            std::max(target_footprint / 2, remaining_bytes));
+      }
       if (UNLIKELY(remaining_bytes > target_footprint)) {
         // A never going to happen situation that from the estimated allocation rate we will exceed
         // the applications entire footprint with the given estimated allocation rate. Schedule
@@ -3836,12 +4031,21 @@ void Heap::RequestCollectorTransition(CollectorType desired_collector_type, uint
 
 class Heap::HeapTrimTask : public HeapTask {
  public:
-  explicit HeapTrimTask(uint64_t delta_time) : HeapTask(NanoTime() + delta_time) { }
+  HeapTrimTask(uint64_t delta_time, const TrimProgress& progress)
+      : HeapTask(NanoTime() + delta_time), progress_(progress) { }
   void Run(Thread* self) override {
     gc::Heap* heap = Runtime::Current()->GetHeap();
-    heap->Trim(self);
-    heap->ClearPendingTrim(self);
+    // Only run a bounded slice of the trim so that it never holds off GCs and allocations for
+    // long, and leave the rest of it to a follow-up task.
+    if (heap->TrimSlice(self, &progress_, NanoTime() + kHeapTrimSliceBudget)) {
+      heap->ClearPendingTrim(self);
+    } else {
+      heap->ContinuePendingTrim(self, progress_);
+    }
   }
+
+ private:
+  TrimProgress progress_;
 };
 
 void Heap::ClearPendingTrim(Thread* self) {
@@ -3849,6 +4053,21 @@ void Heap::ClearPendingTrim(Thread* self) {
   pending_heap_trim_ = nullptr;
 }
 
+void Heap::ContinuePendingTrim(Thread* self, const TrimProgress& progress) {
+  if (!CanAddHeapTask(self)) {
+    ClearPendingTrim(self);
+    return;
+  }
+  // Keep `pending_heap_trim_` set while the trim is in progress, so that trim requests made in the
+  // meantime are ignored rather than starting over.
+  HeapTrimTask* added_task = new HeapTrimTask(kHeapTrimSliceWait, progress);
+  {
+    MutexLock mu(self, *pending_task_lock_);
+    pending_heap_trim_ = added_task;
+  }
+  task_processor_->AddTask(self, added_task);
+}
+
 void Heap::RequestTrim(Thread* self) {
   if (!CanAddHeapTask(self)) {
     return;
@@ -3872,7 +4091,7 @@ void Heap::RequestTrim(Thread* self) {
       // Already have a heap trim request in task processor, ignore this request.
       return;
     }
-    added_task = new HeapTrimTask(kHeapTrimWait);
+    added_task = new HeapTrimTask(kHeapTrimWait, TrimProgress());
     pending_heap_trim_ = added_task;
   }
   task_processor_->AddTask(self, added_task);
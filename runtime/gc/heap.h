@@ -36,6 +36,7 @@
 #include "gc/collector/iteration.h"
 #include "gc/collector_type.h"
 #include "gc/gc_cause.h"
+#include "gc/gc_pacer.h"
 #include "gc/space/large_object_space.h"
 #include "handle.h"
 #include "obj_ptr.h"
@@ -87,6 +88,7 @@ class RememberedSet;
 namespace collector {
 class ConcurrentCopying;
 class GarbageCollector;
+class MarkCompact;
 class MarkSweep;
 class SemiSpace;
 }  // namespace collector
@@ -143,6 +145,8 @@ class Heap {
   static constexpr size_t kDefaultLongGCLogThreshold = MsToNs(100);
   static constexpr size_t kDefaultTLABSize = 32 * KB;
   static constexpr double kDefaultTargetUtilization = 0.75;
+  // Default maximum share of time spent collecting, when pacing the GC for a pause target.
+  static constexpr double kDefaultGcTimeShareTarget = 0.1;
   static constexpr double kDefaultHeapGrowthMultiplier = 2.0;
   // Primitive arrays larger than this size are put in the large object space.
   static constexpr size_t kMinLargeObjectThreshold = 3 * kPageSize;
@@ -179,6 +183,10 @@ class Heap {
 
   // How often we allow heap trimming to happen (nanoseconds).
   static constexpr uint64_t kHeapTrimWait = MsToNs(5000);
+  // How long one slice of a background heap trim may run before yielding (nanoseconds).
+  static constexpr uint64_t kHeapTrimSliceBudget = MsToNs(2);
+  // How long we wait before running the next slice of a background heap trim (nanoseconds).
+  static constexpr uint64_t kHeapTrimSliceWait = MsToNs(20);
   // How long we wait after a transition request to perform a collector transition (nanoseconds).
   static constexpr uint64_t kCollectorTransitionWait = MsToNs(5000);
   // Whether the transition-wait applies or not. Zero wait will stress the
@@ -225,7 +233,11 @@ class Heap {
        bool use_generational_cc,
        uint64_t min_interval_homogeneous_space_compaction_by_oom,
        bool dump_region_info_before_gc,
-       bool dump_region_info_after_gc);
+       bool dump_region_info_after_gc,
+       bool use_numa_aware_allocation,
+       bool use_transparent_huge_pages,
+       uint64_t gc_pause_target,
+       double gc_time_share_target);
 
   ~Heap();
 
@@ -630,7 +642,8 @@ class Heap {
   void DoPendingCollectorTransition()
       REQUIRES(!*gc_complete_lock_, !*pending_task_lock_, !process_state_update_lock_);
 
-  // Deflate monitors, ... and trim the spaces.
+  // Deflate monitors, ... and trim the spaces. Runs all the trim phases back to back, unlike the
+  // background trim task which spreads them over time slices.
   void Trim(Thread* self) REQUIRES(!*gc_complete_lock_);
 
   void RevokeThreadLocalBuffers(Thread* thread);
@@ -749,11 +762,17 @@ class Heap {
 
   // GC performance measuring
   void DumpGcPerformanceInfo(std::ostream& os)
-      REQUIRES(!*gc_complete_lock_);
+      REQUIRES(!*gc_complete_lock_, !process_state_update_lock_);
   void ResetGcPerformanceInfo() REQUIRES(!*gc_complete_lock_);
 
   // Thread pool.
   void CreateThreadPool();
+
+  // Advise the kernel to back the continuous alloc spaces, their bitmaps and the cards covering
+  // them with transparent huge pages.
+  void AdviseHugePages();
+  // Same for a single space. Returns false if the kernel refused the advice.
+  bool AdviseHugePages(space::ContinuousMemMapAllocSpace* alloc_space);
   void DeleteThreadPool();
   ThreadPool* GetThreadPool() {
     return thread_pool_.get();
@@ -804,6 +823,22 @@ class Heap {
     return active_collector;
   }
 
+  // Returns the mark-compact collector, or null if it is not used.
+  collector::MarkCompact* MarkCompactCollector() {
+    return mark_compact_collector_;
+  }
+
+  // Returns the semi-space collector, or null if it is not used.
+  collector::SemiSpace* SemiSpaceCollector() {
+    return semi_space_collector_;
+  }
+
+  // Classes are not moved by the mark-compact collector, which needs them to walk the objects
+  // of a page while the page is being compacted.
+  bool CanMoveClasses() const {
+    return kMovingClasses && foreground_collector_type_ != kCollectorTypeCMC;
+  }
+
   CollectorType CurrentCollectorType() {
     return collector_type_;
   }
@@ -964,6 +999,27 @@ class Heap {
   class ConcurrentGCTask;
   class CollectorTransitionTask;
   class HeapTrimTask;
+
+  // The phases of a heap trim, in the order they run.
+  enum class TrimPhase : uint8_t {
+    kDeflateMonitors,
+    kIndirectReferenceTables,
+    kSpaces,
+    kArenaPool,
+    kDone,
+  };
+
+  // How far an incremental heap trim got, carried from one trim slice to the next.
+  struct TrimProgress {
+    TrimPhase phase = TrimPhase::kDeflateMonitors;
+    // Index in `continuous_spaces_` of the space being trimmed.
+    size_t space_index = 0u;
+    // Page or region of that space to resume releasing memory from.
+    size_t space_cursor = 0u;
+    // Time spent and bytes released by the kSpaces phase so far.
+    uint64_t spaces_duration_ns = 0u;
+    size_t spaces_reclaimed_bytes = 0u;
+  };
   class TriggerPostForkCCGcTask;
 
   // Compact source space to target space. Returns the collector used.
@@ -1006,20 +1062,23 @@ class Heap {
         allocator_type != kAllocatorTypeTLAB &&
         allocator_type != kAllocatorTypeRegion;
   }
-  static ALWAYS_INLINE bool AllocatorMayHaveConcurrentGC(AllocatorType allocator_type) {
+  ALWAYS_INLINE bool AllocatorMayHaveConcurrentGC(AllocatorType allocator_type) const {
     if (kUseReadBarrier) {
-      // Read barrier may have the TLAB allocator but is always concurrent. TODO: clean this up.
+      // Read barrier may have the TLAB allocator but is always concurrent.
       return true;
     }
-    return
-        allocator_type != kAllocatorTypeTLAB &&
-        allocator_type != kAllocatorTypeBumpPointer;
+    // The TLAB and bump pointer allocators are only used with a concurrent collector when that
+    // collector is the mark-compact one.
+    return mark_compact_collector_ != nullptr ||
+        (allocator_type != kAllocatorTypeTLAB && allocator_type != kAllocatorTypeBumpPointer);
   }
   static bool IsMovingGc(CollectorType collector_type) {
     return
         collector_type == kCollectorTypeCC ||
         collector_type == kCollectorTypeSS ||
+        collector_type == kCollectorTypeGSS ||
         collector_type == kCollectorTypeCCBackground ||
+        collector_type == kCollectorTypeCMC ||
         collector_type == kCollectorTypeHomogeneousSpaceCompact;
   }
   bool ShouldAllocLargeObject(ObjPtr<mirror::Class> c, size_t byte_count) const
@@ -1201,18 +1260,29 @@ class Heap {
       REQUIRES(!*gc_complete_lock_, !*pending_task_lock_, !process_state_update_lock_);
 
   void ClearPendingTrim(Thread* self) REQUIRES(!*pending_task_lock_);
+  // Replace the pending trim task with one running the next slice of the same trim.
+  void ContinuePendingTrim(Thread* self, const TrimProgress& progress)
+      REQUIRES(!*pending_task_lock_);
   void ClearPendingCollectorTransition(Thread* self) REQUIRES(!*pending_task_lock_);
 
   // What kind of concurrency behavior is the runtime after? Currently true for concurrent mark
-  // sweep GC, false for other GC types.
+  // sweep, concurrent copying and concurrent mark-compact GC, false for other GC types.
   bool IsGcConcurrent() const ALWAYS_INLINE {
     return collector_type_ == kCollectorTypeCC ||
         collector_type_ == kCollectorTypeCMS ||
+        collector_type_ == kCollectorTypeCMC ||
         collector_type_ == kCollectorTypeCCBackground;
   }
 
-  // Trim the managed and native spaces by releasing unused memory back to the OS.
-  void TrimSpaces(Thread* self) REQUIRES(!*gc_complete_lock_);
+  // Run the trim phases from `progress` on until `deadline_ns` has passed, recording how far we
+  // got in `progress`. Returns true once the trim is complete.
+  bool TrimSlice(Thread* self, TrimProgress* progress, uint64_t deadline_ns)
+      REQUIRES(!*gc_complete_lock_);
+
+  // Trim the managed spaces by releasing unused memory back to the OS, resuming from `progress`
+  // and stopping once `deadline_ns` has passed. Returns true once all the spaces are trimmed.
+  bool TrimSpaces(Thread* self, TrimProgress* progress, uint64_t deadline_ns)
+      REQUIRES(!*gc_complete_lock_);
 
   // Trim 0 pages at the end of reference tables.
   void TrimIndirectReferenceTables(Thread* self);
@@ -1411,6 +1481,10 @@ class Heap {
   Mutex process_state_update_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
   size_t min_foreground_target_footprint_ GUARDED_BY(process_state_update_lock_);
 
+  // Adjusts the heap growth, the start of concurrent GCs and the choice of sticky GCs to meet a
+  // pause and GC time share target, when one is set (see GrowForUtilization()).
+  GcPacer gc_pacer_ GUARDED_BY(process_state_update_lock_);
+
   // When num_bytes_allocated_ exceeds this amount then a concurrent GC should be requested so that
   // it completes ahead of an allocation failing.
   // A multiple of this is also used to determine when to trigger a GC in response to native
@@ -1552,6 +1626,7 @@ class Heap {
 
   std::vector<collector::GarbageCollector*> garbage_collectors_;
   collector::SemiSpace* semi_space_collector_;
+  collector::MarkCompact* mark_compact_collector_;
   Atomic<collector::ConcurrentCopying*> active_concurrent_copying_collector_;
   collector::ConcurrentCopying* young_concurrent_copying_collector_;
   collector::ConcurrentCopying* concurrent_copying_collector_;
@@ -1604,6 +1679,14 @@ class Heap {
   // for major collections. Set in Heap constructor.
   const bool use_generational_cc_;
 
+  // If true, the region space allocates from per-NUMA-node pools and the workers of the heap
+  // thread pool are pinned to the CPUs of one node each.
+  const bool use_numa_aware_allocation_;
+
+  // If true, the alloc spaces, their bitmaps and their cards are backed by transparent huge pages
+  // to reduce TLB misses when marking and scanning, and trims release free regions again.
+  const bool use_transparent_huge_pages_;
+
   // True if the currently running collection has made some thread wait.
   bool running_collection_is_blocking_ GUARDED_BY(gc_complete_lock_);
   // The number of blocking GC runs.
@@ -1670,6 +1753,7 @@ class Heap {
   friend class CollectorTransitionTask;
   friend class collector::GarbageCollector;
   friend class collector::ConcurrentCopying;
+  friend class collector::MarkCompact;
   friend class collector::MarkSweep;
   friend class collector::SemiSpace;
   friend class GCCriticalSection;
@@ -14,6 +14,12 @@
  * limitations under the License.
  */
 
+#include <inttypes.h>
+
+#include <android-base/file.h>
+#include <android-base/strings.h>
+
+#include "base/os.h"
 #include "class_linker-inl.h"
 #include "common_runtime_test.h"
 #include "gc/accounting/card_table-inl.h"
@@ -99,6 +105,65 @@ TEST_F(HeapTest, DumpGCPerformanceOnShutdown) {
   Runtime::Current()->SetDumpGCPerformanceOnShutdown(true);
 }
 
+class HugePagesHeapTest : public HeapTest {
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    HeapTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-XX:TransparentHugePages:true", nullptr));
+  }
+};
+
+// Returns whether the mapping containing `address` was advised to use transparent huge pages,
+// as shown by the "hg" flag of its VmFlags in /proc/self/smaps.
+static bool IsAdvisedHugePages(const void* address) {
+  std::string smaps;
+  CHECK(android::base::ReadFileToString("/proc/self/smaps", &smaps));
+  const uintptr_t addr = reinterpret_cast<uintptr_t>(address);
+  bool in_mapping = false;
+  for (const std::string& line : android::base::Split(smaps, "\n")) {
+    uintptr_t start;
+    uintptr_t end;
+    if (sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR " ", &start, &end) == 2) {
+      in_mapping = start <= addr && addr < end;
+    } else if (in_mapping && android::base::StartsWith(line, "VmFlags:")) {
+      return line.find(" hg") != std::string::npos;
+    }
+  }
+  return false;
+}
+
+// Check that the continuous alloc spaces, the cards covering them and their bitmaps are
+// advised to use transparent huge pages.
+static void CheckHugePagesAdvised() {
+  Heap* heap = Runtime::Current()->GetHeap();
+  ScopedObjectAccess soa(Thread::Current());
+  for (space::ContinuousSpace* space : heap->GetContinuousSpaces()) {
+    if (!space->IsContinuousMemMapAllocSpace()) {
+      continue;
+    }
+    space::ContinuousMemMapAllocSpace* alloc_space = space->AsContinuousMemMapAllocSpace();
+    EXPECT_TRUE(IsAdvisedHugePages(alloc_space->Begin())) << alloc_space->GetName();
+    EXPECT_TRUE(IsAdvisedHugePages(heap->GetCardTable()->CardFromAddr(alloc_space->Begin())))
+        << alloc_space->GetName();
+    for (accounting::ContinuousSpaceBitmap* bitmap :
+             { alloc_space->GetLiveBitmap(), alloc_space->GetMarkBitmap() }) {
+      if (bitmap != nullptr && bitmap->IsValid()) {
+        EXPECT_TRUE(IsAdvisedHugePages(bitmap->GetMemMap()->Begin())) << bitmap->GetName();
+      }
+    }
+  }
+}
+
+#define TEST_DISABLED_WITHOUT_TRANSPARENT_HUGE_PAGES() \
+  if (!OS::DirectoryExists("/sys/kernel/mm/transparent_hugepage")) { \
+    printf("WARNING: TEST DISABLED WITHOUT TRANSPARENT HUGE PAGES\n"); \
+    return; \
+  }
+
+TEST_F(HugePagesHeapTest, AdviseHugePages) {
+  TEST_DISABLED_WITHOUT_TRANSPARENT_HUGE_PAGES();
+  CheckHugePagesAdvised();
+}
+
 class ZygoteHeapTest : public CommonRuntimeTest {
   void SetUpRuntimeOptions(RuntimeOptions* options) override {
     CommonRuntimeTest::SetUpRuntimeOptions(options);
@@ -111,5 +176,20 @@ TEST_F(ZygoteHeapTest, PreZygoteFork) {
   Runtime::Current()->GetHeap()->PreZygoteFork();
 }
 
+class HugePagesZygoteHeapTest : public CommonRuntimeTest {
+  void SetUpRuntimeOptions(RuntimeOptions* options) override {
+    CommonRuntimeTest::SetUpRuntimeOptions(options);
+    options->push_back(std::make_pair("-Xzygote", nullptr));
+    options->push_back(std::make_pair("-XX:TransparentHugePages:true", nullptr));
+  }
+};
+
+// The alloc space created at zygote fork, which app processes allocate from, is advised too.
+TEST_F(HugePagesZygoteHeapTest, PreZygoteFork) {
+  TEST_DISABLED_WITHOUT_TRANSPARENT_HUGE_PAGES();
+  Runtime::Current()->GetHeap()->PreZygoteFork();
+  CheckHugePagesAdvised();
+}
+
 }  // namespace gc
 }  // namespace art
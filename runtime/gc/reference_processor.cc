@@ -16,12 +16,16 @@
 
 #include "reference_processor.h"
 
+#include <memory>
+#include <vector>
+
 #include "art_field-inl.h"
 #include "base/mutex.h"
 #include "base/time_utils.h"
 #include "base/utils.h"
 #include "class_root-inl.h"
 #include "collector/garbage_collector.h"
+#include "heap.h"
 #include "jni/java_vm_ext.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
@@ -38,6 +42,8 @@ namespace art {
 namespace gc {
 
 static constexpr bool kAsyncReferenceQueueAdd = false;
+// Below this many references of a kind, clearing them is not worth waking up the GC workers.
+static constexpr size_t kMinParallelReferences = 4096;
 
 ReferenceProcessor::ReferenceProcessor()
     : collector_(nullptr),
@@ -189,9 +195,18 @@ void ReferenceProcessor::ProcessReferences(bool concurrent,
       StopPreservingReferences(self);
     }
   }
+  const size_t thread_count = GetThreadCount(concurrent);
   // Clear all remaining soft and weak references with white referents.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
+  {
+    TimingLogger::ScopedTiming t2(concurrent ? "ClearSoftReferences" :
+        "(Paused)ClearSoftReferences", timings);
+    ClearWhiteReferences(&soft_reference_queue_, collector, thread_count);
+  }
+  {
+    TimingLogger::ScopedTiming t2(concurrent ? "ClearWeakReferences" :
+        "(Paused)ClearWeakReferences", timings);
+    ClearWhiteReferences(&weak_reference_queue_, collector, thread_count);
+  }
   {
     TimingLogger::ScopedTiming t2(concurrent ? "EnqueueFinalizerReferences" :
         "(Paused)EnqueueFinalizerReferences", timings);
@@ -206,10 +221,31 @@ void ReferenceProcessor::ProcessReferences(bool concurrent,
     }
   }
   // Clear all finalizer referent reachable soft and weak references with white referents.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
+  {
+    TimingLogger::ScopedTiming t2(concurrent ? "ClearSoftReferences" :
+        "(Paused)ClearSoftReferences", timings);
+    ClearWhiteReferences(&soft_reference_queue_, collector, thread_count);
+  }
+  {
+    TimingLogger::ScopedTiming t2(concurrent ? "ClearWeakReferences" :
+        "(Paused)ClearWeakReferences", timings);
+    ClearWhiteReferences(&weak_reference_queue_, collector, thread_count);
+  }
+  if (!kUseReadBarrier && concurrent) {
+    // The referents that Reference.get() can return are final now, as PhantomReference.get()
+    // always returns null. Disable the slow path before clearing the phantom references rather
+    // than after, so that mutators are not blocked for that part. With CMS, clearing a phantom
+    // reference only ever writes null to its referent, which cannot race with
+    // Reference.clear().
+    MutexLock mu(self, *Locks::reference_processor_lock_);
+    DisableSlowPath(self);
+  }
   // Clear all phantom references with white referents.
-  phantom_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
+  {
+    TimingLogger::ScopedTiming t2(concurrent ? "ClearPhantomReferences" :
+        "(Paused)ClearPhantomReferences", timings);
+    ClearWhiteReferences(&phantom_reference_queue_, collector, thread_count);
+  }
   // At this point all reference queues other than the cleared references should be empty.
   DCHECK(soft_reference_queue_.IsEmpty());
   DCHECK(weak_reference_queue_.IsEmpty());
@@ -222,11 +258,76 @@ void ReferenceProcessor::ProcessReferences(bool concurrent,
     // starts since there is a small window of time where slow_path_enabled_ is enabled but the
     // callback isn't yet set.
     collector_ = nullptr;
-    if (!kUseReadBarrier && concurrent) {
-      // Done processing, disable the slow path and broadcast to the waiters.
-      DisableSlowPath(self);
+  }
+}
+
+size_t ReferenceProcessor::GetThreadCount(bool concurrent) const {
+  Runtime* const runtime = Runtime::Current();
+  Heap* const heap = runtime->GetHeap();
+  ThreadPool* const thread_pool = heap->GetThreadPool();
+  // Like parallel marking, leave the CPU time to the foreground apps when in a background state.
+  // Transactions record the cleared referents, which is not thread safe.
+  if (thread_pool == nullptr ||
+      !runtime->InJankPerceptibleProcessState() ||
+      runtime->IsActiveTransaction()) {
+    return 1u;
+  }
+  const size_t thread_count =
+      concurrent ? heap->GetConcGCThreadCount() : heap->GetParallelGCThreadCount();
+  return std::max<size_t>(std::min(thread_count, thread_pool->GetThreadCount() + 1u), 1u);
+}
+
+// Clears the white references of one shard into a private queue.
+class ClearWhiteReferencesTask : public Task {
+ public:
+  ClearWhiteReferencesTask(ReferenceQueue* shard, collector::GarbageCollector* collector)
+      : shard_(shard),
+        collector_(collector),
+        cleared_references_(Locks::reference_queue_cleared_references_lock_) {
+  }
+
+  // The GC thread holds the locks on behalf of the workers, like for parallel marking.
+  void Run(Thread* self ATTRIBUTE_UNUSED) override NO_THREAD_SAFETY_ANALYSIS {
+    shard_->ClearWhiteReferences(&cleared_references_, collector_);
+  }
+
+  ReferenceQueue* GetClearedReferences() {
+    return &cleared_references_;
+  }
+
+ private:
+  ReferenceQueue* const shard_;
+  collector::GarbageCollector* const collector_;
+  ReferenceQueue cleared_references_;
+};
+
+void ReferenceProcessor::ClearWhiteReferences(ShardedReferenceQueue* queue,
+                                              collector::GarbageCollector* collector,
+                                              size_t thread_count) {
+  Thread* const self = Thread::Current();
+  const size_t num_references = queue->TakeNumEnqueued(self);
+  if (thread_count <= 1u || num_references < kMinParallelReferences) {
+    for (size_t i = 0; i != ShardedReferenceQueue::kNumShards; ++i) {
+      queue->GetShard(i)->ClearWhiteReferences(&cleared_references_, collector);
+    }
+    return;
+  }
+  ThreadPool* const thread_pool = Runtime::Current()->GetHeap()->GetThreadPool();
+  std::vector<std::unique_ptr<ClearWhiteReferencesTask>> tasks;
+  for (size_t i = 0; i != ShardedReferenceQueue::kNumShards; ++i) {
+    ReferenceQueue* const shard = queue->GetShard(i);
+    if (!shard->IsEmpty()) {
+      tasks.emplace_back(new ClearWhiteReferencesTask(shard, collector));
+      thread_pool->AddTask(self, tasks.back().get());
     }
   }
+  thread_pool->SetMaxActiveWorkers(thread_count - 1u);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /* do_work= */ true, /* may_hold_locks= */ true);
+  thread_pool->StopWorkers(self);
+  for (const std::unique_ptr<ClearWhiteReferencesTask>& task : tasks) {
+    cleared_references_.Splice(task->GetClearedReferences());
+  }
 }
 
 // Process the "referent" field in a java.lang.ref.Reference.  If the referent has not yet been
@@ -102,11 +102,22 @@ class ReferenceProcessor {
   // Condition that people wait on if they attempt to get the referent of a reference while
   // processing is in progress.
   ConditionVariable condition_ GUARDED_BY(Locks::reference_processor_lock_);
-  // Reference queues used by the GC.
-  ReferenceQueue soft_reference_queue_;
-  ReferenceQueue weak_reference_queue_;
+  // How many threads, including the GC thread, may clear references in parallel.
+  size_t GetThreadCount(bool concurrent) const;
+  // Clear the references with white referents in all the shards of `queue`, in parallel if
+  // `thread_count` is more than one and there are enough of them.
+  void ClearWhiteReferences(ShardedReferenceQueue* queue,
+                            collector::GarbageCollector* collector,
+                            size_t thread_count)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::reference_processor_lock_);
+
+  // Reference queues used by the GC. Finalizer references stay on a single queue as processing
+  // them marks objects, which is not thread safe.
+  ShardedReferenceQueue soft_reference_queue_;
+  ShardedReferenceQueue weak_reference_queue_;
   ReferenceQueue finalizer_reference_queue_;
-  ReferenceQueue phantom_reference_queue_;
+  ShardedReferenceQueue phantom_reference_queue_;
   ReferenceQueue cleared_references_;
 
   DISALLOW_COPY_AND_ASSIGN(ReferenceProcessor);
@@ -194,11 +194,67 @@ void ReferenceQueue::ForwardSoftReferences(MarkObjectVisitor* visitor) {
   } while (LIKELY(ref != head));
 }
 
+void ReferenceQueue::Splice(ReferenceQueue* other) {
+  if (other->IsEmpty()) {
+    return;
+  }
+  if (IsEmpty()) {
+    list_ = other->list_;
+  } else {
+    // Cross the links after the two list heads to join the two cycles into one.
+    ObjPtr<mirror::Reference> head = list_->GetPendingNext<kWithoutReadBarrier>();
+    ObjPtr<mirror::Reference> other_head = other->list_->GetPendingNext<kWithoutReadBarrier>();
+    list_->SetPendingNext(other_head);
+    other->list_->SetPendingNext(head);
+  }
+  other->Clear();
+}
+
 void ReferenceQueue::UpdateRoots(IsMarkedVisitor* visitor) {
   if (list_ != nullptr) {
     list_ = down_cast<mirror::Reference*>(visitor->IsMarked(list_));
   }
 }
 
+ShardedReferenceQueue::ShardedReferenceQueue(Mutex* lock)
+    : lock_(lock), next_shard_(0u), num_enqueued_(0u) {
+  for (std::unique_ptr<ReferenceQueue>& shard : shards_) {
+    shard.reset(new ReferenceQueue(lock));
+  }
+}
+
+void ShardedReferenceQueue::AtomicEnqueueIfNotEnqueued(Thread* self,
+                                                       ObjPtr<mirror::Reference> ref) {
+  DCHECK(ref != nullptr);
+  MutexLock mu(self, *lock_);
+  if (ref->IsUnprocessed()) {
+    shards_[next_shard_]->EnqueueReference(ref);
+    next_shard_ = (next_shard_ + 1u) % kNumShards;
+    ++num_enqueued_;
+  }
+}
+
+size_t ShardedReferenceQueue::TakeNumEnqueued(Thread* self) {
+  MutexLock mu(self, *lock_);
+  size_t num_enqueued = num_enqueued_;
+  num_enqueued_ = 0u;
+  return num_enqueued;
+}
+
+void ShardedReferenceQueue::ForwardSoftReferences(MarkObjectVisitor* visitor) {
+  for (std::unique_ptr<ReferenceQueue>& shard : shards_) {
+    shard->ForwardSoftReferences(visitor);
+  }
+}
+
+bool ShardedReferenceQueue::IsEmpty() const {
+  for (const std::unique_ptr<ReferenceQueue>& shard : shards_) {
+    if (!shard->IsEmpty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace gc
 }  // namespace art
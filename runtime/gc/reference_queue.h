@@ -18,6 +18,7 @@
 #define ART_RUNTIME_GC_REFERENCE_QUEUE_H_
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -108,6 +109,9 @@ class ReferenceQueue {
     return list_;
   }
 
+  // Move all the references of `other` to this queue in constant time. Not thread safe.
+  void Splice(ReferenceQueue* other) REQUIRES_SHARED(Locks::mutator_lock_);
+
   // Visits list_, currently only used for the mark compact GC.
   void UpdateRoots(IsMarkedVisitor* visitor)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -123,6 +127,42 @@ class ReferenceQueue {
   DISALLOW_IMPLICIT_CONSTRUCTORS(ReferenceQueue);
 };
 
+// A reference queue split into shards that share one lock. References are spread round-robin
+// over the shards when enqueued so that the shards can then be processed in parallel.
+class ShardedReferenceQueue {
+ public:
+  static constexpr size_t kNumShards = 16;
+
+  explicit ShardedReferenceQueue(Mutex* lock);
+
+  // Enqueue a reference in the next shard if it is unprocessed. Thread safe.
+  void AtomicEnqueueIfNotEnqueued(Thread* self, ObjPtr<mirror::Reference> ref)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!*lock_);
+
+  // Returns the number of references enqueued since the previous call, and resets it.
+  size_t TakeNumEnqueued(Thread* self) REQUIRES(!*lock_);
+
+  // See ReferenceQueue::ForwardSoftReferences.
+  void ForwardSoftReferences(MarkObjectVisitor* visitor)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  ReferenceQueue* GetShard(size_t index) {
+    DCHECK_LT(index, kNumShards);
+    return shards_[index].get();
+  }
+
+  bool IsEmpty() const;
+
+ private:
+  Mutex* const lock_;
+  std::unique_ptr<ReferenceQueue> shards_[kNumShards];
+  // The shard the next reference is enqueued in.
+  size_t next_shard_ GUARDED_BY(lock_);
+  size_t num_enqueued_ GUARDED_BY(lock_);
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(ShardedReferenceQueue);
+};
+
 }  // namespace gc
 }  // namespace art
 
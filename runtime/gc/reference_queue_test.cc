@@ -95,5 +95,49 @@ TEST_F(ReferenceQueueTest, Dump) {
   LOG(INFO) << oss.str();
 }
 
+TEST_F(ReferenceQueueTest, ShardsAndSplice) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  StackHandleScope<20> hs(self);
+  Mutex lock("Reference queue lock");
+  ShardedReferenceQueue sharded_queue(&lock);
+  ASSERT_TRUE(sharded_queue.IsEmpty());
+  auto ref_class = hs.NewHandle(
+      Runtime::Current()->GetClassLinker()->FindClass(self, "Ljava/lang/ref/WeakReference;",
+                                                      ScopedNullHandle<mirror::ClassLoader>()));
+  ASSERT_TRUE(ref_class != nullptr);
+  auto ref1(hs.NewHandle(ref_class->AllocObject(self)->AsReference()));
+  ASSERT_TRUE(ref1 != nullptr);
+  auto ref2(hs.NewHandle(ref_class->AllocObject(self)->AsReference()));
+  ASSERT_TRUE(ref2 != nullptr);
+  auto ref3(hs.NewHandle(ref_class->AllocObject(self)->AsReference()));
+  ASSERT_TRUE(ref3 != nullptr);
+  sharded_queue.AtomicEnqueueIfNotEnqueued(self, ref1.Get());
+  sharded_queue.AtomicEnqueueIfNotEnqueued(self, ref2.Get());
+  sharded_queue.AtomicEnqueueIfNotEnqueued(self, ref3.Get());
+  // Already enqueued, ignored.
+  sharded_queue.AtomicEnqueueIfNotEnqueued(self, ref1.Get());
+  ASSERT_FALSE(sharded_queue.IsEmpty());
+  ASSERT_EQ(sharded_queue.TakeNumEnqueued(self), 3U);
+  ASSERT_EQ(sharded_queue.TakeNumEnqueued(self), 0U);
+
+  // The references are spread over the shards; gather them back in one queue.
+  ReferenceQueue queue(&lock);
+  for (size_t i = 0; i != ShardedReferenceQueue::kNumShards; ++i) {
+    ASSERT_LE(sharded_queue.GetShard(i)->GetLength(), 1U);
+    queue.Splice(sharded_queue.GetShard(i));
+    ASSERT_TRUE(sharded_queue.GetShard(i)->IsEmpty());
+  }
+  ASSERT_TRUE(sharded_queue.IsEmpty());
+  ASSERT_EQ(queue.GetLength(), 3U);
+
+  std::set<mirror::Reference*> refs = {ref1.Get(), ref2.Get(), ref3.Get()};
+  std::set<mirror::Reference*> dequeued;
+  while (!queue.IsEmpty()) {
+    dequeued.insert(queue.DequeuePendingReference().Ptr());
+  }
+  ASSERT_EQ(refs, dequeued);
+}
+
 }  // namespace gc
 }  // namespace art
@@ -91,6 +91,18 @@ void BumpPointerSpace::Clear() {
   }
 }
 
+void BumpPointerSpace::SetCompactedEnd(uint8_t* end, uint64_t objects, uint64_t bytes) {
+  DCHECK(Begin() <= end && end <= Limit());
+  SetEnd(end);
+  objects_allocated_.store(objects, std::memory_order_relaxed);
+  bytes_allocated_.store(bytes, std::memory_order_relaxed);
+  {
+    MutexLock mu(Thread::Current(), block_lock_);
+    num_blocks_ = 0;
+    main_block_size_ = end - Begin();
+  }
+}
+
 void BumpPointerSpace::Dump(std::ostream& os) const {
   os << GetName() << " "
       << reinterpret_cast<void*>(Begin()) << "-" << reinterpret_cast<void*>(End()) << " - "
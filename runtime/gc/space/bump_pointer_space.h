@@ -107,6 +107,9 @@ class BumpPointerSpace final : public ContinuousMemMapAllocSpace {
   // Reset the space to empty.
   void Clear() override REQUIRES(!block_lock_);
 
+  // Reset the space to the given amount of objects compacted at its beginning, as one main block.
+  void SetCompactedEnd(uint8_t* end, uint64_t objects, uint64_t bytes) REQUIRES(!block_lock_);
+
   void Dump(std::ostream& os) const override;
 
   size_t RevokeThreadLocalBuffers(Thread* thread) override REQUIRES(!block_lock_);
@@ -18,7 +18,9 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include <android-base/logging.h>
 
@@ -605,6 +607,410 @@ void FreeListSpace::SetAllLargeObjectsAsZygoteObjects(Thread* self, bool set_mar
   }
 }
 
+// Header of a SegregatedFreeListSpace block, kept in a side table so that free blocks are never
+// touched. Block boundaries only change while holding the space lock, but the flags and the free
+// list links also change on the lock-free paths.
+class SegregatedFreeListSpace::BlockInfo {
+ public:
+  static constexpr uint32_t kMaxPages = 0x1FFFFFFF;
+
+  // Returns the number of pages of the block.
+  size_t Pages() const {
+    return state_.load(std::memory_order_relaxed) & kMaxPages;
+  }
+  // Returns true if the block is free.
+  bool IsFree() const {
+    return (state_.load(std::memory_order_relaxed) & kFlagFree) != 0;
+  }
+  // Returns true if the block is free, zeroed and still mapped.
+  bool IsCached() const {
+    return (state_.load(std::memory_order_relaxed) & kFlagCached) != 0;
+  }
+  // Return true if the large object is a zygote object.
+  bool IsZygoteObject() const {
+    return (state_.load(std::memory_order_relaxed) & kFlagZygote) != 0;
+  }
+  // Updates the size of the block and whether or not it is free, clearing the zygote flag.
+  void Set(size_t pages, bool free, bool cached) {
+    DCHECK_LE(pages, kMaxPages);
+    DCHECK(free || !cached);
+    state_.store(static_cast<uint32_t>(pages) | (free ? kFlagFree : 0u) |
+                     (cached ? kFlagCached : 0u),
+                 std::memory_order_relaxed);
+  }
+  // Change the object to be a zygote object.
+  void SetZygoteObject() {
+    state_.fetch_or(kFlagZygote, std::memory_order_relaxed);
+  }
+  uint32_t GetNextFree() const {
+    return next_free_.load(std::memory_order_relaxed);
+  }
+  void SetNextFree(uint32_t next_free) {
+    next_free_.store(next_free, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr uint32_t kFlagFree = 0x80000000;  // If block is free.
+  static constexpr uint32_t kFlagZygote = 0x40000000;  // If the large object is a zygote object.
+  static constexpr uint32_t kFlagCached = 0x20000000;  // If the free block is zeroed and mapped.
+
+  Atomic<uint32_t> state_;
+  // One plus the slot of the next block on the same free list, 0 at the end of the list.
+  Atomic<uint32_t> next_free_;
+};
+
+SegregatedFreeListSpace* SegregatedFreeListSpace::Create(const std::string& name, size_t size) {
+  CHECK_EQ(size % kAlignment, 0U);
+  std::string error_msg;
+  MemMap mem_map = MemMap::MapAnonymous(name.c_str(),
+                                        size,
+                                        PROT_READ | PROT_WRITE,
+                                        /*low_4gb=*/ true,
+                                        &error_msg);
+  CHECK(mem_map.IsValid()) << "Failed to allocate large object space mem map: " << error_msg;
+  return new SegregatedFreeListSpace(name, std::move(mem_map), mem_map.Begin(), mem_map.End());
+}
+
+SegregatedFreeListSpace::SegregatedFreeListSpace(const std::string& name,
+                                                 MemMap&& mem_map,
+                                                 uint8_t* begin,
+                                                 uint8_t* end)
+    : LargeObjectSpace(name, begin, end, "segregated free list space lock"),
+      mem_map_(std::move(mem_map)),
+      block_info_(nullptr),
+      end_slot_(0u) {
+  const size_t space_capacity = end - begin;
+  CHECK_ALIGNED(space_capacity, kAlignment);
+  const size_t num_slots = space_capacity / kAlignment;
+  CHECK_LE(num_slots, BlockInfo::kMaxPages);
+  std::string error_msg;
+  block_info_map_ =
+      MemMap::MapAnonymous("large object segregated free list space block info map",
+                           sizeof(BlockInfo) * num_slots,
+                           PROT_READ | PROT_WRITE,
+                           /*low_4gb=*/ false,
+                           &error_msg);
+  CHECK(block_info_map_.IsValid()) << "Failed to allocate block info map" << error_msg;
+  block_info_ = reinterpret_cast<BlockInfo*>(block_info_map_.Begin());
+}
+
+SegregatedFreeListSpace::~SegregatedFreeListSpace() {}
+
+size_t SegregatedFreeListSpace::FreeListForPages(size_t pages) {
+  DCHECK_NE(pages, 0u);
+  if (pages > kMaxSizeClassPages) {
+    return kOversizedFreeList;
+  }
+  // Round down, the block must be able to serve any allocation of its size class.
+  const size_t size_class = LargeObjectSizeClassForPages(pages);
+  return LargeObjectSizeClassPages(size_class) <= pages ? size_class : size_class - 1u;
+}
+
+void SegregatedFreeListSpace::PushFreeBlock(size_t free_list, size_t slot) {
+  DCHECK(block_info_[slot].IsFree());
+  DCHECK_EQ(FreeListForPages(block_info_[slot].Pages()), free_list);
+  Atomic<uint64_t>& head = free_list_heads_[free_list];
+  uint64_t old_head = head.load(std::memory_order_relaxed);
+  uint64_t new_head;
+  do {
+    block_info_[slot].SetNextFree(static_cast<uint32_t>(old_head));
+    // Bump the tag in the upper half on every update so that a stale pop cannot succeed.
+    new_head = (((old_head >> 32) + 1u) << 32) | (slot + 1u);
+  } while (!head.compare_exchange_weak(old_head,
+                                       new_head,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed));
+}
+
+size_t SegregatedFreeListSpace::PopFreeBlock(size_t free_list) {
+  Atomic<uint64_t>& head = free_list_heads_[free_list];
+  uint64_t old_head = head.load(std::memory_order_acquire);
+  while (true) {
+    const uint32_t first = static_cast<uint32_t>(old_head);
+    if (first == 0u) {
+      return kNoSlot;
+    }
+    // The block may be popped by another thread meanwhile, in which case the link is stale but
+    // the tag makes the exchange fail.
+    const uint64_t new_head =
+        (((old_head >> 32) + 1u) << 32) | block_info_[first - 1u].GetNextFree();
+    if (head.compare_exchange_weak(old_head,
+                                   new_head,
+                                   std::memory_order_acquire,
+                                   std::memory_order_acquire)) {
+      return first - 1u;
+    }
+  }
+}
+
+mirror::Object* SegregatedFreeListSpace::Alloc(Thread* self,
+                                               size_t num_bytes,
+                                               size_t* bytes_allocated,
+                                               size_t* usable_size,
+                                               size_t* bytes_tl_bulk_allocated) {
+  const size_t pages = std::max<size_t>(RoundUp(num_bytes, kAlignment) / kAlignment, 1u);
+  size_t slot = kNoSlot;
+  if (LIKELY(pages <= kMaxSizeClassPages)) {
+    // Fast path, reuse a block of the size class without taking the lock.
+    slot = PopFreeBlock(LargeObjectSizeClassForPages(pages));
+  }
+  if (slot == kNoSlot) {
+    MutexLock mu(self, lock_);
+    slot = AllocSlow(pages);
+    if (slot == kNoSlot) {
+      return nullptr;
+    }
+  }
+  BlockInfo* info = &block_info_[slot];
+  DCHECK(info->IsFree());
+  const size_t allocation_size = info->Pages() * kAlignment;
+  DCHECK_GE(allocation_size, num_bytes);
+  if (info->IsCached()) {
+    cached_bytes_.fetch_sub(allocation_size, std::memory_order_relaxed);
+  }
+  info->Set(info->Pages(), /*free=*/ false, /*cached=*/ false);
+  DCHECK(bytes_allocated != nullptr);
+  *bytes_allocated = allocation_size;
+  if (usable_size != nullptr) {
+    *usable_size = allocation_size;
+  }
+  DCHECK(bytes_tl_bulk_allocated != nullptr);
+  *bytes_tl_bulk_allocated = allocation_size;
+  allocated_objects_.fetch_add(1u, std::memory_order_relaxed);
+  total_allocated_objects_.fetch_add(1u, std::memory_order_relaxed);
+  allocated_bytes_.fetch_add(allocation_size, std::memory_order_relaxed);
+  total_allocated_bytes_.fetch_add(allocation_size, std::memory_order_relaxed);
+  return reinterpret_cast<mirror::Object*>(GetAddressForSlot(slot));
+}
+
+size_t SegregatedFreeListSpace::AllocSlow(size_t pages) {
+  // Allocations within the size classes take a whole size class block so that it can be reused
+  // by any allocation of the size class once freed.
+  const bool in_size_class = pages <= kMaxSizeClassPages;
+  const size_t block_pages =
+      in_size_class ? LargeObjectSizeClassPages(LargeObjectSizeClassForPages(pages)) : pages;
+  for (bool coalesced = false; ; coalesced = true) {
+    size_t slot = kNoSlot;
+    if (in_size_class) {
+      // Another thread may have freed a block of the size class meanwhile.
+      slot = PopFreeBlock(LargeObjectSizeClassForPages(pages));
+    }
+    if (slot == kNoSlot) {
+      slot = AllocFromLargerBlock(block_pages);
+    }
+    if (slot == kNoSlot) {
+      slot = AllocFromEnd(block_pages);
+    }
+    if (slot != kNoSlot || coalesced || !CoalesceFreeBlocks()) {
+      return slot;
+    }
+  }
+}
+
+size_t SegregatedFreeListSpace::AllocFromEnd(size_t pages) {
+  const size_t num_slots = mem_map_.Size() / kAlignment;
+  if (num_slots - end_slot_ < pages) {
+    return kNoSlot;
+  }
+  const size_t slot = end_slot_;
+  // Pages after `end_slot_` are either untouched or were released when coalescing.
+  block_info_[slot].Set(pages, /*free=*/ true, /*cached=*/ false);
+  end_slot_ += pages;
+  return slot;
+}
+
+size_t SegregatedFreeListSpace::AllocFromLargerBlock(size_t pages) {
+  size_t slot = kNoSlot;
+  if (pages <= kMaxSizeClassPages) {
+    for (size_t free_list = LargeObjectSizeClassForPages(pages) + 1u;
+         free_list < kNumSizeClasses && slot == kNoSlot;
+         ++free_list) {
+      slot = PopFreeBlock(free_list);
+    }
+  }
+  if (slot == kNoSlot) {
+    // Take the best fit among the oversized blocks. These are only popped while holding `lock_`
+    // so draining the list does not make other allocations fail.
+    std::vector<size_t> other_blocks;
+    for (size_t block = PopFreeBlock(kOversizedFreeList);
+         block != kNoSlot;
+         block = PopFreeBlock(kOversizedFreeList)) {
+      const size_t block_pages = block_info_[block].Pages();
+      if (block_pages >= pages &&
+          (slot == kNoSlot || block_pages < block_info_[slot].Pages())) {
+        std::swap(slot, block);
+      }
+      if (block != kNoSlot) {
+        other_blocks.push_back(block);
+      }
+    }
+    for (size_t block : other_blocks) {
+      PushFreeBlock(kOversizedFreeList, block);
+    }
+  }
+  if (slot != kNoSlot && block_info_[slot].Pages() > pages) {
+    SplitFreeBlock(slot, pages);
+  }
+  return slot;
+}
+
+void SegregatedFreeListSpace::SplitFreeBlock(size_t slot, size_t pages) {
+  BlockInfo* info = &block_info_[slot];
+  DCHECK(info->IsFree());
+  DCHECK_GT(info->Pages(), pages);
+  const size_t remainder_slot = slot + pages;
+  const size_t remainder_pages = info->Pages() - pages;
+  const bool cached = info->IsCached();
+  block_info_[remainder_slot].Set(remainder_pages, /*free=*/ true, cached);
+  info->Set(pages, /*free=*/ true, cached);
+  PushFreeBlock(FreeListForPages(remainder_pages), remainder_slot);
+}
+
+bool SegregatedFreeListSpace::CoalesceFreeBlocks() {
+  // Blocks freed while we coalesce are simply left for the next time.
+  std::vector<size_t> blocks;
+  for (size_t free_list = 0; free_list <= kOversizedFreeList; ++free_list) {
+    for (size_t slot = PopFreeBlock(free_list); slot != kNoSlot; slot = PopFreeBlock(free_list)) {
+      blocks.push_back(slot);
+    }
+  }
+  std::sort(blocks.begin(), blocks.end());
+  bool changed = false;
+  for (size_t i = 0; i < blocks.size(); ) {
+    const size_t begin = blocks[i];
+    size_t end = begin;
+    size_t num_blocks = 0u;
+    size_t cached_bytes = 0u;
+    for (; i < blocks.size() && blocks[i] == end; ++i) {
+      const BlockInfo& info = block_info_[blocks[i]];
+      end += info.Pages();
+      ++num_blocks;
+      cached_bytes += info.IsCached() ? info.Pages() * kAlignment : 0u;
+    }
+    if (end == end_slot_) {
+      // Give the run of free blocks at the end back to the unused part of the space.
+      cached_bytes_.fetch_sub(cached_bytes, std::memory_order_relaxed);
+      if (cached_bytes != 0u) {
+        madvise(GetAddressForSlot(begin), (end - begin) * kAlignment, MADV_DONTNEED);
+      }
+      end_slot_ = begin;
+      changed = true;
+      continue;
+    }
+    if (num_blocks > 1u) {
+      // The merged block is only partly mapped, stop counting it as cached.
+      cached_bytes_.fetch_sub(cached_bytes, std::memory_order_relaxed);
+      block_info_[begin].Set(end - begin, /*free=*/ true, /*cached=*/ false);
+      changed = true;
+    }
+    PushFreeBlock(FreeListForPages(end - begin), begin);
+  }
+  return changed;
+}
+
+size_t SegregatedFreeListSpace::Free(Thread* self ATTRIBUTE_UNUSED, mirror::Object* obj) {
+  DCHECK(Contains(obj)) << reinterpret_cast<void*>(Begin()) << " " << obj << " "
+                        << reinterpret_cast<void*>(End());
+  DCHECK_ALIGNED(obj, kAlignment);
+  const size_t slot = GetSlotIndexForAddress(reinterpret_cast<uintptr_t>(obj));
+  BlockInfo* info = &block_info_[slot];
+  DCHECK(!info->IsFree());
+  const size_t pages = info->Pages();
+  const size_t allocation_size = pages * kAlignment;
+  // Keep blocks of the size classes mapped for reuse while the cache has room, zeroing them here
+  // rather than on the allocation path. Release the others, and zygote objects whose pages are
+  // shared with the zygote.
+  bool cached = false;
+  if (pages <= kMaxSizeClassPages && !info->IsZygoteObject()) {
+    cached = cached_bytes_.fetch_add(allocation_size, std::memory_order_relaxed) +
+        allocation_size <= kMaxCachedBytes;
+    if (!cached) {
+      cached_bytes_.fetch_sub(allocation_size, std::memory_order_relaxed);
+    }
+  }
+  if (cached) {
+    memset(obj, 0, allocation_size);
+  } else {
+    madvise(obj, allocation_size, MADV_DONTNEED);
+  }
+  info->Set(pages, /*free=*/ true, cached);
+  PushFreeBlock(FreeListForPages(pages), slot);
+  DCHECK_LE(allocation_size, allocated_bytes_.load(std::memory_order_relaxed));
+  allocated_objects_.fetch_sub(1u, std::memory_order_relaxed);
+  allocated_bytes_.fetch_sub(allocation_size, std::memory_order_relaxed);
+  return allocation_size;
+}
+
+size_t SegregatedFreeListSpace::AllocationSize(mirror::Object* obj, size_t* usable_size) {
+  DCHECK(Contains(obj));
+  const BlockInfo& info = block_info_[GetSlotIndexForAddress(reinterpret_cast<uintptr_t>(obj))];
+  DCHECK(!info.IsFree());
+  size_t alloc_size = info.Pages() * kAlignment;
+  if (usable_size != nullptr) {
+    *usable_size = alloc_size;
+  }
+  return alloc_size;
+}
+
+void SegregatedFreeListSpace::Walk(DlMallocSpace::WalkCallback callback, void* arg) {
+  // Holding `lock_` keeps the block boundaries stable.
+  MutexLock mu(Thread::Current(), lock_);
+  for (size_t slot = 0; slot < end_slot_; slot += block_info_[slot].Pages()) {
+    DCHECK_NE(block_info_[slot].Pages(), 0u);
+    if (!block_info_[slot].IsFree()) {
+      size_t alloc_size = block_info_[slot].Pages() * kAlignment;
+      uint8_t* byte_start = GetAddressForSlot(slot);
+      callback(byte_start, byte_start + alloc_size, alloc_size, arg);
+      callback(nullptr, nullptr, 0, arg);
+    }
+  }
+}
+
+void SegregatedFreeListSpace::ForEachMemMap(std::function<void(const MemMap&)> func) const {
+  func(block_info_map_);
+  func(mem_map_);
+}
+
+void SegregatedFreeListSpace::Dump(std::ostream& os) const {
+  MutexLock mu(Thread::Current(), lock_);
+  os << GetName() << " -"
+     << " begin: " << reinterpret_cast<void*>(Begin())
+     << " end: " << reinterpret_cast<void*>(End())
+     << " cached: " << PrettySize(cached_bytes_.load(std::memory_order_relaxed)) << "\n";
+  for (size_t slot = 0; slot < end_slot_; slot += block_info_[slot].Pages()) {
+    size_t size = block_info_[slot].Pages() * kAlignment;
+    const void* address = GetAddressForSlot(slot);
+    if (block_info_[slot].IsFree()) {
+      os << "Free block at address: " << address << " of length " << size << " bytes\n";
+    } else {
+      os << "Large object at address: " << address << " of length " << size << " bytes\n";
+    }
+  }
+  if (end_slot_ * kAlignment < Size()) {
+    os << "Free block at address: " << reinterpret_cast<const void*>(GetAddressForSlot(end_slot_))
+       << " of length " << Size() - end_slot_ * kAlignment << " bytes\n";
+  }
+}
+
+bool SegregatedFreeListSpace::IsZygoteLargeObject(Thread* self ATTRIBUTE_UNUSED,
+                                                  mirror::Object* obj) const {
+  return block_info_[GetSlotIndexForAddress(reinterpret_cast<uintptr_t>(obj))].IsZygoteObject();
+}
+
+void SegregatedFreeListSpace::SetAllLargeObjectsAsZygoteObjects(Thread* self, bool set_mark_bit) {
+  MutexLock mu(self, lock_);
+  for (size_t slot = 0; slot < end_slot_; slot += block_info_[slot].Pages()) {
+    if (!block_info_[slot].IsFree()) {
+      block_info_[slot].SetZygoteObject();
+      if (set_mark_bit) {
+        ObjPtr<mirror::Object> obj = reinterpret_cast<mirror::Object*>(GetAddressForSlot(slot));
+        bool success = obj->AtomicSetMarkBit(0, 1);
+        CHECK(success);
+      }
+    }
+  }
+}
+
 void LargeObjectSpace::SweepCallback(size_t num_ptrs, mirror::Object** ptrs, void* arg) {
   SweepCallbackContext* context = static_cast<SweepCallbackContext*>(arg);
   space::LargeObjectSpace* space = context->space->AsLargeObjectSpace();
@@ -657,6 +1063,11 @@ std::pair<uint8_t*, uint8_t*> FreeListSpace::GetBeginEndAtomic() const {
   return std::make_pair(Begin(), End());
 }
 
+std::pair<uint8_t*, uint8_t*> SegregatedFreeListSpace::GetBeginEndAtomic() const {
+  // The space does not grow, Begin() and End() are constant.
+  return std::make_pair(Begin(), End());
+}
+
 }  // namespace space
 }  // namespace gc
 }  // namespace art
@@ -18,12 +18,15 @@
 #define ART_RUNTIME_GC_SPACE_LARGE_OBJECT_SPACE_H_
 
 #include "base/allocator.h"
+#include "base/atomic.h"
 #include "base/safe_map.h"
 #include "base/tracking_safe_map.h"
 #include "dlmalloc_space.h"
 #include "space.h"
 #include "thread-current-inl.h"
 
+#include <array>
+#include <limits>
 #include <set>
 #include <vector>
 
@@ -37,6 +40,7 @@ enum class LargeObjectSpaceType {
   kDisabled,
   kMap,
   kFreeList,
+  kSegregatedFreeList,
 };
 
 // Abstraction implemented by all large object spaces.
@@ -58,11 +62,11 @@ class LargeObjectSpace : public DiscontinuousSpace, public AllocSpace {
     MutexLock mu(Thread::Current(), lock_);
     return num_objects_allocated_;
   }
-  uint64_t GetTotalBytesAllocated() const {
+  virtual uint64_t GetTotalBytesAllocated() const {
     MutexLock mu(Thread::Current(), lock_);
     return total_bytes_allocated_;
   }
-  uint64_t GetTotalObjectsAllocated() const {
+  virtual uint64_t GetTotalObjectsAllocated() const {
     MutexLock mu(Thread::Current(), lock_);
     return total_objects_allocated_;
   }
@@ -241,6 +245,129 @@ class FreeListSpace final : public LargeObjectSpace {
   FreeBlocks free_blocks_ GUARDED_BY(lock_);
 };
 
+// The size classes of SegregatedFreeListSpace, in pages: every page count up to 16 pages, then
+// four per power of two.
+constexpr size_t LargeObjectSizeClassForPages(size_t pages) {
+  if (pages <= 16u) {
+    return pages - 1u;
+  }
+  size_t high_bit = 0u;
+  while (((pages - 1u) >> (high_bit + 1u)) != 0u) {
+    ++high_bit;
+  }
+  return 16u + (high_bit - 4u) * 4u + (((pages - 1u) >> (high_bit - 2u)) & 3u);
+}
+constexpr size_t LargeObjectSizeClassPages(size_t size_class) {
+  if (size_class < 16u) {
+    return size_class + 1u;
+  }
+  return (5u + (size_class - 16u) % 4u) << (2u + (size_class - 16u) / 4u);
+}
+
+// A continuous large object space with size-segregated free lists. Freed blocks of up to
+// kMaxSizeClassPages pages are kept zeroed and mapped, up to kMaxCachedBytes, on lock-free free
+// lists per size class, so that the common allocations and frees never take `lock_`. Only
+// carving new blocks from the end of the space, splitting larger blocks and coalescing free
+// blocks when no block fits take `lock_`.
+class SegregatedFreeListSpace final : public LargeObjectSpace {
+ public:
+  static constexpr size_t kAlignment = kPageSize;
+  // The largest allocation served from the size class free lists.
+  static constexpr size_t kMaxSizeClassPages = std::max<size_t>(MB / kPageSize, 1u);
+  // How many bytes of freed blocks we keep zeroed and mapped for reuse.
+  static constexpr size_t kMaxCachedBytes = 16 * MB;
+
+  virtual ~SegregatedFreeListSpace();
+  static SegregatedFreeListSpace* Create(const std::string& name, size_t capacity);
+  size_t AllocationSize(mirror::Object* obj, size_t* usable_size) override;
+  mirror::Object* Alloc(Thread* self, size_t num_bytes, size_t* bytes_allocated,
+                        size_t* usable_size, size_t* bytes_tl_bulk_allocated)
+      override REQUIRES(!lock_);
+  size_t Free(Thread* self, mirror::Object* obj) override;
+  void Walk(DlMallocSpace::WalkCallback callback, void* arg) override REQUIRES(!lock_);
+  void Dump(std::ostream& os) const override REQUIRES(!lock_);
+  void ForEachMemMap(std::function<void(const MemMap&)> func) const override;
+  std::pair<uint8_t*, uint8_t*> GetBeginEndAtomic() const override;
+
+  uint64_t GetBytesAllocated() override {
+    return allocated_bytes_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetObjectsAllocated() override {
+    return allocated_objects_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetTotalBytesAllocated() const override {
+    return total_allocated_bytes_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetTotalObjectsAllocated() const override {
+    return total_allocated_objects_.load(std::memory_order_relaxed);
+  }
+
+  static constexpr size_t kNumSizeClasses =
+      LargeObjectSizeClassForPages(kMaxSizeClassPages) + 1u;
+  static_assert(LargeObjectSizeClassPages(kNumSizeClasses - 1u) == kMaxSizeClassPages,
+                "The largest size class must be kMaxSizeClassPages");
+
+ protected:
+  SegregatedFreeListSpace(const std::string& name,
+                          MemMap&& mem_map,
+                          uint8_t* begin,
+                          uint8_t* end);
+
+  bool IsZygoteLargeObject(Thread* self, mirror::Object* obj) const override;
+  void SetAllLargeObjectsAsZygoteObjects(Thread* self, bool set_mark_bit) override
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+ private:
+  class BlockInfo;
+
+  static constexpr size_t kNoSlot = std::numeric_limits<size_t>::max();
+  // The free list of blocks larger than kMaxSizeClassPages, after the size class free lists.
+  static constexpr size_t kOversizedFreeList = kNumSizeClasses;
+
+  size_t GetSlotIndexForAddress(uintptr_t address) const {
+    DCHECK(Contains(reinterpret_cast<mirror::Object*>(address)));
+    return (address - reinterpret_cast<uintptr_t>(Begin())) / kAlignment;
+  }
+  uint8_t* GetAddressForSlot(size_t slot) const {
+    return Begin() + slot * kAlignment;
+  }
+  // Returns the free list holding free blocks of `pages` pages, the largest size class that
+  // such a block can serve.
+  static size_t FreeListForPages(size_t pages);
+
+  // Lock-free push and pop of a free block whose header is already set up.
+  void PushFreeBlock(size_t free_list, size_t slot);
+  size_t PopFreeBlock(size_t free_list);
+
+  // Slow path of Alloc(), returns the first slot of a block of at least `pages` pages.
+  size_t AllocSlow(size_t pages) REQUIRES(lock_);
+  size_t AllocFromEnd(size_t pages) REQUIRES(lock_);
+  size_t AllocFromLargerBlock(size_t pages) REQUIRES(lock_);
+  // Merge adjacent free blocks and give back the free blocks at the end of the space. Returns
+  // false if that made no difference.
+  bool CoalesceFreeBlocks() REQUIRES(lock_);
+  // Split the free block at `slot` after `pages` pages and push the remainder to its free list.
+  void SplitFreeBlock(size_t slot, size_t pages) REQUIRES(lock_);
+
+  MemMap mem_map_;
+  // Side table with one block header per page; only the first page of a block is meaningful.
+  MemMap block_info_map_;
+  BlockInfo* block_info_;
+  // Blocks are carved from [0, end_slot_) and the pages after it are unused.
+  size_t end_slot_ GUARDED_BY(lock_);
+  // The heads of the free lists, tagged with a modification count against ABA races.
+  std::array<Atomic<uint64_t>, kNumSizeClasses + 1u> free_list_heads_;
+  // Bytes of free blocks that are zeroed but still mapped.
+  Atomic<size_t> cached_bytes_;
+
+  // Used instead of the `lock_` guarded counters of LargeObjectSpace.
+  Atomic<uint64_t> allocated_bytes_;
+  Atomic<uint64_t> allocated_objects_;
+  Atomic<uint64_t> total_allocated_bytes_;
+  Atomic<uint64_t> total_allocated_objects_;
+};
+
 }  // namespace space
 }  // namespace gc
 }  // namespace art
@@ -30,20 +30,28 @@ class LargeObjectSpaceTest : public SpaceTest<CommonRuntimeTest> {
   static constexpr size_t kNumThreads = 10;
   static constexpr size_t kNumIterations = 1000;
   void RaceTest();
+  void ThroughputTest();
+
+  static constexpr size_t kNumSpaceTypes = 3;
+  static LargeObjectSpace* CreateSpace(size_t los_type, size_t capacity) {
+    switch (los_type) {
+      case 0:
+        return space::LargeObjectMapSpace::Create("large object space");
+      case 1:
+        return space::FreeListSpace::Create("large object space", capacity);
+      default:
+        return space::SegregatedFreeListSpace::Create("large object space", capacity);
+    }
+  }
 };
 
 
 void LargeObjectSpaceTest::LargeObjectTest() {
   size_t rand_seed = 0;
   Thread* const self = Thread::Current();
-  for (size_t i = 0; i < 2; ++i) {
-    LargeObjectSpace* los = nullptr;
+  for (size_t i = 0; i < kNumSpaceTypes; ++i) {
     const size_t capacity = 128 * MB;
-    if (i == 0) {
-      los = space::LargeObjectMapSpace::Create("large object space");
-    } else {
-      los = space::FreeListSpace::Create("large object space", capacity);
-    }
+    LargeObjectSpace* los = CreateSpace(i, capacity);
 
     // Make sure the bitmap is not empty and actually covers at least how much we expect.
     CHECK_LT(static_cast<uintptr_t>(los->GetLiveBitmap()->HeapBegin()),
@@ -152,13 +160,8 @@ class AllocRaceTask : public Task {
 };
 
 void LargeObjectSpaceTest::RaceTest() {
-  for (size_t los_type = 0; los_type < 2; ++los_type) {
-    LargeObjectSpace* los = nullptr;
-    if (los_type == 0) {
-      los = space::LargeObjectMapSpace::Create("large object space");
-    } else {
-      los = space::FreeListSpace::Create("large object space", 128 * MB);
-    }
+  for (size_t los_type = 0; los_type < kNumSpaceTypes; ++los_type) {
+    LargeObjectSpace* los = CreateSpace(los_type, 128 * MB);
 
     Thread* self = Thread::Current();
     ThreadPool thread_pool("Large object space test thread pool", kNumThreads);
@@ -174,6 +177,68 @@ void LargeObjectSpaceTest::RaceTest() {
   }
 }
 
+// Allocates and frees byte[]-like buffers of the typical large object sizes, keeping a few of
+// them alive at any time.
+class AllocThroughputTask : public Task {
+ public:
+  AllocThroughputTask(size_t id, size_t iterations, LargeObjectSpace* los) :
+    id_(id), iterations_(iterations), los_(los) {}
+
+  void Run(Thread* self) override {
+    static constexpr size_t kSizes[] = { 12 * KB, 16 * KB, 24 * KB, 64 * KB, 128 * KB, 1 * MB };
+    static constexpr size_t kNumLive = 4;
+    mirror::Object* live[kNumLive] = {};
+    for (size_t i = 0; i < iterations_; ++i) {
+      mirror::Object*& slot = live[i % kNumLive];
+      if (slot != nullptr) {
+        los_->Free(self, slot);
+      }
+      size_t alloc_size, bytes_tl_bulk_allocated;
+      slot = los_->Alloc(self, kSizes[(i + id_) % arraysize(kSizes)], &alloc_size, nullptr,
+                         &bytes_tl_bulk_allocated);
+      ASSERT_TRUE(slot != nullptr);
+    }
+    for (mirror::Object* obj : live) {
+      if (obj != nullptr) {
+        los_->Free(self, obj);
+      }
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  size_t id_;
+  size_t iterations_;
+  LargeObjectSpace* los_;
+};
+
+void LargeObjectSpaceTest::ThroughputTest() {
+  for (size_t los_type = 0; los_type < kNumSpaceTypes; ++los_type) {
+    LargeObjectSpace* los = CreateSpace(los_type, 512 * MB);
+
+    Thread* self = Thread::Current();
+    ThreadPool thread_pool("Large object space test thread pool", kNumThreads);
+    for (size_t i = 0; i < kNumThreads; ++i) {
+      thread_pool.AddTask(self, new AllocThroughputTask(i, kNumIterations, los));
+    }
+
+    const uint64_t start_time = NanoTime();
+    thread_pool.StartWorkers(self);
+    thread_pool.Wait(self, true, false);
+    const uint64_t duration = NanoTime() - start_time;
+    LOG(INFO) << los->GetName() << " type " << los_type << ": "
+              << kNumThreads * kNumIterations << " allocations and frees in "
+              << PrettyDuration(duration);
+
+    EXPECT_EQ(0U, los->GetBytesAllocated());
+    EXPECT_EQ(0U, los->GetObjectsAllocated());
+    delete los;
+  }
+}
+
 TEST_F(LargeObjectSpaceTest, LargeObjectTest) {
   LargeObjectTest();
 }
@@ -182,6 +247,10 @@ TEST_F(LargeObjectSpaceTest, RaceTest) {
   RaceTest();
 }
 
+TEST_F(LargeObjectSpaceTest, ThroughputTest) {
+  ThroughputTest();
+}
+
 }  // namespace space
 }  // namespace gc
 }  // namespace art
@@ -19,6 +19,7 @@
 #include "bump_pointer_space.h"
 #include "base/dumpable.h"
 #include "base/logging.h"
+#include "base/numa.h"
 #include "gc/accounting/read_barrier_table.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
@@ -32,6 +33,17 @@ namespace space {
 // value of the region size, evaculate the region.
 static constexpr uint kEvacuateLivePercentThreshold = 75U;
 
+// Whether we keep regions selected by the live percent threshold when the survival statistics of
+// their age predict that copying them now costs more than the dead bytes it frees.
+static constexpr bool kAdaptiveEvacuation = true;
+
+// The minimum number of recently sampled bytes of an age bucket for its survival rate to be used.
+static constexpr uint64_t kMinSurvivalSampleBytes = RegionSpace::kRegionSize;
+
+// The recent survival samples of an age bucket lose 1/2^kSurvivalDecayShift of their weight at
+// each collection.
+static constexpr size_t kSurvivalDecayShift = 2U;
+
 // Whether we protect the unused and cleared regions.
 static constexpr bool kProtectClearedRegions = kIsDebugBuild;
 
@@ -49,16 +61,23 @@ static constexpr bool kCheckLiveBytesAgainstRegionBitmap = kIsDebugBuild;
 
 MemMap RegionSpace::CreateMemMap(const std::string& name,
                                  size_t capacity,
-                                 uint8_t* requested_begin) {
+                                 uint8_t* requested_begin,
+                                 bool use_huge_pages) {
   CHECK_ALIGNED(capacity, kRegionSize);
+  static_assert(IsAligned<kRegionSize>(MemMap::kHugePageSize));
+  // Align the map to huge pages if we can so that every huge page of the space is fully used.
+  const size_t alignment = (use_huge_pages && IsAlignedParam(capacity, MemMap::kHugePageSize))
+      ? MemMap::kHugePageSize
+      : kRegionSize;
   std::string error_msg;
-  // Ask for the capacity of an additional kRegionSize so that we can align the map by kRegionSize
-  // even if we get unaligned base address. This is necessary for the ReadBarrierTable to work.
+  // Ask for the capacity of an additional `alignment` so that we can align the map by `alignment`
+  // (at least kRegionSize) even if we get unaligned base address. This is necessary for the
+  // ReadBarrierTable to work.
   MemMap mem_map;
   while (true) {
     mem_map = MemMap::MapAnonymous(name.c_str(),
                                    requested_begin,
-                                   capacity + kRegionSize,
+                                   capacity + alignment,
                                    PROT_READ | PROT_WRITE,
                                    /*low_4gb=*/ true,
                                    /*reuse=*/ false,
@@ -77,16 +96,16 @@ MemMap RegionSpace::CreateMemMap(const std::string& name,
     MemMap::DumpMaps(LOG_STREAM(ERROR));
     return MemMap::Invalid();
   }
-  CHECK_EQ(mem_map.Size(), capacity + kRegionSize);
+  CHECK_EQ(mem_map.Size(), capacity + alignment);
   CHECK_EQ(mem_map.Begin(), mem_map.BaseBegin());
   CHECK_EQ(mem_map.Size(), mem_map.BaseSize());
-  if (IsAlignedParam(mem_map.Begin(), kRegionSize)) {
-    // Got an aligned map. Since we requested a map that's kRegionSize larger. Shrink by
-    // kRegionSize at the end.
+  if (IsAlignedParam(mem_map.Begin(), alignment)) {
+    // Got an aligned map. Since we requested a map that's `alignment` larger. Shrink by
+    // `alignment` at the end.
     mem_map.SetSize(capacity);
   } else {
     // Got an unaligned map. Align the both ends.
-    mem_map.AlignBy(kRegionSize);
+    mem_map.AlignBy(alignment);
   }
   CHECK_ALIGNED(mem_map.Begin(), kRegionSize);
   CHECK_ALIGNED(mem_map.End(), kRegionSize);
@@ -94,12 +113,17 @@ MemMap RegionSpace::CreateMemMap(const std::string& name,
   return mem_map;
 }
 
-RegionSpace* RegionSpace::Create(
-    const std::string& name, MemMap&& mem_map, bool use_generational_cc) {
-  return new RegionSpace(name, std::move(mem_map), use_generational_cc);
+RegionSpace* RegionSpace::Create(const std::string& name,
+                                 MemMap&& mem_map,
+                                 bool use_generational_cc,
+                                 bool use_numa_aware_allocation) {
+  return new RegionSpace(name, std::move(mem_map), use_generational_cc, use_numa_aware_allocation);
 }
 
-RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_generational_cc)
+RegionSpace::RegionSpace(const std::string& name,
+                         MemMap&& mem_map,
+                         bool use_generational_cc,
+                         bool use_numa_aware_allocation)
     : ContinuousMemMapAllocSpace(name,
                                  std::move(mem_map),
                                  mem_map.Begin(),
@@ -110,11 +134,13 @@ RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_gen
       use_generational_cc_(use_generational_cc),
       time_(1U),
       num_regions_(mem_map_.Size() / kRegionSize),
+      num_numa_nodes_(1U),
       madvise_time_(0U),
       num_non_free_regions_(0U),
       num_evac_regions_(0U),
       max_peak_num_non_free_regions_(0U),
       non_free_region_index_limit_(0U),
+      evac_region_age_(1U),
       current_region_(&full_region_),
       evac_region_(nullptr),
       cyclic_alloc_region_index_(0U) {
@@ -126,6 +152,21 @@ RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_gen
   for (size_t i = 0; i < num_regions_; ++i, region_addr += kRegionSize) {
     regions_[i].Init(i, region_addr, region_addr + kRegionSize);
   }
+  if (use_numa_aware_allocation && GetNumaNodeCount() > 1U) {
+    // Each node gets a pool of contiguous regions whose pages are preferably backed by memory of
+    // that node. The policy survives the madvise calls releasing cleared regions.
+    num_numa_nodes_ = std::min(GetNumaNodeCount(), num_regions_);
+    for (size_t node = 0; node < num_numa_nodes_; ++node) {
+      Region* first = &regions_[FirstRegionOfNumaNode(node)];
+      size_t num_node_regions = FirstRegionOfNumaNode(node + 1) - FirstRegionOfNumaNode(node);
+      if (!SetPreferredNumaNode(first->Begin(), num_node_regions * kRegionSize, node)) {
+        PLOG(WARNING) << "Failed to bind the region space pool of NUMA node " << node
+                      << ", disabling NUMA-aware region allocation";
+        num_numa_nodes_ = 1U;
+        break;
+      }
+    }
+  }
   mark_bitmap_ =
       accounting::ContinuousSpaceBitmap::Create("region space live bitmap", Begin(), Capacity());
   if (kIsDebugBuild) {
@@ -204,6 +245,9 @@ void RegionSpace::Region::SetAsUnevacFromSpace(bool clear_live_bytes) {
     // to RegionSpace::SetFromSpace and RegionSpace::ClearFromSpace).
     is_newly_allocated_ = false;
   }
+  // Remember the live bytes of an allocated region to measure how many of them survive this
+  // collection (see RegionSpace::RecordRegionSurvival).
+  prev_live_bytes_ = (clear_live_bytes && IsAllocated()) ? live_bytes_ : static_cast<size_t>(-1);
   if (clear_live_bytes) {
     // Reset the live bytes, as we have made a non-evacuation
     // decision (possibly based on the percentage of live bytes).
@@ -347,6 +391,10 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
   // Flag to store whether the previously seen large region has been evacuated.
   // This is used to apply the same evacuation policy to related large tail regions.
   bool prev_large_evacuated = false;
+  // Bytes to be copied out of the evacuated regions, and the same weighted by the age they will
+  // have once copied, to compute the age of the evacuation regions of this collection.
+  uint64_t evac_bytes = 0U;
+  uint64_t evac_age_bytes = 0U;
   VerifyNonFreeRegionLimit();
   const size_t iter_limit = kUseTableLookupReadBarrier
       ? num_regions_
@@ -363,6 +411,27 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
                type == RegionType::kRegionTypeToSpace);
         bool should_evacuate = r->ShouldBeEvacuated(evac_mode);
         bool is_newly_allocated = r->IsNewlyAllocated();
+        if (kAdaptiveEvacuation &&
+            should_evacuate &&
+            evac_mode == kEvacModeLivePercentNewlyAllocated &&
+            ShouldDeferEvacuation(r)) {
+          ++region_age_stats_[r->Age()].deferred_regions;
+          should_evacuate = false;
+        }
+        if (should_evacuate && state == RegionState::kRegionStateAllocated) {
+          RegionAgeStats& stats = region_age_stats_[r->Age()];
+          ++stats.evacuated_regions;
+          // Newly allocated regions have no live bytes count; their allocated bytes are an
+          // upper bound of what gets copied.
+          size_t bytes = r->BytesAllocated();
+          if (r->LiveBytes() != static_cast<size_t>(-1)) {
+            bytes = r->LiveBytes();
+            stats.copied_bytes += r->LiveBytes();
+            stats.freed_bytes += r->BytesAllocated() - r->LiveBytes();
+          }
+          evac_bytes += bytes;
+          evac_age_bytes += bytes * std::min<size_t>(r->Age() + 1U, kRegionAgeBuckets - 1);
+        }
         if (should_evacuate) {
           r->SetAsFromSpace();
           DCHECK(r->IsInFromSpace());
@@ -410,6 +479,82 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
   DCHECK_EQ(num_expected_large_tails, 0U);
   current_region_ = &full_region_;
   evac_region_ = &full_region_;
+  // Evacuation regions mix the objects of all the evacuated regions; give them the average age of
+  // the copied bytes, so that long-lived objects keep (most of) their age across an evacuation.
+  evac_region_age_ = (evac_bytes == 0U)
+      ? 1U
+      : std::max<uint64_t>((evac_age_bytes + evac_bytes / 2U) / evac_bytes, 1U);
+}
+
+bool RegionSpace::HasSurvivalSamples(size_t age) {
+  DCHECK_LT(age, kRegionAgeBuckets);
+  return region_age_stats_[age].recent_sampled_bytes >= kMinSurvivalSampleBytes;
+}
+
+size_t RegionSpace::PredictedSurvivalPerMille(size_t age) {
+  DCHECK_LT(age, kRegionAgeBuckets);
+  DCHECK(HasSurvivalSamples(age));
+  const RegionAgeStats& stats = region_age_stats_[age];
+  return std::min<uint64_t>(stats.recent_surviving_bytes * 1000U / stats.recent_sampled_bytes,
+                            1000U);
+}
+
+bool RegionSpace::ShouldDeferEvacuation(const Region* r) {
+  if (!r->IsAllocated() ||
+      r->IsNewlyAllocated() ||
+      r->LiveBytes() == static_cast<size_t>(-1) ||
+      !HasSurvivalSamples(r->Age())) {
+    return false;
+  }
+  // Evacuating the region frees its `dead_bytes`, at the cost of copying the part of its
+  // `live_bytes` (counted at the previous collection) which survives this one, as predicted by
+  // the survival rate of the regions of its age. Defer the evacuation when copying costs more
+  // than it frees: regions of long-lived data are then left in place instead of being copied
+  // again at every collection.
+  const size_t live_bytes = r->LiveBytes();
+  const size_t dead_bytes = RoundUp(r->BytesAllocated(), kRegionSize) - live_bytes;
+  const size_t copied_bytes = live_bytes * PredictedSurvivalPerMille(r->Age()) / 1000U;
+  return copied_bytes > dead_bytes;
+}
+
+void RegionSpace::RecordRegionSurvival(const Region* r) {
+  DCHECK(r->IsInUnevacFromSpace());
+  if (!r->IsAllocated() ||
+      r->PrevLiveBytes() == static_cast<size_t>(-1) ||
+      r->LiveBytes() == static_cast<size_t>(-1)) {
+    return;
+  }
+  // With Generational CC, the live bytes count may have been carried over sticky-bit collections
+  // and be larger than the number of bytes live at the previous collection; clamp the sample.
+  const size_t surviving_bytes = std::min(r->LiveBytes(), r->PrevLiveBytes());
+  RegionAgeStats& stats = region_age_stats_[r->Age()];
+  stats.sampled_bytes += r->PrevLiveBytes();
+  stats.surviving_bytes += surviving_bytes;
+  stats.recent_sampled_bytes += r->PrevLiveBytes();
+  stats.recent_surviving_bytes += surviving_bytes;
+}
+
+void RegionSpace::DumpRegionAgeStats(std::ostream& os) {
+  MutexLock mu(Thread::Current(), region_lock_);
+  for (size_t age = 0; age < kRegionAgeBuckets; ++age) {
+    const RegionAgeStats& stats = region_age_stats_[age];
+    if (stats.evacuated_regions == 0U &&
+        stats.deferred_regions == 0U &&
+        stats.sampled_bytes == 0U) {
+      continue;
+    }
+    os << "Regions of age " << age << ((age == kRegionAgeBuckets - 1) ? "+" : "")
+       << ": evacuated " << stats.evacuated_regions
+       << " (copied " << PrettySize(stats.copied_bytes)
+       << ", freed " << PrettySize(stats.freed_bytes) << ")"
+       << ", deferred " << stats.deferred_regions;
+    if (stats.sampled_bytes != 0U) {
+      os << ", survival " << PrettySize(stats.surviving_bytes)
+         << "/" << PrettySize(stats.sampled_bytes)
+         << " (" << (stats.surviving_bytes * 100U / stats.sampled_bytes) << "%)";
+    }
+    os << "\n";
+  }
 }
 
 static void ZeroAndProtectRegion(uint8_t* begin, uint8_t* end) {
@@ -437,6 +582,11 @@ void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
   // Gather memory ranges that need to be madvised.
   {
     MutexLock mu(Thread::Current(), region_lock_);
+    // Age the recent survival samples before adding the ones of this collection.
+    for (RegionAgeStats& stats : region_age_stats_) {
+      stats.recent_sampled_bytes -= stats.recent_sampled_bytes >> kSurvivalDecayShift;
+      stats.recent_surviving_bytes -= stats.recent_surviving_bytes >> kSurvivalDecayShift;
+    }
     // Lambda expression `expand_madvise_range` adds a region to the "clear block".
     //
     // As we iterate over from-space regions, we maintain a "clear block", composed of
@@ -472,6 +622,7 @@ void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
       if (r->IsInFromSpace()) {
         expand_madvise_range(r);
       } else if (r->IsInUnevacFromSpace()) {
+        RecordRegionSurvival(r);
         // We must skip tails of live large objects.
         if (r->LiveBytes() == 0 && !r->IsLargeTail()) {
           // Special case for 0 live bytes, this means all of the objects in the region are
@@ -822,6 +973,42 @@ void RegionSpace::Dump(std::ostream& os) const {
      << reinterpret_cast<void*>(Begin()) << "-" << reinterpret_cast<void*>(Limit());
 }
 
+bool RegionSpace::ReleaseFreeRegionsUntil(uint64_t deadline_ns,
+                                          size_t* cursor,
+                                          size_t* released_bytes) {
+  Thread* const self = Thread::Current();
+  size_t i = *cursor;
+  while (i < num_regions_) {
+    {
+      // Unlike RegionSpace::ClearFromSpace, we need to hold `region_lock_` while calling madvise
+      // as nothing else prevents a free region from being allocated meanwhile. The lock is only
+      // held for one run of free regions at a time so that allocations are not blocked for long.
+      MutexLock mu(self, region_lock_);
+      while (i < num_regions_ && !regions_[i].IsFree()) {
+        ++i;
+      }
+      if (i == num_regions_) {
+        break;
+      }
+      // Release runs of adjacent free regions at once.
+      size_t end = i + 1;
+      while (end < num_regions_ && regions_[end].IsFree()) {
+        ++end;
+      }
+      uint8_t* begin_addr = regions_[i].Begin();
+      size_t length = (end - i) * kRegionSize;
+      CheckedCall(madvise, __FUNCTION__, begin_addr, length, MADV_DONTNEED);
+      *released_bytes += length;
+      i = end;
+    }
+    if (NanoTime() >= deadline_ns) {
+      break;
+    }
+  }
+  *cursor = i;
+  return i == num_regions_;
+}
+
 void RegionSpace::DumpRegionForObject(std::ostream& os, mirror::Object* obj) {
   CHECK(HasAddress(obj));
   MutexLock mu(Thread::Current(), region_lock_);
@@ -864,6 +1051,15 @@ bool RegionSpace::AllocNewTlab(Thread* self,
     // Fetch the largest partial TLAB. The multimap is ordered in decreasing
     // size.
     auto largest_partial_tlab = partial_tlabs_.begin();
+    if (num_numa_nodes_ > 1U) {
+      // Take the largest partial TLAB of the calling thread's node instead, if it is big enough.
+      const size_t node = CurrentNumaNode();
+      while (largest_partial_tlab != partial_tlabs_.end() &&
+             largest_partial_tlab->first >= tlab_size &&
+             RegionNumaNode(largest_partial_tlab->second->idx_) != node) {
+        ++largest_partial_tlab;
+      }
+    }
     if (largest_partial_tlab != partial_tlabs_.end() && largest_partial_tlab->first >= tlab_size) {
       r = largest_partial_tlab->second;
       pos = r->End() - largest_partial_tlab->first;
@@ -961,6 +1157,7 @@ void RegionSpace::Region::Dump(std::ostream& os) const {
      << " type=" << type_
      << " objects_allocated=" << objects_allocated_
      << " alloc_time=" << alloc_time_
+     << " age=" << static_cast<uint>(age_)
      << " live_bytes=" << live_bytes_;
 
   if (live_bytes_ != static_cast<size_t>(-1)) {
@@ -1021,6 +1218,8 @@ void RegionSpace::Region::Clear(bool zero_and_release_pages) {
   objects_allocated_.store(0, std::memory_order_relaxed);
   alloc_time_ = 0;
   live_bytes_ = static_cast<size_t>(-1);
+  prev_live_bytes_ = static_cast<size_t>(-1);
+  age_ = 0;
   if (zero_and_release_pages) {
     ZeroAndProtectRegion(begin_, end_);
   }
@@ -1034,10 +1233,47 @@ void RegionSpace::TraceHeapSize() {
   heap->TraceHeapSize(heap->GetBytesAllocated() + EvacBytes());
 }
 
+size_t RegionSpace::CurrentNumaNode() const {
+  return (num_numa_nodes_ > 1U) ? std::min(GetCurrentNumaNode(), num_numa_nodes_ - 1) : 0U;
+}
+
+void RegionSpace::ClaimRegion(Region* r, bool for_evac) {
+  r->Unfree(this, time_);
+  if (use_generational_cc_) {
+    // TODO: Add an explanation for this assertion.
+    DCHECK(!for_evac || !r->is_newly_allocated_);
+  }
+  if (for_evac) {
+    ++num_evac_regions_;
+    TraceHeapSize();
+    // Evac doesn't count as newly allocated. The objects copied into it survived the
+    // current collection (see RegionSpace::SetFromSpace).
+    r->age_ = evac_region_age_;
+  } else {
+    r->SetNewlyAllocated();
+    ++num_non_free_regions_;
+  }
+}
+
 RegionSpace::Region* RegionSpace::AllocateRegion(bool for_evac) {
   if (!for_evac && (num_non_free_regions_ + 1) * 2 > num_regions_) {
     return nullptr;
   }
+  if (num_numa_nodes_ > 1U) {
+    // Prefer a region of the pool of the calling thread's node, so that the TLABs of mutators
+    // and the objects copied by GC threads sit on local memory.
+    const size_t node = CurrentNumaNode();
+    for (size_t i = FirstRegionOfNumaNode(node), end = FirstRegionOfNumaNode(node + 1);
+         i < end;
+         ++i) {
+      Region* r = &regions_[i];
+      if (r->IsFree()) {
+        ClaimRegion(r, for_evac);
+        return r;
+      }
+    }
+    // Fall back to the regions of the other nodes.
+  }
   for (size_t i = 0; i < num_regions_; ++i) {
     // When using the cyclic region allocation strategy, try to
     // allocate a region starting from the last cyclic allocated
@@ -1048,19 +1284,7 @@ RegionSpace::Region* RegionSpace::AllocateRegion(bool for_evac) {
         : i;
     Region* r = &regions_[region_index];
     if (r->IsFree()) {
-      r->Unfree(this, time_);
-      if (use_generational_cc_) {
-        // TODO: Add an explanation for this assertion.
-        DCHECK(!for_evac || !r->is_newly_allocated_);
-      }
-      if (for_evac) {
-        ++num_evac_regions_;
-        TraceHeapSize();
-        // Evac doesn't count as newly allocated.
-      } else {
-        r->SetNewlyAllocated();
-        ++num_non_free_regions_;
-      }
+      ClaimRegion(r, for_evac);
       if (kCyclicRegionAllocation) {
         // Move the cyclic allocation region marker to the region
         // following the one that was just allocated.
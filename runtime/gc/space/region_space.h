@@ -22,6 +22,7 @@
 #include "space.h"
 #include "thread.h"
 
+#include <array>
 #include <functional>
 #include <map>
 
@@ -60,9 +61,18 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
 
   // Create a region space mem map with the requested sizes. The requested base address is not
   // guaranteed to be granted, if it is required, the caller should call Begin on the returned
-  // space to confirm the request was granted.
-  static MemMap CreateMemMap(const std::string& name, size_t capacity, uint8_t* requested_begin);
-  static RegionSpace* Create(const std::string& name, MemMap&& mem_map, bool use_generational_cc);
+  // space to confirm the request was granted. With `use_huge_pages`, the map is aligned to
+  // huge pages when `capacity` allows it.
+  static MemMap CreateMemMap(const std::string& name,
+                             size_t capacity,
+                             uint8_t* requested_begin,
+                             bool use_huge_pages = false);
+  // With `use_numa_aware_allocation`, the regions are partitioned in one contiguous pool per NUMA
+  // node, backed by memory of that node, and threads get regions of their own node first.
+  static RegionSpace* Create(const std::string& name,
+                             MemMap&& mem_map,
+                             bool use_generational_cc,
+                             bool use_numa_aware_allocation = false);
 
   // Allocate `num_bytes`, returns null if the space is full.
   mirror::Object* Alloc(Thread* self,
@@ -143,6 +153,17 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   void DumpRegionForObject(std::ostream& os, mirror::Object* obj) REQUIRES(!region_lock_);
   void DumpNonFreeRegions(std::ostream& os) REQUIRES(!region_lock_);
 
+  // Release the pages of the free regions again, starting at region `*cursor`, until all regions
+  // have been visited or `deadline_ns` has passed. Free regions are released when they are
+  // cleared, but khugepaged may have since collapsed them into huge pages together with their
+  // allocated neighbours. Updates `*cursor` to the region to resume from and adds the number of
+  // bytes released to `*released_bytes`. Returns true once all regions have been visited. Used by
+  // the incremental heap trim.
+  bool ReleaseFreeRegionsUntil(uint64_t deadline_ns, size_t* cursor, size_t* released_bytes)
+      REQUIRES(!region_lock_);
+  // Dump the per-age survival and evacuation statistics of the allocated regions.
+  void DumpRegionAgeStats(std::ostream& os) REQUIRES(!region_lock_);
+
   size_t RevokeThreadLocalBuffers(Thread* thread) override REQUIRES(!region_lock_);
   size_t RevokeThreadLocalBuffers(Thread* thread, const bool reuse) REQUIRES(!region_lock_);
   size_t RevokeAllThreadLocalBuffers() override
@@ -234,6 +255,9 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   static constexpr size_t kAlignment = kObjectAlignment;
   // The region size.
   static constexpr size_t kRegionSize = 256 * KB;
+  // The number of age buckets of the region survival statistics. The age of a region is the
+  // number of collections its objects have survived, saturated at `kRegionAgeBuckets - 1`.
+  static constexpr size_t kRegionAgeBuckets = 8;
 
   bool IsInFromSpace(mirror::Object* ref) {
     if (HasAddress(ref)) {
@@ -385,7 +409,10 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   }
 
  private:
-  RegionSpace(const std::string& name, MemMap&& mem_map, bool use_generational_cc);
+  RegionSpace(const std::string& name,
+              MemMap&& mem_map,
+              bool use_generational_cc,
+              bool use_numa_aware_allocation);
 
   class Region {
    public:
@@ -398,6 +425,8 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
           end_(nullptr),
           objects_allocated_(0),
           alloc_time_(0),
+          prev_live_bytes_(static_cast<size_t>(-1)),
+          age_(0),
           is_newly_allocated_(false),
           is_a_tlab_(false),
           state_(RegionState::kRegionStateAllocated),
@@ -413,6 +442,8 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
       objects_allocated_.store(0, std::memory_order_relaxed);
       alloc_time_ = 0;
       live_bytes_ = static_cast<size_t>(-1);
+      prev_live_bytes_ = static_cast<size_t>(-1);
+      age_ = 0;
       is_newly_allocated_ = false;
       is_a_tlab_ = false;
       thread_ = nullptr;
@@ -551,6 +582,10 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     void SetUnevacFromSpaceAsToSpace() {
       DCHECK(!IsFree() && IsInUnevacFromSpace());
       type_ = RegionType::kRegionTypeToSpace;
+      // The objects of this region survived one more collection.
+      if (age_ < kRegionAgeBuckets - 1) {
+        ++age_;
+      }
     }
 
     // Return whether this region should be evacuated. Used by RegionSpace::SetFromSpace.
@@ -573,6 +608,17 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
       return live_bytes_;
     }
 
+    // The live bytes count on which the last non-evacuation decision was based, or -1 if it was
+    // undefined. Compared with `LiveBytes()` at the end of the collection, this tells how many of
+    // these bytes survived the collection.
+    size_t PrevLiveBytes() const {
+      return prev_live_bytes_;
+    }
+
+    size_t Age() const {
+      return age_;
+    }
+
     // Returns the number of allocated bytes.  "Bulk allocated" bytes in active TLABs are excluded.
     size_t BytesAllocated() const;
 
@@ -626,6 +672,8 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     // are concurrent updates.
     Atomic<size_t> objects_allocated_;  // The number of objects allocated.
     uint32_t alloc_time_;               // The allocation time of the region.
+    size_t prev_live_bytes_;            // The live bytes at the last non-evacuation decision.
+    uint8_t age_;                       // The number of collections survived (see Age()).
     // Note that newly allocated and evacuated regions use -1 as
     // special value for `live_bytes_`.
     bool is_newly_allocated_;           // True if it's allocated after the last collection.
@@ -707,6 +755,53 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   }
 
   Region* AllocateRegion(bool for_evac) REQUIRES(region_lock_);
+  // Declare free region `r` allocated, for evacuation or not. Helper of AllocateRegion.
+  void ClaimRegion(Region* r, bool for_evac) REQUIRES(region_lock_);
+
+  // The NUMA node whose pool holds region `idx`. Region `i` belongs to node
+  // `i * num_numa_nodes_ / num_regions_`.
+  size_t RegionNumaNode(size_t idx) const {
+    return idx * num_numa_nodes_ / num_regions_;
+  }
+  // The index of the first region of the pool of NUMA node `node`, or `num_regions_` when `node`
+  // is `num_numa_nodes_`.
+  size_t FirstRegionOfNumaNode(size_t node) const {
+    return (node * num_regions_ + num_numa_nodes_ - 1) / num_numa_nodes_;
+  }
+  // The NUMA node of the calling thread, or 0 when the space is not NUMA-aware.
+  size_t CurrentNumaNode() const;
+
+  // Survival and evacuation statistics of the allocated (non-large) regions of a given age.
+  struct RegionAgeStats {
+    // Cumulative counters, reported by RegionSpace::DumpRegionAgeStats.
+    uint64_t evacuated_regions = 0;  // Regions evacuated.
+    uint64_t copied_bytes = 0;       // Live bytes of the evacuated regions with valid live bytes.
+    uint64_t freed_bytes = 0;        // Dead bytes of the evacuated regions with valid live bytes.
+    uint64_t deferred_regions = 0;   // Regions not evacuated because of the adaptive policy.
+    uint64_t sampled_bytes = 0;      // Live bytes of unevacuated regions at the previous GC.
+    uint64_t surviving_bytes = 0;    // The part of `sampled_bytes` still live after this GC.
+    // Exponentially decayed versions of `sampled_bytes` and `surviving_bytes`, from which the
+    // adaptive evacuation policy predicts the survival rate of the bytes of a region of this age.
+    uint64_t recent_sampled_bytes = 0;
+    uint64_t recent_surviving_bytes = 0;
+  };
+
+  // Return whether there are enough survival samples for regions of age `age` to predict their
+  // survival.
+  bool HasSurvivalSamples(size_t age) REQUIRES(region_lock_);
+
+  // Return the predicted fraction (in per mille) of the live bytes of a region of age `age` that
+  // survive a collection. Requires HasSurvivalSamples(age).
+  size_t PredictedSurvivalPerMille(size_t age) REQUIRES(region_lock_);
+
+  // Return whether region `r`, which RegionSpace::Region::ShouldBeEvacuated selected based on its
+  // live percent, should rather be kept for one more cycle as copying its surviving bytes would
+  // cost more than the dead bytes it frees (see RegionSpace::SetFromSpace).
+  bool ShouldDeferEvacuation(const Region* r) REQUIRES(region_lock_);
+
+  // Record in the statistics of its age how many of the live bytes of unevacuated region `r`
+  // survived this collection.
+  void RecordRegionSurvival(const Region* r) REQUIRES(region_lock_);
   void RevokeThreadLocalBuffersLocked(Thread* thread, bool reuse) REQUIRES(region_lock_);
 
   // Scan region range [`begin`, `end`) in increasing order to try to
@@ -742,6 +837,7 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   const bool use_generational_cc_;
   uint32_t time_;                  // The time as the number of collections since the startup.
   size_t num_regions_;             // The number of regions in this space.
+  size_t num_numa_nodes_;          // The number of per-node region pools, 1 if not NUMA-aware.
   uint64_t madvise_time_;          // The amount of time spent in madvise for purging pages.
   // The number of non-free regions in this space.
   size_t num_non_free_regions_ GUARDED_BY(region_lock_);
@@ -767,6 +863,11 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   //   for all `i >= non_free_region_index_limit_`, `regions_[i].IsFree()` is true.
   size_t non_free_region_index_limit_ GUARDED_BY(region_lock_);
 
+  // Per-age survival and evacuation statistics of the allocated regions.
+  std::array<RegionAgeStats, kRegionAgeBuckets> region_age_stats_ GUARDED_BY(region_lock_);
+  // The age given to the evacuation regions of the current collection.
+  uint8_t evac_region_age_ GUARDED_BY(region_lock_);
+
   Region* current_region_;         // The region currently used for allocation.
   Region* evac_region_;            // The region currently used for evacuation.
   Region full_region_;             // The fake/sentinel region that looks full.
@@ -779,6 +880,8 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // Mark bitmap used by the GC.
   accounting::ContinuousSpaceBitmap mark_bitmap_;
 
+  friend class RegionSpaceTest;  // For the adaptive evacuation policy.
+
   DISALLOW_COPY_AND_ASSIGN(RegionSpace);
 };
 
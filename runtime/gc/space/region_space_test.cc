@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "region_space-inl.h"
+
+#include "common_runtime_test.h"
+#include "thread-current-inl.h"
+
+namespace art {
+namespace gc {
+namespace space {
+
+class RegionSpaceTest : public CommonRuntimeTest {
+ protected:
+  static constexpr size_t kNumRegions = 16;
+
+  void SetUp() override {
+    CommonRuntimeTest::SetUp();
+    MemMap mem_map = RegionSpace::CreateMemMap(
+        "region space test", kNumRegions * RegionSpace::kRegionSize, /*requested_begin=*/ nullptr);
+    ASSERT_TRUE(mem_map.IsValid());
+    space_.reset(RegionSpace::Create("region space test",
+                                     std::move(mem_map),
+                                     /*use_generational_cc=*/ false));
+    ASSERT_TRUE(space_ != nullptr);
+  }
+
+  void TearDown() override {
+    space_.reset();
+    CommonRuntimeTest::TearDown();
+  }
+
+  // Set up the next free region as an evacuation region which then survived a collection with
+  // `live_bytes` live bytes, and return its age.
+  size_t AddSurvivorRegion(size_t live_bytes) {
+    MutexLock mu(Thread::Current(), space_->region_lock_);
+    RegionSpace::Region* r = &space_->regions_[next_region_++];
+    CHECK(r->IsFree());
+    space_->ClaimRegion(r, /*for_evac=*/ true);
+    r->SetTop(r->End());
+    r->SetAsUnevacFromSpace(/*clear_live_bytes=*/ true);
+    r->AddLiveBytes(live_bytes);
+    r->SetUnevacFromSpaceAsToSpace();
+    return r->Age();
+  }
+
+  // Record that `survival_percent` of the sampled live bytes of regions of age `age` survived
+  // the collections.
+  void SetSurvival(size_t age, uint64_t survival_percent) {
+    MutexLock mu(Thread::Current(), space_->region_lock_);
+    RegionSpace::RegionAgeStats& stats = space_->region_age_stats_[age];
+    stats.recent_sampled_bytes = 4 * RegionSpace::kRegionSize;
+    stats.recent_surviving_bytes = stats.recent_sampled_bytes * survival_percent / 100U;
+  }
+
+  bool ShouldDeferEvacuationOfLastRegion() {
+    MutexLock mu(Thread::Current(), space_->region_lock_);
+    return space_->ShouldDeferEvacuation(&space_->regions_[next_region_ - 1]);
+  }
+
+  std::unique_ptr<RegionSpace> space_;
+  size_t next_region_ = 0U;
+};
+
+// A region with 60% live bytes is below the live percent threshold, so it is a candidate for
+// evacuation. Copying the live bytes of a high-survival region costs more than the 40% the
+// evacuation frees, so the evacuation is deferred.
+TEST_F(RegionSpaceTest, DeferEvacuationOfHighSurvivalRegion) {
+  size_t age = AddSurvivorRegion(RegionSpace::kRegionSize * 6 / 10);
+  SetSurvival(age, /*survival_percent=*/ 95U);
+  EXPECT_TRUE(ShouldDeferEvacuationOfLastRegion());
+}
+
+TEST_F(RegionSpaceTest, EvacuateLowSurvivalRegion) {
+  size_t age = AddSurvivorRegion(RegionSpace::kRegionSize * 6 / 10);
+  SetSurvival(age, /*survival_percent=*/ 10U);
+  EXPECT_FALSE(ShouldDeferEvacuationOfLastRegion());
+}
+
+// Without survival statistics for its age, the live percent threshold alone decides.
+TEST_F(RegionSpaceTest, EvacuateWithoutSurvivalSamples) {
+  AddSurvivorRegion(RegionSpace::kRegionSize * 6 / 10);
+  EXPECT_FALSE(ShouldDeferEvacuationOfLastRegion());
+}
+
+}  // namespace space
+}  // namespace gc
+}  // namespace art
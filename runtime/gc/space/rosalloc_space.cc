@@ -312,14 +312,7 @@ size_t RosAllocSpace::FreeList(Thread* self, size_t num_ptrs, mirror::Object** p
 
 size_t RosAllocSpace::Trim() {
   VLOG(heap) << "RosAllocSpace::Trim() ";
-  {
-    Thread* const self = Thread::Current();
-    // SOA required for Rosalloc::Trim() -> ArtRosAllocMoreCore() -> Heap::GetRosAllocSpace.
-    ScopedObjectAccess soa(self);
-    MutexLock mu(self, lock_);
-    // Trim to release memory at the end of the space.
-    rosalloc_->Trim();
-  }
+  TrimFootprint();
   // Attempt to release pages if it does not release all empty pages.
   if (!rosalloc_->DoesReleaseAllPages()) {
     return rosalloc_->ReleasePages();
@@ -327,6 +320,25 @@ size_t RosAllocSpace::Trim() {
   return 0;
 }
 
+bool RosAllocSpace::TrimUntil(uint64_t deadline_ns, size_t* cursor, size_t* reclaimed_bytes) {
+  if (*cursor == 0u) {
+    TrimFootprint();
+  }
+  if (rosalloc_->DoesReleaseAllPages()) {
+    return true;
+  }
+  return rosalloc_->ReleasePagesUntil(deadline_ns, cursor, reclaimed_bytes);
+}
+
+void RosAllocSpace::TrimFootprint() {
+  Thread* const self = Thread::Current();
+  // SOA required for Rosalloc::Trim() -> ArtRosAllocMoreCore() -> Heap::GetRosAllocSpace.
+  ScopedObjectAccess soa(self);
+  MutexLock mu(self, lock_);
+  // Trim to release memory at the end of the space.
+  rosalloc_->Trim();
+}
+
 void RosAllocSpace::Walk(void(*callback)(void *start, void *end, size_t num_bytes, void* callback_arg),
                          void* arg) {
   InspectAllRosAlloc(callback, arg, true);
@@ -111,6 +111,10 @@ class RosAllocSpace : public MallocSpace {
   }
 
   size_t Trim() override;
+  // Incremental version of Trim(), releasing empty pages until `deadline_ns` has passed. Resumes
+  // from the page `*cursor` of a previous call, which is updated, and adds the number of bytes
+  // released to `*reclaimed_bytes`. Returns true once the whole space has been trimmed.
+  bool TrimUntil(uint64_t deadline_ns, size_t* cursor, size_t* reclaimed_bytes);
   void Walk(WalkCallback callback, void* arg) override REQUIRES(!lock_);
   size_t GetFootprint() override;
   size_t GetFootprintLimit() override;
@@ -185,6 +189,9 @@ class RosAllocSpace : public MallocSpace {
                                              size_t maximum_size, bool low_memory_mode,
                                              bool running_on_memory_tool);
 
+  // Release the free page run at the end of the space, if any.
+  void TrimFootprint();
+
   void InspectAllRosAlloc(void (*callback)(void *start, void *end, size_t num_bytes, void* callback_arg),
                           void* arg, bool do_null_callback_at_end)
       REQUIRES(!Locks::runtime_shutdown_lock_, !Locks::thread_list_lock_);
@@ -113,6 +113,8 @@ static bool CollectorDoesAllowOrBroadcast() {
     case CollectorType::kCollectorTypeCMS:
     case CollectorType::kCollectorTypeCC:
     case CollectorType::kCollectorTypeSS:
+    case CollectorType::kCollectorTypeGSS:
+    case CollectorType::kCollectorTypeCMC:
       return true;
 
     default:
@@ -52,98 +52,12 @@ void InitMterpTls(Thread* self) {
   self->SetMterpCurrentIBase(artMterpAsmInstructionStart);
 }
 
-/*
- * Find the matching case.  Returns the offset to the handler instructions.
- *
- * Returns 3 if we don't find a match (it's the size of the sparse-switch
- * instruction).
- */
-extern "C" ssize_t MterpDoSparseSwitch(const uint16_t* switchData, int32_t testVal) {
-  const int kInstrLen = 3;
-  uint16_t size;
-  const int32_t* keys;
-  const int32_t* entries;
-
-  /*
-   * Sparse switch data format:
-   *  ushort ident = 0x0200   magic value
-   *  ushort size             number of entries in the table; > 0
-   *  int keys[size]          keys, sorted low-to-high; 32-bit aligned
-   *  int targets[size]       branch targets, relative to switch opcode
-   *
-   * Total size is (2+size*4) 16-bit code units.
-   */
-
-  uint16_t signature = *switchData++;
-  DCHECK_EQ(signature, static_cast<uint16_t>(art::Instruction::kSparseSwitchSignature));
-
-  size = *switchData++;
-
-  /* The keys are guaranteed to be aligned on a 32-bit boundary;
-   * we can treat them as a native int array.
-   */
-  keys = reinterpret_cast<const int32_t*>(switchData);
-
-  /* The entries are guaranteed to be aligned on a 32-bit boundary;
-   * we can treat them as a native int array.
-   */
-  entries = keys + size;
-
-  /*
-   * Binary-search through the array of keys, which are guaranteed to
-   * be sorted low-to-high.
-   */
-  int lo = 0;
-  int hi = size - 1;
-  while (lo <= hi) {
-    int mid = (lo + hi) >> 1;
-
-    int32_t foundVal = keys[mid];
-    if (testVal < foundVal) {
-      hi = mid - 1;
-    } else if (testVal > foundVal) {
-      lo = mid + 1;
-    } else {
-      return entries[mid];
-    }
-  }
-  return kInstrLen;
-}
-
-extern "C" ssize_t MterpDoPackedSwitch(const uint16_t* switchData, int32_t testVal) {
-  const int kInstrLen = 3;
-
-  /*
-   * Packed switch data format:
-   *  ushort ident = 0x0100   magic value
-   *  ushort size             number of entries in the table
-   *  int first_key           first (and lowest) switch case value
-   *  int targets[size]       branch targets, relative to switch opcode
-   *
-   * Total size is (4+size*2) 16-bit code units.
-   */
-  uint16_t signature = *switchData++;
-  DCHECK_EQ(signature, static_cast<uint16_t>(art::Instruction::kPackedSwitchSignature));
-
-  uint16_t size = *switchData++;
-
-  int32_t firstKey = *switchData++;
-  firstKey |= (*switchData++) << 16;
-
-  int index = testVal - firstKey;
-  if (index < 0 || index >= size) {
-    return kInstrLen;
-  }
-
-  /*
-   * The entries are guaranteed to be aligned on a 32-bit boundary;
-   * we can treat them as a native int array.
-   */
-  const int32_t* entries = reinterpret_cast<const int32_t*>(switchData);
-  return entries[index];
+bool CanUseMterp()
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  return CanUseFastInterpreter();
 }
 
-bool CanUseMterp()
+bool CanUseFastInterpreter()
     REQUIRES_SHARED(Locks::mutator_lock_) {
   const Runtime* const runtime = Runtime::Current();
   return
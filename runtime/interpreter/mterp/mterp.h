@@ -37,6 +37,8 @@ namespace interpreter {
 void InitMterpTls(Thread* self);
 void CheckMterpAsmConstants();
 bool CanUseMterp();
+// Whether the runtime state allows an assembly interpreter (mterp or nterp) to run.
+bool CanUseFastInterpreter();
 
 // Poison value for TestExportPC.  If we segfault with this value, it means that a mterp
 // handler for a recent opcode failed to export the Dalvik PC prior to a possible exit from
@@ -35,9 +35,14 @@ void InitMterpTls(Thread* self) {
 
 bool CanUseMterp()
     REQUIRES_SHARED(Locks::mutator_lock_) {
+  // There is no mterp on LoongArch64, only nterp.
+  return kRuntimeISA != InstructionSet::kLoongarch64 && CanUseFastInterpreter();
+}
+
+bool CanUseFastInterpreter()
+    REQUIRES_SHARED(Locks::mutator_lock_) {
   const Runtime* const runtime = Runtime::Current();
   return
-      kRuntimeISA != InstructionSet::kLoongarch64 &&
       !runtime->IsAotCompiler() &&
       !runtime->GetInstrumentation()->IsActive() &&
       // mterp only knows how to deal with the normal exits. It cannot handle any of the
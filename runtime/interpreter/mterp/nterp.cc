@@ -33,8 +33,7 @@ namespace art {
 namespace interpreter {
 
 bool IsNterpSupported() {
-  return !kPoisonHeapReferences && kUseReadBarrier &&
-         kRuntimeISA != InstructionSet::kLoongarch64;
+  return !kPoisonHeapReferences && kUseReadBarrier;
 }
 
 bool CanRuntimeUseNterp() REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -44,7 +43,7 @@ bool CanRuntimeUseNterp() REQUIRES_SHARED(Locks::mutator_lock_) {
   // If the runtime is interpreter only, we currently don't use nterp as some
   // parts of the runtime (like instrumentation) make assumption on an
   // interpreter-only runtime to always be in a switch-like interpreter.
-  return IsNterpSupported() && CanUseMterp() && !instr->InterpretOnly();
+  return IsNterpSupported() && CanUseFastInterpreter() && !instr->InterpretOnly();
 }
 
 const void* GetNterpEntryPoint() {
@@ -105,6 +105,8 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
       options.GetOrDefault(RuntimeArgumentMap::JITPoolThreadPthreadPriority);
   jit_options->zygote_thread_pool_pthread_priority_ =
       options.GetOrDefault(RuntimeArgumentMap::JITZygotePoolThreadPthreadPriority);
+  jit_options->thread_pool_thread_count_ =
+      std::max(options.GetOrDefault(RuntimeArgumentMap::JITPoolThreads), 1u);
 
   // Set default compile threshold to aid with checking defaults.
   jit_options->compile_threshold_ =
@@ -370,7 +372,7 @@ void Jit::WaitForWorkersToBeCreated() {
 void Jit::DeleteThreadPool() {
   Thread* self = Thread::Current();
   if (thread_pool_ != nullptr) {
-    std::unique_ptr<ThreadPool> pool;
+    std::unique_ptr<JitThreadPool> pool;
     {
       ScopedSuspendAll ssa(__FUNCTION__);
       // Clear thread_pool_ field while the threads are suspended.
@@ -797,7 +799,14 @@ class JitCompileTask final : public Task {
       switch (kind_) {
         case TaskKind::kCompile:
         case TaskKind::kPreCompile: {
-          Runtime::Current()->GetJit()->CompileMethod(
+          Jit* jit = Runtime::Current()->GetJit();
+          if (kind_ == TaskKind::kCompile &&
+              compilation_kind_ == CompilationKind::kBaseline &&
+              jit->GetCodeCache()->ContainsPc(method_->GetEntryPointFromQuickCompiledCode())) {
+            // The method got compiled while this request was queued, nothing to do.
+            break;
+          }
+          jit->CompileMethod(
               method_,
               self,
               compilation_kind_,
@@ -822,6 +831,176 @@ class JitCompileTask final : public Task {
   DISALLOW_IMPLICIT_CONSTRUCTORS(JitCompileTask);
 };
 
+// Urgency of a compilation kind, lower is more urgent. OSR requests come first as the method is
+// stuck in a loop in the interpreter, and optimized requests come before baseline ones as the
+// method already proved to be hot in baseline code.
+static int GetCompilationKindRank(CompilationKind compilation_kind) {
+  switch (compilation_kind) {
+    case CompilationKind::kOsr:
+      return 0;
+    case CompilationKind::kOptimized:
+      return 1;
+    case CompilationKind::kBaseline:
+      return 2;
+  }
+}
+
+JitThreadPool* JitThreadPool::Create(const char* name, size_t num_threads, bool create_peers) {
+  JitThreadPool* pool = new JitThreadPool(name, num_threads, create_peers);
+  pool->CreateThreads();
+  return pool;
+}
+
+JitThreadPool::CompileRequest* JitThreadPool::FindCoveringRequestLocked(
+    ArtMethod* method, CompilationKind compilation_kind) {
+  for (CompileRequest& request : compile_requests_) {
+    if (request.method == method &&
+        (request.compilation_kind == compilation_kind ||
+         (compilation_kind == CompilationKind::kBaseline &&
+          request.compilation_kind == CompilationKind::kOptimized))) {
+      return &request;
+    }
+  }
+  return nullptr;
+}
+
+std::vector<JitThreadPool::CompileRequest>::iterator
+JitThreadPool::FindMostUrgentRequestLocked() {
+  DCHECK(!compile_requests_.empty());
+  auto best = compile_requests_.begin();
+  for (auto it = best + 1; it != compile_requests_.end(); ++it) {
+    if (IsMoreUrgent(*it, *best)) {
+      best = it;
+    }
+  }
+  return best;
+}
+
+bool JitThreadPool::IsMoreUrgent(const CompileRequest& lhs, const CompileRequest& rhs) {
+  int lhs_rank = GetCompilationKindRank(lhs.compilation_kind);
+  int rhs_rank = GetCompilationKindRank(rhs.compilation_kind);
+  if (lhs_rank != rhs_rank) {
+    return lhs_rank < rhs_rank;
+  }
+  if (lhs.hits != rhs.hits) {
+    return lhs.hits > rhs.hits;
+  }
+  // The hotness counters keep moving while requests wait, so read them now.
+  uint16_t lhs_counter = lhs.method->GetCounter();
+  uint16_t rhs_counter = rhs.method->GetCounter();
+  if (lhs_counter != rhs_counter) {
+    return lhs_counter > rhs_counter;
+  }
+  return lhs.sequence < rhs.sequence;
+}
+
+bool JitThreadPool::AddCompileTask(Thread* self,
+                                   ArtMethod* method,
+                                   CompilationKind compilation_kind) {
+  {
+    MutexLock mu(self, task_queue_lock_);
+    CompileRequest* pending = FindCoveringRequestLocked(method, compilation_kind);
+    if (pending != nullptr) {
+      ++pending->hits;
+      return false;
+    }
+  }
+  // The task may add a global reference, create it outside of the lock.
+  Task* task = new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, compilation_kind);
+  std::vector<Task*> dropped;
+  {
+    MutexLock mu(self, task_queue_lock_);
+    CompileRequest* pending = FindCoveringRequestLocked(method, compilation_kind);
+    if (pending != nullptr) {
+      // Another thread queued the same request in the meantime.
+      ++pending->hits;
+      dropped.push_back(task);
+    } else {
+      uint32_t hits = 1u;
+      if (compilation_kind == CompilationKind::kOptimized) {
+        // An optimized compilation supersedes a pending baseline one.
+        auto it = std::find_if(compile_requests_.begin(),
+                               compile_requests_.end(),
+                               [method](const CompileRequest& request) {
+                                 return request.method == method &&
+                                     request.compilation_kind == CompilationKind::kBaseline;
+                               });
+        if (it != compile_requests_.end()) {
+          hits += it->hits;
+          dropped.push_back(it->task);
+          compile_requests_.erase(it);
+        }
+      }
+      compile_requests_.push_back({method, compilation_kind, hits, next_sequence_++, task});
+      if (started_ && waiting_count_ != 0) {
+        task_queue_condition_.Signal(self);
+      }
+    }
+  }
+  for (Task* dropped_task : dropped) {
+    dropped_task->Finalize();
+  }
+  return dropped.empty() || dropped.front() != task;
+}
+
+Task* JitThreadPool::GetTask(Thread* self) {
+  {
+    MutexLock mu(self, task_queue_lock_);
+    if (generic_task_owner_ == self) {
+      // The worker is done with its task of the FIFO queue, let any worker run the next one.
+      generic_task_owner_ = nullptr;
+      if (started_ && !tasks_.empty() && waiting_count_ != 0) {
+        task_queue_condition_.Signal(self);
+      }
+    }
+  }
+  return ThreadPool::GetTask(self);
+}
+
+Task* JitThreadPool::TryGetTaskLocked() {
+  if (!started_) {
+    return nullptr;
+  }
+  if (!compile_requests_.empty()) {
+    auto best = FindMostUrgentRequestLocked();
+    Task* task = best->task;
+    compile_requests_.erase(best);
+    return task;
+  }
+  // Tasks of the FIFO queue may depend on the ones before them, run them one at a time.
+  Thread* self = Thread::Current();
+  if (generic_task_owner_ != nullptr && generic_task_owner_ != self) {
+    return nullptr;
+  }
+  Task* task = ThreadPool::TryGetTaskLocked();
+  if (task != nullptr) {
+    generic_task_owner_ = self;
+  }
+  return task;
+}
+
+void JitThreadPool::RemoveAllTasks(Thread* self) {
+  std::vector<CompileRequest> compile_requests;
+  std::deque<Task*> tasks;
+  {
+    MutexLock mu(self, task_queue_lock_);
+    compile_requests.swap(compile_requests_);
+    tasks.swap(tasks_);
+  }
+  for (const CompileRequest& request : compile_requests) {
+    request.task->Finalize();
+  }
+  for (Task* task : tasks) {
+    task->Finalize();
+  }
+}
+
+size_t JitThreadPool::GetTaskCount(Thread* self) {
+  size_t count = ThreadPool::GetTaskCount(self);
+  MutexLock mu(self, task_queue_lock_);
+  return count + compile_requests_.size();
+}
+
 static std::string GetProfileFile(const std::string& dex_location) {
   // Hardcoded assumption where the profile file is.
   // TODO(ngeoffray): this is brittle and we would need to change change if we
@@ -1185,7 +1364,8 @@ void Jit::CreateThreadPool() {
 
   // We need peers as we may report the JIT thread, e.g., in the debugger.
   constexpr bool kJitPoolNeedsPeers = true;
-  thread_pool_.reset(new ThreadPool("Jit thread pool", 1, kJitPoolNeedsPeers));
+  thread_pool_.reset(JitThreadPool::Create(
+      "Jit thread pool", options_->GetThreadPoolThreadCount(), kJitPoolNeedsPeers));
 
   Runtime* runtime = Runtime::Current();
   thread_pool_->SetPthreadPriority(
@@ -1525,10 +1705,7 @@ bool Jit::MaybeCompileMethod(Thread* self,
     if (old_count < HotMethodThreshold() && new_count >= HotMethodThreshold()) {
       if (!code_cache_->ContainsPc(method->GetEntryPointFromQuickCompiledCode())) {
         DCHECK(thread_pool_ != nullptr);
-        thread_pool_->AddTask(
-            self,
-            new JitCompileTask(
-                method, JitCompileTask::TaskKind::kCompile, CompilationKind::kBaseline));
+        thread_pool_->AddCompileTask(self, method, CompilationKind::kBaseline);
       }
     }
     if (old_count < OSRMethodThreshold() && new_count >= OSRMethodThreshold()) {
@@ -1538,9 +1715,7 @@ bool Jit::MaybeCompileMethod(Thread* self,
       DCHECK(!method->IsNative());  // No back edges reported for native methods.
       if (!code_cache_->IsOsrCompiled(method)) {
         DCHECK(thread_pool_ != nullptr);
-        thread_pool_->AddTask(
-            self,
-            new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, CompilationKind::kOsr));
+        thread_pool_->AddCompileTask(self, method, CompilationKind::kOsr);
       }
     }
   }
@@ -1555,11 +1730,7 @@ void Jit::EnqueueOptimizedCompilation(ArtMethod* method, Thread* self) {
   // hotness threshold. If we're not only using the baseline compiler, enqueue a compilation
   // task that will compile optimize the method.
   if (!options_->UseBaselineCompiler()) {
-    thread_pool_->AddTask(
-        self,
-        new JitCompileTask(method,
-                           JitCompileTask::TaskKind::kCompile,
-                           CompilationKind::kOptimized));
+    thread_pool_->AddCompileTask(self, method, CompilationKind::kOptimized);
   }
 }
 
@@ -1796,21 +1967,13 @@ void Jit::EnqueueCompilationFromNterp(ArtMethod* method, Thread* self) {
   if (GetCodeCache()->ContainsPc(method->GetEntryPointFromQuickCompiledCode())) {
     // If we already have compiled code for it, nterp may be stuck in a loop.
     // Compile OSR.
-    thread_pool_->AddTask(
-        self,
-        new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, CompilationKind::kOsr));
+    thread_pool_->AddCompileTask(self, method, CompilationKind::kOsr);
     return;
   }
   if (GetCodeCache()->CanAllocateProfilingInfo()) {
-    thread_pool_->AddTask(
-        self,
-        new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, CompilationKind::kBaseline));
+    thread_pool_->AddCompileTask(self, method, CompilationKind::kBaseline);
   } else {
-    thread_pool_->AddTask(
-        self,
-        new JitCompileTask(method,
-                           JitCompileTask::TaskKind::kCompile,
-                           CompilationKind::kOptimized));
+    thread_pool_->AddCompileTask(self, method, CompilationKind::kOptimized);
   }
 }
 
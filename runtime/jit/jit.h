@@ -65,6 +65,8 @@ static constexpr int kJitPoolThreadPthreadDefaultPriority = 9;
 // 19 is the lowest background priority on device.
 // See android/os/Process.java.
 static constexpr int kJitZygotePoolThreadPthreadDefaultPriority = 19;
+// How many threads compile hot methods. Configurable with -Xjitthreads.
+static constexpr unsigned int kJitPoolDefaultThreadCount = 1;
 // We check whether to jit-compile the method every Nth invoke.
 // The tests often use threshold of 1000 (and thus 500 to start profiling).
 static constexpr uint32_t kJitSamplesBatchSize = 512;  // Must be power of 2.
@@ -121,6 +123,10 @@ class JitOptions {
     return zygote_thread_pool_pthread_priority_;
   }
 
+  size_t GetThreadPoolThreadCount() const {
+    return thread_pool_thread_count_;
+  }
+
   bool UseJitCompilation() const {
     return use_jit_compilation_;
   }
@@ -172,6 +178,7 @@ class JitOptions {
   bool dump_info_on_shutdown_;
   int thread_pool_pthread_priority_;
   int zygote_thread_pool_pthread_priority_;
+  size_t thread_pool_thread_count_;
   ProfileSaverOptions profile_saver_options_;
 
   JitOptions()
@@ -187,7 +194,8 @@ class JitOptions {
         invoke_transition_weight_(0),
         dump_info_on_shutdown_(false),
         thread_pool_pthread_priority_(kJitPoolThreadPthreadDefaultPriority),
-        zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority) {}
+        zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority),
+        thread_pool_thread_count_(kJitPoolDefaultThreadCount) {}
 
   DISALLOW_COPY_AND_ASSIGN(JitOptions);
 };
@@ -210,6 +218,77 @@ class JitCompilerInterface {
                                                  /*out*/ size_t* num_symbols) = 0;
 };
 
+// The thread pool of the JIT. Compilations of hot methods do not go through the FIFO queue of
+// ThreadPool: they are kept in a separate list from which workers pick the most urgent request
+// first (OSR, then optimized, then baseline, hottest method first). Requests for a method that
+// is already queued are coalesced into the pending one. Other tasks (profile compilation, zygote
+// tasks) keep the FIFO queue and are run one at a time, in order, even with several workers.
+class JitThreadPool final : public ThreadPool {
+ public:
+  // Create the pool and its threads. The workers call the overrides below, so they are only
+  // started once the pool is fully constructed.
+  static JitThreadPool* Create(const char* name, size_t num_threads, bool create_peers);
+
+  // Queue a compilation of `method`. Returns false if the request was merged into a pending one.
+  bool AddCompileTask(Thread* self, ArtMethod* method, CompilationKind compilation_kind)
+      REQUIRES(!task_queue_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  void RemoveAllTasks(Thread* self) override REQUIRES(!task_queue_lock_);
+
+  size_t GetTaskCount(Thread* self) override REQUIRES(!task_queue_lock_);
+
+ protected:
+  Task* GetTask(Thread* self) override REQUIRES(!task_queue_lock_);
+
+  Task* TryGetTaskLocked() override REQUIRES(task_queue_lock_);
+
+  bool HasOutstandingTasks() const override REQUIRES(task_queue_lock_) {
+    return ThreadPool::HasOutstandingTasks() || (started_ && !compile_requests_.empty());
+  }
+
+ private:
+  struct CompileRequest {
+    ArtMethod* method;
+    CompilationKind compilation_kind;
+    // How many requests were coalesced into this one.
+    uint32_t hits;
+    // Order of arrival, to keep FIFO order between requests of the same priority.
+    uint64_t sequence;
+    Task* task;
+  };
+
+  JitThreadPool(const char* name, size_t num_threads, bool create_peers)
+      : ThreadPool(name,
+                   num_threads,
+                   create_peers,
+                   ThreadPoolWorker::kDefaultStackSize,
+                   /* work_stealing= */ false,
+                   /* create_threads= */ false),
+        next_sequence_(0u),
+        generic_task_owner_(nullptr) {}
+
+  // Returns the pending request that makes a compilation of `method` with `compilation_kind`
+  // redundant, or null.
+  CompileRequest* FindCoveringRequestLocked(ArtMethod* method, CompilationKind compilation_kind)
+      REQUIRES(task_queue_lock_);
+
+  // Returns the request to compile next. `compile_requests_` must not be empty.
+  std::vector<CompileRequest>::iterator FindMostUrgentRequestLocked() REQUIRES(task_queue_lock_);
+
+  // Whether `lhs` should be compiled before `rhs`.
+  static bool IsMoreUrgent(const CompileRequest& lhs, const CompileRequest& rhs)
+      NO_THREAD_SAFETY_ANALYSIS;
+
+  std::vector<CompileRequest> compile_requests_ GUARDED_BY(task_queue_lock_);
+  uint64_t next_sequence_ GUARDED_BY(task_queue_lock_);
+  // The worker running a task of the FIFO queue, if any.
+  Thread* generic_task_owner_ GUARDED_BY(task_queue_lock_);
+
+  friend class JitThreadPoolTest;
+
+  DISALLOW_COPY_AND_ASSIGN(JitThreadPool);
+};
+
 // Data structure holding information to perform an OSR.
 struct OsrData {
   // The native PC to jump to.
@@ -383,7 +462,7 @@ class Jit {
   // Load the compiler library.
   static bool LoadCompilerLibrary(std::string* error_msg);
 
-  ThreadPool* GetThreadPool() const {
+  JitThreadPool* GetThreadPool() const {
     return thread_pool_.get();
   }
 
@@ -495,7 +574,7 @@ class Jit {
   jit::JitCodeCache* const code_cache_;
   const JitOptions* const options_;
 
-  std::unique_ptr<ThreadPool> thread_pool_;
+  std::unique_ptr<JitThreadPool> thread_pool_;
   std::vector<std::unique_ptr<OatDexFile>> type_lookup_tables_;
 
   Mutex boot_completed_lock_;
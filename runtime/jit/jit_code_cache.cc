@@ -1436,25 +1436,28 @@ OatQuickMethodHeader* JitCodeCache::LookupOsrMethodHeader(ArtMethod* method) {
 
 ProfilingInfo* JitCodeCache::AddProfilingInfo(Thread* self,
                                               ArtMethod* method,
-                                              const std::vector<uint32_t>& entries) {
+                                              const std::vector<uint32_t>& inline_cache_entries,
+                                              const std::vector<uint32_t>& branch_cache_entries) {
   DCHECK(CanAllocateProfilingInfo());
   ProfilingInfo* info = nullptr;
   {
     MutexLock mu(self, *Locks::jit_lock_);
-    info = AddProfilingInfoInternal(self, method, entries);
+    info = AddProfilingInfoInternal(self, method, inline_cache_entries, branch_cache_entries);
   }
 
   if (info == nullptr) {
     GarbageCollectCache(self);
     MutexLock mu(self, *Locks::jit_lock_);
-    info = AddProfilingInfoInternal(self, method, entries);
+    info = AddProfilingInfoInternal(self, method, inline_cache_entries, branch_cache_entries);
   }
   return info;
 }
 
-ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(Thread* self ATTRIBUTE_UNUSED,
-                                                      ArtMethod* method,
-                                                      const std::vector<uint32_t>& entries) {
+ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(
+    Thread* self ATTRIBUTE_UNUSED,
+    ArtMethod* method,
+    const std::vector<uint32_t>& inline_cache_entries,
+    const std::vector<uint32_t>& branch_cache_entries) {
   // Check whether some other thread has concurrently created it.
   auto it = profiling_infos_.find(method);
   if (it != profiling_infos_.end()) {
@@ -1462,7 +1465,7 @@ ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(Thread* self ATTRIBUTE_UNU
   }
 
   size_t profile_info_size = RoundUp(
-      sizeof(ProfilingInfo) + sizeof(InlineCache) * entries.size(),
+      ProfilingInfo::ComputeSize(inline_cache_entries.size(), branch_cache_entries.size()),
       sizeof(void*));
 
   const uint8_t* data = private_region_.AllocateData(profile_info_size);
@@ -1470,7 +1473,8 @@ ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(Thread* self ATTRIBUTE_UNU
     return nullptr;
   }
   uint8_t* writable_data = private_region_.GetWritableDataAddress(data);
-  ProfilingInfo* info = new (writable_data) ProfilingInfo(method, entries);
+  ProfilingInfo* info =
+      new (writable_data) ProfilingInfo(method, inline_cache_entries, branch_cache_entries);
 
   profiling_infos_.Put(method, info);
   histogram_profiling_info_memory_use_.AddValue(profile_info_size);
@@ -1563,8 +1567,19 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
             cache.dex_pc_, is_missing_types, profile_classes);
       }
     }
+
+    // Save the counts of the branches taken by baseline compiled code.
+    std::vector<ProfileMethodInfo::ProfileBranchCount> branch_counts;
+    BranchCache* branch_caches = info->GetBranchCaches();
+    for (size_t i = 0; i < info->number_of_branch_caches_; ++i) {
+      const BranchCache& cache = branch_caches[i];
+      if (cache.GetFalse() != 0u || cache.GetTrue() != 0u) {
+        branch_counts.emplace_back(/*ProfileMethodInfo::ProfileBranchCount*/
+            cache.GetDexPc(), cache.GetFalse(), cache.GetTrue());
+      }
+    }
     methods.emplace_back(/*ProfileMethodInfo*/
-        MethodReference(dex_file, method->GetDexMethodIndex()), inline_caches);
+        MethodReference(dex_file, method->GetDexMethodIndex()), inline_caches, branch_counts);
   }
 }
 
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "art_method-inl.h"
+#include "class_linker-inl.h"
+#include "common_runtime_test.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art {
+namespace jit {
+
+class JitThreadPoolTest : public CommonRuntimeTest {
+ protected:
+  using Request = std::pair<ArtMethod*, CompilationKind>;
+
+  void SetUp() override {
+    CommonRuntimeTest::SetUp();
+    // The workers are never started, requests stay queued until popped by the test.
+    pool_.reset(JitThreadPool::Create("Jit thread pool test", 1u, /* create_peers= */ false));
+  }
+
+  void TearDown() override {
+    pool_->RemoveAllTasks(Thread::Current());
+    pool_.reset();
+    CommonRuntimeTest::TearDown();
+  }
+
+  // Returns three methods of java.lang.Object with the given hotness counters.
+  std::vector<ArtMethod*> GetMethods(uint16_t counter0, uint16_t counter1, uint16_t counter2)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    ObjPtr<mirror::Class> klass =
+        class_linker_->FindSystemClass(Thread::Current(), "Ljava/lang/Object;");
+    std::vector<ArtMethod*> methods;
+    for (ArtMethod& method : klass->GetDeclaredVirtualMethods(kRuntimePointerSize)) {
+      if (!method.IsAbstract() && methods.size() != 3u) {
+        methods.push_back(&method);
+      }
+    }
+    CHECK_EQ(methods.size(), 3u);
+    methods[0]->SetCounter(counter0);
+    methods[1]->SetCounter(counter1);
+    methods[2]->SetCounter(counter2);
+    return methods;
+  }
+
+  // Removes the request that a worker would compile next, as TryGetTaskLocked() does.
+  Request PopMostUrgentRequest() REQUIRES_SHARED(Locks::mutator_lock_) {
+    Thread* self = Thread::Current();
+    Task* task;
+    Request request;
+    {
+      MutexLock mu(self, pool_->task_queue_lock_);
+      auto it = pool_->FindMostUrgentRequestLocked();
+      request = {it->method, it->compilation_kind};
+      task = it->task;
+      pool_->compile_requests_.erase(it);
+    }
+    task->Finalize();
+    return request;
+  }
+
+  std::unique_ptr<JitThreadPool> pool_;
+};
+
+// OSR requests come first, then optimized ones, then baseline ones ordered by how often they
+// were requested.
+TEST_F(JitThreadPoolTest, PriorityOrder) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  std::vector<ArtMethod*> methods = GetMethods(10u, 10u, 10u);
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[0], CompilationKind::kBaseline));
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[1], CompilationKind::kBaseline));
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[2], CompilationKind::kBaseline));
+  EXPECT_FALSE(pool_->AddCompileTask(self, methods[2], CompilationKind::kBaseline));
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[1], CompilationKind::kOptimized));
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[0], CompilationKind::kOsr));
+  // The optimized request of methods[1] replaced its baseline one, the OSR request of
+  // methods[0] did not.
+  EXPECT_EQ(4u, pool_->GetTaskCount(self));
+
+  EXPECT_EQ(Request(methods[0], CompilationKind::kOsr), PopMostUrgentRequest());
+  EXPECT_EQ(Request(methods[1], CompilationKind::kOptimized), PopMostUrgentRequest());
+  EXPECT_EQ(Request(methods[2], CompilationKind::kBaseline), PopMostUrgentRequest());
+  EXPECT_EQ(Request(methods[0], CompilationKind::kBaseline), PopMostUrgentRequest());
+  EXPECT_EQ(0u, pool_->GetTaskCount(self));
+}
+
+// Between requests of the same kind and count, the hottest method comes first, then the
+// oldest request.
+TEST_F(JitThreadPoolTest, HotnessThenArrivalOrder) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  std::vector<ArtMethod*> methods = GetMethods(5u, 50u, 5u);
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[0], CompilationKind::kBaseline));
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[1], CompilationKind::kBaseline));
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[2], CompilationKind::kBaseline));
+
+  EXPECT_EQ(Request(methods[1], CompilationKind::kBaseline), PopMostUrgentRequest());
+  EXPECT_EQ(Request(methods[0], CompilationKind::kBaseline), PopMostUrgentRequest());
+  EXPECT_EQ(Request(methods[2], CompilationKind::kBaseline), PopMostUrgentRequest());
+}
+
+// An optimized request replaces a pending baseline request of the same method, keeping its
+// count, and covers later baseline requests of that method.
+TEST_F(JitThreadPoolTest, OptimizedSupersedesBaseline) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  std::vector<ArtMethod*> methods = GetMethods(10u, 10u, 10u);
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[0], CompilationKind::kBaseline));
+  EXPECT_FALSE(pool_->AddCompileTask(self, methods[0], CompilationKind::kBaseline));
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[1], CompilationKind::kOptimized));
+  EXPECT_TRUE(pool_->AddCompileTask(self, methods[0], CompilationKind::kOptimized));
+  EXPECT_EQ(2u, pool_->GetTaskCount(self));
+  EXPECT_FALSE(pool_->AddCompileTask(self, methods[0], CompilationKind::kBaseline));
+  EXPECT_EQ(2u, pool_->GetTaskCount(self));
+
+  // The superseding request inherited the two baseline requests, so it comes first.
+  EXPECT_EQ(Request(methods[0], CompilationKind::kOptimized), PopMostUrgentRequest());
+  EXPECT_EQ(Request(methods[1], CompilationKind::kOptimized), PopMostUrgentRequest());
+  EXPECT_EQ(0u, pool_->GetTaskCount(self));
+}
+
+}  // namespace jit
+}  // namespace art
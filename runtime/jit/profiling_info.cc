@@ -16,6 +16,8 @@
 
 #include "profiling_info.h"
 
+#include <algorithm>
+
 #include "art_method-inl.h"
 #include "dex/dex_instruction.h"
 #include "jit/jit.h"
@@ -25,14 +27,22 @@
 
 namespace art {
 
-ProfilingInfo::ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& entries)
+ProfilingInfo::ProfilingInfo(ArtMethod* method,
+                             const std::vector<uint32_t>& inline_cache_entries,
+                             const std::vector<uint32_t>& branch_cache_entries)
       : baseline_hotness_count_(0),
         method_(method),
-        number_of_inline_caches_(entries.size()),
+        number_of_inline_caches_(inline_cache_entries.size()),
+        number_of_branch_caches_(branch_cache_entries.size()),
         current_inline_uses_(0) {
   memset(&cache_, 0, number_of_inline_caches_ * sizeof(InlineCache));
   for (size_t i = 0; i < number_of_inline_caches_; ++i) {
-    cache_[i].dex_pc_ = entries[i];
+    cache_[i].dex_pc_ = inline_cache_entries[i];
+  }
+  BranchCache* branch_caches = GetBranchCaches();
+  memset(branch_caches, 0, number_of_branch_caches_ * sizeof(BranchCache));
+  for (size_t i = 0; i < number_of_branch_caches_; ++i) {
+    branch_caches[i].dex_pc_ = branch_cache_entries[i];
   }
 }
 
@@ -41,14 +51,30 @@ ProfilingInfo* ProfilingInfo::Create(Thread* self, ArtMethod* method) {
   // instructions we are interested in profiling.
   DCHECK(!method->IsNative());
 
-  std::vector<uint32_t> entries;
+  std::vector<uint32_t> inline_cache_entries;
+  std::vector<uint32_t> branch_cache_entries;
   for (const DexInstructionPcPair& inst : method->DexInstructions()) {
     switch (inst->Opcode()) {
       case Instruction::INVOKE_VIRTUAL:
       case Instruction::INVOKE_VIRTUAL_RANGE:
       case Instruction::INVOKE_INTERFACE:
       case Instruction::INVOKE_INTERFACE_RANGE:
-        entries.push_back(inst.DexPc());
+        inline_cache_entries.push_back(inst.DexPc());
+        break;
+
+      case Instruction::IF_EQ:
+      case Instruction::IF_EQZ:
+      case Instruction::IF_NE:
+      case Instruction::IF_NEZ:
+      case Instruction::IF_LT:
+      case Instruction::IF_LTZ:
+      case Instruction::IF_GE:
+      case Instruction::IF_GEZ:
+      case Instruction::IF_GT:
+      case Instruction::IF_GTZ:
+      case Instruction::IF_LE:
+      case Instruction::IF_LEZ:
+        branch_cache_entries.push_back(inst.DexPc());
         break;
 
       default:
@@ -61,7 +87,7 @@ ProfilingInfo* ProfilingInfo::Create(Thread* self, ArtMethod* method) {
 
   // Allocate the `ProfilingInfo` object int the JIT's data space.
   jit::JitCodeCache* code_cache = Runtime::Current()->GetJit()->GetCodeCache();
-  return code_cache->AddProfilingInfo(self, method, entries);
+  return code_cache->AddProfilingInfo(self, method, inline_cache_entries, branch_cache_entries);
 }
 
 InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
@@ -76,6 +102,17 @@ InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
   UNREACHABLE();
 }
 
+BranchCache* ProfilingInfo::GetBranchCache(uint32_t dex_pc) {
+  // The caches are sorted by dex pc, as they were created by walking the dex instructions.
+  BranchCache* begin = GetBranchCaches();
+  BranchCache* end = begin + number_of_branch_caches_;
+  BranchCache* it = std::lower_bound(
+      begin, end, dex_pc, [](const BranchCache& cache, uint32_t pc) {
+        return cache.dex_pc_ < pc;
+      });
+  return (it != end && it->dex_pc_ == dex_pc) ? it : nullptr;
+}
+
 void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
   InlineCache* cache = GetInlineCache(dex_pc);
   for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
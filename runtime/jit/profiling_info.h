@@ -59,6 +59,40 @@ class InlineCache {
   DISALLOW_COPY_AND_ASSIGN(InlineCache);
 };
 
+// Structure to store how many times each side of a conditional branch was taken by baseline
+// compiled code. The counters saturate at the maximum value of uint16_t.
+class BranchCache {
+ public:
+  static constexpr MemberOffset FalseOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(BranchCache, false_));
+  }
+
+  static constexpr MemberOffset TrueOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(BranchCache, true_));
+  }
+
+  uint32_t GetDexPc() const {
+    return dex_pc_;
+  }
+
+  uint16_t GetFalse() const {
+    return false_;
+  }
+
+  uint16_t GetTrue() const {
+    return true_;
+  }
+
+ private:
+  uint32_t dex_pc_;
+  uint16_t false_;
+  uint16_t true_;
+
+  friend class ProfilingInfo;
+
+  DISALLOW_COPY_AND_ASSIGN(BranchCache);
+};
+
 /**
  * Profiling info for a method, created and filled by the interpreter once the
  * method is warm, and used by the compiler to drive optimizations.
@@ -82,6 +116,9 @@ class ProfilingInfo {
 
   InlineCache* GetInlineCache(uint32_t dex_pc);
 
+  // Returns the branch cache of the conditional branch at `dex_pc`, or null if there is none.
+  BranchCache* GetBranchCache(uint32_t dex_pc);
+
   // Increments the number of times this method is currently being inlined.
   // Returns whether it was successful, that is it could increment without
   // overflowing.
@@ -115,7 +152,20 @@ class ProfilingInfo {
   }
 
  private:
-  ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& entries);
+  ProfilingInfo(ArtMethod* method,
+                const std::vector<uint32_t>& inline_cache_entries,
+                const std::vector<uint32_t>& branch_cache_entries);
+
+  static size_t ComputeSize(uint32_t number_of_inline_caches, uint32_t number_of_branch_caches) {
+    return sizeof(ProfilingInfo) +
+        number_of_inline_caches * sizeof(InlineCache) +
+        number_of_branch_caches * sizeof(BranchCache);
+  }
+
+  // The branch caches are stored after the inline caches.
+  BranchCache* GetBranchCaches() {
+    return reinterpret_cast<BranchCache*>(&cache_[number_of_inline_caches_]);
+  }
 
   // Hotness count for methods compiled with the JIT baseline compiler. Once
   // a threshold is hit (currentily the maximum value of uint16_t), we will
@@ -127,14 +177,18 @@ class ProfilingInfo {
   // See JitCodeCache::MoveObsoleteMethod.
   ArtMethod* method_;
 
-  // Number of instructions we are profiling in the ArtMethod.
+  // Number of invoke instructions we are profiling in the ArtMethod.
   const uint32_t number_of_inline_caches_;
 
+  // Number of conditional branches we are profiling in the ArtMethod.
+  const uint32_t number_of_branch_caches_;
+
   // When the compiler inlines the method associated to this ProfilingInfo,
   // it updates this counter so that the GC does not try to clear the inline caches.
   uint16_t current_inline_uses_;
 
-  // Dynamically allocated array of size `number_of_inline_caches_`.
+  // Dynamically allocated array of size `number_of_inline_caches_`, followed by an array of
+  // `number_of_branch_caches_` branch caches.
   InlineCache cache_[0];
 
   friend class jit::JitCodeCache;
@@ -23,6 +23,7 @@
 #include "class_linker.h"
 #include "class_root-inl.h"
 #include "dex/dex_file_annotations.h"
+#include "gc/heap.h"
 #include "jni/jni_internal.h"
 #include "mirror/class-alloc-inl.h"
 #include "mirror/class-inl.h"
@@ -32,6 +33,7 @@
 #include "mirror/object-inl.h"
 #include "native_util.h"
 #include "reflection.h"
+#include "runtime.h"
 #include "scoped_fast_native_object_access-inl.h"
 #include "well_known_classes.h"
 
@@ -99,7 +101,7 @@ static jobject Constructor_newInstance0(JNIEnv* env, jobject javaMethod, jobject
     return nullptr;
   }
   bool movable = true;
-  if (!kMovingClasses && c->IsClassClass()) {
+  if (!Runtime::Current()->GetHeap()->CanMoveClasses() && c->IsClassClass()) {
     movable = false;
   }
 
@@ -205,6 +205,14 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XX:LongGCLogThreshold=_")  // in ms
           .WithType<MillisecondsToNanoseconds>()  // store as ns
           .IntoKey(M::LongGCLogThreshold)
+      .Define("-XX:GcPauseTarget=_")  // in ms
+          .WithType<MillisecondsToNanoseconds>()  // store as ns
+          .WithHelp("Pace the GC to keep pauses under this many milliseconds. Defaults to 0 (off)")
+          .IntoKey(M::GcPauseTarget)
+      .Define("-XX:GcTimeShareTarget=_")
+          .WithType<double>().WithRange(0.01, 0.9)
+          .WithHelp("Maximum share of time spent collecting when pacing the GC")
+          .IntoKey(M::GcTimeShareTarget)
       .Define("-XX:DumpGCPerformanceOnShutdown")
           .IntoKey(M::DumpGCPerformanceOnShutdown)
       .Define("-XX:DumpRegionInfoBeforeGC")
@@ -223,6 +231,18 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XX:UseTLAB")
           .WithValue(true)
           .IntoKey(M::UseTLAB)
+      .Define("-XX:NumaAwareAllocation:_")
+          .WithHelp("Allocate region space regions from the NUMA node of the allocating thread and"
+                    " pin the GC worker threads to NUMA nodes. Defaults to 'false'")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::UseNumaAwareAllocation)
+      .Define("-XX:TransparentHugePages:_")
+          .WithHelp("Back the heap spaces, their bitmaps and their card table with transparent huge"
+                    " pages. Defaults to 'false'")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::UseTransparentHugePages)
       .Define({"-XX:EnableHSpaceCompactForOOM", "-XX:DisableHSpaceCompactForOOM"})
           .WithValues({true, false})
           .IntoKey(M::EnableHSpaceCompactForOOM)
@@ -275,6 +295,9 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xjitzygotepthreadpriority:_")
           .WithType<int>()
           .IntoKey(M::JITZygotePoolThreadPthreadPriority)
+      .Define("-Xjitthreads:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::JITPoolThreads)
       .Define("-Xjitsaveprofilinginfo")
           .WithType<ProfileSaverOptions>()
           .AppendValues()
@@ -312,9 +335,10 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .IntoKey(M::ImageDex2Oat)
       .Define("-XX:LargeObjectSpace=_")
           .WithType<gc::space::LargeObjectSpaceType>()
-          .WithValueMap({{"disabled", gc::space::LargeObjectSpaceType::kDisabled},
-                         {"freelist", gc::space::LargeObjectSpaceType::kFreeList},
-                         {"map",      gc::space::LargeObjectSpaceType::kMap}})
+          .WithValueMap({{"disabled",   gc::space::LargeObjectSpaceType::kDisabled},
+                         {"freelist",   gc::space::LargeObjectSpaceType::kFreeList},
+                         {"segregated", gc::space::LargeObjectSpaceType::kSegregatedFreeList},
+                         {"map",        gc::space::LargeObjectSpaceType::kMap}})
           .IntoKey(M::LargeObjectSpace)
       .Define("-XX:LargeObjectThreshold=_")
           .WithType<Memory<1>>()
@@ -700,8 +724,23 @@ bool ParsedOptions::DoParse(const RuntimeOptions& options,
     }
 
     if (background_collector_type_ == gc::kCollectorTypeNone) {
-      background_collector_type_ = low_memory_mode_ ?
-          gc::kCollectorTypeSS : gc::kCollectorTypeHomogeneousSpaceCompact;
+      if (collector_type_ == gc::kCollectorTypeCMC) {
+        // The mark-compact collector has no separate background variant.
+        background_collector_type_ = gc::kCollectorTypeCMC;
+      } else if (collector_type_ == gc::kCollectorTypeGSS) {
+        // Neither does the generational semi-space collector, the old generation lives in a
+        // non-moving malloc space.
+        background_collector_type_ = gc::kCollectorTypeGSS;
+      } else {
+        background_collector_type_ = low_memory_mode_ ?
+            gc::kCollectorTypeSS : gc::kCollectorTypeHomogeneousSpaceCompact;
+      }
+    } else if (collector_type_ == gc::kCollectorTypeGSS &&
+               background_collector_type_ != gc::kCollectorTypeGSS) {
+      // The generational semi-space heap layout does not support switching to another collector.
+      LOG(WARNING) << "Ignoring -XX:BackgroundGC=" << background_collector_type_
+                   << " with -Xgc:GSS, which is its own background collector";
+      background_collector_type_ = gc::kCollectorTypeGSS;
     }
 
     args.Set(M::BackgroundGc, BackgroundGcOption { background_collector_type_ });
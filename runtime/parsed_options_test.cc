@@ -133,6 +133,63 @@ TEST_F(ParsedOptionsTest, ParsedOptionsGc) {
   EXPECT_EQ(gc::kCollectorTypeSS, xgc.collector_type_);
 }
 
+TEST_F(ParsedOptionsTest, ParsedOptionsGcCMC) {
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xgc:CMC", nullptr));
+
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  ASSERT_NE(0u, map.Size());
+
+  using Opt = RuntimeArgumentMap;
+
+  EXPECT_TRUE(map.Exists(Opt::GcOption));
+
+  XGcOption xgc = map.GetOrDefault(Opt::GcOption);
+  EXPECT_EQ(gc::kCollectorTypeCMC, xgc.collector_type_);
+  // Without an explicit background collector, the background collector is CMC too.
+  EXPECT_EQ(gc::kCollectorTypeCMC,
+            static_cast<gc::CollectorType>(map.GetOrDefault(Opt::BackgroundGc)));
+}
+
+TEST_F(ParsedOptionsTest, ParsedOptionsGcGSS) {
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xgc:GSS", nullptr));
+
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  ASSERT_NE(0u, map.Size());
+
+  using Opt = RuntimeArgumentMap;
+
+  EXPECT_TRUE(map.Exists(Opt::GcOption));
+
+  XGcOption xgc = map.GetOrDefault(Opt::GcOption);
+  EXPECT_EQ(gc::kCollectorTypeGSS, xgc.collector_type_);
+  // Without an explicit background collector, the background collector is GSS too.
+  EXPECT_EQ(gc::kCollectorTypeGSS,
+            static_cast<gc::CollectorType>(map.GetOrDefault(Opt::BackgroundGc)));
+}
+
+TEST_F(ParsedOptionsTest, ParsedOptionsGcGSSIgnoresBackgroundGc) {
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xgc:GSS", nullptr));
+  options.push_back(std::make_pair("-XX:BackgroundGC=CMS", nullptr));
+
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+
+  using Opt = RuntimeArgumentMap;
+
+  // GSS cannot switch to another collector, so it stays the background collector.
+  EXPECT_EQ(gc::kCollectorTypeGSS, map.GetOrDefault(Opt::GcOption).collector_type_);
+  EXPECT_EQ(gc::kCollectorTypeGSS,
+            static_cast<gc::CollectorType>(map.GetOrDefault(Opt::BackgroundGc)));
+}
+
 TEST_F(ParsedOptionsTest, ParsedOptionsGenerationalCC) {
   RuntimeOptions options;
   options.push_back(std::make_pair("-Xgc:generational_cc", nullptr));
@@ -150,6 +207,25 @@ TEST_F(ParsedOptionsTest, ParsedOptionsGenerationalCC) {
   ASSERT_TRUE(xgc.generational_cc);
 }
 
+TEST_F(ParsedOptionsTest, ParsedOptionsJitThreads) {
+  using Opt = RuntimeArgumentMap;
+
+  {
+    RuntimeOptions options;
+    RuntimeArgumentMap map;
+    bool parsed = ParsedOptions::Parse(options, false, &map);
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(jit::kJitPoolDefaultThreadCount, map.GetOrDefault(Opt::JITPoolThreads));
+  }
+
+  RuntimeOptions options;
+  options.push_back(std::make_pair("-Xjitthreads:4", nullptr));
+  RuntimeArgumentMap map;
+  bool parsed = ParsedOptions::Parse(options, false, &map);
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(4u, map.GetOrDefault(Opt::JITPoolThreads));
+}
+
 TEST_F(ParsedOptionsTest, ParsedOptionsInstructionSet) {
   using Opt = RuntimeArgumentMap;
 
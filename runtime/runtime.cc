@@ -1598,7 +1598,11 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
                        use_generational_cc,
                        runtime_options.GetOrDefault(Opt::HSpaceCompactForOOMMinIntervalsMs),
                        runtime_options.Exists(Opt::DumpRegionInfoBeforeGC),
-                       runtime_options.Exists(Opt::DumpRegionInfoAfterGC));
+                       runtime_options.Exists(Opt::DumpRegionInfoAfterGC),
+                       runtime_options.GetOrDefault(Opt::UseNumaAwareAllocation),
+                       runtime_options.GetOrDefault(Opt::UseTransparentHugePages),
+                       runtime_options.GetOrDefault(Opt::GcPauseTarget),
+                       runtime_options.GetOrDefault(Opt::GcTimeShareTarget));
 
   dump_gc_performance_on_shutdown_ = runtime_options.Exists(Opt::DumpGCPerformanceOnShutdown);
 
@@ -676,6 +676,11 @@ class Runtime {
     return is_running_on_memory_tool_;
   }
 
+  // True if the runtime does not use the signal chain, so signal handlers cannot be added.
+  bool NoSigChain() const {
+    return no_sig_chain_;
+  }
+
   void SetTargetSdkVersion(uint32_t version) {
     target_sdk_version_ = version;
   }
@@ -22,6 +22,9 @@
 #include <sys/time.h>
 
 #include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
 
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
@@ -46,10 +49,97 @@ static constexpr bool kUseCustomThreadPoolStack = false;
 static constexpr bool kUseCustomThreadPoolStack = true;
 #endif
 
-ThreadPoolWorker::ThreadPoolWorker(ThreadPool* thread_pool, const std::string& name,
-                                   size_t stack_size)
+// Most tasks a worker takes from the shared queue at once.
+static constexpr size_t kMaxTaskBatchSize = 32;
+
+// Fixed-capacity Chase-Lev deque ("Correct and Efficient Work-Stealing for Weak Memory Models",
+// Le et al., PPoPP 2013). The owning worker pushes and pops at the bottom, other threads steal
+// from the top.
+class WorkStealingDeque {
+ public:
+  static constexpr size_t kCapacity = 1024;
+
+  WorkStealingDeque() : top_(0), bottom_(0) {}
+
+  // Owner only. Returns false if the deque is full.
+  bool Push(Task* task) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top >= static_cast<int64_t>(kCapacity)) {
+      return false;
+    }
+    tasks_[bottom % kCapacity].store(task, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Owner only.
+  Task* Pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    Task* task = tasks_[bottom % kCapacity].load(std::memory_order_relaxed);
+    if (top == bottom) {
+      // Last task, race with the thieves for it.
+      if (!top_.compare_exchange_strong(top,
+                                        top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        task = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return task;
+  }
+
+  // Any thread. Returns null if the deque is empty or another thread took the top task first.
+  Task* Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    Task* task = tasks_[top % kCapacity].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top,
+                                      top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return task;
+  }
+
+  size_t Size() const {
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    int64_t top = top_.load(std::memory_order_acquire);
+    return static_cast<size_t>(std::max<int64_t>(bottom - top, 0));
+  }
+
+ private:
+  // Keep the thieves' index and the owner's index on different cache lines.
+  alignas(64) Atomic<int64_t> top_;
+  alignas(64) Atomic<int64_t> bottom_;
+  Atomic<Task*> tasks_[kCapacity];
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+thread_local ThreadPoolWorker* ThreadPoolWorker::current_worker_ = nullptr;
+
+ThreadPoolWorker::ThreadPoolWorker(ThreadPool* thread_pool,
+                                   const std::string& name,
+                                   size_t stack_size,
+                                   size_t index)
     : thread_pool_(thread_pool),
-      name_(name) {
+      name_(name),
+      index_(index) {
   std::string error_msg;
   // On Bionic, we know pthreads will give us a big-enough stack with
   // a guard page, so don't do anything special on Bionic libc.
@@ -106,9 +196,29 @@ int ThreadPoolWorker::GetPthreadPriority() {
 #endif
 }
 
+void ThreadPoolWorker::SetCpuAffinity(const std::vector<int>& cpus) {
+  DCHECK(thread_ != nullptr);
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  if (CPU_COUNT(&cpu_set) != 0 &&
+      sched_setaffinity(thread_->GetTid(), sizeof(cpu_set), &cpu_set) != 0) {
+    PLOG(WARNING) << "Failed to set the CPU affinity of " << name_;
+  }
+#else
+  UNUSED(cpus);
+#endif
+}
+
 void ThreadPoolWorker::Run() {
   Thread* self = Thread::Current();
   Task* task = nullptr;
+  current_worker_ = this;
   thread_pool_->creation_barier_.Pass(self);
   while ((task = thread_pool_->GetTask(self)) != nullptr) {
     task->Run(self);
@@ -140,6 +250,14 @@ void* ThreadPoolWorker::Callback(void* arg) {
 }
 
 void ThreadPool::AddTask(Thread* self, Task* task) {
+  if (IsWorkStealing()) {
+    // Tasks spawned by a task of this pool go to the deque of the worker running it.
+    ThreadPoolWorker* worker = ThreadPoolWorker::current_worker_;
+    if (worker != nullptr && worker->thread_pool_ == this && deques_[worker->index_]->Push(task)) {
+      WakeIdleWorker(self);
+      return;
+    }
+  }
   MutexLock mu(self, task_queue_lock_);
   tasks_.push_back(task);
   // If we have any waiters, signal one.
@@ -148,6 +266,28 @@ void ThreadPool::AddTask(Thread* self, Task* task) {
   }
 }
 
+void ThreadPool::AddTasks(Thread* self, const std::vector<Task*>& tasks) {
+  MutexLock mu(self, task_queue_lock_);
+  tasks_.insert(tasks_.end(), tasks.begin(), tasks.end());
+  if (started_ && waiting_count_ != 0) {
+    if (tasks.size() == 1u) {
+      task_queue_condition_.Signal(self);
+    } else if (!tasks.empty()) {
+      task_queue_condition_.Broadcast(self);
+    }
+  }
+}
+
+void ThreadPool::WakeIdleWorker(Thread* self) {
+  // Pairs with the fence in GetTaskWorkStealing(): either the idle worker sees the new task
+  // before going to sleep, or we see the idle worker and signal it.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idle_count_.load(std::memory_order_relaxed) != 0) {
+    MutexLock mu(self, task_queue_lock_);
+    task_queue_condition_.Signal(self);
+  }
+}
+
 void ThreadPool::RemoveAllTasks(Thread* self) {
   // The ThreadPool is responsible for calling Finalize (which usually delete
   // the task memory) on all the tasks.
@@ -157,12 +297,22 @@ void ThreadPool::RemoveAllTasks(Thread* self) {
   }
   MutexLock mu(self, task_queue_lock_);
   tasks_.clear();
+  for (std::unique_ptr<WorkStealingDeque>& deque : deques_) {
+    while (deque->Size() != 0u) {
+      task = deque->Steal();
+      if (task != nullptr) {
+        task->Finalize();
+      }
+    }
+  }
 }
 
 ThreadPool::ThreadPool(const char* name,
                        size_t num_threads,
                        bool create_peers,
-                       size_t worker_stack_size)
+                       size_t worker_stack_size,
+                       bool work_stealing,
+                       bool create_threads)
   : name_(name),
     task_queue_lock_("task queue lock", kGenericBottomLock),
     task_queue_condition_("task queue condition", task_queue_lock_),
@@ -175,8 +325,17 @@ ThreadPool::ThreadPool(const char* name,
     creation_barier_(0),
     max_active_workers_(num_threads),
     create_peers_(create_peers),
-    worker_stack_size_(worker_stack_size) {
-  CreateThreads();
+    worker_stack_size_(worker_stack_size),
+    idle_count_(0u),
+    workers_started_(false) {
+  if (work_stealing) {
+    for (size_t i = 0; i != num_threads; ++i) {
+      deques_.emplace_back(new WorkStealingDeque());
+    }
+  }
+  if (create_threads) {
+    CreateThreads();
+  }
 }
 
 void ThreadPool::CreateThreads() {
@@ -191,7 +350,7 @@ void ThreadPool::CreateThreads() {
       const std::string worker_name = StringPrintf("%s worker thread %zu", name_.c_str(),
                                                    GetThreadCount());
       threads_.push_back(
-          new ThreadPoolWorker(this, worker_name, worker_stack_size_));
+          new ThreadPoolWorker(this, worker_name, worker_stack_size_, GetThreadCount()));
     }
   }
 }
@@ -236,6 +395,7 @@ ThreadPool::~ThreadPool() {
 void ThreadPool::StartWorkers(Thread* self) {
   MutexLock mu(self, task_queue_lock_);
   started_ = true;
+  workers_started_.store(true, std::memory_order_seq_cst);
   task_queue_condition_.Broadcast(self);
   start_time_ = NanoTime();
   total_wait_time_ = 0;
@@ -244,9 +404,26 @@ void ThreadPool::StartWorkers(Thread* self) {
 void ThreadPool::StopWorkers(Thread* self) {
   MutexLock mu(self, task_queue_lock_);
   started_ = false;
+  workers_started_.store(false, std::memory_order_seq_cst);
+  // Workers do not pop their deques while stopped, so move the tasks they batched or spawned back
+  // to the front of the shared queue, oldest first, to keep them stealable after a restart.
+  std::vector<Task*> deque_tasks;
+  for (std::unique_ptr<WorkStealingDeque>& deque : deques_) {
+    while (deque->Size() != 0u) {
+      Task* task = deque->Steal();
+      if (task != nullptr) {
+        deque_tasks.push_back(task);
+      }
+    }
+  }
+  tasks_.insert(tasks_.begin(), deque_tasks.begin(), deque_tasks.end());
 }
 
 Task* ThreadPool::GetTask(Thread* self) {
+  if (IsWorkStealing()) {
+    DCHECK(ThreadPoolWorker::current_worker_ != nullptr);
+    return GetTaskWorkStealing(self, ThreadPoolWorker::current_worker_->index_);
+  }
   MutexLock mu(self, task_queue_lock_);
   while (!IsShuttingDown()) {
     const size_t thread_count = GetThreadCount();
@@ -278,13 +455,120 @@ Task* ThreadPool::GetTask(Thread* self) {
   return nullptr;
 }
 
+Task* ThreadPool::GetTaskWorkStealing(Thread* self, size_t index) {
+  WorkStealingDeque* deque = deques_[index].get();
+  while (true) {
+    // Our deque holds tasks spawned by our tasks and tasks batched from the shared queue. Neither
+    // may run while the workers are stopped; StopWorkers() moves them back to the shared queue.
+    Task* task = workers_started_.load(std::memory_order_seq_cst) ? deque->Pop() : nullptr;
+    if (task != nullptr) {
+      return task;
+    }
+    bool may_run;
+    {
+      MutexLock mu(self, task_queue_lock_);
+      if (IsShuttingDown()) {
+        return nullptr;
+      }
+      // <= since self is considered an active worker.
+      may_run = started_ && (GetThreadCount() - waiting_count_ <= max_active_workers_);
+      if (may_run && !tasks_.empty()) {
+        return TakeBatchLocked(self, index);
+      }
+    }
+    if (may_run) {
+      task = StealTask(index);
+      if (task != nullptr) {
+        return task;
+      }
+    }
+
+    MutexLock mu(self, task_queue_lock_);
+    if (IsShuttingDown()) {
+      return nullptr;
+    }
+    const bool over_limit = GetThreadCount() - waiting_count_ > max_active_workers_;
+    ++waiting_count_;
+    idle_count_.fetch_add(1u, std::memory_order_relaxed);
+    // Pairs with the fence in WakeIdleWorker().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool has_outstanding_tasks = HasOutstandingTasks();
+    if (over_limit || !has_outstanding_tasks) {
+      if (waiting_count_ == GetThreadCount() && !has_outstanding_tasks) {
+        // We may be done, lets broadcast to the completion condition.
+        completion_condition_.Broadcast(self);
+      }
+      const uint64_t wait_start = kMeasureWaitTime ? NanoTime() : 0;
+      task_queue_condition_.Wait(self);
+      if (kMeasureWaitTime) {
+        const uint64_t wait_end = NanoTime();
+        total_wait_time_ += wait_end - std::max(wait_start, start_time_);
+      }
+    }
+    idle_count_.fetch_sub(1u, std::memory_order_relaxed);
+    --waiting_count_;
+  }
+}
+
+Task* ThreadPool::TakeBatchLocked(Thread* self, size_t index) {
+  DCHECK(!tasks_.empty());
+  // Take an even share of the queue so that the other workers find tasks to steal or take too.
+  size_t batch_size =
+      std::clamp<size_t>(tasks_.size() / GetThreadCount(), 1u, kMaxTaskBatchSize);
+  Task* task = tasks_.front();
+  tasks_.pop_front();
+  for (size_t i = 1; i != batch_size; ++i) {
+    // The deque was empty, so there is room for the whole batch.
+    bool pushed = deques_[index]->Push(tasks_.front());
+    DCHECK(pushed);
+    tasks_.pop_front();
+  }
+  if (batch_size > 1u && waiting_count_ != 0) {
+    task_queue_condition_.Signal(self);
+  }
+  return task;
+}
+
+Task* ThreadPool::StealTask(size_t thief) {
+  const size_t deque_count = deques_.size();
+  for (size_t i = 1; i <= deque_count; ++i) {
+    size_t victim = (thief + i) % deque_count;
+    if (victim == thief) {
+      continue;
+    }
+    Task* task = deques_[victim]->Steal();
+    if (task != nullptr) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+bool ThreadPool::HasDequeTasks() const {
+  for (const std::unique_ptr<WorkStealingDeque>& deque : deques_) {
+    if (deque->Size() != 0u) {
+      return true;
+    }
+  }
+  return false;
+}
+
 Task* ThreadPool::TryGetTask(Thread* self) {
-  MutexLock mu(self, task_queue_lock_);
-  return TryGetTaskLocked();
+  bool may_steal;
+  {
+    MutexLock mu(self, task_queue_lock_);
+    Task* task = TryGetTaskLocked();
+    if (task != nullptr) {
+      return task;
+    }
+    may_steal = started_ && IsWorkStealing();
+  }
+  // Threads outside the pool can steal too, see Wait().
+  return may_steal ? StealTask(deques_.size()) : nullptr;
 }
 
 Task* ThreadPool::TryGetTaskLocked() {
-  if (HasOutstandingTasks()) {
+  if (started_ && !tasks_.empty()) {
     Task* task = tasks_.front();
     tasks_.pop_front();
     return task;
@@ -314,7 +598,11 @@ void ThreadPool::Wait(Thread* self, bool do_work, bool may_hold_locks) {
 
 size_t ThreadPool::GetTaskCount(Thread* self) {
   MutexLock mu(self, task_queue_lock_);
-  return tasks_.size();
+  size_t count = tasks_.size();
+  for (const std::unique_ptr<WorkStealingDeque>& deque : deques_) {
+    count += deque->Size();
+  }
+  return count;
 }
 
 void ThreadPool::SetPthreadPriority(int priority) {
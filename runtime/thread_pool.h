@@ -19,15 +19,18 @@
 
 #include <deque>
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "barrier.h"
+#include "base/atomic.h"
 #include "base/mem_map.h"
 #include "base/mutex.h"
 
 namespace art {
 
 class ThreadPool;
+class WorkStealingDeque;
 
 class Closure {
  public:
@@ -89,25 +92,42 @@ class ThreadPoolWorker {
   // Get the "nice" priority for this worker.
   int GetPthreadPriority();
 
+  // Restrict this worker to run on the given CPUs. Must be called after the worker started.
+  void SetCpuAffinity(const std::vector<int>& cpus);
+
   Thread* GetThread() const { return thread_; }
 
  protected:
-  ThreadPoolWorker(ThreadPool* thread_pool, const std::string& name, size_t stack_size);
+  ThreadPoolWorker(ThreadPool* thread_pool,
+                   const std::string& name,
+                   size_t stack_size,
+                   size_t index);
   static void* Callback(void* arg) REQUIRES(!Locks::mutator_lock_);
   virtual void Run();
 
   ThreadPool* const thread_pool_;
   const std::string name_;
+  // Index of this worker in its pool, and of its deque when the pool steals work.
+  const size_t index_;
   MemMap stack_;
   pthread_t pthread_;
   Thread* thread_;
 
  private:
+  // The worker running on the current thread, if any.
+  static thread_local ThreadPoolWorker* current_worker_;
+
   friend class ThreadPool;
   DISALLOW_COPY_AND_ASSIGN(ThreadPoolWorker);
 };
 
 // Note that thread pool workers will set Thread#setCanCallIntoJava to false.
+//
+// By default all tasks go through a single queue guarded by `task_queue_lock_`. A pool created
+// with `work_stealing` gives each worker its own lock-free deque instead: tasks added by a worker
+// go to its deque, workers run the tasks of their own deque first, then take a batch of tasks from
+// the shared queue, then steal from the other workers, and only take `task_queue_lock_` when
+// they run out of work. Tasks added from outside the pool still go to the shared queue.
 class ThreadPool {
  public:
   // Returns the number of threads in the thread pool.
@@ -127,18 +147,29 @@ class ThreadPool {
   // after running it, it is the caller's responsibility.
   void AddTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_);
 
+  // Add several tasks at once, taking `task_queue_lock_` only once.
+  void AddTasks(Thread* self, const std::vector<Task*>& tasks) REQUIRES(!task_queue_lock_);
+
   // Remove all tasks in the queue.
-  void RemoveAllTasks(Thread* self) REQUIRES(!task_queue_lock_);
+  virtual void RemoveAllTasks(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Create a named thread pool with the given number of threads.
   //
   // If create_peers is true, all worker threads will have a Java peer object. Note that if the
   // pool is asked to do work on the current thread (see Wait), a peer may not be available. Wait
   // will conservatively abort if create_peers and do_work are true.
+  //
+  // If work_stealing is true, the pool uses per-worker deques (see above).
+  //
+  // If create_threads is false, the caller must call CreateThreads() once the pool is fully
+  // constructed. Subclasses overriding the task accessors used by the workers must do so, as the
+  // workers may call them before the subclass constructor has run.
   ThreadPool(const char* name,
              size_t num_threads,
              bool create_peers = false,
-             size_t worker_stack_size = ThreadPoolWorker::kDefaultStackSize);
+             size_t worker_stack_size = ThreadPoolWorker::kDefaultStackSize,
+             bool work_stealing = false,
+             bool create_threads = true);
   virtual ~ThreadPool();
 
   // Create the threads of this pool.
@@ -152,7 +183,7 @@ class ThreadPool {
   // When the pool was created with peers for workers, do_work must not be true (see ThreadPool()).
   void Wait(Thread* self, bool do_work, bool may_hold_locks) REQUIRES(!task_queue_lock_);
 
-  size_t GetTaskCount(Thread* self) REQUIRES(!task_queue_lock_);
+  virtual size_t GetTaskCount(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Returns the total amount of workers waited for tasks.
   uint64_t GetWaitTime() const {
@@ -173,21 +204,40 @@ class ThreadPool {
   // Wait for workers to be created.
   void WaitForWorkersToBeCreated();
 
+  bool IsWorkStealing() const {
+    return !deques_.empty();
+  }
+
  protected:
   // get a task to run, blocks if there are no tasks left
   virtual Task* GetTask(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Try to get a task, returning null if there is none available.
   Task* TryGetTask(Thread* self) REQUIRES(!task_queue_lock_);
-  Task* TryGetTaskLocked() REQUIRES(task_queue_lock_);
+  virtual Task* TryGetTaskLocked() REQUIRES(task_queue_lock_);
+
+  // Work-stealing counterpart of GetTask() for the worker with the given index.
+  Task* GetTaskWorkStealing(Thread* self, size_t index) REQUIRES(!task_queue_lock_);
+
+  // Move a share of the shared queue to the deque of worker `index`, returning one of the tasks.
+  Task* TakeBatchLocked(Thread* self, size_t index) REQUIRES(task_queue_lock_);
+
+  // Steal a task from the deque of any worker but `thief`.
+  Task* StealTask(size_t thief);
+
+  // Whether any worker deque holds tasks.
+  bool HasDequeTasks() const;
+
+  // Wake up an idle worker after pushing a task to a deque.
+  void WakeIdleWorker(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Are we shutting down?
   bool IsShuttingDown() const REQUIRES(task_queue_lock_) {
     return shutting_down_;
   }
 
-  bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) {
-    return started_ && !tasks_.empty();
+  virtual bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) {
+    return started_ && (!tasks_.empty() || HasDequeTasks());
   }
 
   const std::string name_;
@@ -207,6 +257,13 @@ class ThreadPool {
   size_t max_active_workers_ GUARDED_BY(task_queue_lock_);
   const bool create_peers_;
   const size_t worker_stack_size_;
+  // One deque per worker, empty unless the pool steals work.
+  std::vector<std::unique_ptr<WorkStealingDeque>> deques_;
+  // How many workers are about to wait on `task_queue_condition_`. Unlike `waiting_count_`, this
+  // is read without `task_queue_lock_` when pushing to a deque.
+  Atomic<size_t> idle_count_;
+  // Mirrors `started_` for workers popping their own deque without `task_queue_lock_`.
+  Atomic<bool> workers_started_;
 
  private:
   friend class ThreadPoolWorker;
@@ -17,8 +17,10 @@
 #include "thread_pool.h"
 
 #include <string>
+#include <vector>
 
 #include "base/atomic.h"
+#include "base/time_utils.h"
 #include "common_runtime_test.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread-inl.h"
@@ -188,6 +190,177 @@ class NoPeerTask : public Task {
   }
 };
 
+// Check that a work-stealing pool runs both tasks added from outside and tasks spawned by tasks.
+TEST_F(ThreadPoolTest, WorkStealingCheckRun) {
+  Thread* self = Thread::Current();
+  ThreadPool thread_pool("Thread pool test thread pool",
+                         num_threads,
+                         /*create_peers=*/ false,
+                         ThreadPoolWorker::kDefaultStackSize,
+                         /*work_stealing=*/ true);
+  ASSERT_TRUE(thread_pool.IsWorkStealing());
+  AtomicInteger count(0);
+  static const int32_t num_tasks = num_threads * 4;
+  std::vector<Task*> tasks;
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    tasks.push_back(new CountTask(&count));
+  }
+  thread_pool.AddTasks(self, tasks);
+  EXPECT_EQ(static_cast<size_t>(num_tasks), thread_pool.GetTaskCount(self));
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, true, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+
+  static const int depth = 12;
+  count.store(0, std::memory_order_seq_cst);
+  thread_pool.AddTask(self, new TreeTask(&thread_pool, &count, depth));
+  thread_pool.Wait(self, false, false);
+  EXPECT_EQ((1 << depth) - 1, count.load(std::memory_order_seq_cst));
+  EXPECT_EQ(0u, thread_pool.GetTaskCount(self));
+}
+
+TEST_F(ThreadPoolTest, WorkStealingStopStart) {
+  Thread* self = Thread::Current();
+  ThreadPool thread_pool("Thread pool test thread pool",
+                         num_threads,
+                         /*create_peers=*/ false,
+                         ThreadPoolWorker::kDefaultStackSize,
+                         /*work_stealing=*/ true);
+  AtomicInteger count(0);
+  static const int32_t num_tasks = num_threads * 4;
+  for (int32_t i = 0; i < num_tasks; ++i) {
+    thread_pool.AddTask(self, new CountTask(&count));
+  }
+  usleep(200);
+  // Check that no threads started prematurely.
+  EXPECT_EQ(0, count.load(std::memory_order_seq_cst));
+  thread_pool.StartWorkers(self);
+  usleep(200);
+  thread_pool.StopWorkers(self);
+  AtomicInteger bad_count(0);
+  thread_pool.AddTask(self, new CountTask(&bad_count));
+  usleep(200);
+  // Ensure that the task added after the workers were stopped doesn't get run.
+  EXPECT_EQ(0, bad_count.load(std::memory_order_seq_cst));
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, false, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+  EXPECT_EQ(1, bad_count.load(std::memory_order_seq_cst));
+}
+
+class BlockingTask : public Task {
+ public:
+  BlockingTask(AtomicInteger* count, Atomic<bool>* running, Atomic<bool>* release)
+      : count_(count), running_(running), release_(release) {}
+
+  void Run(Thread* self ATTRIBUTE_UNUSED) override {
+    running_->store(true, std::memory_order_seq_cst);
+    while (!release_->load(std::memory_order_seq_cst)) {
+      usleep(100);
+    }
+    ++*count_;
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  AtomicInteger* const count_;
+  Atomic<bool>* const running_;
+  Atomic<bool>* const release_;
+};
+
+// Check that tasks a worker batched from the shared queue into its deque do not run once the
+// workers have been stopped.
+TEST_F(ThreadPoolTest, WorkStealingStopBatchedTasks) {
+  Thread* self = Thread::Current();
+  ThreadPool thread_pool("Thread pool test thread pool",
+                         /*num_threads=*/ 1,
+                         /*create_peers=*/ false,
+                         ThreadPoolWorker::kDefaultStackSize,
+                         /*work_stealing=*/ true);
+  AtomicInteger count(0);
+  Atomic<bool> running(false);
+  Atomic<bool> release(false);
+  static const int32_t num_tasks = 8;
+  std::vector<Task*> tasks;
+  tasks.push_back(new BlockingTask(&count, &running, &release));
+  for (int32_t i = 1; i < num_tasks; ++i) {
+    tasks.push_back(new CountTask(&count));
+  }
+  thread_pool.AddTasks(self, tasks);
+  thread_pool.StartWorkers(self);
+  // The only worker takes the whole queue as one batch and runs the blocking task first.
+  while (!running.load(std::memory_order_seq_cst)) {
+    usleep(100);
+  }
+  thread_pool.StopWorkers(self);
+  release.store(true, std::memory_order_seq_cst);
+  thread_pool.Wait(self, false, false);
+  EXPECT_EQ(1, count.load(std::memory_order_seq_cst));
+  EXPECT_EQ(static_cast<size_t>(num_tasks - 1), thread_pool.GetTaskCount(self));
+  // The batched tasks run once the workers are started again.
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, false, false);
+  EXPECT_EQ(num_tasks, count.load(std::memory_order_seq_cst));
+}
+
+class SpinTask : public Task {
+ public:
+  SpinTask(AtomicInteger* count, size_t iterations) : count_(count), iterations_(iterations) {}
+
+  void Run(Thread* self ATTRIBUTE_UNUSED) override {
+    // Stand-in for compiling a small method.
+    volatile size_t sink = 0;
+    for (size_t i = 0; i != iterations_; ++i) {
+      sink = sink + i;
+    }
+    ++*count_;
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  AtomicInteger* const count_;
+  const size_t iterations_;
+};
+
+// Run many small tasks, the way dex2oat compiles many small methods, on pools of 1 to 64 workers
+// with and without work stealing, and report the throughput of each.
+TEST_F(ThreadPoolTest, ThroughputBenchmark) {
+  Thread* self = Thread::Current();
+  static constexpr int32_t kNumTasks = 20000;
+  static constexpr size_t kTaskIterations = 200;
+  for (size_t workers : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+    for (bool work_stealing : {false, true}) {
+      ThreadPool thread_pool("Thread pool test thread pool",
+                             workers,
+                             /*create_peers=*/ false,
+                             ThreadPoolWorker::kDefaultStackSize,
+                             work_stealing);
+      thread_pool.WaitForWorkersToBeCreated();
+      AtomicInteger count(0);
+      std::vector<Task*> tasks;
+      tasks.reserve(kNumTasks);
+      for (int32_t i = 0; i < kNumTasks; ++i) {
+        tasks.push_back(new SpinTask(&count, kTaskIterations));
+      }
+      const uint64_t start = NanoTime();
+      thread_pool.AddTasks(self, tasks);
+      thread_pool.StartWorkers(self);
+      thread_pool.Wait(self, /*do_work=*/ false, false);
+      const uint64_t duration = std::max<uint64_t>(NanoTime() - start, 1u);
+      EXPECT_EQ(kNumTasks, count.load(std::memory_order_seq_cst));
+      LOG(INFO) << workers << " workers, " << (work_stealing ? "work stealing" : "shared queue")
+                << ": " << (kNumTasks * UINT64_C(1000000000) / duration)
+                << " tasks/s";
+    }
+  }
+}
+
 // Tests for create_peer functionality.
 TEST_F(ThreadPoolTest, PeerTest) {
   Thread* self = Thread::Current();
@@ -17,6 +17,7 @@
 #include "code_simulator.h"
 
 #include "code_simulator_arm64.h"
+#include "code_simulator_loongarch64.h"
 
 namespace art {
 
@@ -24,6 +25,8 @@ CodeSimulator* CodeSimulator::CreateCodeSimulator(InstructionSet target_isa) {
   switch (target_isa) {
     case InstructionSet::kArm64:
       return arm64::CodeSimulatorArm64::CreateCodeSimulatorArm64();
+    case InstructionSet::kLoongarch64:
+      return loongarch64::CodeSimulatorLoongarch64::CreateCodeSimulatorLoongarch64();
     default:
       return nullptr;
   }
@@ -0,0 +1,1105 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_simulator_loongarch64.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include <android-base/logging.h>
+#include <android-base/stringprintf.h>
+
+#include "base/bit_utils.h"
+#include "base/casts.h"
+#include "base/globals.h"
+#include "entrypoints/quick/quick_entrypoints.h"
+#include "thread.h"
+
+namespace art {
+namespace loongarch64 {
+
+using android::base::StringPrintf;
+
+static constexpr size_t kStackSize = 256 * KB;
+static constexpr size_t kNumberOfQuickEntrypoints = sizeof(QuickEntryPoints) / sizeof(void*);
+static constexpr size_t kNumberOfFccRegisters = 8u;
+
+// Instruction fields, see the LoongArch reference manual.
+static inline uint32_t Rd(uint32_t insn) { return insn & 0x1fu; }
+static inline uint32_t Rj(uint32_t insn) { return (insn >> 5) & 0x1fu; }
+static inline uint32_t Rk(uint32_t insn) { return (insn >> 10) & 0x1fu; }
+static inline uint32_t Ra(uint32_t insn) { return (insn >> 15) & 0x1fu; }
+
+static inline int64_t SignedField(uint32_t insn, size_t lsb, size_t width) {
+  return BitFieldExtract(static_cast<int32_t>(insn), lsb, width);
+}
+
+static inline uint64_t UnsignedField(uint32_t insn, size_t lsb, size_t width) {
+  return BitFieldExtract(insn, lsb, width);
+}
+
+static inline int64_t SignExtend32(uint64_t value) {
+  return static_cast<int32_t>(static_cast<uint32_t>(value));
+}
+
+template <typename T>
+static inline T Load(uint64_t address) {
+  T value;
+  memcpy(&value, reinterpret_cast<const void*>(static_cast<uintptr_t>(address)), sizeof(T));
+  return value;
+}
+
+template <typename T>
+static inline void Store(uint64_t address, T value) {
+  memcpy(reinterpret_cast<void*>(static_cast<uintptr_t>(address)), &value, sizeof(T));
+}
+
+template <typename T>
+static inline T CountLeadingZeros(T value) {
+  return (value == 0u) ? BitSizeOf<T>() : CLZ(value);
+}
+
+template <typename T>
+static inline T CountTrailingZeros(T value) {
+  return (value == 0u) ? BitSizeOf<T>() : CTZ(value);
+}
+
+// Reverses the bytes within each `Unit` of `value`.
+template <typename Unit>
+static inline uint64_t ReverseBytesIn(uint64_t value) {
+  uint64_t result = 0u;
+  for (size_t i = 0; i != sizeof(uint64_t) / sizeof(Unit); ++i) {
+    size_t shift = i * BitSizeOf<Unit>();
+    Unit unit = static_cast<Unit>(value >> shift);
+    Unit reversed = 0u;
+    for (size_t j = 0; j != sizeof(Unit); ++j) {
+      uint8_t byte = static_cast<uint8_t>(unit >> (j * kBitsPerByte));
+      reversed = static_cast<Unit>((reversed << kBitsPerByte) | byte);
+    }
+    result |= static_cast<uint64_t>(reversed) << shift;
+  }
+  return result;
+}
+
+// Reverses the bits within each byte of `value`.
+static inline uint64_t ReverseBitsInBytes(uint64_t value) {
+  return ReverseBytesIn<uint64_t>(ReverseBits64(value));
+}
+
+static inline uint64_t SwapHalfwordsInWords(uint64_t value) {
+  return ((value & UINT64_C(0x0000ffff0000ffff)) << 16) |
+         ((value >> 16) & UINT64_C(0x0000ffff0000ffff));
+}
+
+template <typename T>
+static T Divide(T dividend, T divisor) {
+  // The result is unspecified by the ISA; the generated code checks these cases explicitly.
+  if (divisor == 0) {
+    return 0;
+  }
+  if (std::is_signed<T>::value && divisor == static_cast<T>(-1)) {
+    return static_cast<T>(-static_cast<std::make_unsigned_t<T>>(dividend));
+  }
+  return dividend / divisor;
+}
+
+template <typename T>
+static T Remainder(T dividend, T divisor) {
+  if (divisor == 0) {
+    return dividend;
+  }
+  if (std::is_signed<T>::value && divisor == static_cast<T>(-1)) {
+    return 0;
+  }
+  return dividend % divisor;
+}
+
+// FTINTRZ: round towards zero, converting NaN to 0 and saturating out-of-range values.
+template <typename I, typename F>
+static I TruncateToInteger(F value) {
+  if (std::isnan(value)) {
+    return 0;
+  } else if (value >= static_cast<F>(std::numeric_limits<I>::max())) {
+    return std::numeric_limits<I>::max();
+  } else if (value <= static_cast<F>(std::numeric_limits<I>::min())) {
+    return std::numeric_limits<I>::min();
+  } else {
+    return static_cast<I>(value);
+  }
+}
+
+// FCLASS result bits.
+template <typename F>
+static uint64_t ClassifyFloat(F value, bool is_signaling_nan) {
+  if (std::isnan(value)) {
+    return is_signaling_nan ? 1u << 0 : 1u << 1;
+  }
+  uint32_t sign_shift = std::signbit(value) ? 0u : 4u;
+  switch (std::fpclassify(value)) {
+    case FP_INFINITE:
+      return 1u << (2 + sign_shift);
+    case FP_NORMAL:
+      return 1u << (3 + sign_shift);
+    case FP_SUBNORMAL:
+      return 1u << (4 + sign_shift);
+    default:
+      DCHECK_EQ(std::fpclassify(value), FP_ZERO);
+      return 1u << (5 + sign_shift);
+  }
+}
+
+// FCMP.cond: bit 0 of `cond` only selects signaling behavior, the other bits select
+// the relations (less, equal, unordered, not equal) for which the result is true.
+template <typename F>
+static bool CompareFloats(uint32_t cond, F lhs, F rhs) {
+  bool unordered = std::isnan(lhs) || std::isnan(rhs);
+  bool less = !unordered && lhs < rhs;
+  bool equal = !unordered && lhs == rhs;
+  bool greater = !unordered && lhs > rhs;
+  uint32_t relations = cond >> 1;
+  return ((relations & 1u) != 0u && less) ||
+         ((relations & 2u) != 0u && equal) ||
+         ((relations & 4u) != 0u && unordered) ||
+         ((relations & 8u) != 0u && (less || greater));
+}
+
+CodeSimulatorLoongarch64* CodeSimulatorLoongarch64::CreateCodeSimulatorLoongarch64() {
+  if (kCanSimulate) {
+    return new CodeSimulatorLoongarch64();
+  } else {
+    return nullptr;
+  }
+}
+
+CodeSimulatorLoongarch64::CodeSimulatorLoongarch64()
+    : CodeSimulator(),
+      pc_(0u),
+      next_pc_(0u),
+      instruction_count_(0u),
+      stack_(kStackSize / sizeof(uint64_t), 0u),
+      thread_(RoundUp(sizeof(Thread), sizeof(uint64_t)) / sizeof(uint64_t), 0u),
+      trap_slots_(kNumberOfQuickEntrypoints + 1u, 0u),
+      hooks_(kNumberOfQuickEntrypoints) {
+  DCHECK(kCanSimulate);
+  // Point all quick entrypoints of the fake Thread at their trap slots.
+  uint8_t* thread = reinterpret_cast<uint8_t*>(thread_.data());
+  for (size_t i = 0; i != kNumberOfQuickEntrypoints; ++i) {
+    QuickEntrypointEnum entrypoint = static_cast<QuickEntrypointEnum>(i);
+    uint64_t address = GetTrapAddress(i);
+    memcpy(thread + GetThreadOffset<PointerSize::k64>(entrypoint).SizeValue(),
+           &address,
+           sizeof(address));
+  }
+}
+
+CodeSimulatorLoongarch64::~CodeSimulatorLoongarch64() {
+  DCHECK(kCanSimulate);
+}
+
+void CodeSimulatorLoongarch64::SetEntrypointHook(QuickEntrypointEnum entrypoint,
+                                                 EntrypointHook hook) {
+  size_t index = static_cast<size_t>(entrypoint);
+  DCHECK_LT(index, kNumberOfQuickEntrypoints);
+  hooks_[index] = std::move(hook);
+}
+
+void CodeSimulatorLoongarch64::RunFrom(intptr_t code_buffer) {
+  DCHECK(kCanSimulate);
+  std::fill_n(xregs_, kNumberOfXRegisters, 0);
+  std::fill_n(fregs_, kNumberOfFRegisters, 0u);
+  std::fill_n(fcc_, kNumberOfFccRegisters, false);
+  uintptr_t stack_end = reinterpret_cast<uintptr_t>(stack_.data() + stack_.size());
+  xregs_[SP] = static_cast<int64_t>(RoundDown(stack_end, kStackAlignment));
+  xregs_[TR] = reinterpret_cast<int64_t>(thread_.data());
+  const uintptr_t return_address = GetTrapAddress(kNumberOfQuickEntrypoints);
+  xregs_[RA] = static_cast<int64_t>(return_address);
+
+  const uintptr_t traps_begin = GetTrapAddress(0u);
+  instruction_count_ = 0u;
+  pc_ = static_cast<uintptr_t>(code_buffer);
+  while (pc_ != return_address) {
+    if (pc_ >= traps_begin && pc_ < return_address) {
+      CallEntrypointHook((pc_ - traps_begin) / sizeof(uint32_t));
+      continue;
+    }
+    uint32_t insn;
+    memcpy(&insn, reinterpret_cast<const void*>(pc_), sizeof(insn));
+    next_pc_ = pc_ + sizeof(insn);
+    ExecuteInstruction(insn);
+    ++instruction_count_;
+    pc_ = next_pc_;
+  }
+}
+
+bool CodeSimulatorLoongarch64::GetCReturnBool() const {
+  DCHECK(kCanSimulate);
+  return static_cast<bool>(xregs_[A0] & 1);
+}
+
+int32_t CodeSimulatorLoongarch64::GetCReturnInt32() const {
+  DCHECK(kCanSimulate);
+  return static_cast<int32_t>(xregs_[A0]);
+}
+
+int64_t CodeSimulatorLoongarch64::GetCReturnInt64() const {
+  DCHECK(kCanSimulate);
+  return xregs_[A0];
+}
+
+void CodeSimulatorLoongarch64::CallEntrypointHook(size_t index) {
+  QuickEntrypointEnum entrypoint = static_cast<QuickEntrypointEnum>(index);
+  if (hooks_[index] == nullptr) {
+    LOG(FATAL) << "Simulated code called entrypoint " << entrypoint
+               << " without a hook, return address " << std::hex << xregs_[RA];
+  }
+  hooks_[index](this);
+  pc_ = static_cast<uintptr_t>(xregs_[RA]);
+}
+
+void CodeSimulatorLoongarch64::Unimplemented(uint32_t insn) const {
+  LOG(FATAL) << StringPrintf("Unimplemented instruction 0x%08x at 0x%" PRIxPTR, insn, pc_);
+  UNREACHABLE();
+}
+
+void CodeSimulatorLoongarch64::ExecuteInstruction(uint32_t insn) {
+  switch (insn >> 26) {
+    case 0x00u:
+      if (insn < 0x00400000u) {
+        ExecuteIntegerRegister(insn);
+      } else if (insn < 0x01000000u || insn >= 0x02000000u) {
+        ExecuteIntegerImmediate(insn);
+      } else {
+        ExecuteFloatingPoint(insn);
+      }
+      break;
+    case 0x02u:  // FMADD, FMSUB.
+    case 0x03u:  // FCMP, FSEL.
+      ExecuteFloatingPoint(insn);
+      break;
+    case 0x04u:  // ADDU16I.D.
+    case 0x05u:  // LU12I.W, LU32I.D.
+    case 0x06u:  // PCADDI, PCALAU12I.
+    case 0x07u:  // PCADDU12I, PCADDU18I.
+      ExecuteIntegerImmediate(insn);
+      break;
+    case 0x08u:  // LL, SC.
+    case 0x09u:  // LDPTR, STPTR.
+    case 0x0au:  // Loads and stores with a 12-bit offset.
+    case 0x0eu:  // Indexed loads and stores, atomics and barriers.
+      ExecuteLoadStore(insn);
+      break;
+    default:
+      if (insn >= 0x40000000u && insn < 0x70000000u) {
+        ExecuteBranch(insn);
+      } else {
+        Unimplemented(insn);
+      }
+      break;
+  }
+}
+
+void CodeSimulatorLoongarch64::ExecuteIntegerRegister(uint32_t insn) {
+  const uint64_t rj = static_cast<uint64_t>(xregs_[Rj(insn)]);
+  const uint64_t rk = static_cast<uint64_t>(xregs_[Rk(insn)]);
+  const XRegister rd = static_cast<XRegister>(Rd(insn));
+  const int32_t rj32 = static_cast<int32_t>(rj);
+  const int32_t rk32 = static_cast<int32_t>(rk);
+  const uint32_t rj_u32 = static_cast<uint32_t>(rj);
+  const uint32_t rk_u32 = static_cast<uint32_t>(rk);
+  const uint32_t shift32 = rk & 0x1fu;
+  const uint32_t shift64 = rk & 0x3fu;
+
+  switch (insn & 0xfffffc00u) {
+    case 0x00001000u:  // clo.w
+      WriteXRegister(rd, CountLeadingZeros(static_cast<uint32_t>(~rj)));
+      return;
+    case 0x00001400u:  // clz.w
+      WriteXRegister(rd, CountLeadingZeros(static_cast<uint32_t>(rj)));
+      return;
+    case 0x00001800u:  // cto.w
+      WriteXRegister(rd, CountTrailingZeros(static_cast<uint32_t>(~rj)));
+      return;
+    case 0x00001c00u:  // ctz.w
+      WriteXRegister(rd, CountTrailingZeros(static_cast<uint32_t>(rj)));
+      return;
+    case 0x00002000u:  // clo.d
+      WriteXRegister(rd, CountLeadingZeros(~rj));
+      return;
+    case 0x00002400u:  // clz.d
+      WriteXRegister(rd, CountLeadingZeros(rj));
+      return;
+    case 0x00002800u:  // cto.d
+      WriteXRegister(rd, CountTrailingZeros(~rj));
+      return;
+    case 0x00002c00u:  // ctz.d
+      WriteXRegister(rd, CountTrailingZeros(rj));
+      return;
+    case 0x00003000u:  // revb.2h
+      WriteXRegister(rd, SignExtend32(ReverseBytesIn<uint16_t>(rj)));
+      return;
+    case 0x00003400u:  // revb.4h
+      WriteXRegister(rd, ReverseBytesIn<uint16_t>(rj));
+      return;
+    case 0x00003800u:  // revb.2w
+      WriteXRegister(rd, ReverseBytesIn<uint32_t>(rj));
+      return;
+    case 0x00003c00u:  // revb.d
+      WriteXRegister(rd, ReverseBytesIn<uint64_t>(rj));
+      return;
+    case 0x00004000u:  // revh.2w
+      WriteXRegister(rd, SwapHalfwordsInWords(rj));
+      return;
+    case 0x00004400u:  // revh.d
+      WriteXRegister(rd, SwapHalfwordsInWords((rj << 32) | (rj >> 32)));
+      return;
+    case 0x00004800u:  // bitrev.4b
+      WriteXRegister(rd, SignExtend32(ReverseBitsInBytes(rj)));
+      return;
+    case 0x00004c00u:  // bitrev.8b
+      WriteXRegister(rd, ReverseBitsInBytes(rj));
+      return;
+    case 0x00005000u:  // bitrev.w
+      WriteXRegister(rd, SignExtend32(ReverseBits32(static_cast<uint32_t>(rj))));
+      return;
+    case 0x00005400u:  // bitrev.d
+      WriteXRegister(rd, ReverseBits64(rj));
+      return;
+    case 0x00005800u:  // ext.w.h
+      WriteXRegister(rd, static_cast<int16_t>(rj));
+      return;
+    case 0x00005c00u:  // ext.w.b
+      WriteXRegister(rd, static_cast<int8_t>(rj));
+      return;
+    default:
+      break;
+  }
+
+  const uint32_t sa = UnsignedField(insn, 15, 2) + 1u;
+  switch (insn & 0xfffe0000u) {
+    case 0x00040000u:  // alsl.w
+      WriteXRegister(rd, SignExtend32((rj << sa) + rk));
+      return;
+    case 0x00060000u:  // alsl.wu
+      WriteXRegister(rd, static_cast<uint32_t>((rj << sa) + rk));
+      return;
+    case 0x002c0000u:  // alsl.d
+      WriteXRegister(rd, (rj << sa) + rk);
+      return;
+    default:
+      break;
+  }
+
+  switch (insn & 0xffff8000u) {
+    case 0x00100000u:  // add.w
+      WriteXRegister(rd, SignExtend32(rj + rk));
+      break;
+    case 0x00108000u:  // add.d
+      WriteXRegister(rd, rj + rk);
+      break;
+    case 0x00110000u:  // sub.w
+      WriteXRegister(rd, SignExtend32(rj - rk));
+      break;
+    case 0x00118000u:  // sub.d
+      WriteXRegister(rd, rj - rk);
+      break;
+    case 0x00120000u:  // slt
+      WriteXRegister(rd, static_cast<int64_t>(rj) < static_cast<int64_t>(rk) ? 1 : 0);
+      break;
+    case 0x00128000u:  // sltu
+      WriteXRegister(rd, rj < rk ? 1 : 0);
+      break;
+    case 0x00130000u:  // maskeqz
+      WriteXRegister(rd, rk == 0u ? 0u : rj);
+      break;
+    case 0x00138000u:  // masknez
+      WriteXRegister(rd, rk != 0u ? 0u : rj);
+      break;
+    case 0x00140000u:  // nor
+      WriteXRegister(rd, ~(rj | rk));
+      break;
+    case 0x00148000u:  // and
+      WriteXRegister(rd, rj & rk);
+      break;
+    case 0x00150000u:  // or
+      WriteXRegister(rd, rj | rk);
+      break;
+    case 0x00158000u:  // xor
+      WriteXRegister(rd, rj ^ rk);
+      break;
+    case 0x00160000u:  // orn
+      WriteXRegister(rd, rj | ~rk);
+      break;
+    case 0x00168000u:  // andn
+      WriteXRegister(rd, rj & ~rk);
+      break;
+    case 0x00170000u:  // sll.w
+      WriteXRegister(rd, SignExtend32(static_cast<uint32_t>(rj) << shift32));
+      break;
+    case 0x00178000u:  // srl.w
+      WriteXRegister(rd, SignExtend32(static_cast<uint32_t>(rj) >> shift32));
+      break;
+    case 0x00180000u:  // sra.w
+      WriteXRegister(rd, rj32 >> shift32);
+      break;
+    case 0x00188000u:  // sll.d
+      WriteXRegister(rd, rj << shift64);
+      break;
+    case 0x00190000u:  // srl.d
+      WriteXRegister(rd, rj >> shift64);
+      break;
+    case 0x00198000u:  // sra.d
+      WriteXRegister(rd, static_cast<int64_t>(rj) >> shift64);
+      break;
+    case 0x001b0000u:  // rotr.w
+      WriteXRegister(rd, SignExtend32(Rot<uint32_t, false>(static_cast<uint32_t>(rj), shift32)));
+      break;
+    case 0x001b8000u:  // rotr.d
+      WriteXRegister(rd, Rot<uint64_t, false>(rj, shift64));
+      break;
+    case 0x001c0000u:  // mul.w
+      WriteXRegister(rd, SignExtend32(rj * rk));
+      break;
+    case 0x001c8000u:  // mulh.w
+      WriteXRegister(rd, (static_cast<int64_t>(rj32) * rk32) >> 32);
+      break;
+    case 0x001d0000u:  // mulh.wu
+      WriteXRegister(rd, SignExtend32((static_cast<uint64_t>(rj_u32) * rk_u32) >> 32));
+      break;
+    case 0x001d8000u:  // mul.d
+      WriteXRegister(rd, rj * rk);
+      break;
+    case 0x001e0000u:  // mulh.d
+      WriteXRegister(rd, static_cast<int64_t>(
+          (static_cast<__int128>(static_cast<int64_t>(rj)) * static_cast<int64_t>(rk)) >> 64));
+      break;
+    case 0x001e8000u:  // mulh.du
+      WriteXRegister(rd, static_cast<uint64_t>(
+          (static_cast<unsigned __int128>(rj) * rk) >> 64));
+      break;
+    case 0x00200000u:  // div.w
+      WriteXRegister(rd, Divide(rj32, rk32));
+      break;
+    case 0x00208000u:  // mod.w
+      WriteXRegister(rd, Remainder(rj32, rk32));
+      break;
+    case 0x00210000u:  // div.wu
+      WriteXRegister(rd, SignExtend32(Divide(rj_u32, rk_u32)));
+      break;
+    case 0x00218000u:  // mod.wu
+      WriteXRegister(rd, SignExtend32(Remainder(rj_u32, rk_u32)));
+      break;
+    case 0x00220000u:  // div.d
+      WriteXRegister(rd, Divide(static_cast<int64_t>(rj), static_cast<int64_t>(rk)));
+      break;
+    case 0x00228000u:  // mod.d
+      WriteXRegister(rd, Remainder(static_cast<int64_t>(rj), static_cast<int64_t>(rk)));
+      break;
+    case 0x00230000u:  // div.du
+      WriteXRegister(rd, Divide(rj, rk));
+      break;
+    case 0x00238000u:  // mod.du
+      WriteXRegister(rd, Remainder(rj, rk));
+      break;
+    case 0x002a0000u:  // break
+      LOG(FATAL) << StringPrintf("Simulated code hit `break %u` at 0x%" PRIxPTR,
+                                 static_cast<uint32_t>(UnsignedField(insn, 0, 15)),
+                                 pc_);
+      UNREACHABLE();
+    default:
+      Unimplemented(insn);
+  }
+}
+
+void CodeSimulatorLoongarch64::ExecuteIntegerImmediate(uint32_t insn) {
+  const uint64_t rj = static_cast<uint64_t>(xregs_[Rj(insn)]);
+  const XRegister rd = static_cast<XRegister>(Rd(insn));
+  const uint64_t old_rd = static_cast<uint64_t>(xregs_[rd]);
+  const uint32_t rj_u32 = static_cast<uint32_t>(rj);
+
+  // Shifts by an immediate.
+  switch (insn & 0xffff8000u) {
+    case 0x00408000u:  // slli.w
+      WriteXRegister(rd, SignExtend32(static_cast<uint32_t>(rj) << UnsignedField(insn, 10, 5)));
+      return;
+    case 0x00448000u:  // srli.w
+      WriteXRegister(rd, SignExtend32(static_cast<uint32_t>(rj) >> UnsignedField(insn, 10, 5)));
+      return;
+    case 0x00488000u:  // srai.w
+      WriteXRegister(rd, static_cast<int32_t>(rj) >> UnsignedField(insn, 10, 5));
+      return;
+    case 0x004c8000u:  // rotri.w
+      WriteXRegister(
+          rd, SignExtend32(Rot<uint32_t, false>(rj_u32, UnsignedField(insn, 10, 5))));
+      return;
+    default:
+      break;
+  }
+  switch (insn & 0xffff0000u) {
+    case 0x00410000u:  // slli.d
+      WriteXRegister(rd, rj << UnsignedField(insn, 10, 6));
+      return;
+    case 0x00450000u:  // srli.d
+      WriteXRegister(rd, rj >> UnsignedField(insn, 10, 6));
+      return;
+    case 0x00490000u:  // srai.d
+      WriteXRegister(rd, static_cast<int64_t>(rj) >> UnsignedField(insn, 10, 6));
+      return;
+    case 0x004d0000u:  // rotri.d
+      WriteXRegister(rd, Rot<uint64_t, false>(rj, UnsignedField(insn, 10, 6)));
+      return;
+    default:
+      break;
+  }
+
+  // Bit string instructions.
+  switch (insn & 0xffe08000u) {
+    case 0x00600000u: {  // bstrins.w
+      uint32_t msb = UnsignedField(insn, 16, 5);
+      uint32_t lsb = UnsignedField(insn, 10, 5);
+      uint32_t mask = MaskLeastSignificant<uint32_t>(msb - lsb + 1u) << lsb;
+      uint32_t value = (static_cast<uint32_t>(old_rd) & ~mask) |
+                       ((static_cast<uint32_t>(rj) << lsb) & mask);
+      WriteXRegister(rd, SignExtend32(value));
+      return;
+    }
+    case 0x00608000u: {  // bstrpick.w
+      uint32_t msb = UnsignedField(insn, 16, 5);
+      uint32_t lsb = UnsignedField(insn, 10, 5);
+      WriteXRegister(rd, SignExtend32(BitFieldExtract(rj_u32, lsb, msb - lsb + 1u)));
+      return;
+    }
+    default:
+      break;
+  }
+
+  const int64_t si12 = SignedField(insn, 10, 12);
+  const uint64_t ui12 = UnsignedField(insn, 10, 12);
+  switch (insn & 0xffc00000u) {
+    case 0x00800000u: {  // bstrins.d
+      uint32_t msb = UnsignedField(insn, 16, 6);
+      uint32_t lsb = UnsignedField(insn, 10, 6);
+      uint64_t mask = MaskLeastSignificant<uint64_t>(msb - lsb + 1u) << lsb;
+      WriteXRegister(rd, (old_rd & ~mask) | ((rj << lsb) & mask));
+      return;
+    }
+    case 0x00c00000u: {  // bstrpick.d
+      uint32_t msb = UnsignedField(insn, 16, 6);
+      uint32_t lsb = UnsignedField(insn, 10, 6);
+      WriteXRegister(rd, BitFieldExtract(rj, lsb, msb - lsb + 1u));
+      return;
+    }
+    case 0x02000000u:  // slti
+      WriteXRegister(rd, static_cast<int64_t>(rj) < si12 ? 1 : 0);
+      return;
+    case 0x02400000u:  // sltui
+      WriteXRegister(rd, rj < static_cast<uint64_t>(si12) ? 1 : 0);
+      return;
+    case 0x02800000u:  // addi.w
+      WriteXRegister(rd, SignExtend32(rj + si12));
+      return;
+    case 0x02c00000u:  // addi.d
+      WriteXRegister(rd, rj + si12);
+      return;
+    case 0x03000000u:  // lu52i.d
+      WriteXRegister(rd, (rj & UINT64_C(0x000fffffffffffff)) | (static_cast<uint64_t>(si12) << 52));
+      return;
+    case 0x03400000u:  // andi
+      WriteXRegister(rd, rj & ui12);
+      return;
+    case 0x03800000u:  // ori
+      WriteXRegister(rd, rj | ui12);
+      return;
+    case 0x03c00000u:  // xori
+      WriteXRegister(rd, rj ^ ui12);
+      return;
+    default:
+      break;
+  }
+
+  if ((insn & 0xfc000000u) == 0x10000000u) {  // addu16i.d
+    WriteXRegister(rd, rj + static_cast<uint64_t>(SignedField(insn, 10, 16) << 16));
+    return;
+  }
+
+  const int64_t si20 = SignedField(insn, 5, 20);
+  const uint64_t pc = static_cast<uint64_t>(pc_);
+  switch (insn & 0xfe000000u) {
+    case 0x14000000u:  // lu12i.w
+      WriteXRegister(rd, SignExtend32(static_cast<uint64_t>(si20) << 12));
+      break;
+    case 0x16000000u:  // lu32i.d
+      WriteXRegister(rd, (old_rd & 0xffffffffu) | (static_cast<uint64_t>(si20) << 32));
+      break;
+    case 0x18000000u:  // pcaddi
+      WriteXRegister(rd, pc + (static_cast<uint64_t>(si20) << 2));
+      break;
+    case 0x1a000000u:  // pcalau12i
+      WriteXRegister(rd, (pc + (static_cast<uint64_t>(si20) << 12)) & ~UINT64_C(0xfff));
+      break;
+    case 0x1c000000u:  // pcaddu12i
+      WriteXRegister(rd, pc + (static_cast<uint64_t>(si20) << 12));
+      break;
+    case 0x1e000000u:  // pcaddu18i
+      WriteXRegister(rd, pc + (static_cast<uint64_t>(si20) << 18));
+      break;
+    default:
+      Unimplemented(insn);
+  }
+}
+
+void CodeSimulatorLoongarch64::ExecuteLoadStore(uint32_t insn) {
+  const uint64_t rj = static_cast<uint64_t>(xregs_[Rj(insn)]);
+  const uint64_t rk = static_cast<uint64_t>(xregs_[Rk(insn)]);
+  const XRegister rd = static_cast<XRegister>(Rd(insn));
+  const FRegister fd = static_cast<FRegister>(Rd(insn));
+  const uint64_t value = static_cast<uint64_t>(xregs_[rd]);
+
+  // LL/SC and LDPTR/STPTR with a 14-bit offset scaled by 4. The simulation is
+  // single-threaded, so SC always succeeds.
+  const uint64_t address14 = rj + static_cast<uint64_t>(SignedField(insn, 10, 14) << 2);
+  switch (insn & 0xff000000u) {
+    case 0x20000000u:  // ll.w
+    case 0x24000000u:  // ldptr.w
+      WriteXRegister(rd, Load<int32_t>(address14));
+      return;
+    case 0x21000000u:  // sc.w
+      Store<uint32_t>(address14, value);
+      WriteXRegister(rd, 1);
+      return;
+    case 0x25000000u:  // stptr.w
+      Store<uint32_t>(address14, value);
+      return;
+    case 0x22000000u:  // ll.d
+    case 0x26000000u:  // ldptr.d
+      WriteXRegister(rd, Load<int64_t>(address14));
+      return;
+    case 0x23000000u:  // sc.d
+      Store<uint64_t>(address14, value);
+      WriteXRegister(rd, 1);
+      return;
+    case 0x27000000u:  // stptr.d
+      Store<uint64_t>(address14, value);
+      return;
+    default:
+      break;
+  }
+
+  // Loads and stores with a 12-bit offset.
+  const uint64_t address12 = rj + static_cast<uint64_t>(SignedField(insn, 10, 12));
+  switch (insn & 0xffc00000u) {
+    case 0x28000000u:  // ld.b
+      WriteXRegister(rd, Load<int8_t>(address12));
+      return;
+    case 0x28400000u:  // ld.h
+      WriteXRegister(rd, Load<int16_t>(address12));
+      return;
+    case 0x28800000u:  // ld.w
+      WriteXRegister(rd, Load<int32_t>(address12));
+      return;
+    case 0x28c00000u:  // ld.d
+      WriteXRegister(rd, Load<int64_t>(address12));
+      return;
+    case 0x29000000u:  // st.b
+      Store<uint8_t>(address12, value);
+      return;
+    case 0x29400000u:  // st.h
+      Store<uint16_t>(address12, value);
+      return;
+    case 0x29800000u:  // st.w
+      Store<uint32_t>(address12, value);
+      return;
+    case 0x29c00000u:  // st.d
+      Store<uint64_t>(address12, value);
+      return;
+    case 0x2a000000u:  // ld.bu
+      WriteXRegister(rd, Load<uint8_t>(address12));
+      return;
+    case 0x2a400000u:  // ld.hu
+      WriteXRegister(rd, Load<uint16_t>(address12));
+      return;
+    case 0x2a800000u:  // ld.wu
+      WriteXRegister(rd, Load<uint32_t>(address12));
+      return;
+    case 0x2b000000u:  // fld.s
+      fregs_[fd] = (fregs_[fd] & ~UINT64_C(0xffffffff)) | Load<uint32_t>(address12);
+      return;
+    case 0x2b400000u:  // fst.s
+      Store<uint32_t>(address12, fregs_[fd]);
+      return;
+    case 0x2b800000u:  // fld.d
+      fregs_[fd] = Load<uint64_t>(address12);
+      return;
+    case 0x2bc00000u:  // fst.d
+      Store<uint64_t>(address12, fregs_[fd]);
+      return;
+    default:
+      break;
+  }
+
+  // Indexed loads and stores.
+  const uint64_t address = rj + rk;
+  switch (insn & 0xffff8000u) {
+    case 0x38000000u:  // ldx.b
+      WriteXRegister(rd, Load<int8_t>(address));
+      return;
+    case 0x38040000u:  // ldx.h
+      WriteXRegister(rd, Load<int16_t>(address));
+      return;
+    case 0x38080000u:  // ldx.w
+      WriteXRegister(rd, Load<int32_t>(address));
+      return;
+    case 0x380c0000u:  // ldx.d
+      WriteXRegister(rd, Load<int64_t>(address));
+      return;
+    case 0x38100000u:  // stx.b
+      Store<uint8_t>(address, value);
+      return;
+    case 0x38140000u:  // stx.h
+      Store<uint16_t>(address, value);
+      return;
+    case 0x38180000u:  // stx.w
+      Store<uint32_t>(address, value);
+      return;
+    case 0x381c0000u:  // stx.d
+      Store<uint64_t>(address, value);
+      return;
+    case 0x38200000u:  // ldx.bu
+      WriteXRegister(rd, Load<uint8_t>(address));
+      return;
+    case 0x38240000u:  // ldx.hu
+      WriteXRegister(rd, Load<uint16_t>(address));
+      return;
+    case 0x38280000u:  // ldx.wu
+      WriteXRegister(rd, Load<uint32_t>(address));
+      return;
+    case 0x38300000u:  // fldx.s
+      fregs_[fd] = (fregs_[fd] & ~UINT64_C(0xffffffff)) | Load<uint32_t>(address);
+      return;
+    case 0x38340000u:  // fldx.d
+      fregs_[fd] = Load<uint64_t>(address);
+      return;
+    case 0x38380000u:  // fstx.s
+      Store<uint32_t>(address, fregs_[fd]);
+      return;
+    case 0x383c0000u:  // fstx.d
+      Store<uint64_t>(address, fregs_[fd]);
+      return;
+    case 0x38600000u:    // amswap.w
+    case 0x38690000u: {  // amswap_db.w
+      int32_t old_value = Load<int32_t>(rj);
+      Store<uint32_t>(rj, rk);
+      WriteXRegister(rd, old_value);
+      return;
+    }
+    case 0x38608000u:    // amswap.d
+    case 0x38698000u: {  // amswap_db.d
+      int64_t old_value = Load<int64_t>(rj);
+      Store<uint64_t>(rj, rk);
+      WriteXRegister(rd, old_value);
+      return;
+    }
+    case 0x38610000u:    // amadd.w
+    case 0x386a0000u: {  // amadd_db.w
+      int32_t old_value = Load<int32_t>(rj);
+      Store<uint32_t>(rj, static_cast<uint32_t>(old_value) + static_cast<uint32_t>(rk));
+      WriteXRegister(rd, old_value);
+      return;
+    }
+    case 0x38618000u:    // amadd.d
+    case 0x386a8000u: {  // amadd_db.d
+      int64_t old_value = Load<int64_t>(rj);
+      Store<uint64_t>(rj, static_cast<uint64_t>(old_value) + rk);
+      WriteXRegister(rd, old_value);
+      return;
+    }
+    case 0x38720000u:  // dbar
+    case 0x38728000u:  // ibar
+      return;
+    default:
+      Unimplemented(insn);
+  }
+}
+
+void CodeSimulatorLoongarch64::ExecuteBranch(uint32_t insn) {
+  const uint64_t rj = static_cast<uint64_t>(xregs_[Rj(insn)]);
+  const uint64_t rd = static_cast<uint64_t>(xregs_[Rd(insn)]);
+  const uintptr_t offs16 = static_cast<uintptr_t>(SignedField(insn, 10, 16) << 2);
+  const uintptr_t offs21 = static_cast<uintptr_t>(
+      BitFieldExtract(static_cast<int32_t>((Rd(insn) << 16) | UnsignedField(insn, 10, 16)), 0, 21)
+      << 2);
+  const uintptr_t offs26 = static_cast<uintptr_t>(
+      BitFieldExtract(static_cast<int32_t>((UnsignedField(insn, 0, 10) << 16) |
+                                           UnsignedField(insn, 10, 16)),
+                      0,
+                      26)
+      << 2);
+
+  bool taken;
+  switch (insn & 0xfc000000u) {
+    case 0x40000000u:  // beqz
+      taken = (rj == 0u);
+      next_pc_ = taken ? pc_ + offs21 : next_pc_;
+      return;
+    case 0x44000000u:  // bnez
+      taken = (rj != 0u);
+      next_pc_ = taken ? pc_ + offs21 : next_pc_;
+      return;
+    case 0x48000000u:  // bceqz, bcnez
+      if ((insn & 0x00000300u) == 0u) {
+        taken = !fcc_[Rj(insn) & 7u];
+      } else if ((insn & 0x00000300u) == 0x00000100u) {
+        taken = fcc_[Rj(insn) & 7u];
+      } else {
+        Unimplemented(insn);
+      }
+      next_pc_ = taken ? pc_ + offs21 : next_pc_;
+      return;
+    case 0x4c000000u:  // jirl
+      WriteXRegister(static_cast<XRegister>(Rd(insn)), static_cast<int64_t>(next_pc_));
+      next_pc_ = static_cast<uintptr_t>(rj) + offs16;
+      return;
+    case 0x50000000u:  // b
+      next_pc_ = pc_ + offs26;
+      return;
+    case 0x54000000u:  // bl
+      WriteXRegister(RA, static_cast<int64_t>(next_pc_));
+      next_pc_ = pc_ + offs26;
+      return;
+    case 0x58000000u:  // beq
+      taken = (rj == rd);
+      break;
+    case 0x5c000000u:  // bne
+      taken = (rj != rd);
+      break;
+    case 0x60000000u:  // blt
+      taken = static_cast<int64_t>(rj) < static_cast<int64_t>(rd);
+      break;
+    case 0x64000000u:  // bge
+      taken = static_cast<int64_t>(rj) >= static_cast<int64_t>(rd);
+      break;
+    case 0x68000000u:  // bltu
+      taken = rj < rd;
+      break;
+    case 0x6c000000u:  // bgeu
+      taken = rj >= rd;
+      break;
+    default:
+      Unimplemented(insn);
+  }
+  if (taken) {
+    next_pc_ = pc_ + offs16;
+  }
+}
+
+void CodeSimulatorLoongarch64::ExecuteFloatingPoint(uint32_t insn) {
+  const FRegister fd = static_cast<FRegister>(Rd(insn));
+  const uint64_t fj_bits = fregs_[Rj(insn)];
+  const uint64_t fk_bits = fregs_[Rk(insn)];
+  const uint64_t fa_bits = fregs_[Ra(insn)];
+  const float fj_s = bit_cast<float, uint32_t>(static_cast<uint32_t>(fj_bits));
+  const float fk_s = bit_cast<float, uint32_t>(static_cast<uint32_t>(fk_bits));
+  const float fa_s = bit_cast<float, uint32_t>(static_cast<uint32_t>(fa_bits));
+  const double fj_d = bit_cast<double, uint64_t>(fj_bits);
+  const double fk_d = bit_cast<double, uint64_t>(fk_bits);
+  const double fa_d = bit_cast<double, uint64_t>(fa_bits);
+  const uint64_t rj = static_cast<uint64_t>(xregs_[Rj(insn)]);
+  const XRegister rd = static_cast<XRegister>(Rd(insn));
+
+  // Single precision results only replace the low 32 bits of the register.
+  auto write_low = [this, fd](uint32_t bits) {
+    fregs_[fd] = (fregs_[fd] & ~UINT64_C(0xffffffff)) | bits;
+  };
+  auto write_s = [&write_low](float value) { write_low(bit_cast<uint32_t, float>(value)); };
+  auto write_d = [this, fd](double value) { fregs_[fd] = bit_cast<uint64_t, double>(value); };
+
+  switch (insn & 0xfff00000u) {
+    case 0x08100000u:  // fmadd.s
+      write_s(std::fma(fj_s, fk_s, fa_s));
+      return;
+    case 0x08200000u:  // fmadd.d
+      write_d(std::fma(fj_d, fk_d, fa_d));
+      return;
+    case 0x08500000u:  // fmsub.s
+      write_s(std::fma(fj_s, fk_s, -fa_s));
+      return;
+    case 0x08600000u:  // fmsub.d
+      write_d(std::fma(fj_d, fk_d, -fa_d));
+      return;
+    case 0x0c100000u:  // fcmp.cond.s
+    case 0x0c200000u:  // fcmp.cond.d
+      if ((insn & 0x00000018u) != 0u) {
+        Unimplemented(insn);
+      }
+      fcc_[Rd(insn) & 7u] = ((insn & 0xfff00000u) == 0x0c100000u)
+          ? CompareFloats(Ra(insn), fj_s, fk_s)
+          : CompareFloats(Ra(insn), fj_d, fk_d);
+      return;
+    default:
+      break;
+  }
+  if ((insn & 0xfffc0000u) == 0x0d000000u) {  // fsel
+    fregs_[fd] = fcc_[Ra(insn) & 7u] ? fk_bits : fj_bits;
+    return;
+  }
+
+  switch (insn & 0xffff8000u) {
+    case 0x01008000u:  // fadd.s
+      write_s(fj_s + fk_s);
+      return;
+    case 0x01010000u:  // fadd.d
+      write_d(fj_d + fk_d);
+      return;
+    case 0x01028000u:  // fsub.s
+      write_s(fj_s - fk_s);
+      return;
+    case 0x01030000u:  // fsub.d
+      write_d(fj_d - fk_d);
+      return;
+    case 0x01048000u:  // fmul.s
+      write_s(fj_s * fk_s);
+      return;
+    case 0x01050000u:  // fmul.d
+      write_d(fj_d * fk_d);
+      return;
+    case 0x01068000u:  // fdiv.s
+      write_s(fj_s / fk_s);
+      return;
+    case 0x01070000u:  // fdiv.d
+      write_d(fj_d / fk_d);
+      return;
+    case 0x01088000u:  // fmax.s
+      write_s(std::fmax(fj_s, fk_s));
+      return;
+    case 0x01090000u:  // fmax.d
+      write_d(std::fmax(fj_d, fk_d));
+      return;
+    case 0x010a8000u:  // fmin.s
+      write_s(std::fmin(fj_s, fk_s));
+      return;
+    case 0x010b0000u:  // fmin.d
+      write_d(std::fmin(fj_d, fk_d));
+      return;
+    case 0x01128000u:  // fcopysign.s
+      write_s(std::copysign(fj_s, fk_s));
+      return;
+    case 0x01130000u:  // fcopysign.d
+      write_d(std::copysign(fj_d, fk_d));
+      return;
+    default:
+      break;
+  }
+
+  switch (insn & 0xfffffc00u) {
+    case 0x01140400u:  // fabs.s
+      write_low(static_cast<uint32_t>(fj_bits) & 0x7fffffffu);
+      break;
+    case 0x01140800u:  // fabs.d
+      fregs_[fd] = fj_bits & ~(UINT64_C(1) << 63);
+      break;
+    case 0x01141400u:  // fneg.s
+      write_low(static_cast<uint32_t>(fj_bits) ^ 0x80000000u);
+      break;
+    case 0x01141800u:  // fneg.d
+      fregs_[fd] = fj_bits ^ (UINT64_C(1) << 63);
+      break;
+    case 0x01143400u:  // fclass.s
+      write_low(ClassifyFloat(fj_s, (fj_bits & (1u << 22)) == 0u));
+      break;
+    case 0x01143800u:  // fclass.d
+      fregs_[fd] = ClassifyFloat(fj_d, (fj_bits & (UINT64_C(1) << 51)) == 0u);
+      break;
+    case 0x01144400u:  // fsqrt.s
+      write_s(std::sqrt(fj_s));
+      break;
+    case 0x01144800u:  // fsqrt.d
+      write_d(std::sqrt(fj_d));
+      break;
+    case 0x01149400u:  // fmov.s
+    case 0x01149800u:  // fmov.d
+      fregs_[fd] = fj_bits;
+      break;
+    case 0x0114a400u:  // movgr2fr.w
+      write_low(static_cast<uint32_t>(rj));
+      break;
+    case 0x0114a800u:  // movgr2fr.d
+      fregs_[fd] = rj;
+      break;
+    case 0x0114ac00u:  // movgr2frh.w
+      fregs_[fd] = (fregs_[fd] & UINT64_C(0xffffffff)) | (rj << 32);
+      break;
+    case 0x0114b400u:  // movfr2gr.s
+      WriteXRegister(rd, SignExtend32(fj_bits));
+      break;
+    case 0x0114b800u:  // movfr2gr.d
+      WriteXRegister(rd, fj_bits);
+      break;
+    case 0x0114bc00u:  // movfrh2gr.s
+      WriteXRegister(rd, SignExtend32(fj_bits >> 32));
+      break;
+    case 0x01191800u:  // fcvt.s.d
+      write_s(static_cast<float>(fj_d));
+      break;
+    case 0x01192400u:  // fcvt.d.s
+      write_d(static_cast<double>(fj_s));
+      break;
+    case 0x011a8400u:  // ftintrz.w.s
+      write_low(TruncateToInteger<int32_t>(fj_s));
+      break;
+    case 0x011a8800u:  // ftintrz.w.d
+      write_low(TruncateToInteger<int32_t>(fj_d));
+      break;
+    case 0x011aa400u:  // ftintrz.l.s
+      fregs_[fd] = TruncateToInteger<int64_t>(fj_s);
+      break;
+    case 0x011aa800u:  // ftintrz.l.d
+      fregs_[fd] = TruncateToInteger<int64_t>(fj_d);
+      break;
+    case 0x011d1000u:  // ffint.s.w
+      write_s(static_cast<float>(static_cast<int32_t>(fj_bits)));
+      break;
+    case 0x011d1800u:  // ffint.s.l
+      write_s(static_cast<float>(static_cast<int64_t>(fj_bits)));
+      break;
+    case 0x011d2000u:  // ffint.d.w
+      write_d(static_cast<double>(static_cast<int32_t>(fj_bits)));
+      break;
+    case 0x011d2800u:  // ffint.d.l
+      write_d(static_cast<double>(static_cast<int64_t>(fj_bits)));
+      break;
+    case 0x011e4400u:  // frint.s
+      write_s(std::nearbyint(fj_s));
+      break;
+    case 0x011e4800u:  // frint.d
+      write_d(std::nearbyint(fj_d));
+      break;
+    default:
+      if ((insn & 0xfffffc18u) == 0x0114d800u) {  // movgr2cf
+        fcc_[Rd(insn) & 7u] = (rj & 1u) != 0u;
+      } else if ((insn & 0xffffff00u) == 0x0114dc00u) {  // movcf2gr
+        WriteXRegister(rd, fcc_[Rj(insn) & 7u] ? 1 : 0);
+      } else {
+        Unimplemented(insn);
+      }
+      break;
+  }
+}
+
+}  // namespace loongarch64
+}  // namespace art
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_SIMULATOR_CODE_SIMULATOR_LOONGARCH64_H_
+#define ART_SIMULATOR_CODE_SIMULATOR_LOONGARCH64_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "arch/instruction_set.h"
+#include "arch/loongarch64/registers_loongarch64.h"
+#include "code_simulator.h"
+#include "entrypoints/quick/quick_entrypoints_enum.h"
+
+namespace art {
+namespace loongarch64 {
+
+// Interpreter for the LoongArch64 base integer and floating point ISA, used to run
+// generated code on a host of a different architecture.
+//
+// The simulated code shares the host address space: loads and stores access host
+// memory directly. TR points to a zero-initialized fake Thread whose quick entrypoint
+// slots lead to hooks registered with SetEntrypointHook(); calling an entrypoint
+// without a hook aborts the simulation.
+class CodeSimulatorLoongarch64 : public CodeSimulator {
+ public:
+  // Called when simulated code calls an entrypoint. The hook reads its arguments and
+  // writes its results through the register accessors below; the simulation then
+  // resumes at RA.
+  using EntrypointHook = std::function<void(CodeSimulatorLoongarch64* simulator)>;
+
+  static CodeSimulatorLoongarch64* CreateCodeSimulatorLoongarch64();
+  virtual ~CodeSimulatorLoongarch64();
+
+  void RunFrom(intptr_t code_buffer) override;
+
+  bool GetCReturnBool() const override;
+  int32_t GetCReturnInt32() const override;
+  int64_t GetCReturnInt64() const override;
+
+  void SetEntrypointHook(QuickEntrypointEnum entrypoint, EntrypointHook hook);
+
+  int64_t ReadXRegister(XRegister reg) const {
+    return xregs_[reg];
+  }
+
+  void WriteXRegister(XRegister reg, int64_t value) {
+    if (reg != Zero) {
+      xregs_[reg] = value;
+    }
+  }
+
+  uint64_t ReadFRegisterBits(FRegister reg) const {
+    return fregs_[reg];
+  }
+
+  void WriteFRegisterBits(FRegister reg, uint64_t value) {
+    fregs_[reg] = value;
+  }
+
+  // Number of instructions executed by the last RunFrom(), not counting entrypoint hooks.
+  uint64_t GetInstructionCount() const {
+    return instruction_count_;
+  }
+
+ private:
+  CodeSimulatorLoongarch64();
+
+  void ExecuteInstruction(uint32_t insn);
+  void ExecuteBranch(uint32_t insn);
+  void ExecuteLoadStore(uint32_t insn);
+  void ExecuteFloatingPoint(uint32_t insn);
+  void ExecuteIntegerImmediate(uint32_t insn);
+  void ExecuteIntegerRegister(uint32_t insn);
+  void CallEntrypointHook(size_t index);
+
+  NO_RETURN void Unimplemented(uint32_t insn) const;
+
+  // Address of the trap slot with the given index. Slots `[0, number of quick entrypoints)`
+  // stand for the entrypoints and the last slot is the return address of RunFrom().
+  uintptr_t GetTrapAddress(size_t index) const {
+    return reinterpret_cast<uintptr_t>(&trap_slots_[index]);
+  }
+
+  int64_t xregs_[kNumberOfXRegisters];
+  uint64_t fregs_[kNumberOfFRegisters];
+  bool fcc_[8];
+  uintptr_t pc_;
+  // Address of the next instruction; branches overwrite it.
+  uintptr_t next_pc_;
+  uint64_t instruction_count_;
+
+  std::vector<uint64_t> stack_;
+  std::vector<uint64_t> thread_;
+  // Never executed; only their addresses are used to recognize calls to entrypoints
+  // and the final return.
+  std::vector<uint32_t> trap_slots_;
+  std::vector<EntrypointHook> hooks_;
+
+  // The simulator needs a 64-bit little-endian host and is pointless on LoongArch64 itself.
+  static constexpr bool kCanSimulate = (kRuntimeISA == InstructionSet::kX86_64) ||
+                                       (kRuntimeISA == InstructionSet::kArm64);
+
+  DISALLOW_COPY_AND_ASSIGN(CodeSimulatorLoongarch64);
+};
+
+}  // namespace loongarch64
+}  // namespace art
+
+#endif  // ART_SIMULATOR_CODE_SIMULATOR_LOONGARCH64_H_
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_simulator_loongarch64.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/malloc_arena_pool.h"
+#include "gtest/gtest.h"
+#include "utils/loongarch64/assembler_loongarch64.h"
+
+namespace art {
+namespace loongarch64 {
+
+class CodeSimulatorLoongarch64Test : public ::testing::Test {
+ public:
+  CodeSimulatorLoongarch64Test()
+      : pool_(),
+        allocator_(&pool_),
+        assembler_(&allocator_),
+        simulator_(CodeSimulatorLoongarch64::CreateCodeSimulatorLoongarch64()) {}
+
+ protected:
+  // Finalizes the code emitted with `assembler_` and runs it from the beginning.
+  void Run() {
+    assembler_.FinalizeCode();
+    code_.resize(assembler_.CodeSize());
+    MemoryRegion region(code_.data(), code_.size());
+    assembler_.FinalizeInstructions(region);
+    simulator_->RunFrom(reinterpret_cast<intptr_t>(code_.data()));
+  }
+
+  MallocArenaPool pool_;
+  ArenaAllocator allocator_;
+  Loongarch64Assembler assembler_;
+  std::unique_ptr<CodeSimulatorLoongarch64> simulator_;
+  std::vector<uint8_t> code_;
+};
+
+// The simulator is only available on 64-bit little-endian hosts.
+#define TEST_DISABLED_WITHOUT_SIMULATOR() \
+  if (simulator_ == nullptr) { \
+    printf("WARNING: TEST DISABLED WITHOUT LOONGARCH64 SIMULATOR\n"); \
+    return; \
+  }
+
+#define __ assembler_.
+
+TEST_F(CodeSimulatorLoongarch64Test, Arithmetic) {
+  TEST_DISABLED_WITHOUT_SIMULATOR();
+  __ LoadConst64(T0, INT64_C(0x123456789));
+  __ LoadConst32(T1, -7);
+  __ MulD(T2, T0, T1);
+  __ SubD(T3, T2, T0);
+  __ LoadConst32(T4, 3);
+  __ DivD(A0, T3, T4);
+  __ AddW(A1, T1, T4);
+  __ Ret();
+  Run();
+
+  EXPECT_EQ(INT64_C(0x123456789), simulator_->ReadXRegister(T0));
+  EXPECT_EQ(INT64_C(-7), simulator_->ReadXRegister(T1));
+  EXPECT_EQ(INT64_C(-7) * INT64_C(0x123456789), simulator_->ReadXRegister(T2));
+  EXPECT_EQ(INT64_C(-8) * INT64_C(0x123456789), simulator_->ReadXRegister(T3));
+  EXPECT_EQ(INT64_C(-8) * INT64_C(0x123456789) / 3, simulator_->GetCReturnInt64());
+  EXPECT_EQ(-4, simulator_->ReadXRegister(A1));
+  // Writes to the zero register are ignored.
+  EXPECT_EQ(0, simulator_->ReadXRegister(Zero));
+}
+
+TEST_F(CodeSimulatorLoongarch64Test, Branches) {
+  TEST_DISABLED_WITHOUT_SIMULATOR();
+  Loongarch64Label loop;
+  Loongarch64Label skip;
+  // Sum 1 to 10 with a backward branch.
+  __ LoadConst32(T0, 10);
+  __ Move(A0, Zero);
+  __ Bind(&loop);
+  __ AddD(A0, A0, T0);
+  __ AddiD(T0, T0, -1);
+  __ Bnez(T0, &loop);
+  // A taken forward branch skips the next instruction, a not taken one falls through.
+  __ LoadConst32(A1, 1);
+  __ Blt(A0, T0, &skip);
+  __ Blt(T0, A0, &skip);
+  __ LoadConst32(A1, 2);
+  __ Bind(&skip);
+  __ Ret();
+  Run();
+
+  EXPECT_EQ(55, simulator_->GetCReturnInt32());
+  EXPECT_EQ(0, simulator_->ReadXRegister(T0));
+  EXPECT_EQ(1, simulator_->ReadXRegister(A1));
+  // 2 instructions before the loop, 3 in each of the 10 iterations, then 4 up to the return.
+  EXPECT_EQ(2u + 3u * 10u + 4u, simulator_->GetInstructionCount());
+}
+
+TEST_F(CodeSimulatorLoongarch64Test, EntrypointCall) {
+  TEST_DISABLED_WITHOUT_SIMULATOR();
+  size_t hook_calls = 0u;
+  simulator_->SetEntrypointHook(
+      kQuickLmul,
+      [&hook_calls](CodeSimulatorLoongarch64* simulator) {
+        ++hook_calls;
+        simulator->WriteXRegister(
+            A0, simulator->ReadXRegister(A0) * simulator->ReadXRegister(A1));
+      });
+  __ AddiD(SP, SP, -16);
+  __ StoreToOffset(kStoreDoubleword, RA, SP, 8);
+  __ LoadConst32(A0, 6);
+  __ LoadConst32(A1, 7);
+  __ LoadFromOffset(kLoadDoubleword, RA, TR, GetThreadOffset<kLoongarch64PointerSize>(
+      kQuickLmul).Int32Value());
+  __ Jalr(RA);
+  __ AddiD(A0, A0, 1);
+  __ LoadFromOffset(kLoadDoubleword, RA, SP, 8);
+  __ AddiD(SP, SP, 16);
+  __ Ret();
+  Run();
+
+  EXPECT_EQ(1u, hook_calls);
+  EXPECT_EQ(43, simulator_->GetCReturnInt64());
+}
+
+#undef __
+
+}  // namespace loongarch64
+}  // namespace art
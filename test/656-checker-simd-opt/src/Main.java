@@ -153,6 +153,39 @@ public class Main {
     return -1;
   }
 
+  // Every write a[i + 1] vs. read x[i] of another array needs an a != x runtime test,
+  // and up to four of these are accepted.
+  //
+  /// CHECK-START-{X86_64,ARM64}: void Main.fourRuntimeTests(int[], int[], int[], int[], int[], int) loop_optimization (after)
+  /// CHECK-DAG: <<Ne1:z\d+>>  NotEqual [{{l\d+}},{{l\d+}}]         loop:none
+  /// CHECK-DAG: <<Ne2:z\d+>>  NotEqual [{{l\d+}},{{l\d+}}]         loop:none
+  /// CHECK-DAG: <<Ne3:z\d+>>  NotEqual [{{l\d+}},{{l\d+}}]         loop:none
+  /// CHECK-DAG: <<Ne4:z\d+>>  NotEqual [{{l\d+}},{{l\d+}}]         loop:none
+  /// CHECK-DAG:                Select [{{i\d+}},{{i\d+}},<<Ne1>>]   loop:none
+  /// CHECK-DAG:                Select [{{i\d+}},{{i\d+}},<<Ne2>>]   loop:none
+  /// CHECK-DAG:                Select [{{i\d+}},{{i\d+}},<<Ne3>>]   loop:none
+  /// CHECK-DAG:                Select [{{i\d+}},{{i\d+}},<<Ne4>>]   loop:none
+  /// CHECK-DAG:                VecStore                            loop:<<Loop:B\d+>> outer_loop:none
+  private static void fourRuntimeTests(int[] a, int[] b, int[] c, int[] d, int[] e, int n) {
+    for (int i = 0; i < n - 1; i++) {
+      a[i + 1] = b[i] + c[i] + d[i] + e[i];
+    }
+  }
+
+  // A fifth runtime test is too much overhead, so the loop is not vectorized.
+  //
+  /// CHECK-START-{X86_64,ARM64}: void Main.fiveRuntimeTests(int[], int[], int[], int[], int[], int[], int) loop_optimization (after)
+  /// CHECK-NOT: VecLoad
+  //
+  /// CHECK-START-{X86_64,ARM64}: void Main.fiveRuntimeTests(int[], int[], int[], int[], int[], int[], int) loop_optimization (after)
+  /// CHECK-NOT: VecStore
+  private static void fiveRuntimeTests(
+      int[] a, int[] b, int[] c, int[] d, int[] e, int[] f, int n) {
+    for (int i = 0; i < n - 1; i++) {
+      a[i + 1] = b[i] + c[i] + d[i] + e[i] + f[i];
+    }
+  }
+
   /// CHECK-START: void Main.stencilSubInt(int[], int[], int) loop_optimization (before)
   /// CHECK-DAG: <<PAR3:i\d+>>  ParameterValue                       loop:none
   /// CHECK-DAG: <<CP1:i\d+>>   IntConstant 1                        loop:none
@@ -390,6 +423,39 @@ public class Main {
     }
   }
 
+  static void testRuntimeTests() {
+    int[] a = new int[100];
+    int[] b = new int[100];
+    int[] c = new int[100];
+    int[] d = new int[100];
+    int[] e = new int[100];
+    int[] f = new int[100];
+    for (int i = 0; i < 100; i++) {
+      a[i] = 0;
+      b[i] = i;
+      c[i] = 2 * i;
+      d[i] = 3 * i;
+      e[i] = 4 * i;
+      f[i] = 5 * i;
+    }
+    fourRuntimeTests(a, b, c, d, e, 100);
+    expectEquals(0, a[0]);
+    for (int i = 1; i < 100; i++) {
+      expectEquals(10 * (i - 1), a[i]);
+    }
+    fiveRuntimeTests(a, b, c, d, e, f, 100);
+    expectEquals(0, a[0]);
+    for (int i = 1; i < 100; i++) {
+      expectEquals(15 * (i - 1), a[i]);
+    }
+    // Aliased arrays fail the runtime tests, so the loop runs sequentially:
+    // b[i + 1] = b[i] + 9 * i.
+    fourRuntimeTests(b, b, c, d, e, 100);
+    for (int i = 0; i < 100; i++) {
+      expectEquals(9 * i * (i - 1) / 2, b[i]);
+    }
+  }
+
   static void testTypes() {
     int[] a = new int[100];
     int[] b = new int[100];
@@ -410,6 +476,7 @@ public class Main {
     testStencil1();
     testStencil2();
     testStencil3();
+    testRuntimeTests();
     testTypes();
     System.out.println("passed");
   }
@@ -35,26 +35,29 @@ static constexpr jint kArtTiVersion = JVMTI_VERSION_1_2 | 0x40000000;
     CHECK(vc == JNI_OK || vc == JVMTI_ERROR_NONE) << "call " << #c  << " did not succeed\n"; \
   } while (false)
 
-static jthread GetJitThread() {
+static std::vector<jthread> GetJitThreads() {
   art::ScopedObjectAccess soa(art::Thread::Current());
+  std::vector<jthread> jit_threads;
   auto* jit = art::Runtime::Current()->GetJit();
   if (jit == nullptr) {
-    return nullptr;
+    return jit_threads;
   }
   auto* thread_pool = jit->GetThreadPool();
   if (thread_pool == nullptr) {
-    return nullptr;
+    return jit_threads;
   }
-  // Currently we only have a single jit thread so we only look at that one.
-  return soa.AddLocalReference<jthread>(
-          thread_pool->GetWorkers()[0]->GetThread()->GetPeerFromOtherThread());
+  // The JIT may have several compiler threads (see -Xjitthreads), watch all of them.
+  for (art::ThreadPoolWorker* worker : thread_pool->GetWorkers()) {
+    jit_threads.push_back(
+        soa.AddLocalReference<jthread>(worker->GetThread()->GetPeerFromOtherThread()));
+  }
+  return jit_threads;
 }
 
 JNICALL void VmInitCb(jvmtiEnv* jvmti,
                       JNIEnv* env ATTRIBUTE_UNUSED,
                       jthread curthread ATTRIBUTE_UNUSED) {
-  jthread jit_thread = GetJitThread();
-  if (jit_thread != nullptr) {
+  for (jthread jit_thread : GetJitThreads()) {
     CHECK_EQ(jvmti->SetEventNotificationMode(JVMTI_ENABLE, JVMTI_EVENT_CLASS_PREPARE, jit_thread),
              JVMTI_ERROR_NONE);
   }